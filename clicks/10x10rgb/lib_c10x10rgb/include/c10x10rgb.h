@@ -91,6 +91,8 @@
 #define NUM_DATA_BITS                   24
 #define NUM_MATRIX_BYTE                 100
 #define NUX_MAX_CHAR                    40
+#define BITSTREAM_BYTES_PER_LED         9
+#define BITSTREAM_SIZE                  ( NUM_MATRIX_BYTE * BITSTREAM_BYTES_PER_LED )
 
 #define COLOR_DEFAULT                   0x00000000
 #define BG_COLOR_DEFAULT                0x00000000
@@ -159,6 +161,13 @@
 
 typedef void ( *drv_logic_t ) ( void );
 
+/**
+ * @brief Bitstream transmit function pointer.
+ * @details Starts the transfer of @b len bytes of encoded bitstream, e.g. by
+ * SPI or DMA at 2.4 MHz, MSB first.
+ */
+typedef void ( *drv_burst_t ) ( uint8_t *bitstream, uint16_t len );
+
 /**
  * @brief Byte object definition.
  */
@@ -209,8 +218,13 @@ typedef struct
     drv_logic_t logic_zero;
     drv_logic_t logic_one;
     
+    drv_burst_t burst;
+    
     uint32_t matrix[ NUM_MATRIX_BYTE ];
 
+    uint8_t *bitstream[ 2 ];
+    uint8_t bitstream_idx;
+
 } c10x10rgb_t;
 
 /**
@@ -269,6 +283,36 @@ C10X10RGB_RETVAL c10x10rgb_init ( c10x10rgb_t *ctx, c10x10rgb_cfg_t *cfg );
  */
 void c10x10rgb_write_data ( c10x10rgb_t *ctx, uint32_t w_data );
 
+/**
+ * @brief Set bitstream function.
+ * 
+ * @param c10x10rgb     Click object.
+ * @param burst         Bitstream transmit function, NULL to go back to the GPIO protocol.
+ * @param frame_a       Bitstream buffer of BITSTREAM_SIZE bytes.
+ * @param frame_b       Second bitstream buffer of BITSTREAM_SIZE bytes or NULL.
+ * 
+ * @description This function makes the screen functions encode the whole frame
+ *              into a bitstream buffer, 3 bits per WS2812 bit, and hand it over
+ *              to the @b burst function in one transfer. With two buffers the
+ *              next frame is encoded into one buffer while the other one is
+ *              still being transmitted.
+ * @note The @b burst function has to keep the data line low for the reset time
+ *       after the transfer.
+ */
+void c10x10rgb_set_bitstream ( c10x10rgb_t *ctx, drv_burst_t burst, uint8_t *frame_a, uint8_t *frame_b );
+
+/**
+ * @brief Encode bitstream function.
+ * 
+ * @param bitstream     Output buffer of BITSTREAM_BYTES_PER_LED bytes per LED.
+ * @param colors        Color values.
+ * @param num_leds      Number of LEDs.
+ * 
+ * @description This function encodes the color values into a bitstream where each
+ *              WS2812 bit is sent as 3 bits: 110 for logic one and 100 for logic zero.
+ */
+void c10x10rgb_encode_bitstream ( uint8_t *bitstream, const uint32_t *colors, uint16_t num_leds );
+
 /**
  * @brief Fill screen function.
  * 
@@ -30,10 +30,21 @@
 #include "c10x10rgb.h"
 #include "c10x10rgb_ascii_matrix.h"
 
+// ------------------------------------------------------------------ CONSTANTS
+
+// 3-bit codes of the four WS2812 bits in a nibble, 110 for one and 100 for zero
+static const uint16_t bitstream_nibble[ 16 ] =
+{
+    0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+    0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6
+};
+
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
 static void drv_show_screen ( c10x10rgb_t *ctx );
 
+static void drv_show_bitstream ( c10x10rgb_t *ctx, const uint32_t *colors, uint8_t fill );
+
 static void drv_matrix_add_scroll_buf ( drv_scroll_buf_t *scroll_buf_obj,
                                         c10x10rgb_byte_t *data_array, uint8_t data_len );
 
@@ -66,6 +77,7 @@ C10X10RGB_RETVAL c10x10rgb_init ( c10x10rgb_t *ctx, c10x10rgb_cfg_t *cfg )
     // Function pointers 
     ctx->logic_zero = cfg->logic_zero;
     ctx->logic_one = cfg->logic_one;
+    ctx->burst = NULL;
 
     digital_out_low( &ctx->di_pin );
     Delay_100ms( );
@@ -93,9 +105,44 @@ void c10x10rgb_write_data ( c10x10rgb_t *ctx, uint32_t w_data )
     }
 }
 
+void c10x10rgb_set_bitstream ( c10x10rgb_t *ctx, drv_burst_t burst, uint8_t *frame_a, uint8_t *frame_b )
+{
+    ctx->burst = burst;
+    ctx->bitstream[ 0 ] = frame_a;
+    ctx->bitstream[ 1 ] = frame_b;
+    ctx->bitstream_idx = 0;
+}
+
+void c10x10rgb_encode_bitstream ( uint8_t *bitstream, const uint32_t *colors, uint16_t num_leds )
+{
+    uint16_t cnt = 0;
+    uint8_t cnt_byte = 0;
+    uint8_t color_byte = 0;
+    uint32_t bits = 0;
+
+    for ( cnt = 0; cnt < num_leds; cnt++ )
+    {
+        for ( cnt_byte = 0; cnt_byte < 3; cnt_byte++ )
+        {
+            color_byte = ( uint8_t ) ( colors[ cnt ] >> ( 16 - cnt_byte * 8 ) );
+            bits = ( ( uint32_t ) bitstream_nibble[ color_byte >> 4 ] << 12 ) | 
+                   bitstream_nibble[ color_byte & 0x0F ];
+            *bitstream++ = ( uint8_t ) ( bits >> 16 );
+            *bitstream++ = ( uint8_t ) ( bits >> 8 );
+            *bitstream++ = ( uint8_t ) bits;
+        }
+    }
+}
+
 void c10x10rgb_fill_screen ( c10x10rgb_t *ctx, uint32_t screen_color ) 
 {
     uint8_t cnt = 0;
+
+    if ( NULL != ctx->burst )
+    {
+        drv_show_bitstream( ctx, &screen_color, 1 );
+        return;
+    }
     for ( cnt = 0; cnt < NUM_MATRIX_BYTE; cnt++ )
     {
         c10x10rgb_write_data( ctx, screen_color );
@@ -214,12 +261,45 @@ void c10x10rgb_demo_rainbow ( c10x10rgb_t *ctx, uint8_t brightness, uint16_t spe
 static void drv_show_screen ( c10x10rgb_t *ctx )
 {
     uint8_t cnt = 0;
+
+    if ( NULL != ctx->burst )
+    {
+        drv_show_bitstream( ctx, ctx->matrix, 0 );
+        return;
+    }
     for ( cnt = 0; cnt < NUM_MATRIX_BYTE; cnt++ )
     {
         c10x10rgb_write_data( ctx, ctx->matrix[ cnt ] );
     }
 }
 
+static void drv_show_bitstream ( c10x10rgb_t *ctx, const uint32_t *colors, uint8_t fill )
+{
+    uint8_t *bitstream = ctx->bitstream[ ctx->bitstream_idx ];
+    uint8_t cnt = 0;
+
+    if ( fill )
+    {
+        c10x10rgb_encode_bitstream( bitstream, colors, 1 );
+        for ( cnt = 1; cnt < NUM_MATRIX_BYTE; cnt++ )
+        {
+            memcpy ( &bitstream[ cnt * BITSTREAM_BYTES_PER_LED ], bitstream, BITSTREAM_BYTES_PER_LED );
+        }
+    }
+    else
+    {
+        c10x10rgb_encode_bitstream( bitstream, colors, NUM_MATRIX_BYTE );
+    }
+
+    ctx->burst( bitstream, BITSTREAM_SIZE );
+
+    // Encode the next frame into the other buffer while this one is on the wire
+    if ( NULL != ctx->bitstream[ 1 ] )
+    {
+        ctx->bitstream_idx ^= 1;
+    }
+}
+
 static void drv_matrix_add_scroll_buf ( drv_scroll_buf_t *scroll_buf_obj,
                                         c10x10rgb_byte_t *data_array, uint8_t data_len )
 {
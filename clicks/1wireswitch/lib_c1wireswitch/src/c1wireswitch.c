@@ -219,20 +219,18 @@ err_t c1wireswitch_get_pio_latch_state ( c1wireswitch_t *ctx, uint8_t *pio_a_lat
 
 static uint8_t c1wireswitch_calculate_crc8 ( uint8_t *data_buf, uint8_t len )
 {
+    // CRC of each nibble value for reflected polynomial 0x8C, processed 4 bits at a time
+    static const uint8_t crc8_table[ 16 ] = 
+    {
+        0x00, 0x9D, 0x23, 0xBE, 0x46, 0xDB, 0x65, 0xF8,
+        0x8C, 0x11, 0xAF, 0x32, 0xCA, 0x57, 0xE9, 0x74
+    };
     uint8_t crc = 0x00;
     for ( uint8_t cnt_0 = 0; cnt_0 < len; cnt_0++ ) 
     {
-        uint8_t in_byte = data_buf[ cnt_0 ];
-        for ( uint8_t cnt_1 = 0; cnt_1 < 8; cnt_1++ ) 
-        {
-            uint8_t mix = ( crc ^ in_byte ) & 0x01;
-            crc >>= 1;
-            if ( 0 != mix ) 
-            {
-                crc ^= 0x8C;
-            }
-            in_byte >>= 1;
-        }
+        crc ^= data_buf[ cnt_0 ];
+        crc = ( crc >> 4 ) ^ crc8_table[ crc & 0x0F ];
+        crc = ( crc >> 4 ) ^ crc8_table[ crc & 0x0F ];
     }
     return crc;
 }
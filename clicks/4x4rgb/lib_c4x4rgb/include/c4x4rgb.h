@@ -85,6 +85,14 @@
 #define C4X4RGB_CTRL_PIN_IN2        2
 /** \} */
 
+/**
+ * \defgroup bitstream Bitstream buffer size
+ * \{
+ */
+#define C4X4RGB_BITSTREAM_BYTES_PER_LED   9
+#define C4X4RGB_BITSTREAM_SIZE            ( 16 * C4X4RGB_BITSTREAM_BYTES_PER_LED )
+/** \} */
+
 
 /**
  * \defgroup color  Color
@@ -110,6 +118,12 @@
  * @brief Function pointer for logic level one and zero
  */
 typedef void ( *drv_logic_t ) ( void );
+
+/**
+ * @brief Function pointer which starts the transfer of the encoded bitstream,
+ * e.g. by SPI or DMA at 2.4 MHz, MSB first.
+ */
+typedef void ( *drv_burst_t ) ( uint8_t *bitstream, uint16_t len );
  
 /**
  * @brief Click ctx object definition.
@@ -126,8 +140,12 @@ typedef struct
     // Function pointers
     drv_logic_t logic_zero;
     drv_logic_t logic_one;
+    drv_burst_t burst;
     
     uint32_t diode_array[ 16 ];
+
+    uint8_t *bitstream[ 2 ];
+    uint8_t bitstream_idx;
     
 } c4x4rgb_t;
 
@@ -195,9 +213,38 @@ err_t c4x4rgb_init ( c4x4rgb_t *ctx, c4x4rgb_cfg_t *cfg );
  */
 err_t c4x4rgb_set_diode ( c4x4rgb_t *ctx, uint32_t diode_num, uint32_t diode_color );
 
+/**
+ * @brief Function for setting the bitstream transmission.
+ * @details This function makes c4x4rgb_set_diode encode all diodes into a bitstream
+ * buffer, 3 bits per WS2812 bit, and hand it over to the burst function in one
+ * transfer. With two buffers the next frame is encoded into one buffer while the
+ * other one is still being transmitted.
+ *
+ * @param ctx            Click object.
+ * @param burst          Bitstream transmit function, NULL to go back to the logic functions
+ * @param frame_a        Bitstream buffer of C4X4RGB_BITSTREAM_SIZE bytes
+ * @param frame_b        Second bitstream buffer of C4X4RGB_BITSTREAM_SIZE bytes or NULL
+ *
+ * @note The burst function has to keep the data line low for the reset time after
+ * the transfer.
+ */
+void c4x4rgb_set_bitstream ( c4x4rgb_t *ctx, drv_burst_t burst, uint8_t *frame_a, uint8_t *frame_b );
+
+/**
+ * @brief Function for encoding diode colors into a bitstream.
+ * @details This function encodes the colors into a bitstream where each WS2812 bit
+ * is sent as 3 bits: 110 for logic one and 100 for logic zero.
+ *
+ * @param bitstream      Output buffer of C4X4RGB_BITSTREAM_BYTES_PER_LED bytes per diode
+ * @param colors         Diode colors in GRB order
+ * @param num_diodes     Number of diodes
+ */
+void c4x4rgb_encode_bitstream ( uint8_t *bitstream, const uint32_t *colors, uint8_t num_diodes );
+
 /**
  * @brief Function for filling color of ever diode.
- * @details This function sets every diode on selected color.
+ * @details This function sets every diode on selected color. With a bitstream
+ * set by c4x4rgb_set_bitstream the whole frame is sent in one burst.
  *
  * @param ctx            Click object.
  * @param fill_color     Desired color
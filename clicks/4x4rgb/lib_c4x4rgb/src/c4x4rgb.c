@@ -29,10 +29,19 @@
 
 #include "c4x4rgb.h"
 
+// 3-bit codes of the four WS2812 bits in a nibble, 110 for one and 100 for zero
+static const uint16_t bitstream_nibble[ 16 ] =
+{
+    0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+    0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6
+};
+
 static void dev_init_diode ( c4x4rgb_t *ctx, uint32_t a_rgb_color, uint8_t diode_num );
 
 static void dev_set_color ( c4x4rgb_t *ctx, uint8_t diode_num );
 
+static void dev_show_bitstream ( c4x4rgb_t *ctx );
+
 void c4x4rgb_cfg_setup ( c4x4rgb_cfg_t *cfg, drv_logic_t logic_zero, drv_logic_t logic_one, uint8_t select_ctrl_pin )
 {
     // Additional gpio pins
@@ -55,6 +64,7 @@ err_t c4x4rgb_init ( c4x4rgb_t *ctx, c4x4rgb_cfg_t *cfg )
     
     ctx->logic_zero = cfg->logic_zero;
     ctx->logic_one = cfg->logic_one;
+    ctx->burst = NULL;
     
     if ( C4X4RGB_CTRL_PIN_IN2 == cfg->ctrl_pin )
     {
@@ -74,6 +84,15 @@ err_t c4x4rgb_set_diode ( c4x4rgb_t *ctx, uint32_t diode_num, uint32_t diode_col
     {
         return C4X4RGB_ERROR;
     }
+    if ( NULL != ctx->burst )
+    {
+        if ( diode_num > 0 )
+        {
+            dev_init_diode( ctx, diode_color, diode_num - 1 );
+        }
+        dev_show_bitstream( ctx );
+        return C4X4RGB_OK;
+    }
     for ( uint8_t cnt_i = 0; cnt_i < 16; cnt_i++ )
     {
         if ( ( diode_num - 1 ) == cnt_i )
@@ -92,6 +111,15 @@ err_t c4x4rgb_set_diode ( c4x4rgb_t *ctx, uint32_t diode_num, uint32_t diode_col
 
 void c4x4rgb_fill_screen ( c4x4rgb_t *ctx, uint32_t fill_color )
 {
+    if ( NULL != ctx->burst )
+    {
+        for ( uint8_t cnt_i = 0 ; cnt_i < 16; cnt_i++ )
+        {
+            dev_init_diode( ctx, fill_color, cnt_i );
+        }
+        dev_show_bitstream( ctx );
+        return;
+    }
     for ( uint8_t cnt_i = 0 ; cnt_i < 16; cnt_i++ )
     {
         c4x4rgb_set_diode( ctx, cnt_i + 1, fill_color );
@@ -99,6 +127,32 @@ void c4x4rgb_fill_screen ( c4x4rgb_t *ctx, uint32_t fill_color )
     }
 }
 
+void c4x4rgb_set_bitstream ( c4x4rgb_t *ctx, drv_burst_t burst, uint8_t *frame_a, uint8_t *frame_b )
+{
+    ctx->burst = burst;
+    ctx->bitstream[ 0 ] = frame_a;
+    ctx->bitstream[ 1 ] = frame_b;
+    ctx->bitstream_idx = 0;
+}
+
+void c4x4rgb_encode_bitstream ( uint8_t *bitstream, const uint32_t *colors, uint8_t num_diodes )
+{
+    uint8_t color_byte;
+    uint32_t bits;
+    for ( uint8_t cnt_i = 0; cnt_i < num_diodes; cnt_i++ )
+    {
+        for ( uint8_t cnt_j = 0; cnt_j < 3; cnt_j++ )
+        {
+            color_byte = ( uint8_t ) ( colors[ cnt_i ] >> ( 16 - cnt_j * 8 ) );
+            bits = ( ( uint32_t ) bitstream_nibble[ color_byte >> 4 ] << 12 ) | 
+                   bitstream_nibble[ color_byte & 0x0F ];
+            *bitstream++ = ( uint8_t ) ( bits >> 16 );
+            *bitstream++ = ( uint8_t ) ( bits >> 8 );
+            *bitstream++ = ( uint8_t ) bits;
+        }
+    }
+}
+
 static void dev_init_diode ( c4x4rgb_t *ctx, uint32_t a_rgb_color, uint8_t diode_num )
 {
     ctx->diode_array[ diode_num ] = ( a_rgb_color & 0x000000FF ) | 
@@ -122,6 +176,16 @@ static void dev_set_color ( c4x4rgb_t *ctx, uint8_t diode_num )
     }
 }
 
+static void dev_show_bitstream ( c4x4rgb_t *ctx )
+{
+    c4x4rgb_encode_bitstream( ctx->bitstream[ ctx->bitstream_idx ], ctx->diode_array, 16 );
+    ctx->burst( ctx->bitstream[ ctx->bitstream_idx ], C4X4RGB_BITSTREAM_SIZE );
+    // Encode the next frame into the other buffer while this one is on the wire
+    if ( NULL != ctx->bitstream[ 1 ] )
+    {
+        ctx->bitstream_idx ^= 1;
+    }
+}
 
 // ------------------------------------------------------------------------- END
 
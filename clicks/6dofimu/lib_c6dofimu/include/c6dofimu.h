@@ -218,6 +218,7 @@
  */
 #define C6DOFIMU_ACCEL_READ_MODE   0x00
 #define C6DOFIMU_GYRO_READ_MODE    0x01
+#define C6DOFIMU_ALL_READ_MODE     0x02
 /** \} */
 
 /** \} */ // End group macro 
@@ -375,10 +376,11 @@ void c6dofimu_generic_read ( c6dofimu_t *ctx, uint8_t reg, uint8_t *data_buf, ui
  * @brief Read axis data function.
  *
  * @param ctx        Click object.
- * @param read_mode  Read mode: { Accelerometer | Gyroscope }.
+ * @param read_mode  Read mode: { Accelerometer | Gyroscope | All }.
  *
  * @description This function reads axis data for the gyroscope or the accelerometer from
- *              predefined data register addresses.
+ *              predefined data register addresses. All read mode reads both of them
+ *              from the same sample in a single bus transaction.
  */
 void c6dofimu_read_axis_data ( c6dofimu_t *ctx, uint8_t read_mode );
 
@@ -45,6 +45,8 @@ static void c6dofimu_spi_read ( c6dofimu_t *ctx, uint8_t reg, uint8_t *data_buf,
 
 static int16_t drv_double_read ( c6dofimu_t *ctx, uint8_t reg );
 
+static void drv_get_axis ( uint8_t *read_buf, c6dofimu_axis_t *axis );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void c6dofimu_cfg_setup ( c6dofimu_cfg_t *cfg )
@@ -161,17 +163,24 @@ void c6dofimu_generic_read ( c6dofimu_t *ctx, uint8_t reg, uint8_t *data_buf, ui
 
 void c6dofimu_read_axis_data ( c6dofimu_t *ctx, uint8_t read_mode )
 {
+    uint8_t read_buf[ 12 ];
+
     if ( read_mode == C6DOFIMU_ACCEL_READ_MODE )
     {
-        ctx->accel_axis.x = drv_double_read( ctx, C6DOFIMU_OUTX_L_G );
-        ctx->accel_axis.y = drv_double_read( ctx, C6DOFIMU_OUTY_L_G );
-        ctx->accel_axis.z = drv_double_read( ctx, C6DOFIMU_OUTZ_L_G ); 
+        c6dofimu_generic_read( ctx, C6DOFIMU_OUTX_L_XL, read_buf, 6 );
+        drv_get_axis( read_buf, &ctx->accel_axis );
     }
     else if ( read_mode == C6DOFIMU_GYRO_READ_MODE ) 
     {
-        ctx->gyro_axis.x = drv_double_read( ctx, C6DOFIMU_OUTX_L_XL );
-        ctx->gyro_axis.y = drv_double_read( ctx, C6DOFIMU_OUTY_L_XL );
-        ctx->gyro_axis.z = drv_double_read( ctx, C6DOFIMU_OUTZ_L_XL );
+        c6dofimu_generic_read( ctx, C6DOFIMU_OUTX_L_G, read_buf, 6 );
+        drv_get_axis( read_buf, &ctx->gyro_axis );
+    }
+    else if ( read_mode == C6DOFIMU_ALL_READ_MODE ) 
+    {
+        // Gyroscope outputs are followed by accelerometer outputs
+        c6dofimu_generic_read( ctx, C6DOFIMU_OUTX_L_G, read_buf, 12 );
+        drv_get_axis( read_buf, &ctx->gyro_axis );
+        drv_get_axis( &read_buf[ 6 ], &ctx->accel_axis );
     }
 } 
 
@@ -261,5 +270,12 @@ static int16_t drv_double_read ( c6dofimu_t *ctx, uint8_t reg )
     return value;
 }
 
+static void drv_get_axis ( uint8_t *read_buf, c6dofimu_axis_t *axis )
+{
+    axis->x = ( ( int16_t ) read_buf[ 1 ] << 8 ) | read_buf[ 0 ];
+    axis->y = ( ( int16_t ) read_buf[ 3 ] << 8 ) | read_buf[ 2 ];
+    axis->z = ( ( int16_t ) read_buf[ 5 ] << 8 ) | read_buf[ 4 ];
+}
+
 // ------------------------------------------------------------------------- END
 
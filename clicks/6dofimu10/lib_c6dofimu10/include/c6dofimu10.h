@@ -645,6 +645,19 @@ void c6dofimu10_get_accel_axis ( c6dofimu10_t *ctx, c6dofimu10_axis_t *axis );
  */
 void c6dofimu10_get_mag_axis ( c6dofimu10_t *ctx, c6dofimu10_axis_t *axis );
 
+/**
+ * @brief Get accelerometer and magnetometer axis data
+ *
+ * @param ctx          Click object.
+ * @param accel_axis   Accelerometer axis data.
+ * @param mag_axis     Magnetometer axis data.
+ *
+ * @description This function gets accelerometer and magnetometer axis data
+ * of the same sample in a single bus transaction.
+ */
+void c6dofimu10_get_axis_data ( c6dofimu10_t *ctx, c6dofimu10_axis_t *accel_axis, 
+                                c6dofimu10_axis_t *mag_axis );
+
 /**
  * @brief Temperature data.
  *
@@ -33,7 +33,7 @@
 
 static void drv_set_register ( c6dofimu10_t *ctx,  uint8_t reg, uint8_t set_data );
 
-static int16_t drv_read_data_u16 ( c6dofimu10_t *ctx,  uint8_t reg );
+static void drv_read_axis ( c6dofimu10_t *ctx, uint8_t reg, c6dofimu10_axis_t *axis );
 
 static uint8_t drv_get_register ( c6dofimu10_t *ctx,  uint8_t reg );
 
@@ -184,16 +184,28 @@ void c6dofimu10_measurement_cfg( c6dofimu10_t *ctx, c6dofimu10_cfg_t *cfg )
 
 void c6dofimu10_get_accel_axis ( c6dofimu10_t *ctx, c6dofimu10_axis_t *axis )
 {
-    axis->x = drv_read_data_u16( ctx, C6DOFIMU10_REG_ACCEL_XOUT );
-    axis->y = drv_read_data_u16( ctx, C6DOFIMU10_REG_ACCEL_YOUT );
-    axis->z = drv_read_data_u16( ctx, C6DOFIMU10_REG_ACCEL_ZOUT );
+    drv_read_axis( ctx, C6DOFIMU10_REG_ACCEL_XOUT, axis );
 }
 
 void c6dofimu10_get_mag_axis ( c6dofimu10_t *ctx, c6dofimu10_axis_t *axis )
 {
-    axis->x = drv_read_data_u16( ctx, C6DOFIMU10_REG_MAG_XOUT );
-    axis->y = drv_read_data_u16( ctx, C6DOFIMU10_REG_MAG_YOUT );
-    axis->z = drv_read_data_u16( ctx, C6DOFIMU10_REG_MAG_ZOUT );
+    drv_read_axis( ctx, C6DOFIMU10_REG_MAG_XOUT, axis );
+}
+
+void c6dofimu10_get_axis_data ( c6dofimu10_t *ctx, c6dofimu10_axis_t *accel_axis, 
+                                c6dofimu10_axis_t *mag_axis )
+{
+    uint8_t rx_buf[ 12 ] = { 0 };
+
+    // Accelerometer outputs are followed by magnetometer outputs
+    c6dofimu10_generic_read( ctx, C6DOFIMU10_REG_ACCEL_XOUT, rx_buf, 12 );
+
+    accel_axis->x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    accel_axis->y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    accel_axis->z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
+    mag_axis->x = ( ( int16_t ) rx_buf[ 7 ] << 8 ) | rx_buf[ 6 ];
+    mag_axis->y = ( ( int16_t ) rx_buf[ 9 ] << 8 ) | rx_buf[ 8 ];
+    mag_axis->z = ( ( int16_t ) rx_buf[ 11 ] << 8 ) | rx_buf[ 10 ];
 }
 
 float c6dofimu10_get_temperature ( c6dofimu10_t *ctx, uint8_t temp_format )
@@ -263,18 +275,15 @@ static void drv_set_register ( c6dofimu10_t *ctx, uint8_t reg, uint8_t set_data
     c6dofimu10_generic_write( ctx, reg, &set_data, 1 );
 }
 
-static int16_t drv_read_data_u16 ( c6dofimu10_t *ctx, uint8_t reg )
+static void drv_read_axis ( c6dofimu10_t *ctx, uint8_t reg, c6dofimu10_axis_t *axis )
 {
-    uint8_t rx_buf[ 2 ] = { 0 };
-    int16_t data_out = 0;
-
-    c6dofimu10_generic_read( ctx, reg, rx_buf, 2 );
+    uint8_t rx_buf[ 6 ] = { 0 };
 
-    data_out = rx_buf[ 1 ];
-    data_out <<= 8;
-    data_out |= rx_buf[ 0 ];
+    c6dofimu10_generic_read( ctx, reg, rx_buf, 6 );
 
-    return data_out;
+    axis->x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    axis->y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    axis->z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
 }
 
 static uint8_t drv_get_register ( c6dofimu10_t *ctx, uint8_t reg )
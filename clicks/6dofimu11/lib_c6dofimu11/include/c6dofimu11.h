@@ -662,7 +662,7 @@ int16_t c6dofimu11_get_axis ( c6dofimu11_t *ctx, uint8_t reg_add_lsb );
  * @param accel_y      Accel y.
  * @param accel_z      Accel z.
  *
- * @description This function get  accel data.
+ * @description This function get  accel data in a single 6-byte read.
  */
 void c6dofimu11_get_accel_data ( c6dofimu11_t *ctx, int16_t *accel_x, int16_t *accel_y, int16_t *accel_z );
 
@@ -674,7 +674,7 @@ void c6dofimu11_get_accel_data ( c6dofimu11_t *ctx, int16_t *accel_x, int16_t *a
  * @param mag_y        Mag y.
  * @param mag_z        Mag z.
  *
- * @description This function get map data.
+ * @description This function get map data in a single 6-byte read.
  */
 void c6dofimu11_get_mag_data ( c6dofimu11_t *ctx, int16_t *mag_x, int16_t *mag_y, int16_t *mag_z );
 
@@ -264,12 +264,11 @@ int16_t c6dofimu11_get_axis ( c6dofimu11_t *ctx, uint8_t reg_add_lsb )
     int16_t res_val;
     uint8_t buf[ 2 ];
 
-    buf[ 0 ] = c6dofimu11_read_byte( ctx,reg_add_lsb + 1 );
-    buf[ 1 ] = c6dofimu11_read_byte( ctx, reg_add_lsb );
+    c6dofimu11_read_multiple_bytes( ctx, reg_add_lsb, buf, 2 );
 
-    axis_val = buf[ 0 ];
+    axis_val = buf[ 1 ];
     axis_val <<= 8;
-    axis_val |= buf[ 1 ];
+    axis_val |= buf[ 0 ];
 
     res_val = ( int16_t ) axis_val;
 
@@ -278,16 +277,24 @@ int16_t c6dofimu11_get_axis ( c6dofimu11_t *ctx, uint8_t reg_add_lsb )
 
 void c6dofimu11_get_accel_data ( c6dofimu11_t *ctx, int16_t *accel_x, int16_t *accel_y, int16_t *accel_z )
 {
-    *accel_x = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_XOUT_L );
-    *accel_y = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_YOUT_L );
-    *accel_z = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_ZOUT_L );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu11_read_multiple_bytes( ctx, C6DOFIMU11_ACCEL_XOUT_L, rx_buf, 6 );
+
+    *accel_x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    *accel_y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    *accel_z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
 }
 
 void c6dofimu11_get_mag_data ( c6dofimu11_t *ctx, int16_t *mag_x, int16_t *mag_y, int16_t *mag_z )
 {
-    *mag_x = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_XOUT_L );
-    *mag_y = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_YOUT_L );
-    *mag_z = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_ZOUT_L );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu11_read_multiple_bytes( ctx, C6DOFIMU11_MAG_XOUT_L, rx_buf, 6 );
+
+    *mag_x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    *mag_y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    *mag_z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
 }
 
 void c6dofimu11_read_accel (  c6dofimu11_t *ctx, c6dofimu11_accel_t *accel_data )
@@ -297,9 +304,7 @@ void c6dofimu11_read_accel (  c6dofimu11_t *ctx, c6dofimu11_accel_t *accel_data
     int16_t accel_z;
     uint8_t c_tmp;
     
-    accel_x = c6dofimu11_get_axis(  ctx, C6DOFIMU11_ACCEL_XOUT_L );
-    accel_y = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_YOUT_L );
-    accel_z = c6dofimu11_get_axis( ctx, C6DOFIMU11_ACCEL_ZOUT_L );
+    c6dofimu11_get_accel_data( ctx, &accel_x, &accel_y, &accel_z );
     
     c_tmp = c6dofimu11_read_byte( ctx, C6DOFIMU11_CNTL2 );
     c_tmp &= C6DOFIMU11_CNTL2_GSEL_MASK;
@@ -356,9 +361,7 @@ void c6dofimu11_read_mag ( c6dofimu11_t *ctx, c6dofimu11_mag_t *mag_data )
     int16_t mag_z;
     uint8_t c_tmp;
     
-    mag_x = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_XOUT_L );
-    mag_y = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_YOUT_L );
-    mag_z = c6dofimu11_get_axis( ctx, C6DOFIMU11_MAG_ZOUT_L );
+    c6dofimu11_get_mag_data( ctx, &mag_x, &mag_y, &mag_z );
     
     mag_data->x = ( float ) mag_x;
     mag_data->x *= C6DOFIMU11_MAG_COEF;
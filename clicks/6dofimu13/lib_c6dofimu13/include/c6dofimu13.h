@@ -568,7 +568,7 @@ err_t c6dofimu13_mag_get_z ( c6dofimu13_t *ctx, float *result );
 
 /**
  * @brief 6DOF IMU 13 Magnetometer get X, Y, and Z-Axis data function.
- * @details This function reads magnetometer X, Y, and Z-Axis data.
+ * @details This function reads magnetometer X, Y, and Z-Axis data in a single burst.
  * @param[in] ctx : Click context object.
  * See #c6dofimu13_t object definition for detailed explanation.
  * @param[out] mag_x : Magnetometer X-Axis data.
@@ -717,7 +717,7 @@ err_t c6dofimu13_accel_get_z ( c6dofimu13_t *ctx, float *result );
 
 /**
  * @brief 6DOF IMU 13 Accelerometer get X, Y, and Z-Axis data function.
- * @details This function reads accelerometer X, Y, and Z-Axis data.
+ * @details This function reads accelerometer X, Y, and Z-Axis data in a single burst.
  * @param[in] ctx : Click context object.
  * See #c6dofimu13_t object definition for detailed explanation.
  * @param[out] accel_x : Accelerometer X-Axis data.
@@ -38,6 +38,32 @@
  */
 static void dev_get_twos_comp ( int16_t *raw, uint8_t length );
 
+/**
+ * @brief 6DOF IMU 13 decode accelerometer axis.
+ * @details This function decodes one raw accelerometer axis sample
+ * according to the configured output resolution.
+ * @param[in] rx_buf : Axis data starting at the EX_L register.
+ * @param[in] res : Output resolution setting.
+ * @param[out] result : Raw axis data.
+ * @note None.
+ *
+ * @endcode
+ */
+static void dev_accel_get_raw_axis ( uint8_t *rx_buf, uint8_t res, int16_t *result );
+
+/**
+ * @brief 6DOF IMU 13 decode magnetometer axis.
+ * @details This function decodes one magnetometer axis sample
+ * according to the configured output range.
+ * @param[in] rx_buf : Axis data starting at the LSB register.
+ * @param[in] range : Content of the CTL_4 register.
+ * @param[out] result : Magnetometer axis data.
+ * @note None.
+ *
+ * @endcode
+ */
+static void dev_mag_get_axis ( uint8_t *rx_buf, uint8_t range, float *result );
+
 void c6dofimu13_cfg_setup ( c6dofimu13_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -214,7 +240,6 @@ err_t c6dofimu13_mag_init ( c6dofimu13_t *ctx, uint8_t res, uint8_t op_mode, uin
 
 err_t c6dofimu13_mag_get_x ( c6dofimu13_t *ctx, float *result )
 {
-    int16_t adc_val;
     uint8_t range;
     uint8_t rx_buf[ 2 ];
     err_t error_check;
@@ -224,107 +249,39 @@ err_t c6dofimu13_mag_get_x ( c6dofimu13_t *ctx, float *result )
     error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_MAG_CTL_4, &range, 1 );
 
     error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_MAG_OUT_X_LSB, rx_buf, 2 );
-
-    adc_val = rx_buf[ 1 ];
-    adc_val <<= 8;
-    adc_val |= rx_buf[ 0 ];
-
-    if ( range & C6DOFIMU13_MAG_CTL_4_RS_S_15 )
-    {
-        adc_val &= 0x7FFF;
-        if ( adc_val & 0x4000 )
-        {
-            dev_get_twos_comp( &adc_val, 15 );
-        }
-    }
-    else
-    {
-        adc_val &= 0x3FFF;
-        if ( adc_val & 0x2000 )
-        {
-            dev_get_twos_comp( &adc_val, 14 );
-        }
-    }
-
-    *result = ( float ) adc_val * C6DOFIMU13_MAG_SENS;
+    dev_mag_get_axis( rx_buf, range, result );
 
     return error_check;
 }
 
 err_t c6dofimu13_mag_get_y ( c6dofimu13_t *ctx, float *result )
 {
-    int16_t adc_val;
     uint8_t range;
     uint8_t rx_buf[ 2 ];
     err_t error_check;
     
     error_check = c6dofimu13_set_slave_address ( ctx, C6DOFIMU13_DEV_ADDRESS_MAG );
-    
+
     error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_MAG_CTL_4, &range, 1 );
 
     error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_MAG_OUT_Y_LSB, rx_buf, 2 );
-
-    adc_val = rx_buf[ 1 ];
-    adc_val <<= 8;
-    adc_val |= rx_buf[ 0 ];
-
-    if ( range & C6DOFIMU13_MAG_CTL_4_RS_S_15 )
-    {
-        adc_val &= 0x7FFF;
-        if ( adc_val & 0x4000 )
-        {
-            dev_get_twos_comp( &adc_val, 15 );
-        }
-    }
-    else
-    {
-        adc_val &= 0x3FFF;
-        if ( adc_val & 0x2000 )
-        {
-            dev_get_twos_comp( &adc_val, 14 );
-        }
-    }
-
-    *result = ( float ) adc_val * C6DOFIMU13_MAG_SENS;
+    dev_mag_get_axis( rx_buf, range, result );
 
     return error_check;
 }
 
 err_t c6dofimu13_mag_get_z ( c6dofimu13_t *ctx, float *result )
 {
-    int16_t adc_val;
     uint8_t range;
     uint8_t rx_buf[ 2 ];
     err_t error_check;
     
     error_check = c6dofimu13_set_slave_address ( ctx, C6DOFIMU13_DEV_ADDRESS_MAG );
-    
+
     error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_MAG_CTL_4, &range, 1 );
 
     error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_MAG_OUT_Z_LSB, rx_buf, 2 );
-
-    adc_val = rx_buf[ 1 ];
-    adc_val <<= 8;
-    adc_val |= rx_buf[ 0 ];
-
-    if ( range & C6DOFIMU13_MAG_CTL_4_RS_S_15 )
-    {
-        adc_val &= 0x7FFF;
-        if ( adc_val & 0x4000 )
-        {
-            dev_get_twos_comp( &adc_val, 15 );
-        }
-    }
-    else
-    {
-        adc_val &= 0x3FFF;
-        if ( adc_val & 0x2000 )
-        {
-            dev_get_twos_comp( &adc_val, 14 );
-        }
-    }
-
-    *result = ( float ) adc_val * C6DOFIMU13_MAG_SENS;
+    dev_mag_get_axis( rx_buf, range, result );
 
     return error_check;
 }
@@ -333,9 +290,17 @@ err_t c6dofimu13_mag_get_data ( c6dofimu13_t *ctx, float *mag_x, float *mag_y, f
 {
     err_t error_check;
     
-    error_check = c6dofimu13_mag_get_x( ctx, mag_x );
-    error_check |= c6dofimu13_mag_get_y( ctx, mag_y );
-    error_check |= c6dofimu13_mag_get_z( ctx, mag_z );
+    uint8_t range;
+    uint8_t rx_buf[ 6 ];
+    
+    error_check = c6dofimu13_set_slave_address ( ctx, C6DOFIMU13_DEV_ADDRESS_MAG );
+
+    error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_MAG_CTL_4, &range, 1 );
+
+    error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_MAG_OUT_X_LSB, rx_buf, 6 );
+    dev_mag_get_axis( &rx_buf[ 0 ], range, mag_x );
+    dev_mag_get_axis( &rx_buf[ 2 ], range, mag_y );
+    dev_mag_get_axis( &rx_buf[ 4 ], range, mag_z );
     
     return error_check;
 }
@@ -485,96 +450,8 @@ err_t c6dofimu13_accel_get_raw_x ( c6dofimu13_t *ctx, int16_t *result )
     error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_OUTCFG, &res, 1 );
     res &= 0x07;
     
-    if ( res < C6DOFIMU13_ACCEL_OUTCFG_RES_10 )
-    {
-        error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_XOUT_EX_L, rx_buf, 1 );
-        *result = rx_buf[ 0 ];
-        switch( res )
-        {
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_6:
-            {
-                *result &= 0x003F;
-                if ( *result > 0x001F )
-                {
-                    dev_get_twos_comp( result, 6 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_7:
-            {
-                *result &= 0x007F;
-                if ( *result > 0x003F )
-                {
-                    dev_get_twos_comp( result, 7 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_8:
-            {
-                *result &= 0x00FF;
-                if ( *result > 0x007F )
-                {
-                    dev_get_twos_comp( result, 8 );
-                }
-                break;
-            }
-            default:
-            {
-                *result &= 0x003F;
-                if ( *result > 0x001F )
-                {
-                    dev_get_twos_comp( result, 6 );
-                }
-            }
-        }
-    }
-    else
-    {
-        error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_XOUT_EX_L, rx_buf, 2 );
-        *result = rx_buf[ 1 ];
-        *result <<= 8;
-        *result |= rx_buf[ 0 ];
-        
-        switch( res )
-        {
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_10:
-            {
-                *result &= 0x03FF;
-                if ( *result > 0x01FF )
-                {
-                    dev_get_twos_comp( result, 10 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_12:
-            {
-                *result &= 0x0FFF;
-                if ( *result > 0x07FF )
-                {
-                    dev_get_twos_comp( result, 12 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_14:
-            {
-                *result &= 0x3FFF;
-                if ( *result > 0x1FFF )
-                {
-                    dev_get_twos_comp( result, 14 );
-                }
-                break;
-            }
-            default:
-            {
-                *result &= 0x03FF;
-                if ( *result > 0x01FF )
-                {
-                    dev_get_twos_comp( result, 10 );
-                }
-                break;
-            }
-        }
-    }
+    error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_XOUT_EX_L, rx_buf, 2 );
+    dev_accel_get_raw_axis( rx_buf, res, result );
 
     return error_check;
 }
@@ -590,96 +467,8 @@ err_t c6dofimu13_accel_get_raw_y ( c6dofimu13_t *ctx, int16_t *result )
     error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_OUTCFG, &res, 1 );
     res &= 0x07;
     
-    if ( res < C6DOFIMU13_ACCEL_OUTCFG_RES_10 )
-    {
-        error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_YOUT_EX_L, rx_buf, 1 );
-        *result = rx_buf[ 0 ];
-        switch( res )
-        {
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_6:
-            {
-                *result &= 0x003F;
-                if ( *result > 0x001F )
-                {
-                    dev_get_twos_comp( result, 6 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_7:
-            {
-                *result &= 0x007F;
-                if ( *result > 0x003F )
-                {
-                    dev_get_twos_comp( result, 7 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_8:
-            {
-                *result &= 0x00FF;
-                if ( *result > 0x007F )
-                {
-                    dev_get_twos_comp( result, 8 );
-                }
-                break;
-            }
-            default:
-            {
-                *result &= 0x003F;
-                if ( *result > 0x001F )
-                {
-                    dev_get_twos_comp( result, 6 );
-                }
-            }
-        }
-    }
-    else
-    {
-        error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_YOUT_EX_L, rx_buf, 2 );
-        *result = rx_buf[ 1 ];
-        *result <<= 8;
-        *result |= rx_buf[ 0 ];
-        
-        switch( res )
-        {
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_10:
-            {
-                *result &= 0x03FF;
-                if ( *result > 0x01FF )
-                {
-                    dev_get_twos_comp( result, 10 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_12:
-            {
-                *result &= 0x0FFF;
-                if ( *result > 0x07FF )
-                {
-                    dev_get_twos_comp( result, 12 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_14:
-            {
-                *result &= 0x3FFF;
-                if ( *result > 0x1FFF )
-                {
-                    dev_get_twos_comp( result, 14 );
-                }
-                break;
-            }
-            default:
-            {
-                *result &= 0x03FF;
-                if ( *result > 0x01FF )
-                {
-                    dev_get_twos_comp( result, 10 );
-                }
-                break;
-            }
-        }
-    }
+    error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_YOUT_EX_L, rx_buf, 2 );
+    dev_accel_get_raw_axis( rx_buf, res, result );
 
     return error_check;
 }
@@ -695,96 +484,8 @@ err_t c6dofimu13_accel_get_raw_z ( c6dofimu13_t *ctx, int16_t *result )
     error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_OUTCFG, &res, 1 );
     res &= 0x07;
     
-    if ( res < C6DOFIMU13_ACCEL_OUTCFG_RES_10 )
-    {
-        error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_ZOUT_EX_L, rx_buf, 1 );
-        *result = rx_buf[ 0 ];
-        switch( res )
-        {
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_6:
-            {
-                *result &= 0x003F;
-                if ( *result > 0x001F )
-                {
-                    dev_get_twos_comp( result, 6 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_7:
-            {
-                *result &= 0x007F;
-                if ( *result > 0x003F )
-                {
-                    dev_get_twos_comp( result, 7 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_8:
-            {
-                *result &= 0x00FF;
-                if ( *result > 0x007F )
-                {
-                    dev_get_twos_comp( result, 8 );
-                }
-                break;
-            }
-            default:
-            {
-                *result &= 0x003F;
-                if ( *result > 0x001F )
-                {
-                    dev_get_twos_comp( result, 6 );
-                }
-            }
-        }
-    }
-    else
-    {
-        error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_ZOUT_EX_L, rx_buf, 2 );
-        *result = rx_buf[ 1 ];
-        *result <<= 8;
-        *result |= rx_buf[ 0 ];
-        
-        switch( res )
-        {
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_10:
-            {
-                *result &= 0x03FF;
-                if ( *result > 0x01FF )
-                {
-                    dev_get_twos_comp( result, 10 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_12:
-            {
-                *result &= 0x0FFF;
-                if ( *result > 0x07FF )
-                {
-                    dev_get_twos_comp( result, 12 );
-                }
-                break;
-            }
-            case C6DOFIMU13_ACCEL_OUTCFG_RES_14:
-            {
-                *result &= 0x3FFF;
-                if ( *result > 0x1FFF )
-                {
-                    dev_get_twos_comp( result, 14 );
-                }
-                break;
-            }
-            default:
-            {
-                *result &= 0x03FF;
-                if ( *result > 0x01FF )
-                {
-                    dev_get_twos_comp( result, 10 );
-                }
-                break;
-            }
-        }
-    }
+    error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_ZOUT_EX_L, rx_buf, 2 );
+    dev_accel_get_raw_axis( rx_buf, res, result );
 
     return error_check;
 }
@@ -832,9 +533,22 @@ err_t c6dofimu13_accel_get_data ( c6dofimu13_t *ctx, float *accel_x, float *acce
 {
     err_t error_check;
     
-    error_check = c6dofimu13_accel_get_x( ctx, accel_x );
-    error_check |= c6dofimu13_accel_get_y( ctx, accel_y );
-    error_check |= c6dofimu13_accel_get_z( ctx, accel_z );
+    int16_t adc_val;
+    uint8_t rx_buf[ 6 ];
+    uint8_t res;
+    
+    error_check = c6dofimu13_set_slave_address ( ctx, ctx->slave_address );
+    
+    error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_OUTCFG, &res, 1 );
+    res &= 0x07;
+    
+    error_check |= c6dofimu13_generic_read( ctx, C6DOFIMU13_ACCEL_XOUT_EX_L, rx_buf, 6 );
+    dev_accel_get_raw_axis( &rx_buf[ 0 ], res, &adc_val );
+    *accel_x = ( float ) adc_val / ctx->calc_coef;
+    dev_accel_get_raw_axis( &rx_buf[ 2 ], res, &adc_val );
+    *accel_y = ( float ) adc_val / ctx->calc_coef;
+    dev_accel_get_raw_axis( &rx_buf[ 4 ], res, &adc_val );
+    *accel_z = ( float ) adc_val / ctx->calc_coef;
     
     return error_check;
 }
@@ -892,6 +606,126 @@ static void dev_get_twos_comp ( int16_t *raw, uint8_t length )
     }
 }
 
+static void dev_accel_get_raw_axis ( uint8_t *rx_buf, uint8_t res, int16_t *result )
+{
+    if ( res < C6DOFIMU13_ACCEL_OUTCFG_RES_10 )
+    {
+        *result = rx_buf[ 0 ];
+        switch( res )
+        {
+            case C6DOFIMU13_ACCEL_OUTCFG_RES_6:
+            {
+                *result &= 0x003F;
+                if ( *result > 0x001F )
+                {
+                    dev_get_twos_comp( result, 6 );
+                }
+                break;
+            }
+            case C6DOFIMU13_ACCEL_OUTCFG_RES_7:
+            {
+                *result &= 0x007F;
+                if ( *result > 0x003F )
+                {
+                    dev_get_twos_comp( result, 7 );
+                }
+                break;
+            }
+            case C6DOFIMU13_ACCEL_OUTCFG_RES_8:
+            {
+                *result &= 0x00FF;
+                if ( *result > 0x007F )
+                {
+                    dev_get_twos_comp( result, 8 );
+                }
+                break;
+            }
+            default:
+            {
+                *result &= 0x003F;
+                if ( *result > 0x001F )
+                {
+                    dev_get_twos_comp( result, 6 );
+                }
+            }
+        }
+    }
+    else
+    {
+        *result = rx_buf[ 1 ];
+        *result <<= 8;
+        *result |= rx_buf[ 0 ];
+        
+        switch( res )
+        {
+            case C6DOFIMU13_ACCEL_OUTCFG_RES_10:
+            {
+                *result &= 0x03FF;
+                if ( *result > 0x01FF )
+                {
+                    dev_get_twos_comp( result, 10 );
+                }
+                break;
+            }
+            case C6DOFIMU13_ACCEL_OUTCFG_RES_12:
+            {
+                *result &= 0x0FFF;
+                if ( *result > 0x07FF )
+                {
+                    dev_get_twos_comp( result, 12 );
+                }
+                break;
+            }
+            case C6DOFIMU13_ACCEL_OUTCFG_RES_14:
+            {
+                *result &= 0x3FFF;
+                if ( *result > 0x1FFF )
+                {
+                    dev_get_twos_comp( result, 14 );
+                }
+                break;
+            }
+            default:
+            {
+                *result &= 0x03FF;
+                if ( *result > 0x01FF )
+                {
+                    dev_get_twos_comp( result, 10 );
+                }
+                break;
+            }
+        }
+    }
+}
+
+static void dev_mag_get_axis ( uint8_t *rx_buf, uint8_t range, float *result )
+{
+    int16_t adc_val;
+
+    adc_val = rx_buf[ 1 ];
+    adc_val <<= 8;
+    adc_val |= rx_buf[ 0 ];
+
+    if ( range & C6DOFIMU13_MAG_CTL_4_RS_S_15 )
+    {
+        adc_val &= 0x7FFF;
+        if ( adc_val & 0x4000 )
+        {
+            dev_get_twos_comp( &adc_val, 15 );
+        }
+    }
+    else
+    {
+        adc_val &= 0x3FFF;
+        if ( adc_val & 0x2000 )
+        {
+            dev_get_twos_comp( &adc_val, 14 );
+        }
+    }
+
+    *result = ( float ) adc_val * C6DOFIMU13_MAG_SENS;
+}
+
 // ------------------------------------------------------------------------- END
 
 
@@ -947,6 +947,24 @@ err_t c6dofimu14_get_accel_axis ( c6dofimu14_t *ctx, c6dofimu14_axis_t *axis );
  */
 err_t c6dofimu14_get_gyro_axis ( c6dofimu14_t *ctx, c6dofimu14_axis_t *axis );
 
+/**
+ * @brief 6DOF IMU 14 get sensor data function.
+ * @details This function reads temperature, accel and gyro data of the same
+ * sample from the sensor data registers in a single bus transaction.
+ * @param[in] ctx : Click context object.
+ * See #c6dofimu14_t object definition for detailed explanation.
+ * @param[out] temp : Temperature in Celsius.
+ * @param[out] acc_axis : Accel axis output.
+ * @param[out] gyro_axis : Gyro axis output.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t c6dofimu14_get_sensor_data ( c6dofimu14_t *ctx, float *temp, c6dofimu14_axis_t *acc_axis, 
+                                   c6dofimu14_axis_t *gyro_axis );
+
 #ifdef __cplusplus
 }
 #endif
@@ -353,51 +353,46 @@ err_t c6dofimu14_get_temperature ( c6dofimu14_t *ctx, float *temp )
 
 err_t c6dofimu14_get_accel_axis ( c6dofimu14_t *ctx, c6dofimu14_axis_t *axis )
 {
-    uint8_t tmp_data;
+    uint8_t tmp_data[ 6 ];
     err_t error_check = c6dofimu14_check_data_ready ( ctx, C6DOFIMU14_INTSTATUS_DATA_RDY );
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_ACCEL_X_MSB, &tmp_data, 1 );
-    axis->x = tmp_data;
-    axis->x <<= 8;
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_ACCEL_X_LSB, &tmp_data, 1 );
-    axis->x |= tmp_data;
-
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_ACCEL_Y_MSB, &tmp_data, 1 );
-    axis->y = tmp_data;
-    axis->y <<= 8;
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_ACCEL_Y_LSB, &tmp_data, 1 );
-    axis->y |= tmp_data;
-    
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_ACCEL_Z_MSB, &tmp_data, 1 );
-    axis->z = tmp_data;
-    axis->z <<= 8;
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_ACCEL_Z_LSB, &tmp_data, 1 );
-    axis->z |= tmp_data;
+    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_ACCEL_X_MSB, tmp_data, 6 );
+    axis->x = ( ( int16_t ) tmp_data[ 0 ] << 8 ) | tmp_data[ 1 ];
+    axis->y = ( ( int16_t ) tmp_data[ 2 ] << 8 ) | tmp_data[ 3 ];
+    axis->z = ( ( int16_t ) tmp_data[ 4 ] << 8 ) | tmp_data[ 5 ];
     
     return error_check;
 }
 
 err_t c6dofimu14_get_gyro_axis ( c6dofimu14_t *ctx, c6dofimu14_axis_t *axis )
 {
-    uint8_t tmp_data;
+    uint8_t tmp_data[ 6 ];
     
     err_t error_check = c6dofimu14_check_data_ready ( ctx, C6DOFIMU14_INTSTATUS_DATA_RDY );
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_GYRO_X_MSB, &tmp_data, 1 );
-    axis->x = tmp_data;
-    axis->x <<= 8;
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_GYRO_X_LSB, &tmp_data, 1 );
-    axis->x |= tmp_data;
-
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_GYRO_Y_MSB, &tmp_data, 1 );
-    axis->y = tmp_data;
-    axis->y <<= 8;
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_GYRO_Y_LSB, &tmp_data, 1 );
-    axis->y |= tmp_data;
+    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_GYRO_X_MSB, tmp_data, 6 );
+    axis->x = ( ( int16_t ) tmp_data[ 0 ] << 8 ) | tmp_data[ 1 ];
+    axis->y = ( ( int16_t ) tmp_data[ 2 ] << 8 ) | tmp_data[ 3 ];
+    axis->z = ( ( int16_t ) tmp_data[ 4 ] << 8 ) | tmp_data[ 5 ];
     
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_GYRO_Z_MSB, &tmp_data, 1 );
-    axis->z = tmp_data;
-    axis->z <<= 8;
-    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_GYRO_Z_LSB, &tmp_data, 1 );
-    axis->z |= tmp_data;
+    return error_check;
+}
+
+err_t c6dofimu14_get_sensor_data ( c6dofimu14_t *ctx, float *temp, c6dofimu14_axis_t *acc_axis, 
+                                   c6dofimu14_axis_t *gyro_axis )
+{
+    uint8_t tmp_data[ 14 ];
+    int16_t raw_data;
+    
+    err_t error_check = c6dofimu14_check_data_ready ( ctx, C6DOFIMU14_INTSTATUS_DATA_RDY );
+    // Temperature, accel and gyro data registers are contiguous
+    error_check |= c6dofimu14_generic_read( ctx, C6DOFIMU14_REG0_TEMP_DATA_MSB, tmp_data, 14 );
+    raw_data = ( ( int16_t ) tmp_data[ 0 ] << 8 ) | tmp_data[ 1 ];
+    *temp = ( ( float ) raw_data / 132.48 ) + 25.00;
+    acc_axis->x = ( ( int16_t ) tmp_data[ 2 ] << 8 ) | tmp_data[ 3 ];
+    acc_axis->y = ( ( int16_t ) tmp_data[ 4 ] << 8 ) | tmp_data[ 5 ];
+    acc_axis->z = ( ( int16_t ) tmp_data[ 6 ] << 8 ) | tmp_data[ 7 ];
+    gyro_axis->x = ( ( int16_t ) tmp_data[ 8 ] << 8 ) | tmp_data[ 9 ];
+    gyro_axis->y = ( ( int16_t ) tmp_data[ 10 ] << 8 ) | tmp_data[ 11 ];
+    gyro_axis->z = ( ( int16_t ) tmp_data[ 12 ] << 8 ) | tmp_data[ 13 ];
     
     return error_check;
 }
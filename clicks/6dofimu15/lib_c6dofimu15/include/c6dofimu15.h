@@ -202,7 +202,7 @@
 #define C6DOFIMU15_BDR_XL_208_HZ        0x05
 #define C6DOFIMU15_BDR_XL_417_HZ        0x06
 #define C6DOFIMU15_BDR_XL_833_HZ        0x07
-#define C6DOFIMU15_BDR_XL_1667_HZ       0x80
+#define C6DOFIMU15_BDR_XL_1667_HZ       0x08
 #define C6DOFIMU15_BDR_XL_3333_HZ       0x09
 #define C6DOFIMU15_BDR_XL_6667_HZ       0x0A
 /** \} */
@@ -514,6 +514,26 @@
 #define C6DOFIMU15_TAG_SEN_TEMP            0x18
 #define C6DOFIMU15_TAG_SEN_T_ST            0x20
 #define C6DOFIMU15_TAG_SEN_CFG_CHN         0x28
+#define C6DOFIMU15_TAG_SEN_MASK            0xF8
+/** \} */
+ 
+/**
+ * \defgroup fifo_status  FIFO status
+ * \{
+ */
+#define C6DOFIMU15_FIFO_WTM_IA             0x80
+#define C6DOFIMU15_FIFO_OVR_IA             0x40
+#define C6DOFIMU15_FIFO_FULL_IA            0x20
+#define C6DOFIMU15_FIFO_DIFF_MSB_MASK      0x03
+/** \} */
+ 
+/**
+ * \defgroup fifo_stream  FIFO stream
+ * \{
+ */
+#define C6DOFIMU15_FIFO_WTM_MAX            511
+#define C6DOFIMU15_FIFO_WORD_SIZE          7
+#define C6DOFIMU15_FIFO_BURST_WORDS        36
 /** \} */
  
 /**
@@ -645,6 +665,50 @@ typedef struct
 
 } c6dofimu15_cfg_t;
 
+/**
+ * @brief Output data structure definition.
+ */
+typedef struct
+{
+    int16_t temp_out;
+    int16_t gyro_x;
+    int16_t gyro_y;
+    int16_t gyro_z;
+    int16_t accel_x;
+    int16_t accel_y;
+    int16_t accel_z;
+
+} c6dofimu15_data_t;
+
+/**
+ * @brief FIFO sample structure definition.
+ */
+typedef struct
+{
+    uint8_t  tag;
+    int16_t  x;
+    int16_t  y;
+    int16_t  z;
+    uint32_t timestamp;
+
+} c6dofimu15_fifo_sample_t;
+
+/**
+ * @brief FIFO ring buffer structure definition.
+ */
+typedef struct
+{
+    c6dofimu15_fifo_sample_t *buf;
+    uint16_t size;
+    uint16_t head;
+    uint16_t tail;
+    uint16_t count;
+    uint16_t dropped;
+    uint32_t timestamp;
+    uint8_t  status;
+
+} c6dofimu15_fifo_ring_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 /**
@@ -856,6 +920,18 @@ void c6dofimu15_acceleration_rate ( c6dofimu15_t *ctx, float *x_acel_rte
 **/
 float c6dofimu15_read_temp_out ( c6dofimu15_t *ctx );
 
+/**
+ * @brief Read output data function
+ *
+ * @param ctx        Click object.
+ * @param data_out   Temperature, gyroscope and accelerometer raw data.
+ *
+ * @description Function is used to read temperature, gyroscope and accelerometer
+ * data of the same sample in a single bus transaction. Register address
+ * auto increment must be enabled, which is done by the default config.
+**/
+void c6dofimu15_read_data ( c6dofimu15_t *ctx, c6dofimu15_data_t *data_out );
+
 /**
  * @brief Disable I2C block function
  *
@@ -1002,6 +1078,74 @@ uint8_t c6dofimu15_temp_data_rdy ( c6dofimu15_t *ctx );
 **/
 uint8_t c6dofimu15_who_im_i ( c6dofimu15_t *ctx );
 
+/**
+ * @brief FIFO stream configuration function
+ *
+ * @param ctx        Click object.
+ * @param watermark  FIFO watermark threshold in words ( max 511 ).
+ * @param bdr_xl     Accelerometer batch data rate ( C6DOFIMU15_BDR_XL_x ).
+ * @param bdr_gy     Gyroscope batch data rate ( C6DOFIMU15_BDR_GY_x ).
+ * @param dec_ts     Timestamp batching decimation ( C6DOFIMU15_DEC_TS_BATCH_x ),
+ *                   0 disables timestamp batching.
+ *
+ * @description Function sets the FIFO watermark and batching rates, enables
+ * the timestamp counter when timestamp batching is requested, puts the FIFO
+ * in continuous mode and routes the watermark flag to the INT1 pin.
+**/
+void c6dofimu15_fifo_config ( c6dofimu15_t *ctx, uint16_t watermark, uint8_t bdr_xl, uint8_t bdr_gy, uint8_t dec_ts );
+
+/**
+ * @brief FIFO level function
+ *
+ * @param ctx        Click object.
+ * @param status     FIFO_STATUS2 flags ( C6DOFIMU15_FIFO_WTM_IA, _OVR_IA, _FULL_IA ).
+ *
+ * @returns number of unread words in the FIFO
+ *
+ * @description Function reads both FIFO status registers in a single transaction.
+**/
+uint16_t c6dofimu15_fifo_get_level ( c6dofimu15_t *ctx, uint8_t *status );
+
+/**
+ * @brief FIFO ring buffer initialization function
+ *
+ * @param ring       FIFO ring buffer object.
+ * @param buf        Caller supplied sample storage.
+ * @param size       Number of samples in the storage.
+ *
+ * @description Function binds the caller storage to the ring and empties it.
+**/
+void c6dofimu15_fifo_ring_init ( c6dofimu15_fifo_ring_t *ring, c6dofimu15_fifo_sample_t *buf, uint16_t size );
+
+/**
+ * @brief FIFO ring buffer pop function
+ *
+ * @param ring       FIFO ring buffer object.
+ * @param sample     Oldest sample in the ring.
+ *
+ * @returns 1 if a sample was taken, 0 if the ring is empty
+ *
+ * @description Function takes the oldest accelerometer or gyroscope sample from the ring.
+**/
+uint8_t c6dofimu15_fifo_ring_pop ( c6dofimu15_fifo_ring_t *ring, c6dofimu15_fifo_sample_t *sample );
+
+/**
+ * @brief FIFO read function
+ *
+ * @param ctx        Click object.
+ * @param ring       FIFO ring buffer object.
+ *
+ * @returns number of FIFO words read
+ *
+ * @description Function drains the FIFO in bursts of up to 36 tagged words per
+ * bus transaction and demultiplexes them into the ring. Accelerometer and
+ * gyroscope words are stored with the last batched timestamp, timestamp words
+ * update it and the remaining words are discarded.
+ * @note When the ring is full the oldest sample is overwritten and counted in
+ * ring->dropped. ring->status holds the FIFO_STATUS2 flags read before draining.
+**/
+uint16_t c6dofimu15_fifo_read ( c6dofimu15_t *ctx, c6dofimu15_fifo_ring_t *ring );
+
 #ifdef __cplusplus
 }
 #endif
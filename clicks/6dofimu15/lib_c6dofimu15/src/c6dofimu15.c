@@ -209,9 +209,13 @@ void c6dofimu15_read_gyroscope ( c6dofimu15_t *ctx, int16_t *gyro_x
                                , int16_t *gyro_y
                                , int16_t *gyro_z )
 {
-    *gyro_x = c6dofimu15_read_gyro_x( ctx );
-    *gyro_y = c6dofimu15_read_gyro_y( ctx );
-    *gyro_z = c6dofimu15_read_gyro_z( ctx );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu15_generic_read( ctx, C6DOFIMU15_OUTX_L_G, rx_buf, 6 );
+
+    *gyro_x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    *gyro_y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    *gyro_z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
 }
 
 void c6dofimu15_angular_rate ( c6dofimu15_t *ctx, float *x_ang_rte
@@ -333,9 +337,13 @@ void c6dofimu15_read_accelerometer ( c6dofimu15_t *ctx, int16_t *accel_x
                                    , int16_t *accel_y
                                    , int16_t *accel_z )
 {
-    *accel_x = c6dofimu15_read_accel_x( ctx );
-    *accel_y = c6dofimu15_read_accel_y( ctx );
-    *accel_z = c6dofimu15_read_accel_z( ctx );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu15_generic_read( ctx, C6DOFIMU15_OUTX_L_A, rx_buf, 6 );
+
+    *accel_x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    *accel_y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    *accel_z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
 }
 
 void c6dofimu15_acceleration_rate ( c6dofimu15_t *ctx, float *x_acel_rte
@@ -412,6 +420,22 @@ float c6dofimu15_read_temp_out ( c6dofimu15_t *ctx )
     return result;
 }
 
+void c6dofimu15_read_data ( c6dofimu15_t *ctx, c6dofimu15_data_t *data_out )
+{
+    uint8_t rx_buf[ 14 ];
+
+    // OUT_TEMP_L to OUTZ_H_A are contiguous
+    c6dofimu15_generic_read( ctx, C6DOFIMU15_OUT_TEMP_L, rx_buf, 14 );
+
+    data_out->temp_out = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    data_out->gyro_x = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    data_out->gyro_y = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
+    data_out->gyro_z = ( ( int16_t ) rx_buf[ 7 ] << 8 ) | rx_buf[ 6 ];
+    data_out->accel_x = ( ( int16_t ) rx_buf[ 9 ] << 8 ) | rx_buf[ 8 ];
+    data_out->accel_y = ( ( int16_t ) rx_buf[ 11 ] << 8 ) | rx_buf[ 10 ];
+    data_out->accel_z = ( ( int16_t ) rx_buf[ 13 ] << 8 ) | rx_buf[ 12 ];
+}
+
 void c6dofimu15_i2c_disable ( c6dofimu15_t *ctx, uint8_t com_sel )
 {
     uint8_t aux_reg_val = 0;
@@ -628,6 +652,155 @@ uint8_t c6dofimu15_who_im_i ( c6dofimu15_t *ctx )
     }
 }
 
+void c6dofimu15_fifo_config ( c6dofimu15_t *ctx, uint16_t watermark, uint8_t bdr_xl, uint8_t bdr_gy, uint8_t dec_ts )
+{
+    uint8_t fifo_ctl[ 4 ];
+    uint8_t aux_reg_val = 0;
+
+    if ( watermark > C6DOFIMU15_FIFO_WTM_MAX )
+    {
+        watermark = C6DOFIMU15_FIFO_WTM_MAX;
+    }
+
+    c6dofimu15_generic_read( ctx, C6DOFIMU15_FIFO_CTL1, fifo_ctl, 4 );
+
+    fifo_ctl[ 0 ] = ( uint8_t ) watermark;
+    fifo_ctl[ 1 ] &= 0xFE;
+    fifo_ctl[ 1 ] |= ( uint8_t ) ( watermark >> 8 );
+    fifo_ctl[ 2 ] = ( bdr_gy & 0xF0 ) | ( bdr_xl & 0x0F );
+    fifo_ctl[ 3 ] &= 0x30;
+    fifo_ctl[ 3 ] |= ( dec_ts & 0xC0 ) | C6DOFIMU15_CONT_MODE;
+
+    c6dofimu15_generic_write( ctx, C6DOFIMU15_FIFO_CTL1, fifo_ctl, 4 );
+
+    c6dofimu15_generic_read( ctx, C6DOFIMU15_CTL10_C, &aux_reg_val, 1 );
+
+    if ( dec_ts == 0 )
+    {
+        aux_reg_val &= ~C6DOFIMU15_T_STAMP_EN;
+    }
+    else
+    {
+        aux_reg_val |= C6DOFIMU15_T_STAMP_EN;
+    }
+
+    c6dofimu15_generic_write( ctx, C6DOFIMU15_CTL10_C, &aux_reg_val, 1 );
+
+    c6dofimu15_generic_read( ctx, C6DOFIMU15_INT1_CTL, &aux_reg_val, 1 );
+    aux_reg_val |= C6DOFIMU15_INT1_FIFO_TH;
+    c6dofimu15_generic_write( ctx, C6DOFIMU15_INT1_CTL, &aux_reg_val, 1 );
+}
+
+uint16_t c6dofimu15_fifo_get_level ( c6dofimu15_t *ctx, uint8_t *status )
+{
+    uint8_t rx_buf[ 2 ];
+    uint16_t level;
+
+    c6dofimu15_generic_read( ctx, C6DOFIMU15_FIFO_STAT1, rx_buf, 2 );
+
+    *status = rx_buf[ 1 ] & ( C6DOFIMU15_FIFO_WTM_IA | C6DOFIMU15_FIFO_OVR_IA | C6DOFIMU15_FIFO_FULL_IA );
+
+    level = rx_buf[ 1 ] & C6DOFIMU15_FIFO_DIFF_MSB_MASK;
+    level <<= 8;
+    level |= rx_buf[ 0 ];
+
+    return level;
+}
+
+void c6dofimu15_fifo_ring_init ( c6dofimu15_fifo_ring_t *ring, c6dofimu15_fifo_sample_t *buf, uint16_t size )
+{
+    ring->buf = buf;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->count = 0;
+    ring->dropped = 0;
+    ring->timestamp = 0;
+    ring->status = 0;
+}
+
+uint8_t c6dofimu15_fifo_ring_pop ( c6dofimu15_fifo_ring_t *ring, c6dofimu15_fifo_sample_t *sample )
+{
+    if ( ring->count == 0 )
+    {
+        return 0;
+    }
+
+    *sample = ring->buf[ ring->tail ];
+    ring->tail = ( ring->tail + 1 ) % ring->size;
+    ring->count--;
+
+    return 1;
+}
+
+uint16_t c6dofimu15_fifo_read ( c6dofimu15_t *ctx, c6dofimu15_fifo_ring_t *ring )
+{
+    uint8_t rx_buf[ C6DOFIMU15_FIFO_BURST_WORDS * C6DOFIMU15_FIFO_WORD_SIZE ];
+    uint8_t *word;
+    uint8_t tag;
+    uint8_t n_words;
+    uint8_t cnt;
+    uint16_t level;
+    uint16_t n_read = 0;
+    c6dofimu15_fifo_sample_t *sample;
+
+    level = c6dofimu15_fifo_get_level( ctx, &ring->status );
+
+    while ( level > 0 )
+    {
+        n_words = ( level > C6DOFIMU15_FIFO_BURST_WORDS ) ? C6DOFIMU15_FIFO_BURST_WORDS : level;
+
+        c6dofimu15_generic_read( ctx, C6DOFIMU15_FIFO_DATA_OUT_TAG, rx_buf, n_words * C6DOFIMU15_FIFO_WORD_SIZE );
+
+        for ( cnt = 0; cnt < n_words; cnt++ )
+        {
+            word = &rx_buf[ cnt * C6DOFIMU15_FIFO_WORD_SIZE ];
+            tag = word[ 0 ] & C6DOFIMU15_TAG_SEN_MASK;
+
+            if ( tag == C6DOFIMU15_TAG_SEN_T_ST )
+            {
+                ring->timestamp = word[ 4 ];
+                ring->timestamp <<= 8;
+                ring->timestamp |= word[ 3 ];
+                ring->timestamp <<= 8;
+                ring->timestamp |= word[ 2 ];
+                ring->timestamp <<= 8;
+                ring->timestamp |= word[ 1 ];
+            }
+            else if ( ( tag == C6DOFIMU15_TAG_SEN_ACEL ) || ( tag == C6DOFIMU15_TAG_SEN_GYRO ) )
+            {
+                if ( ring->count == ring->size )
+                {
+                    ring->tail = ( ring->tail + 1 ) % ring->size;
+                    ring->count--;
+                    ring->dropped++;
+                }
+
+                sample = &ring->buf[ ring->head ];
+                sample->tag = tag;
+                sample->x = word[ 2 ];
+                sample->x <<= 8;
+                sample->x |= word[ 1 ];
+                sample->y = word[ 4 ];
+                sample->y <<= 8;
+                sample->y |= word[ 3 ];
+                sample->z = word[ 6 ];
+                sample->z <<= 8;
+                sample->z |= word[ 5 ];
+                sample->timestamp = ring->timestamp;
+
+                ring->head = ( ring->head + 1 ) % ring->size;
+                ring->count++;
+            }
+        }
+
+        level -= n_words;
+        n_read += n_words;
+    }
+
+    return n_read;
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static void c6dofimu15_i2c_write ( c6dofimu15_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
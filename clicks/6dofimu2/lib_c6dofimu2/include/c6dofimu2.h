@@ -424,6 +424,19 @@ void c6dofimu2_read_accel ( c6dofimu2_t *ctx, c6dofimu2_accel_data_t *accel_data
  */
 void c6dofimu2_read_gyro ( c6dofimu2_t *ctx, c6dofimu2_gyro_data_t *gyro_data );
 
+/**
+ * @brief Read Gyro and Accel data function.
+ *
+ * @param ctx          Click object.
+ * @param gyro_data    Pointer to structure where Gyro data be stored.
+ * @param accel_data   Pointer to structure where Accel data be stored.
+ *
+ * @description This function reads Gyro and Accel X-axis, Y-axis and Z-axis
+ * of the same sample in a single bus transaction.
+ */
+void c6dofimu2_read_data ( c6dofimu2_t *ctx, c6dofimu2_gyro_data_t *gyro_data, 
+                           c6dofimu2_accel_data_t *accel_data );
+
 #ifdef __cplusplus
 }
 #endif
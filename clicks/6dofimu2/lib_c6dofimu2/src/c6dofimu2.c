@@ -190,16 +190,40 @@ int16_t c6dofimu2_get_axis ( c6dofimu2_t *ctx, uint8_t adr_reg_low, uint8_t adr_
 
 void c6dofimu2_read_accel ( c6dofimu2_t *ctx, c6dofimu2_accel_data_t *accel_data )
 {
-    accel_data->accel_x = c6dofimu2_get_axis( ctx, C6DOFIMU2_ACCEL_X_L, C6DOFIMU2_ACCEL_X_H );
-    accel_data->accel_y = c6dofimu2_get_axis( ctx, C6DOFIMU2_ACCEL_Y_L, C6DOFIMU2_ACCEL_Y_H );
-    accel_data->accel_z = c6dofimu2_get_axis( ctx, C6DOFIMU2_ACCEL_Z_L, C6DOFIMU2_ACCEL_Z_H );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu2_generic_read( ctx, C6DOFIMU2_ACCEL_X_L, rx_buf, 6 );
+
+    accel_data->accel_x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    accel_data->accel_y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    accel_data->accel_z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
 }
 
 void c6dofimu2_read_gyro ( c6dofimu2_t *ctx, c6dofimu2_gyro_data_t *gyro_data )
 {
-    gyro_data->gyro_x = c6dofimu2_get_axis( ctx, C6DOFIMU2_GYRO_X_L, C6DOFIMU2_GYRO_X_H );
-    gyro_data->gyro_y = c6dofimu2_get_axis( ctx, C6DOFIMU2_GYRO_Y_L, C6DOFIMU2_GYRO_Y_H );
-    gyro_data->gyro_z = c6dofimu2_get_axis( ctx, C6DOFIMU2_GYRO_Z_L, C6DOFIMU2_GYRO_Z_H );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu2_generic_read( ctx, C6DOFIMU2_GYRO_X_L, rx_buf, 6 );
+
+    gyro_data->gyro_x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    gyro_data->gyro_y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    gyro_data->gyro_z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
+}
+
+void c6dofimu2_read_data ( c6dofimu2_t *ctx, c6dofimu2_gyro_data_t *gyro_data, 
+                           c6dofimu2_accel_data_t *accel_data )
+{
+    uint8_t rx_buf[ 12 ];
+
+    // Gyro data is followed by Accel data
+    c6dofimu2_generic_read( ctx, C6DOFIMU2_GYRO_X_L, rx_buf, 12 );
+
+    gyro_data->gyro_x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    gyro_data->gyro_y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    gyro_data->gyro_z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
+    accel_data->accel_x = ( ( int16_t ) rx_buf[ 7 ] << 8 ) | rx_buf[ 6 ];
+    accel_data->accel_y = ( ( int16_t ) rx_buf[ 9 ] << 8 ) | rx_buf[ 8 ];
+    accel_data->accel_z = ( ( int16_t ) rx_buf[ 11 ] << 8 ) | rx_buf[ 10 ];
 }
 
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
@@ -726,7 +726,7 @@ uint8_t c6dofimu20_get_int2_state ( c6dofimu20_t *ctx );
 
 /**
  * @brief 6 DOF IMU 20 accel data reading function.
- * @details This function reads a accel data from registers.
+ * @details This function reads a accel data from registers in a single burst.
  * @param[in] ctx : Click context object.
  * See #c6dofimu20_t object definition for detailed explanation.
  * @param[out] acc_data : Read accel data.
@@ -740,7 +740,7 @@ err_t c6dofimu20_get_acc_data ( c6dofimu20_t *ctx, c6dofimu20_data_t *acc_data )
 
 /**
  * @brief 6 DOF IMU 20 gyro data reading function.
- * @details This function reads a gyro data from registers.
+ * @details This function reads a gyro data from registers in a single burst.
  * @param[in] ctx : Click context object.
  * See #c6dofimu20_t object definition for detailed explanation.
  * @param[out] gyr_data : Read gyro data.
@@ -752,6 +752,23 @@ err_t c6dofimu20_get_acc_data ( c6dofimu20_t *ctx, c6dofimu20_data_t *acc_data )
  */
 err_t c6dofimu20_get_gyr_data ( c6dofimu20_t *ctx, c6dofimu20_data_t *gyr_data );
 
+/**
+ * @brief 6 DOF IMU 20 accel and gyro data reading function.
+ * @details This function reads accel and gyro data of the same sample
+ * in a single burst starting from the ACC_DATA_X register.
+ * @param[in] ctx : Click context object.
+ * See #c6dofimu20_t object definition for detailed explanation.
+ * @param[out] acc_data : Read accel data.
+ * See c6dofimu20_data_t object definition for detailed explanation.
+ * @param[out] gyr_data : Read gyro data.
+ * See c6dofimu20_data_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t c6dofimu20_get_data ( c6dofimu20_t *ctx, c6dofimu20_data_t *acc_data, c6dofimu20_data_t *gyr_data );
+
 /**
  * @brief 6 DOF IMU 20 temperature reading function.
  * @details This function reads a temperature from registers.
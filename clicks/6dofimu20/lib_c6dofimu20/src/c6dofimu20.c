@@ -293,14 +293,12 @@ uint8_t c6dofimu20_get_int2_state ( c6dofimu20_t *ctx )
 err_t c6dofimu20_get_acc_data ( c6dofimu20_t *ctx, c6dofimu20_data_t *acc_data )
 {
     err_t error_flag = C6DOFIMU20_OK;
-    uint16_t tmp_data;
+    uint8_t rx_data[ 7 ] = { 0 };
     
-    error_flag |= c6dofimu20_get_reg( ctx, C6DOFIMU20_REG_ACC_DATA_X, &tmp_data );
-    acc_data->data_x = ( int16_t ) tmp_data;
-    error_flag |= c6dofimu20_get_reg( ctx, C6DOFIMU20_REG_ACC_DATA_Y, &tmp_data );
-    acc_data->data_y = ( int16_t ) tmp_data;
-    error_flag |= c6dofimu20_get_reg( ctx, C6DOFIMU20_REG_ACC_DATA_Z, &tmp_data );
-    acc_data->data_z = ( int16_t ) tmp_data;
+    error_flag |= c6dofimu20_generic_read( ctx, C6DOFIMU20_REG_ACC_DATA_X, rx_data, 7 );
+    acc_data->data_x = ( ( int16_t ) rx_data[ 2 ] << 8 ) | rx_data[ 1 ];
+    acc_data->data_y = ( ( int16_t ) rx_data[ 4 ] << 8 ) | rx_data[ 3 ];
+    acc_data->data_z = ( ( int16_t ) rx_data[ 6 ] << 8 ) | rx_data[ 5 ];
     
     return error_flag;
 }
@@ -308,14 +306,28 @@ err_t c6dofimu20_get_acc_data ( c6dofimu20_t *ctx, c6dofimu20_data_t *acc_data )
 err_t c6dofimu20_get_gyr_data ( c6dofimu20_t *ctx, c6dofimu20_data_t *gyr_data )
 {
     err_t error_flag = C6DOFIMU20_OK;
-    uint16_t tmp_data;
+    uint8_t rx_data[ 7 ] = { 0 };
     
-    error_flag |= c6dofimu20_get_reg( ctx, C6DOFIMU20_REG_GYR_DATA_X, &tmp_data );
-    gyr_data->data_x = ( int16_t ) tmp_data;
-    error_flag |= c6dofimu20_get_reg( ctx, C6DOFIMU20_REG_GYR_DATA_Y, &tmp_data );
-    gyr_data->data_y = ( int16_t ) tmp_data;
-    error_flag |= c6dofimu20_get_reg( ctx, C6DOFIMU20_REG_GYR_DATA_Z, &tmp_data );
-    gyr_data->data_z = ( int16_t ) tmp_data;
+    error_flag |= c6dofimu20_generic_read( ctx, C6DOFIMU20_REG_GYR_DATA_X, rx_data, 7 );
+    gyr_data->data_x = ( ( int16_t ) rx_data[ 2 ] << 8 ) | rx_data[ 1 ];
+    gyr_data->data_y = ( ( int16_t ) rx_data[ 4 ] << 8 ) | rx_data[ 3 ];
+    gyr_data->data_z = ( ( int16_t ) rx_data[ 6 ] << 8 ) | rx_data[ 5 ];
+    
+    return error_flag;
+}
+
+err_t c6dofimu20_get_data ( c6dofimu20_t *ctx, c6dofimu20_data_t *acc_data, c6dofimu20_data_t *gyr_data )
+{
+    err_t error_flag = C6DOFIMU20_OK;
+    uint8_t rx_data[ 13 ] = { 0 };
+    
+    error_flag |= c6dofimu20_generic_read( ctx, C6DOFIMU20_REG_ACC_DATA_X, rx_data, 13 );
+    acc_data->data_x = ( ( int16_t ) rx_data[ 2 ] << 8 ) | rx_data[ 1 ];
+    acc_data->data_y = ( ( int16_t ) rx_data[ 4 ] << 8 ) | rx_data[ 3 ];
+    acc_data->data_z = ( ( int16_t ) rx_data[ 6 ] << 8 ) | rx_data[ 5 ];
+    gyr_data->data_x = ( ( int16_t ) rx_data[ 8 ] << 8 ) | rx_data[ 7 ];
+    gyr_data->data_y = ( ( int16_t ) rx_data[ 10 ] << 8 ) | rx_data[ 9 ];
+    gyr_data->data_z = ( ( int16_t ) rx_data[ 12 ] << 8 ) | rx_data[ 11 ];
     
     return error_flag;
 }
@@ -248,6 +248,26 @@ extern "C"{
 #define C6DOFIMU25_FUNC_CFG_ACCESS_FSM_WR_CTRL_EN       0x08
 #define C6DOFIMU25_FUNC_CFG_ACCESS_SW_POR               0x04
 
+/**
+ * @brief 6DOF IMU 25 FIFO_CTRL3 register setting.
+ * @details Specified setting for FIFO_CTRL3 register of 6DOF IMU 25 Click driver.
+ */
+#define C6DOFIMU25_FIFO_CTRL3_BDR_GY_MASK               0xF0
+#define C6DOFIMU25_FIFO_CTRL3_BDR_XL_MASK               0x0F
+
+/**
+ * @brief 6DOF IMU 25 FIFO_CTRL4 register setting.
+ * @details Specified setting for FIFO_CTRL4 register of 6DOF IMU 25 Click driver.
+ */
+#define C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_OFF          0x00
+#define C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_1            0x40
+#define C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_8            0x80
+#define C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_32           0xC0
+#define C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_MASK         0xC0
+#define C6DOFIMU25_FIFO_CTRL4_FIFO_MODE_BYPASS          0x00
+#define C6DOFIMU25_FIFO_CTRL4_FIFO_MODE_CONTINUOUS      0x06
+#define C6DOFIMU25_FIFO_CTRL4_FIFO_MODE_MASK            0x07
+
 /**
  * @brief 6DOF IMU 25 INT1_CTRL register setting.
  * @details Specified setting for INT1_CTRL register of 6DOF IMU 25 Click driver.
@@ -265,6 +285,27 @@ extern "C"{
  */
 #define C6DOFIMU25_WHO_AM_I                             0x71
 
+/**
+ * @brief 6DOF IMU 25 FIFO_STATUS2 register setting.
+ * @details Specified setting for FIFO_STATUS2 register of 6DOF IMU 25 Click driver.
+ */
+#define C6DOFIMU25_FIFO_STATUS2_WTM_IA                  0x80
+#define C6DOFIMU25_FIFO_STATUS2_OVR_IA                  0x40
+#define C6DOFIMU25_FIFO_STATUS2_FULL_IA                 0x20
+#define C6DOFIMU25_FIFO_STATUS2_OVR_LATCHED             0x08
+#define C6DOFIMU25_FIFO_STATUS2_DIFF_FIFO_8             0x01
+
+/**
+ * @brief 6DOF IMU 25 FIFO_DATA_OUT_TAG register setting.
+ * @details Specified setting for FIFO_DATA_OUT_TAG register of 6DOF IMU 25 Click driver.
+ */
+#define C6DOFIMU25_FIFO_TAG_GYRO                        0x01
+#define C6DOFIMU25_FIFO_TAG_ACCEL                       0x02
+#define C6DOFIMU25_FIFO_TAG_TEMP                        0x03
+#define C6DOFIMU25_FIFO_TAG_TIMESTAMP                   0x04
+#define C6DOFIMU25_FIFO_TAG_CFG_CHANGE                  0x05
+#define C6DOFIMU25_FIFO_TAG_SENSOR_MASK                 0xF8
+
 /**
  * @brief 6DOF IMU 25 CTRL1 register setting.
  * @details Specified setting for CTRL1 register of 6DOF IMU 25 Click driver.
@@ -320,6 +361,12 @@ extern "C"{
 #define C6DOFIMU25_STATUS_GDA                           0x02
 #define C6DOFIMU25_STATUS_XLDA                          0x01
 
+/**
+ * @brief 6DOF IMU 25 FUNCTIONS_ENABLE register setting.
+ * @details Specified setting for FUNCTIONS_ENABLE register of 6DOF IMU 25 Click driver.
+ */
+#define C6DOFIMU25_FUNCTIONS_ENABLE_TIMESTAMP_EN        0x40
+
 /**
  * @brief 6DOF IMU 25 memory bank setting.
  * @details Specified setting for memory bank of 6DOF IMU 25 Click driver.
@@ -391,6 +438,15 @@ extern "C"{
 #define C6DOFIMU25_TEMP_SENS_LSB_PER_C                  256.0
 #define C6DOFIMU25_TEMP_OFFSET                          25.0
 
+/**
+ * @brief 6DOF IMU 25 FIFO stream setting.
+ * @details Specified setting for FIFO stream of 6DOF IMU 25 Click driver.
+ * A burst is limited to 36 words of 7 bytes so it fits a single 8-bit length transfer.
+ */
+#define C6DOFIMU25_FIFO_WTM_MAX                         255
+#define C6DOFIMU25_FIFO_WORD_SIZE                       7
+#define C6DOFIMU25_FIFO_BURST_WORDS                     36
+
 /**
  * @brief 6DOF IMU 25 device address setting.
  * @details Specified setting for device slave address selection of
@@ -531,6 +587,37 @@ typedef struct
 
 } c6dofimu25_data_t;
 
+/**
+ * @brief 6DOF IMU 25 Click FIFO sample structure.
+ * @details FIFO sample object definition of 6DOF IMU 25 Click driver.
+ */
+typedef struct
+{
+    uint8_t  tag;                   /**< Sensor tag (C6DOFIMU25_FIFO_TAG_ACCEL or C6DOFIMU25_FIFO_TAG_GYRO). */
+    int16_t  x;                     /**< Raw X axis. */
+    int16_t  y;                     /**< Raw Y axis. */
+    int16_t  z;                     /**< Raw Z axis. */
+    uint32_t timestamp;             /**< Last batched timestamp. */
+
+} c6dofimu25_fifo_sample_t;
+
+/**
+ * @brief 6DOF IMU 25 Click FIFO ring buffer structure.
+ * @details FIFO ring buffer object definition of 6DOF IMU 25 Click driver.
+ */
+typedef struct
+{
+    c6dofimu25_fifo_sample_t *buf;  /**< Caller supplied sample storage. */
+    uint16_t size;                  /**< Number of samples in the storage. */
+    uint16_t head;                  /**< Write index. */
+    uint16_t tail;                  /**< Read index. */
+    uint16_t count;                 /**< Number of stored samples. */
+    uint16_t dropped;               /**< Number of overwritten samples. */
+    uint32_t timestamp;             /**< Last batched timestamp. */
+    uint8_t  status;                /**< FIFO_STATUS2 flags of the last read. */
+
+} c6dofimu25_fifo_ring_t;
+
 /**
  * @brief 6DOF IMU 25 Click return value data.
  * @details Predefined enum values for driver return values.
@@ -891,7 +978,8 @@ err_t c6dofimu25_get_temp ( c6dofimu25_t *ctx, float *temp );
 
 /**
  * @brief 6DOF IMU 25 get data function.
- * @details This function reads the accelerometer, gyroscope, and temperature measurement data.
+ * @details This function reads the accelerometer, gyroscope, and temperature measurement data
+ * with a single status read followed by a single burst read of all output registers.
  * @param[in] ctx : Click context object.
  * See #c6dofimu25_t object definition for detailed explanation.
  * @param[out] data_out : Output data structure read.
@@ -903,6 +991,80 @@ err_t c6dofimu25_get_temp ( c6dofimu25_t *ctx, float *temp );
  */
 err_t c6dofimu25_get_data ( c6dofimu25_t *ctx, c6dofimu25_data_t *data_out );
 
+/**
+ * @brief 6DOF IMU 25 FIFO config function.
+ * @details This function sets the FIFO watermark and batching data rates, enables
+ * the timestamp counter when timestamp batching is requested, puts the FIFO in
+ * continuous mode and routes the FIFO threshold flag to the INT1 pin.
+ * @param[in] ctx : Click context object.
+ * See #c6dofimu25_t object definition for detailed explanation.
+ * @param[in] watermark : FIFO watermark threshold in words (up to 255).
+ * @param[in] bdr_xl : Accel batch data rate, same encoding as accel output data rate.
+ * @param[in] bdr_gy : Gyro batch data rate, same encoding as gyro output data rate.
+ * @param[in] dec_ts : Timestamp batching decimation (C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_x).
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t c6dofimu25_fifo_config ( c6dofimu25_t *ctx, uint8_t watermark, uint8_t bdr_xl, uint8_t bdr_gy, uint8_t dec_ts );
+
+/**
+ * @brief 6DOF IMU 25 get FIFO level function.
+ * @details This function reads both FIFO status registers in a single transaction.
+ * @param[in] ctx : Click context object.
+ * See #c6dofimu25_t object definition for detailed explanation.
+ * @param[out] level : Number of unread words in the FIFO.
+ * @param[out] status : FIFO_STATUS2 interrupt flags.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t c6dofimu25_fifo_get_level ( c6dofimu25_t *ctx, uint16_t *level, uint8_t *status );
+
+/**
+ * @brief 6DOF IMU 25 FIFO ring init function.
+ * @details This function binds the caller storage to the FIFO ring buffer and empties it.
+ * @param[out] ring : FIFO ring buffer object.
+ * See #c6dofimu25_fifo_ring_t object definition for detailed explanation.
+ * @param[in] buf : Caller supplied sample storage.
+ * @param[in] size : Number of samples in the storage.
+ * @return Nothing.
+ * @note None.
+ */
+void c6dofimu25_fifo_ring_init ( c6dofimu25_fifo_ring_t *ring, c6dofimu25_fifo_sample_t *buf, uint16_t size );
+
+/**
+ * @brief 6DOF IMU 25 FIFO ring pop function.
+ * @details This function takes the oldest sample from the FIFO ring buffer.
+ * @param[in] ring : FIFO ring buffer object.
+ * See #c6dofimu25_fifo_ring_t object definition for detailed explanation.
+ * @param[out] sample : Oldest sample in the ring.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, ring is empty.
+ * See #err_t definition for detailed explanation.
+ * @note Raw axes are converted with @b ctx->accel_sens or @b ctx->gyro_sens.
+ */
+err_t c6dofimu25_fifo_ring_pop ( c6dofimu25_fifo_ring_t *ring, c6dofimu25_fifo_sample_t *sample );
+
+/**
+ * @brief 6DOF IMU 25 FIFO read function.
+ * @details This function drains the FIFO in bursts of up to 36 tagged words per bus
+ * transaction and demultiplexes them into the ring buffer. Accel and gyro words are
+ * stored with the last batched timestamp, timestamp words update it and other words
+ * are discarded.
+ * @param[in] ctx : Click context object.
+ * See #c6dofimu25_t object definition for detailed explanation.
+ * @param[in,out] ring : FIFO ring buffer object.
+ * See #c6dofimu25_fifo_ring_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note When the ring is full the oldest sample is overwritten and counted in @b ring->dropped.
+ */
+err_t c6dofimu25_fifo_read ( c6dofimu25_t *ctx, c6dofimu25_fifo_ring_t *ring );
+
 #ifdef __cplusplus
 }
 #endif
@@ -571,21 +571,204 @@ err_t c6dofimu25_get_temp ( c6dofimu25_t *ctx, float *temp )
 err_t c6dofimu25_get_data ( c6dofimu25_t *ctx, c6dofimu25_data_t *data_out )
 {
     err_t error_flag = C6DOFIMU25_OK;
+    uint8_t status = 0;
+    uint8_t data_buf[ 14 ] = { 0 };
+    int16_t raw_data = 0;
     if ( NULL == data_out )
     {
         error_flag = C6DOFIMU25_ERROR;
     }
     if ( C6DOFIMU25_OK == error_flag )
     {
-        error_flag = c6dofimu25_get_temp ( ctx, &data_out->temperature );
+        error_flag = c6dofimu25_read_reg ( ctx, C6DOFIMU25_REG_STATUS, &status );
+    }
+    if ( ( C6DOFIMU25_OK == error_flag ) && ( status & ( C6DOFIMU25_STATUS_TDA | 
+                                                         C6DOFIMU25_STATUS_GDA | 
+                                                         C6DOFIMU25_STATUS_XLDA ) ) )
+    {
+        error_flag = c6dofimu25_read_regs ( ctx, C6DOFIMU25_REG_OUT_TEMP_L, data_buf, 14 );
+    }
+    if ( ( C6DOFIMU25_OK == error_flag ) && ( status & C6DOFIMU25_STATUS_TDA ) )
+    {
+        raw_data = data_buf[ 1 ];
+        raw_data <<= 8;
+        raw_data |= data_buf[ 0 ];
+        data_out->temperature = ( float ) raw_data / C6DOFIMU25_TEMP_SENS_LSB_PER_C + C6DOFIMU25_TEMP_OFFSET;
+    }
+    if ( ( C6DOFIMU25_OK == error_flag ) && ( status & C6DOFIMU25_STATUS_GDA ) )
+    {
+        raw_data = data_buf[ 3 ];
+        raw_data <<= 8;
+        raw_data |= data_buf[ 2 ];
+        data_out->gyro.x = ( float ) raw_data * ctx->gyro_sens;
+        raw_data = data_buf[ 5 ];
+        raw_data <<= 8;
+        raw_data |= data_buf[ 4 ];
+        data_out->gyro.y = ( float ) raw_data * ctx->gyro_sens;
+        raw_data = data_buf[ 7 ];
+        raw_data <<= 8;
+        raw_data |= data_buf[ 6 ];
+        data_out->gyro.z = ( float ) raw_data * ctx->gyro_sens;
+    }
+    if ( ( C6DOFIMU25_OK == error_flag ) && ( status & C6DOFIMU25_STATUS_XLDA ) )
+    {
+        raw_data = data_buf[ 9 ];
+        raw_data <<= 8;
+        raw_data |= data_buf[ 8 ];
+        data_out->accel.z = ( float ) raw_data * ctx->accel_sens;
+        raw_data = data_buf[ 11 ];
+        raw_data <<= 8;
+        raw_data |= data_buf[ 10 ];
+        data_out->accel.y = ( float ) raw_data * ctx->accel_sens;
+        raw_data = data_buf[ 13 ];
+        raw_data <<= 8;
+        raw_data |= data_buf[ 12 ];
+        data_out->accel.x = ( float ) raw_data * ctx->accel_sens;
+    }
+    return error_flag;
+}
+
+err_t c6dofimu25_fifo_config ( c6dofimu25_t *ctx, uint8_t watermark, uint8_t bdr_xl, uint8_t bdr_gy, uint8_t dec_ts )
+{
+    err_t error_flag = C6DOFIMU25_OK;
+    uint8_t fifo_ctrl[ 4 ] = { 0 };
+    uint8_t reg_data = 0;
+    if ( ( bdr_xl > C6DOFIMU25_ACCEL_ODR_7680_HZ ) || ( bdr_gy > C6DOFIMU25_GYRO_ODR_7680_HZ ) )
+    {
+        error_flag = C6DOFIMU25_ERROR;
+    }
+    if ( C6DOFIMU25_OK == error_flag )
+    {
+        error_flag = c6dofimu25_read_regs ( ctx, C6DOFIMU25_REG_FIFO_CTRL1, fifo_ctrl, 4 );
+    }
+    if ( C6DOFIMU25_OK == error_flag )
+    {
+        fifo_ctrl[ 0 ] = watermark;
+        fifo_ctrl[ 2 ] = ( ( bdr_gy << 4 ) & C6DOFIMU25_FIFO_CTRL3_BDR_GY_MASK ) | 
+                         ( bdr_xl & C6DOFIMU25_FIFO_CTRL3_BDR_XL_MASK );
+        fifo_ctrl[ 3 ] &= ( ~( C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_MASK | C6DOFIMU25_FIFO_CTRL4_FIFO_MODE_MASK ) );
+        fifo_ctrl[ 3 ] |= ( ( dec_ts & C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_MASK ) | 
+                            C6DOFIMU25_FIFO_CTRL4_FIFO_MODE_CONTINUOUS );
+        error_flag = c6dofimu25_write_regs ( ctx, C6DOFIMU25_REG_FIFO_CTRL1, fifo_ctrl, 4 );
+    }
+    if ( C6DOFIMU25_OK == error_flag )
+    {
+        error_flag = c6dofimu25_read_reg ( ctx, C6DOFIMU25_REG_FUNCTIONS_ENABLE, &reg_data );
+    }
+    if ( C6DOFIMU25_OK == error_flag )
+    {
+        reg_data &= ( ~C6DOFIMU25_FUNCTIONS_ENABLE_TIMESTAMP_EN );
+        if ( C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_OFF != ( dec_ts & C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_MASK ) )
+        {
+            reg_data |= C6DOFIMU25_FUNCTIONS_ENABLE_TIMESTAMP_EN;
+        }
+        error_flag = c6dofimu25_write_reg ( ctx, C6DOFIMU25_REG_FUNCTIONS_ENABLE, reg_data );
     }
     if ( C6DOFIMU25_OK == error_flag )
     {
-        error_flag = c6dofimu25_get_accel ( ctx, &data_out->accel );
+        error_flag = c6dofimu25_read_reg ( ctx, C6DOFIMU25_REG_INT1_CTRL, &reg_data );
     }
     if ( C6DOFIMU25_OK == error_flag )
     {
-        error_flag = c6dofimu25_get_gyro ( ctx, &data_out->gyro );
+        reg_data |= C6DOFIMU25_INT1_CTRL_FIFO_TH;
+        error_flag = c6dofimu25_write_reg ( ctx, C6DOFIMU25_REG_INT1_CTRL, reg_data );
+    }
+    return error_flag;
+}
+
+err_t c6dofimu25_fifo_get_level ( c6dofimu25_t *ctx, uint16_t *level, uint8_t *status )
+{
+    err_t error_flag = C6DOFIMU25_OK;
+    uint8_t data_buf[ 2 ] = { 0 };
+    if ( ( NULL == level ) || ( NULL == status ) )
+    {
+        error_flag = C6DOFIMU25_ERROR;
+    }
+    if ( C6DOFIMU25_OK == error_flag )
+    {
+        error_flag = c6dofimu25_read_regs ( ctx, C6DOFIMU25_REG_FIFO_STATUS1, data_buf, 2 );
+    }
+    if ( C6DOFIMU25_OK == error_flag )
+    {
+        *level = ( ( uint16_t ) ( data_buf[ 1 ] & C6DOFIMU25_FIFO_STATUS2_DIFF_FIFO_8 ) << 8 ) | data_buf[ 0 ];
+        *status = data_buf[ 1 ] & ( C6DOFIMU25_FIFO_STATUS2_WTM_IA | 
+                                    C6DOFIMU25_FIFO_STATUS2_OVR_IA | 
+                                    C6DOFIMU25_FIFO_STATUS2_FULL_IA );
+    }
+    return error_flag;
+}
+
+void c6dofimu25_fifo_ring_init ( c6dofimu25_fifo_ring_t *ring, c6dofimu25_fifo_sample_t *buf, uint16_t size )
+{
+    ring->buf = buf;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->count = 0;
+    ring->dropped = 0;
+    ring->timestamp = 0;
+    ring->status = 0;
+}
+
+err_t c6dofimu25_fifo_ring_pop ( c6dofimu25_fifo_ring_t *ring, c6dofimu25_fifo_sample_t *sample )
+{
+    if ( ( NULL == sample ) || ( 0 == ring->count ) )
+    {
+        return C6DOFIMU25_ERROR;
+    }
+    *sample = ring->buf[ ring->tail ];
+    ring->tail = ( ring->tail + 1 ) % ring->size;
+    ring->count--;
+    return C6DOFIMU25_OK;
+}
+
+err_t c6dofimu25_fifo_read ( c6dofimu25_t *ctx, c6dofimu25_fifo_ring_t *ring )
+{
+    err_t error_flag = C6DOFIMU25_OK;
+    uint8_t data_buf[ C6DOFIMU25_FIFO_BURST_WORDS * C6DOFIMU25_FIFO_WORD_SIZE ] = { 0 };
+    c6dofimu25_fifo_sample_t *sample = NULL;
+    uint8_t *word = NULL;
+    uint16_t level = 0;
+    uint8_t num_words = 0;
+    uint8_t tag = 0;
+    if ( ( NULL == ring ) || ( NULL == ring->buf ) || ( 0 == ring->size ) )
+    {
+        return C6DOFIMU25_ERROR;
+    }
+    error_flag = c6dofimu25_fifo_get_level ( ctx, &level, &ring->status );
+    while ( ( C6DOFIMU25_OK == error_flag ) && ( level > 0 ) )
+    {
+        num_words = ( level > C6DOFIMU25_FIFO_BURST_WORDS ) ? C6DOFIMU25_FIFO_BURST_WORDS : level;
+        error_flag = c6dofimu25_read_regs ( ctx, C6DOFIMU25_REG_FIFO_DATA_OUT_TAG, data_buf, 
+                                            num_words * C6DOFIMU25_FIFO_WORD_SIZE );
+        for ( uint8_t cnt = 0; ( C6DOFIMU25_OK == error_flag ) && ( cnt < num_words ); cnt++ )
+        {
+            word = &data_buf[ cnt * C6DOFIMU25_FIFO_WORD_SIZE ];
+            tag = ( word[ 0 ] & C6DOFIMU25_FIFO_TAG_SENSOR_MASK ) >> 3;
+            if ( C6DOFIMU25_FIFO_TAG_TIMESTAMP == tag )
+            {
+                ring->timestamp = ( ( uint32_t ) word[ 4 ] << 24 ) | ( ( uint32_t ) word[ 3 ] << 16 ) | 
+                                  ( ( uint16_t ) word[ 2 ] << 8 ) | word[ 1 ];
+            }
+            else if ( ( C6DOFIMU25_FIFO_TAG_ACCEL == tag ) || ( C6DOFIMU25_FIFO_TAG_GYRO == tag ) )
+            {
+                if ( ring->count == ring->size )
+                {
+                    ring->tail = ( ring->tail + 1 ) % ring->size;
+                    ring->count--;
+                    ring->dropped++;
+                }
+                sample = &ring->buf[ ring->head ];
+                sample->tag = tag;
+                sample->x = ( int16_t ) ( ( ( uint16_t ) word[ 2 ] << 8 ) | word[ 1 ] );
+                sample->y = ( int16_t ) ( ( ( uint16_t ) word[ 4 ] << 8 ) | word[ 3 ] );
+                sample->z = ( int16_t ) ( ( ( uint16_t ) word[ 6 ] << 8 ) | word[ 5 ] );
+                sample->timestamp = ring->timestamp;
+                ring->head = ( ring->head + 1 ) % ring->size;
+                ring->count++;
+            }
+        }
+        level -= num_words;
     }
     return error_flag;
 }
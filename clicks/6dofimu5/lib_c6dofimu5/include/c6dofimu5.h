@@ -479,6 +479,21 @@ typedef struct
 
 } c6dofimu5_cfg_t;
 
+/**
+ * @brief Output data structure definition.
+ */
+typedef struct
+{
+    int16_t accel_x;
+    int16_t accel_y;
+    int16_t accel_z;
+    int16_t temp_out;
+    int16_t gyro_x;
+    int16_t gyro_y;
+    int16_t gyro_z;
+
+} c6dofimu5_data_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 /**
@@ -667,6 +682,17 @@ void c6dofimu5_acceleration_rate ( c6dofimu5_t *ctx, float *x_accel_rte, float *
  */
 float c6dofimu5_read_temp_out ( c6dofimu5_t *ctx );
 
+/**
+ * @brief Read output data function.
+ *
+ * @param ctx       Click object.
+ * @param data_out  Accelerometer, temperature and gyroscope raw data.
+ *
+ * @description This function is used to read accelerometer, temperature and gyroscope
+ * data of the same sample in a single bus transaction.
+ */
+void c6dofimu5_read_data ( c6dofimu5_t *ctx, c6dofimu5_data_t *data_out );
+
 /**
  * @brief Barometer Read function.
  *
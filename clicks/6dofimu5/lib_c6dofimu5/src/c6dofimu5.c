@@ -237,9 +237,13 @@ int16_t c6dofimu5_read_gyro_z ( c6dofimu5_t *ctx )
 
 void c6dofimu5_read_gyroscope ( c6dofimu5_t *ctx, int16_t *gyro_x, int16_t *gyro_y, int16_t *gyro_z )
 {
-    *gyro_x = c6dofimu5_read_gyro_x( ctx );
-    *gyro_y = c6dofimu5_read_gyro_y( ctx );
-    *gyro_z = c6dofimu5_read_gyro_z( ctx );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu5_read_bytes( ctx, C6DOFIMU5_GYRO_XOUT_H, rx_buf, 6 );
+
+    *gyro_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *gyro_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *gyro_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
 }
 
 void c6dofimu5_angular_rate ( c6dofimu5_t *ctx, float *x_ang_rte, float *y_ang_rte, float *z_ang_rte )
@@ -337,9 +341,13 @@ int16_t c6dofimu5_read_accel_z ( c6dofimu5_t *ctx )
 
 void c6dofimu5_read_accelerometer ( c6dofimu5_t *ctx, int16_t *accel_x, int16_t *accel_y, int16_t *accel_z )
 {
-    *accel_x = c6dofimu5_read_accel_x( ctx );
-    *accel_y = c6dofimu5_read_accel_y( ctx );
-    *accel_z = c6dofimu5_read_accel_z( ctx );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu5_read_bytes( ctx, C6DOFIMU5_ACCEL_XOUT_H, rx_buf, 6 );
+
+    *accel_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *accel_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *accel_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
 }
 
 void c6dofimu5_acceleration_rate ( c6dofimu5_t *ctx, float *x_accel_rte, float *y_accel_rte, float *z_accel_rte )
@@ -410,6 +418,22 @@ float c6dofimu5_read_temp_out ( c6dofimu5_t *ctx )
     return result;
 }
 
+void c6dofimu5_read_data ( c6dofimu5_t *ctx, c6dofimu5_data_t *data_out )
+{
+    uint8_t rx_buf[ 14 ];
+
+    // ACCEL_XOUT_H to GYRO_ZOUT_L are contiguous
+    c6dofimu5_read_bytes( ctx, C6DOFIMU5_ACCEL_XOUT_H, rx_buf, 14 );
+
+    data_out->accel_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    data_out->accel_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    data_out->accel_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
+    data_out->temp_out = ( ( int16_t ) rx_buf[ 6 ] << 8 ) | rx_buf[ 7 ];
+    data_out->gyro_x = ( ( int16_t ) rx_buf[ 8 ] << 8 ) | rx_buf[ 9 ];
+    data_out->gyro_y = ( ( int16_t ) rx_buf[ 10 ] << 8 ) | rx_buf[ 11 ];
+    data_out->gyro_z = ( ( int16_t ) rx_buf[ 12 ] << 8 ) | rx_buf[ 13 ];
+}
+
 void c6dofimu5_baro_read ( c6dofimu5_t *ctx, uint16_t cmd, uint8_t *data_out, uint16_t n_bytes )
 {
     uint8_t tx_buf[ 2 ];
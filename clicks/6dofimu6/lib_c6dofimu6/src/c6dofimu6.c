@@ -239,9 +239,13 @@ int16_t c6dofimu6_read_gyro_z ( c6dofimu6_t *ctx )
 // Read gyroscope data
 void c6dofimu6_read_gyroscope ( c6dofimu6_t *ctx, int16_t *gyro_x, int16_t *gyro_y, int16_t *gyro_z )
 {
-    *gyro_x = c6dofimu6_read_gyro_x( ctx );
-    *gyro_y = c6dofimu6_read_gyro_y( ctx );
-    *gyro_z = c6dofimu6_read_gyro_z( ctx );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu6_generic_read( ctx, C6DOFIMU6_GYRO_XOUT_H, rx_buf, 6 );
+
+    *gyro_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *gyro_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *gyro_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
 }
 
 // Read Angular Rate
@@ -344,9 +348,13 @@ int16_t c6dofimu6_read_accel_z( c6dofimu6_t *ctx )
 // Read Accelerometer Data
 void c6dofimu6_read_accelerometer ( c6dofimu6_t *ctx, int16_t *accel_x, int16_t *accel_y, int16_t *accel_z )
 {
-    *accel_x = c6dofimu6_read_accel_x( ctx );
-    *accel_y = c6dofimu6_read_accel_y( ctx );
-    *accel_z = c6dofimu6_read_accel_z( ctx );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu6_generic_read( ctx, C6DOFIMU6_ACCEL_XOUT_H, rx_buf, 6 );
+
+    *accel_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *accel_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *accel_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
 }
 
 // Read acceleration Rate
@@ -419,6 +427,23 @@ float c6dofimu6_read_temp_out ( c6dofimu6_t *ctx )
     return result;
 }
 
+// Read output data
+void c6dofimu6_read_data ( c6dofimu6_t *ctx, c6dofimu6_data_t *data_out )
+{
+    uint8_t rx_buf[ 14 ];
+
+    // ACCEL_XOUT_H to GYRO_ZOUT_L are contiguous
+    c6dofimu6_generic_read( ctx, C6DOFIMU6_ACCEL_XOUT_H, rx_buf, 14 );
+
+    data_out->accel_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    data_out->accel_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    data_out->accel_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
+    data_out->temp_out = ( ( int16_t ) rx_buf[ 6 ] << 8 ) | rx_buf[ 7 ];
+    data_out->gyro_x = ( ( int16_t ) rx_buf[ 8 ] << 8 ) | rx_buf[ 9 ];
+    data_out->gyro_y = ( ( int16_t ) rx_buf[ 10 ] << 8 ) | rx_buf[ 11 ];
+    data_out->gyro_z = ( ( int16_t ) rx_buf[ 12 ] << 8 ) | rx_buf[ 13 ];
+}
+
 uint8_t c6dofimu6_check_int_pin ( c6dofimu6_t *ctx )
 {
     return digital_in_read( &ctx->int_pin );
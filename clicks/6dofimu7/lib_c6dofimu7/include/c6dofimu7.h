@@ -274,6 +274,21 @@ void c6dofimu7_get_accel_data ( c6dofimu7_t *ctx, c6dofimu7_axis_t *accel, float
  */
 void c6dofimu7_get_gyro_data ( c6dofimu7_t *ctx, c6dofimu7_axis_t *gyro, float sensitivity );
 
+/**
+ * @brief Get accelerometer and gyroscope data function.
+ *
+ * @param ctx                  Click object.
+ * @param accel                Accelerometer axis structure.
+ * @param accel_sensitivity    Accelerometer sensitivity value.
+ * @param gyro                 Gyroscope axis structure.
+ * @param gyro_sensitivity     Gyroscope sensitivity value.
+ *
+ * @description This function reads accelerometer and gyroscope axis data in a single
+ * 12-byte burst starting at ACCEL_XOUT_H, so both structures hold the same sample.
+ */
+void c6dofimu7_get_data ( c6dofimu7_t *ctx, c6dofimu7_axis_t *accel, float accel_sensitivity, 
+                          c6dofimu7_axis_t *gyro, float gyro_sensitivity );
+
 /**
  * @brief Get PWM input function.
  *
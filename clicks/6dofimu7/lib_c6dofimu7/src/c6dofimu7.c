@@ -90,16 +90,39 @@ void c6dofimu7_default_cfg ( c6dofimu7_t *ctx )
 
 void c6dofimu7_get_accel_data ( c6dofimu7_t *ctx, c6dofimu7_axis_t *accel, float sensitivity )
 {
-    accel->x_axis = c6dofimu7_read_word( ctx, C6DOFIMU7_ACCEL_XOUT_H ) / sensitivity;
-    accel->y_axis = c6dofimu7_read_word( ctx, C6DOFIMU7_ACCEL_YOUT_H ) / sensitivity;
-    accel->z_axis = c6dofimu7_read_word( ctx, C6DOFIMU7_ACCEL_ZOUT_H ) / sensitivity;
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu7_generic_read( ctx, C6DOFIMU7_ACCEL_XOUT_H, rx_buf, 6 );
+
+    accel->x_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ] ) / sensitivity;
+    accel->y_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ] ) / sensitivity;
+    accel->z_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ] ) / sensitivity;
 }
 
 void c6dofimu7_get_gyro_data ( c6dofimu7_t *ctx, c6dofimu7_axis_t *gyro, float sensitivity )
 {   
-    gyro->x_axis = c6dofimu7_read_word( ctx, C6DOFIMU7_GYRO_XOUT_H ) / sensitivity;
-    gyro->y_axis = c6dofimu7_read_word( ctx, C6DOFIMU7_GYRO_YOUT_H ) / sensitivity;
-    gyro->z_axis = c6dofimu7_read_word( ctx, C6DOFIMU7_GYRO_ZOUT_H ) / sensitivity;
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu7_generic_read( ctx, C6DOFIMU7_GYRO_XOUT_H, rx_buf, 6 );
+
+    gyro->x_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ] ) / sensitivity;
+    gyro->y_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ] ) / sensitivity;
+    gyro->z_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ] ) / sensitivity;
+}
+
+void c6dofimu7_get_data ( c6dofimu7_t *ctx, c6dofimu7_axis_t *accel, float accel_sensitivity, 
+                          c6dofimu7_axis_t *gyro, float gyro_sensitivity )
+{
+    uint8_t rx_buf[ 12 ];
+
+    c6dofimu7_generic_read( ctx, C6DOFIMU7_ACCEL_XOUT_H, rx_buf, 12 );
+
+    accel->x_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ] ) / accel_sensitivity;
+    accel->y_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ] ) / accel_sensitivity;
+    accel->z_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ] ) / accel_sensitivity;
+    gyro->x_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 6 ] << 8 ) | rx_buf[ 7 ] ) / gyro_sensitivity;
+    gyro->y_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 8 ] << 8 ) | rx_buf[ 9 ] ) / gyro_sensitivity;
+    gyro->z_axis = ( int16_t ) ( ( ( int16_t ) rx_buf[ 10 ] << 8 ) | rx_buf[ 11 ] ) / gyro_sensitivity;
 }
 
 float c6dofimu7_get_temp_data ( c6dofimu7_t *ctx, float temp_sensitivity, float temp_offset )
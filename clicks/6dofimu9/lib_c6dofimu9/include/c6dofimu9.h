@@ -240,6 +240,22 @@
 #define C6DOFIMU9_BM_ENABLE_ACCEL_FIFO                              0x08
 /** \} */
 
+/**
+ * \defgroup fifo_stream  FIFO stream
+ * \{
+ */
+#define C6DOFIMU9_BM_USER_CTRL_FIFO_EN                              0x40
+#define C6DOFIMU9_BM_USER_CTRL_FIFO_RST                             0x04
+#define C6DOFIMU9_BM_CONFIG_FIFO_MODE_MASK                          0x40
+#define C6DOFIMU9_FIFO_COUNT_MSB_MASK                               0x1F
+#define C6DOFIMU9_FIFO_SIZE                                         512
+#define C6DOFIMU9_FIFO_RECORD_SIZE                                  14
+#define C6DOFIMU9_FIFO_WTM_MAX                                      36
+#define C6DOFIMU9_FIFO_BURST_RECORDS                                18
+#define C6DOFIMU9_FIFO_WTM_IA                                       0x80
+#define C6DOFIMU9_FIFO_FULL_IA                                      0x20
+/** \} */
+
 /**
  * \defgroup device_id  Device ID
  * \{
@@ -290,6 +306,7 @@ typedef struct c6dofimu9_s
     c6dofimu9_master_io_t  write_f;
     c6dofimu9_master_io_t  read_f;
     c6dofimu9_select_t master_sel;
+    uint16_t fifo_watermark;
 
 } c6dofimu9_t;
 
@@ -324,6 +341,36 @@ typedef struct
 
 } c6dofimu9_cfg_t;
 
+/**
+ * @brief Output data structure.
+ */
+typedef struct
+{
+    int16_t accel_x;
+    int16_t accel_y;
+    int16_t accel_z;
+    int16_t temp_out;
+    int16_t gyro_x;
+    int16_t gyro_y;
+    int16_t gyro_z;
+
+} c6dofimu9_data_t;
+
+/**
+ * @brief FIFO ring buffer structure definition.
+ */
+typedef struct
+{
+    c6dofimu9_data_t *buf;
+    uint16_t size;
+    uint16_t head;
+    uint16_t tail;
+    uint16_t count;
+    uint16_t dropped;
+    uint8_t  status;
+
+} c6dofimu9_fifo_ring_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 /**
@@ -774,6 +821,86 @@ void c6dofimu9_get_accel_data ( c6dofimu9_t *ctx, int16_t *p_accel_x, int16_t *p
  */
 void c6dofimu9_get_gyro_data ( c6dofimu9_t *ctx, int16_t *p_gyro_x, int16_t *p_gyro_y, int16_t *p_gyro_z );
 
+/**
+ * @brief Read Accel, Temperature and Gyro data function
+ *
+ * @param ctx          Click object.
+ * @param data_out     pointer to the output data structure
+ *
+ * @description Function reads 16-bit ( signed ) Accel, Temperature and Gyro data in a single
+ * 14-byte burst starting from C6DOFIMU9_REG_ACCEL_XOUT_H to the C6DOFIMU9_REG_GYRO_ZOUT_L register
+ * address, so all values belong to the same sample
+ * of IAM-20680 High Performance Automotive 6-Axis MotionTracking Device on 6DOF IMU 9 Click board.
+ */
+void c6dofimu9_get_data ( c6dofimu9_t *ctx, c6dofimu9_data_t *data_out );
+
+/**
+ * @brief FIFO stream configuration function
+ *
+ * @param ctx          Click object.
+ * @param watermark    FIFO watermark threshold in records ( max 36 ).
+ *
+ * @description Function puts Accel, Temperature and Gyro data in the FIFO at the sample rate,
+ * one 14-byte record per sample, stops writing when the FIFO is full, and resets and enables it
+ * of IAM-20680 High Performance Automotive 6-Axis MotionTracking Device on 6DOF IMU 9 Click board.
+ * @note The device has no FIFO watermark interrupt, the watermark is compared with
+ * the FIFO level by c6dofimu9_fifo_get_level.
+ */
+void c6dofimu9_fifo_config ( c6dofimu9_t *ctx, uint16_t watermark );
+
+/**
+ * @brief FIFO level function
+ *
+ * @param ctx          Click object.
+ * @param status       FIFO flags ( C6DOFIMU9_FIFO_WTM_IA, C6DOFIMU9_FIFO_FULL_IA ).
+ *
+ * @returns number of complete records in the FIFO
+ *
+ * @description Function reads the C6DOFIMU9_REG_FIFO_COUNTH and C6DOFIMU9_REG_FIFO_COUNTL
+ * registers in a single transaction. C6DOFIMU9_FIFO_FULL_IA is set when another record does
+ * not fit in the FIFO.
+ */
+uint16_t c6dofimu9_fifo_get_level ( c6dofimu9_t *ctx, uint8_t *status );
+
+/**
+ * @brief FIFO ring buffer initialization function
+ *
+ * @param ring         FIFO ring buffer object.
+ * @param buf          Caller supplied sample storage.
+ * @param size         Number of samples in the storage.
+ *
+ * @description Function binds the caller storage to the ring and empties it.
+ */
+void c6dofimu9_fifo_ring_init ( c6dofimu9_fifo_ring_t *ring, c6dofimu9_data_t *buf, uint16_t size );
+
+/**
+ * @brief FIFO ring buffer pop function
+ *
+ * @param ring         FIFO ring buffer object.
+ * @param sample       Oldest sample in the ring.
+ *
+ * @returns 1 if a sample was taken, 0 if the ring is empty
+ *
+ * @description Function takes the oldest Accel, Temperature and Gyro sample from the ring.
+ */
+uint8_t c6dofimu9_fifo_ring_pop ( c6dofimu9_fifo_ring_t *ring, c6dofimu9_data_t *sample );
+
+/**
+ * @brief FIFO read function
+ *
+ * @param ctx          Click object.
+ * @param ring         FIFO ring buffer object.
+ *
+ * @returns number of FIFO records read
+ *
+ * @description Function drains the complete records from the C6DOFIMU9_REG_FIFO_R_W register
+ * in bursts of up to 18 records per bus transaction and stores them in the ring.
+ * @note When the ring is full the oldest sample is overwritten and counted in ring->dropped.
+ * ring->status holds the FIFO flags read before draining. A full FIFO is reset after it is
+ * drained, so the partial record at its end is discarded and the next record starts aligned.
+ */
+uint16_t c6dofimu9_fifo_read ( c6dofimu9_t *ctx, c6dofimu9_fifo_ring_t *ring );
+
 
 #ifdef __cplusplus
 }
@@ -72,6 +72,7 @@ C6DOFIMU9_RETVAL c6dofimu9_init ( c6dofimu9_t *ctx, c6dofimu9_cfg_t *cfg )
 {
     // Only in case it is necessary to check somewhere which communication is set
     ctx->master_sel = cfg->sel;
+    ctx->fifo_watermark = 0;
     
 
     if ( ctx->master_sel == C6DOFIMU9_MASTER_I2C )
@@ -506,16 +507,175 @@ int16_t c6dofimu9_get_axis ( c6dofimu9_t *ctx, uint8_t addr_reg_msb, uint8_t add
 
 void c6dofimu9_get_accel_data ( c6dofimu9_t *ctx, int16_t *p_accel_x, int16_t *p_accel_y, int16_t *p_accel_z )
 {
-    *p_accel_x = c6dofimu9_get_axis( ctx, C6DOFIMU9_REG_ACCEL_XOUT_H, C6DOFIMU9_REG_ACCEL_XOUT_L );
-    *p_accel_y = c6dofimu9_get_axis( ctx, C6DOFIMU9_REG_ACCEL_YOUT_H, C6DOFIMU9_REG_ACCEL_YOUT_L );
-    *p_accel_z = c6dofimu9_get_axis( ctx, C6DOFIMU9_REG_ACCEL_ZOUT_H, C6DOFIMU9_REG_ACCEL_ZOUT_L );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu9_generic_read( ctx, C6DOFIMU9_REG_ACCEL_XOUT_H, rx_buf, 6 );
+
+    *p_accel_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *p_accel_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *p_accel_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
 }
 
 void c6dofimu9_get_gyro_data ( c6dofimu9_t *ctx, int16_t *p_gyro_x, int16_t *p_gyro_y, int16_t *p_gyro_z )
 {
-    *p_gyro_x = c6dofimu9_get_axis( ctx, C6DOFIMU9_REG_GYRO_XOUT_H, C6DOFIMU9_REG_GYRO_XOUT_L );
-    *p_gyro_y = c6dofimu9_get_axis( ctx, C6DOFIMU9_REG_GYRO_YOUT_H, C6DOFIMU9_REG_GYRO_YOUT_L );
-    *p_gyro_z = c6dofimu9_get_axis( ctx, C6DOFIMU9_REG_GYRO_ZOUT_H, C6DOFIMU9_REG_GYRO_ZOUT_L );
+    uint8_t rx_buf[ 6 ];
+
+    c6dofimu9_generic_read( ctx, C6DOFIMU9_REG_GYRO_XOUT_H, rx_buf, 6 );
+
+    *p_gyro_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *p_gyro_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *p_gyro_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
+}
+
+void c6dofimu9_get_data ( c6dofimu9_t *ctx, c6dofimu9_data_t *data_out )
+{
+    uint8_t rx_buf[ 14 ];
+
+    c6dofimu9_generic_read( ctx, C6DOFIMU9_REG_ACCEL_XOUT_H, rx_buf, 14 );
+
+    data_out->accel_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    data_out->accel_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    data_out->accel_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
+    data_out->temp_out = ( ( int16_t ) rx_buf[ 6 ] << 8 ) | rx_buf[ 7 ];
+    data_out->gyro_x = ( ( int16_t ) rx_buf[ 8 ] << 8 ) | rx_buf[ 9 ];
+    data_out->gyro_y = ( ( int16_t ) rx_buf[ 10 ] << 8 ) | rx_buf[ 11 ];
+    data_out->gyro_z = ( ( int16_t ) rx_buf[ 12 ] << 8 ) | rx_buf[ 13 ];
+}
+
+void c6dofimu9_fifo_config ( c6dofimu9_t *ctx, uint16_t watermark )
+{
+    uint8_t temp;
+
+    if ( watermark > C6DOFIMU9_FIFO_WTM_MAX )
+    {
+        watermark = C6DOFIMU9_FIFO_WTM_MAX;
+    }
+
+    ctx->fifo_watermark = watermark;
+
+    c6dofimu9_generic_read( ctx, C6DOFIMU9_REG_CONFIG, &temp, 1 );
+    temp &= ~C6DOFIMU9_BM_CONFIG_FIFO_MODE_MASK;
+    temp |= C6DOFIMU9_BM_FIFO_MODE_FULL_NO_WRITE_DATA;
+    c6dofimu9_generic_write( ctx, C6DOFIMU9_REG_CONFIG, &temp, 1 );
+
+    c6dofimu9_enable_fifo( ctx, C6DOFIMU9_BM_ENABLE_TEMP_FIFO | C6DOFIMU9_BM_ENABLE_XGYRO_FIFO |
+                                C6DOFIMU9_BM_ENABLE_YGYRO_FIFO | C6DOFIMU9_BM_ENABLE_ZGYRO_FIFO |
+                                C6DOFIMU9_BM_ENABLE_ACCEL_FIFO );
+
+    c6dofimu9_generic_read( ctx, C6DOFIMU9_REG_USER_CTRL, &temp, 1 );
+    temp |= C6DOFIMU9_BM_USER_CTRL_FIFO_EN | C6DOFIMU9_BM_USER_CTRL_FIFO_RST;
+    c6dofimu9_generic_write( ctx, C6DOFIMU9_REG_USER_CTRL, &temp, 1 );
+}
+
+uint16_t c6dofimu9_fifo_get_level ( c6dofimu9_t *ctx, uint8_t *status )
+{
+    uint8_t rx_buf[ 2 ];
+    uint16_t n_bytes;
+    uint16_t level;
+
+    c6dofimu9_generic_read( ctx, C6DOFIMU9_REG_FIFO_COUNTH, rx_buf, 2 );
+
+    n_bytes = rx_buf[ 0 ] & C6DOFIMU9_FIFO_COUNT_MSB_MASK;
+    n_bytes <<= 8;
+    n_bytes |= rx_buf[ 1 ];
+
+    level = n_bytes / C6DOFIMU9_FIFO_RECORD_SIZE;
+
+    *status = 0;
+
+    if ( ( ctx->fifo_watermark != 0 ) && ( level >= ctx->fifo_watermark ) )
+    {
+        *status |= C6DOFIMU9_FIFO_WTM_IA;
+    }
+
+    if ( n_bytes > ( C6DOFIMU9_FIFO_SIZE - C6DOFIMU9_FIFO_RECORD_SIZE ) )
+    {
+        *status |= C6DOFIMU9_FIFO_FULL_IA;
+    }
+
+    return level;
+}
+
+void c6dofimu9_fifo_ring_init ( c6dofimu9_fifo_ring_t *ring, c6dofimu9_data_t *buf, uint16_t size )
+{
+    ring->buf = buf;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->count = 0;
+    ring->dropped = 0;
+    ring->status = 0;
+}
+
+uint8_t c6dofimu9_fifo_ring_pop ( c6dofimu9_fifo_ring_t *ring, c6dofimu9_data_t *sample )
+{
+    if ( ring->count == 0 )
+    {
+        return 0;
+    }
+
+    *sample = ring->buf[ ring->tail ];
+    ring->tail = ( ring->tail + 1 ) % ring->size;
+    ring->count--;
+
+    return 1;
+}
+
+uint16_t c6dofimu9_fifo_read ( c6dofimu9_t *ctx, c6dofimu9_fifo_ring_t *ring )
+{
+    uint8_t rx_buf[ C6DOFIMU9_FIFO_BURST_RECORDS * C6DOFIMU9_FIFO_RECORD_SIZE ];
+    uint8_t *record;
+    uint8_t n_records;
+    uint8_t cnt;
+    uint8_t temp;
+    uint16_t level;
+    uint16_t n_read = 0;
+    c6dofimu9_data_t *sample;
+
+    level = c6dofimu9_fifo_get_level( ctx, &ring->status );
+
+    while ( level > 0 )
+    {
+        n_records = ( level > C6DOFIMU9_FIFO_BURST_RECORDS ) ? C6DOFIMU9_FIFO_BURST_RECORDS : level;
+
+        c6dofimu9_generic_read( ctx, C6DOFIMU9_REG_FIFO_R_W, rx_buf, n_records * C6DOFIMU9_FIFO_RECORD_SIZE );
+
+        for ( cnt = 0; cnt < n_records; cnt++ )
+        {
+            record = &rx_buf[ cnt * C6DOFIMU9_FIFO_RECORD_SIZE ];
+
+            if ( ring->count == ring->size )
+            {
+                ring->tail = ( ring->tail + 1 ) % ring->size;
+                ring->count--;
+                ring->dropped++;
+            }
+
+            sample = &ring->buf[ ring->head ];
+            sample->accel_x = ( ( int16_t ) record[ 0 ] << 8 ) | record[ 1 ];
+            sample->accel_y = ( ( int16_t ) record[ 2 ] << 8 ) | record[ 3 ];
+            sample->accel_z = ( ( int16_t ) record[ 4 ] << 8 ) | record[ 5 ];
+            sample->temp_out = ( ( int16_t ) record[ 6 ] << 8 ) | record[ 7 ];
+            sample->gyro_x = ( ( int16_t ) record[ 8 ] << 8 ) | record[ 9 ];
+            sample->gyro_y = ( ( int16_t ) record[ 10 ] << 8 ) | record[ 11 ];
+            sample->gyro_z = ( ( int16_t ) record[ 12 ] << 8 ) | record[ 13 ];
+
+            ring->head = ( ring->head + 1 ) % ring->size;
+            ring->count++;
+        }
+
+        level -= n_records;
+        n_read += n_records;
+    }
+
+    if ( ring->status & C6DOFIMU9_FIFO_FULL_IA )
+    {
+        c6dofimu9_generic_read( ctx, C6DOFIMU9_REG_USER_CTRL, &temp, 1 );
+        temp |= C6DOFIMU9_BM_USER_CTRL_FIFO_RST;
+        c6dofimu9_generic_write( ctx, C6DOFIMU9_REG_USER_CTRL, &temp, 1 );
+    }
+
+    return n_read;
 }
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
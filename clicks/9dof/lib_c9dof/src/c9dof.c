@@ -35,11 +35,12 @@
 #define C9DOF_COMM_MODE_MAG               1
 #define C9DOF_ACCEL_GYRO_POWER_MODE_OFF   0
 #define C9DOF_ACCEL_GYRO_POWER_MODE_ON    1
+#define C9DOF_MAG_AUTO_INCREMENT          0x80
 
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
 /**
- * @brief Get axis function.
+ * @brief Get axes function.
  *
  * @param ctx          Click object.
  * @param w_mode       Write mode
@@ -49,9 +50,12 @@
  * <pre>
  * 1 ( C9DOF_COMM_MODE_MAG )        : Communication with Magnetic sensor.
  * </pre> 
- * @param adr_reg_low  LSB data register address.
+ * @param adr_reg_low  X-axis LSB data register address.
+ * @param axes         Output X, Y and Z axis data.
+ *
+ * @description Reads all three axes in a single 6-byte burst.
  */
-static int16_t dev_get_axis ( c9dof_t *ctx, uint8_t w_mode, uint8_t adr_reg_lsb );
+static void dev_get_axes ( c9dof_t *ctx, uint8_t w_mode, uint8_t adr_reg_lsb, int16_t *axes );
 
 /**
  * @brief Communication 10 ms delay function.
@@ -226,23 +230,35 @@ void c9dof_generic_read_mag ( c9dof_t *ctx, uint8_t reg, uint8_t *data_buf, uint
 
 void c9dof_read_accel ( c9dof_t *ctx, c9dof_accel_data_t *accel_data )
 {   
-    accel_data->x = dev_get_axis( ctx, C9DOF_COMM_MODE_ACCEL_GYRO, C9DOF_REG_OUT_X_L_XL );
-    accel_data->y = dev_get_axis( ctx, C9DOF_COMM_MODE_ACCEL_GYRO, C9DOF_REG_OUT_Y_L_XL );
-    accel_data->z = dev_get_axis( ctx, C9DOF_COMM_MODE_ACCEL_GYRO, C9DOF_REG_OUT_Z_L_XL );
+    int16_t axes[ 3 ];
+
+    dev_get_axes( ctx, C9DOF_COMM_MODE_ACCEL_GYRO, C9DOF_REG_OUT_X_L_XL, axes );
+
+    accel_data->x = axes[ 0 ];
+    accel_data->y = axes[ 1 ];
+    accel_data->z = axes[ 2 ];
 }
 
 void c9dof_read_gyro ( c9dof_t *ctx, c9dof_gyro_data_t *gyro_data )
 {
-    gyro_data->x = dev_get_axis( ctx, C9DOF_COMM_MODE_ACCEL_GYRO, C9DOF_REG_OUT_X_L_G );
-    gyro_data->y = dev_get_axis( ctx, C9DOF_COMM_MODE_ACCEL_GYRO, C9DOF_REG_OUT_Y_L_G );
-    gyro_data->z = dev_get_axis( ctx, C9DOF_COMM_MODE_ACCEL_GYRO, C9DOF_REG_OUT_Z_L_G );
+    int16_t axes[ 3 ];
+
+    dev_get_axes( ctx, C9DOF_COMM_MODE_ACCEL_GYRO, C9DOF_REG_OUT_X_L_G, axes );
+
+    gyro_data->x = axes[ 0 ];
+    gyro_data->y = axes[ 1 ];
+    gyro_data->z = axes[ 2 ];
 }
 
 void c9dof_read_mag ( c9dof_t *ctx, c9dof_mag_data_t *mag_data )
 {
-    mag_data->x = dev_get_axis( ctx, C9DOF_COMM_MODE_MAG, C9DOF_REG_OUT_X_L_M );
-    mag_data->y = dev_get_axis( ctx, C9DOF_COMM_MODE_MAG, C9DOF_REG_OUT_Y_L_M );
-    mag_data->z = dev_get_axis( ctx, C9DOF_COMM_MODE_MAG, C9DOF_REG_OUT_Z_L_M );
+    int16_t axes[ 3 ];
+
+    dev_get_axes( ctx, C9DOF_COMM_MODE_MAG, C9DOF_REG_OUT_X_L_M, axes );
+
+    mag_data->x = axes[ 0 ];
+    mag_data->y = axes[ 1 ];
+    mag_data->z = axes[ 2 ];
 }
 
 uint8_t c9dof_get_interrupt ( c9dof_t *ctx )
@@ -252,25 +268,26 @@ uint8_t c9dof_get_interrupt ( c9dof_t *ctx )
 
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
-static int16_t dev_get_axis ( c9dof_t *ctx, uint8_t r_mode, uint8_t adr_reg_lsb )
+static void dev_get_axes ( c9dof_t *ctx, uint8_t r_mode, uint8_t adr_reg_lsb, int16_t *axes )
 {
-    int16_t result;
-    uint8_t rx_buf[ 2 ];
+    uint8_t rx_buf[ 6 ];
+    uint8_t cnt;
     
     if ( r_mode == C9DOF_COMM_MODE_ACCEL_GYRO )
     {
-        c9dof_generic_read_accel_gyro ( ctx, adr_reg_lsb, &rx_buf, 2 );
+        c9dof_generic_read_accel_gyro ( ctx, adr_reg_lsb, rx_buf, 6 );
     }
     else if ( r_mode == C9DOF_COMM_MODE_MAG )
     {
-        c9dof_generic_read_mag ( ctx, adr_reg_lsb, &rx_buf, 2 );    
+        c9dof_generic_read_mag ( ctx, adr_reg_lsb | C9DOF_MAG_AUTO_INCREMENT, rx_buf, 6 );    
     }
 
-    result = rx_buf[ 1 ];
-    result <<= 8;
-    result |= rx_buf[ 0 ];
-
-    return result;
+    for ( cnt = 0; cnt < 3; cnt++ )
+    {
+        axes[ cnt ] = rx_buf[ cnt * 2 + 1 ];
+        axes[ cnt ] <<= 8;
+        axes[ cnt ] |= rx_buf[ cnt * 2 ];
+    }
 }
 
 static void dev_communication_delay ( void )
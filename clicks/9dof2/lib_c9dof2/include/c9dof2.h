@@ -672,6 +672,21 @@ typedef struct
 
 } c9dof2_cfg_t;
 
+/**
+ * @brief Output data structure definition.
+ */
+typedef struct
+{
+    int16_t accel_x;
+    int16_t accel_y;
+    int16_t accel_z;
+    int16_t gyro_x;
+    int16_t gyro_y;
+    int16_t gyro_z;
+    int16_t temp_out;
+
+} c9dof2_data_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -752,6 +767,19 @@ uint8_t c9dof2_read_byte ( c9dof2_t *ctx, uint8_t reg );
 **/
 int16_t c9dof2_read_data ( c9dof2_t *ctx, uint8_t reg );
 
+/**
+ * @brief Read Bytes function
+ *
+ * @param ctx          Click object.
+ * @param reg          8-bit start register address
+ * @param data_out     Output data buffer
+ * @param len          Number of bytes to read
+ *
+ * @description Reads consecutive registers starting from the 8-bit register
+ * address in a single SPI transaction.
+**/
+void c9dof2_read_bytes ( c9dof2_t *ctx, uint8_t reg, uint8_t *data_out, uint8_t len );
+
 /**
  * @brief Device Reset function
  *
@@ -842,6 +870,17 @@ void c9dof2_acceleration_rate ( c9dof2_t *ctx, float *x_accel_rte, float *y_acce
 **/
 float c9dof2_read_temperature ( c9dof2_t *ctx, float temp_offs );
 
+/**
+ * @brief Read all data function
+ *
+ * @param ctx               Click object.
+ * @param data_out          Accelerometer, gyroscope and temperature raw data.
+ *
+ * @description Function is used to read accelerometer, gyroscope and temperature
+ * data of the same sample in a single SPI transaction.
+**/
+void c9dof2_read_all_data ( c9dof2_t *ctx, c9dof2_data_t *data_out );
+
 /**
  * @brief Check Interrupt state function
  *
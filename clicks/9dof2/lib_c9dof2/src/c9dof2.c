@@ -141,20 +141,30 @@ uint8_t c9dof2_read_byte ( c9dof2_t *ctx, uint8_t reg )
 
 int16_t c9dof2_read_data ( c9dof2_t *ctx, uint8_t reg )
 {
-    uint8_t msb_buf;
-    uint8_t lsb_buf;
+    uint8_t rx_buf[ 2 ];
     int16_t result;
 
-    msb_buf = c9dof2_read_byte( ctx, reg );
-    lsb_buf = c9dof2_read_byte( ctx, reg + 1 );
+    c9dof2_read_bytes( ctx, reg, rx_buf, 2 );
    
-    result = msb_buf;
+    result = rx_buf[ 0 ];
     result <<= 8;
-    result |= lsb_buf;
+    result |= rx_buf[ 1 ];
 
     return result;
 }
 
+void c9dof2_read_bytes ( c9dof2_t *ctx, uint8_t reg, uint8_t *data_out, uint8_t len )
+{
+    uint8_t tx_buf[ 1 ];
+
+    tx_buf[ 0 ] = reg;
+    tx_buf[ 0 ] |= C9DOF2_READ_BIT_MASK;
+
+    spi_master_select_device( ctx->chip_select );
+    spi_master_write_then_read( &ctx->spi, tx_buf, 1, data_out, len );
+    spi_master_deselect_device( ctx->chip_select );  
+}
+
 void c9dof2_dev_rst ( c9dof2_t *ctx )
 {
     uint8_t tx_buf;
@@ -211,9 +221,13 @@ void c9dof2_def_settings ( c9dof2_t *ctx )
 
 void c9dof2_read_gyroscope ( c9dof2_t *ctx, int16_t *gyro_x, int16_t *gyro_y, int16_t *gyro_z )
 {
-    *gyro_x = c9dof2_read_data( ctx, C9DOF2_GYRO_XOUT_H );
-    *gyro_y = c9dof2_read_data( ctx, C9DOF2_GYRO_YOUT_H );
-    *gyro_z = c9dof2_read_data( ctx, C9DOF2_GYRO_ZOUT_H );
+    uint8_t rx_buf[ 6 ];
+
+    c9dof2_read_bytes( ctx, C9DOF2_GYRO_XOUT_H, rx_buf, 6 );
+
+    *gyro_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *gyro_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *gyro_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
 }
 
 void c9dof2_angular_rate ( c9dof2_t *ctx, float *x_ang_rte, float *y_ang_rte, float *z_ang_rte )
@@ -269,9 +283,13 @@ void c9dof2_angular_rate ( c9dof2_t *ctx, float *x_ang_rte, float *y_ang_rte, fl
 
 void c9dof2_read_accelerometer ( c9dof2_t *ctx, int16_t *accel_x, int16_t *accel_y, int16_t *accel_z )
 {
-    *accel_x = c9dof2_read_data( ctx, C9DOF2_ACCEL_XOUT_H );
-    *accel_y = c9dof2_read_data( ctx, C9DOF2_ACCEL_YOUT_H );
-    *accel_z = c9dof2_read_data( ctx, C9DOF2_ACCEL_ZOUT_H );
+    uint8_t rx_buf[ 6 ];
+
+    c9dof2_read_bytes( ctx, C9DOF2_ACCEL_XOUT_H, rx_buf, 6 );
+
+    *accel_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *accel_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *accel_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
 }
 
 void c9dof2_acceleration_rate ( c9dof2_t *ctx, float *x_accel_rte, float *y_accel_rte, float *z_accel_rte )
@@ -339,6 +357,22 @@ float c9dof2_read_temperature ( c9dof2_t *ctx, float temp_offs )
     return result;
 }
 
+void c9dof2_read_all_data ( c9dof2_t *ctx, c9dof2_data_t *data_out )
+{
+    uint8_t rx_buf[ 14 ];
+
+    // ACCEL_XOUT_H to TEMP_OUT_L are contiguous
+    c9dof2_read_bytes( ctx, C9DOF2_ACCEL_XOUT_H, rx_buf, 14 );
+
+    data_out->accel_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    data_out->accel_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    data_out->accel_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
+    data_out->gyro_x = ( ( int16_t ) rx_buf[ 6 ] << 8 ) | rx_buf[ 7 ];
+    data_out->gyro_y = ( ( int16_t ) rx_buf[ 8 ] << 8 ) | rx_buf[ 9 ];
+    data_out->gyro_z = ( ( int16_t ) rx_buf[ 10 ] << 8 ) | rx_buf[ 11 ];
+    data_out->temp_out = ( ( int16_t ) rx_buf[ 12 ] << 8 ) | rx_buf[ 13 ];
+}
+
 uint8_t c9dof2_check_int ( c9dof2_t *ctx )
 {
     uint8_t state;
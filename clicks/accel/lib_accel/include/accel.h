@@ -49,6 +49,7 @@
     #endif
 #endif
 
+#include "drv_digital_out.h"
 #include "drv_digital_in.h"
 #include "drv_i2c_master.h"
 #include "drv_spi_master.h"
@@ -291,6 +292,17 @@ typedef struct
 
 } accel_cfg_t;
 
+/**
+ * @brief Axes data object.
+ */
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+
+} accel_axes_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 /**
@@ -417,6 +429,17 @@ int16_t accel_read_y_axis ( accel_t *ctx );
  */
 int16_t accel_read_z_axis ( accel_t *ctx );
 
+/**
+ * @brief Function raw read X, Y and Z axis
+ *
+ * @param ctx      Click object.
+ * @param axes     Axes data object.
+ *
+ * @description Function reads X, Y and Z axis values of the same sample
+ * from Accel in a single bus transaction.
+ */
+void accel_read_axes ( accel_t *ctx, accel_axes_t *axes );
+
 /**
  * @brief INT Pin Get function.
  *
@@ -221,6 +221,17 @@ int16_t accel_read_z_axis ( accel_t *ctx )
     return out_z;
 }
 
+void accel_read_axes ( accel_t *ctx, accel_axes_t *axes )
+{
+    uint8_t buf[ 6 ] = { 0 };
+
+    accel_generic_read( ctx, ACCEL_REG_DATA_X_LSB, buf, 6 );
+
+    axes->x = ( ( int16_t ) buf[ 1 ] << 8 ) | buf[ 0 ];
+    axes->y = ( ( int16_t ) buf[ 3 ] << 8 ) | buf[ 2 ];
+    axes->z = ( ( int16_t ) buf[ 5 ] << 8 ) | buf[ 4 ];
+}
+
 uint8_t accel_check_int_pin ( accel_t *ctx )
 {
     return digital_in_read( &ctx->int_pin );
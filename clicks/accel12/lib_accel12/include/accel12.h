@@ -418,7 +418,7 @@ int16_t accel12_get_one_axis ( accel12_t *ctx, uint8_t axis );
  * @param y_axis       Accel Y axis data
  * @param z_axis       Accel Z axis data 
  *
- * @description This function read Accel axis data 
+ * @description This function read Accel axis data in a single burst
  */
 void accel12_get_axis_data ( accel12_t *ctx, int16_t *x_axis, int16_t *y_axis, int16_t *z_axis);
 
@@ -178,9 +178,13 @@ int16_t accel12_get_one_axis ( accel12_t *ctx, uint8_t axis )
 
 void accel12_get_axis_data ( accel12_t *ctx, int16_t *x_axis, int16_t *y_axis, int16_t *z_axis)
 {
-    *x_axis = accel12_get_one_axis( ctx, ACCEL12_REG_X_AXIS_LSB );
-    *y_axis = accel12_get_one_axis( ctx, ACCEL12_REG_Y_AXIS_LSB );
-    *z_axis = accel12_get_one_axis( ctx, ACCEL12_REG_Z_AXIS_LSB );
+    uint8_t read_reg[ 6 ];
+    
+    accel12_generic_read( ctx, ACCEL12_REG_X_AXIS_LSB, read_reg, 6 );
+    
+    *x_axis = ( ( int16_t ) read_reg[ 1 ] << 8 ) | read_reg[ 0 ];
+    *y_axis = ( ( int16_t ) read_reg[ 3 ] << 8 ) | read_reg[ 2 ];
+    *z_axis = ( ( int16_t ) read_reg[ 5 ] << 8 ) | read_reg[ 4 ];
 }
 
 uint8_t accel12_get_tap_detection ( accel12_t *ctx )
@@ -282,6 +282,24 @@
 #define ACCEL13_FCTRL_CONTINUOUS_MODE         0xC0
 /** \} */
 
+/**
+ * \defgroup fifo_samples Fifo Samples
+ * \{
+ */
+#define ACCEL13_FSAMPLES_FIFO_FTH             0x80
+#define ACCEL13_FSAMPLES_FIFO_OVR             0x40
+#define ACCEL13_FSAMPLES_DIFF_MASK            0x3F
+/** \} */
+
+/**
+ * \defgroup fifo_stream Fifo Stream
+ * \{
+ */
+#define ACCEL13_FIFO_WTM_MAX                  31
+#define ACCEL13_FIFO_SAMPLE_SIZE              6
+#define ACCEL13_FIFO_BURST_SAMPLES            32
+/** \} */
+
 /**
  * \defgroup tap_ths_x Tap THS X
  * \{
@@ -519,6 +537,21 @@ typedef struct
 
 }  accel13_status_t;
 
+/**
+ * @brief FIFO ring buffer structure definition.
+ */
+typedef struct
+{
+    accel13_axis_t *buf;
+    uint16_t size;
+    uint16_t head;
+    uint16_t tail;
+    uint16_t count;
+    uint16_t dropped;
+    uint8_t  status;
+
+} accel13_fifo_ring_t;
+
 /**
  * @brief Structure for collecting status data,
  * read from the WAKE-UP SRC register
@@ -739,7 +772,7 @@ float accel13_get_temperature ( accel13_t *ctx );
  * @param ctx            Click object.
  * @param axis           An object that contains X , Y and Z axis data.
  * 
- * @description This function reads the axis data and stores it in the axis object.
+ * @description This function reads the axis data in a single burst and stores it in the axis object.
  */
 void accel13_get_axis_data ( accel13_t *ctx, accel13_axis_t *axis );
 
@@ -815,6 +848,69 @@ void accel13_set_user_offset ( accel13_t *ctx, accel13_user_offset_t *axis );
  */
 uint8_t accel13_get_interrupt ( accel13_t *ctx, uint8_t int_num );
 
+/**
+ * @brief FIFO stream configuration function
+ *
+ * @param ctx            Click object.
+ * @param watermark      FIFO threshold in samples ( max 31 ).
+ *
+ * @description This function sets the FIFO threshold, puts the FIFO
+ * in continuous mode and routes the FIFO threshold flag to the INT1 pin.
+ */
+void accel13_fifo_config ( accel13_t *ctx, uint8_t watermark );
+
+/**
+ * @brief FIFO level function
+ *
+ * @param ctx            Click object.
+ * @param status         FIFO flags ( ACCEL13_FSAMPLES_FIFO_FTH, ACCEL13_FSAMPLES_FIFO_OVR ).
+ *
+ * @return Number of unread samples in the FIFO
+ *
+ * @description This function reads the FIFO samples register.
+ */
+uint8_t accel13_fifo_get_level ( accel13_t *ctx, uint8_t *status );
+
+/**
+ * @brief FIFO ring buffer initialization function
+ *
+ * @param ring           FIFO ring buffer object.
+ * @param buf            Caller supplied sample storage.
+ * @param size           Number of samples in the storage.
+ *
+ * @description This function binds the caller storage to the ring and empties it.
+ */
+void accel13_fifo_ring_init ( accel13_fifo_ring_t *ring, accel13_axis_t *buf, uint16_t size );
+
+/**
+ * @brief FIFO ring buffer pop function
+ *
+ * @param ring           FIFO ring buffer object.
+ * @param sample         Oldest sample in the ring.
+ *
+ * @return 1 if a sample was taken, 0 if the ring is empty
+ *
+ * @description This function takes the oldest axis sample from the ring.
+ */
+uint8_t accel13_fifo_ring_pop ( accel13_fifo_ring_t *ring, accel13_axis_t *sample );
+
+/**
+ * @brief FIFO read function
+ *
+ * @param ctx            Click object.
+ * @param ring           FIFO ring buffer object.
+ *
+ * @return Number of FIFO samples read
+ *
+ * @description This function drains the FIFO with a single burst from the
+ * X axis LSB register, which rolls back from the Z axis MSB register while
+ * the FIFO is enabled, and stores the samples in the ring.
+ * @note Register address auto increment has to be enabled in CTRL2.
+ * When the ring is full the oldest sample is overwritten and counted in
+ * ring->dropped. ring->status holds the FIFO flags read before draining.
+ */
+uint8_t accel13_fifo_read ( accel13_t *ctx, accel13_fifo_ring_t *ring );
+
 #ifdef __cplusplus
 }
 #endif
@@ -244,9 +244,13 @@ float accel13_get_temperature ( accel13_t *ctx )
 
 void accel13_get_axis_data ( accel13_t *ctx, accel13_axis_t *axis )
 {
-    axis->x = accel13_generic_read_word( ctx, ACCEL13_REG_AXIS_X_LSB );
-    axis->y = accel13_generic_read_word( ctx, ACCEL13_REG_AXIS_Y_LSB );
-    axis->z = accel13_generic_read_word( ctx, ACCEL13_REG_AXIS_Z_LSB );
+    uint8_t read_buf[ 6 ];
+
+    accel13_generic_read_bytes( ctx, ACCEL13_REG_AXIS_X_LSB, read_buf, 6 );
+
+    axis->x = ( ( int16_t ) read_buf[ 1 ] << 8 ) | read_buf[ 0 ];
+    axis->y = ( ( int16_t ) read_buf[ 3 ] << 8 ) | read_buf[ 2 ];
+    axis->z = ( ( int16_t ) read_buf[ 5 ] << 8 ) | read_buf[ 4 ];
 }
 
 void accel13_get_status ( accel13_t *ctx, accel13_status_t *status)
@@ -336,6 +340,103 @@ uint8_t accel13_get_interrupt ( accel13_t *ctx, uint8_t int_num )
     }
 }
 
+void accel13_fifo_config ( accel13_t *ctx, uint8_t watermark )
+{
+    uint8_t temp;
+
+    if ( watermark > ACCEL13_FIFO_WTM_MAX )
+    {
+        watermark = ACCEL13_FIFO_WTM_MAX;
+    }
+
+    accel13_generic_write_single_byte( ctx, ACCEL13_REG_FIFO_CTRL, ACCEL13_FCTRL_CONTINUOUS_MODE | watermark );
+
+    accel13_generic_read_bytes( ctx, ACCEL13_REG_CTRL_4_INT1, &temp, 1 );
+    temp |= ACCEL13_CTRL4_INT1_FTH_ENABLED;
+    accel13_generic_write_single_byte( ctx, ACCEL13_REG_CTRL_4_INT1, temp );
+}
+
+uint8_t accel13_fifo_get_level ( accel13_t *ctx, uint8_t *status )
+{
+    uint8_t fifo_samples;
+
+    accel13_generic_read_bytes( ctx, ACCEL13_REG_FIFO_SAMPLES, &fifo_samples, 1 );
+
+    *status = fifo_samples & ( ACCEL13_FSAMPLES_FIFO_FTH | ACCEL13_FSAMPLES_FIFO_OVR );
+
+    return fifo_samples & ACCEL13_FSAMPLES_DIFF_MASK;
+}
+
+void accel13_fifo_ring_init ( accel13_fifo_ring_t *ring, accel13_axis_t *buf, uint16_t size )
+{
+    ring->buf = buf;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->count = 0;
+    ring->dropped = 0;
+    ring->status = 0;
+}
+
+uint8_t accel13_fifo_ring_pop ( accel13_fifo_ring_t *ring, accel13_axis_t *sample )
+{
+    if ( ring->count == 0 )
+    {
+        return 0;
+    }
+
+    *sample = ring->buf[ ring->tail ];
+    ring->tail = ( ring->tail + 1 ) % ring->size;
+    ring->count--;
+
+    return 1;
+}
+
+uint8_t accel13_fifo_read ( accel13_t *ctx, accel13_fifo_ring_t *ring )
+{
+    uint8_t read_buf[ ACCEL13_FIFO_BURST_SAMPLES * ACCEL13_FIFO_SAMPLE_SIZE ];
+    uint8_t *word;
+    uint8_t level;
+    uint8_t cnt;
+    accel13_axis_t *sample;
+
+    level = accel13_fifo_get_level( ctx, &ring->status );
+
+    if ( level == 0 )
+    {
+        return 0;
+    }
+
+    if ( level > ACCEL13_FIFO_BURST_SAMPLES )
+    {
+        level = ACCEL13_FIFO_BURST_SAMPLES;
+    }
+
+    accel13_generic_read_bytes( ctx, ACCEL13_REG_AXIS_X_LSB, read_buf, level * ACCEL13_FIFO_SAMPLE_SIZE );
+
+    for ( cnt = 0; cnt < level; cnt++ )
+    {
+        word = &read_buf[ cnt * ACCEL13_FIFO_SAMPLE_SIZE ];
+
+        if ( ring->count == ring->size )
+        {
+            ring->tail = ( ring->tail + 1 ) % ring->size;
+            ring->count--;
+            ring->dropped++;
+        }
+
+        sample = &ring->buf[ ring->head ];
+        sample->x = ( ( int16_t ) word[ 1 ] << 8 ) | word[ 0 ];
+        sample->y = ( ( int16_t ) word[ 3 ] << 8 ) | word[ 2 ];
+        sample->z = ( ( int16_t ) word[ 5 ] << 8 ) | word[ 4 ];
+
+        ring->head = ( ring->head + 1 ) % ring->size;
+        ring->count++;
+    }
+
+    return level;
+}
+
 
 
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
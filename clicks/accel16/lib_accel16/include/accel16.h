@@ -144,6 +144,23 @@ extern "C"{
 #define ACCEL16_TEMPERATURE_RES             0.065
 #define ACCEL16_TEMPERATURE_CAL_SAMPLE_NUM  100
 
+/**
+ * @brief Accel 16 FIFO stream settings.
+ * @details Specified FIFO stream settings of Accel 16 Click driver.
+ */
+#define ACCEL16_FIFO_CONTROL_AH             0x08
+#define ACCEL16_FIFO_CONTROL_STREAM         0x02
+#define ACCEL16_STATUS_FIFO_OVERRUN         0x08
+#define ACCEL16_STATUS_FIFO_WATERMARK       0x04
+#define ACCEL16_INTMAP_FIFO_WATERMARK       0x04
+#define ACCEL16_FIFO_ENTRIES_MSB_MASK       0x03
+#define ACCEL16_FIFO_AXIS_MASK              0xC000
+#define ACCEL16_FIFO_AXIS_X                 0x0000
+#define ACCEL16_FIFO_AXIS_Y                 0x4000
+#define ACCEL16_FIFO_AXIS_Z                 0x8000
+#define ACCEL16_FIFO_WTM_MAX                170
+#define ACCEL16_FIFO_BURST_WORDS            120
+
 /**
  * @brief Data sample selection.
  * @details This macro sets data samples for SPI modules.
@@ -237,6 +254,24 @@ typedef struct
 
 } accel16_axes_t;
 
+/**
+ * @brief Accel 16 Click FIFO ring buffer.
+ * @details FIFO ring buffer object definition of Accel 16 Click driver.
+ */
+typedef struct
+{
+    accel16_axes_t *buf;        /**< Caller supplied sample storage. */
+    uint16_t size;              /**< Number of samples in the storage. */
+    uint16_t head;              /**< Next sample to write. */
+    uint16_t tail;              /**< Oldest sample. */
+    uint16_t count;             /**< Number of samples in the ring. */
+    uint16_t dropped;           /**< Samples overwritten while the ring was full. */
+    uint8_t status;             /**< FIFO flags of the STATUS register read before draining. */
+    accel16_axes_t pending;     /**< Sample whose axis words are still being read. */
+    uint8_t pending_axes;       /**< Axis words of the pending sample read so far. */
+
+} accel16_fifo_ring_t;
+
 /**
  * @brief Accel 16 Click return value data.
  * @details Predefined enum values for driver return values.
@@ -477,6 +512,72 @@ err_t accel16_get_adc ( accel16_t *ctx, float *v_adc );
  */
 err_t accel16_calibrate_temperature ( accel16_t *ctx, float room_temperature );
 
+/**
+ * @brief Accel 16 FIFO stream configuration function.
+ * @details This function sets the FIFO watermark, puts the FIFO in stream mode
+ * without temperature words and maps the FIFO watermark flag to the INT1 pin.
+ * @param[in] ctx : Click context object.
+ * See #accel16_t object definition for detailed explanation.
+ * @param[in] watermark : FIFO watermark in X, Y and Z samples ( max 170 ).
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+err_t accel16_fifo_config ( accel16_t *ctx, uint16_t watermark );
+
+/**
+ * @brief Accel 16 FIFO level function.
+ * @details This function reads the STATUS and FIFO entries registers in a single transaction.
+ * @param[in] ctx : Click context object.
+ * See #accel16_t object definition for detailed explanation.
+ * @param[out] level : Number of unread axis words in the FIFO.
+ * @param[out] status : FIFO flags ( ACCEL16_STATUS_FIFO_WATERMARK, ACCEL16_STATUS_FIFO_OVERRUN ).
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+err_t accel16_fifo_get_level ( accel16_t *ctx, uint16_t *level, uint8_t *status );
+
+/**
+ * @brief Accel 16 FIFO ring buffer initialization function.
+ * @details This function binds the caller storage to the ring and empties it.
+ * @param[out] ring : FIFO ring buffer object.
+ * See #accel16_fifo_ring_t object definition for detailed explanation.
+ * @param[in] buf : Caller supplied sample storage.
+ * @param[in] size : Number of samples in the storage.
+ * @return Nothing.
+ */
+void accel16_fifo_ring_init ( accel16_fifo_ring_t *ring, accel16_axes_t *buf, uint16_t size );
+
+/**
+ * @brief Accel 16 FIFO ring buffer pop function.
+ * @details This function takes the oldest sample from the ring.
+ * @param[in,out] ring : FIFO ring buffer object.
+ * See #accel16_fifo_ring_t object definition for detailed explanation.
+ * @param[out] sample : Oldest sample in g.
+ * @return @li @c 1 - A sample was taken,
+ *         @li @c 0 - The ring is empty.
+ */
+uint8_t accel16_fifo_ring_pop ( accel16_fifo_ring_t *ring, accel16_axes_t *sample );
+
+/**
+ * @brief Accel 16 FIFO drain function.
+ * @details This function drains the FIFO in bursts of up to 120 axis words per
+ * bus transaction and assembles the words into samples in g by their axis tags.
+ * A sample is stored in the ring once its Z word is read after the X and Y words,
+ * words of an incomplete sample are kept in the ring for the next drain.
+ * @param[in] ctx : Click context object.
+ * See #accel16_t object definition for detailed explanation.
+ * @param[in,out] ring : FIFO ring buffer object.
+ * See #accel16_fifo_ring_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note When the ring is full the oldest sample is overwritten and counted in
+ * ring->dropped. ring->status holds the FIFO flags read before draining.
+ */
+err_t accel16_fifo_drain ( accel16_t *ctx, accel16_fifo_ring_t *ring );
+
 #ifdef __cplusplus
 }
 #endif
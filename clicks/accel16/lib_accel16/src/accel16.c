@@ -270,4 +270,139 @@ err_t accel16_calibrate_temperature ( accel16_t *ctx, float room_temperature )
     return error_flag;
 }
 
+err_t accel16_fifo_config ( accel16_t *ctx, uint16_t watermark )
+{
+    err_t error_flag = ACCEL16_OK;
+    uint8_t fifo_ctl[ 2 ] = { 0 };
+    uint8_t intmap = 0;
+
+    if ( watermark > ACCEL16_FIFO_WTM_MAX )
+    {
+        watermark = ACCEL16_FIFO_WTM_MAX;
+    }
+
+    // FIFO_SAMPLES counts axis words, its ninth bit is AH in FIFO_CONTROL
+    watermark *= 3;
+    fifo_ctl[ 0 ] = ACCEL16_FIFO_CONTROL_STREAM;
+    if ( watermark > 0xFF )
+    {
+        fifo_ctl[ 0 ] |= ACCEL16_FIFO_CONTROL_AH;
+    }
+    fifo_ctl[ 1 ] = ( uint8_t ) watermark;
+    error_flag |= accel16_multiple_reg_write( ctx, ACCEL16_REG_FIFO_CONTROL, fifo_ctl, 2 );
+
+    error_flag |= accel16_single_reg_read( ctx, ACCEL16_REG_INTMAP1, &intmap );
+    intmap |= ACCEL16_INTMAP_FIFO_WATERMARK;
+    error_flag |= accel16_single_reg_write( ctx, ACCEL16_REG_INTMAP1, intmap );
+
+    return error_flag;
+}
+
+err_t accel16_fifo_get_level ( accel16_t *ctx, uint16_t *level, uint8_t *status )
+{
+    uint8_t temp_buf[ 3 ] = { 0 };
+    err_t ret_val = accel16_multiple_reg_read( ctx, ACCEL16_REG_STATUS, temp_buf, 3 );
+
+    *status = temp_buf[ 0 ] & ( ACCEL16_STATUS_FIFO_WATERMARK | ACCEL16_STATUS_FIFO_OVERRUN );
+    *level = ( ( uint16_t ) ( temp_buf[ 2 ] & ACCEL16_FIFO_ENTRIES_MSB_MASK ) << 8 ) | temp_buf[ 1 ];
+
+    return ret_val;
+}
+
+void accel16_fifo_ring_init ( accel16_fifo_ring_t *ring, accel16_axes_t *buf, uint16_t size )
+{
+    ring->buf = buf;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->count = 0;
+    ring->dropped = 0;
+    ring->status = 0;
+    ring->pending_axes = 0;
+}
+
+uint8_t accel16_fifo_ring_pop ( accel16_fifo_ring_t *ring, accel16_axes_t *sample )
+{
+    if ( 0 == ring->count )
+    {
+        return 0;
+    }
+
+    *sample = ring->buf[ ring->tail ];
+    ring->tail = ( ring->tail + 1 ) % ring->size;
+    ring->count--;
+
+    return 1;
+}
+
+err_t accel16_fifo_drain ( accel16_t *ctx, accel16_fifo_ring_t *ring )
+{
+    uint8_t temp_buf[ ACCEL16_FIFO_BURST_WORDS * 2 ] = { 0 };
+    uint16_t level = 0;
+    uint16_t n_words = 0;
+    uint16_t word = 0;
+    float value = 0;
+    err_t error_flag = accel16_fifo_get_level( ctx, &level, &ring->status );
+
+    while ( ( ACCEL16_OK == error_flag ) && ( level > 0 ) )
+    {
+        n_words = ( level > ACCEL16_FIFO_BURST_WORDS ) ? ACCEL16_FIFO_BURST_WORDS : level;
+        error_flag = accel16_fifo_read( ctx, temp_buf, n_words * 2 );
+        if ( ACCEL16_OK != error_flag )
+        {
+            break;
+        }
+
+        for ( uint16_t cnt = 0; cnt < n_words; cnt++ )
+        {
+            word = ( ( uint16_t ) temp_buf[ cnt * 2 + 1 ] << 8 ) | temp_buf[ cnt * 2 ];
+            // Bits 13:0 hold the value, sign extended from bit 11
+            value = ( ( int16_t ) ( word << 2 ) >> 2 ) / ctx->resolution;
+
+            switch ( word & ACCEL16_FIFO_AXIS_MASK )
+            {
+                case ACCEL16_FIFO_AXIS_X:
+                {
+                    ring->pending.x = value;
+                    ring->pending_axes = 1;
+                    break;
+                }
+                case ACCEL16_FIFO_AXIS_Y:
+                {
+                    ring->pending.y = value;
+                    ring->pending_axes = ( 1 == ring->pending_axes ) ? 2 : 0;
+                    break;
+                }
+                case ACCEL16_FIFO_AXIS_Z:
+                {
+                    if ( 2 == ring->pending_axes )
+                    {
+                        if ( ring->count == ring->size )
+                        {
+                            ring->tail = ( ring->tail + 1 ) % ring->size;
+                            ring->count--;
+                            ring->dropped++;
+                        }
+                        ring->pending.z = value;
+                        ring->buf[ ring->head ] = ring->pending;
+                        ring->head = ( ring->head + 1 ) % ring->size;
+                        ring->count++;
+                    }
+                    ring->pending_axes = 0;
+                    break;
+                }
+                default:
+                {
+                    ring->pending_axes = 0;
+                    break;
+                }
+            }
+        }
+
+        level -= n_words;
+    }
+
+    return error_flag;
+}
+
 // ------------------------------------------------------------------------- END
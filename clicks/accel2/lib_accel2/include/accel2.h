@@ -240,6 +240,17 @@ typedef struct
 
 } accel2_cfg_t;
 
+/**
+ * @brief Axes data object.
+ */
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+
+} accel2_axes_t;
+
 /** \} */ // End types group
 
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
@@ -340,6 +351,17 @@ int16_t accel2_read_yaxis ( accel2_t *ctx );
  */
 int16_t accel2_read_zaxis ( accel2_t *ctx );
 
+/**
+ * @brief Function read X, Y and Z axis.
+ *
+ * @param ctx      Click object.
+ * @param axes     Axes data object.
+ *
+ * @description This function reads X, Y and Z axis of the same sample from Accel 2
+ * in a single bus transaction, relying on the register address auto increment.
+ */
+void accel2_read_axes ( accel2_t *ctx, accel2_axes_t *axes );
+
 #ifdef __cplusplus
 }
 #endif
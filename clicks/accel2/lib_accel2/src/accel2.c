@@ -210,6 +210,17 @@ int16_t accel2_read_zaxis ( accel2_t *ctx )
     return (int16_t)out_z;
 }
 
+void accel2_read_axes ( accel2_t *ctx, accel2_axes_t *axes )
+{
+    uint8_t buffer[ 6 ];
+
+    accel2_generic_read( ctx, ACCEL2_OUT_X_L, buffer, 6 );
+
+    axes->x = ( ( int16_t ) buffer[ 1 ] << 8 ) | buffer[ 0 ];
+    axes->y = ( ( int16_t ) buffer[ 3 ] << 8 ) | buffer[ 2 ];
+    axes->z = ( ( int16_t ) buffer[ 5 ] << 8 ) | buffer[ 4 ];
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static void accel2_i2c_write ( accel2_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
@@ -497,7 +497,7 @@ uint8_t accel28_get_int_state ( accel28_t *ctx );
 
 /**
  * @brief Accel 28 raw data reading function.
- * @details This function reads the raw accel data.
+ * @details This function reads the raw accel data of all axes in a single burst.
  * @param[in] ctx : Click context object.
  * See #accel28_t object definition for detailed explanation.
  * @param[out] data_out : Accel data.
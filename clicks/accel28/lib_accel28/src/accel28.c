@@ -240,16 +240,12 @@ uint8_t accel28_get_int_state ( accel28_t *ctx )
 err_t accel28_get_raw_data ( accel28_t *ctx, accel28_data_t *data_out )
 {
     err_t error_flag = ACCEL28_OK;
-    uint8_t tmp_data[ 2 ] = { 0 };
+    uint8_t tmp_data[ 6 ] = { 0 };
     
-    error_flag |= accel28_generic_read( ctx, ACCEL28_REG_OUT_X_L, tmp_data, 2 );
-    data_out->x_data = ( float ) ( ( ( int16_t ) tmp_data[ 1 ] << 8 ) | tmp_data[ 0 ] );
-    
-    error_flag |= accel28_generic_read( ctx, ACCEL28_REG_OUT_Y_L, tmp_data, 2 );
-    data_out->y_data = ( float ) ( ( ( int16_t ) tmp_data[ 1 ] << 8 ) | tmp_data[ 0 ] );
-    
-    error_flag |= accel28_generic_read( ctx, ACCEL28_REG_OUT_Z_L, tmp_data, 2 );
-    data_out->z_data = ( float ) ( ( ( int16_t ) tmp_data[ 1 ] << 8 ) | tmp_data[ 0 ] );
+    error_flag |= accel28_generic_read( ctx, ACCEL28_REG_OUT_X_L, tmp_data, 6 );
+    data_out->x_data = ( float ) ( int16_t ) ( ( ( uint16_t ) tmp_data[ 1 ] << 8 ) | tmp_data[ 0 ] );
+    data_out->y_data = ( float ) ( int16_t ) ( ( ( uint16_t ) tmp_data[ 3 ] << 8 ) | tmp_data[ 2 ] );
+    data_out->z_data = ( float ) ( int16_t ) ( ( ( uint16_t ) tmp_data[ 5 ] << 8 ) | tmp_data[ 4 ] );
     
     return error_flag;
 }
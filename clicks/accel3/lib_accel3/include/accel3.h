@@ -335,7 +335,7 @@ uint8_t accel3_check_id ( accel3_t *ctx );
  * @param accel3_data   Pointer to structure where Accel data be stored.
  *
  * @description This function reads Accel data ( X, Y and Z axis ) 
- * from the desired Accel registers of the H3LIS331DL module.
+ * from the desired Accel registers of the H3LIS331DL module in a single burst.
  */
 void accel3_read_data ( accel3_t *ctx, accel3_data_t *accel3_data );
 
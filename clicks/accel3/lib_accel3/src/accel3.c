@@ -32,11 +32,11 @@
 // ------------------------------------------------------------- PRIVATE MACROS 
 
 #define ACCEL3_DUMMY           0
+#define ACCEL3_I2C_AUTO_INC    0x80
+#define ACCEL3_SPI_AUTO_INC    0x40
 
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
-static int16_t dev_get_axis ( accel3_t *ctx, uint8_t adr_reg_msb, uint8_t adr_reg_lsb );
-
 static void accel3_i2c_write ( accel3_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len );
 
 static void accel3_i2c_read  ( accel3_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len );
@@ -184,29 +184,17 @@ uint8_t accel3_check_id ( accel3_t *ctx )
     
 void accel3_read_data ( accel3_t *ctx, accel3_data_t *accel3_data )
 {
-    accel3_data->x = dev_get_axis( ctx, ACCEL3_OUT_X_H, ACCEL3_OUT_X_L );
-    accel3_data->y = dev_get_axis( ctx, ACCEL3_OUT_Y_H, ACCEL3_OUT_Y_L );
-    accel3_data->z = dev_get_axis( ctx, ACCEL3_OUT_Z_H, ACCEL3_OUT_Z_L );
-}
-
-// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
-
-static int16_t dev_get_axis ( accel3_t *ctx, uint8_t adr_reg_msb, uint8_t adr_reg_lsb )
-{
-    uint16_t result;
-    uint8_t buf_lbs[ 1 ];
-    uint8_t buf_mbs[ 1 ];
-    
-    accel3_generic_read( ctx, adr_reg_msb, buf_lbs, 1 );
-    accel3_generic_read( ctx, adr_reg_lsb, buf_mbs, 1 );
+    uint8_t rx_buf[ 6 ];
 
-    result = buf_lbs[ 0 ];
-    result <<= 8;
-    result |= buf_mbs[ 0 ];
+    accel3_generic_read( ctx, ACCEL3_OUT_X_L, rx_buf, 6 );
 
-    return result;
+    accel3_data->x = ( ( int16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+    accel3_data->y = ( ( int16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ];
+    accel3_data->z = ( ( int16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ];
 }
 
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
 static void accel3_i2c_write ( accel3_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
     uint8_t tx_buf[ 256 ];
@@ -224,6 +212,10 @@ static void accel3_i2c_write ( accel3_t *ctx, uint8_t reg, uint8_t *data_buf, ui
 
 static void accel3_i2c_read ( accel3_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
+    if ( len > 1 )
+    {
+        reg |= ACCEL3_I2C_AUTO_INC;
+    }
     i2c_master_write_then_read( &ctx->i2c, &reg, 1, data_buf, len );
 }
 
@@ -250,6 +242,10 @@ static void accel3_spi_read ( accel3_t *ctx, uint8_t reg, uint8_t *data_buf, uin
     uint8_t cnt;
 
     tx_buf[ 0 ] = reg | 0x80;
+    if ( len > 1 )
+    {
+        tx_buf[ 0 ] |= ACCEL3_SPI_AUTO_INC;
+    }
     
     spi_master_select_device( ctx->chip_select );
     spi_master_write_then_read( &ctx->spi, tx_buf, 1, data_buf, len );
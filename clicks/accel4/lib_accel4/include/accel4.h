@@ -400,7 +400,7 @@ uint8_t accel4_get_int2 ( accel4_t *ctx );
 
 /**
  * @brief Accel data reading.
- * @details This function reads a accel data and calculates it with 
+ * @details This function reads a accel data in a single burst and calculates it with 
  * resolution set in @b ctx object. Data will be set in @b axes object.
  * @param[in] ctx : Click context object.
  * See #accel4_t object definition for detailed explanation.
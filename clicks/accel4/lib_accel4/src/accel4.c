@@ -259,21 +259,20 @@ uint8_t accel4_get_int2 ( accel4_t *ctx )
 
 err_t accel4_get_axes_data ( accel4_t *ctx, accel4_axes_t *axes )
 {
-    uint8_t temp_axis_data[ 2 ] = { 0 };
+    uint8_t temp_axis_data[ 6 ] = { 0 };
     int16_t axis_data;
     err_t ret_val = ACCEL4_OK;
     ctx->resolution = 0.98;
     
-    ret_val |= accel4_generic_read( ctx, ACCEL4_REG_OUT_X_LSB, &temp_axis_data, 2 );
+    ret_val |= accel4_generic_read( ctx, ACCEL4_REG_OUT_X_LSB, temp_axis_data, 6 );
+    
     axis_data = temp_axis_data[ 0 ] | ( ( int16_t )temp_axis_data[ 1 ] << 8 );
     axes->x = axis_data * ctx->resolution;
     
-    ret_val |= accel4_generic_read( ctx, ACCEL4_REG_OUT_Y_LSB, &temp_axis_data, 2 );
-    axis_data = temp_axis_data[ 0 ] | ( ( int16_t )temp_axis_data[ 1 ] << 8 );
+    axis_data = temp_axis_data[ 2 ] | ( ( int16_t )temp_axis_data[ 3 ] << 8 );
     axes->y = axis_data * ctx->resolution;
     
-    ret_val |= accel4_generic_read( ctx, ACCEL4_REG_OUT_Z_LSB, &temp_axis_data, 2 );
-    axis_data = temp_axis_data[ 0 ] | ( ( int16_t )temp_axis_data[ 1 ] << 8 );
+    axis_data = temp_axis_data[ 4 ] | ( ( int16_t )temp_axis_data[ 5 ] << 8 );
     axes->z = axis_data * ctx->resolution;
     
     return ret_val;
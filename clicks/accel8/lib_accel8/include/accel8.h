@@ -429,6 +429,21 @@ typedef struct
 
 } range_retval_t;
 
+/**
+ * @brief Output data structure.
+ */
+typedef struct
+{
+    int16_t accel_x;
+    int16_t accel_y;
+    int16_t accel_z;
+    int16_t temp_out;
+    int16_t gyro_x;
+    int16_t gyro_y;
+    int16_t gyro_z;
+
+} accel8_data_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -549,6 +564,17 @@ void accel8_get_accel_axis ( accel8_t *ctx, int16_t *x_axis, int16_t *y_axis, in
  */
 void accel8_get_gyro_axis ( accel8_t *ctx, int16_t *x_axis, int16_t *y_axis, int16_t *z_axis );
 
+/**
+ * @brief Functions for read Accel, Temperature and Gyro data
+ *
+ * @param ctx          Click object.
+ * @param data_out     Output data structure.
+ *
+ * @description This function reads Accel, Temperature and Gyro data
+ * in a single 14-byte burst, so all values belong to the same sample.
+ */
+void accel8_get_data ( accel8_t *ctx, accel8_data_t *data_out );
+
 /**
  * @brief Functions for read INT pin state
  *
@@ -193,16 +193,39 @@ float accel8_get_temperature ( accel8_t *ctx )
 
 void accel8_get_accel_axis ( accel8_t *ctx, int16_t *x_axis, int16_t *y_axis, int16_t *z_axis )
 {
-    *x_axis = accel8_read_data( ctx, ACCEL8_ACCEL_X_AXIS_DATA );
-    *y_axis = accel8_read_data( ctx, ACCEL8_ACCEL_Y_AXIS_DATA );
-    *z_axis = accel8_read_data( ctx, ACCEL8_ACCEL_Z_AXIS_DATA );
+    uint8_t rx_buf[ 6 ];
+
+    accel8_generic_read( ctx, ACCEL8_ACCEL_X_AXIS_DATA, rx_buf, 6 );
+
+    *x_axis = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *y_axis = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *z_axis = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
 }
 
 void accel8_get_gyro_axis ( accel8_t *ctx, int16_t *x_axis, int16_t *y_axis, int16_t *z_axis )
 {
-    *x_axis = accel8_read_data( ctx, ACCEL8_GYRO_X_AXIS_DATA );
-    *y_axis = accel8_read_data( ctx, ACCEL8_GYRO_Y_AXIS_DATA );
-    *z_axis = accel8_read_data( ctx, ACCEL8_GYRO_Z_AXIS_DATA );
+    uint8_t rx_buf[ 6 ];
+
+    accel8_generic_read( ctx, ACCEL8_GYRO_X_AXIS_DATA, rx_buf, 6 );
+
+    *x_axis = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    *y_axis = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    *z_axis = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
+}
+
+void accel8_get_data ( accel8_t *ctx, accel8_data_t *data_out )
+{
+    uint8_t rx_buf[ 14 ];
+
+    accel8_generic_read( ctx, ACCEL8_ACCEL_X_AXIS_DATA, rx_buf, 14 );
+
+    data_out->accel_x = ( ( int16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ];
+    data_out->accel_y = ( ( int16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    data_out->accel_z = ( ( int16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 5 ];
+    data_out->temp_out = ( ( int16_t ) rx_buf[ 6 ] << 8 ) | rx_buf[ 7 ];
+    data_out->gyro_x = ( ( int16_t ) rx_buf[ 8 ] << 8 ) | rx_buf[ 9 ];
+    data_out->gyro_y = ( ( int16_t ) rx_buf[ 10 ] << 8 ) | rx_buf[ 11 ];
+    data_out->gyro_z = ( ( int16_t ) rx_buf[ 12 ] << 8 ) | rx_buf[ 13 ];
 }
 
 uint8_t accel8_get_interrupt ( accel8_t *ctx )
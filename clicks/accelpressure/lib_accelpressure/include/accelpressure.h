@@ -651,7 +651,7 @@ err_t accelpressure_set_fsr ( accelpressure_t *ctx, uint8_t fsr );
 
 /**
  * @brief AccelPressure get the accel sensor axes function.
- * @details This function reads the accelerometer sensor axes data 
+ * @details This function reads the accelerometer sensor axes data in a single burst
  * of the FXLS8974, 3-Axis Low-g Accelerometer on the AccelPressure Click board.
  * @param[in] ctx : Click context object.
  * See #accelpressure_t object definition for detailed explanation.
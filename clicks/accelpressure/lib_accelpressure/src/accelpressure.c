@@ -252,25 +252,23 @@ err_t accelpressure_set_fsr ( accelpressure_t *ctx, uint8_t fsr )
 
 err_t accelpressure_get_axes_data ( accelpressure_t *ctx, accelpressure_axes_t *axes )
 {
-    uint8_t data_buf[ 2 ] = { 0 };
+    uint8_t data_buf[ 6 ] = { 0 };
     int16_t axis_data = DUMMY;
     
-    err_t err_flag = accelpressure_acc_reg_read( ctx, ACCELPRESSURE_ACC_REG_OUT_X_LSB, data_buf, 2 );
+    err_t err_flag = accelpressure_acc_reg_read( ctx, ACCELPRESSURE_ACC_REG_OUT_X_LSB, data_buf, 6 );
     axis_data = data_buf[ 1 ];
     axis_data <<= 8;
     axis_data |= data_buf[ 0 ];
     axes->x = ( float ) axis_data * ctx->sensitivity;
     
-    err_flag |= accelpressure_acc_reg_read( ctx, ACCELPRESSURE_ACC_REG_OUT_Y_LSB, data_buf, 2 );
-    axis_data = data_buf[ 1 ];
+    axis_data = data_buf[ 3 ];
     axis_data <<= 8;
-    axis_data |= data_buf[ 0 ];
+    axis_data |= data_buf[ 2 ];
     axes->y = ( float ) axis_data * ctx->sensitivity;
     
-    err_flag |= accelpressure_acc_reg_read( ctx, ACCELPRESSURE_ACC_REG_OUT_Z_LSB, data_buf, 2 );
-    axis_data = data_buf[ 1 ];
+    axis_data = data_buf[ 5 ];
     axis_data <<= 8;
-    axis_data |= data_buf[ 0 ];
+    axis_data |= data_buf[ 4 ];
     axes->z = ( float ) axis_data * ctx->sensitivity;
     
     return err_flag;
@@ -27,14 +27,6 @@
 
 #include "clickid.h"
 
-/** 
- * @brief Reflect bits.
- * @details This function reflects a desired number of bits in data.
- * @return Reflected data.
- * @note None.
- */
-static uint16_t clickid_reflect_bits( uint16_t data_in, uint8_t len );
-
 /** 
  * @brief CRC-16/MAXIM calculation for CRC16 function.
  * @details This function calculates CRC16 with parameteres: 
@@ -319,56 +311,38 @@ err_t clickid_read_information ( clickid_t *ctx, clickid_information_t *info )
     return error_flag;
 }
 
-static uint16_t clickid_reflect_bits( uint16_t data_in, uint8_t len )
-{
-    uint16_t data_out = 0;
-    for ( uint16_t cnt = 0; cnt < len; cnt++ )
-    {
-        data_out |= ( ( data_in >> cnt ) & 1 ) << ( len - cnt - 1 );
-    }
-    return data_out;
-}
-
 static uint16_t clickid_calculate_crc16( uint8_t *data_buf, uint16_t len )
 {
+    // CRC of each nibble value for reflected polynomial 0xA001, processed 4 bits at a time
+    static const uint16_t crc16_table[ 16 ] = 
+    {
+        0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
+        0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400
+    };
     uint16_t crc16 = 0x0000;
     for ( uint16_t cnt = 0; cnt < len; cnt++ )
     {
-        crc16 ^= ( clickid_reflect_bits( data_buf[ cnt ], 8 ) << 8 );
-        for ( uint8_t bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
-        {
-            if ( crc16 & 0x8000 )
-            {
-                crc16 = ( crc16 << 1 ) ^ 0x8005;
-            }
-            else
-            {
-                crc16 <<= 1;
-            }
-        }
+        crc16 = ( crc16 >> 4 ) ^ crc16_table[ ( crc16 ^ data_buf[ cnt ] ) & 0x0F ];
+        crc16 = ( crc16 >> 4 ) ^ crc16_table[ ( crc16 ^ ( data_buf[ cnt ] >> 4 ) ) & 0x0F ];
     }
-    return clickid_reflect_bits( crc16, 16 ) ^ 0xFFFF;
+    return crc16 ^ 0xFFFF;
 }
 
 static uint8_t clickid_calculate_crc8 ( uint8_t *data_buf, uint8_t len )
 {
+    // CRC of each nibble value for reflected polynomial 0x8C, processed 4 bits at a time
+    static const uint8_t crc8_table[ 16 ] = 
+    {
+        0x00, 0x9D, 0x23, 0xBE, 0x46, 0xDB, 0x65, 0xF8,
+        0x8C, 0x11, 0xAF, 0x32, 0xCA, 0x57, 0xE9, 0x74
+    };
     uint8_t crc = 0;
     uint8_t byte_cnt = 0;
-    uint8_t bit_cnt = 0;
     for ( byte_cnt = 0; byte_cnt < len; byte_cnt++ ) 
     {
         crc ^= data_buf[ byte_cnt ];
-        for ( bit_cnt = 0; bit_cnt < 8; bit_cnt++ ) 
-        {
-            if ( crc & 0x01 ) 
-            {
-                crc = ( crc >> 1 ) ^ 0x8C;
-            }
-            else
-            {
-                crc >>= 1;
-            }
-        }
+        crc = ( crc >> 4 ) ^ crc8_table[ crc & 0x0F ];
+        crc = ( crc >> 4 ) ^ crc8_table[ crc & 0x0F ];
     }
     return crc;
 }
@@ -26,6 +26,65 @@
  */
 
 #include "ecg5.h"
+#include "math.h"
+#include "string.h"
+
+/**
+ * @brief ECG 5 acquisition filter settings.
+ * @details Private settings of the block acquisition filters of ECG 5 Click driver.
+ */
+#define ACQ_COEF_ONE            ( ( float ) ( 1ul << ECG5_ACQ_COEF_BITS ) )
+#define ACQ_PI                  3.14159265
+#define ACQ_DC_CUTOFF_HZ        0.1
+#define ACQ_NOTCH_Q             8.0
+
+/**
+ * @brief ECG 5 biquad set function.
+ * @details This function normalizes the biquad coefficients to fixed-point format
+ * and clears the filter states.
+ */
+static void dev_biquad_set ( ecg5_biquad_t *bq, float b0, float b1, float b2, float a0, float a1, float a2 );
+
+/**
+ * @brief ECG 5 biquad band-pass design function.
+ * @details This function designs a second order band-pass section with edges
+ * prewarped for the bilinear transform.
+ */
+static void dev_biquad_band_pass ( ecg5_biquad_t *bq, float fs, float f_low, float f_high );
+
+/**
+ * @brief ECG 5 biquad run function.
+ * @details This function filters a single sample in direct form I with a 64-bit accumulator.
+ */
+static int32_t dev_biquad_run ( ecg5_biquad_t *bq, int32_t sample );
+
+/**
+ * @brief ECG 5 QRS detector settings.
+ * @details Private settings of the Pan-Tompkins QRS detector of ECG 5 Click driver.
+ */
+#define QRS_BAND_LOW_HZ         5.0
+#define QRS_BAND_HIGH_HZ        15.0
+#define QRS_SLOPE_MAX           4095
+
+/**
+ * @brief ECG 5 QRS detector step function.
+ * @details This function advances the QRS detector by a single sample and
+ * returns 1 when a QRS complex is detected.
+ */
+static uint8_t dev_qrs_step ( ecg5_qrs_t *qrs, int32_t sample );
+
+/**
+ * @brief ECG 5 QRS beat function.
+ * @details This function registers a detected QRS complex and updates the average RR interval.
+ */
+static void dev_qrs_beat ( ecg5_qrs_t *qrs, uint32_t pos );
+
+/**
+ * @brief ECG 5 QRS threshold function.
+ * @details This function updates the detection threshold from the signal and noise
+ * peak estimates, keeping the signal estimate at or above the noise estimate.
+ */
+static void dev_qrs_threshold ( ecg5_qrs_t *qrs );
 
 void ecg5_cfg_setup ( ecg5_cfg_t *cfg ) {
     cfg->an = HAL_PIN_NC;
@@ -100,4 +159,319 @@ err_t ecg5_check_lod_positive ( ecg5_t *ctx ) {
     }
 }
 
+err_t ecg5_acq_start ( ecg5_t *ctx, uint16_t sample_rate, uint8_t mains_freq, float band_low, float band_high ) {
+    float fs = sample_rate;
+    float w0 = 0;
+    uint16_t sample = 0;
+
+    if ( ( 0 == sample_rate ) || ( band_low <= 0 ) || ( band_low >= band_high ) || 
+         ( band_high >= ( fs / 2 ) ) || ( mains_freq >= ( fs / 2 ) ) ) {
+        return ECG5_ERROR;
+    }
+    ctx->acq.running = 0;
+
+    if ( ECG5_OK != ecg5_read_an_pin_value( ctx, &sample ) ) {
+        return ECG5_ERROR;
+    }
+    ctx->acq.last_sample = sample;
+    ctx->acq.sample_rate = sample_rate;
+
+    // Single pole DC removal seeded with the current level to avoid a start-up step
+    ctx->acq.dc_coef = ( int32_t ) ( ( 1.0 - 2.0 * ACQ_PI * ACQ_DC_CUTOFF_HZ / fs ) * ACQ_COEF_ONE );
+    ctx->acq.dc_x1 = ( int32_t ) sample << ECG5_ACQ_FRAC_BITS;
+    ctx->acq.dc_y1 = 0;
+
+    if ( ECG5_ACQ_MAINS_OFF == mains_freq ) {
+        dev_biquad_set( &ctx->acq.notch, 1, 0, 0, 1, 0, 0 );
+    } else {
+        w0 = tan( ACQ_PI * mains_freq / fs );
+        dev_biquad_set( &ctx->acq.notch, 1 + w0 * w0, 2 * ( w0 * w0 - 1 ), 1 + w0 * w0, 
+                                         1 + w0 / ACQ_NOTCH_Q + w0 * w0, 2 * ( w0 * w0 - 1 ), 
+                                         1 - w0 / ACQ_NOTCH_Q + w0 * w0 );
+    }
+    dev_biquad_band_pass( &ctx->acq.band, fs, band_low, band_high );
+
+    ctx->acq.ready[ 0 ] = 0;
+    ctx->acq.ready[ 1 ] = 0;
+    ctx->acq.fill_buf = 0;
+    ctx->acq.fill_idx = 0;
+    ctx->acq.read_buf = 0;
+    ctx->acq.overrun = 0;
+    ctx->acq.running = 1;
+
+    return ECG5_OK;
+}
+
+void ecg5_acq_stop ( ecg5_t *ctx ) {
+    ctx->acq.running = 0;
+}
+
+void ecg5_acq_tick ( ecg5_t *ctx ) {
+    uint16_t sample = 0;
+
+    if ( !ctx->acq.running ) {
+        return;
+    }
+
+    // A failed conversion repeats the previous sample to keep the sampling grid intact
+    if ( ECG5_OK == ecg5_read_an_pin_value( ctx, &sample ) ) {
+        ctx->acq.last_sample = sample;
+    }
+    ctx->acq.block[ ctx->acq.fill_buf ][ ctx->acq.fill_idx ] = ctx->acq.last_sample;
+
+    if ( ++ctx->acq.fill_idx >= ECG5_ACQ_BLOCK_SIZE ) {
+        ctx->acq.fill_idx = 0;
+        ctx->acq.ready[ ctx->acq.fill_buf ] = 1;
+        ctx->acq.fill_buf ^= 1;
+        if ( ctx->acq.ready[ ctx->acq.fill_buf ] ) {
+            ctx->acq.ready[ ctx->acq.fill_buf ] = 0;
+            ctx->acq.overrun++;
+        }
+    }
+}
+
+err_t ecg5_acq_get_block ( ecg5_t *ctx, int32_t *data_out ) {
+    uint16_t *raw = NULL;
+    int32_t sample = 0;
+    int32_t dc_out = 0;
+
+    if ( NULL == data_out ) {
+        return ECG5_ERROR;
+    }
+    if ( !ctx->acq.ready[ ctx->acq.read_buf ] ) {
+        // The expected block was overwritten, continue with the other one
+        if ( !ctx->acq.ready[ ctx->acq.read_buf ^ 1 ] ) {
+            return ECG5_ERROR;
+        }
+        ctx->acq.read_buf ^= 1;
+    }
+
+    raw = ctx->acq.block[ ctx->acq.read_buf ];
+    for ( uint16_t cnt = 0; cnt < ECG5_ACQ_BLOCK_SIZE; cnt++ ) {
+        sample = ( int32_t ) raw[ cnt ] << ECG5_ACQ_FRAC_BITS;
+
+        dc_out = sample - ctx->acq.dc_x1 + 
+                 ( int32_t ) ( ( ( int64_t ) ctx->acq.dc_coef * ctx->acq.dc_y1 ) >> ECG5_ACQ_COEF_BITS );
+        ctx->acq.dc_x1 = sample;
+        ctx->acq.dc_y1 = dc_out;
+
+        sample = dev_biquad_run( &ctx->acq.notch, dc_out );
+        sample = dev_biquad_run( &ctx->acq.band, sample );
+
+        data_out[ cnt ] = ( sample + ( 1l << ( ECG5_ACQ_FRAC_BITS - 1 ) ) ) >> ECG5_ACQ_FRAC_BITS;
+    }
+
+    ctx->acq.ready[ ctx->acq.read_buf ] = 0;
+    ctx->acq.read_buf ^= 1;
+
+    return ECG5_OK;
+}
+
+err_t ecg5_qrs_start ( ecg5_t *ctx ) {
+    ecg5_qrs_t *qrs = &ctx->qrs;
+    uint16_t fs = ctx->acq.sample_rate;
+
+    if ( 0 == fs ) {
+        return ECG5_ERROR;
+    }
+
+    dev_biquad_band_pass( &qrs->band, fs, QRS_BAND_LOW_HZ, QRS_BAND_HIGH_HZ );
+
+    qrs->mwi_len = ( uint16_t ) ( ( ( uint32_t ) fs * 3 ) / 20 );
+    if ( qrs->mwi_len > ECG5_QRS_MWI_LEN_MAX ) {
+        qrs->mwi_len = ECG5_QRS_MWI_LEN_MAX;
+    } else if ( 0 == qrs->mwi_len ) {
+        qrs->mwi_len = 1;
+    }
+    memset( qrs->mwi, 0, sizeof( qrs->mwi ) );
+    memset( qrs->deriv, 0, sizeof( qrs->deriv ) );
+    qrs->mwi_sum = 0;
+    qrs->mwi_idx = 0;
+
+    qrs->sample_cnt = 0;
+    qrs->learn_len = ( uint32_t ) fs * 2;
+    qrs->refractory = fs / 5;
+    qrs->peak = 0;
+    qrs->peak_pos = 0;
+    qrs->spki = 0;
+    qrs->npki = 0;
+    qrs->threshold = 0;
+    qrs->sb_peak = 0;
+    qrs->sb_pos = 0;
+    qrs->last_qrs = 0;
+    qrs->rr_avg = 0;
+    qrs->rr_sum = 0;
+    qrs->beat_cnt = 0;
+
+    return ECG5_OK;
+}
+
+uint8_t ecg5_qrs_process ( ecg5_t *ctx, int32_t *data_in, uint16_t len ) {
+    uint8_t num_qrs = 0;
+
+    for ( uint16_t cnt = 0; cnt < len; cnt++ ) {
+        num_qrs += dev_qrs_step( &ctx->qrs, data_in[ cnt ] );
+    }
+
+    return num_qrs;
+}
+
+err_t ecg5_qrs_get_heart_rate ( ecg5_t *ctx, float *heart_rate ) {
+    if ( ( NULL == heart_rate ) || ( 0 == ctx->qrs.rr_avg ) ) {
+        return ECG5_ERROR;
+    }
+
+    *heart_rate = 60.0 * 8 * ctx->acq.sample_rate / ctx->qrs.rr_sum;
+
+    return ECG5_OK;
+}
+
+static void dev_biquad_set ( ecg5_biquad_t *bq, float b0, float b1, float b2, float a0, float a1, float a2 ) {
+    bq->b0 = ( int32_t ) ( b0 / a0 * ACQ_COEF_ONE );
+    bq->b1 = ( int32_t ) ( b1 / a0 * ACQ_COEF_ONE );
+    bq->b2 = ( int32_t ) ( b2 / a0 * ACQ_COEF_ONE );
+    bq->a1 = ( int32_t ) ( a1 / a0 * ACQ_COEF_ONE );
+    bq->a2 = ( int32_t ) ( a2 / a0 * ACQ_COEF_ONE );
+    bq->x1 = 0;
+    bq->x2 = 0;
+    bq->y1 = 0;
+    bq->y2 = 0;
+}
+
+static void dev_biquad_band_pass ( ecg5_biquad_t *bq, float fs, float f_low, float f_high ) {
+    float w_low = tan( ACQ_PI * f_low / fs );
+    float w_high = tan( ACQ_PI * f_high / fs );
+    float bw = w_high - w_low;
+    float w0_sq = w_low * w_high;
+
+    dev_biquad_set( bq, bw, 0, -bw, 1 + bw + w0_sq, 2 * ( w0_sq - 1 ), 1 - bw + w0_sq );
+}
+
+static int32_t dev_biquad_run ( ecg5_biquad_t *bq, int32_t sample ) {
+    int64_t acc = ( int64_t ) bq->b0 * sample;
+    acc += ( int64_t ) bq->b1 * bq->x1;
+    acc += ( int64_t ) bq->b2 * bq->x2;
+    acc -= ( int64_t ) bq->a1 * bq->y1;
+    acc -= ( int64_t ) bq->a2 * bq->y2;
+
+    bq->x2 = bq->x1;
+    bq->x1 = sample;
+    bq->y2 = bq->y1;
+    bq->y1 = ( int32_t ) ( ( acc + ( 1ll << ( ECG5_ACQ_COEF_BITS - 1 ) ) ) >> ECG5_ACQ_COEF_BITS );
+
+    return bq->y1;
+}
+
+static uint8_t dev_qrs_step ( ecg5_qrs_t *qrs, int32_t sample ) {
+    int32_t slope = 0;
+    uint32_t mwi_out = 0;
+    uint32_t pos = qrs->sample_cnt++;
+
+    // Band-pass, five point derivative and squaring
+    sample = dev_biquad_run( &qrs->band, sample << ECG5_ACQ_FRAC_BITS );
+    slope = ( 2 * sample + qrs->deriv[ 0 ] - qrs->deriv[ 2 ] - 2 * qrs->deriv[ 3 ] ) >> ( ECG5_ACQ_FRAC_BITS - 1 );
+    qrs->deriv[ 3 ] = qrs->deriv[ 2 ];
+    qrs->deriv[ 2 ] = qrs->deriv[ 1 ];
+    qrs->deriv[ 1 ] = qrs->deriv[ 0 ];
+    qrs->deriv[ 0 ] = sample;
+    if ( slope > QRS_SLOPE_MAX ) {
+        slope = QRS_SLOPE_MAX;
+    } else if ( slope < -QRS_SLOPE_MAX ) {
+        slope = -QRS_SLOPE_MAX;
+    }
+
+    // Moving window integration
+    qrs->mwi_sum -= qrs->mwi[ qrs->mwi_idx ];
+    qrs->mwi[ qrs->mwi_idx ] = ( uint32_t ) ( slope * slope );
+    qrs->mwi_sum += qrs->mwi[ qrs->mwi_idx ];
+    if ( ++qrs->mwi_idx >= qrs->mwi_len ) {
+        qrs->mwi_idx = 0;
+    }
+    mwi_out = qrs->mwi_sum / qrs->mwi_len;
+
+    if ( pos < qrs->learn_len ) {
+        // Learn the initial signal peak and the noise level
+        if ( mwi_out > qrs->spki ) {
+            qrs->spki = mwi_out;
+        }
+        if ( mwi_out > qrs->npki ) {
+            qrs->npki += ( mwi_out - qrs->npki ) >> 6;
+        } else {
+            qrs->npki -= ( qrs->npki - mwi_out ) >> 6;
+        }
+        if ( ( pos + 1 ) == qrs->learn_len ) {
+            qrs->spki /= 3;
+            qrs->npki /= 2;
+            dev_qrs_threshold( qrs );
+            qrs->last_qrs = pos;
+        }
+        return 0;
+    }
+
+    if ( mwi_out > qrs->peak ) {
+        qrs->peak = mwi_out;
+        qrs->peak_pos = pos;
+        return 0;
+    }
+
+    if ( ( qrs->peak > 0 ) && ( mwi_out < ( qrs->peak >> 1 ) ) ) {
+        // Integrated waveform fell to half of the peak, classify the peak
+        uint32_t peak = qrs->peak;
+        uint32_t peak_pos = qrs->peak_pos;
+        qrs->peak = 0;
+        if ( ( peak_pos - qrs->last_qrs ) > qrs->refractory ) {
+            if ( peak > qrs->threshold ) {
+                qrs->spki = ( peak + 7 * qrs->spki ) >> 3;
+                dev_qrs_threshold( qrs );
+                qrs->sb_peak = 0;
+                dev_qrs_beat( qrs, peak_pos );
+                return 1;
+            }
+            qrs->npki = ( peak + 7 * qrs->npki ) >> 3;
+            dev_qrs_threshold( qrs );
+            if ( peak > qrs->sb_peak ) {
+                qrs->sb_peak = peak;
+                qrs->sb_pos = peak_pos;
+            }
+        }
+    }
+
+    // Search back for a missed beat after 166 % of the average RR interval
+    if ( ( qrs->rr_avg > 0 ) && ( ( pos - qrs->last_qrs ) > ( ( qrs->rr_avg * 166 ) / 100 ) ) && 
+         ( qrs->sb_peak > ( qrs->threshold >> 1 ) ) ) {
+        qrs->spki = ( qrs->sb_peak + 3 * qrs->spki ) >> 2;
+        dev_qrs_threshold( qrs );
+        qrs->sb_peak = 0;
+        dev_qrs_beat( qrs, qrs->sb_pos );
+        return 1;
+    }
+
+    return 0;
+}
+
+static void dev_qrs_beat ( ecg5_qrs_t *qrs, uint32_t pos ) {
+    uint32_t rr = pos - qrs->last_qrs;
+
+    // The average is kept scaled by 8, averaging in whole samples drifts low on jittery intervals
+    if ( qrs->beat_cnt > 1 ) {
+        qrs->rr_sum += rr - ( qrs->rr_sum >> 3 );
+        qrs->rr_avg = ( qrs->rr_sum + 4 ) >> 3;
+    } else if ( qrs->beat_cnt > 0 ) {
+        qrs->rr_sum = rr << 3;
+        qrs->rr_avg = rr;
+        qrs->beat_cnt++;
+    } else {
+        qrs->beat_cnt++;
+    }
+    qrs->last_qrs = pos;
+}
+
+static void dev_qrs_threshold ( ecg5_qrs_t *qrs ) {
+    // Flat or noise-only input can leave the signal estimate below the noise estimate
+    if ( qrs->spki < qrs->npki ) {
+        qrs->spki = qrs->npki;
+    }
+    qrs->threshold = qrs->npki + ( ( qrs->spki - qrs->npki ) >> 2 );
+}
+
 // ------------------------------------------------------------------------- END
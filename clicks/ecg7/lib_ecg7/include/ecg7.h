@@ -82,6 +82,26 @@ extern "C"{
  */
 #define ECG7_SET_DEV_ADDR      0x4D
 
+/**
+ * @brief ECG 7 block acquisition setting.
+ * @details Specified setting for block acquisition of ECG 7 Click driver.
+ */
+#define ECG7_ACQ_BLOCK_SIZE                64
+#define ECG7_ACQ_FRAC_BITS                 8
+#define ECG7_ACQ_COEF_BITS                 28
+#define ECG7_ACQ_MAINS_OFF                 0
+#define ECG7_ACQ_MAINS_50HZ                50
+#define ECG7_ACQ_MAINS_60HZ                60
+#define ECG7_ACQ_BAND_LOW_HZ               0.5
+#define ECG7_ACQ_BAND_HIGH_HZ              40.0
+
+/**
+ * @brief ECG 7 QRS detector setting.
+ * @details Specified setting for Pan-Tompkins QRS detector of ECG 7 Click driver.
+ * The integration window is 150 ms, so the full window is kept up to a 1000 Hz sample rate.
+ */
+#define ECG7_QRS_MWI_LEN_MAX               150
+
 /*! @} */ // ecg7_set
 
 /**
@@ -117,6 +137,78 @@ typedef enum
 
 } ecg7_drv_t;
 
+/**
+ * @brief ECG 7 Click fixed-point biquad filter object.
+ * @details Second order section of ECG 7 Click driver with coefficients
+ * in Q28 format and states scaled by 2^ECG7_ACQ_FRAC_BITS.
+ */
+typedef struct
+{
+    int32_t b0;                     /**< Feed-forward coefficient 0. */
+    int32_t b1;                     /**< Feed-forward coefficient 1. */
+    int32_t b2;                     /**< Feed-forward coefficient 2. */
+    int32_t a1;                     /**< Feedback coefficient 1. */
+    int32_t a2;                     /**< Feedback coefficient 2. */
+    int32_t x1;                     /**< Input delayed by one sample. */
+    int32_t x2;                     /**< Input delayed by two samples. */
+    int32_t y1;                     /**< Output delayed by one sample. */
+    int32_t y2;                     /**< Output delayed by two samples. */
+
+} ecg7_biquad_t;
+
+/**
+ * @brief ECG 7 Click block acquisition object.
+ * @details Double-buffered acquisition state of ECG 7 Click driver, filled by #ecg7_acq_tick
+ * and filtered by #ecg7_acq_get_block.
+ */
+typedef struct
+{
+    uint16_t block[ 2 ][ ECG7_ACQ_BLOCK_SIZE ];   /**< Raw ADC sample blocks. */
+    volatile uint8_t  ready[ 2 ];   /**< Block filled and not yet processed flags. */
+    volatile uint8_t  fill_buf;     /**< Block being filled by the timer tick. */
+    volatile uint16_t fill_idx;     /**< Next sample position in the filled block. */
+    volatile uint16_t overrun;      /**< Number of blocks overwritten before processing. */
+    volatile uint8_t  running;      /**< Acquisition running flag. */
+    uint8_t  read_buf;              /**< Next block to be processed. */
+    uint16_t last_sample;           /**< Last raw ADC sample. */
+    uint16_t sample_rate;           /**< Timer tick rate [Hz]. */
+    int32_t  dc_coef;               /**< DC removal pole. */
+    int32_t  dc_x1;                 /**< DC removal input state. */
+    int32_t  dc_y1;                 /**< DC removal output state. */
+    ecg7_biquad_t notch;             /**< Mains notch filter. */
+    ecg7_biquad_t band;              /**< Band-pass filter. */
+
+} ecg7_acq_t;
+
+/**
+ * @brief ECG 7 Click QRS detector object.
+ * @details Streaming Pan-Tompkins QRS detector state of ECG 7 Click driver, advanced by #ecg7_qrs_process.
+ */
+typedef struct
+{
+    ecg7_biquad_t band;              /**< 5-15 Hz QRS band-pass filter. */
+    int32_t  deriv[ 4 ];            /**< Derivative input history. */
+    uint32_t mwi[ ECG7_QRS_MWI_LEN_MAX ];  /**< Squared slope integration window. */
+    uint32_t mwi_sum;               /**< Integration window sum. */
+    uint16_t mwi_len;               /**< Integration window length in samples. */
+    uint16_t mwi_idx;               /**< Integration window write position. */
+    uint32_t sample_cnt;            /**< Number of processed samples. */
+    uint32_t learn_len;             /**< Threshold learning period in samples. */
+    uint32_t refractory;            /**< Refractory period in samples. */
+    uint32_t peak;                  /**< Current integrated peak candidate. */
+    uint32_t peak_pos;              /**< Current peak candidate position. */
+    uint32_t spki;                  /**< Running signal peak estimate. */
+    uint32_t npki;                  /**< Running noise peak estimate. */
+    uint32_t threshold;             /**< Detection threshold. */
+    uint32_t sb_peak;               /**< Largest sub-threshold peak for search-back. */
+    uint32_t sb_pos;                /**< Search-back peak position. */
+    uint32_t last_qrs;              /**< Position of the last detected QRS complex. */
+    uint32_t rr_avg;                /**< Average RR interval in samples, 0 until two beats are found. */
+    uint32_t rr_sum;                /**< Average RR interval scaled by 8. */
+    uint8_t  beat_cnt;              /**< Number of detected beats, saturated at 2. */
+
+} ecg7_qrs_t;
+
 /**
  * @brief ECG 7 Click context object.
  * @details Context object definition of ECG 7 Click driver.
@@ -131,6 +223,9 @@ typedef struct
     float       vref;               /**< ADC reference voltage. */
     ecg7_drv_t drv_sel;             /**< Master driver interface selector. */
 
+    ecg7_acq_t acq;                 /**< Block acquisition object. */
+    ecg7_qrs_t qrs;                 /**< QRS detector object. */
+
 } ecg7_t;
 
 /**
@@ -251,6 +346,104 @@ err_t ecg7_read_voltage ( ecg7_t *ctx, float *voltage );
  */
 err_t ecg7_set_vref ( ecg7_t *ctx, float vref );
 
+/**
+ * @brief ECG 7 acquisition start function.
+ * @details This function computes the fixed-point filter coefficients for the selected
+ * sample rate, resets the acquisition blocks and filter states and starts the block acquisition.
+ * The filter chain is DC removal, mains notch and band-pass.
+ * @param[in] ctx : Click context object.
+ * See #ecg7_t object definition for detailed explanation.
+ * @param[in] sample_rate : Rate at which #ecg7_acq_tick is called [Hz].
+ * @param[in] mains_freq : Mains notch frequency, @li @c  0 - Notch disabled,
+ *                                                @li @c 50 - 50 Hz,
+ *                                                @li @c 60 - 60 Hz.
+ * @param[in] band_low : Band-pass lower edge [Hz], e.g. ECG7_ACQ_BAND_LOW_HZ.
+ * @param[in] band_high : Band-pass upper edge [Hz], e.g. ECG7_ACQ_BAND_HIGH_HZ.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The band edges and the mains frequency must be below half of the sample rate.
+ */
+err_t ecg7_acq_start ( ecg7_t *ctx, uint16_t sample_rate, uint8_t mains_freq, float band_low, float band_high );
+
+/**
+ * @brief ECG 7 acquisition stop function.
+ * @details This function stops the block acquisition, further timer ticks are ignored.
+ * @param[in] ctx : Click context object.
+ * See #ecg7_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void ecg7_acq_stop ( ecg7_t *ctx );
+
+/**
+ * @brief ECG 7 acquisition tick function.
+ * @details This function reads a single ADC sample into the block being filled and swaps
+ * the blocks when it is full. A block that was not processed in time is overwritten
+ * and counted in @b ctx->acq.overrun.
+ * @param[in] ctx : Click context object.
+ * See #ecg7_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note Call this function from a periodic timer interrupt running at the sample rate
+ * set by #ecg7_acq_start.
+ * In I2C mode each tick performs a two byte bus read, so the bus speed has to leave
+ * margin within the sample period.
+ */
+void ecg7_acq_tick ( ecg7_t *ctx );
+
+/**
+ * @brief ECG 7 acquisition get block function.
+ * @details This function takes the oldest filled block, runs it through the fixed-point
+ * filter chain and marks it free for the timer tick.
+ * @param[in] ctx : Click context object.
+ * See #ecg7_t object definition for detailed explanation.
+ * @param[out] data_out : ECG7_ACQ_BLOCK_SIZE filtered samples in ADC counts.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no block is ready.
+ * See #err_t definition for detailed explanation.
+ * @note A block must be processed within one block period to avoid overruns.
+ */
+err_t ecg7_acq_get_block ( ecg7_t *ctx, int32_t *data_out );
+
+/**
+ * @brief ECG 7 QRS detector start function.
+ * @details This function resets the streaming Pan-Tompkins QRS detector for the sample rate
+ * set by #ecg7_acq_start. The adaptive thresholds are learned during the first 2 seconds.
+ * @param[in] ctx : Click context object.
+ * See #ecg7_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, acquisition is not started.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t ecg7_qrs_start ( ecg7_t *ctx );
+
+/**
+ * @brief ECG 7 QRS detector process function.
+ * @details This function feeds a block of filtered samples to the QRS detector.
+ * @param[in] ctx : Click context object.
+ * See #ecg7_t object definition for detailed explanation.
+ * @param[in] data_in : Filtered samples from #ecg7_acq_get_block.
+ * @param[in] len : Number of samples.
+ * @return Number of QRS complexes detected in the block.
+ * @note The position of the last complex is kept in @b ctx->qrs.last_qrs
+ * as a sample index delayed by the integration window.
+ */
+uint8_t ecg7_qrs_process ( ecg7_t *ctx, int32_t *data_in, uint16_t len );
+
+/**
+ * @brief ECG 7 QRS detector get heart rate function.
+ * @details This function calculates the heart rate from the average RR interval.
+ * @param[in] ctx : Click context object.
+ * See #ecg7_t object definition for detailed explanation.
+ * @param[out] heart_rate : Heart rate [bpm].
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, less than two beats detected.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t ecg7_qrs_get_heart_rate ( ecg7_t *ctx, float *heart_rate );
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,31 @@ extern "C"{
  * @{
  */
 
+/**
+ * @defgroup eeg_set EEG Settings
+ * @brief Settings of EEG Click driver.
+ */
+
+/**
+ * @addtogroup eeg_set
+ * @{
+ */
+
+/**
+ * @brief EEG block acquisition setting.
+ * @details Specified setting for block acquisition of EEG Click driver.
+ */
+#define EEG_ACQ_BLOCK_SIZE                64
+#define EEG_ACQ_FRAC_BITS                 8
+#define EEG_ACQ_COEF_BITS                 28
+#define EEG_ACQ_MAINS_OFF                 0
+#define EEG_ACQ_MAINS_50HZ                50
+#define EEG_ACQ_MAINS_60HZ                60
+#define EEG_ACQ_BAND_LOW_HZ               0.5
+#define EEG_ACQ_BAND_HIGH_HZ              40.0
+
+/*! @} */ // eeg_set
+
 /**
  * @defgroup eeg_map EEG MikroBUS Map
  * @brief MikroBUS pin mapping of EEG Click driver.
@@ -76,6 +101,49 @@ extern "C"{
 /*! @} */ // eeg_map
 /*! @} */ // eeg
 
+/**
+ * @brief EEG Click fixed-point biquad filter object.
+ * @details Second order section of EEG Click driver with coefficients
+ * in Q28 format and states scaled by 2^EEG_ACQ_FRAC_BITS.
+ */
+typedef struct
+{
+    int32_t b0;                     /**< Feed-forward coefficient 0. */
+    int32_t b1;                     /**< Feed-forward coefficient 1. */
+    int32_t b2;                     /**< Feed-forward coefficient 2. */
+    int32_t a1;                     /**< Feedback coefficient 1. */
+    int32_t a2;                     /**< Feedback coefficient 2. */
+    int32_t x1;                     /**< Input delayed by one sample. */
+    int32_t x2;                     /**< Input delayed by two samples. */
+    int32_t y1;                     /**< Output delayed by one sample. */
+    int32_t y2;                     /**< Output delayed by two samples. */
+
+} eeg_biquad_t;
+
+/**
+ * @brief EEG Click block acquisition object.
+ * @details Double-buffered acquisition state of EEG Click driver, filled by #eeg_acq_tick
+ * and filtered by #eeg_acq_get_block.
+ */
+typedef struct
+{
+    uint16_t block[ 2 ][ EEG_ACQ_BLOCK_SIZE ];   /**< Raw ADC sample blocks. */
+    volatile uint8_t  ready[ 2 ];   /**< Block filled and not yet processed flags. */
+    volatile uint8_t  fill_buf;     /**< Block being filled by the timer tick. */
+    volatile uint16_t fill_idx;     /**< Next sample position in the filled block. */
+    volatile uint16_t overrun;      /**< Number of blocks overwritten before processing. */
+    volatile uint8_t  running;      /**< Acquisition running flag. */
+    uint8_t  read_buf;              /**< Next block to be processed. */
+    uint16_t last_sample;           /**< Last raw ADC sample. */
+    uint16_t sample_rate;           /**< Timer tick rate [Hz]. */
+    int32_t  dc_coef;               /**< DC removal pole. */
+    int32_t  dc_x1;                 /**< DC removal input state. */
+    int32_t  dc_y1;                 /**< DC removal output state. */
+    eeg_biquad_t notch;             /**< Mains notch filter. */
+    eeg_biquad_t band;              /**< Band-pass filter. */
+
+} eeg_acq_t;
+
 /**
  * @brief EEG Click context object.
  * @details Context object definition of EEG Click driver.
@@ -83,6 +151,7 @@ extern "C"{
 typedef struct
 {
     analog_in_t  adc;       /**< ADC module object. */
+    eeg_acq_t    acq;       /**< Block acquisition object. */
 
 } eeg_t;
 
@@ -173,6 +242,65 @@ err_t eeg_read_an_pin_value ( eeg_t *ctx, uint16_t *data_out );
  */
 err_t eeg_read_an_pin_voltage ( eeg_t *ctx, float *data_out );
 
+/**
+ * @brief EEG acquisition start function.
+ * @details This function computes the fixed-point filter coefficients for the selected
+ * sample rate, resets the acquisition blocks and filter states and starts the block acquisition.
+ * The filter chain is DC removal, mains notch and band-pass.
+ * @param[in] ctx : Click context object.
+ * See #eeg_t object definition for detailed explanation.
+ * @param[in] sample_rate : Rate at which #eeg_acq_tick is called [Hz].
+ * @param[in] mains_freq : Mains notch frequency, @li @c  0 - Notch disabled,
+ *                                                @li @c 50 - 50 Hz,
+ *                                                @li @c 60 - 60 Hz.
+ * @param[in] band_low : Band-pass lower edge [Hz], e.g. EEG_ACQ_BAND_LOW_HZ.
+ * @param[in] band_high : Band-pass upper edge [Hz], e.g. EEG_ACQ_BAND_HIGH_HZ.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note The band edges and the mains frequency must be below half of the sample rate.
+ */
+err_t eeg_acq_start ( eeg_t *ctx, uint16_t sample_rate, uint8_t mains_freq, float band_low, float band_high );
+
+/**
+ * @brief EEG acquisition stop function.
+ * @details This function stops the block acquisition, further timer ticks are ignored.
+ * @param[in] ctx : Click context object.
+ * See #eeg_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void eeg_acq_stop ( eeg_t *ctx );
+
+/**
+ * @brief EEG acquisition tick function.
+ * @details This function reads a single ADC sample into the block being filled and swaps
+ * the blocks when it is full. A block that was not processed in time is overwritten
+ * and counted in @b ctx->acq.overrun.
+ * @param[in] ctx : Click context object.
+ * See #eeg_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note Call this function from a periodic timer interrupt running at the sample rate
+ * set by #eeg_acq_start.
+ */
+void eeg_acq_tick ( eeg_t *ctx );
+
+/**
+ * @brief EEG acquisition get block function.
+ * @details This function takes the oldest filled block, runs it through the fixed-point
+ * filter chain and marks it free for the timer tick.
+ * @param[in] ctx : Click context object.
+ * See #eeg_t object definition for detailed explanation.
+ * @param[out] data_out : EEG_ACQ_BLOCK_SIZE filtered samples in ADC counts.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no block is ready.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note A block must be processed within one block period to avoid overruns.
+ */
+err_t eeg_acq_get_block ( eeg_t *ctx, int32_t *data_out );
+
 #ifdef __cplusplus
 }
 #endif
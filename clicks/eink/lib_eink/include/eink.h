@@ -228,7 +228,12 @@ typedef struct
     eink_cordinate_t dev_cord;
 #ifndef IMAGE_MODE_ONLY
     uint8_t p_frame[EINK_DISPLAY_RESOLUTION];
+    eink_xy_t frame_dirty;
+    uint8_t frame_dirty_flag;
 #endif
+    uint8_t *p_shadow;
+    eink_xy_t shadow_prev;
+    uint8_t shadow_prev_flag;
 } eink_t;
 
 /**
@@ -359,6 +364,53 @@ void eink_set_mem_area ( eink_t *ctx, eink_xy_t *xy );
  */
 void eink_update_display ( eink_t *ctx );
 
+/**
+ * @brief Start display update
+ * 
+ * @param ctx       Click object.
+ *
+ * @details Starts the display update and returns immediately without waiting
+ * for the panel. Completion is reported by the BUSY pin, see eink_display_busy.
+ */
+void eink_update_display_start ( eink_t *ctx );
+
+/**
+ * @brief Display busy
+ * 
+ * @param ctx       Click object.
+ *
+ * @returns 1 while the panel is refreshing, 0 when it is idle.
+ */
+uint8_t eink_display_busy ( eink_t *ctx );
+
+/**
+ * @brief Set shadow buffer
+ * 
+ * @param ctx         Click object.
+ * @param shadow_buf  Buffer of EINK_DISPLAY_RESOLUTION bytes which holds a copy
+ *                    of the image in the display RAM.
+ *
+ * @details The shadow buffer is required by eink_partial_image. The first
+ * partial update after this call rewrites the whole display RAM.
+ */
+void eink_set_shadow ( eink_t *ctx, uint8_t *shadow_buf );
+
+/**
+ * @brief Partial image update
+ *
+ * @param ctx           Click object.
+ * @param image_buffer  Buffer containing the new image
+ *
+ * @details Compares the image with the shadow buffer and writes only the
+ * byte-aligned window which differs, then starts the update without waiting
+ * for the panel. Poll eink_display_busy to find out when the refresh is done.
+ * The panel has no built-in partial waveform, load the fast partial LUT with
+ * eink_set_lut beforehand.
+ *
+ * @returns 0 on success, -1 if the shadow buffer is not set.
+ */
+err_t eink_partial_image ( eink_t *ctx, const uint8_t* image_buffer );
+
 /**
  * @brief Function that fills the screen
  *
@@ -390,6 +442,9 @@ void eink_display_image ( eink_t *ctx, const uint8_t* image_buffer );
  * @param text        Text buffer
  * @param text_set    Struct object.
  *
+ * @details Only the pixels changed since the previous call are tracked, and the
+ * bounding window of the changed rows and columns is written to the display RAM
+ * before the update. If no pixel changed the display is not updated at all.
  */
 void eink_text ( eink_t *ctx, uint8_t *text, eink_text_set_t *text_set );
 
@@ -32,13 +32,19 @@
 // ------------------------------------------------------------- PRIVATE MACROS 
 
 #define EINK_DUMMY      0
+#define EINK_ROW_BYTES  ( EINK_DISPLAY_WIDTH / 4 )
 
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
 static void wait_until_idle ( eink_t *ctx );
 static void frame_px ( eink_t *ctx, uint8_t x, uint8_t y, uint8_t font_col );
+static void frame_mark_all ( eink_t *ctx );
+static void frame_push ( eink_t *ctx );
 static void char_wr ( eink_t *ctx, uint16_t ch_idx );
 static void display_delay ( );
+static uint8_t shadow_diff ( eink_t *ctx, const uint8_t *image_buffer, eink_xy_t *win );
+static void shadow_load ( eink_t *ctx, const uint8_t *image_buffer, uint8_t color );
+static void window_write ( eink_t *ctx, const uint8_t *image_buffer, eink_xy_t *win );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -95,6 +101,13 @@ err_t eink_init ( eink_t *ctx, eink_cfg_t *cfg )
 
     digital_in_init( &ctx->bsy, cfg->bsy );
 
+    ctx->p_shadow = NULL;
+    ctx->shadow_prev_flag = 0;
+
+#ifndef IMAGE_MODE_ONLY
+    frame_mark_all( ctx );
+#endif
+
     return EINK_OK;
 }
 
@@ -203,6 +216,58 @@ void eink_update_display ( eink_t *ctx )
     wait_until_idle( ctx );
 }
 
+void eink_update_display_start ( eink_t *ctx )
+{
+    eink_send_cmd( ctx, EINK_CMD_DISPLAY_UPDATE_CONTROL_2 );
+    eink_send_data( ctx, 0x02 );
+    eink_send_cmd( ctx, EINK_CMD_MASTER_ACTIVATION );
+}
+
+uint8_t eink_display_busy ( eink_t *ctx )
+{
+    return digital_in_read( &ctx->bsy );
+}
+
+void eink_set_shadow ( eink_t *ctx, uint8_t *shadow_buf )
+{
+    ctx->p_shadow = shadow_buf;
+    shadow_load( ctx, NULL, EINK_SCREEN_COLOR_WHITE );
+}
+
+err_t eink_partial_image ( eink_t *ctx, const uint8_t* image_buffer )
+{
+    eink_xy_t win;
+
+    if ( NULL == ctx->p_shadow )
+    {
+        return EINK_ERROR;
+    }
+
+    if ( !shadow_diff( ctx, image_buffer, &win ) )
+    {
+        return EINK_OK;
+    }
+
+    wait_until_idle( ctx );
+
+    // The other RAM bank still holds the image from before the previous update
+    if ( ctx->shadow_prev_flag )
+    {
+        window_write( ctx, image_buffer, &ctx->shadow_prev );
+    }
+    window_write( ctx, image_buffer, &win );
+
+    ctx->shadow_prev = win;
+    ctx->shadow_prev_flag = 1;
+
+#ifndef IMAGE_MODE_ONLY
+    frame_mark_all( ctx );
+#endif
+    eink_update_display_start( ctx );
+
+    return EINK_OK;
+}
+
 void eink_fill_screen ( eink_t *ctx, uint8_t color )               
 {
     uint16_t cnt;
@@ -222,6 +287,10 @@ void eink_fill_screen ( eink_t *ctx, uint8_t color )
     {
        eink_send_data( ctx, color );
     }
+    shadow_load( ctx, NULL, color );
+#ifndef IMAGE_MODE_ONLY
+    frame_mark_all( ctx );
+#endif
     eink_send_cmd( ctx, EINK_CMD_MASTER_ACTIVATION );
     display_delay(  );
     eink_update_display( ctx );
@@ -245,6 +314,10 @@ void eink_display_image ( eink_t *ctx, const uint8_t* image_buffer )
     {
         eink_send_data( ctx, image_buffer[ cnt ] );
     }
+    shadow_load( ctx, image_buffer, 0 );
+#ifndef IMAGE_MODE_ONLY
+    frame_mark_all( ctx );
+#endif
 
     eink_send_cmd( ctx, EINK_CMD_MASTER_ACTIVATION );
     display_delay( );
@@ -255,7 +328,6 @@ void eink_display_image ( eink_t *ctx, const uint8_t* image_buffer )
 void eink_text ( eink_t *ctx, uint8_t *text, eink_text_set_t *text_set )
 {
     uint16_t cnt;
-    eink_xy_t xy;
 
     if ( ( text_set->text_x >= EINK_DISPLAY_WIDTH ) || ( text_set->text_y >= EINK_DISPLAY_HEIGHT ) )
     {
@@ -270,20 +342,13 @@ void eink_text ( eink_t *ctx, uint8_t *text, eink_text_set_t *text_set )
         char_wr( ctx, text[ cnt ] );
     }
     
-    xy.x_start = 0;
-    xy.y_start = EINK_DISPLAY_HEIGHT - 1; 
-    xy.x_end = EINK_DISPLAY_WIDTH - 1;
-    xy.y_end = 0;
-     
-    eink_set_mem_area( ctx, &xy );
-    eink_set_mem_pointer( ctx, 0, 0xAB );
-    
-    eink_send_cmd( ctx, EINK_CMD_WRITE_RAM );
-
-    for ( cnt = 0; cnt < EINK_DISPLAY_RESOLUTION; cnt++ )
+    if ( !ctx->frame_dirty_flag )
     {
-        eink_send_data( ctx, ctx->p_frame[ cnt ] );
+        return;
     }
+    
+    frame_push( ctx );
+    shadow_load( ctx, ctx->p_frame, 0 );
 
     eink_send_cmd( ctx, EINK_CMD_MASTER_ACTIVATION );
     display_delay( );
@@ -320,10 +385,63 @@ static void frame_px ( eink_t *ctx, uint8_t x, uint8_t y, uint8_t font_col )
     uint8_t off;
     uint16_t pos;
 
+    uint8_t new_px;
+
+    if ( ( x >= EINK_DISPLAY_WIDTH ) || ( y >= EINK_DISPLAY_HEIGHT ) )
+    {
+        return;
+    }
+
     pos = ( y * ( EINK_DISPLAY_WIDTH / 4 ) ) + ( x / 4 );
     off = ( 3 - ( x % 4 ) ) * 2;
-    ctx->p_frame[ pos ] &= ~( 0x03 << off );
-    ctx->p_frame[ pos ] |= ( ( font_col & 0x03 ) << off );
+    new_px = ( ctx->p_frame[ pos ] & ~( 0x03 << off ) ) | ( ( font_col & 0x03 ) << off );
+    if ( new_px == ctx->p_frame[ pos ] )
+    {
+        return;
+    }
+    ctx->p_frame[ pos ] = new_px;
+
+    x /= 4;
+    if ( !ctx->frame_dirty_flag )
+    {
+        ctx->frame_dirty.x_start = x;
+        ctx->frame_dirty.x_end = x;
+        ctx->frame_dirty.y_start = y;
+        ctx->frame_dirty.y_end = y;
+        ctx->frame_dirty_flag = 1;
+        return;
+    }
+    if ( x < ctx->frame_dirty.x_start )
+    {
+        ctx->frame_dirty.x_start = x;
+    }
+    if ( x > ctx->frame_dirty.x_end )
+    {
+        ctx->frame_dirty.x_end = x;
+    }
+    if ( y < ctx->frame_dirty.y_start )
+    {
+        ctx->frame_dirty.y_start = y;
+    }
+    if ( y > ctx->frame_dirty.y_end )
+    {
+        ctx->frame_dirty.y_end = y;
+    }
+}
+
+static void frame_mark_all ( eink_t *ctx )
+{
+    ctx->frame_dirty.x_start = 0;
+    ctx->frame_dirty.x_end = ( EINK_DISPLAY_WIDTH / 4 ) - 1;
+    ctx->frame_dirty.y_start = 0;
+    ctx->frame_dirty.y_end = EINK_DISPLAY_HEIGHT - 1;
+    ctx->frame_dirty_flag = 1;
+}
+
+static void frame_push ( eink_t *ctx )
+{
+    window_write( ctx, ctx->p_frame, &ctx->frame_dirty );
+    ctx->frame_dirty_flag = 0;
 }
 
 static void char_wr ( eink_t *ctx, uint16_t ch_idx )
@@ -428,6 +546,115 @@ static void char_wr ( eink_t *ctx, uint16_t ch_idx )
 }
 #endif
 
+static uint8_t shadow_diff ( eink_t *ctx, const uint8_t *image_buffer, eink_xy_t *win )
+{
+    uint8_t row;
+    uint8_t col;
+    uint8_t first;
+    uint8_t last;
+    uint8_t *p_row;
+    const uint8_t *p_img;
+    uint8_t diff = 0;
+
+    win->x_start = EINK_ROW_BYTES - 1;
+    win->x_end = 0;
+
+    for ( row = 0; row < EINK_DISPLAY_HEIGHT; row++ )
+    {
+        p_row = &ctx->p_shadow[ row * EINK_ROW_BYTES ];
+        p_img = &image_buffer[ row * EINK_ROW_BYTES ];
+
+        first = 0;
+        while ( ( first < EINK_ROW_BYTES ) && ( p_row[ first ] == p_img[ first ] ) )
+        {
+            first++;
+        }
+        if ( first == EINK_ROW_BYTES )
+        {
+            continue;
+        }
+        last = EINK_ROW_BYTES - 1;
+        while ( p_row[ last ] == p_img[ last ] )
+        {
+            last--;
+        }
+
+        for ( col = first; col <= last; col++ )
+        {
+            p_row[ col ] = p_img[ col ];
+        }
+
+        if ( !diff )
+        {
+            win->y_start = row;
+            diff = 1;
+        }
+        win->y_end = row;
+        if ( first < win->x_start )
+        {
+            win->x_start = first;
+        }
+        if ( last > win->x_end )
+        {
+            win->x_end = last;
+        }
+    }
+
+    return diff;
+}
+
+static void shadow_load ( eink_t *ctx, const uint8_t *image_buffer, uint8_t color )
+{
+    uint16_t cnt;
+
+    if ( NULL == ctx->p_shadow )
+    {
+        return;
+    }
+
+    for ( cnt = 0; cnt < EINK_DISPLAY_RESOLUTION; cnt++ )
+    {
+        ctx->p_shadow[ cnt ] = ( NULL == image_buffer ) ? color : image_buffer[ cnt ];
+    }
+
+    // Whole RAM was rewritten, resync it completely with the next partial update
+    ctx->shadow_prev.x_start = 0;
+    ctx->shadow_prev.x_end = EINK_ROW_BYTES - 1;
+    ctx->shadow_prev.y_start = 0;
+    ctx->shadow_prev.y_end = EINK_DISPLAY_HEIGHT - 1;
+    ctx->shadow_prev_flag = 1;
+}
+
+static void window_write ( eink_t *ctx, const uint8_t *image_buffer, eink_xy_t *win )
+{
+    uint8_t row;
+
+    // Image rows are stored top to bottom while RAM Y address is decremented
+    eink_send_cmd( ctx, EINK_CMD_SET_RAM_X_ADDRESS_START_END_POSITION );
+    eink_send_data( ctx, win->x_start );
+    eink_send_data( ctx, win->x_end );
+    eink_send_cmd( ctx, EINK_CMD_SET_RAM_Y_ADDRESS_START_END_POSITION );
+    eink_send_data( ctx, ( EINK_DISPLAY_HEIGHT - 1 ) - win->y_start );
+    eink_send_data( ctx, ( EINK_DISPLAY_HEIGHT - 1 ) - win->y_end );
+    eink_send_cmd( ctx, EINK_CMD_SET_RAM_X_ADDRESS_COUNTER );
+    eink_send_data( ctx, win->x_start );
+    eink_send_cmd( ctx, EINK_CMD_SET_RAM_Y_ADDRESS_COUNTER );
+    eink_send_data( ctx, ( EINK_DISPLAY_HEIGHT - 1 ) - win->y_start );
+    wait_until_idle( ctx );
+
+    eink_send_cmd( ctx, EINK_CMD_WRITE_RAM );
+
+    // Address counter wraps inside the window, so all rows go out in one burst
+    digital_out_high( &ctx->dc );
+    spi_master_select_device( ctx->chip_select );
+    for ( row = win->y_start; row <= win->y_end; row++ )
+    {
+        spi_master_write( &ctx->spi, ( uint8_t * ) &image_buffer[ ( row * EINK_ROW_BYTES ) + win->x_start ], 
+                          ( win->x_end - win->x_start ) + 1 );
+    }
+    spi_master_deselect_device( ctx->chip_select );
+}
+
 static void display_delay ( )
 {
     Delay_1ms( );
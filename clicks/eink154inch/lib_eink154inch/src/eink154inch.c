@@ -32,6 +32,16 @@
 // ------------------------------------------------------------- PRIVATE MACROS 
 
 #define EINK154INCH_DUMMY      0
+#define EINK154INCH_ROW_BYTES  ( EINK154INCH_DISPLAY_WIDTH / 8 )
+
+// ------------------------------------------------------------------ CONSTANTS
+
+static const uint8_t lut_partial[ 30 ] =
+{
+    0x10, 0x18, 0x18, 0x08, 0x18, 0x18, 0x08, 0x00, 0x00, 0x00, 
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+    0x13, 0x14, 0x44, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
 
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
@@ -39,6 +49,9 @@ static void wait_until_idle ( eink154inch_t *ctx );
 static void frame_px ( eink154inch_t *ctx, uint16_t x, uint16_t y, uint8_t font_col );
 static void char_wr ( eink154inch_t *ctx, uint16_t ch_idx );
 static void display_delay ( );
+static uint8_t shadow_diff ( eink154inch_t *ctx, const uint8_t *image_buffer, eink154inch_xy_t *win );
+static void shadow_load ( eink154inch_t *ctx, const uint8_t *image_buffer, uint8_t color );
+static void window_write ( eink154inch_t *ctx, const uint8_t *image_buffer, eink154inch_xy_t *win );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -93,6 +106,9 @@ err_t eink154inch_init ( eink154inch_t *ctx, eink154inch_cfg_t *cfg )
     // Input pins
     digital_in_init( &ctx->bsy, cfg->bsy );
 
+    ctx->p_shadow = NULL;
+    ctx->shadow_prev_flag = 0;
+
     return EINK154INCH_OK;
 }
 
@@ -195,6 +211,61 @@ void eink154inch_update_display ( eink154inch_t *ctx )
     wait_until_idle( ctx );
 }
 
+void eink154inch_update_display_start ( eink154inch_t *ctx )
+{
+    eink154inch_send_cmd( ctx, EINK154INCH_CMD_DISPLAY_UPDATE_CONTROL_2 );
+    eink154inch_send_data( ctx, 0xC4 );
+    eink154inch_send_cmd( ctx, EINK154INCH_CMD_MASTER_ACTIVATION );
+    eink154inch_send_cmd( ctx, EINK154INCH_CMD_TERMINATE_FRAME_READ_WRITE );
+}
+
+uint8_t eink154inch_display_busy ( eink154inch_t *ctx )
+{
+    return digital_in_read( &ctx->bsy );
+}
+
+void eink154inch_set_lut_partial ( eink154inch_t *ctx )
+{
+    eink154inch_set_lut( ctx, lut_partial, sizeof( lut_partial ) );
+}
+
+void eink154inch_set_shadow ( eink154inch_t *ctx, uint8_t *shadow_buf )
+{
+    ctx->p_shadow = shadow_buf;
+    shadow_load( ctx, NULL, EINK154INCH_SCREEN_COLOR_WHITE );
+}
+
+err_t eink154inch_partial_image ( eink154inch_t *ctx, const uint8_t* image_buffer )
+{
+    eink154inch_xy_t win;
+
+    if ( NULL == ctx->p_shadow )
+    {
+        return EINK154INCH_ERROR;
+    }
+
+    if ( !shadow_diff( ctx, image_buffer, &win ) )
+    {
+        return EINK154INCH_OK;
+    }
+
+    wait_until_idle( ctx );
+
+    // The other RAM bank still holds the image from before the previous update
+    if ( ctx->shadow_prev_flag )
+    {
+        window_write( ctx, image_buffer, &ctx->shadow_prev );
+    }
+    window_write( ctx, image_buffer, &win );
+
+    ctx->shadow_prev = win;
+    ctx->shadow_prev_flag = 1;
+
+    eink154inch_update_display_start( ctx );
+
+    return EINK154INCH_OK;
+}
+
 void eink154inch_fill_screen ( eink154inch_t *ctx, uint8_t color )               
 {
     uint16_t cnt;
@@ -213,6 +284,7 @@ void eink154inch_fill_screen ( eink154inch_t *ctx, uint8_t color )
     {
        eink154inch_send_data( ctx, color );
     }
+    shadow_load( ctx, NULL, color );
 
     display_delay(  );
     eink154inch_update_display( ctx );
@@ -238,6 +310,7 @@ void eink154inch_image ( eink154inch_t *ctx, const uint8_t* image_buffer )
     {
         eink154inch_send_data( ctx, image_buffer[ cnt ] );
     }
+    shadow_load( ctx, image_buffer, 0 );
 
     display_delay( );
     eink154inch_update_display( ctx );
@@ -276,6 +349,7 @@ void eink154inch_text ( eink154inch_t *ctx, char *text, eink154inch_text_set_t *
     {
         eink154inch_send_data( ctx, ctx->p_frame[ cnt ] );
     }
+    shadow_load( ctx, ctx->p_frame, 0 );
 
     display_delay( );
     eink154inch_update_display( ctx );
@@ -419,6 +493,109 @@ static void char_wr ( eink154inch_t *ctx, uint16_t ch_idx )
 }
 #endif
 
+static uint8_t shadow_diff ( eink154inch_t *ctx, const uint8_t *image_buffer, eink154inch_xy_t *win )
+{
+    uint16_t row;
+    uint16_t col;
+    uint16_t first;
+    uint16_t last;
+    uint8_t *p_row;
+    const uint8_t *p_img;
+    uint8_t diff = 0;
+
+    win->x_start = EINK154INCH_ROW_BYTES - 1;
+    win->x_end = 0;
+
+    for ( row = 0; row < EINK154INCH_DISPLAY_HEIGHT; row++ )
+    {
+        p_row = &ctx->p_shadow[ row * EINK154INCH_ROW_BYTES ];
+        p_img = &image_buffer[ row * EINK154INCH_ROW_BYTES ];
+
+        first = 0;
+        while ( ( first < EINK154INCH_ROW_BYTES ) && ( p_row[ first ] == p_img[ first ] ) )
+        {
+            first++;
+        }
+        if ( first == EINK154INCH_ROW_BYTES )
+        {
+            continue;
+        }
+        last = EINK154INCH_ROW_BYTES - 1;
+        while ( p_row[ last ] == p_img[ last ] )
+        {
+            last--;
+        }
+
+        for ( col = first; col <= last; col++ )
+        {
+            p_row[ col ] = p_img[ col ];
+        }
+
+        if ( !diff )
+        {
+            win->y_start = row;
+            diff = 1;
+        }
+        win->y_end = row;
+        if ( first < win->x_start )
+        {
+            win->x_start = first;
+        }
+        if ( last > win->x_end )
+        {
+            win->x_end = last;
+        }
+    }
+
+    return diff;
+}
+
+static void shadow_load ( eink154inch_t *ctx, const uint8_t *image_buffer, uint8_t color )
+{
+    uint16_t cnt;
+
+    if ( NULL == ctx->p_shadow )
+    {
+        return;
+    }
+
+    for ( cnt = 0; cnt < EINK154INCH_DISPLAY_RESOLUTIONS; cnt++ )
+    {
+        ctx->p_shadow[ cnt ] = ( NULL == image_buffer ) ? color : image_buffer[ cnt ];
+    }
+
+    // Whole RAM was rewritten, resync it completely with the next partial update
+    ctx->shadow_prev.x_start = 0;
+    ctx->shadow_prev.x_end = EINK154INCH_ROW_BYTES - 1;
+    ctx->shadow_prev.y_start = 0;
+    ctx->shadow_prev.y_end = EINK154INCH_DISPLAY_HEIGHT - 1;
+    ctx->shadow_prev_flag = 1;
+}
+
+static void window_write ( eink154inch_t *ctx, const uint8_t *image_buffer, eink154inch_xy_t *win )
+{
+    uint16_t row;
+    eink154inch_xy_t xy;
+
+    xy.x_start = win->x_start * 8;
+    xy.x_end = ( win->x_end * 8 ) + 7;
+    xy.y_start = win->y_start;
+    xy.y_end = win->y_end;
+    eink154inch_set_mem_area( ctx, &xy );
+    eink154inch_set_mem_pointer( ctx, xy.x_start, xy.y_start );
+    eink154inch_send_cmd( ctx, EINK154INCH_CMD_WRITE_RAM );
+
+    // Address counter wraps inside the window, so all rows go out in one burst
+    digital_out_high( &ctx->dc );
+    spi_master_select_device( ctx->chip_select );
+    for ( row = win->y_start; row <= win->y_end; row++ )
+    {
+        spi_master_write( &ctx->spi, ( uint8_t * ) &image_buffer[ ( row * EINK154INCH_ROW_BYTES ) + win->x_start ], 
+                          ( win->x_end - win->x_start ) + 1 );
+    }
+    spi_master_deselect_device( ctx->chip_select );
+}
+
 static void display_delay ( )
 {
     Delay_1ms( );
@@ -197,6 +197,10 @@ typedef struct
     eink290inch_font_t dev_font;
     eink290inch_cord_t dev_cord;
 
+    uint8_t           *p_shadow;
+    eink290inch_xy_t  shadow_prev;
+    uint8_t           shadow_prev_flag;
+
 } eink290inch_t;
 
 /**
@@ -325,6 +329,65 @@ void eink290inch_set_mem_area ( eink290inch_t *ctx, eink290inch_xy_t *xy );
  */
 void eink290inch_update_display ( eink290inch_t *ctx );
 
+/**
+ * @brief Start display update function
+ * 
+ * @param ctx          Click object.
+ *
+ * @details Starts the display update and returns immediately without waiting
+ * for the panel. Completion is reported by the BUSY pin, see
+ * eink290inch_display_busy.
+ */
+void eink290inch_update_display_start ( eink290inch_t *ctx );
+
+/**
+ * @brief Display busy function
+ * 
+ * @param ctx          Click object.
+ *
+ * @returns 1 while the panel is refreshing, 0 when it is idle.
+ */
+uint8_t eink290inch_display_busy ( eink290inch_t *ctx );
+
+/**
+ * @brief Load partial LUT function
+ * 
+ * @param ctx          Click object.
+ *
+ * @details Loads the built-in fast partial refresh waveform which only drives
+ * pixels that change color. Reload the full LUT with eink290inch_set_lut
+ * to get back to the full, flashing refresh.
+ */
+void eink290inch_set_lut_partial ( eink290inch_t *ctx );
+
+/**
+ * @brief Set shadow buffer function
+ * 
+ * @param ctx          Click object.
+ * @param shadow_buf   Buffer of EINK290INCH_DISPLAY_RESOLUTIONS bytes which
+ *                     holds a copy of the image in the display RAM.
+ *
+ * @details The shadow buffer is required by eink290inch_partial_image.
+ * The first partial update after this call rewrites the whole display RAM.
+ */
+void eink290inch_set_shadow ( eink290inch_t *ctx, uint8_t *shadow_buf );
+
+/**
+ * @brief Partial image update function
+ *
+ * @param ctx          Click object.
+ * @param image_buffer Buffer containing the new image
+ *
+ * @details Compares the image with the shadow buffer and writes only the
+ * byte-aligned window which differs, then starts the update without waiting
+ * for the panel. Poll eink290inch_display_busy to find out when the refresh
+ * is done. The window of the previous partial update is rewritten as well so
+ * both RAM banks of the controller stay in sync.
+ *
+ * @returns 0 on success, -1 if the shadow buffer is not set.
+ */
+err_t eink290inch_partial_image ( eink290inch_t *ctx, const uint8_t* image_buffer );
+
 /**
  * @brief Function that fills the screen
  *
@@ -56,6 +56,31 @@ extern "C"{
  * @{
  */
 
+/**
+ * @defgroup emg_set EMG Settings
+ * @brief Settings of EMG Click driver.
+ */
+
+/**
+ * @addtogroup emg_set
+ * @{
+ */
+
+/**
+ * @brief EMG block acquisition setting.
+ * @details Specified setting for block acquisition of EMG Click driver.
+ */
+#define EMG_ACQ_BLOCK_SIZE                64
+#define EMG_ACQ_FRAC_BITS                 8
+#define EMG_ACQ_COEF_BITS                 28
+#define EMG_ACQ_MAINS_OFF                 0
+#define EMG_ACQ_MAINS_50HZ                50
+#define EMG_ACQ_MAINS_60HZ                60
+#define EMG_ACQ_BAND_LOW_HZ               20.0
+#define EMG_ACQ_BAND_HIGH_HZ              150.0
+
+/*! @} */ // emg_set
+
 /**
  * @defgroup emg_map EMG MikroBUS Map
  * @brief MikroBUS pin mapping of EMG Click driver.
@@ -76,6 +101,49 @@ extern "C"{
 /*! @} */ // emg_map
 /*! @} */ // emg
 
+/**
+ * @brief EMG Click fixed-point biquad filter object.
+ * @details Second order section of EMG Click driver with coefficients
+ * in Q28 format and states scaled by 2^EMG_ACQ_FRAC_BITS.
+ */
+typedef struct
+{
+    int32_t b0;                     /**< Feed-forward coefficient 0. */
+    int32_t b1;                     /**< Feed-forward coefficient 1. */
+    int32_t b2;                     /**< Feed-forward coefficient 2. */
+    int32_t a1;                     /**< Feedback coefficient 1. */
+    int32_t a2;                     /**< Feedback coefficient 2. */
+    int32_t x1;                     /**< Input delayed by one sample. */
+    int32_t x2;                     /**< Input delayed by two samples. */
+    int32_t y1;                     /**< Output delayed by one sample. */
+    int32_t y2;                     /**< Output delayed by two samples. */
+
+} emg_biquad_t;
+
+/**
+ * @brief EMG Click block acquisition object.
+ * @details Double-buffered acquisition state of EMG Click driver, filled by #emg_acq_tick
+ * and filtered by #emg_acq_get_block.
+ */
+typedef struct
+{
+    uint16_t block[ 2 ][ EMG_ACQ_BLOCK_SIZE ];   /**< Raw ADC sample blocks. */
+    volatile uint8_t  ready[ 2 ];   /**< Block filled and not yet processed flags. */
+    volatile uint8_t  fill_buf;     /**< Block being filled by the timer tick. */
+    volatile uint16_t fill_idx;     /**< Next sample position in the filled block. */
+    volatile uint16_t overrun;      /**< Number of blocks overwritten before processing. */
+    volatile uint8_t  running;      /**< Acquisition running flag. */
+    uint8_t  read_buf;              /**< Next block to be processed. */
+    uint16_t last_sample;           /**< Last raw ADC sample. */
+    uint16_t sample_rate;           /**< Timer tick rate [Hz]. */
+    int32_t  dc_coef;               /**< DC removal pole. */
+    int32_t  dc_x1;                 /**< DC removal input state. */
+    int32_t  dc_y1;                 /**< DC removal output state. */
+    emg_biquad_t notch;             /**< Mains notch filter. */
+    emg_biquad_t band;              /**< Band-pass filter. */
+
+} emg_acq_t;
+
 /**
  * @brief EMG Click context object.
  * @details Context object definition of EMG Click driver.
@@ -83,6 +151,7 @@ extern "C"{
 typedef struct
 {
     analog_in_t  adc;       /**< ADC module object. */
+    emg_acq_t    acq;       /**< Block acquisition object. */
 
 } emg_t;
 
@@ -171,6 +240,65 @@ err_t emg_read_an_pin_value ( emg_t *ctx, uint16_t *data_out );
  */
 err_t emg_read_an_pin_voltage ( emg_t *ctx, float *data_out );
 
+/**
+ * @brief EMG acquisition start function.
+ * @details This function computes the fixed-point filter coefficients for the selected
+ * sample rate, resets the acquisition blocks and filter states and starts the block acquisition.
+ * The filter chain is DC removal, mains notch and band-pass.
+ * @param[in] ctx : Click context object.
+ * See #emg_t object definition for detailed explanation.
+ * @param[in] sample_rate : Rate at which #emg_acq_tick is called [Hz].
+ * @param[in] mains_freq : Mains notch frequency, @li @c  0 - Notch disabled,
+ *                                                @li @c 50 - 50 Hz,
+ *                                                @li @c 60 - 60 Hz.
+ * @param[in] band_low : Band-pass lower edge [Hz], e.g. EMG_ACQ_BAND_LOW_HZ.
+ * @param[in] band_high : Band-pass upper edge [Hz], e.g. EMG_ACQ_BAND_HIGH_HZ.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note The band edges and the mains frequency must be below half of the sample rate.
+ */
+err_t emg_acq_start ( emg_t *ctx, uint16_t sample_rate, uint8_t mains_freq, float band_low, float band_high );
+
+/**
+ * @brief EMG acquisition stop function.
+ * @details This function stops the block acquisition, further timer ticks are ignored.
+ * @param[in] ctx : Click context object.
+ * See #emg_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void emg_acq_stop ( emg_t *ctx );
+
+/**
+ * @brief EMG acquisition tick function.
+ * @details This function reads a single ADC sample into the block being filled and swaps
+ * the blocks when it is full. A block that was not processed in time is overwritten
+ * and counted in @b ctx->acq.overrun.
+ * @param[in] ctx : Click context object.
+ * See #emg_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note Call this function from a periodic timer interrupt running at the sample rate
+ * set by #emg_acq_start.
+ */
+void emg_acq_tick ( emg_t *ctx );
+
+/**
+ * @brief EMG acquisition get block function.
+ * @details This function takes the oldest filled block, runs it through the fixed-point
+ * filter chain and marks it free for the timer tick.
+ * @param[in] ctx : Click context object.
+ * See #emg_t object definition for detailed explanation.
+ * @param[out] data_out : EMG_ACQ_BLOCK_SIZE filtered samples in ADC counts.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no block is ready.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note A block must be processed within one block period to avoid overruns.
+ */
+err_t emg_acq_get_block ( emg_t *ctx, int32_t *data_out );
+
 #ifdef __cplusplus
 }
 #endif
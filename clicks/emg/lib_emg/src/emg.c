@@ -26,6 +26,36 @@
  */
 
 #include "emg.h"
+#include "math.h"
+
+/**
+ * @brief EMG acquisition filter settings.
+ * @details Private settings of the block acquisition filters of EMG Click driver.
+ */
+#define ACQ_COEF_ONE            ( ( float ) ( 1ul << EMG_ACQ_COEF_BITS ) )
+#define ACQ_PI                  3.14159265
+#define ACQ_DC_CUTOFF_HZ        0.1
+#define ACQ_NOTCH_Q             8.0
+
+/**
+ * @brief EMG biquad set function.
+ * @details This function normalizes the biquad coefficients to fixed-point format
+ * and clears the filter states.
+ */
+static void dev_biquad_set ( emg_biquad_t *bq, float b0, float b1, float b2, float a0, float a1, float a2 );
+
+/**
+ * @brief EMG biquad band-pass design function.
+ * @details This function designs a second order band-pass section with edges
+ * prewarped for the bilinear transform.
+ */
+static void dev_biquad_band_pass ( emg_biquad_t *bq, float fs, float f_low, float f_high );
+
+/**
+ * @brief EMG biquad run function.
+ * @details This function filters a single sample in direct form I with a 64-bit accumulator.
+ */
+static int32_t dev_biquad_run ( emg_biquad_t *bq, int32_t sample );
 
 void emg_cfg_setup ( emg_cfg_t *cfg )
 {
@@ -73,4 +103,168 @@ err_t emg_read_an_pin_voltage ( emg_t *ctx, float *data_out )
     return analog_in_read_voltage( &ctx->adc, data_out );
 }
 
+err_t emg_acq_start ( emg_t *ctx, uint16_t sample_rate, uint8_t mains_freq, float band_low, float band_high )
+{
+    float fs = sample_rate;
+    float w0 = 0;
+    uint16_t sample = 0;
+
+    if ( ( 0 == sample_rate ) || ( band_low <= 0 ) || ( band_low >= band_high ) || 
+         ( band_high >= ( fs / 2 ) ) || ( mains_freq >= ( fs / 2 ) ) )
+    {
+        return EMG_ERROR;
+    }
+    ctx->acq.running = 0;
+
+    if ( EMG_OK != emg_read_an_pin_value( ctx, &sample ) )
+    {
+        return EMG_ERROR;
+    }
+    ctx->acq.last_sample = sample;
+    ctx->acq.sample_rate = sample_rate;
+
+    // Single pole DC removal seeded with the current level to avoid a start-up step
+    ctx->acq.dc_coef = ( int32_t ) ( ( 1.0 - 2.0 * ACQ_PI * ACQ_DC_CUTOFF_HZ / fs ) * ACQ_COEF_ONE );
+    ctx->acq.dc_x1 = ( int32_t ) sample << EMG_ACQ_FRAC_BITS;
+    ctx->acq.dc_y1 = 0;
+
+    if ( EMG_ACQ_MAINS_OFF == mains_freq )
+    {
+        dev_biquad_set( &ctx->acq.notch, 1, 0, 0, 1, 0, 0 );
+    }
+    else
+    {
+        w0 = tan( ACQ_PI * mains_freq / fs );
+        dev_biquad_set( &ctx->acq.notch, 1 + w0 * w0, 2 * ( w0 * w0 - 1 ), 1 + w0 * w0, 
+                                         1 + w0 / ACQ_NOTCH_Q + w0 * w0, 2 * ( w0 * w0 - 1 ), 
+                                         1 - w0 / ACQ_NOTCH_Q + w0 * w0 );
+    }
+    dev_biquad_band_pass( &ctx->acq.band, fs, band_low, band_high );
+
+    ctx->acq.ready[ 0 ] = 0;
+    ctx->acq.ready[ 1 ] = 0;
+    ctx->acq.fill_buf = 0;
+    ctx->acq.fill_idx = 0;
+    ctx->acq.read_buf = 0;
+    ctx->acq.overrun = 0;
+    ctx->acq.running = 1;
+
+    return EMG_OK;
+}
+
+void emg_acq_stop ( emg_t *ctx )
+{
+    ctx->acq.running = 0;
+}
+
+void emg_acq_tick ( emg_t *ctx )
+{
+    uint16_t sample = 0;
+
+    if ( !ctx->acq.running )
+    {
+        return;
+    }
+
+    // A failed conversion repeats the previous sample to keep the sampling grid intact
+    if ( EMG_OK == emg_read_an_pin_value( ctx, &sample ) )
+    {
+        ctx->acq.last_sample = sample;
+    }
+    ctx->acq.block[ ctx->acq.fill_buf ][ ctx->acq.fill_idx ] = ctx->acq.last_sample;
+
+    if ( ++ctx->acq.fill_idx >= EMG_ACQ_BLOCK_SIZE )
+    {
+        ctx->acq.fill_idx = 0;
+        ctx->acq.ready[ ctx->acq.fill_buf ] = 1;
+        ctx->acq.fill_buf ^= 1;
+        if ( ctx->acq.ready[ ctx->acq.fill_buf ] )
+        {
+            ctx->acq.ready[ ctx->acq.fill_buf ] = 0;
+            ctx->acq.overrun++;
+        }
+    }
+}
+
+err_t emg_acq_get_block ( emg_t *ctx, int32_t *data_out )
+{
+    uint16_t *raw = NULL;
+    int32_t sample = 0;
+    int32_t dc_out = 0;
+
+    if ( NULL == data_out )
+    {
+        return EMG_ERROR;
+    }
+    if ( !ctx->acq.ready[ ctx->acq.read_buf ] )
+    {
+        // The expected block was overwritten, continue with the other one
+        if ( !ctx->acq.ready[ ctx->acq.read_buf ^ 1 ] )
+        {
+            return EMG_ERROR;
+        }
+        ctx->acq.read_buf ^= 1;
+    }
+
+    raw = ctx->acq.block[ ctx->acq.read_buf ];
+    for ( uint16_t cnt = 0; cnt < EMG_ACQ_BLOCK_SIZE; cnt++ )
+    {
+        sample = ( int32_t ) raw[ cnt ] << EMG_ACQ_FRAC_BITS;
+
+        dc_out = sample - ctx->acq.dc_x1 + 
+                 ( int32_t ) ( ( ( int64_t ) ctx->acq.dc_coef * ctx->acq.dc_y1 ) >> EMG_ACQ_COEF_BITS );
+        ctx->acq.dc_x1 = sample;
+        ctx->acq.dc_y1 = dc_out;
+
+        sample = dev_biquad_run( &ctx->acq.notch, dc_out );
+        sample = dev_biquad_run( &ctx->acq.band, sample );
+
+        data_out[ cnt ] = ( sample + ( 1l << ( EMG_ACQ_FRAC_BITS - 1 ) ) ) >> EMG_ACQ_FRAC_BITS;
+    }
+
+    ctx->acq.ready[ ctx->acq.read_buf ] = 0;
+    ctx->acq.read_buf ^= 1;
+
+    return EMG_OK;
+}
+
+static void dev_biquad_set ( emg_biquad_t *bq, float b0, float b1, float b2, float a0, float a1, float a2 )
+{
+    bq->b0 = ( int32_t ) ( b0 / a0 * ACQ_COEF_ONE );
+    bq->b1 = ( int32_t ) ( b1 / a0 * ACQ_COEF_ONE );
+    bq->b2 = ( int32_t ) ( b2 / a0 * ACQ_COEF_ONE );
+    bq->a1 = ( int32_t ) ( a1 / a0 * ACQ_COEF_ONE );
+    bq->a2 = ( int32_t ) ( a2 / a0 * ACQ_COEF_ONE );
+    bq->x1 = 0;
+    bq->x2 = 0;
+    bq->y1 = 0;
+    bq->y2 = 0;
+}
+
+static void dev_biquad_band_pass ( emg_biquad_t *bq, float fs, float f_low, float f_high )
+{
+    float w_low = tan( ACQ_PI * f_low / fs );
+    float w_high = tan( ACQ_PI * f_high / fs );
+    float bw = w_high - w_low;
+    float w0_sq = w_low * w_high;
+
+    dev_biquad_set( bq, bw, 0, -bw, 1 + bw + w0_sq, 2 * ( w0_sq - 1 ), 1 - bw + w0_sq );
+}
+
+static int32_t dev_biquad_run ( emg_biquad_t *bq, int32_t sample )
+{
+    int64_t acc = ( int64_t ) bq->b0 * sample;
+    acc += ( int64_t ) bq->b1 * bq->x1;
+    acc += ( int64_t ) bq->b2 * bq->x2;
+    acc -= ( int64_t ) bq->a1 * bq->y1;
+    acc -= ( int64_t ) bq->a2 * bq->y2;
+
+    bq->x2 = bq->x1;
+    bq->x1 = sample;
+    bq->y2 = bq->y1;
+    bq->y1 = ( int32_t ) ( ( acc + ( 1ll << ( EMG_ACQ_COEF_BITS - 1 ) ) ) >> EMG_ACQ_COEF_BITS );
+
+    return bq->y1;
+}
+
 // ------------------------------------------------------------------------- END
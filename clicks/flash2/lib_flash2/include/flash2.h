@@ -131,6 +131,8 @@
 #define            FLASH2_START_PAGE_ADDRESS 0x010000
 #define            FLASH2_END_PAGE_ADDRESS   0x7FFFFF
 #define            FLASH2_FLASH_PAGE_SIZE    256
+#define            FLASH2_PAGE_PROGRAM_TIMEOUT_MS  5
+#define            FLASH2_ERASE_TIMEOUT_MS         1000
 /**
  * \defgroup error_code Error Code
  * \{
@@ -138,6 +140,8 @@
 #define FLASH2_RETVAL  uint8_t
 
 #define FLASH2_OK           0x00
+#define FLASH2_TIMEOUT_ERROR  0xFD
+#define FLASH2_PARAM_ERROR  0xFE
 #define FLASH2_INIT_ERROR   0xFF
 /** \} */
 
@@ -610,6 +614,7 @@ void flash2_highspeedRread( flash2_t *ctx, uint32_t address, uint8_t *buffer, ui
  * requires the ICO bit in the configuration register to be
  * set to ‘1’ prior to executing the command.
  *
+ * @note Use @c flash2_quad_write_pages to get the timeout status.
  */
 void flash2_quadWrite( flash2_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count );
 
@@ -628,11 +633,73 @@ void flash2_quadWrite( flash2_t *ctx, uint32_t address, uint8_t *buffer, uint32_
  * ating the Page-Program operation. A Page-Program
  * applied to a protected memory area will be ignored.
  *
- *
+ * @note A write started while an erase is in progress waits for it up to
+ * FLASH2_ERASE_TIMEOUT_MS. Use @c flash2_write_pages to get the timeout status.
  */
 void flash2_write_generic( flash2_t *ctx, uint32_t address, uint8_t *buffer,
                         uint32_t data_count );
 
+/**
+ * @brief  Flash 2 Wait Ready 
+ *
+ * @param ctx             Click object.
+ * @param timeout_ms - Maximum time to wait in milliseconds.
+ * @description Polls the BUSY bit of the Status register every 100 us until
+ * the current internal Write operation finishes or the timeout expires.
+ *
+ * @returns FLASH2_OK or FLASH2_TIMEOUT_ERROR
+ */
+FLASH2_RETVAL flash2_wait_ready( flash2_t *ctx, uint16_t timeout_ms );
+
+/**
+ * @brief  Flash 2 Page Program Start 
+ *
+ * @param ctx             Click object.
+ * @param address - Address to start write at.
+ * @param buffer - Buffer with data to write.
+ * @param data_count - Amount of bytes to write, must not cross a page boundary.
+ * @description Enables writes and issues a single Page-Program instruction,
+ * then returns without waiting for the program cycle to finish. The caller
+ * may prepare the next page while the device is busy and then check
+ * @c flash2_busy or call @c flash2_wait_ready before starting the next page.
+ *
+ * @returns FLASH2_OK or FLASH2_PARAM_ERROR
+ */
+FLASH2_RETVAL flash2_page_program_start( flash2_t *ctx, uint32_t address, uint8_t *buffer, 
+                                         uint16_t data_count );
+
+/**
+ * @brief  Flash 2 Write Pages 
+ *
+ * @param ctx             Click object.
+ * @param address - Address to start write at.
+ * @param buffer - Buffer with data to write.
+ * @param data_count - Amount of bytes to write.
+ * @description Writes any amount of data by splitting it on page boundaries
+ * and issuing Write-Enable and Page-Program for every page. A pending erase
+ * is waited for up to FLASH2_ERASE_TIMEOUT_MS before the first page, and each
+ * program cycle up to FLASH2_PAGE_PROGRAM_TIMEOUT_MS while the next page is set up.
+ *
+ * @returns FLASH2_OK or FLASH2_TIMEOUT_ERROR
+ */
+FLASH2_RETVAL flash2_write_pages( flash2_t *ctx, uint32_t address, uint8_t *buffer, 
+                                  uint32_t data_count );
+
+/**
+ * @brief  Flash 2 Quad Write Pages 
+ *
+ * @param ctx             Click object.
+ * @param address - Address to start write at.
+ * @param buffer - Buffer with data to write.
+ * @param data_count - Amount of bytes to write.
+ * @description Same as @c flash2_write_pages, using the SPI Quad Page-Program
+ * instruction for every page.
+ *
+ * @returns FLASH2_OK or FLASH2_TIMEOUT_ERROR
+ */
+FLASH2_RETVAL flash2_quad_write_pages( flash2_t *ctx, uint32_t address, uint8_t *buffer, 
+                                       uint32_t data_count );
+
 /**
  * @brief  Flash 2 Quad Enable 
  *
@@ -40,6 +40,8 @@ void flash2_write( flash2_t *ctx, uint8_t *buffer, uint16_t count );
 uint8_t flash2_read_byte( flash2_t *ctx );
 void flash2_read( flash2_t *ctx, uint8_t *buffer, uint16_t count );
 void flash2_write_address( flash2_t *ctx, uint32_t address );
+static FLASH2_RETVAL flash2_program_pages( flash2_t *ctx, uint8_t instr, uint32_t address, 
+                                           uint8_t *buffer, uint32_t data_count );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -402,93 +404,60 @@ void flash2_highspeedRread( flash2_t *ctx, uint32_t address, uint8_t *buffer, ui
 }
 void flash2_quadWrite( flash2_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count )
 {
-    uint8_t i;
-    uint8_t repeat;
-    uint8_t repeat_over;
-    while ( flash2_busy( ctx ) );
-
-    flash2_write_enable( ctx );
-    spi_master_select_device( ctx->chip_select );
-    flash2_command( ctx, FLASH2_INSTR_SPI_QUAD );
-    
-    if( data_count <= FLASH2_FLASH_PAGE_SIZE )
-    {
+    flash2_program_pages( ctx, FLASH2_INSTR_SPI_QUAD, address, buffer, data_count );
+}
 
+void flash2_write_generic( flash2_t *ctx, uint32_t address, uint8_t *buffer,
+                        uint32_t data_count )
+{
+    flash2_program_pages( ctx, FLASH2_INSTR_PP, address, buffer, data_count );
+}
 
-        flash2_write_address( ctx, address );
-        flash2_write( ctx, buffer, data_count );
+FLASH2_RETVAL flash2_wait_ready( flash2_t *ctx, uint16_t timeout_ms )
+{
+    uint32_t poll_cnt = ( uint32_t ) timeout_ms * 10;
 
-    }
-    else
+    while ( flash2_busy( ctx ) )
     {
-        repeat = data_count / FLASH2_FLASH_PAGE_SIZE;
-        repeat_over = data_count % FLASH2_FLASH_PAGE_SIZE;
-
-        for ( i = 0; i < repeat; i++ )
-        {
-
-
-            flash2_write_address( ctx, address + ( i * FLASH2_FLASH_PAGE_SIZE ) );
-            flash2_write(ctx,  buffer + ( i * FLASH2_FLASH_PAGE_SIZE ),
-                                        FLASH2_FLASH_PAGE_SIZE );
-        }
-        if ( repeat_over )
+        if ( !poll_cnt-- )
         {
-
-            flash2_write_address( ctx, address +
-                                           ( repeat * FLASH2_FLASH_PAGE_SIZE ) );
-            flash2_write( ctx, buffer + ( repeat * FLASH2_FLASH_PAGE_SIZE ),
-                                        repeat_over );
+            return FLASH2_TIMEOUT_ERROR;
         }
+        Delay_100us( );
     }
-    spi_master_deselect_device( ctx->chip_select );  
 
+    return FLASH2_OK;
 }
 
-void flash2_write_generic( flash2_t *ctx, uint32_t address, uint8_t *buffer,
-                        uint32_t data_count )
+FLASH2_RETVAL flash2_page_program_start( flash2_t *ctx, uint32_t address, uint8_t *buffer, 
+                                         uint16_t data_count )
 {
-    uint8_t i;
-    uint8_t repeat;
-    uint8_t repeat_over;
-    while ( flash2_busy( ctx ) );
+    if ( ( data_count == 0 ) ||
+         ( ( address % FLASH2_FLASH_PAGE_SIZE ) + data_count > FLASH2_FLASH_PAGE_SIZE ) )
+    {
+        return FLASH2_PARAM_ERROR;
+    }
 
     flash2_write_enable( ctx );
     spi_master_select_device( ctx->chip_select );
     flash2_command( ctx, FLASH2_INSTR_PP );
-    
-    if( data_count <= FLASH2_FLASH_PAGE_SIZE )
-    {
-
-        flash2_write_address( ctx, address );
-        flash2_write( ctx, buffer, data_count );
-
-    }
-    else
-    {
-        repeat = data_count / FLASH2_FLASH_PAGE_SIZE;
-        repeat_over = data_count % FLASH2_FLASH_PAGE_SIZE;
-
-        for ( i = 0; i < repeat; i++ )
-        {
-
-            flash2_write_address( ctx, address + ( i * FLASH2_FLASH_PAGE_SIZE ) );
-            flash2_write( ctx, buffer + ( i * FLASH2_FLASH_PAGE_SIZE ),
-                                        FLASH2_FLASH_PAGE_SIZE );
-        }
-        if ( repeat_over )
-        {
+    flash2_write_address( ctx, address );
+    flash2_write( ctx, buffer, data_count );
+    spi_master_deselect_device( ctx->chip_select );
 
+    return FLASH2_OK;
+}
 
-            flash2_write_address( ctx, address +
-                                           ( repeat * FLASH2_FLASH_PAGE_SIZE ) );
-            flash2_write( ctx, buffer + ( repeat * FLASH2_FLASH_PAGE_SIZE ),
-                                        repeat_over );
-        }
-    }
-    spi_master_deselect_device( ctx->chip_select );  
-    
+FLASH2_RETVAL flash2_write_pages( flash2_t *ctx, uint32_t address, uint8_t *buffer, 
+                                  uint32_t data_count )
+{
+    return flash2_program_pages( ctx, FLASH2_INSTR_PP, address, buffer, data_count );
+}
 
+FLASH2_RETVAL flash2_quad_write_pages( flash2_t *ctx, uint32_t address, uint8_t *buffer, 
+                                       uint32_t data_count )
+{
+    return flash2_program_pages( ctx, FLASH2_INSTR_SPI_QUAD, address, buffer, data_count );
 }
 
 void flash2_quad_enable( flash2_t *ctx )
@@ -832,6 +801,49 @@ void flash2_write_address( flash2_t *ctx, uint32_t addr )
     flash2_write( ctx, temp, 3 );
 }
 
+static FLASH2_RETVAL flash2_program_pages( flash2_t *ctx, uint8_t instr, uint32_t address, 
+                                           uint8_t *buffer, uint32_t data_count )
+{
+    uint16_t page_len;
+
+    // A sector, block or chip erase may still be running
+    if ( flash2_wait_ready( ctx, FLASH2_ERASE_TIMEOUT_MS ) )
+    {
+        return FLASH2_TIMEOUT_ERROR;
+    }
+
+    // The first chunk only reaches the end of the page the address points into
+    page_len = FLASH2_FLASH_PAGE_SIZE - ( address % FLASH2_FLASH_PAGE_SIZE );
+
+    while ( data_count )
+    {
+        if ( page_len > data_count )
+        {
+            page_len = data_count;
+        }
+
+        flash2_write_enable( ctx );
+        spi_master_select_device( ctx->chip_select );
+        flash2_command( ctx, instr );
+        flash2_write_address( ctx, address );
+        flash2_write( ctx, buffer, page_len );
+        spi_master_deselect_device( ctx->chip_select );
+
+        // Set up the next page while the current one is being programmed
+        address += page_len;
+        buffer += page_len;
+        data_count -= page_len;
+        page_len = FLASH2_FLASH_PAGE_SIZE;
+
+        if ( flash2_wait_ready( ctx, FLASH2_PAGE_PROGRAM_TIMEOUT_MS ) )
+        {
+            return FLASH2_TIMEOUT_ERROR;
+        }
+    }
+
+    return FLASH2_OK;
+}
+
 
 
 // ------------------------------------------------------------------------- END
@@ -95,6 +95,29 @@ extern "C"{
 #define GNSS_GPGGA_TIME_SINCE_LAST_DGPS             13
 #define GNSS_GPGGA_DGPS_REFERENCE_STATION_ID        14
 
+/**
+ * @brief GNSS NMEA streaming parser sentence IDs.
+ * @details Specified sentence IDs returned by the NMEA streaming parser of GNSS Click driver.
+ */
+#define GNSS_NMEA_SENTENCE_NONE                     0
+#define GNSS_NMEA_SENTENCE_GGA                      1
+#define GNSS_NMEA_SENTENCE_RMC                      2
+#define GNSS_NMEA_SENTENCE_GSA                      3
+#define GNSS_NMEA_SENTENCE_GSV                      4
+#define GNSS_NMEA_SENTENCE_VTG                      5
+#define GNSS_NMEA_SENTENCE_GNS                      6
+
+/**
+ * @brief GNSS NMEA streaming parser settings.
+ * @details Specified settings of the NMEA streaming parser of GNSS Click driver.
+ * @note Coordinates are expressed in 1e-7 degrees (negative for south and west),
+ * while speed, course, altitude and dilution of precision values are scaled by 100.
+ */
+#define GNSS_NMEA_FIELD_SIZE                        16
+#define GNSS_NMEA_GSA_MAX_SATELLITES                12
+#define GNSS_NMEA_GSV_MAX_SATELLITES                4
+#define GNSS_NMEA_COORDINATE_SCALE                  10000000ul
+
 /**
  * @brief GNSS driver buffer size.
  * @details Specified size of driver ring buffer.
@@ -181,6 +204,188 @@ typedef enum
 
 } gnss_return_value_t;
 
+/**
+ * @brief GNSS NMEA UTC time object.
+ * @details UTC time object definition of GNSS Click driver.
+ */
+typedef struct
+{
+    uint8_t hours;                      /**< Hours [0-23]. */
+    uint8_t minutes;                    /**< Minutes [0-59]. */
+    uint8_t seconds;                    /**< Seconds [0-60]. */
+    uint16_t milliseconds;              /**< Milliseconds [0-999]. */
+
+} gnss_nmea_time_t;
+
+/**
+ * @brief GNSS NMEA UTC date object.
+ * @details UTC date object definition of GNSS Click driver.
+ */
+typedef struct
+{
+    uint8_t day;                        /**< Day of month [1-31]. */
+    uint8_t month;                      /**< Month [1-12]. */
+    uint8_t year;                       /**< Year [0-99]. */
+
+} gnss_nmea_date_t;
+
+/**
+ * @brief GNSS NMEA GGA sentence object.
+ * @details Global positioning system fix data object definition of GNSS Click driver.
+ */
+typedef struct
+{
+    gnss_nmea_time_t time;              /**< UTC time of the fix. */
+    int32_t latitude;                   /**< Latitude in 1e-7 degrees. */
+    int32_t longitude;                  /**< Longitude in 1e-7 degrees. */
+    uint8_t quality;                    /**< Quality indicator (0 - no fix). */
+    uint8_t num_satellites;             /**< Number of satellites in use. */
+    uint16_t hdop;                      /**< Horizontal dilution of precision x100. */
+    int32_t altitude;                   /**< Altitude above mean sea level in cm. */
+    int32_t geoid_separation;           /**< Geoidal separation in cm. */
+    uint16_t dgps_age;                  /**< Age of differential data in seconds. */
+    uint16_t dgps_station_id;           /**< Differential reference station ID. */
+    char talker[ 3 ];                   /**< Talker ID of the sentence. */
+
+} gnss_nmea_gga_t;
+
+/**
+ * @brief GNSS NMEA RMC sentence object.
+ * @details Recommended minimum specific data object definition of GNSS Click driver.
+ */
+typedef struct
+{
+    gnss_nmea_time_t time;              /**< UTC time of the fix. */
+    char status;                        /**< Status ('A' - valid, 'V' - warning). */
+    int32_t latitude;                   /**< Latitude in 1e-7 degrees. */
+    int32_t longitude;                  /**< Longitude in 1e-7 degrees. */
+    uint32_t speed_knots;               /**< Speed over ground in knots x100. */
+    uint16_t course;                    /**< Course over ground in degrees x100. */
+    gnss_nmea_date_t date;              /**< UTC date of the fix. */
+    char mode;                          /**< Mode indicator. */
+    char talker[ 3 ];                   /**< Talker ID of the sentence. */
+
+} gnss_nmea_rmc_t;
+
+/**
+ * @brief GNSS NMEA GSA sentence object.
+ * @details DOP and active satellites object definition of GNSS Click driver.
+ */
+typedef struct
+{
+    char mode;                          /**< Selection mode ('M' - manual, 'A' - automatic). */
+    uint8_t fix_type;                   /**< Fix type (1 - none, 2 - 2D, 3 - 3D). */
+    uint8_t satellite_id[ GNSS_NMEA_GSA_MAX_SATELLITES ];   /**< Satellites used in the fix. */
+    uint16_t pdop;                      /**< Position dilution of precision x100. */
+    uint16_t hdop;                      /**< Horizontal dilution of precision x100. */
+    uint16_t vdop;                      /**< Vertical dilution of precision x100. */
+    uint8_t system_id;                  /**< GNSS system ID (NMEA 4.10 and later). */
+    char talker[ 3 ];                   /**< Talker ID of the sentence. */
+
+} gnss_nmea_gsa_t;
+
+/**
+ * @brief GNSS NMEA GSV satellite object.
+ * @details Satellite in view object definition of GNSS Click driver.
+ */
+typedef struct
+{
+    uint8_t id;                         /**< Satellite ID. */
+    int8_t elevation;                   /**< Elevation in degrees. */
+    uint16_t azimuth;                   /**< Azimuth in degrees. */
+    uint8_t snr;                        /**< Signal to noise ratio in dB-Hz. */
+
+} gnss_nmea_satellite_t;
+
+/**
+ * @brief GNSS NMEA GSV sentence object.
+ * @details Satellites in view object definition of GNSS Click driver.
+ */
+typedef struct
+{
+    uint8_t total_messages;             /**< Total number of GSV messages. */
+    uint8_t message_number;             /**< Number of this GSV message. */
+    uint8_t satellites_in_view;         /**< Total number of satellites in view. */
+    uint8_t num_satellites;             /**< Number of satellites in this message. */
+    gnss_nmea_satellite_t satellite[ GNSS_NMEA_GSV_MAX_SATELLITES ];   /**< Satellites in this message. */
+    uint8_t signal_id;                  /**< Signal ID (NMEA 4.10 and later). */
+    char talker[ 3 ];                   /**< Talker ID of the sentence. */
+
+} gnss_nmea_gsv_t;
+
+/**
+ * @brief GNSS NMEA VTG sentence object.
+ * @details Course over ground and ground speed object definition of GNSS Click driver.
+ */
+typedef struct
+{
+    uint16_t course_true;               /**< True course in degrees x100. */
+    uint16_t course_magnetic;           /**< Magnetic course in degrees x100. */
+    uint32_t speed_knots;               /**< Speed over ground in knots x100. */
+    uint32_t speed_kmh;                 /**< Speed over ground in km/h x100. */
+    char mode;                          /**< Mode indicator. */
+    char talker[ 3 ];                   /**< Talker ID of the sentence. */
+
+} gnss_nmea_vtg_t;
+
+/**
+ * @brief GNSS NMEA GNS sentence object.
+ * @details GNSS fix data object definition of GNSS Click driver.
+ */
+typedef struct
+{
+    gnss_nmea_time_t time;              /**< UTC time of the fix. */
+    int32_t latitude;                   /**< Latitude in 1e-7 degrees. */
+    int32_t longitude;                  /**< Longitude in 1e-7 degrees. */
+    char mode[ 5 ];                     /**< Mode indicator per constellation. */
+    uint8_t num_satellites;             /**< Number of satellites in use. */
+    uint16_t hdop;                      /**< Horizontal dilution of precision x100. */
+    int32_t altitude;                   /**< Altitude above mean sea level in cm. */
+    int32_t geoid_separation;           /**< Geoidal separation in cm. */
+    char nav_status;                    /**< Navigational status (NMEA 4.10 and later). */
+    char talker[ 3 ];                   /**< Talker ID of the sentence. */
+
+} gnss_nmea_gns_t;
+
+/**
+ * @brief GNSS NMEA streaming parser object.
+ * @details NMEA streaming parser object definition of GNSS Click driver.
+ * Bytes are fed one at a time and the sentence fields are decoded into the
+ * working union as soon as each field delimiter arrives. The decoded data is
+ * published to the matching sentence object only after the checksum is verified.
+ */
+typedef struct
+{
+    uint8_t state;                      /**< Parser state. */
+    uint8_t sentence;                   /**< Sentence ID being parsed. */
+    uint8_t field_num;                  /**< Index of the field being parsed. */
+    uint8_t field_len;                  /**< Length of the field being parsed. */
+    char field[ GNSS_NMEA_FIELD_SIZE ]; /**< Field being parsed. */
+    uint8_t checksum;                   /**< Calculated checksum. */
+    uint8_t rx_checksum;                /**< Received checksum. */
+    char talker[ 3 ];                   /**< Talker ID of the sentence being parsed. */
+    uint16_t checksum_errors;           /**< Number of sentences dropped on checksum mismatch. */
+
+    union
+    {
+        gnss_nmea_gga_t gga;
+        gnss_nmea_rmc_t rmc;
+        gnss_nmea_gsa_t gsa;
+        gnss_nmea_gsv_t gsv;
+        gnss_nmea_vtg_t vtg;
+        gnss_nmea_gns_t gns;
+
+    } work;                             /**< Sentence being parsed. */
+
+    gnss_nmea_gga_t gga;                /**< Last valid GGA sentence. */
+    gnss_nmea_rmc_t rmc;                /**< Last valid RMC sentence. */
+    gnss_nmea_gsa_t gsa;                /**< Last valid GSA sentence. */
+    gnss_nmea_gsv_t gsv;                /**< Last valid GSV sentence. */
+    gnss_nmea_vtg_t vtg;                /**< Last valid VTG sentence. */
+    gnss_nmea_gns_t gns;                /**< Last valid GNS sentence. */
+
+} gnss_nmea_parser_t;
+
 /*!
  * @addtogroup gnss GNSS Click Driver
  * @brief API for configuring and manipulating GNSS Click driver.
@@ -286,6 +491,45 @@ void gnss_set_fon_pin ( gnss_t *ctx, uint8_t state );
  */
 err_t gnss_parse_gpgga ( char *rsp_buf, uint8_t gpgga_element, char *element_data );
 
+/**
+ * @brief GNSS NMEA parser init function.
+ * @details This function resets the NMEA streaming parser state and all decoded sentence data.
+ * @param[out] parser : NMEA streaming parser object.
+ * See #gnss_nmea_parser_t object definition for detailed explanation.
+ * @return None.
+ * @note None.
+ */
+void gnss_nmea_parser_init ( gnss_nmea_parser_t *parser );
+
+/**
+ * @brief GNSS NMEA parse byte function.
+ * @details This function feeds a single received byte to the NMEA streaming parser.
+ * Supported sentences are GGA, RMC, GSA, GSV, VTG and GNS from any talker ID.
+ * Each sentence is decoded in a single pass and published to the parser object
+ * only if its checksum matches.
+ * @param[in,out] parser : NMEA streaming parser object.
+ * See #gnss_nmea_parser_t object definition for detailed explanation.
+ * @param[in] data_in : Received byte.
+ * @return @li @c  0 - No sentence completed,
+ *         @li @c >0 - ID of the completed sentence (GNSS_NMEA_SENTENCE_x).
+ * @note None.
+ */
+uint8_t gnss_nmea_parse_byte ( gnss_nmea_parser_t *parser, char data_in );
+
+/**
+ * @brief GNSS NMEA process function.
+ * @details This function reads bytes from the UART ring buffer and feeds them to the NMEA
+ * streaming parser until a sentence is completed or the ring buffer is empty.
+ * @param[in] ctx : Click context object.
+ * See #gnss_t object definition for detailed explanation.
+ * @param[in,out] parser : NMEA streaming parser object.
+ * See #gnss_nmea_parser_t object definition for detailed explanation.
+ * @return @li @c  0 - No sentence completed,
+ *         @li @c >0 - ID of the completed sentence (GNSS_NMEA_SENTENCE_x).
+ * @note The remaining bytes stay in the ring buffer for the next call.
+ */
+uint8_t gnss_nmea_process ( gnss_t *ctx, gnss_nmea_parser_t *parser );
+
 #ifdef __cplusplus
 }
 #endif
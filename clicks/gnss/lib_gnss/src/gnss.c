@@ -28,6 +28,65 @@
 #include "gnss.h"
 #include "generic_pointer.h"
 
+/**
+ * @brief GNSS NMEA streaming parser states.
+ * @details Specified states of the NMEA streaming parser of GNSS Click driver.
+ */
+#define GNSS_NMEA_STATE_WAIT_START      0
+#define GNSS_NMEA_STATE_FIELDS          1
+#define GNSS_NMEA_STATE_CHECKSUM_HI     2
+#define GNSS_NMEA_STATE_CHECKSUM_LO     3
+
+/**
+ * @brief GNSS NMEA hex character to nibble function.
+ * @details This function converts a hex character to its nibble value, returns 0xFF on invalid character.
+ */
+static uint8_t gnss_nmea_hex_to_nibble ( char hex );
+
+/**
+ * @brief GNSS NMEA parse fixed point function.
+ * @details This function converts a decimal field to a signed integer scaled by 10^decimals.
+ * Extra decimal digits are truncated.
+ */
+static int32_t gnss_nmea_parse_fixed ( char *field, uint8_t decimals );
+
+/**
+ * @brief GNSS NMEA parse time function.
+ * @details This function converts a hhmmss.sss field to the UTC time object.
+ */
+static void gnss_nmea_parse_time ( char *field, gnss_nmea_time_t *time );
+
+/**
+ * @brief GNSS NMEA parse coordinate function.
+ * @details This function converts a (d)ddmm.mmmmm field to 1e-7 degrees.
+ */
+static int32_t gnss_nmea_parse_coordinate ( char *field );
+
+/**
+ * @brief GNSS NMEA GSV capacity function.
+ * @details This function returns the number of satellites the current GSV message carries,
+ * derived from the satellites in view and the message number.
+ */
+static uint8_t gnss_nmea_gsv_capacity ( gnss_nmea_gsv_t *gsv );
+
+/**
+ * @brief GNSS NMEA parse address function.
+ * @details This function resolves the sentence ID from the address field and clears the working sentence object.
+ */
+static uint8_t gnss_nmea_parse_address ( gnss_nmea_parser_t *parser );
+
+/**
+ * @brief GNSS NMEA parse field function.
+ * @details This function decodes the completed field into the working sentence object.
+ */
+static void gnss_nmea_parse_field ( gnss_nmea_parser_t *parser );
+
+/**
+ * @brief GNSS NMEA publish sentence function.
+ * @details This function copies the verified working sentence object to its published object.
+ */
+static void gnss_nmea_publish ( gnss_nmea_parser_t *parser );
+
 void gnss_cfg_setup ( gnss_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -147,4 +206,655 @@ err_t gnss_parse_gpgga ( char *rsp_buf, uint8_t gpgga_element, char *element_dat
     return GNSS_ERROR;
 }
 
+void gnss_nmea_parser_init ( gnss_nmea_parser_t *parser )
+{
+    memset( parser, 0, sizeof( gnss_nmea_parser_t ) );
+    parser->state = GNSS_NMEA_STATE_WAIT_START;
+}
+
+uint8_t gnss_nmea_parse_byte ( gnss_nmea_parser_t *parser, char data_in )
+{
+    if ( '$' == data_in )
+    {
+        parser->state = GNSS_NMEA_STATE_FIELDS;
+        parser->sentence = GNSS_NMEA_SENTENCE_NONE;
+        parser->field_num = 0;
+        parser->field_len = 0;
+        parser->checksum = 0;
+        return GNSS_NMEA_SENTENCE_NONE;
+    }
+    switch ( parser->state )
+    {
+        case GNSS_NMEA_STATE_FIELDS:
+        {
+            if ( ( ',' == data_in ) || ( '*' == data_in ) )
+            {
+                parser->field[ parser->field_len ] = '\0';
+                if ( 0 == parser->field_num )
+                {
+                    parser->sentence = gnss_nmea_parse_address( parser );
+                    if ( GNSS_NMEA_SENTENCE_NONE == parser->sentence )
+                    {
+                        parser->state = GNSS_NMEA_STATE_WAIT_START;
+                        break;
+                    }
+                }
+                else
+                {
+                    gnss_nmea_parse_field( parser );
+                }
+                if ( '*' == data_in )
+                {
+                    parser->state = GNSS_NMEA_STATE_CHECKSUM_HI;
+                    break;
+                }
+                parser->checksum ^= data_in;
+                parser->field_num++;
+                parser->field_len = 0;
+            }
+            else if ( ( '\r' == data_in ) || ( '\n' == data_in ) || 
+                      ( parser->field_len >= ( GNSS_NMEA_FIELD_SIZE - 1 ) ) )
+            {
+                parser->state = GNSS_NMEA_STATE_WAIT_START;
+            }
+            else
+            {
+                parser->checksum ^= data_in;
+                parser->field[ parser->field_len++ ] = data_in;
+            }
+            break;
+        }
+        case GNSS_NMEA_STATE_CHECKSUM_HI:
+        {
+            uint8_t nibble = gnss_nmea_hex_to_nibble( data_in );
+            if ( nibble > 0x0F )
+            {
+                parser->state = GNSS_NMEA_STATE_WAIT_START;
+                break;
+            }
+            parser->rx_checksum = nibble << 4;
+            parser->state = GNSS_NMEA_STATE_CHECKSUM_LO;
+            break;
+        }
+        case GNSS_NMEA_STATE_CHECKSUM_LO:
+        {
+            uint8_t nibble = gnss_nmea_hex_to_nibble( data_in );
+            parser->state = GNSS_NMEA_STATE_WAIT_START;
+            if ( nibble > 0x0F )
+            {
+                break;
+            }
+            parser->rx_checksum |= nibble;
+            if ( parser->rx_checksum != parser->checksum )
+            {
+                parser->checksum_errors++;
+                break;
+            }
+            gnss_nmea_publish( parser );
+            return parser->sentence;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    return GNSS_NMEA_SENTENCE_NONE;
+}
+
+uint8_t gnss_nmea_process ( gnss_t *ctx, gnss_nmea_parser_t *parser )
+{
+    char rx_byte = 0;
+    uint8_t sentence = GNSS_NMEA_SENTENCE_NONE;
+    while ( ( GNSS_NMEA_SENTENCE_NONE == sentence ) && ( uart_read( &ctx->uart, &rx_byte, 1 ) > 0 ) )
+    {
+        sentence = gnss_nmea_parse_byte( parser, rx_byte );
+    }
+    return sentence;
+}
+
+static uint8_t gnss_nmea_hex_to_nibble ( char hex )
+{
+    if ( ( hex >= '0' ) && ( hex <= '9' ) )
+    {
+        return hex - '0';
+    }
+    if ( ( hex >= 'A' ) && ( hex <= 'F' ) )
+    {
+        return hex - 'A' + 10;
+    }
+    if ( ( hex >= 'a' ) && ( hex <= 'f' ) )
+    {
+        return hex - 'a' + 10;
+    }
+    return 0xFF;
+}
+
+static int32_t gnss_nmea_parse_fixed ( char *field, uint8_t decimals )
+{
+    int32_t value = 0;
+    uint8_t sign = 0;
+    uint8_t fraction = 0;
+    uint8_t frac_cnt = 0;
+    if ( '-' == *field )
+    {
+        sign = 1;
+        field++;
+    }
+    for ( ; *field; field++ )
+    {
+        if ( '.' == *field )
+        {
+            fraction = 1;
+        }
+        else if ( ( *field >= '0' ) && ( *field <= '9' ) )
+        {
+            if ( fraction )
+            {
+                if ( frac_cnt >= decimals )
+                {
+                    break;
+                }
+                frac_cnt++;
+            }
+            value = value * 10 + ( *field - '0' );
+        }
+        else
+        {
+            break;
+        }
+    }
+    for ( ; frac_cnt < decimals; frac_cnt++ )
+    {
+        value *= 10;
+    }
+    return sign ? -value : value;
+}
+
+static void gnss_nmea_parse_time ( char *field, gnss_nmea_time_t *time )
+{
+    int32_t time_ms = gnss_nmea_parse_fixed( field, 3 );
+    time->milliseconds = time_ms % 1000;
+    time_ms /= 1000;
+    time->seconds = time_ms % 100;
+    time_ms /= 100;
+    time->minutes = time_ms % 100;
+    time->hours = time_ms / 100;
+}
+
+static int32_t gnss_nmea_parse_coordinate ( char *field )
+{
+    // (d)ddmm.mmmmm scaled by 1e5, the degrees are above the 1e7 boundary.
+    uint32_t raw = ( uint32_t ) gnss_nmea_parse_fixed( field, 5 );
+    uint32_t degrees = raw / GNSS_NMEA_COORDINATE_SCALE;
+    uint32_t minutes = raw % GNSS_NMEA_COORDINATE_SCALE;
+    return ( int32_t ) ( degrees * GNSS_NMEA_COORDINATE_SCALE + ( minutes * 10 ) / 6 );
+}
+
+static uint8_t gnss_nmea_gsv_capacity ( gnss_nmea_gsv_t *gsv )
+{
+    uint16_t first = 0;
+    if ( gsv->message_number > 1 )
+    {
+        first = ( uint16_t ) ( gsv->message_number - 1 ) * GNSS_NMEA_GSV_MAX_SATELLITES;
+    }
+    if ( gsv->satellites_in_view <= first )
+    {
+        return 0;
+    }
+    if ( ( gsv->satellites_in_view - first ) > GNSS_NMEA_GSV_MAX_SATELLITES )
+    {
+        return GNSS_NMEA_GSV_MAX_SATELLITES;
+    }
+    return ( uint8_t ) ( gsv->satellites_in_view - first );
+}
+
+static uint8_t gnss_nmea_parse_address ( gnss_nmea_parser_t *parser )
+{
+    uint8_t sentence = GNSS_NMEA_SENTENCE_NONE;
+    char *type = &parser->field[ 2 ];
+    if ( 5 != parser->field_len )
+    {
+        return GNSS_NMEA_SENTENCE_NONE;
+    }
+    if ( ( 'G' == type[ 0 ] ) && ( 'G' == type[ 1 ] ) && ( 'A' == type[ 2 ] ) )
+    {
+        sentence = GNSS_NMEA_SENTENCE_GGA;
+    }
+    else if ( ( 'R' == type[ 0 ] ) && ( 'M' == type[ 1 ] ) && ( 'C' == type[ 2 ] ) )
+    {
+        sentence = GNSS_NMEA_SENTENCE_RMC;
+    }
+    else if ( ( 'G' == type[ 0 ] ) && ( 'S' == type[ 1 ] ) && ( 'A' == type[ 2 ] ) )
+    {
+        sentence = GNSS_NMEA_SENTENCE_GSA;
+    }
+    else if ( ( 'G' == type[ 0 ] ) && ( 'S' == type[ 1 ] ) && ( 'V' == type[ 2 ] ) )
+    {
+        sentence = GNSS_NMEA_SENTENCE_GSV;
+    }
+    else if ( ( 'V' == type[ 0 ] ) && ( 'T' == type[ 1 ] ) && ( 'G' == type[ 2 ] ) )
+    {
+        sentence = GNSS_NMEA_SENTENCE_VTG;
+    }
+    else if ( ( 'G' == type[ 0 ] ) && ( 'N' == type[ 1 ] ) && ( 'S' == type[ 2 ] ) )
+    {
+        sentence = GNSS_NMEA_SENTENCE_GNS;
+    }
+    else
+    {
+        return GNSS_NMEA_SENTENCE_NONE;
+    }
+    memset( &parser->work, 0, sizeof( parser->work ) );
+    parser->talker[ 0 ] = parser->field[ 0 ];
+    parser->talker[ 1 ] = parser->field[ 1 ];
+    return sentence;
+}
+
+static void gnss_nmea_parse_field ( gnss_nmea_parser_t *parser )
+{
+    char *field = parser->field;
+    uint8_t field_num = parser->field_num;
+    if ( 0 == parser->field_len )
+    {
+        return;
+    }
+    switch ( parser->sentence )
+    {
+        case GNSS_NMEA_SENTENCE_GGA:
+        {
+            gnss_nmea_gga_t *gga = &parser->work.gga;
+            switch ( field_num )
+            {
+                case GNSS_GPGGA_TIME:
+                {
+                    gnss_nmea_parse_time( field, &gga->time );
+                    break;
+                }
+                case GNSS_GPGGA_LATITUDE:
+                {
+                    gga->latitude = gnss_nmea_parse_coordinate( field );
+                    break;
+                }
+                case GNSS_GPGGA_LATITUDE_SIDE:
+                {
+                    if ( 'S' == field[ 0 ] )
+                    {
+                        gga->latitude = -gga->latitude;
+                    }
+                    break;
+                }
+                case GNSS_GPGGA_LONGITUDE:
+                {
+                    gga->longitude = gnss_nmea_parse_coordinate( field );
+                    break;
+                }
+                case GNSS_GPGGA_LONGITUDE_SIDE:
+                {
+                    if ( 'W' == field[ 0 ] )
+                    {
+                        gga->longitude = -gga->longitude;
+                    }
+                    break;
+                }
+                case GNSS_GPGGA_QUALITY_INDICATOR:
+                {
+                    gga->quality = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+                    break;
+                }
+                case GNSS_GPGGA_NUMBER_OF_SATELLITES:
+                {
+                    gga->num_satellites = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+                    break;
+                }
+                case GNSS_GPGGA_H_DILUTION_OF_POS:
+                {
+                    gga->hdop = ( uint16_t ) gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case GNSS_GPGGA_ALTITUDE:
+                {
+                    gga->altitude = gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case GNSS_GPGGA_GEOIDAL_SEPARATION:
+                {
+                    gga->geoid_separation = gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case GNSS_GPGGA_TIME_SINCE_LAST_DGPS:
+                {
+                    gga->dgps_age = ( uint16_t ) gnss_nmea_parse_fixed( field, 0 );
+                    break;
+                }
+                case GNSS_GPGGA_DGPS_REFERENCE_STATION_ID:
+                {
+                    gga->dgps_station_id = ( uint16_t ) gnss_nmea_parse_fixed( field, 0 );
+                    break;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_RMC:
+        {
+            gnss_nmea_rmc_t *rmc = &parser->work.rmc;
+            switch ( field_num )
+            {
+                case 1:
+                {
+                    gnss_nmea_parse_time( field, &rmc->time );
+                    break;
+                }
+                case 2:
+                {
+                    rmc->status = field[ 0 ];
+                    break;
+                }
+                case 3:
+                {
+                    rmc->latitude = gnss_nmea_parse_coordinate( field );
+                    break;
+                }
+                case 4:
+                {
+                    if ( 'S' == field[ 0 ] )
+                    {
+                        rmc->latitude = -rmc->latitude;
+                    }
+                    break;
+                }
+                case 5:
+                {
+                    rmc->longitude = gnss_nmea_parse_coordinate( field );
+                    break;
+                }
+                case 6:
+                {
+                    if ( 'W' == field[ 0 ] )
+                    {
+                        rmc->longitude = -rmc->longitude;
+                    }
+                    break;
+                }
+                case 7:
+                {
+                    rmc->speed_knots = ( uint32_t ) gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case 8:
+                {
+                    rmc->course = ( uint16_t ) gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case 9:
+                {
+                    int32_t date = gnss_nmea_parse_fixed( field, 0 );
+                    rmc->date.year = date % 100;
+                    rmc->date.month = ( date / 100 ) % 100;
+                    rmc->date.day = date / 10000;
+                    break;
+                }
+                case 12:
+                {
+                    rmc->mode = field[ 0 ];
+                    break;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_GSA:
+        {
+            gnss_nmea_gsa_t *gsa = &parser->work.gsa;
+            if ( 1 == field_num )
+            {
+                gsa->mode = field[ 0 ];
+            }
+            else if ( 2 == field_num )
+            {
+                gsa->fix_type = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+            }
+            else if ( field_num < ( 3 + GNSS_NMEA_GSA_MAX_SATELLITES ) )
+            {
+                gsa->satellite_id[ field_num - 3 ] = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+            }
+            else if ( 15 == field_num )
+            {
+                gsa->pdop = ( uint16_t ) gnss_nmea_parse_fixed( field, 2 );
+            }
+            else if ( 16 == field_num )
+            {
+                gsa->hdop = ( uint16_t ) gnss_nmea_parse_fixed( field, 2 );
+            }
+            else if ( 17 == field_num )
+            {
+                gsa->vdop = ( uint16_t ) gnss_nmea_parse_fixed( field, 2 );
+            }
+            else if ( 18 == field_num )
+            {
+                gsa->system_id = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+            }
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_GSV:
+        {
+            gnss_nmea_gsv_t *gsv = &parser->work.gsv;
+            if ( 1 == field_num )
+            {
+                gsv->total_messages = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+            }
+            else if ( 2 == field_num )
+            {
+                gsv->message_number = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+            }
+            else if ( 3 == field_num )
+            {
+                gsv->satellites_in_view = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+            }
+            else if ( field_num == ( 4 + gnss_nmea_gsv_capacity( gsv ) * 4 ) )
+            {
+                // NMEA 4.10 appends the signal ID after the last satellite block
+                gsv->signal_id = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+            }
+            else if ( field_num < ( 4 + gnss_nmea_gsv_capacity( gsv ) * 4 ) )
+            {
+                uint8_t sat_num = ( field_num - 4 ) / 4;
+                gnss_nmea_satellite_t *sat = &gsv->satellite[ sat_num ];
+                switch ( ( field_num - 4 ) % 4 )
+                {
+                    case 0:
+                    {
+                        sat->id = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+                        gsv->num_satellites = sat_num + 1;
+                        break;
+                    }
+                    case 1:
+                    {
+                        sat->elevation = ( int8_t ) gnss_nmea_parse_fixed( field, 0 );
+                        break;
+                    }
+                    case 2:
+                    {
+                        sat->azimuth = ( uint16_t ) gnss_nmea_parse_fixed( field, 0 );
+                        break;
+                    }
+                    default:
+                    {
+                        sat->snr = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+                        break;
+                    }
+                }
+            }
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_VTG:
+        {
+            gnss_nmea_vtg_t *vtg = &parser->work.vtg;
+            switch ( field_num )
+            {
+                case 1:
+                {
+                    vtg->course_true = ( uint16_t ) gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case 3:
+                {
+                    vtg->course_magnetic = ( uint16_t ) gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case 5:
+                {
+                    vtg->speed_knots = ( uint32_t ) gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case 7:
+                {
+                    vtg->speed_kmh = ( uint32_t ) gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case 9:
+                {
+                    vtg->mode = field[ 0 ];
+                    break;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_GNS:
+        {
+            gnss_nmea_gns_t *gns = &parser->work.gns;
+            switch ( field_num )
+            {
+                case 1:
+                {
+                    gnss_nmea_parse_time( field, &gns->time );
+                    break;
+                }
+                case 2:
+                {
+                    gns->latitude = gnss_nmea_parse_coordinate( field );
+                    break;
+                }
+                case 3:
+                {
+                    if ( 'S' == field[ 0 ] )
+                    {
+                        gns->latitude = -gns->latitude;
+                    }
+                    break;
+                }
+                case 4:
+                {
+                    gns->longitude = gnss_nmea_parse_coordinate( field );
+                    break;
+                }
+                case 5:
+                {
+                    if ( 'W' == field[ 0 ] )
+                    {
+                        gns->longitude = -gns->longitude;
+                    }
+                    break;
+                }
+                case 6:
+                {
+                    strncpy( gns->mode, field, sizeof( gns->mode ) - 1 );
+                    break;
+                }
+                case 7:
+                {
+                    gns->num_satellites = ( uint8_t ) gnss_nmea_parse_fixed( field, 0 );
+                    break;
+                }
+                case 8:
+                {
+                    gns->hdop = ( uint16_t ) gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case 9:
+                {
+                    gns->altitude = gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case 10:
+                {
+                    gns->geoid_separation = gnss_nmea_parse_fixed( field, 2 );
+                    break;
+                }
+                case 13:
+                {
+                    gns->nav_status = field[ 0 ];
+                    break;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+static void gnss_nmea_publish ( gnss_nmea_parser_t *parser )
+{
+    switch ( parser->sentence )
+    {
+        case GNSS_NMEA_SENTENCE_GGA:
+        {
+            memcpy( &parser->gga, &parser->work.gga, sizeof( gnss_nmea_gga_t ) );
+            memcpy( parser->gga.talker, parser->talker, sizeof( parser->talker ) );
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_RMC:
+        {
+            memcpy( &parser->rmc, &parser->work.rmc, sizeof( gnss_nmea_rmc_t ) );
+            memcpy( parser->rmc.talker, parser->talker, sizeof( parser->talker ) );
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_GSA:
+        {
+            memcpy( &parser->gsa, &parser->work.gsa, sizeof( gnss_nmea_gsa_t ) );
+            memcpy( parser->gsa.talker, parser->talker, sizeof( parser->talker ) );
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_GSV:
+        {
+            memcpy( &parser->gsv, &parser->work.gsv, sizeof( gnss_nmea_gsv_t ) );
+            memcpy( parser->gsv.talker, parser->talker, sizeof( parser->talker ) );
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_VTG:
+        {
+            memcpy( &parser->vtg, &parser->work.vtg, sizeof( gnss_nmea_vtg_t ) );
+            memcpy( parser->vtg.talker, parser->talker, sizeof( parser->talker ) );
+            break;
+        }
+        case GNSS_NMEA_SENTENCE_GNS:
+        {
+            memcpy( &parser->gns, &parser->work.gns, sizeof( gnss_nmea_gns_t ) );
+            memcpy( parser->gns.talker, parser->talker, sizeof( parser->talker ) );
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
 // ------------------------------------------------------------------------- END
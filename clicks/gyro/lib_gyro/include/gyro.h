@@ -103,6 +103,7 @@
 #define GYRO_L3GD20_REGISTER_OUT_Z_H                    0x2D
 #define GYRO_L3GD20_REGISTER_FIFO_CTRL_REG              0x2E
 #define GYRO_L3GD20_REGISTER_FIFO_SRC_REG               0x2F
+#define GYRO_L3GD20_AUTO_INCREMENT                      0x80
 /** \} */
 
 /**
@@ -260,7 +261,7 @@ uint8_t gyro_read_data ( gyro_t *ctx, uint8_t address );
  *
  * @returns         16-bit value ( low and high data )
  *
- * @description Function get data from two L3GD20 register.
+ * @description Function get data from two L3GD20 register in a single transaction.
  */
 int16_t gyro_get_axis ( gyro_t *ctx, uint8_t adr_reg_low );
 
@@ -273,7 +274,8 @@ int16_t gyro_get_axis ( gyro_t *ctx, uint8_t adr_reg_low );
  * @param gyro_y             pointer to read Gyro Y-axis data
  * @param gyro_z             pointer to read Gyro Z-axis data
  *
- * @description Function read Gyro X-axis, Y-axis and Z-axis axis.
+ * @description Function read Gyro X-axis, Y-axis and Z-axis axis of the same sample
+ * in a single transaction.
  *
  */
 void gyro_read_gyro ( gyro_t *ctx, int16_t *gyro_x, int16_t *gyro_y, int16_t *gyro_z );
@@ -113,8 +113,8 @@ int16_t gyro_get_axis ( gyro_t *ctx, uint8_t adr_reg_low )
     uint16_t result;
     uint8_t buffer[ 2 ];
 
-    buffer[ 0 ] = gyro_read_data( ctx, adr_reg_low );
-    buffer[ 1 ] = gyro_read_data( ctx, adr_reg_low + 1 );
+    adr_reg_low |= GYRO_L3GD20_AUTO_INCREMENT;
+    i2c_master_write_then_read( &ctx->i2c, &adr_reg_low, 1, buffer, 2 );
 
     result = buffer[ 1 ];
     result <<= 8;
@@ -125,9 +125,16 @@ int16_t gyro_get_axis ( gyro_t *ctx, uint8_t adr_reg_low )
 
 void gyro_read_gyro ( gyro_t *ctx, int16_t *gyro_x, int16_t *gyro_y, int16_t *gyro_z )
 {
-    *gyro_x = gyro_get_axis( ctx, GYRO_L3GD20_REGISTER_OUT_X_L );
-    *gyro_y = gyro_get_axis( ctx, GYRO_L3GD20_REGISTER_OUT_Y_L );
-    *gyro_z = gyro_get_axis( ctx, GYRO_L3GD20_REGISTER_OUT_Z_L );
+    uint8_t address;
+    uint8_t buffer[ 6 ];
+
+    // OUT_X_L to OUT_Z_H are read with the sub-address auto increment
+    address = GYRO_L3GD20_REGISTER_OUT_X_L | GYRO_L3GD20_AUTO_INCREMENT;
+    i2c_master_write_then_read( &ctx->i2c, &address, 1, buffer, 6 );
+
+    *gyro_x = ( int16_t )( ( ( uint16_t ) buffer[ 1 ] << 8 ) | buffer[ 0 ] );
+    *gyro_y = ( int16_t )( ( ( uint16_t ) buffer[ 3 ] << 8 ) | buffer[ 2 ] );
+    *gyro_z = ( int16_t )( ( ( uint16_t ) buffer[ 5 ] << 8 ) | buffer[ 4 ] );
 }
 
 // ------------------------------------------------------------------------ END
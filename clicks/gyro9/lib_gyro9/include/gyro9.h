@@ -557,7 +557,7 @@ err_t gyro9_get_status ( gyro9_t *ctx, uint8_t *status );
 
 /**
  * @brief Gyro 9 get gyro data function.
- * @details This function reads the gyroscope raw data 
+ * @details This function reads the gyroscope raw data of all axes in a single burst
  * of the A3G4250D, MEMS motion sensor: 3-axis digital output gyroscope
  * on the Gyro 9 Click board™.
  * @param[in] ctx : Click context object.
@@ -34,6 +34,14 @@
 #define DUMMY             0x00
 #define SPI_READ_MASK     0x80
 
+/**
+ * @brief Register address auto increment.
+ * @details Definition of the register address auto increment bits
+ * used for multiple byte reading.
+ */
+#define I2C_AUTO_INC_MASK 0x80
+#define SPI_AUTO_INC_MASK 0x40
+
 /**
  * @brief Gyro 9 I2C writing function.
  * @details This function writes a desired number of data bytes starting from
@@ -324,22 +332,17 @@ err_t gyro9_get_status ( gyro9_t *ctx, uint8_t *status )
 
 err_t gyro9_get_axis_data ( gyro9_t *ctx, gyro9_axis_data_t *gyro_axis )
 {
-    uint8_t data_buf = DUMMY;
-    err_t err_flag = gyro9_generic_read( ctx, GYRO9_REG_OUT_X_H, &data_buf, 1 );
-    gyro_axis->x = data_buf;
+    uint8_t data_buf[ 6 ] = { 0 };
+    err_t err_flag = gyro9_generic_read( ctx, GYRO9_REG_OUT_X_L, data_buf, 6 );
+    gyro_axis->x = data_buf[ 1 ];
     gyro_axis->x <<= 8;
-    err_flag = gyro9_generic_read( ctx, GYRO9_REG_OUT_X_L, &data_buf, 1 );
-    gyro_axis->x |= data_buf;
-    err_flag |= gyro9_generic_read( ctx, GYRO9_REG_OUT_Y_H, &data_buf, 1 );
-    gyro_axis->y = data_buf;
+    gyro_axis->x |= data_buf[ 0 ];
+    gyro_axis->y = data_buf[ 3 ];
     gyro_axis->y <<= 8;
-    err_flag = gyro9_generic_read( ctx, GYRO9_REG_OUT_Y_L, &data_buf, 1 );
-    gyro_axis->y |= data_buf;
-    err_flag |= gyro9_generic_read( ctx, GYRO9_REG_OUT_Z_H, &data_buf, 1 );
-    gyro_axis->z = data_buf;
+    gyro_axis->y |= data_buf[ 2 ];
+    gyro_axis->z = data_buf[ 5 ];
     gyro_axis->z <<= 8;
-    err_flag = gyro9_generic_read( ctx, GYRO9_REG_OUT_Z_L, &data_buf, 1 );
-    gyro_axis->z |= data_buf;
+    gyro_axis->z |= data_buf[ 4 ];
     return err_flag;
 }
 
@@ -384,6 +387,10 @@ static err_t gyro9_i2c_write ( gyro9_t *ctx, uint8_t reg, uint8_t *data_in, uint
 
 static err_t gyro9_i2c_read ( gyro9_t *ctx, uint8_t reg, uint8_t *data_out, uint8_t len ) 
 {
+    if ( len > 1 )
+    {
+        reg |= I2C_AUTO_INC_MASK;
+    }
     return i2c_master_write_then_read( &ctx->i2c, &reg, 1, data_out, len );
 }
 
@@ -399,6 +406,10 @@ static err_t gyro9_spi_write ( gyro9_t *ctx, uint8_t reg, uint8_t *data_in, uint
 static err_t gyro9_spi_read ( gyro9_t *ctx, uint8_t reg, uint8_t *data_out, uint8_t len ) 
 {
     uint8_t reg_adr = reg | SPI_READ_MASK;
+    if ( len > 1 )
+    {
+        reg_adr |= SPI_AUTO_INC_MASK;
+    }
     spi_master_select_device( ctx->chip_select );
     err_t error_flag = spi_master_write_then_read( &ctx->spi, &reg_adr, 1, data_out, len );
     spi_master_deselect_device( ctx->chip_select );
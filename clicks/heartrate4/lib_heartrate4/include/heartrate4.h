@@ -110,6 +110,9 @@
 #define HEARTRATE4_FIFO_READ_PTR              0x06
 #define HEARTRATE4_FIFO_DATA                  0x07
 #define HEARTRATE4_BUFFER_LENGTH              32
+#define HEARTRATE4_FIFO_DEPTH                 32
+#define HEARTRATE4_FIFO_PTR_MASK              0x1F
+#define HEARTRATE4_FIFO_SAMPLE_SIZE           9
 /** \} */
 
 /**
@@ -636,11 +639,12 @@ uint8_t heartrate4_check_int_pow_and_temp ( heartrate4_t *ctx, uint8_t flag );
  * @brief Read all FIFO samples function
  *
  * @param ctx           Click object.
- * @param buff  output buffer
+ * @param buff  output buffer, at least HEARTRATE4_FIFO_DEPTH * HEARTRATE4_FIFO_SAMPLE_SIZE bytes
  *
- * @returns 16-bit data representing the number of samples to read
+ * @returns 16-bit data representing the number of samples read
  *
- * @description Function is used to read all FIFO data samples and returns average value.
+ * @description Function reads the FIFO pointers in one transaction and then
+ * all pending samples in a single burst, HEARTRATE4_FIFO_SAMPLE_SIZE bytes per sample.
 **/
 uint16_t heartrate4_read_fifo_all_samples ( heartrate4_t *ctx, uint8_t *buff );
 
@@ -475,20 +475,23 @@ uint8_t heartrate4_check_int_pow_and_temp ( heartrate4_t *ctx, uint8_t flag )
 
 uint16_t heartrate4_read_fifo_all_samples ( heartrate4_t *ctx, uint8_t *buff )
 {
-    uint8_t *tem_ptr = buff;
+    uint8_t ptr_buff[ 3 ];
+    uint8_t wr_buff[ 1 ];
     uint16_t samp_to_rd = 0;
-    uint16_t fifo_rd_ptr = 0;
-    uint16_t fifo_wr_ptr = 0;
-    uint16_t cnt = 0;
 
-    fifo_wr_ptr = heartrate4_get_write_ptr ( ctx );
-    fifo_rd_ptr = heartrate4_get_read_ptr( ctx );
-    samp_to_rd = fifo_wr_ptr - fifo_rd_ptr;
+    // FIFO write pointer, overflow counter and read pointer are consecutive registers
+    heartrate4_multi_read( ctx, HEARTRATE4_FIFO_WRITE_PTR, ptr_buff, 3 );
+
+    samp_to_rd = ( ptr_buff[ 0 ] - ptr_buff[ 2 ] ) & HEARTRATE4_FIFO_PTR_MASK;
+    if ( ptr_buff[ 1 ] != 0 )
+    {
+        samp_to_rd = HEARTRATE4_FIFO_DEPTH;
+    }
 
-    for ( cnt = 0; cnt < samp_to_rd; cnt++ )
+    if ( samp_to_rd != 0 )
     {
-        heartrate4_multi_read( ctx, HEARTRATE4_FIFO_DATA, tem_ptr, 9 );
-        tem_ptr+= 9;
+        wr_buff[ 0 ] = HEARTRATE4_FIFO_DATA;
+        i2c_master_write_then_read( &ctx->i2c, wr_buff, 1, buff, samp_to_rd * HEARTRATE4_FIFO_SAMPLE_SIZE );
     }
 
     return samp_to_rd;
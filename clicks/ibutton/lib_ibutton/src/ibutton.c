@@ -161,23 +161,19 @@ void ibutton_disable_green_led ( ibutton_t *ctx )
 
 static uint8_t ibutton_calculate_crc8 ( uint8_t *data_buf, uint8_t len )
 {
+    // CRC of each nibble value for reflected polynomial 0x8C, processed 4 bits at a time
+    static const uint8_t crc8_table[ 16 ] = 
+    {
+        0x00, 0x9D, 0x23, 0xBE, 0x46, 0xDB, 0x65, 0xF8,
+        0x8C, 0x11, 0xAF, 0x32, 0xCA, 0x57, 0xE9, 0x74
+    };
     uint8_t crc = 0;
     uint8_t byte_cnt = 0;
-    uint8_t bit_cnt = 0;
     for ( byte_cnt = 0; byte_cnt < len; byte_cnt++ ) 
     {
         crc ^= data_buf[ byte_cnt ];
-        for ( bit_cnt = 0; bit_cnt < 8; bit_cnt++ ) 
-        {
-            if ( crc & 0x01 ) 
-            {
-                crc = ( crc >> 1 ) ^ 0x8C;
-            }
-            else
-            {
-                crc >>= 1;
-            }
-        }
+        crc = ( crc >> 4 ) ^ crc8_table[ crc & 0x0F ];
+        crc = ( crc >> 4 ) ^ crc8_table[ crc & 0x0F ];
     }
     return crc;
 }
@@ -402,6 +402,21 @@ extern "C"{
 #define IPSDISPLAY_FONT_ASCII_OFFSET            32
 #define IPSDISPLAY_FONT_WIDTH_MSB               0x80
 
+/**
+ * @brief IPS Display scanline buffer setting.
+ * @details Specified setting for scanline buffer of IPS Display Click driver.
+ * @note Increase buffer size if needed, it must hold at least one row of the widest font.
+ */
+#define IPSDISPLAY_SCANLINE_PIXELS              32
+
+/**
+ * @brief IPS Display framebuffer setting.
+ * @details Specified setting for framebuffer dirty rectangle tracking of IPS Display Click driver.
+ * @note Increase the number of dirty rectangles if needed, when the list is full the
+ * new rectangle is merged with the closest tracked one.
+ */
+#define IPSDISPLAY_FB_MAX_DIRTY_RECTS           8
+
 /**
  * @brief IPS Display rotation setting.
  * @details Specified setting for rotation of IPS Display Click driver.
@@ -493,6 +508,38 @@ typedef struct
 
 } ipsdisplay_point_t;
 
+/**
+ * @brief IPS Display Click rectangle area object.
+ * @details Rectangle area object definition of IPS Display Click driver.
+ */
+typedef struct
+{
+    uint16_t x_start;               /**< Start X coordinate. */
+    uint16_t y_start;               /**< Start Y coordinate. */
+    uint16_t x_end;                 /**< End X coordinate (inclusive). */
+    uint16_t y_end;                 /**< End Y coordinate (inclusive). */
+
+} ipsdisplay_rect_t;
+
+/**
+ * @brief IPS Display Click framebuffer object.
+ * @details Framebuffer object definition of IPS Display Click driver.
+ * The framebuffer covers a rectangle region of the screen (the whole screen or a part of it)
+ * and is backed by a caller provided RGB565 buffer. Drawing into the framebuffer only marks
+ * the pixels that actually changed as dirty, and the flush function pushes the merged dirty
+ * rectangles to the display.
+ */
+typedef struct
+{
+    uint16_t *buf;                  /**< RGB565 pixel buffer of width * height pixels. */
+    ipsdisplay_point_t origin;      /**< Screen coordinates of the top-left framebuffer pixel. */
+    uint16_t width;                 /**< Framebuffer width in pixels. */
+    uint16_t height;                /**< Framebuffer height in pixels. */
+    ipsdisplay_rect_t dirty[ IPSDISPLAY_FB_MAX_DIRTY_RECTS ];    /**< Dirty rectangles in screen coordinates. */
+    uint8_t num_dirty;              /**< Number of dirty rectangles. */
+
+} ipsdisplay_fb_t;
+
 /**
  * @brief IPS Display Click context object.
  * @details Context object definition of IPS Display Click driver.
@@ -509,6 +556,7 @@ typedef struct
 
     uint8_t      rotation;          /**< Screen rotation settings. */
     ipsdisplay_font_t font;         /**< Font setting. */ 
+    uint8_t      scanline_buf[ IPSDISPLAY_SCANLINE_PIXELS * 2 ];  /**< Pre-expanded RGB565 scanline buffer. */
 
 } ipsdisplay_t;
 
@@ -744,6 +792,41 @@ err_t ipsdisplay_set_pos ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, ipsdi
  */
 err_t ipsdisplay_fill_screen ( ipsdisplay_t *ctx, uint16_t color );
 
+/**
+ * @brief IPS Display write color function.
+ * @details This function writes the same color to a desired number of pixels of the previously
+ * set display area in a single chip select burst.
+ * @param[in] ctx : Click context object.
+ * See #ipsdisplay_t object definition for detailed explanation.
+ * @param[in] color : RGB565 color.
+ * @param[in] num_pixels : Number of pixels to be written.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The display area must be set with #ipsdisplay_set_pos function first.
+ */
+err_t ipsdisplay_write_color ( ipsdisplay_t *ctx, uint16_t color, uint32_t num_pixels );
+
+/**
+ * @brief IPS Display fill rectangle function.
+ * @details This function fills a rectangle area with the selected color by setting the display
+ * area once and streaming all pixels in a single chip select burst. The rectangle is clipped
+ * to the display area and only a rectangle lying entirely outside of it is rejected.
+ * @param[in] ctx : Click context object.
+ * See #ipsdisplay_t object definition for detailed explanation.
+ * @param[in] start_pt : Start point coordinates.
+ * See #iipsdisplay_point_t object definition for detailed explanation.
+ * @param[in] end_pt : End point coordinates.
+ * See #iipsdisplay_point_t object definition for detailed explanation.
+ * @param[in] color : RGB565 color.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note X and Y are swapped in Horizontal display orientation.
+ */
+err_t ipsdisplay_fill_rectangle ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, 
+                                  ipsdisplay_point_t end_pt, uint16_t color );
+
 /**
  * @brief IPS Display write char function.
  * @details This function writes a single ASCII character on the selected position in configured font size
@@ -761,6 +844,26 @@ err_t ipsdisplay_fill_screen ( ipsdisplay_t *ctx, uint16_t color );
  */
 err_t ipsdisplay_write_char ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t data_in, uint16_t color );
 
+/**
+ * @brief IPS Display write char with background function.
+ * @details This function writes a single ASCII character on the selected position in configured font size
+ * with a specified color over a specified background color. The whole glyph cell is streamed
+ * in a single chip select burst.
+ * @param[in] ctx : Click context object.
+ * See #ipsdisplay_t object definition for detailed explanation.
+ * @param[in] start_pt : Start point coordinates.
+ * See #iipsdisplay_point_t object definition for detailed explanation.
+ * @param[in] data_in : ASCII(32-126) char to write.
+ * @param[in] color : RGB565 color.
+ * @param[in] bg_color : RGB565 background color.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t ipsdisplay_write_char_bg ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t data_in, 
+                                 uint16_t color, uint16_t bg_color );
+
 /**
  * @brief IPS Display write string function.
  * @details This function writes a text string starting from the selected position in configured font size
@@ -778,6 +881,25 @@ err_t ipsdisplay_write_char ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, ui
  */
 err_t ipsdisplay_write_string ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t *data_in, uint16_t color );
 
+/**
+ * @brief IPS Display write string with background function.
+ * @details This function writes a text string starting from the selected position in configured font size
+ * with a specified color over a specified background color.
+ * @param[in] ctx : Click context object.
+ * See #ipsdisplay_t object definition for detailed explanation.
+ * @param[in] start_pt : Start point coordinates.
+ * See #iipsdisplay_point_t object definition for detailed explanation.
+ * @param[in] data_in : ASCII(32-126) string to write (must end with \0).
+ * @param[in] color : RGB565 color.
+ * @param[in] bg_color : RGB565 background color.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t ipsdisplay_write_string_bg ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t *data_in, 
+                                   uint16_t color, uint16_t bg_color );
+
 /**
  * @brief IPS Display draw pixel function.
  * @details This function draws a pixel on the selected position with a specified color.
@@ -861,6 +983,89 @@ err_t ipsdisplay_draw_circle ( ipsdisplay_t *ctx, ipsdisplay_point_t center_pt,
  */
 err_t ipsdisplay_draw_picture ( ipsdisplay_t *ctx, uint8_t rotation, const uint16_t *image );
 
+/**
+ * @brief IPS Display framebuffer init function.
+ * @details This function initializes a framebuffer object covering the selected screen region,
+ * fills it with the selected color and marks the whole region as dirty.
+ * @param[out] fb : Framebuffer object.
+ * See #ipsdisplay_fb_t object definition for detailed explanation.
+ * @param[in] buf : RGB565 pixel buffer of at least width * height pixels.
+ * @param[in] origin : Screen coordinates of the top-left framebuffer pixel.
+ * See #ipsdisplay_point_t object definition for detailed explanation.
+ * @param[in] width : Framebuffer width in pixels.
+ * @param[in] height : Framebuffer height in pixels.
+ * @param[in] color : RGB565 initial color.
+ * @return None.
+ * @note The region coordinates must be given for the display rotation used when flushing.
+ */
+void ipsdisplay_fb_init ( ipsdisplay_fb_t *fb, uint16_t *buf, ipsdisplay_point_t origin, 
+                          uint16_t width, uint16_t height, uint16_t color );
+
+/**
+ * @brief IPS Display framebuffer draw pixel function.
+ * @details This function draws a pixel into the framebuffer and marks it dirty if its color changed.
+ * @param[in] fb : Framebuffer object.
+ * See #ipsdisplay_fb_t object definition for detailed explanation.
+ * @param[in] start_pt : Screen coordinates of the pixel.
+ * See #ipsdisplay_point_t object definition for detailed explanation.
+ * @param[in] color : RGB565 color.
+ * @return None.
+ * @note Pixels outside of the framebuffer region are ignored.
+ */
+void ipsdisplay_fb_draw_pixel ( ipsdisplay_fb_t *fb, ipsdisplay_point_t start_pt, uint16_t color );
+
+/**
+ * @brief IPS Display framebuffer fill rectangle function.
+ * @details This function fills a rectangle area of the framebuffer with the selected color and
+ * marks the bounding box of the changed pixels dirty.
+ * @param[in] fb : Framebuffer object.
+ * See #ipsdisplay_fb_t object definition for detailed explanation.
+ * @param[in] start_pt : Start point screen coordinates.
+ * See #ipsdisplay_point_t object definition for detailed explanation.
+ * @param[in] end_pt : End point screen coordinates.
+ * See #ipsdisplay_point_t object definition for detailed explanation.
+ * @param[in] color : RGB565 color.
+ * @return None.
+ * @note The area is clipped to the framebuffer region.
+ */
+void ipsdisplay_fb_fill_rectangle ( ipsdisplay_fb_t *fb, ipsdisplay_point_t start_pt, 
+                                    ipsdisplay_point_t end_pt, uint16_t color );
+
+/**
+ * @brief IPS Display framebuffer write string function.
+ * @details This function writes a text string into the framebuffer starting from the selected position
+ * in configured font size with a specified color over a specified background color.
+ * @param[in] ctx : Click context object.
+ * See #ipsdisplay_t object definition for detailed explanation.
+ * @param[in] fb : Framebuffer object.
+ * See #ipsdisplay_fb_t object definition for detailed explanation.
+ * @param[in] start_pt : Start point screen coordinates.
+ * See #ipsdisplay_point_t object definition for detailed explanation.
+ * @param[in] data_in : ASCII(32-126) string to write (must end with \0).
+ * @param[in] color : RGB565 color.
+ * @param[in] bg_color : RGB565 background color.
+ * @return None.
+ * @note Redrawing a changed value only marks the pixels that differ as dirty.
+ */
+void ipsdisplay_fb_write_string ( ipsdisplay_t *ctx, ipsdisplay_fb_t *fb, ipsdisplay_point_t start_pt, 
+                                  uint8_t *data_in, uint16_t color, uint16_t bg_color );
+
+/**
+ * @brief IPS Display framebuffer flush function.
+ * @details This function pushes all dirty rectangles of the framebuffer to the display, each one as
+ * a single display area set and data burst, and removes the written rectangles from the dirty list.
+ * On an error the rectangle being written and the ones after it are kept for the next flush.
+ * @param[in] ctx : Click context object.
+ * See #ipsdisplay_t object definition for detailed explanation.
+ * @param[in] fb : Framebuffer object.
+ * See #ipsdisplay_fb_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t ipsdisplay_fb_flush ( ipsdisplay_t *ctx, ipsdisplay_fb_t *fb );
+
 #ifdef __cplusplus
 }
 #endif
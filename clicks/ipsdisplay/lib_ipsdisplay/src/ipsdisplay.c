@@ -28,6 +28,22 @@
 #include "ipsdisplay.h"
 #include "ipsdisplay_resources.h"
 
+/**
+ * @brief IPS Display write text function.
+ * @details This function writes a text string with line wrapping, glyphs are drawn transparent
+ * if bg_color is NULL, otherwise each glyph cell is streamed as a single window burst.
+ */
+static err_t ipsdisplay_write_text ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t *data_in, 
+                                     uint16_t color, uint16_t *bg_color );
+
+/**
+ * @brief IPS Display framebuffer mark dirty function.
+ * @details This function adds a rectangle to the framebuffer dirty list, merging it with all
+ * overlapping or adjacent rectangles. If the list is full it is merged with the rectangle
+ * whose bounding box grows the least.
+ */
+static void ipsdisplay_fb_mark_dirty ( ipsdisplay_fb_t *fb, ipsdisplay_rect_t *rect );
+
 /**
  * @brief Dummy data.
  * @details Definition of dummy data.
@@ -190,11 +206,11 @@ err_t ipsdisplay_write_cmd_par ( ipsdisplay_t *ctx, uint8_t cmd, uint8_t *data_i
 {
     err_t error_flag = IPSDISPLAY_OK;
     error_flag |= ipsdisplay_write_cmd( ctx, cmd );
-    for ( uint8_t cnt = 0; ( cnt < len ) && ( NULL != data_in ); cnt++ )
+    if ( ( len > 0 ) && ( NULL != data_in ) )
     {
         digital_out_low ( &ctx->cs );
         ipsdisplay_enter_data_mode( ctx );
-        error_flag |= spi_master_write( &ctx->spi, &data_in[ cnt ], 1 );
+        error_flag |= spi_master_write( &ctx->spi, data_in, len );
         digital_out_high ( &ctx->cs );
     }
     return error_flag;
@@ -203,14 +219,50 @@ err_t ipsdisplay_write_cmd_par ( ipsdisplay_t *ctx, uint8_t cmd, uint8_t *data_i
 err_t ipsdisplay_write_data ( ipsdisplay_t *ctx, uint16_t *data_in, uint16_t len )
 {
     err_t error_flag = IPSDISPLAY_OK;
-    uint8_t data_buf[ 2 ] = { 0 };
+    uint16_t buf_cnt = 0;
     digital_out_low ( &ctx->cs );
     ipsdisplay_enter_data_mode( ctx );
     for ( uint16_t cnt = 0; cnt < len; cnt++ )
     {
-        data_buf[ 0 ] = ( uint8_t ) ( ( data_in[ cnt ] >> 8 ) & 0xFF );
-        data_buf[ 1 ] = ( uint8_t ) ( data_in[ cnt ] & 0xFF );
-        error_flag |= spi_master_write( &ctx->spi, data_buf, 2 );
+        ctx->scanline_buf[ buf_cnt++ ] = ( uint8_t ) ( ( data_in[ cnt ] >> 8 ) & 0xFF );
+        ctx->scanline_buf[ buf_cnt++ ] = ( uint8_t ) ( data_in[ cnt ] & 0xFF );
+        if ( buf_cnt >= sizeof ( ctx->scanline_buf ) )
+        {
+            error_flag |= spi_master_write( &ctx->spi, ctx->scanline_buf, buf_cnt );
+            buf_cnt = 0;
+        }
+    }
+    if ( buf_cnt > 0 )
+    {
+        error_flag |= spi_master_write( &ctx->spi, ctx->scanline_buf, buf_cnt );
+    }
+    digital_out_high ( &ctx->cs );
+    return error_flag;
+}
+
+err_t ipsdisplay_write_color ( ipsdisplay_t *ctx, uint16_t color, uint32_t num_pixels )
+{
+    err_t error_flag = IPSDISPLAY_OK;
+    uint16_t buf_len = IPSDISPLAY_SCANLINE_PIXELS;
+    if ( num_pixels < buf_len )
+    {
+        buf_len = ( uint16_t ) num_pixels;
+    }
+    for ( uint16_t cnt = 0; cnt < buf_len; cnt++ )
+    {
+        ctx->scanline_buf[ cnt * 2 ] = ( uint8_t ) ( ( color >> 8 ) & 0xFF );
+        ctx->scanline_buf[ cnt * 2 + 1 ] = ( uint8_t ) ( color & 0xFF );
+    }
+    digital_out_low ( &ctx->cs );
+    ipsdisplay_enter_data_mode( ctx );
+    while ( num_pixels > 0 )
+    {
+        if ( num_pixels < buf_len )
+        {
+            buf_len = ( uint16_t ) num_pixels;
+        }
+        error_flag |= spi_master_write( &ctx->spi, ctx->scanline_buf, buf_len * 2 );
+        num_pixels -= buf_len;
     }
     digital_out_high ( &ctx->cs );
     return error_flag;
@@ -368,7 +420,6 @@ err_t ipsdisplay_set_pos ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, ipsdi
 
 err_t ipsdisplay_fill_screen ( ipsdisplay_t *ctx, uint16_t color )
 {
-    err_t error_flag = IPSDISPLAY_OK;
     ipsdisplay_point_t start_pt, end_pt;
     start_pt.x = IPSDISPLAY_POS_HEIGHT_MIN;
     start_pt.y = IPSDISPLAY_POS_WIDTH_MIN;
@@ -382,10 +433,58 @@ err_t ipsdisplay_fill_screen ( ipsdisplay_t *ctx, uint16_t color )
         end_pt.x = IPSDISPLAY_POS_WIDTH_MAX;
         end_pt.y = IPSDISPLAY_POS_HEIGHT_MAX;
     }
+    return ipsdisplay_fill_rectangle ( ctx, start_pt, end_pt, color );
+}
+
+err_t ipsdisplay_fill_rectangle ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, 
+                                  ipsdisplay_point_t end_pt, uint16_t color )
+{
+    err_t error_flag = IPSDISPLAY_OK;
+    uint32_t num_pixels = 0;
+    uint16_t tmp_pos = 0;
+    uint16_t x_max = 0;
+    uint16_t y_max = 0;
+    if ( start_pt.x > end_pt.x )
+    {
+        tmp_pos = start_pt.x;
+        start_pt.x = end_pt.x;
+        end_pt.x = tmp_pos;
+    }
+    if ( start_pt.y > end_pt.y )
+    {
+        tmp_pos = start_pt.y;
+        start_pt.y = end_pt.y;
+        end_pt.y = tmp_pos;
+    }
+    // Clip to the panel so partially visible shapes are still drawn
+    if ( ( IPSDISPLAY_ROTATION_VERTICAL_0 == ctx->rotation ) || 
+         ( IPSDISPLAY_ROTATION_VERTICAL_180 == ctx->rotation ) )
+    {
+        x_max = IPSDISPLAY_POS_WIDTH_MAX;
+        y_max = IPSDISPLAY_POS_HEIGHT_MAX;
+    }
+    else
+    {
+        x_max = IPSDISPLAY_POS_HEIGHT_MAX;
+        y_max = IPSDISPLAY_POS_WIDTH_MAX;
+    }
+    if ( ( start_pt.x > x_max ) || ( start_pt.y > y_max ) )
+    {
+        return IPSDISPLAY_ERROR;
+    }
+    if ( end_pt.x > x_max )
+    {
+        end_pt.x = x_max;
+    }
+    if ( end_pt.y > y_max )
+    {
+        end_pt.y = y_max;
+    }
     error_flag |= ipsdisplay_set_pos ( ctx, start_pt, end_pt );
-    for ( uint16_t cnt = 0; cnt < IPSDISPLAY_NUM_PIXELS; cnt++ )
+    if ( IPSDISPLAY_OK == error_flag )
     {
-        error_flag |= ipsdisplay_write_data ( ctx, &color, 1 );
+        num_pixels = ( uint32_t ) ( end_pt.x - start_pt.x + 1 ) * ( end_pt.y - start_pt.y + 1 );
+        error_flag |= ipsdisplay_write_color ( ctx, color, num_pixels );
     }
     return error_flag;
 }
@@ -393,19 +492,32 @@ err_t ipsdisplay_fill_screen ( ipsdisplay_t *ctx, uint16_t color )
 err_t ipsdisplay_write_char ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t data_in, uint16_t color )
 {
     err_t error_flag = IPSDISPLAY_OK;
-    ipsdisplay_point_t point;
+    ipsdisplay_point_t run_start, run_end;
     uint16_t font_pos = ( data_in - IPSDISPLAY_FONT_ASCII_OFFSET ) * ctx->font.height * ( ( ( ctx->font.width - 1 ) / 8 ) + 1 );
     uint8_t h_cnt = 0;
     uint8_t w_cnt = 0;
     for ( h_cnt = 0; h_cnt < ctx->font.height; h_cnt++ )
     {
-        for ( w_cnt = 0; w_cnt < ctx->font.width; w_cnt++ )
+        w_cnt = 0;
+        while ( w_cnt < ctx->font.width )
         {
             if ( ctx->font.font_buf[ font_pos + ( w_cnt / 8 ) ] & ( IPSDISPLAY_FONT_WIDTH_MSB >> ( w_cnt % 8 ) ) )
             {
-                point.x = start_pt.x + w_cnt;
-                point.y = start_pt.y + h_cnt;
-                error_flag |= ipsdisplay_draw_pixel ( ctx, point, color );
+                // Write the whole horizontal run of set bits in a single window
+                run_start.x = start_pt.x + w_cnt;
+                run_start.y = start_pt.y + h_cnt;
+                while ( ( w_cnt < ctx->font.width ) && 
+                        ( ctx->font.font_buf[ font_pos + ( w_cnt / 8 ) ] & ( IPSDISPLAY_FONT_WIDTH_MSB >> ( w_cnt % 8 ) ) ) )
+                {
+                    w_cnt++;
+                }
+                run_end.x = start_pt.x + w_cnt - 1;
+                run_end.y = run_start.y;
+                error_flag |= ipsdisplay_fill_rectangle ( ctx, run_start, run_end, color );
+            }
+            else
+            {
+                w_cnt++;
             }
         }
         font_pos = font_pos + ( ( w_cnt - 1 ) / 8 ) + 1;
@@ -413,45 +525,58 @@ err_t ipsdisplay_write_char ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, ui
     return error_flag;
 }
 
-err_t ipsdisplay_write_string ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t *data_in, uint16_t color )
+err_t ipsdisplay_write_char_bg ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t data_in, 
+                                 uint16_t color, uint16_t bg_color )
 {
     err_t error_flag = IPSDISPLAY_OK;
-    ipsdisplay_point_t point;
-    point.x = start_pt.x;
-    point.y = start_pt.y;
-    for ( uint16_t char_cnt = 0; char_cnt < strlen ( ( char * ) data_in ); char_cnt++ )
+    ipsdisplay_point_t end_pt;
+    uint16_t font_pos = ( data_in - IPSDISPLAY_FONT_ASCII_OFFSET ) * ctx->font.height * ( ( ( ctx->font.width - 1 ) / 8 ) + 1 );
+    uint16_t px_color = 0;
+    uint8_t h_cnt = 0;
+    uint8_t w_cnt = 0;
+    if ( ctx->font.width > IPSDISPLAY_SCANLINE_PIXELS )
     {
-        if ( ( IPSDISPLAY_ROTATION_VERTICAL_0 == ctx->rotation ) || 
-             ( IPSDISPLAY_ROTATION_VERTICAL_180 == ctx->rotation ) )
-        {
-            if ( point.x > ( IPSDISPLAY_POS_WIDTH_MAX - ctx->font.width ) )
-            {
-                point.x = IPSDISPLAY_POS_WIDTH_MIN;
-                point.y += ctx->font.height;
-            }
-            if ( point.y > ( IPSDISPLAY_POS_HEIGHT_MAX - ctx->font.height ) )
-            {
-                point.y = IPSDISPLAY_POS_HEIGHT_MIN;
-            }
-        }
-        else
+        return IPSDISPLAY_ERROR;
+    }
+    end_pt.x = start_pt.x + ctx->font.width - 1;
+    end_pt.y = start_pt.y + ctx->font.height - 1;
+    error_flag |= ipsdisplay_set_pos ( ctx, start_pt, end_pt );
+    if ( IPSDISPLAY_OK != error_flag )
+    {
+        return error_flag;
+    }
+    digital_out_low ( &ctx->cs );
+    ipsdisplay_enter_data_mode( ctx );
+    for ( h_cnt = 0; h_cnt < ctx->font.height; h_cnt++ )
+    {
+        for ( w_cnt = 0; w_cnt < ctx->font.width; w_cnt++ )
         {
-            if ( point.x > ( IPSDISPLAY_POS_HEIGHT_MAX - ctx->font.width ) )
-            {
-                point.x = IPSDISPLAY_POS_HEIGHT_MIN;
-                point.y += ctx->font.height;
-            }
-            if ( point.y > ( IPSDISPLAY_POS_WIDTH_MAX - ctx->font.height ) )
+            px_color = bg_color;
+            if ( ctx->font.font_buf[ font_pos + ( w_cnt / 8 ) ] & ( IPSDISPLAY_FONT_WIDTH_MSB >> ( w_cnt % 8 ) ) )
             {
-                point.y = IPSDISPLAY_POS_WIDTH_MIN;
+                px_color = color;
             }
+            ctx->scanline_buf[ w_cnt * 2 ] = ( uint8_t ) ( ( px_color >> 8 ) & 0xFF );
+            ctx->scanline_buf[ w_cnt * 2 + 1 ] = ( uint8_t ) ( px_color & 0xFF );
         }
-        error_flag |= ipsdisplay_write_char ( ctx, point, data_in[ char_cnt ], color );
-        point.x += ( ctx->font.width + IPSDISPLAY_FONT_TEXT_SPACE );
+        error_flag |= spi_master_write( &ctx->spi, ctx->scanline_buf, ctx->font.width * 2 );
+        font_pos = font_pos + ( ( w_cnt - 1 ) / 8 ) + 1;
     }
+    digital_out_high ( &ctx->cs );
     return error_flag;
 }
 
+err_t ipsdisplay_write_string ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t *data_in, uint16_t color )
+{
+    return ipsdisplay_write_text ( ctx, start_pt, data_in, color, NULL );
+}
+
+err_t ipsdisplay_write_string_bg ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t *data_in, 
+                                   uint16_t color, uint16_t bg_color )
+{
+    return ipsdisplay_write_text ( ctx, start_pt, data_in, color, &bg_color );
+}
+
 err_t ipsdisplay_draw_pixel ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint16_t color )
 {
     err_t error_flag = IPSDISPLAY_OK;
@@ -478,6 +603,12 @@ err_t ipsdisplay_draw_line ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt,
     point.x = start_pt.x;
     point.y = start_pt.y;
 
+    if ( ( start_pt.x == end_pt.x ) || ( start_pt.y == end_pt.y ) )
+    {
+        // Horizontal and vertical lines are a single window burst
+        return ipsdisplay_fill_rectangle ( ctx, start_pt, end_pt, color );
+    }
+
     if ( delta_x > 0 ) 
     {
         incx = 1;
@@ -599,7 +730,7 @@ err_t ipsdisplay_draw_picture ( ipsdisplay_t *ctx, uint8_t rotation, const uint1
 {
     err_t error_flag = IPSDISPLAY_OK;
     ipsdisplay_point_t start_pt, end_pt;
-    uint8_t data_buf[ 2 ] = { 0 };
+    uint16_t buf_cnt = 0;
     uint8_t old_rotation = ctx->rotation;
     error_flag |= ipsdisplay_set_rotation ( ctx, rotation );
     start_pt.x = IPSDISPLAY_POS_HEIGHT_MIN;
@@ -619,13 +750,332 @@ err_t ipsdisplay_draw_picture ( ipsdisplay_t *ctx, uint8_t rotation, const uint1
     ipsdisplay_enter_data_mode( ctx );
     for ( uint16_t cnt = 0; cnt < IPSDISPLAY_NUM_PIXELS; cnt++ )
     {
-        data_buf[ 0 ] = ( uint8_t ) ( ( image[ cnt ] >> 8 ) & 0xFF );
-        data_buf[ 1 ] = ( uint8_t ) ( image[ cnt ] & 0xFF );
-        error_flag |= spi_master_write( &ctx->spi, data_buf, 2 );
+        ctx->scanline_buf[ buf_cnt++ ] = ( uint8_t ) ( ( image[ cnt ] >> 8 ) & 0xFF );
+        ctx->scanline_buf[ buf_cnt++ ] = ( uint8_t ) ( image[ cnt ] & 0xFF );
+        if ( buf_cnt >= sizeof ( ctx->scanline_buf ) )
+        {
+            error_flag |= spi_master_write( &ctx->spi, ctx->scanline_buf, buf_cnt );
+            buf_cnt = 0;
+        }
+    }
+    if ( buf_cnt > 0 )
+    {
+        error_flag |= spi_master_write( &ctx->spi, ctx->scanline_buf, buf_cnt );
     }
     digital_out_high ( &ctx->cs );
     error_flag |= ipsdisplay_set_rotation ( ctx, old_rotation );
     return error_flag;
 }
 
+void ipsdisplay_fb_init ( ipsdisplay_fb_t *fb, uint16_t *buf, ipsdisplay_point_t origin, 
+                          uint16_t width, uint16_t height, uint16_t color )
+{
+    ipsdisplay_rect_t rect;
+    fb->buf = buf;
+    fb->origin.x = origin.x;
+    fb->origin.y = origin.y;
+    fb->width = width;
+    fb->height = height;
+    fb->num_dirty = 0;
+    for ( uint32_t cnt = 0; cnt < ( ( uint32_t ) width * height ); cnt++ )
+    {
+        fb->buf[ cnt ] = color;
+    }
+    rect.x_start = origin.x;
+    rect.y_start = origin.y;
+    rect.x_end = origin.x + width - 1;
+    rect.y_end = origin.y + height - 1;
+    ipsdisplay_fb_mark_dirty ( fb, &rect );
+}
+
+void ipsdisplay_fb_draw_pixel ( ipsdisplay_fb_t *fb, ipsdisplay_point_t start_pt, uint16_t color )
+{
+    ipsdisplay_fb_fill_rectangle ( fb, start_pt, start_pt, color );
+}
+
+void ipsdisplay_fb_fill_rectangle ( ipsdisplay_fb_t *fb, ipsdisplay_point_t start_pt, 
+                                    ipsdisplay_point_t end_pt, uint16_t color )
+{
+    ipsdisplay_rect_t changed;
+    uint16_t tmp_pos = 0;
+    uint16_t *row = NULL;
+    uint8_t is_changed = 0;
+    if ( start_pt.x > end_pt.x )
+    {
+        tmp_pos = start_pt.x;
+        start_pt.x = end_pt.x;
+        end_pt.x = tmp_pos;
+    }
+    if ( start_pt.y > end_pt.y )
+    {
+        tmp_pos = start_pt.y;
+        start_pt.y = end_pt.y;
+        end_pt.y = tmp_pos;
+    }
+    if ( ( end_pt.x < fb->origin.x ) || ( end_pt.y < fb->origin.y ) || 
+         ( start_pt.x >= ( fb->origin.x + fb->width ) ) || ( start_pt.y >= ( fb->origin.y + fb->height ) ) )
+    {
+        return;
+    }
+    if ( start_pt.x < fb->origin.x )
+    {
+        start_pt.x = fb->origin.x;
+    }
+    if ( start_pt.y < fb->origin.y )
+    {
+        start_pt.y = fb->origin.y;
+    }
+    if ( end_pt.x >= ( fb->origin.x + fb->width ) )
+    {
+        end_pt.x = fb->origin.x + fb->width - 1;
+    }
+    if ( end_pt.y >= ( fb->origin.y + fb->height ) )
+    {
+        end_pt.y = fb->origin.y + fb->height - 1;
+    }
+    changed.x_start = end_pt.x;
+    changed.y_start = end_pt.y;
+    changed.x_end = start_pt.x;
+    changed.y_end = start_pt.y;
+    for ( uint16_t y_pos = start_pt.y; y_pos <= end_pt.y; y_pos++ )
+    {
+        row = &fb->buf[ ( uint32_t ) ( y_pos - fb->origin.y ) * fb->width ];
+        for ( uint16_t x_pos = start_pt.x; x_pos <= end_pt.x; x_pos++ )
+        {
+            if ( row[ x_pos - fb->origin.x ] != color )
+            {
+                row[ x_pos - fb->origin.x ] = color;
+                is_changed = 1;
+                if ( x_pos < changed.x_start )
+                {
+                    changed.x_start = x_pos;
+                }
+                if ( x_pos > changed.x_end )
+                {
+                    changed.x_end = x_pos;
+                }
+                if ( y_pos < changed.y_start )
+                {
+                    changed.y_start = y_pos;
+                }
+                changed.y_end = y_pos;
+            }
+        }
+    }
+    if ( is_changed )
+    {
+        ipsdisplay_fb_mark_dirty ( fb, &changed );
+    }
+}
+
+void ipsdisplay_fb_write_string ( ipsdisplay_t *ctx, ipsdisplay_fb_t *fb, ipsdisplay_point_t start_pt, 
+                                  uint8_t *data_in, uint16_t color, uint16_t bg_color )
+{
+    ipsdisplay_point_t run_start, run_end;
+    uint16_t font_pos = 0;
+    uint8_t run_bit = 0;
+    uint8_t h_cnt = 0;
+    uint8_t w_cnt = 0;
+    for ( uint16_t char_cnt = 0; data_in[ char_cnt ]; char_cnt++ )
+    {
+        font_pos = ( data_in[ char_cnt ] - IPSDISPLAY_FONT_ASCII_OFFSET ) * ctx->font.height * 
+                   ( ( ( ctx->font.width - 1 ) / 8 ) + 1 );
+        for ( h_cnt = 0; h_cnt < ctx->font.height; h_cnt++ )
+        {
+            w_cnt = 0;
+            while ( w_cnt < ctx->font.width )
+            {
+                // Fill each run of equal glyph bits as a single span
+                run_bit = !!( ctx->font.font_buf[ font_pos + ( w_cnt / 8 ) ] & ( IPSDISPLAY_FONT_WIDTH_MSB >> ( w_cnt % 8 ) ) );
+                run_start.x = start_pt.x + w_cnt;
+                run_start.y = start_pt.y + h_cnt;
+                while ( ( w_cnt < ctx->font.width ) && ( run_bit == 
+                        !!( ctx->font.font_buf[ font_pos + ( w_cnt / 8 ) ] & ( IPSDISPLAY_FONT_WIDTH_MSB >> ( w_cnt % 8 ) ) ) ) )
+                {
+                    w_cnt++;
+                }
+                run_end.x = start_pt.x + w_cnt - 1;
+                run_end.y = run_start.y;
+                ipsdisplay_fb_fill_rectangle ( fb, run_start, run_end, run_bit ? color : bg_color );
+            }
+            font_pos = font_pos + ( ( w_cnt - 1 ) / 8 ) + 1;
+        }
+        start_pt.x += ( ctx->font.width + IPSDISPLAY_FONT_TEXT_SPACE );
+    }
+}
+
+err_t ipsdisplay_fb_flush ( ipsdisplay_t *ctx, ipsdisplay_fb_t *fb )
+{
+    err_t error_flag = IPSDISPLAY_OK;
+    ipsdisplay_point_t start_pt, end_pt;
+    ipsdisplay_rect_t *rect = NULL;
+    uint16_t *row = NULL;
+    uint16_t buf_cnt = 0;
+    uint8_t rect_cnt = 0;
+    for ( rect_cnt = 0; rect_cnt < fb->num_dirty; rect_cnt++ )
+    {
+        rect = &fb->dirty[ rect_cnt ];
+        start_pt.x = rect->x_start;
+        start_pt.y = rect->y_start;
+        end_pt.x = rect->x_end;
+        end_pt.y = rect->y_end;
+        error_flag |= ipsdisplay_set_pos ( ctx, start_pt, end_pt );
+        if ( IPSDISPLAY_OK != error_flag )
+        {
+            break;
+        }
+        digital_out_low ( &ctx->cs );
+        ipsdisplay_enter_data_mode( ctx );
+        buf_cnt = 0;
+        for ( uint16_t y_pos = rect->y_start; y_pos <= rect->y_end; y_pos++ )
+        {
+            row = &fb->buf[ ( uint32_t ) ( y_pos - fb->origin.y ) * fb->width ];
+            for ( uint16_t x_pos = rect->x_start; x_pos <= rect->x_end; x_pos++ )
+            {
+                ctx->scanline_buf[ buf_cnt++ ] = ( uint8_t ) ( ( row[ x_pos - fb->origin.x ] >> 8 ) & 0xFF );
+                ctx->scanline_buf[ buf_cnt++ ] = ( uint8_t ) ( row[ x_pos - fb->origin.x ] & 0xFF );
+                if ( buf_cnt >= sizeof ( ctx->scanline_buf ) )
+                {
+                    error_flag |= spi_master_write( &ctx->spi, ctx->scanline_buf, buf_cnt );
+                    buf_cnt = 0;
+                }
+            }
+        }
+        if ( buf_cnt > 0 )
+        {
+            error_flag |= spi_master_write( &ctx->spi, ctx->scanline_buf, buf_cnt );
+        }
+        digital_out_high ( &ctx->cs );
+        if ( IPSDISPLAY_OK != error_flag )
+        {
+            break;
+        }
+    }
+    // Keep the rectangles that were not written so the next flush retries them
+    for ( uint8_t keep_cnt = rect_cnt; keep_cnt < fb->num_dirty; keep_cnt++ )
+    {
+        fb->dirty[ keep_cnt - rect_cnt ] = fb->dirty[ keep_cnt ];
+    }
+    fb->num_dirty -= rect_cnt;
+    return error_flag;
+}
+
+static err_t ipsdisplay_write_text ( ipsdisplay_t *ctx, ipsdisplay_point_t start_pt, uint8_t *data_in, 
+                                     uint16_t color, uint16_t *bg_color )
+{
+    err_t error_flag = IPSDISPLAY_OK;
+    ipsdisplay_point_t point;
+    point.x = start_pt.x;
+    point.y = start_pt.y;
+    for ( uint16_t char_cnt = 0; char_cnt < strlen ( ( char * ) data_in ); char_cnt++ )
+    {
+        if ( ( IPSDISPLAY_ROTATION_VERTICAL_0 == ctx->rotation ) || 
+             ( IPSDISPLAY_ROTATION_VERTICAL_180 == ctx->rotation ) )
+        {
+            if ( point.x > ( IPSDISPLAY_POS_WIDTH_MAX - ctx->font.width ) )
+            {
+                point.x = IPSDISPLAY_POS_WIDTH_MIN;
+                point.y += ctx->font.height;
+            }
+            if ( point.y > ( IPSDISPLAY_POS_HEIGHT_MAX - ctx->font.height ) )
+            {
+                point.y = IPSDISPLAY_POS_HEIGHT_MIN;
+            }
+        }
+        else
+        {
+            if ( point.x > ( IPSDISPLAY_POS_HEIGHT_MAX - ctx->font.width ) )
+            {
+                point.x = IPSDISPLAY_POS_HEIGHT_MIN;
+                point.y += ctx->font.height;
+            }
+            if ( point.y > ( IPSDISPLAY_POS_WIDTH_MAX - ctx->font.height ) )
+            {
+                point.y = IPSDISPLAY_POS_WIDTH_MIN;
+            }
+        }
+        if ( NULL != bg_color )
+        {
+            error_flag |= ipsdisplay_write_char_bg ( ctx, point, data_in[ char_cnt ], color, *bg_color );
+        }
+        else
+        {
+            error_flag |= ipsdisplay_write_char ( ctx, point, data_in[ char_cnt ], color );
+        }
+        point.x += ( ctx->font.width + IPSDISPLAY_FONT_TEXT_SPACE );
+    }
+    return error_flag;
+}
+
+static void ipsdisplay_fb_mark_dirty ( ipsdisplay_fb_t *fb, ipsdisplay_rect_t *rect )
+{
+    ipsdisplay_rect_t merged;
+    ipsdisplay_rect_t *dirty = NULL;
+    uint32_t area = 0;
+    uint32_t best_area = 0xFFFFFFFFul;
+    uint8_t best_idx = 0;
+    uint8_t rect_cnt = 0;
+    merged.x_start = rect->x_start;
+    merged.y_start = rect->y_start;
+    merged.x_end = rect->x_end;
+    merged.y_end = rect->y_end;
+    while ( rect_cnt < fb->num_dirty )
+    {
+        dirty = &fb->dirty[ rect_cnt ];
+        // Merge overlapping or touching rectangles and rescan the list with the grown one
+        if ( ( merged.x_start <= ( dirty->x_end + 1 ) ) && ( dirty->x_start <= ( merged.x_end + 1 ) ) && 
+             ( merged.y_start <= ( dirty->y_end + 1 ) ) && ( dirty->y_start <= ( merged.y_end + 1 ) ) )
+        {
+            if ( dirty->x_start < merged.x_start )
+            {
+                merged.x_start = dirty->x_start;
+            }
+            if ( dirty->y_start < merged.y_start )
+            {
+                merged.y_start = dirty->y_start;
+            }
+            if ( dirty->x_end > merged.x_end )
+            {
+                merged.x_end = dirty->x_end;
+            }
+            if ( dirty->y_end > merged.y_end )
+            {
+                merged.y_end = dirty->y_end;
+            }
+            fb->num_dirty--;
+            fb->dirty[ rect_cnt ] = fb->dirty[ fb->num_dirty ];
+            rect_cnt = 0;
+        }
+        else
+        {
+            rect_cnt++;
+        }
+    }
+    if ( fb->num_dirty >= IPSDISPLAY_FB_MAX_DIRTY_RECTS )
+    {
+        for ( rect_cnt = 0; rect_cnt < fb->num_dirty; rect_cnt++ )
+        {
+            dirty = &fb->dirty[ rect_cnt ];
+            area = ( uint32_t ) ( ( ( dirty->x_end > merged.x_end ) ? dirty->x_end : merged.x_end ) - 
+                                  ( ( dirty->x_start < merged.x_start ) ? dirty->x_start : merged.x_start ) + 1 ) * 
+                   ( ( ( dirty->y_end > merged.y_end ) ? dirty->y_end : merged.y_end ) - 
+                     ( ( dirty->y_start < merged.y_start ) ? dirty->y_start : merged.y_start ) + 1 );
+            if ( area < best_area )
+            {
+                best_area = area;
+                best_idx = rect_cnt;
+            }
+        }
+        fb->num_dirty--;
+        merged.x_start = ( fb->dirty[ best_idx ].x_start < merged.x_start ) ? fb->dirty[ best_idx ].x_start : merged.x_start;
+        merged.y_start = ( fb->dirty[ best_idx ].y_start < merged.y_start ) ? fb->dirty[ best_idx ].y_start : merged.y_start;
+        merged.x_end = ( fb->dirty[ best_idx ].x_end > merged.x_end ) ? fb->dirty[ best_idx ].x_end : merged.x_end;
+        merged.y_end = ( fb->dirty[ best_idx ].y_end > merged.y_end ) ? fb->dirty[ best_idx ].y_end : merged.y_end;
+        fb->dirty[ best_idx ] = fb->dirty[ fb->num_dirty ];
+        ipsdisplay_fb_mark_dirty ( fb, &merged );
+        return;
+    }
+    fb->dirty[ fb->num_dirty++ ] = merged;
+}
+
 // ------------------------------------------------------------------------- END
@@ -128,6 +128,7 @@ typedef struct
     float cp_alpha[ 2 ];
     int16_t cp_offset[ 2 ];
     float il_chess_c[ 3 ];
+    float alpha_corr_r[ 4 ];
     uint16_t broken_pixels[ 5 ];
     uint16_t outlier_pixels[ 5 ];
 } irgrid3_params_t;
@@ -424,6 +425,24 @@ float irgrid3_get_vdd ( irgrid3_t *ctx, uint16_t *frame_data );
  */
 void irgrid3_calculate_temp_obj ( irgrid3_t *ctx, uint16_t *frame_data, float tr_data, float *px_matrix );
 
+/**
+ * @brief Function for calculating temperature objects using the fast path.
+ * @details This function calculates the same temperature objects as
+ * #irgrid3_calculate_temp_obj using single precision arithmetic only. All frame
+ * constants are computed once per subpage, the range correction constants are
+ * taken from the parameters extracted by #irgrid3_extract_parameters and the
+ * fourth roots use a Newton refined approximation instead of pow.
+ * @param[in] ctx : Click context object.
+ * See #irgrid3_t object definition for detailed explanation.
+ * @param[in] frame_data : Frame Data
+ * @param[in] tr_data : Real temperature
+ * @param[out] px_matrix : Buffer in which the result of the calculation will be stored
+ * @return Nothing.
+ * @note The result differs from the reference path by less than 0.01 degrees Celsius
+ * over the -40 to 300 degrees Celsius object range.
+ */
+void irgrid3_calculate_temp_obj_fast ( irgrid3_t *ctx, uint16_t *frame_data, float tr_data, float *px_matrix );
+
 /**
  * @brief Function for getting Image.
  * @details This function is used for getting Image.
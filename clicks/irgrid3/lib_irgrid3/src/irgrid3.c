@@ -50,6 +50,8 @@ static void extract_cp_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data );
 static void extract_cilc_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data );
 static uint8_t extract_deviating_pixels ( irgrid3_t *ctx, uint16_t *eeprom_data );
 static float gain_calculation ( irgrid3_t *ctx, uint16_t raw_gain );
+static float pow_2 ( uint8_t exponent );
+static float root_4 ( float value );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -147,6 +149,11 @@ uint8_t irgrid3_extract_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data ) {
         extract_cp_parameters( ctx, eeprom_data );
         extract_cilc_parameters( ctx, eeprom_data );
         error = extract_deviating_pixels( ctx, eeprom_data );
+
+        ctx->params.alpha_corr_r[ 0 ] = 1 / ( 1 + ctx->params.ks_to[ 0 ] * 40 );
+        ctx->params.alpha_corr_r[ 1 ] = 1;
+        ctx->params.alpha_corr_r[ 2 ] = ( 1 + ctx->params.ks_to[ 2 ] * ctx->params.ct[ 2 ] );
+        ctx->params.alpha_corr_r[ 3 ] = ctx->params.alpha_corr_r[ 2 ] * ( 1 + ctx->params.ks_to[ 3 ] * ( ctx->params.ct[ 3 ] - ctx->params.ct[ 2 ] ) );
     }
     return error;
 }
@@ -279,7 +286,7 @@ float irgrid3_get_temp_ambient ( irgrid3_t *ctx, uint16_t *frame_data ) {
     if ( raw_ptat_art > 32767 ) {
         raw_ptat_art = raw_ptat_art - 65536;
     }
-    raw_ptat_art = ( raw_ptat / ( raw_ptat * ctx->params.alpha_ptat + raw_ptat_art ) ) * pow( 2, 18 );
+    raw_ptat_art = ( raw_ptat / ( raw_ptat * ctx->params.alpha_ptat + raw_ptat_art ) ) * 262144.0f;
 
     // Temperature ambient
 
@@ -304,7 +311,7 @@ float irgrid3_get_vdd ( irgrid3_t *ctx, uint16_t *frame_data ) {
     }
 
     resolution_ram = ( frame_data[ 832 ] & 0x0C00 ) >> 10;
-    resolution_correction = pow( 2, ( double )ctx->params.resolution_eeprom ) / pow( 2, ( double )resolution_ram );
+    resolution_correction = pow_2( ctx->params.resolution_eeprom ) / pow_2( resolution_ram );
 
     vdd = ( resolution_correction * vdd - ctx->params.vdd_25 ) / ctx->params.k_vdd + 3.3;
 
@@ -424,6 +431,120 @@ void irgrid3_calculate_temp_obj ( irgrid3_t *ctx, uint16_t *frame_data, float tr
     }
 }
 
+void irgrid3_calculate_temp_obj_fast ( irgrid3_t *ctx, uint16_t *frame_data, float tr_data, float *px_matrix ) {
+    float gain;
+    uint16_t sub_page;
+    float raw_vdd;
+    float raw_ta;
+    float raw_ta_4;
+    float raw_tr_4;
+    float raw_ta_tr;
+    float ir_data_cp;
+    float ir_data;
+    float alpha_compensated;
+    float alpha_cp;
+    float ks_ta_corr;
+    float ks_to_corr;
+    float d_ta;
+    float d_vdd;
+    float il_chess_corr[ 2 ];
+    float raw_sx;
+    float raw_to;
+    uint8_t mode;
+    uint8_t calibrated_mode;
+    int8_t il_pattern;
+    int8_t pattern;
+    int8_t conversion_pattern;
+    int8_t range;
+    int px_number;
+
+    // Frame constants
+
+    sub_page = frame_data[ 833 ];
+
+    raw_vdd = irgrid3_get_vdd( ctx, frame_data );
+    raw_ta = irgrid3_get_temp_ambient( ctx, frame_data );
+    d_ta = raw_ta - 25.0f;
+    d_vdd = raw_vdd - 3.3f;
+    raw_ta_4 = raw_ta + 273.15f;
+    raw_ta_4 *= raw_ta_4;
+    raw_ta_4 *= raw_ta_4;
+    raw_tr_4 = tr_data + 273.15f;
+    raw_tr_4 *= raw_tr_4;
+    raw_tr_4 *= raw_tr_4;
+    raw_ta_tr = raw_tr_4 - ( raw_tr_4 - raw_ta_4 ) / 0.95f;
+
+    gain = gain_calculation( ctx, frame_data[ 778 ] );
+
+    mode = ( frame_data[ 832 ] & 0x1000 ) >> 5;
+    calibrated_mode = ( mode == ctx->params.calibration_mode_eeprom );
+
+    ir_data_cp = ( int16_t )frame_data[ 776 + 32 * sub_page ];
+    ir_data_cp = ir_data_cp * gain;
+    if ( ( sub_page == 0 ) || calibrated_mode ) {
+        ir_data_cp = ir_data_cp - ctx->params.cp_offset[ sub_page ] * ( 1 + ctx->params.cp_kta * d_ta ) * ( 1 + ctx->params.cp_kv * d_vdd );
+    } else {
+        ir_data_cp = ir_data_cp - ( ctx->params.cp_offset[ 1 ] + ctx->params.il_chess_c[ 0 ] ) * ( 1 + ctx->params.cp_kta * d_ta ) * ( 1 + ctx->params.cp_kv * d_vdd );
+    }
+    ir_data_cp = ctx->params.tgc * ir_data_cp;
+
+    alpha_cp = ctx->params.tgc * ctx->params.cp_alpha[ sub_page ];
+    ks_ta_corr = 1 + ctx->params.ks_ta * d_ta;
+    ks_to_corr = 1 - ctx->params.ks_to[ 1 ] * 273.15f;
+    il_chess_corr[ 0 ] = -ctx->params.il_chess_c[ 2 ];
+    il_chess_corr[ 1 ] = ctx->params.il_chess_c[ 2 ];
+
+    // Temperature object calculation
+
+    for ( px_number = 0; px_number < 768; px_number++ ) {
+        il_pattern = ( px_number >> 5 ) & 1;
+
+        if ( mode == 0 ) {
+            pattern = il_pattern;
+        } else {
+            pattern = il_pattern ^ ( px_number & 1 );
+        }
+
+        if ( pattern == sub_page ) {
+            ir_data = ( int16_t )frame_data[ px_number ];
+            ir_data = ir_data * gain;
+
+            ir_data = ir_data - ctx->params.offset[ px_number ] * ( 1 + ctx->params.kta[ px_number ] * d_ta ) * ( 1 + ctx->params.kv[ px_number ] * d_vdd );
+            if ( !calibrated_mode ) {
+                // 0, -1, 0, +1 for the pixels of each group of four, sign flipped on odd rows
+                conversion_pattern = 0;
+                if ( px_number & 1 ) {
+                    conversion_pattern = ( ( px_number & 2 ) ? 1 : -1 ) * ( 1 - 2 * il_pattern );
+                }
+                ir_data = ir_data + il_chess_corr[ il_pattern ] - ctx->params.il_chess_c[ 1 ] * conversion_pattern;
+            }
+
+            ir_data = ir_data / 0.95f - ir_data_cp;
+
+            alpha_compensated = ( ctx->params.alpha[ px_number ] - alpha_cp ) * ks_ta_corr;
+
+            raw_sx = alpha_compensated * alpha_compensated * alpha_compensated * ( ir_data + alpha_compensated * raw_ta_tr );
+            raw_sx = root_4( raw_sx ) * ctx->params.ks_to[ 1 ];
+
+            raw_to = root_4( ir_data / ( alpha_compensated * ks_to_corr + raw_sx ) + raw_ta_tr ) - 273.15f;
+
+            if ( raw_to < ctx->params.ct[ 1 ] ) {
+                range = 0;
+            } else if ( raw_to < ctx->params.ct[ 2 ] ) {
+                range = 1;
+            } else if ( raw_to < ctx->params.ct[ 3 ] ) {
+                range = 2;
+            } else {
+                range = 3;
+            }
+
+            raw_to = root_4( ir_data / ( alpha_compensated * ctx->params.alpha_corr_r[ range ] * ( 1 + ctx->params.ks_to[ range ] * ( raw_to - ctx->params.ct[ range ] ) ) ) + raw_ta_tr ) - 273.15f;
+
+            px_matrix[ px_number ] = raw_to;
+        }
+    }
+}
+
 void irgrid3_get_image ( irgrid3_t *ctx, uint16_t *frame_data, float *px_matrix ) {
     float raw_vdd;
     float raw_ta;
@@ -617,7 +738,7 @@ static void extract_ptat_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data ) {
 
     v_ptat_25 = eeprom_data[ 49 ];
 
-    alpha_ptat = (eeprom_data[16] & 0xF000) / pow(2, ( double )14) + 8.0f;
+    alpha_ptat = (eeprom_data[16] & 0xF000) / pow_2( 14 ) + 8.0f;
 
     ctx->params.kv_ptat = kv_ptat;
     ctx->params.kt_ptat = kt_ptat;
@@ -760,7 +881,7 @@ static void extract_alpha_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data ) {
             }
             ctx->params.alpha[ p ] = ctx->params.alpha[ p ] * ( 1 << acc_rem_scale );
             ctx->params.alpha[ p ] = ( alpha_ref + ( acc_row[ i ] << acc_row_scale ) + ( acc_column[ j ] << acc_column_scale ) + ctx->params.alpha[ p ] );
-            ctx->params.alpha[ p ] = ctx->params.alpha[ p ] / pow( 2, ( double )alpha_scale );
+            ctx->params.alpha[ p ] = ctx->params.alpha[ p ] / pow_2( alpha_scale );
         }
     }
 }
@@ -878,7 +999,7 @@ static void extract_kta_pixel_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data
             }
             ctx->params.kta[ p ] = ctx->params.kta[ p ] * ( 1 << kta_scale_2 );
             ctx->params.kta[ p ] = kta_rc[ split ] + ctx->params.kta[ p ];
-            ctx->params.kta[ p ] = ctx->params.kta[ p ] / pow( 2, ( double )kta_scale_1 );
+            ctx->params.kta[ p ] = ctx->params.kta[ p ] / pow_2( kta_scale_1 );
         }
     }
 }
@@ -928,7 +1049,7 @@ static void extract_kv_pixel_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data
             p = 32 * i + j;
             split = 2 * ( ( p / 32 ) - ( p / 64 ) * 2 ) + ( p % 2 );
             ctx->params.kv[ p ] = kv_t[ split ];
-            ctx->params.kv[ p ] = ctx->params.kv[ p ] / pow(2, ( double )kv_scale);
+            ctx->params.kv[ p ] = ctx->params.kv[ p ] / pow_2( kv_scale );
         }
     }
 }
@@ -959,7 +1080,7 @@ static void extract_cp_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data ) {
     if ( alpha_sp[ 0 ] > 511 ) {
         alpha_sp[ 0 ] = alpha_sp[ 0 ] - 1024;
     }
-    alpha_sp[ 0 ] = alpha_sp[ 0 ] / pow( 2, ( double )alpha_scale );
+    alpha_sp[ 0 ] = alpha_sp[ 0 ] / pow_2( alpha_scale );
 
     alpha_sp[ 1 ] = ( eeprom_data[ 57 ] & 0xFC00 ) >> 10;
     if ( alpha_sp[ 1 ] > 31 ) {
@@ -972,14 +1093,14 @@ static void extract_cp_parameters ( irgrid3_t *ctx, uint16_t *eeprom_data ) {
         cp_kta = cp_kta - 256;
     }
     kta_scale_1 = ( ( eeprom_data[ 56 ] & 0x00F0 ) >> 4 ) + 8;
-    ctx->params.cp_kta = cp_kta / pow( 2, ( double )kta_scale_1 );
+    ctx->params.cp_kta = cp_kta / pow_2( kta_scale_1 );
 
     cp_kv = ( eeprom_data[ 59 ] & 0xFF00 ) >> 8;
     if ( cp_kv > 127 ) {
         cp_kv = cp_kv - 256;
     }
     kv_scale = ( eeprom_data[ 56 ] & 0x0F00 ) >> 8;
-    ctx->params.cp_kv = cp_kv / pow( 2, ( double )kv_scale );
+    ctx->params.cp_kv = cp_kv / pow_2( kv_scale );
 
     ctx->params.cp_alpha [ 0 ] = alpha_sp[ 0 ];
     ctx->params.cp_alpha [ 1 ] = alpha_sp[ 1 ];
@@ -1094,5 +1215,43 @@ static float gain_calculation ( irgrid3_t *ctx, uint16_t raw_gain ) {
     return ctx->params.gain_eeprom / gain;
 }
 
+static float pow_2 ( uint8_t exponent ) {
+    float result = 1.0f;
+
+    while ( exponent >= 16 ) {
+        result *= 65536.0f;
+        exponent -= 16;
+    }
+
+    return result * ( float )( ( uint16_t )1 << exponent );
+}
+
+static float root_4 ( float value ) {
+    union {
+        float f;
+        uint32_t u;
+    } est;
+    float root_inv;
+    float root_inv_4;
+    uint8_t cnt;
+
+    if ( value <= 0 ) {
+        return 0;
+    }
+
+    // Initial estimate of value^(-1/4) from the exponent bits, then Newton steps
+    est.f = value;
+    est.u = 0x4F580000ul - ( est.u >> 2 );
+    root_inv = est.f;
+
+    for ( cnt = 0; cnt < 3; cnt++ ) {
+        root_inv_4 = root_inv * root_inv;
+        root_inv_4 *= root_inv_4;
+        root_inv = root_inv * ( 1.25f - 0.25f * value * root_inv_4 );
+    }
+
+    return value * root_inv * root_inv * root_inv;
+}
+
 
 // ------------------------------------------------------------------------- END
@@ -243,6 +243,29 @@ typedef enum
 struct lightranger12_s;
 typedef err_t ( *lightranger12_master_io_t )( struct lightranger12_s*, uint16_t, uint8_t*, uint16_t ); /**< Driver serial interface. */
 
+/**
+ * @brief LightRanger 12 Click ranging frame view structure.
+ * @details Ranging frame view definition of LightRanger 12 Click driver.
+ * The arrays point into the context temporary buffer and remain valid until the next
+ * transfer performed with the same context object.
+ */
+typedef struct
+{
+    uint8_t stream_count;                   /**< Results stream count of the frame. */
+    int8_t silicon_temp_degc;               /**< Internal sensor silicon temperature. */
+    uint8_t num_zones;                      /**< Number of zones in the frame (16 or 64). */
+    const uint8_t *nb_target_detected;      /**< Number of valid target detected for each zone. */
+    const int16_t *distance_mm;             /**< Measured distance in mm for each zone. */
+    const uint8_t *target_status;           /**< Measurement validity for each zone (255 if no target). */
+
+} lightranger12_frame_t;
+
+/**
+ * @brief LightRanger 12 Click ranging frame callback.
+ * @details Callback called by #lightranger12_get_ranging_frame for each decoded frame.
+ */
+typedef void ( *lightranger12_frame_cb_t )( const lightranger12_frame_t *frame );
+
 /**
  * @brief LightRanger 12 Click context object.
  * @details Context object definition of LightRanger 12 Click driver.
@@ -268,6 +291,7 @@ typedef struct lightranger12_s
     uint32_t data_read_size;        /**< Size of data read though I2C or SPI. */
     uint8_t offset_data[ LIGHTRANGER12_OFFSET_BUFFER_SIZE ];    /**< Offset buffer. */
     uint8_t temp_buf[ LIGHTRANGER12_TEMP_BUFFER_SIZE ]; /**< Temporary buffer used for internal driver processing. */
+    lightranger12_frame_cb_t frame_cb;  /**< Ranging frame callback (NULL if not used). */
 
 } lightranger12_t;
 
@@ -762,6 +786,37 @@ err_t lightranger12_stop_ranging ( lightranger12_t *ctx );
  */
 err_t lightranger12_get_ranging_data ( lightranger12_t *ctx, lightranger12_results_data_t *results );
 
+/**
+ * @brief LightRanger 12 set frame callback function.
+ * @details This function sets the callback which is called by #lightranger12_get_ranging_frame
+ * with each successfully decoded frame.
+ * @param[in] ctx : Click context object.
+ * See #lightranger12_t object definition for detailed explanation.
+ * @param[in] frame_cb : Frame callback function, NULL to disable it.
+ * See #lightranger12_frame_cb_t definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void lightranger12_set_frame_callback ( lightranger12_t *ctx, lightranger12_frame_cb_t frame_cb );
+
+/**
+ * @brief LightRanger 12 get ranging frame function.
+ * @details This function reads the results of the blocks enabled by #lightranger12_start_ranging
+ * and decodes the used blocks in place inside the context temporary buffer, without swapping
+ * the whole frame or copying the zone arrays. The distance is converted to mm and the target
+ * status is set to 255 for zones without targets in the same pass.
+ * @param[in] ctx : Click context object.
+ * See #lightranger12_t object definition for detailed explanation.
+ * @param[out] frame : LightRanger 12 frame view, NULL if only the callback is used.
+ * See #lightranger12_frame_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The frame arrays are valid until the next transfer with the same context object.
+ * Blocks missing from the frame are reported as NULL pointers.
+ */
+err_t lightranger12_get_ranging_frame ( lightranger12_t *ctx, lightranger12_frame_t *frame );
+
 #ifdef __cplusplus
 }
 #endif
@@ -197,6 +197,7 @@ void lightranger12_drv_interface_sel ( lightranger12_cfg_t *cfg, lightranger12_d
 err_t lightranger12_init ( lightranger12_t *ctx, lightranger12_cfg_t *cfg ) 
 {
     ctx->drv_sel = cfg->drv_sel;
+    ctx->frame_cb = NULL;
 
     digital_out_init( &ctx->sync, cfg->sync );
     digital_out_init( &ctx->lpn, cfg->lpn );
@@ -993,6 +994,155 @@ err_t lightranger12_get_ranging_data ( lightranger12_t *ctx, lightranger12_resul
     return error_flag;
 }
 
+void lightranger12_set_frame_callback ( lightranger12_t *ctx, lightranger12_frame_cb_t frame_cb )
+{
+    ctx->frame_cb = frame_cb;
+}
+
+err_t lightranger12_get_ranging_frame ( lightranger12_t *ctx, lightranger12_frame_t *frame )
+{
+    lightranger12_frame_t frame_view;
+    uint8_t *buf_ptr = ctx->temp_buf;
+    uint8_t *block_ptr = NULL;
+    uint8_t *nb_target_ptr = NULL;
+    int16_t *distance_ptr = NULL;
+    uint8_t data_buf[ 4 ] = { 0 };
+    uint32_t bh_word = 0;
+    uint16_t bh_type = 0;
+    uint16_t bh_size = 0;
+    uint16_t bh_idx = 0;
+    uint16_t header_id = 0;
+    uint16_t footer_id = 0;
+    uint32_t cnt = 0;
+    uint32_t zone = 0;
+    uint32_t msize = 0;
+    int16_t distance = 0;
+
+    if ( ( ctx->data_read_size < 24 ) || ( ctx->data_read_size > LIGHTRANGER12_TEMP_BUFFER_SIZE ) )
+    {
+        return LIGHTRANGER12_ERROR;
+    }
+    if ( LIGHTRANGER12_OK != lightranger12_read_multi ( ctx, 0x0000, buf_ptr, ctx->data_read_size ) )
+    {
+        return LIGHTRANGER12_ERROR;
+    }
+
+    // The frame is made of big endian 32-bit words, check header and footer ids before decoding
+    header_id = ( ( uint16_t ) buf_ptr[ 11 ] << 8 ) | buf_ptr[ 10 ];
+    footer_id = ( ( uint16_t ) buf_ptr[ ctx->data_read_size - 1 ] << 8 ) | 
+                buf_ptr[ ctx->data_read_size - 2 ];
+    if ( header_id != footer_id )
+    {
+        return LIGHTRANGER12_ERROR;
+    }
+
+    memset ( &frame_view, 0, sizeof ( lightranger12_frame_t ) );
+    frame_view.stream_count = buf_ptr[ 0 ];
+    ctx->stream_count = buf_ptr[ 0 ];
+
+    // Start decoding at position 16 to avoid headers
+    for ( cnt = 16; ( cnt + 4 ) <= ctx->data_read_size; cnt += ( 4 + msize ) )
+    {
+        bh_word = ( ( uint32_t ) buf_ptr[ cnt ] << 24 ) | ( ( uint32_t ) buf_ptr[ cnt + 1 ] << 16 ) | 
+                  ( ( uint16_t ) buf_ptr[ cnt + 2 ] << 8 ) | buf_ptr[ cnt + 3 ];
+        bh_type = ( uint16_t ) ( bh_word & 0x0F );
+        bh_size = ( uint16_t ) ( ( bh_word >> 4 ) & 0x0FFF );
+        bh_idx = ( uint16_t ) ( ( bh_word >> 16 ) & 0xFFFF );
+        if ( ( bh_type > 0x01 ) && ( bh_type < 0x0D ) )
+        {
+            msize = ( uint32_t ) bh_type * bh_size;
+        }
+        else
+        {
+            msize = bh_size;
+        }
+        if ( ( cnt + 4 + msize ) > ctx->data_read_size )
+        {
+            // Footer reached
+            break;
+        }
+        block_ptr = &buf_ptr[ cnt + 4 ];
+
+        switch ( bh_idx )
+        {
+            case LIGHTRANGER12_METADATA_IDX:
+            {
+                frame_view.silicon_temp_degc = ( int8_t ) block_ptr[ 11 ];
+                break;
+            }
+            case LIGHTRANGER12_NB_TARGET_DETECTED_IDX:
+            case LIGHTRANGER12_TARGET_STATUS_IDX:
+            {
+                if ( ( bh_size > LIGHTRANGER12_RESOLUTION_8X8 ) || ( bh_size % 4 ) )
+                {
+                    return LIGHTRANGER12_ERROR;
+                }
+                for ( zone = 0; zone < bh_size; zone += 4 )
+                {
+                    memcpy ( data_buf, &block_ptr[ zone ], 4 );
+                    block_ptr[ zone ] = data_buf[ 3 ];
+                    block_ptr[ zone + 1 ] = data_buf[ 2 ];
+                    block_ptr[ zone + 2 ] = data_buf[ 1 ];
+                    block_ptr[ zone + 3 ] = data_buf[ 0 ];
+                    // Set target status to 255 if no target is detected for this zone
+                    if ( ( LIGHTRANGER12_TARGET_STATUS_IDX == bh_idx ) && ( NULL != nb_target_ptr ) )
+                    {
+                        block_ptr[ zone ] = nb_target_ptr[ zone ] ? block_ptr[ zone ] : 255;
+                        block_ptr[ zone + 1 ] = nb_target_ptr[ zone + 1 ] ? block_ptr[ zone + 1 ] : 255;
+                        block_ptr[ zone + 2 ] = nb_target_ptr[ zone + 2 ] ? block_ptr[ zone + 2 ] : 255;
+                        block_ptr[ zone + 3 ] = nb_target_ptr[ zone + 3 ] ? block_ptr[ zone + 3 ] : 255;
+                    }
+                }
+                if ( LIGHTRANGER12_NB_TARGET_DETECTED_IDX == bh_idx )
+                {
+                    nb_target_ptr = block_ptr;
+                    frame_view.nb_target_detected = block_ptr;
+                }
+                else
+                {
+                    frame_view.target_status = block_ptr;
+                }
+                frame_view.num_zones = ( uint8_t ) bh_size;
+                break;
+            }
+            case LIGHTRANGER12_DISTANCE_IDX:
+            {
+                if ( ( bh_size > LIGHTRANGER12_RESOLUTION_8X8 ) || ( bh_size % 2 ) )
+                {
+                    return LIGHTRANGER12_ERROR;
+                }
+                distance_ptr = ( int16_t * ) block_ptr;
+                for ( zone = 0; zone < bh_size; zone += 2 )
+                {
+                    memcpy ( data_buf, &block_ptr[ zone * 2 ], 4 );
+                    // Convert data into their real format
+                    distance = ( int16_t ) ( ( ( uint16_t ) data_buf[ 2 ] << 8 ) | data_buf[ 3 ] ) / 4;
+                    distance_ptr[ zone ] = ( distance < 0 ) ? 0 : distance;
+                    distance = ( int16_t ) ( ( ( uint16_t ) data_buf[ 0 ] << 8 ) | data_buf[ 1 ] ) / 4;
+                    distance_ptr[ zone + 1 ] = ( distance < 0 ) ? 0 : distance;
+                }
+                frame_view.distance_mm = distance_ptr;
+                frame_view.num_zones = ( uint8_t ) bh_size;
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    if ( NULL != frame )
+    {
+        memcpy ( frame, &frame_view, sizeof ( lightranger12_frame_t ) );
+    }
+    if ( NULL != ctx->frame_cb )
+    {
+        ctx->frame_cb ( &frame_view );
+    }
+    return LIGHTRANGER12_OK;
+}
+
 static void lightranger12_swap_buffer ( uint8_t *buffer, uint16_t size )
 {
     uint8_t data_buf[ 4 ] = { 0 };
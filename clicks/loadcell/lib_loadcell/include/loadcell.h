@@ -137,6 +137,15 @@
 #define LOADCELL_DATA_OK                                 1
 /** \} */
 
+/**
+ * \defgroup stream Stream settings
+ * \{
+ */
+#define LOADCELL_STREAM_BUF_SIZE                         20
+#define LOADCELL_STREAM_FILTER_AVERAGE                   0
+#define LOADCELL_STREAM_FILTER_MEDIAN                    1
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -144,6 +153,21 @@
  * \{
  */
  
+/**
+ * @brief Stream ring buffer and running filter state definition.
+ */
+typedef struct
+{
+    int32_t sample[ LOADCELL_STREAM_BUF_SIZE ];
+    int32_t sorted[ LOADCELL_STREAM_BUF_SIZE ];
+    int32_t sum;
+    uint8_t head;
+    uint8_t count;
+    uint8_t filter;
+    uint8_t input_sel;
+
+} loadcell_stream_t;
+
 /**
  * @brief Click ctx object definition.
  */
@@ -158,6 +182,10 @@ typedef struct
 
     digital_in_t int_pin;
 
+    // Background acquisition 
+
+    loadcell_stream_t stream;
+
 } loadcell_t;
 
 /**
@@ -322,6 +350,41 @@ uint8_t loadcell_calibration ( loadcell_t *ctx, uint8_t input_sel, uint16_t cal_
  */
 float loadcell_get_weight ( loadcell_t *ctx, uint8_t input_sel, loadcell_data_t *cell_data );
 
+/**
+ * @brief Stream start function.
+ * @param ctx          Click object.
+ * @param input_sel    Input channel and gain selection.
+ * @param filter       Filter type ( 0 : average, 1 : median ).
+ * @returns 1 on success, 0 if the input selection or the filter type is invalid.
+ *
+ * @description This function clears the stream ring buffer and selects the running filter
+ * used by the background acquisition.
+ */
+uint8_t loadcell_stream_start ( loadcell_t *ctx, uint8_t input_sel, uint8_t filter );
+
+/**
+ * @brief Stream poll function.
+ * @param ctx          Click object.
+ * @returns 1 if a new sample was captured, 0 otherwise.
+ *
+ * @description This function captures a conversion into the stream ring buffer
+ * if the data is ready, without waiting for it. A failed read leaves the buffer unchanged.
+ * @note Call it from the data ready interrupt or the main loop at least at the output data rate.
+ */
+uint8_t loadcell_stream_poll ( loadcell_t *ctx );
+
+/**
+ * @brief Stream get weight function.
+ * @param ctx          Click object.
+ * @param cell_data    Load cell data structure.
+ * @param weight_g     Filtered weight [ g ].
+ * @returns LOADCELL_GET_RESULT_ERROR if no samples are captured yet.
+ *
+ * @description This function calculates the weight from the running filter of the
+ * captured samples without performing any conversions.
+ */
+uint8_t loadcell_stream_get_weight ( loadcell_t *ctx, loadcell_data_t *cell_data, float *weight_g );
+
 
 #ifdef __cplusplus
 }
@@ -52,6 +52,9 @@ static void dev_rst_delay ( void );
 // Measurement delay
 static void dev_measure_delay ( void );
 
+// Stream sample push
+static void dev_stream_push ( loadcell_t *ctx, int32_t sample );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void loadcell_cfg_setup ( loadcell_cfg_t *cfg )
@@ -374,6 +377,97 @@ float loadcell_get_weight ( loadcell_t *ctx, uint8_t input_sel, loadcell_data_t
     return weight_val;
 }
 
+uint8_t loadcell_stream_start ( loadcell_t *ctx, uint8_t input_sel, uint8_t filter )
+{
+    if ( ( input_sel > LOADCELL_CHANN_A_GATE_64_NEXT ) || ( filter > LOADCELL_STREAM_FILTER_MEDIAN ) )
+    {
+        return LOADCELL_GET_RESULT_ERROR;
+    }
+    ctx->stream.input_sel = input_sel;
+    ctx->stream.filter = filter;
+    ctx->stream.head = 0;
+    ctx->stream.count = 0;
+    ctx->stream.sum = 0;
+    return LOADCELL_GET_RESULT_OK;
+}
+
+uint8_t loadcell_stream_poll ( loadcell_t *ctx )
+{
+    uint32_t sample;
+
+    if ( loadcell_check_out( ctx ) )
+    {
+        return 0;
+    }
+    if ( LOADCELL_GET_RESULT_OK != loadcell_read_results( ctx, ctx->stream.input_sel, &sample ) )
+    {
+        return 0;
+    }
+    dev_stream_push ( ctx, ( int32_t ) sample );
+    return 1;
+}
+
+uint8_t loadcell_stream_get_weight ( loadcell_t *ctx, loadcell_data_t *cell_data, float *weight_g )
+{
+    loadcell_stream_t *stream = &ctx->stream;
+    float weight_val;
+
+    if ( 0 == stream->count )
+    {
+        return LOADCELL_GET_RESULT_ERROR;
+    }
+
+    if ( LOADCELL_STREAM_FILTER_MEDIAN == stream->filter )
+    {
+        weight_val = ( float ) stream->sorted[ stream->count / 2 ];
+        if ( 0 == ( stream->count % 2 ) )
+        {
+            weight_val += ( float ) stream->sorted[ stream->count / 2 - 1 ];
+            weight_val /= 2.0;
+        }
+    }
+    else
+    {
+        weight_val = ( float ) stream->sum;
+        weight_val /= stream->count;
+    }
+
+    weight_val -= cell_data->tare;
+
+    if ( cell_data->weight_data_100g_ok == LOADCELL_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_100g;
+    }
+    else if ( cell_data->weight_data_500g_ok == LOADCELL_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_500g;
+    }
+    else if ( cell_data->weight_data_1000g_ok == LOADCELL_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_1000g;
+    }
+    else if ( cell_data->weight_data_5000g_ok == LOADCELL_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_5000g;
+    }
+    else if ( cell_data->weight_data_10000g_ok == LOADCELL_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_10000g;
+    }
+    else
+    {
+        weight_val *= LOADCELL_DEFAULT_WEIGHT_SCALE_COEFFICIENT;
+    }
+
+    if ( weight_val < 0 )
+    {
+        weight_val = 0.0;
+    }
+
+    *weight_g = weight_val;
+    return LOADCELL_GET_RESULT_OK;
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static void dev_clk_delay ( void )
@@ -391,5 +485,42 @@ static void dev_measure_delay ( void )
     Delay_1ms( );
 }
 
+static void dev_stream_push ( loadcell_t *ctx, int32_t sample )
+{
+    loadcell_stream_t *stream = &ctx->stream;
+    uint8_t pos = 0;
+
+    if ( LOADCELL_STREAM_BUF_SIZE == stream->count )
+    {
+        // Drop the oldest sample from the running sum and from the sorted window
+        int32_t oldest = stream->sample[ stream->head ];
+        stream->sum -= oldest;
+        while ( stream->sorted[ pos ] != oldest )
+        {
+            pos++;
+        }
+        for ( ; pos < ( stream->count - 1 ); pos++ )
+        {
+            stream->sorted[ pos ] = stream->sorted[ pos + 1 ];
+        }
+        stream->count--;
+        stream->sample[ stream->head ] = sample;
+        stream->head = ( stream->head + 1 ) % LOADCELL_STREAM_BUF_SIZE;
+    }
+    else
+    {
+        stream->sample[ ( stream->head + stream->count ) % LOADCELL_STREAM_BUF_SIZE ] = sample;
+    }
+
+    // Insertion keeps the window sorted so the median is available in constant time
+    for ( pos = stream->count; ( pos > 0 ) && ( stream->sorted[ pos - 1 ] > sample ); pos-- )
+    {
+        stream->sorted[ pos ] = stream->sorted[ pos - 1 ];
+    }
+    stream->sorted[ pos ] = sample;
+    stream->count++;
+    stream->sum += sample;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -193,6 +193,15 @@
 #define LOADCELL2_DATA_OK                                          1
 /** \} */
 
+/**
+ * \defgroup stream Stream settings
+ * \{
+ */
+#define LOADCELL2_STREAM_BUF_SIZE                                  20
+#define LOADCELL2_STREAM_FILTER_AVERAGE                            0
+#define LOADCELL2_STREAM_FILTER_MEDIAN                             1
+/** \} */
+
 /**
  * \defgroup result Result status
  * \{
@@ -226,6 +235,20 @@
  * \{
  */
 
+/**
+ * @brief Stream ring buffer and running filter state definition.
+ */
+typedef struct
+{
+    int32_t sample[ LOADCELL2_STREAM_BUF_SIZE ];
+    int32_t sorted[ LOADCELL2_STREAM_BUF_SIZE ];
+    int32_t sum;
+    uint8_t head;
+    uint8_t count;
+    uint8_t filter;
+
+} loadcell2_stream_t;
+
 /**
  * @brief Click ctx object definition.
  */
@@ -245,6 +268,10 @@ typedef struct
 
     uint8_t slave_address;
 
+    // Background acquisition 
+
+    loadcell2_stream_t stream;
+
 } loadcell2_t;
 
 /**
@@ -528,6 +555,39 @@ float loadcell2_get_weight ( loadcell2_t *ctx, loadcell2_data_t *cell_data );
 */
 uint8_t loadcell2_check_drdy ( loadcell2_t *ctx );
 
+/**
+ * @brief Stream start function.
+ * @param ctx          Click object.
+ * @param filter       Filter type ( 0 : average, 1 : median ).
+ *
+ * @description This function clears the stream ring buffer and selects the running filter
+ * used by the background acquisition.
+ */
+uint8_t loadcell2_stream_start ( loadcell2_t *ctx, uint8_t filter );
+
+/**
+ * @brief Stream poll function.
+ * @param ctx          Click object.
+ * @returns 1 if a new sample was captured, 0 otherwise.
+ *
+ * @description This function captures a conversion into the stream ring buffer
+ * if the data is ready, without waiting for it. A failed read leaves the buffer unchanged.
+ * @note Call it from the data ready interrupt or the main loop at least at the output data rate.
+ */
+uint8_t loadcell2_stream_poll ( loadcell2_t *ctx );
+
+/**
+ * @brief Stream get weight function.
+ * @param ctx          Click object.
+ * @param cell_data    Load cell data structure.
+ * @param weight_g     Filtered weight [ g ].
+ * @returns LOADCELL2_GET_RESULT_ERROR if no samples are captured yet.
+ *
+ * @description This function calculates the weight from the running filter of the
+ * captured samples without performing any conversions.
+ */
+uint8_t loadcell2_stream_get_weight ( loadcell2_t *ctx, loadcell2_data_t *cell_data, float *weight_g );
+
 
 
 #ifdef __cplusplus
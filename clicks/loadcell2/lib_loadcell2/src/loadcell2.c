@@ -61,6 +61,8 @@ static void dev_rst_delay( void );
 
 static void dev_measure_delay ( void );
 
+static void dev_stream_push ( loadcell2_t *ctx, int32_t sample );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void loadcell2_cfg_setup ( loadcell2_cfg_t *cfg )
@@ -555,6 +557,100 @@ float loadcell2_get_weight ( loadcell2_t *ctx, loadcell2_data_t *cell_data )
     return weight_val;
 }
 
+uint8_t loadcell2_stream_start ( loadcell2_t *ctx, uint8_t filter )
+{
+    if ( filter > LOADCELL2_STREAM_FILTER_MEDIAN )
+    {
+        return LOADCELL2_GET_RESULT_ERROR;
+    }
+    ctx->stream.filter = filter;
+    ctx->stream.head = 0;
+    ctx->stream.count = 0;
+    ctx->stream.sum = 0;
+    return LOADCELL2_GET_RESULT_OK;
+}
+
+uint8_t loadcell2_stream_poll ( loadcell2_t *ctx )
+{
+    uint8_t reg = LOADCELL2_REG_ADC_B2;
+    uint8_t rx_buf[ 3 ];
+    uint32_t sample;
+
+    if ( !loadcell2_check_drdy( ctx ) )
+    {
+        return 0;
+    }
+    // loadcell2_generic_read drops the bus status, so the conversion is read here
+    if ( I2C_MASTER_SUCCESS != i2c_master_write_then_read( &ctx->i2c, &reg, 1, rx_buf, 3 ) )
+    {
+        return 0;
+    }
+    sample = ( ( uint32_t ) rx_buf[ 0 ] << 16 ) | ( ( uint32_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 2 ];
+    dev_stream_push ( ctx, ( int32_t ) sample );
+    return 1;
+}
+
+uint8_t loadcell2_stream_get_weight ( loadcell2_t *ctx, loadcell2_data_t *cell_data, float *weight_g )
+{
+    loadcell2_stream_t *stream = &ctx->stream;
+    float weight_val;
+
+    if ( 0 == stream->count )
+    {
+        return LOADCELL2_GET_RESULT_ERROR;
+    }
+
+    if ( LOADCELL2_STREAM_FILTER_MEDIAN == stream->filter )
+    {
+        weight_val = ( float ) stream->sorted[ stream->count / 2 ];
+        if ( 0 == ( stream->count % 2 ) )
+        {
+            weight_val += ( float ) stream->sorted[ stream->count / 2 - 1 ];
+            weight_val /= 2.0;
+        }
+    }
+    else
+    {
+        weight_val = ( float ) stream->sum;
+        weight_val /= stream->count;
+    }
+
+    weight_val -= cell_data->tare;
+
+    if ( cell_data->weight_data_100g_ok == LOADCELL2_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_100g;
+    }
+    else if ( cell_data->weight_data_500g_ok == LOADCELL2_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_500g;
+    }
+    else if ( cell_data->weight_data_1000g_ok == LOADCELL2_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_1000g;
+    }
+    else if ( cell_data->weight_data_5000g_ok == LOADCELL2_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_5000g;
+    }
+    else if ( cell_data->weight_data_10000g_ok == LOADCELL2_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_10000g;
+    }
+    else
+    {
+        weight_val *= LOADCELL2_DEFAULT_WEIGHT_SCALE_COEFFICIENT;
+    }
+
+    if ( weight_val < 0 )
+    {
+        weight_val = 0.0;
+    }
+
+    *weight_g = weight_val;
+    return LOADCELL2_GET_RESULT_OK;
+}
+
 uint8_t loadcell2_check_drdy ( loadcell2_t *ctx )
 {
     return  digital_in_read( &ctx->rdy ); 
@@ -572,5 +668,42 @@ static void dev_measure_delay ( void )
     Delay_1ms( );
 }
 
+static void dev_stream_push ( loadcell2_t *ctx, int32_t sample )
+{
+    loadcell2_stream_t *stream = &ctx->stream;
+    uint8_t pos = 0;
+
+    if ( LOADCELL2_STREAM_BUF_SIZE == stream->count )
+    {
+        // Drop the oldest sample from the running sum and from the sorted window
+        int32_t oldest = stream->sample[ stream->head ];
+        stream->sum -= oldest;
+        while ( stream->sorted[ pos ] != oldest )
+        {
+            pos++;
+        }
+        for ( ; pos < ( stream->count - 1 ); pos++ )
+        {
+            stream->sorted[ pos ] = stream->sorted[ pos + 1 ];
+        }
+        stream->count--;
+        stream->sample[ stream->head ] = sample;
+        stream->head = ( stream->head + 1 ) % LOADCELL2_STREAM_BUF_SIZE;
+    }
+    else
+    {
+        stream->sample[ ( stream->head + stream->count ) % LOADCELL2_STREAM_BUF_SIZE ] = sample;
+    }
+
+    // Insertion keeps the window sorted so the median is available in constant time
+    for ( pos = stream->count; ( pos > 0 ) && ( stream->sorted[ pos - 1 ] > sample ); pos-- )
+    {
+        stream->sorted[ pos ] = stream->sorted[ pos - 1 ];
+    }
+    stream->sorted[ pos ] = sample;
+    stream->count++;
+    stream->sum += sample;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -204,6 +204,15 @@ extern "C"{
 #define LOADCELL3_DATA_NO_DATA                              0
 #define LOADCELL3_DATA_OK                                   1   
 
+/**
+ * @brief Load Cell 3 stream settings.
+ * @details Specified settings for background acquisition of Load Cell 3 Click driver.
+ * @note Increase buffer size if needed, up to 127 samples.
+ */
+#define LOADCELL3_STREAM_BUF_SIZE                           20
+#define LOADCELL3_STREAM_FILTER_AVERAGE                     0
+#define LOADCELL3_STREAM_FILTER_MEDIAN                      1
+
 /*! @} */ // status
 
 /**
@@ -228,6 +237,21 @@ extern "C"{
 /*! @} */ // loadcell3_map
 /*! @} */ // loadcell3
 
+/**
+ * @brief Load Cell 3 Click stream object.
+ * @details Background acquisition ring buffer and running filter state of Load Cell 3 Click driver.
+ */
+typedef struct
+{
+    int32_t sample[ LOADCELL3_STREAM_BUF_SIZE ];    /**< Raw samples in arrival order. */
+    int32_t sorted[ LOADCELL3_STREAM_BUF_SIZE ];    /**< Raw samples sorted for the median filter. */
+    int32_t sum;                                    /**< Running sum of the buffered samples. */
+    uint8_t head;                                   /**< Index of the oldest sample. */
+    uint8_t count;                                  /**< Number of buffered samples. */
+    uint8_t filter;                                 /**< Filter type. */
+
+} loadcell3_stream_t;
+
 /**
  * @brief Load Cell 3 Click context object.
  * @details Context object definition of Load Cell 3 Click driver.
@@ -246,6 +270,9 @@ typedef struct
 
     uint8_t slave_address;    /**< Device slave address (used for I2C driver). */
 
+    // Background acquisition
+    loadcell3_stream_t stream;    /**< Stream ring buffer and filter state. */
+
 } loadcell3_t;
 
 /**
@@ -714,6 +741,52 @@ err_t loadcell3_calibration ( loadcell3_t *ctx, uint16_t cal_val, loadcell3_data
  */
 float loadcell3_get_weight ( loadcell3_t *ctx, loadcell3_data_t *cell_data );
 
+/**
+ * @brief Load Cell 3 stream start function.
+ * @details This function clears the stream ring buffer and selects the running filter
+ * used by the background acquisition.
+ * @param[in] ctx : Click context object.
+ * See #loadcell3_t object definition for detailed explanation.
+ * @param[in] filter : Filter type:
+ *                     @li @c 0 - Moving average,
+ *                     @li @c 1 - Moving median.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell3_stream_start ( loadcell3_t *ctx, uint8_t filter );
+
+/**
+ * @brief Load Cell 3 stream poll function.
+ * @details This function captures a conversion into the stream ring buffer
+ * if the data is ready, without waiting for it.
+ * @param[in] ctx : Click context object.
+ * See #loadcell3_t object definition for detailed explanation.
+ * @return @li @c 0 - No new sample,
+ *         @li @c 1 - New sample captured.
+ * @note The device provides no data ready signal, so every call captures one conversion,
+ * unless a bus error leaves the buffer unchanged.
+ * Call it at the output data rate.
+ */
+uint8_t loadcell3_stream_poll ( loadcell3_t *ctx );
+
+/**
+ * @brief Load Cell 3 stream get weight function.
+ * @details This function calculates the weight from the running filter of the
+ * captured samples without performing any conversions.
+ * @param[in] ctx : Click context object.
+ * See #loadcell3_t object definition for detailed explanation.
+ * @param[in] cell_data : Cell data object.
+ * See #loadcell3_data_t object definition for detailed explanation.
+ * @param[out] weight_g : Filtered weight in grams.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no samples captured.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell3_stream_get_weight ( loadcell3_t *ctx, loadcell3_data_t *cell_data, float *weight_g );
+
 #ifdef __cplusplus
 }
 #endif
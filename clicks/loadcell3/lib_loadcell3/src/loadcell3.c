@@ -49,6 +49,16 @@ static void dev_cfg_delay ( void );
  */
 static void dev_measure_delay ( void );
 
+/**
+ * @brief Load Cell 3 stream push function.
+ * @details This function adds a sample to the stream ring buffer and updates the running filter.
+ * @param[in] ctx : Click context object.
+ * See #loadcell3_t object definition for detailed explanation.
+ * @param[in] sample : Raw ADC sample.
+ * @return Nothing.
+ */
+static void dev_stream_push ( loadcell3_t *ctx, int32_t sample );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void loadcell3_cfg_setup ( loadcell3_cfg_t *cfg ) {
@@ -172,7 +182,7 @@ err_t loadcell3_generic_test_page_read ( loadcell3_t *ctx, uint8_t reg, uint8_t
 }
 
 err_t loadcell3_set_memory_page_slave_addr ( loadcell3_t *ctx, uint8_t memory_page ) {
-    err_t err_flag;
+    err_t err_flag = LOADCELL3_OK;
         
     if ( ( memory_page == LOADCELL3_SET_MEMORY_PAGE_TEST_REG ) || ( memory_page == LOADCELL3_SET_MEMORY_PAGE_CONTROL_AND_STATUS_REG ) ||
          ( memory_page == LOADCELL3_SET_MEMORY_PAGE_EEPROM_CACHE_CELLS ) || ( memory_page == LOADCELL3_SET_MEMORY_PAGE_CTRL_AND_STATUS_REG ) ) {
@@ -513,6 +523,78 @@ float loadcell3_get_weight ( loadcell3_t *ctx, loadcell3_data_t *cell_data ) {
     return weight_val;
 }
 
+err_t loadcell3_stream_start ( loadcell3_t *ctx, uint8_t filter ) {
+    if ( filter > LOADCELL3_STREAM_FILTER_MEDIAN ) {
+        return LOADCELL3_ERROR;
+    }
+    ctx->stream.filter = filter;
+    ctx->stream.head = 0;
+    ctx->stream.count = 0;
+    ctx->stream.sum = 0;
+    return LOADCELL3_OK;
+}
+
+uint8_t loadcell3_stream_poll ( loadcell3_t *ctx ) {
+    uint8_t lsb;
+    uint8_t msb;
+    int16_t sample;
+
+    if ( ( LOADCELL3_OK != loadcell3_set_memory_page_slave_addr( ctx, LOADCELL3_SET_MEMORY_PAGE_TEST_REG ) ) ||
+         ( LOADCELL3_OK != loadcell3_generic_read( ctx, LOADCELL3_REG_TEST_PADC_DATA_1, &lsb, 1 ) ) ||
+         ( LOADCELL3_OK != loadcell3_generic_read( ctx, LOADCELL3_REG_TEST_PADC_DATA_2, &msb, 1 ) ) ) {
+        return 0;
+    }
+    sample = ( int16_t ) ( ( ( uint16_t ) msb << 8 ) | lsb );
+    dev_stream_push ( ctx, ( int32_t ) sample );
+    return 1;
+}
+
+err_t loadcell3_stream_get_weight ( loadcell3_t *ctx, loadcell3_data_t *cell_data, float *weight_g ) {
+    loadcell3_stream_t *stream = &ctx->stream;
+    float weight_val;
+
+    if ( 0 == stream->count ) {
+        return LOADCELL3_ERROR;
+    }
+
+    if ( LOADCELL3_STREAM_FILTER_MEDIAN == stream->filter ) {
+        weight_val = ( float ) stream->sorted[ stream->count / 2 ];
+        if ( 0 == ( stream->count % 2 ) ) {
+            weight_val += ( float ) stream->sorted[ stream->count / 2 - 1 ];
+            weight_val /= 2.0;
+        }
+    }
+    else {
+        weight_val = ( float ) stream->sum;
+        weight_val /= stream->count;
+    }
+
+    weight_val -= cell_data->tare;
+
+    if ( cell_data->weight_data_100g_ok == LOADCELL3_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_100g;
+    }
+    else if ( cell_data->weight_data_500g_ok == LOADCELL3_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_500g;
+    }
+    else if ( cell_data->weight_data_1000g_ok == LOADCELL3_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_1000g;
+    }
+    else if ( cell_data->weight_data_5000g_ok == LOADCELL3_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_5000g;
+    }
+    else if ( cell_data->weight_data_10000g_ok == LOADCELL3_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_10000g;
+    }
+
+    if ( weight_val < 0 ) {
+        weight_val = LOADCELL3_WEIGHT_ZERO;
+    }
+
+    *weight_g = weight_val;
+    return LOADCELL3_OK;
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static void dev_cfg_delay ( void ) {
@@ -523,4 +605,35 @@ static void dev_measure_delay ( void ) {
     Delay_10ms( );
 }
 
+static void dev_stream_push ( loadcell3_t *ctx, int32_t sample ) {
+    loadcell3_stream_t *stream = &ctx->stream;
+    uint8_t pos = 0;
+
+    if ( LOADCELL3_STREAM_BUF_SIZE == stream->count ) {
+        // Drop the oldest sample from the running sum and from the sorted window
+        int32_t oldest = stream->sample[ stream->head ];
+        stream->sum -= oldest;
+        while ( stream->sorted[ pos ] != oldest ) {
+            pos++;
+        }
+        for ( ; pos < ( stream->count - 1 ); pos++ ) {
+            stream->sorted[ pos ] = stream->sorted[ pos + 1 ];
+        }
+        stream->count--;
+        stream->sample[ stream->head ] = sample;
+        stream->head = ( stream->head + 1 ) % LOADCELL3_STREAM_BUF_SIZE;
+    }
+    else {
+        stream->sample[ ( stream->head + stream->count ) % LOADCELL3_STREAM_BUF_SIZE ] = sample;
+    }
+
+    // Insertion keeps the window sorted so the median is available in constant time
+    for ( pos = stream->count; ( pos > 0 ) && ( stream->sorted[ pos - 1 ] > sample ); pos-- ) {
+        stream->sorted[ pos ] = stream->sorted[ pos - 1 ];
+    }
+    stream->sorted[ pos ] = sample;
+    stream->count++;
+    stream->sum += sample;
+}
+
 // ------------------------------------------------------------------------- END
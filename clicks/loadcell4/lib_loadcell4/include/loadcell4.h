@@ -81,6 +81,15 @@ extern "C"{
 #define LOADCELL4_WEIGHT_10000G                                    10000
 #define LOADCELL4_DEFAULT_WEIGHT_SCALE_COEFFICIENT        0.088495575221
 
+/**
+ * @brief Load Cell 4 stream settings.
+ * @details Specified settings for background acquisition of Load Cell 4 Click driver.
+ * @note Increase buffer size if needed, up to 127 samples.
+ */
+#define LOADCELL4_STREAM_BUF_SIZE                                      20
+#define LOADCELL4_STREAM_FILTER_AVERAGE                                0
+#define LOADCELL4_STREAM_FILTER_MEDIAN                                 1
+
 /**
  * @brief Load Cell 4 eeprom setting.
  * @details Specified eeprom setting of Load Cell 4 Click driver.
@@ -112,11 +121,11 @@ extern "C"{
  * @brief Load Cell 4 status.
  * @details Status settings of Load Cell 4 Click driver.
  */
-#define LOADCELL4_STATUS_NORMAL                                     0x00
+#define LOADCELL4_STATUS_NORMAL                                        0x00
 #define LOADCELL4_STATUS_CMD_MODE                                   0x01
-#define LOADCELL4_STATUS_STALE_DATA                                 0x02
+#define LOADCELL4_STATUS_STALE_DATA                                    0x02
 #define LOADCELL4_STATUS_ERROR                                      0x03
-#define LOADCELL4_STATUS_BIT_MASK                                   0x03
+#define LOADCELL4_STATUS_BIT_MASK                                      0x03
 #define LOADCELL4_BRIDGE_RES                                      0x3FFF
 
 /**
@@ -185,6 +194,21 @@ extern "C"{
 /*! @} */ // loadcell4_map
 /*! @} */ // loadcell4
 
+/**
+ * @brief Load Cell 4 Click stream object.
+ * @details Background acquisition ring buffer and running filter state of Load Cell 4 Click driver.
+ */
+typedef struct
+{
+    int32_t sample[ LOADCELL4_STREAM_BUF_SIZE ];    /**< Raw samples in arrival order. */
+    int32_t sorted[ LOADCELL4_STREAM_BUF_SIZE ];    /**< Raw samples sorted for the median filter. */
+    int32_t sum;                                    /**< Running sum of the buffered samples. */
+    uint8_t head;                                   /**< Index of the oldest sample. */
+    uint8_t count;                                  /**< Number of buffered samples. */
+    uint8_t filter;                                 /**< Filter type. */
+
+} loadcell4_stream_t;
+
 /**
  * @brief Load Cell 4 Click context object.
  * @details Context object definition of Load Cell 4 Click driver.
@@ -203,6 +227,9 @@ typedef struct
     // I2C slave address
     uint8_t slave_address;                           /**< Device slave address (used for I2C driver). */
 
+    // Background acquisition
+    loadcell4_stream_t stream;    /**< Stream ring buffer and filter state. */
+
 } loadcell4_t;
 
 /**
@@ -487,6 +514,50 @@ err_t loadcell4_calibration ( loadcell4_t *ctx, uint16_t cal_val, loadcell4_data
  */
 float loadcell4_get_weight ( loadcell4_t *ctx, loadcell4_data_t *cell_data );
 
+/**
+ * @brief Load Cell 4 stream start function.
+ * @details This function clears the stream ring buffer and selects the running filter
+ * used by the background acquisition.
+ * @param[in] ctx : Click context object.
+ * See #loadcell4_t object definition for detailed explanation.
+ * @param[in] filter : Filter type:
+ *                     @li @c 0 - Moving average,
+ *                     @li @c 1 - Moving median.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell4_stream_start ( loadcell4_t *ctx, uint8_t filter );
+
+/**
+ * @brief Load Cell 4 stream poll function.
+ * @details This function captures a conversion into the stream ring buffer
+ * if the data is ready, without waiting for it. A failed read leaves the buffer unchanged.
+ * @param[in] ctx : Click context object.
+ * See #loadcell4_t object definition for detailed explanation.
+ * @return @li @c 0 - No new sample,
+ *         @li @c 1 - New sample captured.
+ * @note Call it from the INT pin interrupt or the main loop at least at the output data rate.
+ */
+uint8_t loadcell4_stream_poll ( loadcell4_t *ctx );
+
+/**
+ * @brief Load Cell 4 stream get weight function.
+ * @details This function calculates the weight from the running filter of the
+ * captured samples without performing any conversions.
+ * @param[in] ctx : Click context object.
+ * See #loadcell4_t object definition for detailed explanation.
+ * @param[in] cell_data : Cell data object.
+ * See #loadcell4_data_t object definition for detailed explanation.
+ * @param[out] weight_g : Filtered weight in grams.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no samples captured.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell4_stream_get_weight ( loadcell4_t *ctx, loadcell4_data_t *cell_data, float *weight_g );
+
 #ifdef __cplusplus
 }
 #endif
@@ -73,6 +73,16 @@ static void dev_i2c_read ( loadcell4_t *ctx, uint8_t *read_buf );
  */
 static uint8_t dev_i2c_read_eeprom ( loadcell4_t *ctx, uint8_t cmd_data, uint16_t *read_word );
 
+/**
+ * @brief Load Cell 4 stream push function.
+ * @details This function adds a sample to the stream ring buffer and updates the running filter.
+ * @param[in] ctx : Click context object.
+ * See #loadcell4_t object definition for detailed explanation.
+ * @param[in] sample : Raw ADC sample.
+ * @return Nothing.
+ */
+static void dev_stream_push ( loadcell4_t *ctx, int32_t sample );
+
 // --------------------------------------------------------- PUBLIC FUNCTIONS 
 
 void loadcell4_cfg_setup ( loadcell4_cfg_t *cfg ) 
@@ -403,6 +413,77 @@ float loadcell4_get_weight ( loadcell4_t *ctx, loadcell4_data_t *cell_data ) {
     return weight_val;
 }
 
+err_t loadcell4_stream_start ( loadcell4_t *ctx, uint8_t filter ) {
+    if ( filter > LOADCELL4_STREAM_FILTER_MEDIAN ) {
+        return LOADCELL4_ERROR;
+    }
+    ctx->stream.filter = filter;
+    ctx->stream.head = 0;
+    ctx->stream.count = 0;
+    ctx->stream.sum = 0;
+    return LOADCELL4_OK;
+}
+
+uint8_t loadcell4_stream_poll ( loadcell4_t *ctx ) {
+    uint8_t rx_buf[ 4 ];
+    uint16_t sample;
+
+    if ( 1 != loadcell4_get_int( ctx ) ) {
+        return 0;
+    }
+    // loadcell4_read_data drops the bus status, so the conversion is read here
+    if ( I2C_MASTER_SUCCESS != i2c_master_read( &ctx->i2c, rx_buf, 4 ) ) {
+        return 0;
+    }
+    if ( LOADCELL4_STATUS_NORMAL != ( ( rx_buf[ 0 ] >> 6 ) & LOADCELL4_STATUS_BIT_MASK ) ) {
+        return 0;
+    }
+    sample = ( ( ( uint16_t ) rx_buf[ 0 ] << 8 ) | rx_buf[ 1 ] ) & LOADCELL4_BRIDGE_RES;
+    dev_stream_push ( ctx, ( int32_t ) sample );
+    return 1;
+}
+
+err_t loadcell4_stream_get_weight ( loadcell4_t *ctx, loadcell4_data_t *cell_data, float *weight_g ) {
+    loadcell4_stream_t *stream = &ctx->stream;
+    float weight_val;
+
+    if ( 0 == stream->count ) {
+        return LOADCELL4_ERROR;
+    }
+
+    if ( LOADCELL4_STREAM_FILTER_MEDIAN == stream->filter ) {
+        weight_val = ( float ) stream->sorted[ stream->count / 2 ];
+        if ( 0 == ( stream->count % 2 ) ) {
+            weight_val += ( float ) stream->sorted[ stream->count / 2 - 1 ];
+            weight_val /= 2.0;
+        }
+    } else {
+        weight_val = ( float ) stream->sum;
+        weight_val /= stream->count;
+    }
+
+    weight_val -= cell_data->tare;
+
+    if ( cell_data->weight_data_100g_ok == LOADCELL4_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_100g;
+    } else if ( cell_data->weight_data_500g_ok == LOADCELL4_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_500g;
+    } else if ( cell_data->weight_data_1000g_ok == LOADCELL4_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_1000g;
+    } else if ( cell_data->weight_data_5000g_ok == LOADCELL4_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_5000g;
+    } else if ( cell_data->weight_data_10000g_ok == LOADCELL4_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_10000g;
+    }
+
+    if ( weight_val < 0 ) {
+        weight_val = LOADCELL4_WEIGHT_ZERO;
+    }
+
+    *weight_g = weight_val;
+    return LOADCELL4_OK;
+}
+
 
 // --------------------------------------------- PRIVATE FUNCTION DEFINITIONS 
 
@@ -460,4 +541,34 @@ static uint8_t dev_i2c_read_eeprom ( loadcell4_t *ctx, uint8_t cmd_data, uint16_
     return read_buf[ 0 ];
 }
 
+static void dev_stream_push ( loadcell4_t *ctx, int32_t sample ) {
+    loadcell4_stream_t *stream = &ctx->stream;
+    uint8_t pos = 0;
+
+    if ( LOADCELL4_STREAM_BUF_SIZE == stream->count ) {
+        // Drop the oldest sample from the running sum and from the sorted window
+        int32_t oldest = stream->sample[ stream->head ];
+        stream->sum -= oldest;
+        while ( stream->sorted[ pos ] != oldest ) {
+            pos++;
+        }
+        for ( ; pos < ( stream->count - 1 ); pos++ ) {
+            stream->sorted[ pos ] = stream->sorted[ pos + 1 ];
+        }
+        stream->count--;
+        stream->sample[ stream->head ] = sample;
+        stream->head = ( stream->head + 1 ) % LOADCELL4_STREAM_BUF_SIZE;
+    } else {
+        stream->sample[ ( stream->head + stream->count ) % LOADCELL4_STREAM_BUF_SIZE ] = sample;
+    }
+
+    // Insertion keeps the window sorted so the median is available in constant time
+    for ( pos = stream->count; ( pos > 0 ) && ( stream->sorted[ pos - 1 ] > sample ); pos-- ) {
+        stream->sorted[ pos ] = stream->sorted[ pos - 1 ];
+    }
+    stream->sorted[ pos ] = sample;
+    stream->count++;
+    stream->sum += sample;
+}
+
 // ------------------------------------------------------------------------- END
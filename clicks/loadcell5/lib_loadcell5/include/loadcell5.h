@@ -171,6 +171,15 @@ extern "C"{
 #define LOADCELL5_DATA_NO_DATA                                     0
 #define LOADCELL5_DATA_OK                                          1   
 
+/**
+ * @brief Load Cell 5 stream settings.
+ * @details Specified settings for background acquisition of Load Cell 5 Click driver.
+ * @note Increase buffer size if needed, up to 127 samples.
+ */
+#define LOADCELL5_STREAM_BUF_SIZE                                  20
+#define LOADCELL5_STREAM_FILTER_AVERAGE                            0
+#define LOADCELL5_STREAM_FILTER_MEDIAN                             1
+
 /*! @} */ // status
 
 
@@ -253,6 +262,21 @@ extern "C"{
 /*! @} */ // loadcell5_map
 /*! @} */ // loadcell5
 
+/**
+ * @brief Load Cell 5 Click stream object.
+ * @details Background acquisition ring buffer and running filter state of Load Cell 5 Click driver.
+ */
+typedef struct
+{
+    int32_t sample[ LOADCELL5_STREAM_BUF_SIZE ];    /**< Raw samples in arrival order. */
+    int32_t sorted[ LOADCELL5_STREAM_BUF_SIZE ];    /**< Raw samples sorted for the median filter. */
+    int32_t sum;                                    /**< Running sum of the buffered samples. */
+    uint8_t head;                                   /**< Index of the oldest sample. */
+    uint8_t count;                                  /**< Number of buffered samples. */
+    uint8_t filter;                                 /**< Filter type. */
+
+} loadcell5_stream_t;
+
 /**
  * @brief Load Cell 5 Click context object.
  * @details Context object definition of Load Cell 5 Click driver.
@@ -274,6 +298,9 @@ typedef struct
 
     pin_name_t  chip_select; /**< Chip select pin descriptor (used for SPI driver). */
 
+    // Background acquisition
+    loadcell5_stream_t stream;    /**< Stream ring buffer and filter state. */
+
 } loadcell5_t;
 
 /**
@@ -543,6 +570,50 @@ float loadcell5_get_weight ( loadcell5_t *ctx, loadcell5_data_t *cell_data );
  */
 uint8_t loadcell5_check_data_ready ( loadcell5_t *ctx );
 
+/**
+ * @brief Load Cell 5 stream start function.
+ * @details This function clears the stream ring buffer and selects the running filter
+ * used by the background acquisition.
+ * @param[in] ctx : Click context object.
+ * See #loadcell5_t object definition for detailed explanation.
+ * @param[in] filter : Filter type:
+ *                     @li @c 0 - Moving average,
+ *                     @li @c 1 - Moving median.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell5_stream_start ( loadcell5_t *ctx, uint8_t filter );
+
+/**
+ * @brief Load Cell 5 stream poll function.
+ * @details This function captures a conversion into the stream ring buffer
+ * if the data is ready, without waiting for it.
+ * @param[in] ctx : Click context object.
+ * See #loadcell5_t object definition for detailed explanation.
+ * @return @li @c 0 - No new sample,
+ *         @li @c 1 - New sample captured.
+ * @note Call it from the RDY pin interrupt or the main loop at least at the output data rate.
+ */
+uint8_t loadcell5_stream_poll ( loadcell5_t *ctx );
+
+/**
+ * @brief Load Cell 5 stream get weight function.
+ * @details This function calculates the weight from the running filter of the
+ * captured samples without performing any conversions.
+ * @param[in] ctx : Click context object.
+ * See #loadcell5_t object definition for detailed explanation.
+ * @param[in] cell_data : Cell data object.
+ * See #loadcell5_data_t object definition for detailed explanation.
+ * @param[out] weight_g : Filtered weight in grams.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no samples captured.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell5_stream_get_weight ( loadcell5_t *ctx, loadcell5_data_t *cell_data, float *weight_g );
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,8 @@ static void dev_rst_delay( void );
 
 static void dev_measure_delay ( void );
 
+static void dev_stream_push ( loadcell5_t *ctx, int32_t sample );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void loadcell5_cfg_setup ( loadcell5_cfg_t *cfg ) {
@@ -335,6 +337,78 @@ float loadcell5_get_weight ( loadcell5_t *ctx, loadcell5_data_t *cell_data ) {
     return weight_val;
 }
 
+err_t loadcell5_stream_start ( loadcell5_t *ctx, uint8_t filter ) {
+    if ( filter > LOADCELL5_STREAM_FILTER_MEDIAN ) {
+        return LOADCELL5_ERROR;
+    }
+    ctx->stream.filter = filter;
+    ctx->stream.head = 0;
+    ctx->stream.count = 0;
+    ctx->stream.sum = 0;
+    return LOADCELL5_OK;
+}
+
+uint8_t loadcell5_stream_poll ( loadcell5_t *ctx ) {
+    uint32_t sample;
+    uint8_t status;
+
+    if ( loadcell5_check_data_ready( ctx ) ) {
+        return 0;
+    }
+    if ( ( LOADCELL5_OK != loadcell5_get_data( ctx, &status, &sample ) ) || 
+         ( status & LOADCELL5_STATUS_ERROR ) ) {
+        return 0;
+    }
+    dev_stream_push ( ctx, ( int32_t ) sample );
+    return 1;
+}
+
+err_t loadcell5_stream_get_weight ( loadcell5_t *ctx, loadcell5_data_t *cell_data, float *weight_g ) {
+    loadcell5_stream_t *stream = &ctx->stream;
+    float weight_val;
+
+    if ( 0 == stream->count ) {
+        return LOADCELL5_ERROR;
+    }
+
+    if ( LOADCELL5_STREAM_FILTER_MEDIAN == stream->filter ) {
+        weight_val = ( float ) stream->sorted[ stream->count / 2 ];
+        if ( 0 == ( stream->count % 2 ) ) {
+            weight_val += ( float ) stream->sorted[ stream->count / 2 - 1 ];
+            weight_val /= 2.0;
+        }
+    }
+    else {
+        weight_val = ( float ) stream->sum;
+        weight_val /= stream->count;
+    }
+
+    weight_val -= cell_data->tare;
+
+    if ( cell_data->weight_data_100g_ok == LOADCELL5_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_100g;
+    }
+    else if ( cell_data->weight_data_500g_ok == LOADCELL5_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_500g;
+    }
+    else if ( cell_data->weight_data_1000g_ok == LOADCELL5_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_1000g;
+    }
+    else if ( cell_data->weight_data_5000g_ok == LOADCELL5_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_5000g;
+    }
+    else if ( cell_data->weight_data_10000g_ok == LOADCELL5_DATA_OK ) {
+        weight_val *= cell_data->weight_coeff_10000g;
+    }
+
+    if ( weight_val < 0 ) {
+        weight_val = LOADCELL5_WEIGHT_ZERO;
+    }
+
+    *weight_g = weight_val;
+    return LOADCELL5_OK;
+}
+
 uint8_t loadcell5_check_data_ready ( loadcell5_t *ctx ) {
     return digital_in_read( &ctx->rdy );
 }
@@ -351,4 +425,35 @@ static void dev_measure_delay ( void ) {
     Delay_10ms( );
 }
 
+static void dev_stream_push ( loadcell5_t *ctx, int32_t sample ) {
+    loadcell5_stream_t *stream = &ctx->stream;
+    uint8_t pos = 0;
+
+    if ( LOADCELL5_STREAM_BUF_SIZE == stream->count ) {
+        // Drop the oldest sample from the running sum and from the sorted window
+        int32_t oldest = stream->sample[ stream->head ];
+        stream->sum -= oldest;
+        while ( stream->sorted[ pos ] != oldest ) {
+            pos++;
+        }
+        for ( ; pos < ( stream->count - 1 ); pos++ ) {
+            stream->sorted[ pos ] = stream->sorted[ pos + 1 ];
+        }
+        stream->count--;
+        stream->sample[ stream->head ] = sample;
+        stream->head = ( stream->head + 1 ) % LOADCELL5_STREAM_BUF_SIZE;
+    }
+    else {
+        stream->sample[ ( stream->head + stream->count ) % LOADCELL5_STREAM_BUF_SIZE ] = sample;
+    }
+
+    // Insertion keeps the window sorted so the median is available in constant time
+    for ( pos = stream->count; ( pos > 0 ) && ( stream->sorted[ pos - 1 ] > sample ); pos-- ) {
+        stream->sorted[ pos ] = stream->sorted[ pos - 1 ];
+    }
+    stream->sorted[ pos ] = sample;
+    stream->count++;
+    stream->sum += sample;
+}
+
 // ------------------------------------------------------------------------- END
@@ -232,6 +232,15 @@ extern "C"{
 #define LOADCELL6_WEIGHT_5000G           5000
 #define LOADCELL6_WEIGHT_10000G          10000
 
+/**
+ * @brief Load Cell 6 stream settings.
+ * @details Specified settings for background acquisition of Load Cell 6 Click driver.
+ * @note Increase buffer size if needed, up to 127 samples.
+ */
+#define LOADCELL6_STREAM_BUF_SIZE        20
+#define LOADCELL6_STREAM_FILTER_AVERAGE  0
+#define LOADCELL6_STREAM_FILTER_MEDIAN   1
+
 /**
  * @brief Data sample selection.
  * @details This macro sets data samples for SPI modules.
@@ -271,6 +280,21 @@ extern "C"{
 /*! @} */ // loadcell6_map
 /*! @} */ // loadcell6
 
+/**
+ * @brief Load Cell 6 Click stream object.
+ * @details Background acquisition ring buffer and running filter state of Load Cell 6 Click driver.
+ */
+typedef struct
+{
+    int32_t sample[ LOADCELL6_STREAM_BUF_SIZE ];    /**< Raw samples in arrival order. */
+    int32_t sorted[ LOADCELL6_STREAM_BUF_SIZE ];    /**< Raw samples sorted for the median filter. */
+    int32_t sum;                                    /**< Running sum of the buffered samples. */
+    uint8_t head;                                   /**< Index of the oldest sample. */
+    uint8_t count;                                  /**< Number of buffered samples. */
+    uint8_t filter;                                 /**< Filter type. */
+
+} loadcell6_stream_t;
+
 /**
  * @brief Load Cell 6 Click context object.
  * @details Context object definition of Load Cell 6 Click driver.
@@ -289,6 +313,9 @@ typedef struct
 
     pin_name_t  chip_select; /**< Chip select pin descriptor (used for SPI driver). */
 
+    // Background acquisition
+    loadcell6_stream_t stream;    /**< Stream ring buffer and filter state. */
+
 } loadcell6_t;
 
 /**
@@ -646,6 +673,51 @@ err_t loadcell6_calibration ( loadcell6_t *ctx, uint16_t cal_val, loadcell6_data
  */
 err_t loadcell6_get_weight ( loadcell6_t *ctx, loadcell6_data_t *cell_data, float *weight_g );
 
+/**
+ * @brief Load Cell 6 stream start function.
+ * @details This function clears the stream ring buffer and selects the running filter
+ * used by the background acquisition.
+ * @param[in] ctx : Click context object.
+ * See #loadcell6_t object definition for detailed explanation.
+ * @param[in] filter : Filter type:
+ *                     @li @c 0 - Moving average,
+ *                     @li @c 1 - Moving median.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note This function also starts the first conversion.
+ */
+err_t loadcell6_stream_start ( loadcell6_t *ctx, uint8_t filter );
+
+/**
+ * @brief Load Cell 6 stream poll function.
+ * @details This function captures a conversion into the stream ring buffer
+ * if the data is ready, without waiting for it.
+ * @param[in] ctx : Click context object.
+ * See #loadcell6_t object definition for detailed explanation.
+ * @return @li @c 0 - No new sample,
+ *         @li @c 1 - New sample captured.
+ * @note Call it from the RDY pin interrupt or the main loop at least at the output data rate.
+ * A failed read leaves the buffer unchanged and the conversion is read again on the next call.
+ */
+uint8_t loadcell6_stream_poll ( loadcell6_t *ctx );
+
+/**
+ * @brief Load Cell 6 stream get weight function.
+ * @details This function calculates the weight from the running filter of the
+ * captured samples without performing any conversions.
+ * @param[in] ctx : Click context object.
+ * See #loadcell6_t object definition for detailed explanation.
+ * @param[in] cell_data : Cell data object.
+ * See #loadcell6_data_t object definition for detailed explanation.
+ * @param[out] weight_g : Filtered weight in grams.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no samples captured.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell6_stream_get_weight ( loadcell6_t *ctx, loadcell6_data_t *cell_data, float *weight_g );
+
 #ifdef __cplusplus
 }
 #endif
@@ -79,6 +79,16 @@ static void dev_sync_delay ( void );
  */
 static void dev_config_delay ( void );
 
+/**
+ * @brief Load Cell 6 stream push function.
+ * @details This function adds a sample to the stream ring buffer and updates the running filter.
+ * @param[in] ctx : Click context object.
+ * See #loadcell6_t object definition for detailed explanation.
+ * @param[in] sample : Raw ADC sample.
+ * @return Nothing.
+ */
+static void dev_stream_push ( loadcell6_t *ctx, int32_t sample );
+
 void loadcell6_cfg_setup ( loadcell6_cfg_t *cfg ) 
 {
     cfg->sck  = HAL_PIN_NC;
@@ -528,6 +538,104 @@ err_t loadcell6_get_weight ( loadcell6_t *ctx, loadcell6_data_t *cell_data, floa
     return error_flag;
 }
 
+err_t loadcell6_stream_start ( loadcell6_t *ctx, uint8_t filter )
+{
+    if ( filter > LOADCELL6_STREAM_FILTER_MEDIAN )
+    {
+        return LOADCELL6_ERROR;
+    }
+    ctx->stream.filter = filter;
+    ctx->stream.head = 0;
+    ctx->stream.count = 0;
+    ctx->stream.sum = 0;
+    return loadcell6_set_command( ctx, LOADCELL6_CMD_START );
+}
+
+uint8_t loadcell6_stream_poll ( loadcell6_t *ctx )
+{
+    uint32_t sample;
+
+    if ( loadcell6_check_data_ready( ctx ) )
+    {
+        return 0;
+    }
+    if ( LOADCELL6_OK != loadcell6_read_reg_data( ctx, LOADCELL6_REG_DATA, &sample ) )
+    {
+        // The conversion stays ready, the next poll reads it again
+        return 0;
+    }
+    // Start the next conversion right away so it runs while the sample is processed
+    loadcell6_set_command( ctx, LOADCELL6_CMD_START );
+    dev_stream_push ( ctx, ( int32_t ) sample );
+    return 1;
+}
+
+err_t loadcell6_stream_get_weight ( loadcell6_t *ctx, loadcell6_data_t *cell_data, float *weight_g )
+{
+    loadcell6_stream_t *stream = &ctx->stream;
+    float weight_val;
+
+    if ( 0 == stream->count )
+    {
+        return LOADCELL6_ERROR;
+    }
+
+    if ( LOADCELL6_STREAM_FILTER_MEDIAN == stream->filter )
+    {
+        weight_val = ( float ) stream->sorted[ stream->count / 2 ];
+        if ( 0 == ( stream->count % 2 ) )
+        {
+            weight_val += ( float ) stream->sorted[ stream->count / 2 - 1 ];
+            weight_val /= 2.0;
+        }
+    }
+    else
+    {
+        weight_val = ( float ) stream->sum;
+        weight_val /= stream->count;
+    }
+
+    weight_val -= cell_data->tare;
+
+    if ( cell_data->weight_data_100g_ok == LOADCELL6_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_100g;
+    }
+
+    if ( cell_data->weight_data_200g_ok == LOADCELL6_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_200g;
+    }
+
+    if ( cell_data->weight_data_500g_ok == LOADCELL6_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_500g;
+    }
+
+    if ( cell_data->weight_data_1000g_ok == LOADCELL6_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_1000g;
+    }
+
+    if ( cell_data->weight_data_5000g_ok == LOADCELL6_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_5000g;
+    }
+
+    if ( cell_data->weight_data_10000g_ok == LOADCELL6_DATA_OK )
+    {
+        weight_val *= cell_data->weight_coeff_10000g;
+    }
+
+    if ( weight_val < 0 )
+    {
+        weight_val = LOADCELL6_WEIGHT_ZERO;
+    }
+
+    *weight_g = weight_val;
+    return LOADCELL6_OK;
+}
+
 static void dev_measure_delay ( void ) 
 {
     Delay_1us( );
@@ -548,4 +656,41 @@ static void dev_config_delay ( void )
     Delay_10ms( );
 }
 
+static void dev_stream_push ( loadcell6_t *ctx, int32_t sample )
+{
+    loadcell6_stream_t *stream = &ctx->stream;
+    uint8_t pos = 0;
+
+    if ( LOADCELL6_STREAM_BUF_SIZE == stream->count )
+    {
+        // Drop the oldest sample from the running sum and from the sorted window
+        int32_t oldest = stream->sample[ stream->head ];
+        stream->sum -= oldest;
+        while ( stream->sorted[ pos ] != oldest )
+        {
+            pos++;
+        }
+        for ( ; pos < ( stream->count - 1 ); pos++ )
+        {
+            stream->sorted[ pos ] = stream->sorted[ pos + 1 ];
+        }
+        stream->count--;
+        stream->sample[ stream->head ] = sample;
+        stream->head = ( stream->head + 1 ) % LOADCELL6_STREAM_BUF_SIZE;
+    }
+    else
+    {
+        stream->sample[ ( stream->head + stream->count ) % LOADCELL6_STREAM_BUF_SIZE ] = sample;
+    }
+
+    // Insertion keeps the window sorted so the median is available in constant time
+    for ( pos = stream->count; ( pos > 0 ) && ( stream->sorted[ pos - 1 ] > sample ); pos-- )
+    {
+        stream->sorted[ pos ] = stream->sorted[ pos - 1 ];
+    }
+    stream->sorted[ pos ] = sample;
+    stream->count++;
+    stream->sum += sample;
+}
+
 // ------------------------------------------------------------------------- END
@@ -73,6 +73,15 @@ extern "C"{
  */
 #define LOADCELL7_NUM_CONVERSIONS           80
 
+/**
+ * @brief Load Cell 7 stream settings.
+ * @details Specified settings for background acquisition of Load Cell 7 Click driver.
+ * @note Increase buffer size if needed, up to 127 samples.
+ */
+#define LOADCELL7_STREAM_BUF_SIZE           20
+#define LOADCELL7_STREAM_FILTER_AVERAGE     0
+#define LOADCELL7_STREAM_FILTER_MEDIAN      1
+
 /**
  * @brief Data sample selection.
  * @details This macro sets data samples for SPI modules.
@@ -109,6 +118,21 @@ extern "C"{
 /*! @} */ // loadcell7_map
 /*! @} */ // loadcell7
 
+/**
+ * @brief Load Cell 7 Click stream object.
+ * @details Background acquisition ring buffer and running filter state of Load Cell 7 Click driver.
+ */
+typedef struct
+{
+    int32_t sample[ LOADCELL7_STREAM_BUF_SIZE ];    /**< Raw samples in arrival order. */
+    int32_t sorted[ LOADCELL7_STREAM_BUF_SIZE ];    /**< Raw samples sorted for the median filter. */
+    int32_t sum;                                    /**< Running sum of the buffered samples. */
+    uint8_t head;                                   /**< Index of the oldest sample. */
+    uint8_t count;                                  /**< Number of buffered samples. */
+    uint8_t filter;                                 /**< Filter type. */
+
+} loadcell7_stream_t;
+
 /**
  * @brief Load Cell 7 Click context object.
  * @details Context object definition of Load Cell 7 Click driver.
@@ -124,6 +148,9 @@ typedef struct
     int32_t      tare_scale;        /**< Tare scale - ADC value of the empty container. */
     float        weight_scale;      /**< Calibrated weight scale. */
 
+    // Background acquisition
+    loadcell7_stream_t stream;    /**< Stream ring buffer and filter state. */
+
 } loadcell7_t;
 
 /**
@@ -261,6 +288,48 @@ err_t loadcell7_calibrate_weight ( loadcell7_t *ctx, float cal_weight );
  */
 err_t loadcell7_get_weight ( loadcell7_t *ctx, float *weight );
 
+/**
+ * @brief Load Cell 7 stream start function.
+ * @details This function clears the stream ring buffer and selects the running filter
+ * used by the background acquisition.
+ * @param[in] ctx : Click context object.
+ * See #loadcell7_t object definition for detailed explanation.
+ * @param[in] filter : Filter type:
+ *                     @li @c 0 - Moving average,
+ *                     @li @c 1 - Moving median.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell7_stream_start ( loadcell7_t *ctx, uint8_t filter );
+
+/**
+ * @brief Load Cell 7 stream poll function.
+ * @details This function captures a conversion into the stream ring buffer
+ * if the data is ready, without waiting for it.
+ * @param[in] ctx : Click context object.
+ * See #loadcell7_t object definition for detailed explanation.
+ * @return @li @c 0 - No new sample,
+ *         @li @c 1 - New sample captured.
+ * @note Call it from the main loop at least at the output data rate.
+ */
+uint8_t loadcell7_stream_poll ( loadcell7_t *ctx );
+
+/**
+ * @brief Load Cell 7 stream get weight function.
+ * @details This function calculates the weight from the running filter of the
+ * captured samples without performing any conversions.
+ * @param[in] ctx : Click context object.
+ * See #loadcell7_t object definition for detailed explanation.
+ * @param[out] weight : Filtered weight in grams.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no samples captured.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell7_stream_get_weight ( loadcell7_t *ctx, float *weight );
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,16 @@
 
 #include "loadcell7.h"
 
+/**
+ * @brief Load Cell 7 stream push function.
+ * @details This function adds a sample to the stream ring buffer and updates the running filter.
+ * @param[in] ctx : Click context object.
+ * See #loadcell7_t object definition for detailed explanation.
+ * @param[in] sample : Raw ADC sample.
+ * @return Nothing.
+ */
+static void loadcell7_stream_push ( loadcell7_t *ctx, int32_t sample );
+
 void loadcell7_cfg_setup ( loadcell7_cfg_t *cfg ) 
 {
     cfg->sck  = HAL_PIN_NC;
@@ -151,4 +161,99 @@ err_t loadcell7_get_weight ( loadcell7_t *ctx, float *weight )
     return error_flag;
 }
 
+err_t loadcell7_stream_start ( loadcell7_t *ctx, uint8_t filter )
+{
+    if ( filter > LOADCELL7_STREAM_FILTER_MEDIAN )
+    {
+        return LOADCELL7_ERROR;
+    }
+    ctx->stream.filter = filter;
+    ctx->stream.head = 0;
+    ctx->stream.count = 0;
+    ctx->stream.sum = 0;
+    return LOADCELL7_OK;
+}
+
+uint8_t loadcell7_stream_poll ( loadcell7_t *ctx )
+{
+    int32_t sample;
+
+    if ( digital_in_read( &ctx->miso ) )
+    {
+        return 0;
+    }
+    if ( LOADCELL7_OK != loadcell7_read_raw_adc ( ctx, &sample ) )
+    {
+        return 0;
+    }
+    loadcell7_stream_push ( ctx, ( int32_t ) sample );
+    return 1;
+}
+
+err_t loadcell7_stream_get_weight ( loadcell7_t *ctx, float *weight )
+{
+    loadcell7_stream_t *stream = &ctx->stream;
+    float weight_val;
+
+    if ( 0 == stream->count )
+    {
+        return LOADCELL7_ERROR;
+    }
+
+    if ( LOADCELL7_STREAM_FILTER_MEDIAN == stream->filter )
+    {
+        weight_val = ( float ) stream->sorted[ stream->count / 2 ];
+        if ( 0 == ( stream->count % 2 ) )
+        {
+            weight_val += ( float ) stream->sorted[ stream->count / 2 - 1 ];
+            weight_val /= 2.0;
+        }
+    }
+    else
+    {
+        weight_val = ( float ) stream->sum;
+        weight_val /= stream->count;
+    }
+
+    *weight = ( weight_val - ctx->tare_scale ) * ctx->weight_scale;
+    return LOADCELL7_OK;
+}
+
+static void loadcell7_stream_push ( loadcell7_t *ctx, int32_t sample )
+{
+    loadcell7_stream_t *stream = &ctx->stream;
+    uint8_t pos = 0;
+
+    if ( LOADCELL7_STREAM_BUF_SIZE == stream->count )
+    {
+        // Drop the oldest sample from the running sum and from the sorted window
+        int32_t oldest = stream->sample[ stream->head ];
+        stream->sum -= oldest;
+        while ( stream->sorted[ pos ] != oldest )
+        {
+            pos++;
+        }
+        for ( ; pos < ( stream->count - 1 ); pos++ )
+        {
+            stream->sorted[ pos ] = stream->sorted[ pos + 1 ];
+        }
+        stream->count--;
+        stream->sample[ stream->head ] = sample;
+        stream->head = ( stream->head + 1 ) % LOADCELL7_STREAM_BUF_SIZE;
+    }
+    else
+    {
+        stream->sample[ ( stream->head + stream->count ) % LOADCELL7_STREAM_BUF_SIZE ] = sample;
+    }
+
+    // Insertion keeps the window sorted so the median is available in constant time
+    for ( pos = stream->count; ( pos > 0 ) && ( stream->sorted[ pos - 1 ] > sample ); pos-- )
+    {
+        stream->sorted[ pos ] = stream->sorted[ pos - 1 ];
+    }
+    stream->sorted[ pos ] = sample;
+    stream->count++;
+    stream->sum += sample;
+}
+
 // ------------------------------------------------------------------------- END
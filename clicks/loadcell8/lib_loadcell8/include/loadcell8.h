@@ -86,6 +86,23 @@ extern "C"{
 #define LOADCELL8_AVG_MEASURE_100     100.0
 #define LOADCELL8_MEASURE_DATA_RES    0x3FFF
 
+/**
+ * @brief Load Cell 8 measurement status setting.
+ * @details Specified setting for status bits of the measurement data of Load Cell 8 Click driver.
+ */
+#define LOADCELL8_STATUS_NORMAL       0x00
+#define LOADCELL8_STATUS_STALE_DATA   0x02
+#define LOADCELL8_STATUS_BIT_MASK     0x03
+
+/**
+ * @brief Load Cell 8 stream settings.
+ * @details Specified settings for background acquisition of Load Cell 8 Click driver.
+ * @note Increase buffer size if needed, up to 127 samples.
+ */
+#define LOADCELL8_STREAM_BUF_SIZE     20
+#define LOADCELL8_STREAM_FILTER_AVERAGE 0
+#define LOADCELL8_STREAM_FILTER_MEDIAN 1
+
 /**
  * @brief Load Cell 8 device address setting.
  * @details Specified setting for device slave address selection of
@@ -118,6 +135,21 @@ extern "C"{
 /*! @} */ // loadcell8_map
 /*! @} */ // loadcell8
 
+/**
+ * @brief Load Cell 8 Click stream object.
+ * @details Background acquisition ring buffer and running filter state of Load Cell 8 Click driver.
+ */
+typedef struct
+{
+    int32_t sample[ LOADCELL8_STREAM_BUF_SIZE ];    /**< Raw samples in arrival order. */
+    int32_t sorted[ LOADCELL8_STREAM_BUF_SIZE ];    /**< Raw samples sorted for the median filter. */
+    int32_t sum;                                    /**< Running sum of the buffered samples. */
+    uint8_t head;                                   /**< Index of the oldest sample. */
+    uint8_t count;                                  /**< Number of buffered samples. */
+    uint8_t filter;                                 /**< Filter type. */
+
+} loadcell8_stream_t;
+
 /**
  * @brief Load Cell 8 Click context object.
  * @details Context object definition of Load Cell 8 Click driver.
@@ -136,6 +168,9 @@ typedef struct
     // I2C slave address
     uint8_t slave_address;    /**< Device slave address (used for I2C driver). */
 
+    // Background acquisition
+    loadcell8_stream_t stream;    /**< Stream ring buffer and filter state. */
+
 } loadcell8_t;
 
 /**
@@ -334,6 +369,50 @@ err_t loadcell8_calibration_weight ( loadcell8_t *ctx, uint16_t cal_val, loadcel
  */
 err_t loadcell8_get_weight ( loadcell8_t *ctx, loadcell8_data_t *cell_data, float *weight_g );
 
+/**
+ * @brief Load Cell 8 stream start function.
+ * @details This function clears the stream ring buffer and selects the running filter
+ * used by the background acquisition.
+ * @param[in] ctx : Click context object.
+ * See #loadcell8_t object definition for detailed explanation.
+ * @param[in] filter : Filter type:
+ *                     @li @c 0 - Moving average,
+ *                     @li @c 1 - Moving median.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell8_stream_start ( loadcell8_t *ctx, uint8_t filter );
+
+/**
+ * @brief Load Cell 8 stream poll function.
+ * @details This function captures a conversion into the stream ring buffer
+ * if the data is ready, without waiting for it.
+ * @param[in] ctx : Click context object.
+ * See #loadcell8_t object definition for detailed explanation.
+ * @return @li @c 0 - No new sample,
+ *         @li @c 1 - New sample captured.
+ * @note Call it from the main loop at least at the output data rate.
+ */
+uint8_t loadcell8_stream_poll ( loadcell8_t *ctx );
+
+/**
+ * @brief Load Cell 8 stream get weight function.
+ * @details This function calculates the weight from the running filter of the
+ * captured samples without performing any conversions.
+ * @param[in] ctx : Click context object.
+ * See #loadcell8_t object definition for detailed explanation.
+ * @param[in] cell_data : Cell data object.
+ * See #loadcell8_data_t object definition for detailed explanation.
+ * @param[out] weight_g : Filtered weight in grams.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no samples captured or negative weight.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t loadcell8_stream_get_weight ( loadcell8_t *ctx, loadcell8_data_t *cell_data, float *weight_g );
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,16 @@
  */
 static err_t loadcell8_get_avr_measure ( loadcell8_t *ctx, float *avr_measure );
 
+/**
+ * @brief Load Cell 8 stream push function.
+ * @details This function adds a sample to the stream ring buffer and updates the running filter.
+ * @param[in] ctx : Click context object.
+ * See #loadcell8_t object definition for detailed explanation.
+ * @param[in] sample : Raw ADC sample.
+ * @return Nothing.
+ */
+static void loadcell8_stream_push ( loadcell8_t *ctx, int32_t sample );
+
 void loadcell8_cfg_setup ( loadcell8_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -251,6 +261,95 @@ err_t loadcell8_get_weight ( loadcell8_t *ctx, loadcell8_data_t *cell_data, floa
     return err_flag;
 }
 
+err_t loadcell8_stream_start ( loadcell8_t *ctx, uint8_t filter )
+{
+    if ( filter > LOADCELL8_STREAM_FILTER_MEDIAN )
+    {
+        return LOADCELL8_ERROR;
+    }
+    ctx->stream.filter = filter;
+    ctx->stream.head = 0;
+    ctx->stream.count = 0;
+    ctx->stream.sum = 0;
+    return LOADCELL8_OK;
+}
+
+uint8_t loadcell8_stream_poll ( loadcell8_t *ctx )
+{
+    uint32_t raw_adc;
+
+    if ( LOADCELL8_OK != loadcell8_read_raw_adc( ctx, &raw_adc ) )
+    {
+        return 0;
+    }
+    // Only fresh conversions are captured, stale data is skipped
+    if ( LOADCELL8_STATUS_NORMAL != ( ( raw_adc >> 30 ) & LOADCELL8_STATUS_BIT_MASK ) )
+    {
+        return 0;
+    }
+    raw_adc >>= 16;
+    raw_adc &= LOADCELL8_MEASURE_DATA_RES;
+    loadcell8_stream_push ( ctx, ( int32_t ) raw_adc );
+    return 1;
+}
+
+err_t loadcell8_stream_get_weight ( loadcell8_t *ctx, loadcell8_data_t *cell_data, float *weight_g )
+{
+    loadcell8_stream_t *stream = &ctx->stream;
+    float weight_val;
+
+    if ( 0 == stream->count )
+    {
+        return LOADCELL8_ERROR;
+    }
+
+    if ( LOADCELL8_STREAM_FILTER_MEDIAN == stream->filter )
+    {
+        weight_val = ( float ) stream->sorted[ stream->count / 2 ];
+        if ( 0 == ( stream->count % 2 ) )
+        {
+            weight_val += ( float ) stream->sorted[ stream->count / 2 - 1 ];
+            weight_val /= 2.0;
+        }
+    }
+    else
+    {
+        weight_val = ( float ) stream->sum;
+        weight_val /= stream->count;
+    }
+
+    weight_val -= cell_data->tare;
+
+    if ( LOADCELL8_DATA_OK == cell_data->weight_data_100g_ok )
+    {
+        weight_val *= cell_data->weight_coeff_100g;
+    }
+    else if ( LOADCELL8_DATA_OK == cell_data->weight_data_500g_ok )
+    {
+        weight_val *= cell_data->weight_coeff_500g;
+    }
+    else if ( LOADCELL8_DATA_OK == cell_data->weight_data_1000g_ok )
+    {
+        weight_val *= cell_data->weight_coeff_1000g;
+    }
+    else if ( LOADCELL8_DATA_OK == cell_data->weight_data_5000g_ok )
+    {
+        weight_val *= cell_data->weight_coeff_5000g;
+    }
+    else if ( LOADCELL8_DATA_OK == cell_data->weight_data_10000g_ok )
+    {
+        weight_val *= cell_data->weight_coeff_10000g;
+    }
+
+    *weight_g = weight_val;
+    if ( weight_val < LOADCELL8_WEIGHT_ZERO )
+    {
+        *weight_g = LOADCELL8_WEIGHT_ZERO;
+        return LOADCELL8_ERROR;
+    }
+    return LOADCELL8_OK;
+}
+
 static err_t loadcell8_get_avr_measure ( loadcell8_t *ctx, float *avr_measure ) 
 {
     err_t err_flag = LOADCELL8_OK;
@@ -267,4 +366,41 @@ static err_t loadcell8_get_avr_measure ( loadcell8_t *ctx, float *avr_measure )
     return err_flag;
 }
 
+static void loadcell8_stream_push ( loadcell8_t *ctx, int32_t sample )
+{
+    loadcell8_stream_t *stream = &ctx->stream;
+    uint8_t pos = 0;
+
+    if ( LOADCELL8_STREAM_BUF_SIZE == stream->count )
+    {
+        // Drop the oldest sample from the running sum and from the sorted window
+        int32_t oldest = stream->sample[ stream->head ];
+        stream->sum -= oldest;
+        while ( stream->sorted[ pos ] != oldest )
+        {
+            pos++;
+        }
+        for ( ; pos < ( stream->count - 1 ); pos++ )
+        {
+            stream->sorted[ pos ] = stream->sorted[ pos + 1 ];
+        }
+        stream->count--;
+        stream->sample[ stream->head ] = sample;
+        stream->head = ( stream->head + 1 ) % LOADCELL8_STREAM_BUF_SIZE;
+    }
+    else
+    {
+        stream->sample[ ( stream->head + stream->count ) % LOADCELL8_STREAM_BUF_SIZE ] = sample;
+    }
+
+    // Insertion keeps the window sorted so the median is available in constant time
+    for ( pos = stream->count; ( pos > 0 ) && ( stream->sorted[ pos - 1 ] > sample ); pos-- )
+    {
+        stream->sorted[ pos ] = stream->sorted[ pos - 1 ];
+    }
+    stream->sorted[ pos ] = sample;
+    stream->count++;
+    stream->sum += sample;
+}
+
 // ------------------------------------------------------------------------- END
@@ -94,6 +94,38 @@ extern "C"{
 #define DRV_RX_BUFFER_SIZE 500
 #define DRV_TX_BUFFER_SIZE 100
 
+/**
+ * @brief LTE Cat.1-EU AT engine settings.
+ * @details Line buffer size, command queue depth and default response timeout of the AT command engine.
+ */
+#define LTECAT1EU_AT_LINE_SIZE                 128
+#define LTECAT1EU_AT_QUEUE_SIZE                4
+#define LTECAT1EU_AT_DEFAULT_TIMEOUT_MS        1000
+
+/**
+ * @brief LTE Cat.1-EU AT command status.
+ * @details Final result codes and engine states of the AT command.
+ */
+#define LTECAT1EU_AT_STATUS_OK                 0
+#define LTECAT1EU_AT_STATUS_CONNECT            1
+#define LTECAT1EU_AT_STATUS_ERROR              2
+#define LTECAT1EU_AT_STATUS_CME_ERROR          3
+#define LTECAT1EU_AT_STATUS_CMS_ERROR          4
+#define LTECAT1EU_AT_STATUS_NO_CARRIER         5
+#define LTECAT1EU_AT_STATUS_BUSY               6
+#define LTECAT1EU_AT_STATUS_NO_ANSWER          7
+#define LTECAT1EU_AT_STATUS_NO_DIALTONE        8
+#define LTECAT1EU_AT_STATUS_PENDING            0xFE
+#define LTECAT1EU_AT_STATUS_TIMEOUT            0xFF
+
+/**
+ * @brief LTE Cat.1-EU AT socket data mode.
+ * @details Encoding of the socket data and its placement after the receive header.
+ */
+#define LTECAT1EU_AT_RX_HEX                    0x01
+#define LTECAT1EU_AT_RX_INLINE                 0x02
+#define LTECAT1EU_AT_RX_QUOTED                 0x04
+
 /*! @} */ // ltecat1eu_set
 
 /**
@@ -121,6 +153,67 @@ extern "C"{
 /*! @} */ // ltecat1eu_map
 /*! @} */ // ltecat1eu
 
+/**
+ * @brief LTE Cat.1-EU AT command object.
+ * @details AT command object, owned by the application until its
+ * completion callback is called. The command is sent as cmd=param.
+ */
+typedef struct ltecat1eu_at_cmd
+{
+    const char *cmd;                /**< Command, e.g. "AT+CSQ". */
+    const char *param;              /**< Parameters sent after '=', NULL if none. */
+    const uint8_t *data;            /**< Data sent after the "> " prompt, NULL if none. */
+    uint16_t data_len;              /**< Data length. */
+    uint32_t timeout_ms;            /**< Response timeout, 0 for default. */
+    void ( *line )( struct ltecat1eu_at_cmd *cmd, char *line );    /**< Response line callback, can be NULL. */
+    void ( *done )( struct ltecat1eu_at_cmd *cmd );                /**< Completion callback, can be NULL. */
+    void *ref;                      /**< User reference. */
+    volatile uint8_t status;        /**< Command status. */
+    int16_t err_code;               /**< +CME/+CMS ERROR code, -1 if not reported. */
+    const char *rx_prefix;          /**< Socket data header, e.g. "+QIRD:", NULL if none. */
+    uint8_t rx_field;               /**< Index of the data length field in the header. */
+    uint8_t rx_mode;                /**< Socket data mode, see #LTECAT1EU_AT_RX_HEX. */
+    uint8_t *rx_buf;                /**< Socket data buffer, NULL to use the data callback. */
+    uint16_t rx_size;               /**< Socket data buffer size. */
+    void ( *rx )( struct ltecat1eu_at_cmd *cmd, uint8_t *data_in, uint16_t len );     /**< Socket data callback, can be NULL. */
+    uint16_t rx_len;                /**< Number of socket data bytes received. */
+
+} ltecat1eu_at_cmd_t;
+
+/**
+ * @brief LTE Cat.1-EU AT unsolicited result code object.
+ * @details Entry of the unsolicited result code table.
+ */
+typedef struct
+{
+    const char *prefix;             /**< Line prefix, e.g. "+CEREG:". */
+    void ( *handler )( char *line, void *ref );             /**< Handler of the matching line. */
+    void *ref;                      /**< User reference passed to the handler. */
+
+} ltecat1eu_at_urc_t;
+
+/**
+ * @brief LTE Cat.1-EU AT engine object.
+ * @details AT command engine state.
+ */
+typedef struct
+{
+    char line[ LTECAT1EU_AT_LINE_SIZE ];   /**< Line being framed. */
+    uint16_t line_len;              /**< Line length. */
+    ltecat1eu_at_cmd_t *queue[ LTECAT1EU_AT_QUEUE_SIZE ];                 /**< Command queue. */
+    uint8_t q_head;                 /**< Queue head index. */
+    uint8_t q_cnt;                  /**< Number of queued commands. */
+    uint8_t state;                  /**< Engine state. */
+    uint8_t tx_step;                /**< Command part being sent. */
+    uint16_t tx_pos;                /**< Number of bytes of the part sent. */
+    uint32_t start_ms;              /**< Command start time. */
+    uint32_t rx_left;               /**< Number of socket data characters left. */
+    uint8_t rx_nibble;              /**< High nibble of the hex byte being decoded. */
+    const ltecat1eu_at_urc_t *urc;         /**< Unsolicited result code table. */
+    uint8_t n_urc;                  /**< Number of table entries. */
+
+} ltecat1eu_at_t;
+
 /**
  * @brief LTE Cat.1-EU Click context object.
  * @details Context object definition of LTE Cat.1-EU Click driver.
@@ -142,6 +235,9 @@ typedef struct
     char uart_rx_buffer[ DRV_RX_BUFFER_SIZE ];         /**< Buffer size. */
     char uart_tx_buffer[ DRV_TX_BUFFER_SIZE ];         /**< Buffer size. */
 
+    // AT command engine
+    ltecat1eu_at_t at;                                     /**< AT command engine. */
+
 } ltecat1eu_t;
 
 /**
@@ -350,6 +446,57 @@ void ltecat1eu_set_sim_apn ( ltecat1eu_t *ctx, char *sim_apn );
  */
 void ltecat1eu_send_text_message ( ltecat1eu_t *ctx, char *phone_number, char *message_context );
 
+/**
+ * @brief LTE Cat.1-EU AT engine initialization function.
+ * @details This function clears the AT command engine and its command queue.
+ * @param[in] ctx : Click context object.
+ * See #ltecat1eu_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void ltecat1eu_at_init ( ltecat1eu_t *ctx );
+
+/**
+ * @brief LTE Cat.1-EU AT URC table setting function.
+ * @details This function sets the table of unsolicited result codes. Lines starting
+ * with a table prefix are passed to its handler instead of the running command.
+ * @param[in] ctx : Click context object.
+ * See #ltecat1eu_t object definition for detailed explanation.
+ * @param[in] urc : Unsolicited result code table, must stay valid while in use.
+ * @param[in] n_urc : Number of table entries.
+ * @return Nothing.
+ * @note Response lines of the running command (e.g. "+CREG:" for AT+CREG?) are not dispatched.
+ */
+void ltecat1eu_at_set_urc_table ( ltecat1eu_t *ctx, const ltecat1eu_at_urc_t *urc, uint8_t n_urc );
+
+/**
+ * @brief LTE Cat.1-EU AT command submit function.
+ * @details This function queues the command. Commands are sent one at a time
+ * by #ltecat1eu_at_process, each with its own response timeout.
+ * @param[in] ctx : Click context object.
+ * See #ltecat1eu_t object definition for detailed explanation.
+ * @param[in] cmd : Command object, must stay valid until completion.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Command status is #LTECAT1EU_AT_STATUS_PENDING until completion.
+ */
+err_t ltecat1eu_at_submit ( ltecat1eu_t *ctx, ltecat1eu_at_cmd_t *cmd );
+
+/**
+ * @brief LTE Cat.1-EU AT engine process function.
+ * @details This function sends queued commands, frames received lines from the UART
+ * ring buffer, completes commands on final result codes or timeout and dispatches
+ * unsolicited result codes. Socket data announced by the receive header of the
+ * running command is streamed to its data buffer or callback.
+ * @param[in] ctx : Click context object.
+ * See #ltecat1eu_t object definition for detailed explanation.
+ * @param[in] time_ms : Current time in milliseconds.
+ * @return Nothing.
+ * @note Call it from the main loop, it never blocks.
+ */
+void ltecat1eu_at_process ( ltecat1eu_t *ctx, uint32_t time_ms );
+
 #ifdef __cplusplus
 }
 #endif
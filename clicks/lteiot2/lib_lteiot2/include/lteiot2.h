@@ -150,6 +150,41 @@
 #define LTEIOT2_CMD_QGPSLOC     "AT+QGPSLOC"
 /** \} */
 
+/**
+ * \defgroup at_engine AT command engine
+ * \{
+ */
+#define LTEIOT2_AT_LINE_SIZE                 128
+#define LTEIOT2_AT_QUEUE_SIZE                4
+#define LTEIOT2_AT_DEFAULT_TIMEOUT_MS        1000
+/** \} */
+
+/**
+ * \defgroup at_status AT command status
+ * \{
+ */
+#define LTEIOT2_AT_STATUS_OK                 0
+#define LTEIOT2_AT_STATUS_CONNECT            1
+#define LTEIOT2_AT_STATUS_ERROR              2
+#define LTEIOT2_AT_STATUS_CME_ERROR          3
+#define LTEIOT2_AT_STATUS_CMS_ERROR          4
+#define LTEIOT2_AT_STATUS_NO_CARRIER         5
+#define LTEIOT2_AT_STATUS_BUSY               6
+#define LTEIOT2_AT_STATUS_NO_ANSWER          7
+#define LTEIOT2_AT_STATUS_NO_DIALTONE        8
+#define LTEIOT2_AT_STATUS_PENDING            0xFE
+#define LTEIOT2_AT_STATUS_TIMEOUT            0xFF
+/** \} */
+
+/**
+ * \defgroup at_rx AT socket data mode
+ * \{
+ */
+#define LTEIOT2_AT_RX_HEX                    0x01
+#define LTEIOT2_AT_RX_INLINE                 0x02
+#define LTEIOT2_AT_RX_QUOTED                 0x04
+/** \} */
+
 /**
  * \defgroup driver Driver define
  * \{
@@ -164,6 +199,67 @@
  * \defgroup type Types
  * \{
  */
+/**
+ * @brief LTE IoT 2 AT command object.
+ * @details AT command object, owned by the application until its
+ * completion callback is called. The command is sent as cmd=param.
+ */
+typedef struct lteiot2_at_cmd
+{
+    const char *cmd;                /**< Command, e.g. "AT+CSQ". */
+    const char *param;              /**< Parameters sent after '=', NULL if none. */
+    const uint8_t *data;            /**< Data sent after the "> " prompt, NULL if none. */
+    uint16_t data_len;              /**< Data length. */
+    uint32_t timeout_ms;            /**< Response timeout, 0 for default. */
+    void ( *line )( struct lteiot2_at_cmd *cmd, char *line );    /**< Response line callback, can be NULL. */
+    void ( *done )( struct lteiot2_at_cmd *cmd );                /**< Completion callback, can be NULL. */
+    void *ref;                      /**< User reference. */
+    volatile uint8_t status;        /**< Command status. */
+    int16_t err_code;               /**< +CME/+CMS ERROR code, -1 if not reported. */
+    const char *rx_prefix;          /**< Socket data header, e.g. "+QIRD:", NULL if none. */
+    uint8_t rx_field;               /**< Index of the data length field in the header. */
+    uint8_t rx_mode;                /**< Socket data mode, see #LTEIOT2_AT_RX_HEX. */
+    uint8_t *rx_buf;                /**< Socket data buffer, NULL to use the data callback. */
+    uint16_t rx_size;               /**< Socket data buffer size. */
+    void ( *rx )( struct lteiot2_at_cmd *cmd, uint8_t *data_in, uint16_t len );     /**< Socket data callback, can be NULL. */
+    uint16_t rx_len;                /**< Number of socket data bytes received. */
+
+} lteiot2_at_cmd_t;
+
+/**
+ * @brief LTE IoT 2 AT unsolicited result code object.
+ * @details Entry of the unsolicited result code table.
+ */
+typedef struct
+{
+    const char *prefix;             /**< Line prefix, e.g. "+CEREG:". */
+    void ( *handler )( char *line, void *ref );             /**< Handler of the matching line. */
+    void *ref;                      /**< User reference passed to the handler. */
+
+} lteiot2_at_urc_t;
+
+/**
+ * @brief LTE IoT 2 AT engine object.
+ * @details AT command engine state.
+ */
+typedef struct
+{
+    char line[ LTEIOT2_AT_LINE_SIZE ];   /**< Line being framed. */
+    uint16_t line_len;              /**< Line length. */
+    lteiot2_at_cmd_t *queue[ LTEIOT2_AT_QUEUE_SIZE ];                 /**< Command queue. */
+    uint8_t q_head;                 /**< Queue head index. */
+    uint8_t q_cnt;                  /**< Number of queued commands. */
+    uint8_t state;                  /**< Engine state. */
+    uint8_t tx_step;                /**< Command part being sent. */
+    uint16_t tx_pos;                /**< Number of bytes of the part sent. */
+    uint32_t start_ms;              /**< Command start time. */
+    uint32_t rx_left;               /**< Number of socket data characters left. */
+    uint8_t rx_nibble;              /**< High nibble of the hex byte being decoded. */
+    const lteiot2_at_urc_t *urc;         /**< Unsolicited result code table. */
+    uint8_t n_urc;                  /**< Number of table entries. */
+
+} lteiot2_at_t;
+
 /**
  * @brief Click ctx object definition.
  */
@@ -188,6 +284,9 @@ typedef struct
     char uart_rx_buffer[ DRV_RX_BUFFER_SIZE ];
     char uart_tx_buffer[ DRV_RX_BUFFER_SIZE ];
 
+    // AT command engine
+    lteiot2_at_t at;                                     /**< AT command engine. */
+
 } lteiot2_t;
 
 /**
@@ -408,6 +507,57 @@ lteiot2_error_t lteiot2_generic_parser
     uint8_t element, char *parser_buf 
 );
 
+/**
+ * @brief LTE IoT 2 AT engine initialization function.
+ * @details This function clears the AT command engine and its command queue.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void lteiot2_at_init ( lteiot2_t *ctx );
+
+/**
+ * @brief LTE IoT 2 AT URC table setting function.
+ * @details This function sets the table of unsolicited result codes. Lines starting
+ * with a table prefix are passed to its handler instead of the running command.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @param[in] urc : Unsolicited result code table, must stay valid while in use.
+ * @param[in] n_urc : Number of table entries.
+ * @return Nothing.
+ * @note Response lines of the running command (e.g. "+CREG:" for AT+CREG?) are not dispatched.
+ */
+void lteiot2_at_set_urc_table ( lteiot2_t *ctx, const lteiot2_at_urc_t *urc, uint8_t n_urc );
+
+/**
+ * @brief LTE IoT 2 AT command submit function.
+ * @details This function queues the command. Commands are sent one at a time
+ * by #lteiot2_at_process, each with its own response timeout.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @param[in] cmd : Command object, must stay valid until completion.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Command status is #LTEIOT2_AT_STATUS_PENDING until completion.
+ */
+err_t lteiot2_at_submit ( lteiot2_t *ctx, lteiot2_at_cmd_t *cmd );
+
+/**
+ * @brief LTE IoT 2 AT engine process function.
+ * @details This function sends queued commands, frames received lines from the UART
+ * ring buffer, completes commands on final result codes or timeout and dispatches
+ * unsolicited result codes. Socket data announced by the receive header of the
+ * running command is streamed to its data buffer or callback.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @param[in] time_ms : Current time in milliseconds.
+ * @return Nothing.
+ * @note Call it from the main loop, it never blocks.
+ */
+void lteiot2_at_process ( lteiot2_t *ctx, uint32_t time_ms );
+
 #ifdef __cplusplus
 }
 #endif
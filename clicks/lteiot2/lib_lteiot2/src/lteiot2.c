@@ -50,6 +50,14 @@
 #define SMS_MAX_7BIT_TEXT_LENGTH            160
 #define SMS_MAX_PDU_LENGTH                  256
 
+#define AT_STATE_IDLE                       0
+#define AT_STATE_SEND                       1
+#define AT_STATE_WAIT                       2
+#define AT_STATE_DATA                       3
+#define AT_STATE_RAW                        4
+#define AT_STATE_RAW_END                    5
+#define AT_CMD_END                          "\r"
+
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
 
 // Checks if the command is supported.
@@ -83,6 +91,98 @@ static int16_t encode_phone_number ( char *phone_number, uint8_t *output_buffer,
  */
 static void lteiot2_str_cut_chr ( char *str, char chr );
 
+/**
+ * @brief LTE IoT 2 AT part writing function.
+ * @details This function writes the rest of the command part to the UART.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @param[in] data_in : Command part.
+ * @param[in] len : Command part length.
+ * @return @li @c 0 - Part not sent completely,
+ *         @li @c 1 - Part sent.
+ * @note None.
+ */
+static uint8_t lteiot2_at_write_part ( lteiot2_t *ctx, const char *data_in, uint16_t len );
+
+/**
+ * @brief LTE IoT 2 AT command sending function.
+ * @details This function sends the command parts or prompted data of the head command.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+static void lteiot2_at_send ( lteiot2_t *ctx );
+
+/**
+ * @brief LTE IoT 2 AT line handling function.
+ * @details This function passes the framed line to the running command or URC handler.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+static void lteiot2_at_rx_line ( lteiot2_t *ctx );
+
+/**
+ * @brief LTE IoT 2 AT final result code function.
+ * @details This function matches the line against final result codes.
+ * @param[in] line : Response line.
+ * @param[out] err_code : +CME/+CMS ERROR code, -1 if not reported.
+ * @return Command status, #LTEIOT2_AT_STATUS_PENDING for other lines.
+ * @note None.
+ */
+static uint8_t lteiot2_at_result ( char *line, int16_t *err_code );
+
+/**
+ * @brief LTE IoT 2 AT command completion function.
+ * @details This function removes the head command from the queue and calls its callback.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @param[in] status : Command status.
+ * @param[in] err_code : +CME/+CMS ERROR code.
+ * @return Nothing.
+ * @note None.
+ */
+static void lteiot2_at_complete ( lteiot2_t *ctx, uint8_t status, int16_t err_code );
+
+/**
+ * @brief LTE IoT 2 AT socket data header function.
+ * @details This function checks the framed line for the socket data header of the
+ * running command and starts streaming of the announced number of data bytes.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @param[in] line_end : 1 if the line is complete, 0 if still being framed.
+ * @return @li @c 0 - Not a socket data header,
+ *         @li @c 1 - Socket data header.
+ * @note None.
+ */
+static uint8_t lteiot2_at_rx_header ( lteiot2_t *ctx, uint8_t line_end );
+
+/**
+ * @brief LTE IoT 2 AT socket data function.
+ * @details This function decodes the socket data in place and stores it to
+ * the command data buffer or passes it to the command data callback.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @param[in,out] data_in : Received socket data.
+ * @param[in] len : Number of received bytes.
+ * @return Number of bytes consumed.
+ * @note None.
+ */
+static uint16_t lteiot2_at_rx_data ( lteiot2_t *ctx, uint8_t *data_in, uint16_t len );
+
+/**
+ * @brief LTE IoT 2 AT socket data direct reading function.
+ * @details This function reads the socket data from the UART ring buffer
+ * directly into the free part of the command data buffer.
+ * @param[in] ctx : Click context object.
+ * See #lteiot2_t object definition for detailed explanation.
+ * @return Number of bytes read.
+ * @note None.
+ */
+static int32_t lteiot2_at_rx_direct ( lteiot2_t *ctx );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void lteiot2_cfg_setup ( lteiot2_cfg_t *cfg )
@@ -365,6 +465,130 @@ lteiot2_error_t lteiot2_generic_parser
     return LTEIOT2_NO_ERROR;
 }
 
+void lteiot2_at_init ( lteiot2_t *ctx )
+{
+    memset( &ctx->at, 0, sizeof( lteiot2_at_t ) );
+    ctx->at.state = AT_STATE_IDLE;
+}
+
+void lteiot2_at_set_urc_table ( lteiot2_t *ctx, const lteiot2_at_urc_t *urc, uint8_t n_urc )
+{
+    ctx->at.urc = urc;
+    ctx->at.n_urc = urc ? n_urc : 0;
+}
+
+err_t lteiot2_at_submit ( lteiot2_t *ctx, lteiot2_at_cmd_t *cmd )
+{
+    lteiot2_at_t *at = &ctx->at;
+
+    if ( ( NULL == cmd ) || ( NULL == cmd->cmd ) || ( at->q_cnt >= LTEIOT2_AT_QUEUE_SIZE ) )
+    {
+        return LTEIOT2_ERROR;
+    }
+    cmd->status = LTEIOT2_AT_STATUS_PENDING;
+    cmd->err_code = -1;
+    cmd->rx_len = 0;
+    at->queue[ ( at->q_head + at->q_cnt ) % LTEIOT2_AT_QUEUE_SIZE ] = cmd;
+    at->q_cnt++;
+
+    return LTEIOT2_OK;
+}
+
+void lteiot2_at_process ( lteiot2_t *ctx, uint32_t time_ms )
+{
+    lteiot2_at_t *at = &ctx->at;
+    uint8_t rx_buf[ 32 ];
+    int32_t rx_len;
+    int32_t cnt;
+    char rx_chr;
+
+    if ( ( AT_STATE_IDLE == at->state ) && at->q_cnt )
+    {
+        at->state = AT_STATE_SEND;
+        at->tx_step = 0;
+        at->tx_pos = 0;
+        at->start_ms = time_ms;
+    }
+    if ( ( AT_STATE_SEND == at->state ) || ( AT_STATE_DATA == at->state ) )
+    {
+        lteiot2_at_send( ctx );
+    }
+
+    // Lines are framed as they arrive, without waiting for the whole response
+    for ( ; ; )
+    {
+        // Socket data goes from the UART ring buffer straight into the caller buffer
+        if ( ( AT_STATE_RAW == at->state ) && ( lteiot2_at_rx_direct( ctx ) > 0 ) )
+        {
+            continue;
+        }
+        rx_len = uart_read( &ctx->uart, rx_buf, sizeof( rx_buf ) );
+        if ( rx_len <= 0 )
+        {
+            break;
+        }
+        cnt = 0;
+        while ( cnt < rx_len )
+        {
+            if ( AT_STATE_RAW == at->state )
+            {
+                cnt += lteiot2_at_rx_data( ctx, &rx_buf[ cnt ], rx_len - cnt );
+                continue;
+            }
+            rx_chr = rx_buf[ cnt++ ];
+            if ( AT_STATE_RAW_END == at->state )
+            {
+                // Rest of the line holding the inline socket data
+                if ( '\n' == rx_chr )
+                {
+                    at->state = AT_STATE_WAIT;
+                }
+            }
+            else if ( '\n' == rx_chr )
+            {
+                at->line[ at->line_len ] = 0;
+                if ( at->line_len )
+                {
+                    lteiot2_at_rx_line( ctx );
+                }
+                at->line_len = 0;
+            }
+            else if ( ( '\r' != rx_chr ) && ( at->line_len || ( ' ' != rx_chr ) ) )
+            {
+                if ( at->line_len < ( LTEIOT2_AT_LINE_SIZE - 1 ) )
+                {
+                    at->line[ at->line_len++ ] = rx_chr;
+                }
+                // Data prompt is not terminated by a new line
+                if ( ( AT_STATE_WAIT == at->state ) && ( 1 == at->line_len ) && ( '>' == rx_chr ) && 
+                     ( NULL != at->queue[ at->q_head ]->data ) )
+                {
+                    at->line_len = 0;
+                    at->tx_pos = 0;
+                    at->state = AT_STATE_DATA;
+                    lteiot2_at_send( ctx );
+                }
+                // Inline socket data follows the header on the same line
+                if ( ( AT_STATE_WAIT == at->state ) && ( ( ',' == rx_chr ) || ( '"' == rx_chr ) ) )
+                {
+                    lteiot2_at_rx_header( ctx, 0 );
+                }
+            }
+        }
+    }
+
+    if ( AT_STATE_IDLE != at->state )
+    {
+        uint32_t timeout_ms = at->queue[ at->q_head ]->timeout_ms;
+        if ( ( time_ms - at->start_ms ) >= ( timeout_ms ? timeout_ms : LTEIOT2_AT_DEFAULT_TIMEOUT_MS ) )
+        {
+            // An unterminated echo of the silent command would prefix the next line
+            at->line_len = 0;
+            lteiot2_at_complete( ctx, LTEIOT2_AT_STATUS_TIMEOUT, -1 );
+        }
+    }
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static uint8_t check_support_command ( uint8_t command, uint8_t element, char *command_buf )
@@ -541,5 +765,358 @@ static void lteiot2_str_cut_chr ( char *str, char chr )
     }
 }
 
+static uint8_t lteiot2_at_write_part ( lteiot2_t *ctx, const char *data_in, uint16_t len )
+{
+    lteiot2_at_t *at = &ctx->at;
+
+    if ( at->tx_pos < len )
+    {
+        int32_t tx_len = uart_write( &ctx->uart, ( char * ) &data_in[ at->tx_pos ], len - at->tx_pos );
+        if ( tx_len > 0 )
+        {
+            at->tx_pos += tx_len;
+        }
+    }
+    if ( at->tx_pos < len )
+    {
+        return 0;
+    }
+    at->tx_pos = 0;
+
+    return 1;
+}
+
+static void lteiot2_at_send ( lteiot2_t *ctx )
+{
+    lteiot2_at_t *at = &ctx->at;
+    lteiot2_at_cmd_t *cmd = at->queue[ at->q_head ];
+    const char *part;
+
+    if ( AT_STATE_DATA == at->state )
+    {
+        if ( lteiot2_at_write_part( ctx, ( const char * ) cmd->data, cmd->data_len ) )
+        {
+            at->state = AT_STATE_WAIT;
+        }
+        return;
+    }
+
+    // Command is sent in parts, no intermediate buffer is needed
+    while ( AT_STATE_SEND == at->state )
+    {
+        switch ( at->tx_step )
+        {
+            case 0:
+            {
+                part = cmd->cmd;
+                break;
+            }
+            case 1:
+            {
+                part = cmd->param ? "=" : "";
+                break;
+            }
+            case 2:
+            {
+                part = cmd->param ? cmd->param : "";
+                break;
+            }
+            default:
+            {
+                part = AT_CMD_END;
+                break;
+            }
+        }
+        if ( !lteiot2_at_write_part( ctx, part, strlen( part ) ) )
+        {
+            return;
+        }
+        if ( ++at->tx_step > 3 )
+        {
+            at->state = AT_STATE_WAIT;
+        }
+    }
+}
+
+static void lteiot2_at_rx_line ( lteiot2_t *ctx )
+{
+    lteiot2_at_t *at = &ctx->at;
+    lteiot2_at_cmd_t *cmd = NULL;
+    uint16_t name_len = 0;
+    uint8_t status;
+    int16_t err_code;
+
+    if ( AT_STATE_IDLE != at->state )
+    {
+        cmd = at->queue[ at->q_head ];
+        // Command echo
+        if ( 0 == strncmp( at->line, cmd->cmd, strlen( cmd->cmd ) ) )
+        {
+            return;
+        }
+        // Socket data header, the data follows on the next line
+        if ( lteiot2_at_rx_header( ctx, 1 ) )
+        {
+            return;
+        }
+        status = lteiot2_at_result( at->line, &err_code );
+        if ( LTEIOT2_AT_STATUS_PENDING != status )
+        {
+            lteiot2_at_complete( ctx, status, err_code );
+            return;
+        }
+        // Information response prefix, e.g. "+CSQ" for AT+CSQ
+        if ( 0 == strncmp( cmd->cmd, "AT", 2 ) )
+        {
+            while ( cmd->cmd[ name_len + 2 ] && ( '=' != cmd->cmd[ name_len + 2 ] ) && 
+                    ( '?' != cmd->cmd[ name_len + 2 ] ) )
+            {
+                name_len++;
+            }
+        }
+        if ( ( name_len > 1 ) && ( ':' == at->line[ name_len ] ) && 
+             ( 0 == strncmp( at->line, &cmd->cmd[ 2 ], name_len ) ) )
+        {
+            if ( NULL != cmd->line )
+            {
+                cmd->line( cmd, at->line );
+            }
+            return;
+        }
+    }
+
+    for ( uint8_t cnt = 0; cnt < at->n_urc; cnt++ )
+    {
+        if ( 0 == strncmp( at->line, at->urc[ cnt ].prefix, strlen( at->urc[ cnt ].prefix ) ) )
+        {
+            at->urc[ cnt ].handler( at->line, at->urc[ cnt ].ref );
+            return;
+        }
+    }
+
+    if ( ( NULL != cmd ) && ( NULL != cmd->line ) )
+    {
+        cmd->line( cmd, at->line );
+    }
+}
+
+static uint8_t lteiot2_at_result ( char *line, int16_t *err_code )
+{
+    // Indexed by command status
+    static const char * const result_code[ ] = 
+    {
+        "OK", "CONNECT", "ERROR", "+CME ERROR:", "+CMS ERROR:", 
+        "NO CARRIER", "BUSY", "NO ANSWER", "NO DIALTONE"
+    };
+    uint8_t len;
+
+    *err_code = -1;
+    for ( uint8_t cnt = 0; cnt < ( sizeof( result_code ) / sizeof( result_code[ 0 ] ) ); cnt++ )
+    {
+        len = strlen( result_code[ cnt ] );
+        if ( strncmp( line, result_code[ cnt ], len ) )
+        {
+            continue;
+        }
+        if ( ( LTEIOT2_AT_STATUS_CME_ERROR == cnt ) || ( LTEIOT2_AT_STATUS_CMS_ERROR == cnt ) )
+        {
+            while ( ' ' == line[ len ] )
+            {
+                len++;
+            }
+            if ( ( line[ len ] >= '0' ) && ( line[ len ] <= '9' ) )
+            {
+                *err_code = 0;
+                while ( ( line[ len ] >= '0' ) && ( line[ len ] <= '9' ) && ( *err_code < 10000 ) )
+                {
+                    *err_code = *err_code * 10 + ( line[ len++ ] - '0' );
+                }
+            }
+            return cnt;
+        }
+        // CONNECT may be followed by the connection speed
+        if ( ( 0 == line[ len ] ) || ( ( LTEIOT2_AT_STATUS_CONNECT == cnt ) && ( ' ' == line[ len ] ) ) )
+        {
+            return cnt;
+        }
+    }
+    // Result of data sent after the prompt
+    if ( 0 == strcmp( line, "SEND OK" ) )
+    {
+        return LTEIOT2_AT_STATUS_OK;
+    }
+    if ( 0 == strcmp( line, "SEND FAIL" ) )
+    {
+        return LTEIOT2_AT_STATUS_ERROR;
+    }
+
+    return LTEIOT2_AT_STATUS_PENDING;
+}
+
+static void lteiot2_at_complete ( lteiot2_t *ctx, uint8_t status, int16_t err_code )
+{
+    lteiot2_at_t *at = &ctx->at;
+    lteiot2_at_cmd_t *cmd = at->queue[ at->q_head ];
+
+    at->q_head = ( at->q_head + 1 ) % LTEIOT2_AT_QUEUE_SIZE;
+    at->q_cnt--;
+    at->state = AT_STATE_IDLE;
+    cmd->err_code = err_code;
+    cmd->status = status;
+    if ( NULL != cmd->done )
+    {
+        cmd->done( cmd );
+    }
+}
+
+static uint8_t lteiot2_at_rx_header ( lteiot2_t *ctx, uint8_t line_end )
+{
+    lteiot2_at_t *at = &ctx->at;
+    lteiot2_at_cmd_t *cmd = at->queue[ at->q_head ];
+    uint8_t inline_data = cmd->rx_mode & ( LTEIOT2_AT_RX_INLINE | LTEIOT2_AT_RX_QUOTED );
+    uint32_t data_len = 0;
+    uint16_t prefix_len;
+    uint8_t field = 0;
+
+    if ( ( NULL == cmd->rx_prefix ) || ( !line_end && !inline_data ) )
+    {
+        return 0;
+    }
+    prefix_len = strlen( cmd->rx_prefix );
+    if ( ( at->line_len < prefix_len ) || strncmp( at->line, cmd->rx_prefix, prefix_len ) )
+    {
+        return 0;
+    }
+    for ( uint16_t cnt = prefix_len; cnt < at->line_len; cnt++ )
+    {
+        if ( ',' == at->line[ cnt ] )
+        {
+            field++;
+        }
+        else if ( ( field == cmd->rx_field ) && ( at->line[ cnt ] >= '0' ) && ( at->line[ cnt ] <= '9' ) && 
+                  ( data_len < 0xFFFF ) )
+        {
+            data_len = data_len * 10 + ( at->line[ cnt ] - '0' );
+        }
+    }
+    if ( !line_end )
+    {
+        // Data starts after the field following the length, or after its opening quote
+        if ( ( field != ( cmd->rx_field + 1 ) ) || 
+             ( ( cmd->rx_mode & LTEIOT2_AT_RX_QUOTED ) ? 
+               ( ( '"' != at->line[ at->line_len - 1 ] ) || ( ',' != at->line[ at->line_len - 2 ] ) ) : 
+               ( ',' != at->line[ at->line_len - 1 ] ) ) )
+        {
+            return 0;
+        }
+    }
+    else if ( inline_data )
+    {
+        // Header without data, e.g. "+CARECV: 0"
+        return 1;
+    }
+
+    at->line_len = 0;
+    if ( data_len )
+    {
+        at->rx_left = ( cmd->rx_mode & LTEIOT2_AT_RX_HEX ) ? ( data_len * 2 ) : data_len;
+        at->state = AT_STATE_RAW;
+    }
+    else if ( !line_end )
+    {
+        at->state = AT_STATE_RAW_END;
+    }
+
+    return 1;
+}
+
+static uint16_t lteiot2_at_rx_data ( lteiot2_t *ctx, uint8_t *data_in, uint16_t len )
+{
+    lteiot2_at_t *at = &ctx->at;
+    lteiot2_at_cmd_t *cmd = at->queue[ at->q_head ];
+    uint16_t out_len = len;
+    uint8_t nibble;
+
+    if ( len > at->rx_left )
+    {
+        len = at->rx_left;
+        out_len = len;
+    }
+    if ( cmd->rx_mode & LTEIOT2_AT_RX_HEX )
+    {
+        // Decoded in place, each byte overwrites the first of its two characters
+        out_len = 0;
+        for ( uint16_t cnt = 0; cnt < len; cnt++ )
+        {
+            nibble = data_in[ cnt ];
+            nibble = ( nibble <= '9' ) ? ( nibble - '0' ) : ( ( nibble | 0x20 ) - 'a' + 10 );
+            if ( ( at->rx_left - cnt ) & 1 )
+            {
+                data_in[ out_len++ ] = ( at->rx_nibble << 4 ) | ( nibble & 0x0F );
+            }
+            else
+            {
+                at->rx_nibble = nibble & 0x0F;
+            }
+        }
+    }
+    at->rx_left -= len;
+
+    if ( NULL != cmd->rx_buf )
+    {
+        // Data exceeding the buffer is discarded
+        if ( out_len > ( cmd->rx_size - cmd->rx_len ) )
+        {
+            out_len = cmd->rx_size - cmd->rx_len;
+        }
+        if ( data_in != &cmd->rx_buf[ cmd->rx_len ] )
+        {
+            memcpy( &cmd->rx_buf[ cmd->rx_len ], data_in, out_len );
+        }
+        cmd->rx_len += out_len;
+    }
+    else if ( out_len )
+    {
+        cmd->rx_len += out_len;
+        if ( NULL != cmd->rx )
+        {
+            cmd->rx( cmd, data_in, out_len );
+        }
+    }
+
+    if ( 0 == at->rx_left )
+    {
+        at->state = ( cmd->rx_mode & ( LTEIOT2_AT_RX_INLINE | LTEIOT2_AT_RX_QUOTED ) ) ? AT_STATE_RAW_END : AT_STATE_WAIT;
+    }
+
+    return len;
+}
+
+static int32_t lteiot2_at_rx_direct ( lteiot2_t *ctx )
+{
+    lteiot2_at_t *at = &ctx->at;
+    lteiot2_at_cmd_t *cmd = at->queue[ at->q_head ];
+    uint32_t len;
+    int32_t rx_len;
+
+    if ( ( NULL == cmd->rx_buf ) || ( cmd->rx_len >= cmd->rx_size ) )
+    {
+        return 0;
+    }
+    // Hex characters are decoded into the first half of the space they are read to
+    len = cmd->rx_size - cmd->rx_len;
+    if ( len > at->rx_left )
+    {
+        len = at->rx_left;
+    }
+    rx_len = uart_read( &ctx->uart, &cmd->rx_buf[ cmd->rx_len ], len );
+    if ( rx_len > 0 )
+    {
+        lteiot2_at_rx_data( ctx, &cmd->rx_buf[ cmd->rx_len ], rx_len );
+    }
+
+    return rx_len;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -1888,6 +1888,9 @@ typedef struct
 
     mcp251863_data_t glb_data;
     mcp251863_func_data_t func_data;
+
+    uint8_t spi_transmit_buffer[ MCP251863_SPI_DEFAULT_BUFFER_LENGTH ];  /**< SPI transmit buffer. */
+    uint8_t spi_receive_buffer[ MCP251863_SPI_DEFAULT_BUFFER_LENGTH ];   /**< SPI receive buffer. */
     
 } mcp251863_t;
 
@@ -2033,6 +2036,58 @@ err_t mcp251863_transmit_message ( mcp251863_t *ctx, uint8_t *data_in, uint16_t
  */
 err_t mcp251863_receive_message ( mcp251863_t *ctx, uint8_t *data_out, uint16_t *data_len );
 
+/**
+ * @brief Burst message transmit function.
+ * @details Loads up to @b num_msg messages into the TX FIFO back-to-back. The FIFO status is
+ * read once and the number of free message objects is derived from the empty, half and not full
+ * flags, so no status polling is done between the messages. The transmit request is set together
+ * with the last user address increment of each batch.
+ * @param[in] ctx : Click context object.
+ * See #mcp251863_t object definition for detailed explanation.
+ * @param[in] channel : TX FIFO channel.
+ * @param[in] tx_obj : Array of @b num_msg TX message objects.
+ * @param[in] data_in : Payloads of the messages, one every @b data_stride bytes.
+ * @param[in] data_stride : Payload slot size in bytes.
+ * @param[in] num_msg : Number of messages to be sent.
+ * @param[out] num_sent : Number of messages loaded into the FIFO.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Read error,
+ *         @li @c -2 - Channel is not a TX FIFO,
+ *         @li @c -3 - Message payload larger than data stride,
+ *         @li @c -4 - Write byte array error,
+ *         @li @c -5 - Transmit channel update error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note Loading stops when the FIFO is full, @b num_sent may be lower than @b num_msg.
+ */
+err_t mcp251863_transmit_burst ( mcp251863_t *ctx, uint8_t channel, mcp251863_tx_msg_obj_t *tx_obj, 
+                                 uint8_t *data_in, uint8_t data_stride, uint8_t num_msg, uint8_t *num_sent );
+
+/**
+ * @brief Burst message receive function.
+ * @details Drains up to @b max_msg messages from the RX FIFO back-to-back. The FIFO status is
+ * read once and the number of pending messages is derived from the full, half and not empty
+ * flags, so no status polling is done between the messages. Message objects and payloads are
+ * read directly into the caller buffers.
+ * @param[in] ctx : Click context object.
+ * See #mcp251863_t object definition for detailed explanation.
+ * @param[in] channel : RX FIFO channel.
+ * @param[out] rx_obj : Array of at least @b max_msg RX message objects.
+ * @param[out] data_out : Payloads of the messages, one every @b data_stride bytes.
+ * @param[in] data_stride : Payload slot size in bytes, longer payloads are truncated.
+ * @param[in] max_msg : Maximal number of messages to be read.
+ * @param[out] num_msg : Number of messages read.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Read error,
+ *         @li @c -2 - Channel is not a RX FIFO,
+ *         @li @c -3 - Read byte array error,
+ *         @li @c -4 - Receiver channel update error.
+ *
+ * See #err_t definition for detailed explanation.
+ */
+err_t mcp251863_receive_burst ( mcp251863_t *ctx, uint8_t channel, mcp251863_rx_msg_obj_t *rx_obj, 
+                                uint8_t *data_out, uint8_t data_stride, uint8_t max_msg, uint8_t *num_msg );
+
 /**
  * @brief Reset function
  * @details Function for reset using generic transfer
@@ -2593,7 +2648,9 @@ err_t mcp251863_receive_channel_status_get ( mcp251863_t *ctx, uint8_t channel,
 
 /**
  * @brief Get Received Message.
- * @details Reads Received message from channel.
+ * @details Reads Received message from channel. The FIFO control, status and user address
+ * registers are read in one transfer, then the message object is read directly into
+ * @b rx_obj and the received payload into @b ctx->func_data.rxd in a second transfer.
  * @param[in] ctx : Click context object.
  * See #mcp251863_t object definition for detailed explanation. 
  * @param[in] cannel : Channel.
@@ -132,13 +132,29 @@ static uint32_t mcp2518_control_reset_values[ ] =
 
 #endif
 
-// ------------------------------------------------------------------ VARIABLES
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
-// SPI Transmit buffer
-static uint8_t spi_transmit_buffer[ MCP251863_SPI_DEFAULT_BUFFER_LENGTH ];
+/**
+ * @brief Message object RAM address.
+ * @details Converts the FIFO user address register value to the RAM address.
+ */
+static uint16_t mcp251863_user_address_to_ram ( uint32_t user_address );
+
+/**
+ * @brief RX message object read.
+ * @details Reads the message object header directly into @b rx_obj and the received
+ * payload (up to @b max_bytes) directly into @b data_out in a single SPI transfer.
+ */
+static err_t mcp251863_rx_object_read ( mcp251863_t *ctx, uint16_t address, bool time_stamp, 
+                                        mcp251863_rx_msg_obj_t *rx_obj, uint8_t *data_out, uint16_t max_bytes );
 
-// SPI Receive buffer
-static uint8_t spi_receive_buffer[ MCP251863_SPI_DEFAULT_BUFFER_LENGTH ];
+/**
+ * @brief TX message object write.
+ * @details Writes the message object header from @b tx_obj and @b n_bytes of payload
+ * from @b data_in in a single SPI transfer.
+ */
+static err_t mcp251863_tx_object_write ( mcp251863_t *ctx, uint16_t address, 
+                                         mcp251863_tx_msg_obj_t *tx_obj, uint8_t *data_in, uint8_t n_bytes );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -393,15 +409,209 @@ err_t mcp251863_receive_message ( mcp251863_t *ctx, uint8_t *data_out, uint16_t
     return MCP251863_OK;
 }
 
+err_t mcp251863_transmit_burst ( mcp251863_t *ctx, uint8_t channel, mcp251863_tx_msg_obj_t *tx_obj, 
+                                 uint8_t *data_in, uint8_t data_stride, uint8_t num_msg, uint8_t *num_sent )
+{
+    uint16_t address;
+    uint8_t fifo_depth;
+    uint8_t available;
+    uint8_t n_bytes;
+    uint32_t fifo_reg[ 3 ];
+    mcp251863_fifo_ctl_t ci_fifo_con;
+    mcp251863_fifo_stat_t ci_fifo_sta;
+    mcp251863_fifo_user_cfg_t ci_fifo_ua;
+    err_t error_flag;
+
+    *num_sent = 0;
+    address = MCP251863_REG_CIFIFOCON + ( channel * MCP251863_FIFO_OFFSET );
+
+    error_flag = mcp251863_read_word_array( ctx, address, fifo_reg, 3 );
+    if ( error_flag == MCP251863_ERROR ) 
+    {
+        return -1;
+    }
+
+    ci_fifo_con.word = fifo_reg[ 0 ];
+    if ( !ci_fifo_con.tx_bf.tx_enable ) 
+    {
+        return -2;
+    }
+    fifo_depth = ci_fifo_con.tx_bf.fifo_size + 1;
+    ci_fifo_sta.word = fifo_reg[ 1 ];
+    ci_fifo_ua.word = fifo_reg[ 2 ];
+
+    while ( ( *num_sent < num_msg ) && ci_fifo_sta.tx_bf.tx_not_full_if )
+    {
+        // Number of free message objects guaranteed by the status flags
+        if ( ci_fifo_sta.tx_bf.tx_empty_if ) 
+        {
+            available = fifo_depth;
+        } 
+        else if ( ci_fifo_sta.tx_bf.tx_half_full_if && ( fifo_depth > 1 ) ) 
+        {
+            available = fifo_depth / 2;
+        } 
+        else 
+        {
+            available = 1;
+        }
+
+        while ( available && ( *num_sent < num_msg ) )
+        {
+            n_bytes = ( uint8_t ) mcp251863_dlc_to_data_bytes( ( uint8_t ) tx_obj[ *num_sent ].bf.ctrl.dlc );
+            if ( n_bytes > data_stride ) 
+            {
+                return -3;
+            }
+
+            address = mcp251863_user_address_to_ram( ci_fifo_ua.word );
+            error_flag = mcp251863_tx_object_write( ctx, address, &tx_obj[ *num_sent ], 
+                                                    &data_in[ ( uint16_t ) *num_sent * data_stride ], n_bytes );
+            if ( error_flag == MCP251863_ERROR ) 
+            {
+                return -4;
+            }
+
+            ( *num_sent )++;
+            available--;
+
+            // Transmit request is set only with the last increment of the batch
+            error_flag = mcp251863_transmit_channel_update( ctx, channel, 
+                                                            ( 0 == available ) || ( *num_sent == num_msg ) );
+            if ( error_flag == MCP251863_ERROR ) 
+            {
+                return -5;
+            }
+
+            if ( available && ( *num_sent < num_msg ) ) 
+            {
+                address = MCP251863_REG_CIFIFOUA + ( channel * MCP251863_FIFO_OFFSET );
+                error_flag = mcp251863_read_word( ctx, address, &ci_fifo_ua.word );
+                if ( error_flag == MCP251863_ERROR ) 
+                {
+                    return -1;
+                }
+            }
+        }
+
+        if ( *num_sent < num_msg ) 
+        {
+            address = MCP251863_REG_CIFIFOSTA + ( channel * MCP251863_FIFO_OFFSET );
+            error_flag = mcp251863_read_word_array( ctx, address, fifo_reg, 2 );
+            if ( error_flag == MCP251863_ERROR ) 
+            {
+                return -1;
+            }
+            ci_fifo_sta.word = fifo_reg[ 0 ];
+            ci_fifo_ua.word = fifo_reg[ 1 ];
+        }
+    }
+
+    return MCP251863_OK;
+}
+
+err_t mcp251863_receive_burst ( mcp251863_t *ctx, uint8_t channel, mcp251863_rx_msg_obj_t *rx_obj, 
+                                uint8_t *data_out, uint8_t data_stride, uint8_t max_msg, uint8_t *num_msg )
+{
+    uint16_t address;
+    uint8_t fifo_depth;
+    uint8_t available;
+    uint32_t fifo_reg[ 3 ];
+    mcp251863_fifo_ctl_t ci_fifo_con;
+    mcp251863_fifo_stat_t ci_fifo_sta;
+    mcp251863_fifo_user_cfg_t ci_fifo_ua;
+    err_t error_flag;
+
+    *num_msg = 0;
+    address = MCP251863_REG_CIFIFOCON + ( channel * MCP251863_FIFO_OFFSET );
+
+    error_flag = mcp251863_read_word_array( ctx, address, fifo_reg, 3 );
+    if ( error_flag == MCP251863_ERROR ) 
+    {
+        return -1;
+    }
+
+    ci_fifo_con.word = fifo_reg[ 0 ];
+    if ( ci_fifo_con.rx_bf.tx_enable ) 
+    {
+        return -2;
+    }
+    fifo_depth = ci_fifo_con.rx_bf.fifo_size + 1;
+    ci_fifo_sta.word = fifo_reg[ 1 ];
+    ci_fifo_ua.word = fifo_reg[ 2 ];
+
+    while ( ( *num_msg < max_msg ) && ci_fifo_sta.rx_bf.rx_not_empty_if )
+    {
+        // Number of pending messages guaranteed by the status flags
+        if ( ci_fifo_sta.rx_bf.rx_full_if ) 
+        {
+            available = fifo_depth;
+        } 
+        else if ( ci_fifo_sta.rx_bf.rx_half_full_if && ( fifo_depth > 1 ) ) 
+        {
+            available = fifo_depth / 2;
+        } 
+        else 
+        {
+            available = 1;
+        }
+
+        while ( available && ( *num_msg < max_msg ) )
+        {
+            address = mcp251863_user_address_to_ram( ci_fifo_ua.word );
+            error_flag = mcp251863_rx_object_read( ctx, address, ci_fifo_con.rx_bf.rx_time_stamp_enable, 
+                                                   &rx_obj[ *num_msg ], 
+                                                   &data_out[ ( uint16_t ) *num_msg * data_stride ], data_stride );
+            if ( error_flag == MCP251863_ERROR ) 
+            {
+                return -3;
+            }
+
+            error_flag = mcp251863_receive_channel_update( ctx, channel );
+            if ( error_flag == MCP251863_ERROR ) 
+            {
+                return -4;
+            }
+
+            ( *num_msg )++;
+            available--;
+
+            if ( available && ( *num_msg < max_msg ) ) 
+            {
+                address = MCP251863_REG_CIFIFOUA + ( channel * MCP251863_FIFO_OFFSET );
+                error_flag = mcp251863_read_word( ctx, address, &ci_fifo_ua.word );
+                if ( error_flag == MCP251863_ERROR ) 
+                {
+                    return -1;
+                }
+            }
+        }
+
+        if ( *num_msg < max_msg ) 
+        {
+            address = MCP251863_REG_CIFIFOSTA + ( channel * MCP251863_FIFO_OFFSET );
+            error_flag = mcp251863_read_word_array( ctx, address, fifo_reg, 2 );
+            if ( error_flag == MCP251863_ERROR ) 
+            {
+                return -1;
+            }
+            ci_fifo_sta.word = fifo_reg[ 0 ];
+            ci_fifo_ua.word = fifo_reg[ 1 ];
+        }
+    }
+
+    return MCP251863_OK;
+}
+
 err_t mcp251863_reset ( mcp251863_t *ctx )
 {
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( MCP251863_INS_RESET << 4 );
-    spi_transmit_buffer[ 1 ] = 0;
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( MCP251863_INS_RESET << 4 );
+    ctx->spi_transmit_buffer[ 1 ] = 0;
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write( &ctx->spi, spi_transmit_buffer, 2);
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, 2);
     spi_master_deselect_device( ctx->chip_select );  
 
     return error_flag;
@@ -411,14 +621,14 @@ err_t mcp251863_read_byte ( mcp251863_t *ctx, uint16_t address, uint8_t *data_ou
 {
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write_then_read( &ctx->spi, spi_transmit_buffer, 2, spi_receive_buffer, 1 );
+    error_flag = spi_master_write_then_read( &ctx->spi, ctx->spi_transmit_buffer, 2, ctx->spi_receive_buffer, 1 );
     spi_master_deselect_device( ctx->chip_select );  
     
-    *data_out = spi_receive_buffer[ 0 ];
+    *data_out = ctx->spi_receive_buffer[ 0 ];
 
     return error_flag;
 }
@@ -427,12 +637,12 @@ err_t mcp251863_write_byte ( mcp251863_t *ctx, uint16_t address, uint8_t data_in
 {
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
-    spi_transmit_buffer[ 2 ] = data_in;
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    ctx->spi_transmit_buffer[ 2 ] = data_in;
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write( &ctx->spi, spi_transmit_buffer, 3 );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, 3 );
     spi_master_deselect_device( ctx->chip_select );
     
     return error_flag;
@@ -443,11 +653,11 @@ err_t mcp251863_read_word ( mcp251863_t *ctx, uint16_t address, uint32_t *data_o
     uint32_t temp;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write_then_read( &ctx->spi, spi_transmit_buffer, 2, spi_receive_buffer, 4 );
+    error_flag = spi_master_write_then_read( &ctx->spi, ctx->spi_transmit_buffer, 2, ctx->spi_receive_buffer, 4 );
     spi_master_deselect_device( ctx->chip_select );
     if ( error_flag == MCP251863_ERROR ) 
     {
@@ -457,7 +667,7 @@ err_t mcp251863_read_word ( mcp251863_t *ctx, uint16_t address, uint32_t *data_o
     *data_out = 0;
     for ( uint8_t cnt = 0; cnt < 4; cnt++ ) 
     {
-        temp = ( uint32_t ) spi_receive_buffer[ cnt ];
+        temp = ( uint32_t ) ctx->spi_receive_buffer[ cnt ];
         *data_out += temp << ( cnt * 8 );
     }
 
@@ -469,16 +679,16 @@ err_t mcp251863_write_word ( mcp251863_t *ctx, uint16_t address, uint32_t data_i
     uint8_t cnt;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
 
     for ( cnt = 0; cnt < 4; cnt++ ) 
     {
-        spi_transmit_buffer[ cnt + 2 ] = ( uint8_t ) ( ( data_in >> ( cnt * 8 ) ) & 0xFF );
+        ctx->spi_transmit_buffer[ cnt + 2 ] = ( uint8_t ) ( ( data_in >> ( cnt * 8 ) ) & 0xFF );
     }
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write( &ctx->spi, spi_transmit_buffer, 6 );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, 6 );
     spi_master_deselect_device( ctx->chip_select );
     return error_flag;
 }
@@ -488,11 +698,11 @@ err_t mcp251863_read_half_word ( mcp251863_t *ctx, uint16_t address, uint16_t *d
     uint32_t temp;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write_then_read( &ctx->spi, spi_transmit_buffer, 2, spi_receive_buffer, 2 );
+    error_flag = spi_master_write_then_read( &ctx->spi, ctx->spi_transmit_buffer, 2, ctx->spi_receive_buffer, 2 );
     spi_master_deselect_device( ctx->chip_select );
 
     if ( error_flag == MCP251863_ERROR ) 
@@ -503,7 +713,7 @@ err_t mcp251863_read_half_word ( mcp251863_t *ctx, uint16_t address, uint16_t *d
     *data_out = 0;
     for ( uint8_t cnt = 0; cnt < 2; cnt++ ) 
     {
-        temp = ( uint32_t ) spi_receive_buffer[ cnt ];
+        temp = ( uint32_t ) ctx->spi_receive_buffer[ cnt ];
         *data_out += temp << ( cnt * 8 );
     }
 
@@ -515,16 +725,16 @@ err_t mcp251863_write_half_word ( mcp251863_t *ctx, uint16_t address, uint16_t d
     uint8_t cnt;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
 
     for ( cnt = 0; cnt < 2; cnt++ ) 
     {
-        spi_transmit_buffer[ cnt + 2 ] = ( uint8_t ) ( ( data_in >> ( cnt * 8 ) ) & 0xFF );
+        ctx->spi_transmit_buffer[ cnt + 2 ] = ( uint8_t ) ( ( data_in >> ( cnt * 8 ) ) & 0xFF );
     }
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write( &ctx->spi, spi_transmit_buffer, 4 );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, 4 );
     spi_master_deselect_device( ctx->chip_select );
     return error_flag;
 }
@@ -534,16 +744,16 @@ err_t mcp251863_write_byte_safe ( mcp251863_t *ctx, uint16_t address, uint8_t da
     uint16_t crc_result = 0;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE_SAFE << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
-    spi_transmit_buffer[ 2 ] = data_in;
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE_SAFE << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    ctx->spi_transmit_buffer[ 2 ] = data_in;
 
-    crc_result = mcp251863_calculate_crc16( spi_transmit_buffer, 3 );
-    spi_transmit_buffer[ 3 ] = ( crc_result >> 8 ) & 0xFF;
-    spi_transmit_buffer[ 4 ] = crc_result & 0xFF;
+    crc_result = mcp251863_calculate_crc16( ctx->spi_transmit_buffer, 3 );
+    ctx->spi_transmit_buffer[ 3 ] = ( crc_result >> 8 ) & 0xFF;
+    ctx->spi_transmit_buffer[ 4 ] = crc_result & 0xFF;
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write( &ctx->spi, spi_transmit_buffer, 5 );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, 5 );
     spi_master_deselect_device( ctx->chip_select );
     return error_flag;
 }
@@ -554,20 +764,20 @@ err_t mcp251863_write_word_safe ( mcp251863_t *ctx, uint16_t address, uint32_t d
     uint16_t crc_result = 0;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE_SAFE << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE_SAFE << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
 
     for ( cnt = 0; cnt < 4; cnt++ ) 
     {
-        spi_transmit_buffer[ cnt + 2 ] = ( uint8_t ) ( ( data_in >> ( cnt * 8 ) ) & 0xFF );
+        ctx->spi_transmit_buffer[ cnt + 2 ] = ( uint8_t ) ( ( data_in >> ( cnt * 8 ) ) & 0xFF );
     }
 
-    crc_result = mcp251863_calculate_crc16( spi_transmit_buffer, 6 );
-    spi_transmit_buffer[6] = ( crc_result >> 8 ) & 0xFF;
-    spi_transmit_buffer[7] = crc_result & 0xFF;
+    crc_result = mcp251863_calculate_crc16( ctx->spi_transmit_buffer, 6 );
+    ctx->spi_transmit_buffer[6] = ( crc_result >> 8 ) & 0xFF;
+    ctx->spi_transmit_buffer[7] = crc_result & 0xFF;
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write( &ctx->spi, spi_transmit_buffer, 8 );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, 8 );
     spi_master_deselect_device( ctx->chip_select );
     
     return error_flag;
@@ -576,27 +786,15 @@ err_t mcp251863_write_word_safe ( mcp251863_t *ctx, uint16_t address, uint32_t d
 err_t mcp251863_read_byte_array ( mcp251863_t *ctx, uint16_t address, 
                                    uint8_t *data_out, uint16_t n_bytes )
 {
-    uint16_t cnt;
-    uint16_t spi_transfer_size = n_bytes + 2;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
-
-    for ( cnt = 2; cnt < spi_transfer_size; cnt++ ) 
-    {
-        spi_transmit_buffer[ cnt ] = 0;
-    }
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write_then_read( &ctx->spi, spi_transmit_buffer, 2, spi_receive_buffer, n_bytes );
+    error_flag = spi_master_write_then_read( &ctx->spi, ctx->spi_transmit_buffer, 2, data_out, n_bytes );
     spi_master_deselect_device( ctx->chip_select );
 
-    for ( cnt = 0; cnt < n_bytes; cnt++ ) 
-    {
-        data_out[ cnt ] = spi_receive_buffer[ cnt ];
-    }
-
     return error_flag;
 }
 
@@ -608,24 +806,24 @@ err_t mcp251863_read_byte_array_with_crc ( mcp251863_t *ctx, bool from_ram, bool
     uint16_t spi_transfer_size = ctx->func_data.n_bytes + 5; 
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ_CRC << 4 ) + ( ( ctx->func_data.address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( ctx->func_data.address & 0xFF );
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ_CRC << 4 ) + ( ( ctx->func_data.address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( ctx->func_data.address & 0xFF );
     if ( from_ram ) 
     {
-        spi_transmit_buffer[ 2 ] = ctx->func_data.n_bytes >> 2;
+        ctx->spi_transmit_buffer[ 2 ] = ctx->func_data.n_bytes >> 2;
     } 
     else 
     {
-        spi_transmit_buffer[ 2 ] = ctx->func_data.n_bytes;
+        ctx->spi_transmit_buffer[ 2 ] = ctx->func_data.n_bytes;
     }
 
     for ( cnt = 3; cnt < spi_transfer_size; cnt++ ) 
     {
-        spi_transmit_buffer[ cnt ] = 0;
+        ctx->spi_transmit_buffer[ cnt ] = 0;
     }
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write_then_read( &ctx->spi, spi_transmit_buffer, 3, spi_receive_buffer, ctx->func_data.n_bytes );
+    error_flag = spi_master_write_then_read( &ctx->spi, ctx->spi_transmit_buffer, 3, ctx->spi_receive_buffer, ctx->func_data.n_bytes );
     spi_master_deselect_device( ctx->chip_select );
 
     if ( error_flag == MCP251863_ERROR ) 
@@ -633,13 +831,13 @@ err_t mcp251863_read_byte_array_with_crc ( mcp251863_t *ctx, bool from_ram, bool
         return error_flag;
     }
 
-    crc_from_spi_slave = ( uint16_t ) ( spi_receive_buffer[ ctx->func_data.n_bytes - 2 ] << 8 ) + 
-                         ( uint16_t ) ( spi_receive_buffer[ ctx->func_data.n_bytes - 1 ] );
+    crc_from_spi_slave = ( uint16_t ) ( ctx->spi_receive_buffer[ ctx->func_data.n_bytes - 2 ] << 8 ) + 
+                         ( uint16_t ) ( ctx->spi_receive_buffer[ ctx->func_data.n_bytes - 1 ] );
 
-    spi_receive_buffer[ 0 ] = spi_transmit_buffer[ 0 ];
-    spi_receive_buffer[ 1 ] = spi_transmit_buffer[ 1 ];
-    spi_receive_buffer[ 2 ] = spi_transmit_buffer[ 2 ];
-    crc_at_controller = mcp251863_calculate_crc16( spi_receive_buffer, ctx->func_data.n_bytes + 3 );
+    ctx->spi_receive_buffer[ 0 ] = ctx->spi_transmit_buffer[ 0 ];
+    ctx->spi_receive_buffer[ 1 ] = ctx->spi_transmit_buffer[ 1 ];
+    ctx->spi_receive_buffer[ 2 ] = ctx->spi_transmit_buffer[ 2 ];
+    crc_at_controller = mcp251863_calculate_crc16( ctx->spi_receive_buffer, ctx->func_data.n_bytes + 3 );
 
     if ( crc_from_spi_slave == crc_at_controller ) 
     {
@@ -652,7 +850,7 @@ err_t mcp251863_read_byte_array_with_crc ( mcp251863_t *ctx, bool from_ram, bool
 
     for ( cnt = 0; cnt < ctx->func_data.n_bytes; cnt++ ) 
     {
-        ctx->func_data.rxd[ cnt ] = spi_receive_buffer[ cnt + 3 ];
+        ctx->func_data.rxd[ cnt ] = ctx->spi_receive_buffer[ cnt + 3 ];
     }
 
     return error_flag;
@@ -664,16 +862,16 @@ err_t mcp251863_write_byte_array ( mcp251863_t *ctx, uint16_t address, uint8_t *
     uint16_t spi_transfer_size = n_bytes + 2;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
 
     for ( cnt = 2; cnt < spi_transfer_size; cnt++ ) 
     {
-        spi_transmit_buffer[ cnt ] = data_in[ cnt - 2 ];
+        ctx->spi_transmit_buffer[ cnt ] = data_in[ cnt - 2 ];
     }
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write( &ctx->spi, spi_transmit_buffer, spi_transfer_size );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, spi_transfer_size );
     spi_master_deselect_device( ctx->chip_select );
     
 
@@ -687,29 +885,29 @@ err_t mcp251863_write_byte_array_with_crc ( mcp251863_t *ctx, bool from_ram )
     uint16_t spi_transfer_size = ctx->func_data.n_bytes + 5;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE_CRC << 4 ) + 
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE_CRC << 4 ) + 
                                            ( ( ctx->func_data.address >> 8 ) & 0xF ) );
-    spi_transmit_buffer[ 1 ] = ( uint8_t ) ( ctx->func_data.address & 0xFF );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( ctx->func_data.address & 0xFF );
     if ( from_ram ) 
     {
-        spi_transmit_buffer[ 2 ] = ctx->func_data.n_bytes >> 2;
+        ctx->spi_transmit_buffer[ 2 ] = ctx->func_data.n_bytes >> 2;
     } 
     else 
     {
-        spi_transmit_buffer[ 2 ] = ctx->func_data.n_bytes;
+        ctx->spi_transmit_buffer[ 2 ] = ctx->func_data.n_bytes;
     }
 
     for ( cnt = 0; cnt < ctx->func_data.n_bytes; cnt++ ) 
     {
-        spi_transmit_buffer[ cnt + 3 ] = ctx->func_data.txd[ cnt ];
+        ctx->spi_transmit_buffer[ cnt + 3 ] = ctx->func_data.txd[ cnt ];
     }
 
-    crc_result = mcp251863_calculate_crc16( spi_transmit_buffer, spi_transfer_size - 2 ) ; 
-    spi_transmit_buffer[ spi_transfer_size - 2 ]  = ( uint8_t ) ( ( crc_result >> 8 ) & 0xFF );
-    spi_transmit_buffer[ spi_transfer_size - 1 ]  = ( uint8_t ) ( crc_result & 0xFF );
+    crc_result = mcp251863_calculate_crc16( ctx->spi_transmit_buffer, spi_transfer_size - 2 ) ; 
+    ctx->spi_transmit_buffer[ spi_transfer_size - 2 ]  = ( uint8_t ) ( ( crc_result >> 8 ) & 0xFF );
+    ctx->spi_transmit_buffer[ spi_transfer_size - 1 ]  = ( uint8_t ) ( crc_result & 0xFF );
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write( &ctx->spi, spi_transmit_buffer, spi_transfer_size );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, spi_transfer_size );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
@@ -723,16 +921,16 @@ err_t mcp251863_read_word_array ( mcp251863_t *ctx, uint16_t address,
     uint16_t spi_transfer_size = n_words * 4;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF );
-    spi_transmit_buffer[ 1 ] = address & 0xFF;
+    ctx->spi_transmit_buffer[ 0 ] = ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF );
+    ctx->spi_transmit_buffer[ 1 ] = address & 0xFF;
 
     for ( cnt = 2; cnt < spi_transfer_size; cnt++ ) 
     {
-        spi_transmit_buffer[ cnt ] = 0;
+        ctx->spi_transmit_buffer[ cnt ] = 0;
     }
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write_then_read( &ctx->spi, spi_transmit_buffer, 2, spi_receive_buffer, spi_transfer_size );
+    error_flag = spi_master_write_then_read( &ctx->spi, ctx->spi_transmit_buffer, 2, ctx->spi_receive_buffer, spi_transfer_size );
     spi_master_deselect_device( ctx->chip_select );
 
     if ( error_flag == MCP251863_ERROR ) 
@@ -746,7 +944,7 @@ err_t mcp251863_read_word_array ( mcp251863_t *ctx, uint16_t address,
         w.word = 0;
         for ( j = 0; j < 4; j++, n++ ) 
         {
-            w.byte[ j ] = spi_receive_buffer[ n ];
+            w.byte[ j ] = ctx->spi_receive_buffer[ n ];
         }
         data_out[ cnt ] = w.word;
     }
@@ -762,8 +960,8 @@ err_t mcp251863_write_word_array ( mcp251863_t *ctx, uint16_t address,
     uint16_t spi_transfer_size = n_words * 4 + 2;
     err_t error_flag;
 
-    spi_transmit_buffer[ 0 ] = ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF );
-    spi_transmit_buffer[ 1 ] = address & 0xFF;
+    ctx->spi_transmit_buffer[ 0 ] = ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF );
+    ctx->spi_transmit_buffer[ 1 ] = address & 0xFF;
 
     n = 2;
     for ( cnt = 0; cnt < n_words; cnt++ ) 
@@ -771,12 +969,12 @@ err_t mcp251863_write_word_array ( mcp251863_t *ctx, uint16_t address,
         w.word = data_in[ cnt ];
         for ( j = 0; j < 4; j++, n++ ) 
         {
-            spi_transmit_buffer[ n ] = w.byte[ j ];
+            ctx->spi_transmit_buffer[ n ] = w.byte[ j ];
         }
     }
 
     spi_master_select_device( ctx->chip_select );  
-    error_flag = spi_master_write( &ctx->spi, spi_transmit_buffer, spi_transfer_size );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, spi_transfer_size );
     spi_master_deselect_device( ctx->chip_select );
     
 
@@ -1411,16 +1609,13 @@ err_t mcp251863_receive_channel_status_get ( mcp251863_t *ctx, uint8_t channel,
 
 err_t mcp251863_receive_message_get ( mcp251863_t *ctx, uint8_t channel, mcp251863_rx_msg_obj_t* rx_obj )
 {
-    uint8_t cnt_n = 0;
     uint16_t address;
-    uint8_t rx_data[ MCP251863_MAX_MSG_SIZE ];
     uint32_t fifo_reg[ 3 ];
     mcp251863_fifo_ctl_t ci_fifo_con;
-    mcp251863_fifo_stat_t ci_fifo_sta;
     mcp251863_fifo_user_cfg_t ci_fifo_ua;
     err_t error_flag;
-    mcp251863_reg_t my_reg;
 
+    // FIFO control, status and user address are read in a single transfer
     address = MCP251863_REG_CIFIFOCON  + ( channel * MCP251863_FIFO_OFFSET );
 
     error_flag = mcp251863_read_word_array( ctx, address, fifo_reg, 3 );
@@ -1435,74 +1630,17 @@ err_t mcp251863_receive_message_get ( mcp251863_t *ctx, uint8_t channel, mcp2518
         return -2;
     }
 
-    ci_fifo_sta.word = fifo_reg[ 1 ];
-
     ci_fifo_ua.word = fifo_reg[ 2 ];
-#ifdef USERADDRESS_TIMES_FOUR
-    address = 4 * ci_fifo_ua.bf.user_address;
-#else
-    address = ci_fifo_ua.bf.user_address;
-#endif
-    address += MCP251863_RAMADDR_START;
-
-    cnt_n = ctx->func_data.n_bytes + 8; 
+    address = mcp251863_user_address_to_ram( ci_fifo_ua.word );
 
-    if ( ci_fifo_con.rx_bf.rx_time_stamp_enable ) 
-    {
-        cnt_n += 4; 
-    }
-
-    if ( cnt_n % 4 ) 
-    {
-        cnt_n = cnt_n + 4 - ( cnt_n % 4 );
-    }
-
-    if ( cnt_n > MCP251863_MAX_MSG_SIZE) 
-    {
-        cnt_n = MCP251863_MAX_MSG_SIZE;
-    }
-
-    error_flag = mcp251863_read_byte_array( ctx, address, rx_data, cnt_n );
+    // Message object is decoded directly into the caller buffers
+    error_flag = mcp251863_rx_object_read( ctx, address, ci_fifo_con.rx_bf.rx_time_stamp_enable, rx_obj, 
+                                           ctx->func_data.rxd, ctx->func_data.n_bytes );
     if ( error_flag == MCP251863_ERROR ) 
     {
         return -3;
     }
 
-    my_reg.byte[ 0 ] = rx_data[ 0 ];
-    my_reg.byte[ 1 ] = rx_data[ 1 ];
-    my_reg.byte[ 2 ] = rx_data[ 2 ];
-    my_reg.byte[ 3 ] = rx_data[ 3 ];
-    rx_obj->word[ 0 ] = my_reg.word;
-
-    my_reg.byte[ 0 ] = rx_data[ 4 ];
-    my_reg.byte[ 1 ] = rx_data[5 ];
-    my_reg.byte[ 2 ] = rx_data[6 ];
-    my_reg.byte[ 3 ] = rx_data[7 ];
-    rx_obj->word[ 1 ] = my_reg.word;
-
-    if ( ci_fifo_con.rx_bf.rx_time_stamp_enable ) 
-    {
-        my_reg.byte[ 0 ] = rx_data[8 ];
-        my_reg.byte[ 1 ] = rx_data[9 ];
-        my_reg.byte[ 2 ] = rx_data[10 ];
-        my_reg.byte[ 3 ] = rx_data[11 ];
-        rx_obj->word[ 2 ] = my_reg.word;
-
-        for ( uint8_t cnt = 0; cnt < ctx->func_data.n_bytes; cnt++ ) 
-        {
-            ctx->func_data.rxd[ cnt ] = rx_data[ cnt + 12 ];
-        }
-    } 
-    else 
-    {
-        rx_obj->word[ 2 ] = 0;
-
-        for ( uint8_t cnt = 0; cnt < ctx->func_data.n_bytes; cnt++ ) 
-        {
-            ctx->func_data.rxd[ cnt ] = rx_data[ cnt + 8 ];
-        }
-    }
-
     error_flag = mcp251863_receive_channel_update( ctx, channel );
     if ( error_flag == MCP251863_ERROR ) 
     {
@@ -3960,4 +4098,109 @@ uint8_t mcp251863_data_bytes_to_dlc ( uint8_t num )
     return dlc;
 }
 
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint16_t mcp251863_user_address_to_ram ( uint32_t user_address )
+{
+    mcp251863_fifo_user_cfg_t ci_fifo_ua;
+    uint16_t address;
+
+    ci_fifo_ua.word = user_address;
+#ifdef USERADDRESS_TIMES_FOUR
+    address = 4 * ci_fifo_ua.bf.user_address;
+#else
+    address = ci_fifo_ua.bf.user_address;
+#endif
+    return address + MCP251863_RAMADDR_START;
+}
+
+static err_t mcp251863_rx_object_read ( mcp251863_t *ctx, uint16_t address, bool time_stamp, 
+                                        mcp251863_rx_msg_obj_t *rx_obj, uint8_t *data_out, uint16_t max_bytes )
+{
+    uint8_t header_size = 8;
+    uint8_t payload_size;
+    uint8_t padding_size;
+    uint8_t padding[ 4 ];
+    err_t error_flag;
+
+    if ( time_stamp ) 
+    {
+        header_size += 4; 
+    }
+
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_READ << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+
+    spi_master_select_device( ctx->chip_select );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, 2 );
+    error_flag |= spi_master_read( &ctx->spi, rx_obj->byte, header_size );
+    if ( error_flag != MCP251863_OK ) 
+    {
+        spi_master_deselect_device( ctx->chip_select );
+        return MCP251863_ERROR;
+    }
+    if ( !time_stamp ) 
+    {
+        rx_obj->word[ 2 ] = 0;
+    }
+
+    // Only the received payload is clocked in, padded to the RAM word size
+    payload_size = ( uint8_t ) mcp251863_dlc_to_data_bytes( rx_obj->bf.ctrl.dlc );
+    padding_size = ( 4 - ( payload_size % 4 ) ) % 4;
+    if ( payload_size > max_bytes ) 
+    {
+        payload_size = ( uint8_t ) max_bytes;
+        padding_size = 0;
+    }
+    if ( payload_size ) 
+    {
+        error_flag |= spi_master_read( &ctx->spi, data_out, payload_size );
+    }
+    if ( padding_size ) 
+    {
+        error_flag |= spi_master_read( &ctx->spi, padding, padding_size );
+    }
+    spi_master_deselect_device( ctx->chip_select );
+
+    if ( error_flag != MCP251863_OK ) 
+    {
+        return MCP251863_ERROR;
+    }
+    return MCP251863_OK;
+}
+
+static err_t mcp251863_tx_object_write ( mcp251863_t *ctx, uint16_t address, 
+                                         mcp251863_tx_msg_obj_t *tx_obj, uint8_t *data_in, uint8_t n_bytes )
+{
+    uint8_t cnt;
+    uint8_t padding[ 4 ] = { 0 };
+    uint8_t padding_size = ( 4 - ( n_bytes % 4 ) ) % 4;
+    err_t error_flag;
+
+    ctx->spi_transmit_buffer[ 0 ] = ( uint8_t ) ( ( MCP251863_INS_WRITE << 4 ) + ( ( address >> 8 ) & 0xF ) );
+    ctx->spi_transmit_buffer[ 1 ] = ( uint8_t ) ( address & 0xFF );
+    for ( cnt = 0; cnt < 8; cnt++ ) 
+    {
+        ctx->spi_transmit_buffer[ cnt + 2 ] = tx_obj->byte[ cnt ];
+    }
+
+    spi_master_select_device( ctx->chip_select );
+    error_flag = spi_master_write( &ctx->spi, ctx->spi_transmit_buffer, 10 );
+    if ( n_bytes ) 
+    {
+        error_flag |= spi_master_write( &ctx->spi, data_in, n_bytes );
+    }
+    if ( padding_size ) 
+    {
+        error_flag |= spi_master_write( &ctx->spi, padding, padding_size );
+    }
+    spi_master_deselect_device( ctx->chip_select );
+
+    if ( error_flag != MCP251863_OK ) 
+    {
+        return MCP251863_ERROR;
+    }
+    return MCP251863_OK;
+}
+
 // ------------------------------------------------------------------------- END
@@ -176,6 +176,14 @@
 #define OLEDC_DEFAULT_PRECHARGE_2   0x01
 /** \} */
 
+/**
+ * \defgroup framebuffer Framebuffer
+ * \{
+ */
+#define OLEDC_FB_MAX_DIRTY_AREAS    8
+#define OLEDC_FB_CHUNK_SIZE         32
+/** \} */
+
 
 
 /** \} */ // End group macro 
@@ -241,6 +249,37 @@ typedef struct
 
 } oledc_cfg_t;
 
+/**
+ * @brief Framebuffer area object definition.
+ */
+typedef struct
+{
+    uint8_t col_start;
+    uint8_t row_start;
+    uint8_t col_end;
+    uint8_t row_end;
+
+} oledc_area_t;
+
+/**
+ * @brief Framebuffer object definition.
+ *
+ * @description The framebuffer covers a region of the screen and is backed by a
+ * caller provided buffer of width * height RGB565 pixels. Only pixels that change
+ * are marked dirty, and adjacent dirty areas are merged.
+ */
+typedef struct
+{
+    uint16_t      *buf;
+    uint8_t       col_off;
+    uint8_t       row_off;
+    uint8_t       width;
+    uint8_t       height;
+    oledc_area_t  dirty[ OLEDC_FB_MAX_DIRTY_AREAS ];
+    uint8_t       num_dirty;
+
+} oledc_fb_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -385,6 +424,66 @@ void oledc_text( oledc_t *ctx, uint8_t *text, uint16_t x, uint16_t y );
  */
 void oledc_set_font( oledc_t *ctx, const uint8_t *font_s, uint16_t color );
 
+/**
+ * @brief Framebuffer Setup.
+ *
+ * @param fb  Framebuffer object.
+ * @param buf  Pixel buffer of at least width * height RGB565 pixels.
+ * @param col_off  Column offset of the framebuffer region from the left border of the screen.
+ * @param row_off  Row offset of the framebuffer region from the top border of the screen.
+ * @param width  Framebuffer region width.
+ * @param height  Framebuffer region height.
+ * @param color  Initial RGB color.
+ *
+ * @description Function fills the framebuffer with the provided color and marks
+ * the whole region dirty, so the first @c oledc_fb_flush call writes it entirely.
+ */
+void oledc_fb_init( oledc_fb_t *fb, uint16_t *buf, uint8_t col_off, uint8_t row_off, 
+                    uint8_t width, uint8_t height, uint16_t color );
+
+/**
+ * @brief Framebuffer Draw Rectangle.
+ *
+ * @param fb  Framebuffer object.
+ * @param col_off  Column offset from the left border of the screen.
+ * @param row_off  Row offset from the top border of the screen.
+ * @param col_end  Column end offset also counted from the left border.
+ * @param row_end  Row offset also counted from the top border.
+ * @param color  RGB color.
+ *
+ * @description Function fills the rectangle in the framebuffer and marks the
+ * changed pixels dirty. The rectangle is clipped to the framebuffer region.
+ */
+void oledc_fb_rectangle( oledc_fb_t *fb, uint8_t col_off, uint8_t row_off, 
+                         uint8_t col_end, uint8_t row_end, uint16_t color );
+
+/**
+ * @brief Framebuffer Draw Text.
+ *
+ * @param ctx  Context object.
+ * @param fb  Framebuffer object.
+ * @param text  Text string.
+ * @param x  Column offset from the left border of the screen.
+ * @param y  Row offset from the top border of the screen.
+ * @param bg_color  Background RGB color.
+ *
+ * @description Function writes text into the framebuffer using the font set by
+ * @c oledc_set_font over the provided background color, so redrawing a changed
+ * value marks only the differing pixels dirty.
+ */
+void oledc_fb_text( oledc_t *ctx, oledc_fb_t *fb, uint8_t *text, uint16_t x, uint16_t y, uint16_t bg_color );
+
+/**
+ * @brief Framebuffer Flush.
+ *
+ * @param ctx  Context object.
+ * @param fb  Framebuffer object.
+ *
+ * @description Function writes all dirty areas of the framebuffer to the display,
+ * each one as a single address window and data burst, and clears the dirty list.
+ */
+void oledc_fb_flush( oledc_t *ctx, oledc_fb_t *fb );
+
 #ifdef __cplusplus
 }
 #endif
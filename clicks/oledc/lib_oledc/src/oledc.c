@@ -70,6 +70,10 @@ static void pixel( oledc_t *ctx, uint8_t col, uint8_t row, uint16_t color );
 
 static void character( oledc_t *ctx, uint16_t ch );
 
+static void fb_character( oledc_t *ctx, oledc_fb_t *fb, uint16_t ch, uint16_t bg_color );
+
+static void fb_mark_dirty( oledc_fb_t *fb, oledc_area_t *area );
+
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -253,6 +257,154 @@ void oledc_set_font( oledc_t *ctx, const uint8_t *font_s, uint16_t color )
     ctx->font_color         = color;
 }
 
+void oledc_fb_init( oledc_fb_t *fb, uint16_t *buf, uint8_t col_off, uint8_t row_off, 
+                    uint8_t width, uint8_t height, uint16_t color )
+{
+    oledc_area_t area;
+    uint16_t cnt;
+
+    fb->buf       = buf;
+    fb->col_off   = col_off;
+    fb->row_off   = row_off;
+    fb->width     = width;
+    fb->height    = height;
+    fb->num_dirty = 0;
+
+    for ( cnt = 0; cnt < ( ( uint16_t )width * height ); cnt++ )
+    {
+        fb->buf[ cnt ] = color;
+    }
+
+    area.col_start = col_off;
+    area.row_start = row_off;
+    area.col_end   = col_off + width - 1;
+    area.row_end   = row_off + height - 1;
+    fb_mark_dirty( fb, &area );
+}
+
+void oledc_fb_rectangle( oledc_fb_t *fb, uint8_t col_off, uint8_t row_off, 
+                         uint8_t col_end, uint8_t row_end, uint16_t color )
+{
+    oledc_area_t changed;
+    uint16_t *row_ptr;
+    uint8_t col;
+    uint8_t row;
+    uint8_t is_changed = 0;
+
+    /* Clip to the framebuffer region, end offsets are exclusive */
+    if( col_off < fb->col_off )
+        col_off = fb->col_off;
+
+    if( row_off < fb->row_off )
+        row_off = fb->row_off;
+
+    if( col_end > ( fb->col_off + fb->width ) )
+        col_end = fb->col_off + fb->width;
+
+    if( row_end > ( fb->row_off + fb->height ) )
+        row_end = fb->row_off + fb->height;
+
+    if( ( col_end <= col_off ) || ( row_end <= row_off ) )
+        return;
+
+    changed.col_start = col_end;
+    changed.row_start = row_end;
+    changed.col_end   = col_off;
+    changed.row_end   = row_off;
+
+    for( row = row_off; row < row_end; row++ )
+    {
+        row_ptr = &fb->buf[ ( uint16_t )( row - fb->row_off ) * fb->width ];
+        for( col = col_off; col < col_end; col++ )
+        {
+            if( row_ptr[ col - fb->col_off ] != color )
+            {
+                row_ptr[ col - fb->col_off ] = color;
+                is_changed = 1;
+                if( col < changed.col_start )
+                    changed.col_start = col;
+                if( col > changed.col_end )
+                    changed.col_end = col;
+                if( row < changed.row_start )
+                    changed.row_start = row;
+                changed.row_end = row;
+            }
+        }
+    }
+
+    if( is_changed )
+        fb_mark_dirty( fb, &changed );
+}
+
+void oledc_fb_text( oledc_t *ctx, oledc_fb_t *fb, uint8_t *text, uint16_t x, uint16_t y, uint16_t bg_color )
+{
+    uint8_t *ptr = text;
+
+    if ( ( x >= OLEDC_SCREEN_WIDTH ) || ( y >= OLEDC_SCREEN_HEIGHT ) )
+    {
+        return;
+    }
+    
+    ctx->x_cord = x;
+    ctx->y_cord = y;
+
+    while( *ptr )
+    {
+        fb_character( ctx, fb, *ptr++, bg_color );
+    }
+}
+
+void oledc_fb_flush( oledc_t *ctx, oledc_fb_t *fb )
+{
+    uint8_t   cmd = OLEDC_WRITE_RAM;
+    uint8_t   chunk[ OLEDC_FB_CHUNK_SIZE ];
+    uint8_t   chunk_cnt;
+    uint8_t   area_cnt;
+    uint8_t   col;
+    uint8_t   row;
+    uint16_t  *row_ptr;
+    oledc_area_t *area;
+
+    for( area_cnt = 0; area_cnt < fb->num_dirty; area_cnt++ )
+    {
+        area = &fb->dirty[ area_cnt ];
+
+        cols[ 0 ] = OLEDC_COL_OFF + area->col_start;
+        cols[ 1 ] = OLEDC_COL_OFF + area->col_end;
+        rows[ 0 ] = OLEDC_ROW_OFF + area->row_start;
+        rows[ 1 ] = OLEDC_ROW_OFF + area->row_end;
+
+        oledc_more_arg_commands( ctx, OLEDC_SET_COL_ADDRESS, cols, 2 );
+        oledc_more_arg_commands( ctx, OLEDC_SET_ROW_ADDRESS, rows, 2 );
+        spi_master_select_device( ctx->chip_select );
+        digital_out_low( &ctx->dc );
+        spi_master_write( &ctx->spi, &cmd, 1 );
+        digital_out_high( &ctx->dc );
+
+        chunk_cnt = 0;
+        for( row = area->row_start; row <= area->row_end; row++ )
+        {
+            row_ptr = &fb->buf[ ( uint16_t )( row - fb->row_off ) * fb->width ];
+            for( col = area->col_start; col <= area->col_end; col++ )
+            {
+                chunk[ chunk_cnt++ ] = row_ptr[ col - fb->col_off ] >> 8;
+                chunk[ chunk_cnt++ ] = row_ptr[ col - fb->col_off ] & 0x00FF;
+                if( chunk_cnt >= OLEDC_FB_CHUNK_SIZE )
+                {
+                    spi_master_write( &ctx->spi, chunk, chunk_cnt );
+                    chunk_cnt = 0;
+                }
+            }
+        }
+        if( chunk_cnt )
+        {
+            spi_master_write( &ctx->spi, chunk, chunk_cnt );
+        }
+        spi_master_deselect_device( ctx->chip_select );  
+    }
+    fb->num_dirty = 0;
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static void box_area 
@@ -436,5 +588,127 @@ static void character( oledc_t *ctx, uint16_t ch )
     ctx->x_cord = x + 1;
 }
 
+static void fb_character( oledc_t *ctx, oledc_fb_t *fb, uint16_t ch, uint16_t bg_color )
+{
+    uint8_t     ch_width = 0;
+    uint8_t     x_cnt;
+    uint8_t     y_cnt;
+    uint16_t    x = 0;
+    uint16_t    y = 0;
+    uint16_t    tmp;
+    uint8_t     temp = 0;
+    uint8_t     mask = 0;
+    uint32_t    offset;
+    const uint8_t *ch_table;
+    const uint8_t *ch_bitmap;
+
+    if( ch < ctx->font_first_char )
+        return;
+
+    if( ch > ctx->font_last_char )
+        return;
+
+    offset = 0;
+    tmp = (ch - ctx->font_first_char) << 2;
+    ch_table = ctx->font_obj + 8 + tmp;
+    ch_width = *ch_table;
+
+    offset = (uint32_t)ch_table[1] + ((uint32_t)ch_table[2] << 8) + ((uint32_t)ch_table[3] << 16);
+
+    ch_bitmap = ctx->font_obj + offset;
+
+    y = ctx->y_cord;
+    for (y_cnt = 0; y_cnt < ctx->font_height; y_cnt++)
+    {
+        x = ctx->x_cord;
+        mask = 0;
+        for( x_cnt = 0; x_cnt < ch_width; x_cnt++ )
+        {
+            if( !mask )
+            {
+                temp = *ch_bitmap++;
+                mask = 0x01;
+            }
+            if( temp & mask )
+                oledc_fb_rectangle( fb, x, y, x + 1, y + 1, ctx->font_color );
+            else
+                oledc_fb_rectangle( fb, x, y, x + 1, y + 1, bg_color );
+
+            x++;
+            mask <<= 1;
+        }
+        y++;
+    }
+    ctx->x_cord = x + 1;
+}
+
+static void fb_mark_dirty( oledc_fb_t *fb, oledc_area_t *area )
+{
+    oledc_area_t  merged = *area;
+    oledc_area_t  *dirty;
+    uint16_t      size;
+    uint16_t      best_size = 0xFFFF;
+    uint8_t       best_idx = 0;
+    uint8_t       cnt = 0;
+
+    /* Merge all overlapping or adjacent areas, rescan after each merge */
+    while( cnt < fb->num_dirty )
+    {
+        dirty = &fb->dirty[ cnt ];
+        if( ( merged.col_start <= dirty->col_end + 1 ) && ( dirty->col_start <= merged.col_end + 1 ) &&
+            ( merged.row_start <= dirty->row_end + 1 ) && ( dirty->row_start <= merged.row_end + 1 ) )
+        {
+            if( dirty->col_start < merged.col_start )
+                merged.col_start = dirty->col_start;
+            if( dirty->row_start < merged.row_start )
+                merged.row_start = dirty->row_start;
+            if( dirty->col_end > merged.col_end )
+                merged.col_end = dirty->col_end;
+            if( dirty->row_end > merged.row_end )
+                merged.row_end = dirty->row_end;
+
+            fb->dirty[ cnt ] = fb->dirty[ --fb->num_dirty ];
+            cnt = 0;
+        }
+        else
+        {
+            cnt++;
+        }
+    }
+
+    /* List is full, merge with the area giving the smallest bounding box */
+    if( fb->num_dirty >= OLEDC_FB_MAX_DIRTY_AREAS )
+    {
+        for( cnt = 0; cnt < fb->num_dirty; cnt++ )
+        {
+            dirty = &fb->dirty[ cnt ];
+            size = ( uint16_t )( ( ( dirty->col_end > merged.col_end ) ? dirty->col_end : merged.col_end ) -
+                                 ( ( dirty->col_start < merged.col_start ) ? dirty->col_start : merged.col_start ) + 1 ) *
+                   ( ( ( dirty->row_end > merged.row_end ) ? dirty->row_end : merged.row_end ) -
+                     ( ( dirty->row_start < merged.row_start ) ? dirty->row_start : merged.row_start ) + 1 );
+            if( size < best_size )
+            {
+                best_size = size;
+                best_idx = cnt;
+            }
+        }
+        dirty = &fb->dirty[ best_idx ];
+        if( dirty->col_start < merged.col_start )
+            merged.col_start = dirty->col_start;
+        if( dirty->row_start < merged.row_start )
+            merged.row_start = dirty->row_start;
+        if( dirty->col_end > merged.col_end )
+            merged.col_end = dirty->col_end;
+        if( dirty->row_end > merged.row_end )
+            merged.row_end = dirty->row_end;
+
+        fb->dirty[ best_idx ] = fb->dirty[ --fb->num_dirty ];
+        fb_mark_dirty( fb, &merged );
+        return;
+    }
+
+    fb->dirty[ fb->num_dirty++ ] = merged;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -191,6 +191,16 @@ extern "C"{
 #define OXIMETER5_INTERRUPT_INACTIVE             0x00
 #define OXIMETER5_INTERRUPT_ACTIVE               0x01
 
+#define OXIMETER5_FIFO_PTR_MASK                  0x1F
+#define OXIMETER5_FIFO_DEPTH                     32
+#define OXIMETER5_FIFO_SAMPLE_SIZE               6
+
+#define OXIMETER5_ESTIMATOR_DELAY_SIZE           16
+#define OXIMETER5_ESTIMATOR_NUM_INTERVALS        4
+#define OXIMETER5_ESTIMATOR_NUM_RATIOS           5
+#define OXIMETER5_ESTIMATOR_NO_BEAT              0x00
+#define OXIMETER5_ESTIMATOR_NEW_BEAT             0x01
+
 /**
  * @brief Oximeter 5 device address setting.
  * @details Specified setting for device slave address selection of
@@ -255,6 +265,64 @@ typedef struct
 
 } oximeter5_cfg_t;
 
+/**
+ * @brief Oximeter 5 Click sample ring buffer object.
+ * @details Caller provided ring buffer of IR and Red samples filled by
+ * the FIFO burst read of Oximeter 5 Click driver.
+ */
+typedef struct
+{
+    uint32_t *ir;           /**< IR samples buffer. */
+    uint32_t *red;          /**< Red samples buffer. */
+    uint16_t size;          /**< Number of samples each buffer can hold. */
+    uint16_t head;          /**< Index of the oldest sample. */
+    uint16_t count;         /**< Number of stored samples. */
+    uint16_t overrun;       /**< Number of samples lost to FIFO overflow or a full ring buffer. */
+
+} oximeter5_ring_t;
+
+/**
+ * @brief Oximeter 5 Click streaming SpO2 and heart rate estimator object.
+ * @details State of the sample by sample SpO2 and heart rate estimator
+ * of Oximeter 5 Click driver, it has a fixed size independent of the run time.
+ */
+typedef struct
+{
+    int32_t  ir_dc;                                         /**< Running IR DC level in Q4 fixed point. */
+    int32_t  ma_buf[ 4 ];                                   /**< Last DC removed and inverted IR samples. */
+    int32_t  ma_sum;                                        /**< Sum of the moving average buffer. */
+    int32_t  th_mean;                                       /**< Running mean of the filtered signal in Q4 fixed point. */
+    int32_t  prev_val;                                      /**< Previous filtered value. */
+    uint32_t cand_idx;                                      /**< Start of the current rising edge plateau. */
+    uint8_t  rising;                                        /**< Filtered signal is on a rising edge. */
+    uint8_t  peak_pending;                                  /**< Peak waiting for the minimum distance to pass. */
+    uint32_t peak_idx;                                      /**< Index of the pending peak. */
+    int32_t  peak_val;                                      /**< Value of the pending peak. */
+    uint8_t  valley_pending;                                /**< Confirmed valley not yet released from the delay line. */
+    uint32_t valley_idx;                                    /**< Raw sample index of the confirmed valley. */
+    uint32_t ir_delay[ OXIMETER5_ESTIMATOR_DELAY_SIZE ];    /**< IR raw samples delay line. */
+    uint32_t red_delay[ OXIMETER5_ESTIMATOR_DELAY_SIZE ];   /**< Red raw samples delay line. */
+    uint32_t sample_cnt;                                    /**< Number of samples consumed. */
+    uint8_t  seg_valid;                                     /**< A valley to valley segment is open. */
+    uint32_t seg_start;                                     /**< Raw sample index of the segment start valley. */
+    int32_t  seg_ir0;                                       /**< IR value at the segment start valley. */
+    int32_t  seg_red0;                                      /**< Red value at the segment start valley. */
+    int32_t  seg_ir_max;                                    /**< Maximum IR value in the segment. */
+    uint32_t seg_ir_max_idx;                                /**< Index of the maximum IR value. */
+    int32_t  seg_red_max;                                   /**< Maximum Red value in the segment. */
+    uint32_t seg_red_max_idx;                               /**< Index of the maximum Red value. */
+    int32_t  seg_ir_at_red_max;                             /**< IR value at the maximum Red value index. */
+    uint16_t intervals[ OXIMETER5_ESTIMATOR_NUM_INTERVALS ];/**< Last beat to beat intervals in samples. */
+    uint8_t  interval_cnt;                                  /**< Number of valid intervals. */
+    uint8_t  interval_idx;                                  /**< Next interval slot. */
+    int32_t  ratios[ OXIMETER5_ESTIMATOR_NUM_RATIOS ];      /**< Last Red/IR AC to DC ratios. */
+    uint8_t  ratio_cnt;                                     /**< Number of valid ratios. */
+    uint8_t  ratio_idx;                                     /**< Next ratio slot. */
+    uint8_t  spo2;                                          /**< Last published SpO2 value. */
+    int32_t  heart_rate;                                    /**< Last published heart rate value. */
+
+} oximeter5_estimator_t;
+
 /**
  * @brief Oximeter 5 Click return value data.
  * @details Predefined enum values for driver return values.
@@ -506,6 +574,57 @@ err_t oximeter5_set_spo2_cfg ( oximeter5_t *ctx, uint8_t spo2_adc_rge,  uint8_t
  */
 err_t oximeter5_read_sensor_data ( oximeter5_t *ctx, uint32_t *ir, uint32_t *red );
 
+/**
+ * @brief Oximeter 5 sample ring buffer init function.
+ * @details This function sets up the caller provided sample ring buffer
+ * used by the FIFO burst read of the Oximeter 5 Click board™.
+ * @param[out] ring : Sample ring buffer object.
+ * See #oximeter5_ring_t object definition for detailed explanation.
+ * @param[in] ir_buf : IR samples buffer.
+ * @param[in] red_buf : Red samples buffer.
+ * @param[in] size : Number of samples each buffer can hold.
+ * @return Nothing.
+ * @note None.
+ */
+void oximeter5_ring_init ( oximeter5_ring_t *ring, uint32_t *ir_buf, uint32_t *red_buf, uint16_t size );
+
+/**
+ * @brief Oximeter 5 read FIFO samples function.
+ * @details This function reads the FIFO write pointer, overflow counter and
+ * read pointer in one transaction, then reads all pending IR and Red samples
+ * in a single burst and appends them to the sample ring buffer
+ * of the MAX30102 High-Sensitivity Pulse Oximeter and
+ * Heart-Rate Sensor for Wearable Health
+ * on the Oximeter 5 Click board™.
+ * @param[in] ctx : Click context object.
+ * See #oximeter5_t object definition for detailed explanation.
+ * @param[in,out] ring : Sample ring buffer object.
+ * See #oximeter5_ring_t object definition for detailed explanation.
+ * @param[out] num_samples : Number of samples read from the FIFO.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note When the ring buffer is full the oldest samples are overwritten
+ * and counted in the overrun field.
+ */
+err_t oximeter5_read_fifo_samples ( oximeter5_t *ctx, oximeter5_ring_t *ring, uint8_t *num_samples );
+
+/**
+ * @brief Oximeter 5 sample ring buffer pop function.
+ * @details This function takes the oldest IR and Red sample from the sample ring buffer.
+ * @param[in,out] ring : Sample ring buffer object.
+ * See #oximeter5_ring_t object definition for detailed explanation.
+ * @param[out] ir : IR ADC data.
+ * @param[out] red : Red ADC data.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, the ring buffer is empty.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t oximeter5_ring_pop ( oximeter5_ring_t *ring, uint32_t *ir, uint32_t *red );
+
 /**
  * @brief Oximeter 5 get oxygen saturation function.
  * @details This function get oxygen saturation data
@@ -548,6 +667,39 @@ err_t oximeter5_get_oxygen_saturation ( uint32_t *pun_ir_buffer, int32_t n_ir_bu
  */
 err_t oximeter5_get_heart_rate ( uint32_t *pun_ir_buffer, int32_t n_ir_buffer_length, uint32_t *pun_red_buffer, int32_t *pn_heart_rate );
 
+/**
+ * @brief Oximeter 5 estimator init function.
+ * @details This function resets the streaming SpO2 and heart rate estimator
+ * of the MAX30102 High-Sensitivity Pulse Oximeter and
+ * Heart-Rate Sensor for Wearable Health
+ * on the Oximeter 5 Click board™.
+ * @param[out] est : Estimator object.
+ * See #oximeter5_estimator_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note None.
+ */
+void oximeter5_estimator_init ( oximeter5_estimator_t *est );
+
+/**
+ * @brief Oximeter 5 estimator update function.
+ * @details This function consumes one IR and Red sample and updates the
+ * SpO2 and heart rate estimates once per detected beat, using running DC removal,
+ * a streaming valley detector and sliding windows of beat intervals and ratios
+ * of the MAX30102 High-Sensitivity Pulse Oximeter and
+ * Heart-Rate Sensor for Wearable Health
+ * on the Oximeter 5 Click board™.
+ * @param[in,out] est : Estimator object.
+ * See #oximeter5_estimator_t object definition for detailed explanation.
+ * @param[in] ir : IR ADC data.
+ * @param[in] red : Red ADC data.
+ * @return @li @c 0x00 - No new beat,
+ *         @li @c 0x01 - New beat, the spo2 and heart_rate fields are updated.
+ * @note Samples are expected at the same 25 Hz rate as the batch functions,
+ * the estimates are published with a delay of 8 samples.
+ * The spo2 and heart_rate fields hold the error values until a valid estimate is available.
+ */
+uint8_t oximeter5_estimator_update ( oximeter5_estimator_t *est, uint32_t ir, uint32_t red );
+
 #ifdef __cplusplus
 }
 #endif
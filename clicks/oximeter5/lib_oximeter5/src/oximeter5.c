@@ -26,6 +26,7 @@
  */
 
 #include "oximeter5.h"
+#include "string.h"
 
 #define SAMPLING_FREQUENCY          25   
 #define BUFFER_SIZE                 ( SAMPLING_FREQUENCY * 4 ) 
@@ -36,6 +37,9 @@
 #define BYTE_LOW_NIBBLE             0x0F
 #define TEMPERATURE_DATA_CALC_DATA  0.0625
 #define OXIMETER5_N_X_DC_MAX        -16777216
+#define ESTIMATOR_DC_SHIFT          6
+#define ESTIMATOR_PEAK_DISTANCE     4
+#define ESTIMATOR_RELEASE_DELAY     ( ESTIMATOR_PEAK_DISTANCE + MA4_SIZE )
 
 const uint8_t uch_spo2_table[ 184 ] = 
 { 
@@ -81,6 +85,20 @@ static void dev_remove_close_peaks ( int32_t *pn_locs, int32_t *pn_npks, int32_t
  */
 static void dev_find_peaks ( int32_t *pn_locs, int32_t *n_npks,  int32_t  *pn_x, uint8_t n_size, int32_t n_min_height, int32_t n_min_distance, int32_t n_max_num );
 
+/**
+ * @brief Oximeter 5 estimator valley detection function.
+ * @details This function feeds one filtered sample to the streaming valley detector
+ * and confirms the pending valley once no deeper one can follow within the minimum distance.
+ */
+static void dev_estimator_detect ( oximeter5_estimator_t *est, int32_t n_val, uint32_t n_idx );
+
+/**
+ * @brief Oximeter 5 estimator beat function.
+ * @details This function closes the valley to valley segment ending at the released sample
+ * and updates the heart rate and SpO2 estimates.
+ */
+static void dev_estimator_beat ( oximeter5_estimator_t *est, uint32_t n_idx, int32_t n_ir, int32_t n_red );
+
 void oximeter5_cfg_setup ( oximeter5_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -306,6 +324,88 @@ err_t oximeter5_read_sensor_data ( oximeter5_t *ctx, uint32_t *ir, uint32_t *red
     return error_flag;
 }
 
+void oximeter5_ring_init ( oximeter5_ring_t *ring, uint32_t *ir_buf, uint32_t *red_buf, uint16_t size )
+{
+    ring->ir = ir_buf;
+    ring->red = red_buf;
+    ring->size = size;
+    ring->head = 0;
+    ring->count = 0;
+    ring->overrun = 0;
+}
+
+err_t oximeter5_read_fifo_samples ( oximeter5_t *ctx, oximeter5_ring_t *ring, uint8_t *num_samples )
+{
+    uint8_t ptr_buf[ 3 ];
+    uint8_t rx_buf[ OXIMETER5_FIFO_DEPTH * OXIMETER5_FIFO_SAMPLE_SIZE ];
+    uint8_t *sample;
+    uint8_t pending;
+    uint16_t tail;
+  
+    *num_samples = 0;
+    
+    // FIFO_WR_PTR, OVF_COUNTER and FIFO_RD_PTR are consecutive registers
+    err_t error_flag = oximeter5_generic_read( ctx, OXIMETER5_REG_FIFO_WR_PTR, ptr_buf, 3 );
+    if ( OXIMETER5_OK != error_flag )
+    {
+        return error_flag;
+    }
+    
+    pending = ( ptr_buf[ 0 ] - ptr_buf[ 2 ] ) & OXIMETER5_FIFO_PTR_MASK;
+    if ( ptr_buf[ 1 ] )
+    {
+        // On overflow the write and read pointers are equal and the FIFO is full
+        pending = OXIMETER5_FIFO_DEPTH;
+        ring->overrun += ptr_buf[ 1 ];
+    }
+    if ( 0 == pending )
+    {
+        return OXIMETER5_OK;
+    }
+    
+    error_flag = oximeter5_generic_read( ctx, OXIMETER5_REG_FIFO_DATA, rx_buf, pending * OXIMETER5_FIFO_SAMPLE_SIZE );
+    if ( OXIMETER5_OK != error_flag )
+    {
+        return error_flag;
+    }
+    
+    sample = rx_buf;
+    for ( uint8_t cnt = 0; cnt < pending; cnt++ )
+    {
+        if ( ring->count == ring->size )
+        {
+            ring->head = ( ring->head + 1 ) % ring->size;
+            ring->count--;
+            ring->overrun++;
+        }
+        tail = ( ring->head + ring->count ) % ring->size;
+        ring->ir[ tail ] = ( ( ( uint32_t ) sample[ 0 ] << 16 ) | 
+                             ( ( uint32_t ) sample[ 1 ] << 8 ) | sample[ 2 ] ) & DATA_18_BIT;
+        ring->red[ tail ] = ( ( ( uint32_t ) sample[ 3 ] << 16 ) | 
+                              ( ( uint32_t ) sample[ 4 ] << 8 ) | sample[ 5 ] ) & DATA_18_BIT;
+        ring->count++;
+        sample += OXIMETER5_FIFO_SAMPLE_SIZE;
+    }
+    *num_samples = pending;
+  
+    return OXIMETER5_OK;
+}
+
+err_t oximeter5_ring_pop ( oximeter5_ring_t *ring, uint32_t *ir, uint32_t *red )
+{
+    if ( 0 == ring->count )
+    {
+        return OXIMETER5_ERROR;
+    }
+    
+    *ir = ring->ir[ ring->head ];
+    *red = ring->red[ ring->head ];
+    ring->head = ( ring->head + 1 ) % ring->size;
+    ring->count--;
+  
+    return OXIMETER5_OK;
+}
+
 err_t oximeter5_get_oxygen_saturation ( uint32_t *pun_ir_buffer, int32_t n_ir_buffer_length, uint32_t *pun_red_buffer, uint8_t *pn_spo2 )
 {
     uint32_t un_ir_mean;
@@ -556,6 +656,232 @@ err_t oximeter5_get_heart_rate ( uint32_t *pun_ir_buffer, int32_t n_ir_buffer_le
 
 }
 
+void oximeter5_estimator_init ( oximeter5_estimator_t *est )
+{
+    memset( est, 0, sizeof( oximeter5_estimator_t ) );
+    est->spo2 = OXIMETER5_PN_SPO2_ERROR_DATA;
+    est->heart_rate = OXIMETER5_HEART_RATE_ERROR_DATA;
+}
+
+uint8_t oximeter5_estimator_update ( oximeter5_estimator_t *est, uint32_t ir, uint32_t red )
+{
+    uint32_t n_idx = est->sample_cnt;
+    uint32_t n_rel;
+    uint8_t beat = OXIMETER5_ESTIMATOR_NO_BEAT;
+    int32_t n_x;
+    int32_t n_th;
+
+    est->ir_delay[ n_idx % OXIMETER5_ESTIMATOR_DELAY_SIZE ] = ir;
+    est->red_delay[ n_idx % OXIMETER5_ESTIMATOR_DELAY_SIZE ] = red;
+
+    // running DC removal, signal is inverted so that the peak detector finds valleys
+    if ( 0 == n_idx )
+    {
+        est->ir_dc = ( int32_t ) ir << 4;
+    }
+    est->ir_dc += ( ( ( int32_t ) ir << 4 ) - est->ir_dc ) >> ESTIMATOR_DC_SHIFT;
+    n_x = ( est->ir_dc >> 4 ) - ( int32_t ) ir;
+
+    // 4 pt Moving Average, value at n_idx matches the batch value at n_idx - 3
+    est->ma_sum += n_x - est->ma_buf[ n_idx % MA4_SIZE ];
+    est->ma_buf[ n_idx % MA4_SIZE ] = n_x;
+
+    if ( n_idx >= ( MA4_SIZE - 1 ) )
+    {
+        n_x = est->ma_sum / MA4_SIZE;
+        est->th_mean += ( ( n_x * 16 ) - est->th_mean ) >> ESTIMATOR_DC_SHIFT;
+        dev_estimator_detect( est, n_x, n_idx - ( MA4_SIZE - 1 ) );
+    }
+
+    // release the delayed raw sample, valleys up to this index are already confirmed
+    if ( n_idx >= ESTIMATOR_RELEASE_DELAY )
+    {
+        n_rel = n_idx - ESTIMATOR_RELEASE_DELAY;
+        if ( est->valley_pending && ( est->valley_idx == n_rel ) )
+        {
+            est->valley_pending = 0;
+            if ( est->seg_valid )
+            {
+                dev_estimator_beat( est, n_rel, est->ir_delay[ n_rel % OXIMETER5_ESTIMATOR_DELAY_SIZE ], 
+                                    est->red_delay[ n_rel % OXIMETER5_ESTIMATOR_DELAY_SIZE ] );
+                beat = OXIMETER5_ESTIMATOR_NEW_BEAT;
+            }
+            est->seg_valid = 1;
+            est->seg_start = n_rel;
+            est->seg_ir0 = est->ir_delay[ n_rel % OXIMETER5_ESTIMATOR_DELAY_SIZE ];
+            est->seg_red0 = est->red_delay[ n_rel % OXIMETER5_ESTIMATOR_DELAY_SIZE ];
+            est->seg_ir_max = OXIMETER5_N_X_DC_MAX;
+            est->seg_red_max = OXIMETER5_N_X_DC_MAX;
+        }
+        
+        if ( est->seg_valid )
+        {
+            n_x = est->ir_delay[ n_rel % OXIMETER5_ESTIMATOR_DELAY_SIZE ];
+            n_th = est->red_delay[ n_rel % OXIMETER5_ESTIMATOR_DELAY_SIZE ];
+            if ( n_x > est->seg_ir_max )
+            {
+                est->seg_ir_max = n_x;
+                est->seg_ir_max_idx = n_rel;
+            }
+            if ( n_th > est->seg_red_max )
+            {
+                est->seg_red_max = n_th;
+                est->seg_red_max_idx = n_rel;
+                est->seg_ir_at_red_max = n_x;
+            }
+            if ( ( n_rel - est->seg_start ) >= BUFFER_SIZE )
+            {
+                // no valley within the batch window, start over
+                est->seg_valid = 0;
+            }
+        }
+    }
+
+    est->sample_cnt++;
+    
+    return beat;
+}
+
+static void dev_estimator_detect ( oximeter5_estimator_t *est, int32_t n_val, uint32_t n_idx )
+{
+    int32_t n_th1 = est->th_mean >> 4;
+
+    if ( n_th1 < 30 )
+    {
+        n_th1 = 30; // min allowed
+    }
+    
+    if ( n_th1 > 60 )
+    {
+        n_th1 = 60; // max allowed
+    } 
+
+    if ( n_idx > 0 )
+    {
+        if ( n_val > est->prev_val )
+        {
+            est->rising = 1;
+            est->cand_idx = n_idx;
+        }
+        else if ( n_val < est->prev_val )
+        {
+            if ( est->rising && ( est->prev_val > n_th1 ) )
+            {
+                // keep the higher one of two peaks closer than the minimum distance
+                if ( est->peak_pending && ( ( est->cand_idx - est->peak_idx ) <= ESTIMATOR_PEAK_DISTANCE ) )
+                {
+                    if ( est->prev_val > est->peak_val )
+                    {
+                        est->peak_idx = est->cand_idx;
+                        est->peak_val = est->prev_val;
+                    }
+                }
+                else
+                {
+                    est->peak_pending = 1;
+                    est->peak_idx = est->cand_idx;
+                    est->peak_val = est->prev_val;
+                }
+            }
+            est->rising = 0;
+        }
+    }
+    est->prev_val = n_val;
+
+    if ( est->peak_pending && ( ( n_idx - est->peak_idx ) > ESTIMATOR_PEAK_DISTANCE ) )
+    {
+        est->peak_pending = 0;
+        est->valley_pending = 1;
+        est->valley_idx = est->peak_idx;
+    }
+}
+
+static void dev_estimator_beat ( oximeter5_estimator_t *est, uint32_t n_idx, int32_t n_ir, int32_t n_red )
+{
+    int32_t n_len = n_idx - est->seg_start;
+    int32_t n_y_ac, n_x_ac;
+    int32_t n_nume, n_denom;
+    int32_t an_ratio[ OXIMETER5_ESTIMATOR_NUM_RATIOS ];
+    int32_t n_ratio_average;
+    int32_t n_temp;
+    uint16_t n_interval_sum = 0;
+    uint8_t n_middle_idx;
+    uint8_t n_cnt_i, n_cnt_j;
+
+    // heart rate from the average of the last beat intervals
+    est->intervals[ est->interval_idx ] = n_len;
+    est->interval_idx = ( est->interval_idx + 1 ) % OXIMETER5_ESTIMATOR_NUM_INTERVALS;
+    if ( est->interval_cnt < OXIMETER5_ESTIMATOR_NUM_INTERVALS )
+    {
+        est->interval_cnt++;
+    }
+    for ( n_cnt_i = 0; n_cnt_i < est->interval_cnt; n_cnt_i++ )
+    {
+        n_interval_sum += est->intervals[ n_cnt_i ];
+    }
+    est->heart_rate = ( int32_t ) ( ( SAMPLING_FREQUENCY * 60 ) / ( n_interval_sum / est->interval_cnt ) );
+
+    if ( n_len <= 3 )
+    {
+        return;
+    }
+
+    // AC of Red and IR above the linear DC between the two valleys, same as the batch function
+    n_y_ac = ( n_red - est->seg_red0 ) * ( int32_t ) ( est->seg_red_max_idx - est->seg_start ); 
+    n_y_ac = est->seg_red0 + n_y_ac / n_len; 
+    n_y_ac = est->seg_red_max - n_y_ac;
+    n_x_ac = ( n_ir - est->seg_ir0 ) * ( int32_t ) ( est->seg_ir_max_idx - est->seg_start ); 
+    n_x_ac = est->seg_ir0 + n_x_ac / n_len; 
+    n_x_ac = est->seg_ir_at_red_max - n_x_ac;
+    n_nume = ( n_y_ac * est->seg_ir_max ) >> 7; 
+    n_denom = ( n_x_ac * est->seg_red_max ) >> 7;
+    
+    if ( ( n_denom > 0 ) && ( n_nume != 0 ) )
+    {   
+        est->ratios[ est->ratio_idx ] = ( n_nume * 100 ) / n_denom;
+        est->ratio_idx = ( est->ratio_idx + 1 ) % OXIMETER5_ESTIMATOR_NUM_RATIOS;
+        if ( est->ratio_cnt < OXIMETER5_ESTIMATOR_NUM_RATIOS )
+        {
+            est->ratio_cnt++;
+        }
+    }
+    
+    if ( 0 == est->ratio_cnt )
+    {
+        return;
+    }
+
+    // median of the ratio window, at most OXIMETER5_ESTIMATOR_NUM_RATIOS entries
+    for ( n_cnt_i = 0; n_cnt_i < est->ratio_cnt; n_cnt_i++ )
+    {
+        n_temp = est->ratios[ n_cnt_i ];
+        for ( n_cnt_j = n_cnt_i; ( n_cnt_j > 0 ) && ( n_temp < an_ratio[ n_cnt_j - 1 ] ); n_cnt_j-- )
+        {
+            an_ratio[ n_cnt_j ] = an_ratio[ n_cnt_j - 1 ];
+        }
+        an_ratio[ n_cnt_j ] = n_temp;
+    }
+    n_middle_idx = est->ratio_cnt / 2;
+
+    if ( n_middle_idx > 1 )
+    {
+        n_ratio_average = ( an_ratio[ n_middle_idx - 1 ] + an_ratio[ n_middle_idx ] ) / 2; 
+    }
+    else
+    {
+        n_ratio_average = an_ratio[ n_middle_idx ];
+    }
+    
+    if ( ( n_ratio_average > 2 ) && ( n_ratio_average < 184 ) )
+    {
+        est->spo2 = uch_spo2_table[ n_ratio_average ];
+    }
+    else
+    {
+        est->spo2 = OXIMETER5_PN_SPO2_ERROR_DATA;
+    }
+}
+
 static void dev_peaks_above_min_height ( int32_t *pn_locs, int32_t *n_npks,  int32_t  *pn_x, uint8_t n_size, int32_t n_min_height )
 {
     uint8_t n_width;
@@ -124,6 +124,14 @@ extern "C"{
 #define PAC1720_RSENSE_OHM                      0.004
 #define PAC1720_POWER_RATIO_RESOLUTION          65535
 
+/**
+ * @brief PAC1720 snapshot settings.
+ * @details Number of channels and the size of the measurement data block
+ * (CH1 VSENSE to CH2 POWER RATIO) of PAC1720 Click driver.
+ */
+#define PAC1720_NUM_CH                          2
+#define PAC1720_SNAPSHOT_BLOCK_SIZE             12
+
 /**
  * @brief PAC1720 product ID value.
  * @details Specified product ID value of PAC1720 Click driver.
@@ -196,6 +204,12 @@ typedef struct
     
     uint8_t ch2_vsrc_cfg;
     uint8_t ch2_vsense_cfg;
+    
+    uint8_t vsrc_shift[ PAC1720_NUM_CH ];       /**< Vsource data right shift. */
+    uint8_t vsense_shift[ PAC1720_NUM_CH ];     /**< Vsense data right shift. */
+    float vsrc_scale[ PAC1720_NUM_CH ];         /**< Vsource LSB weight [V]. */
+    float isense_scale[ PAC1720_NUM_CH ];       /**< Vsense LSB weight [A]. */
+    float power_scale[ PAC1720_NUM_CH ];        /**< Power ratio LSB weight [W]. */
 
 } pac1720_t;
 
@@ -281,6 +295,18 @@ typedef enum
 
 } pac1720_cs_rng_t;
 
+/**
+ * @brief PAC1720 Click snapshot object.
+ * @details Measurements of both channels read in a single transaction of PAC1720 Click driver.
+ */
+typedef struct
+{
+    float voltage[ PAC1720_NUM_CH ];            /**< Voltage [V]. */
+    float current[ PAC1720_NUM_CH ];            /**< Current [A]. */
+    float power[ PAC1720_NUM_CH ];              /**< Power [W]. */
+
+} pac1720_snapshot_t;
+
 /*!
  * @addtogroup pac1720 PAC1720 Click Driver
  * @brief API for configuring and manipulating PAC1720 Click driver.
@@ -524,6 +550,24 @@ err_t pac1720_set_vsense_config ( pac1720_t *ctx, pac1720_ch_sel_t ch, pac1720_s
 err_t pac1720_get_measurements ( pac1720_t *ctx, pac1720_ch_sel_t ch, 
                                  float *voltage, float *current, float *power );
 
+/**
+ * @brief PAC1720 get snapshot function.
+ * @details This function reads Vsense, Vsource and power ratio registers of both channels 
+ * in a single I2C transaction and converts them using the scale factors precomputed 
+ * by the configuration functions.
+ * @param[in] ctx : Click context object.
+ * See #pac1720_t object definition for detailed explanation.
+ * @param[out] snap : Voltage, current and power of both channels.
+ * See #pac1720_snapshot_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note Vsource and Vsense must be configured with pac1720_set_vsource_config and 
+ * pac1720_set_vsense_config functions before calling this function.
+ */
+err_t pac1720_get_snapshot ( pac1720_t *ctx, pac1720_snapshot_t *snap );
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,17 @@
 
 #include "pac1720.h"
 
+/**
+ * @brief PAC1720 update scale function.
+ * @details This function precomputes the data shifts and LSB weights of the selected
+ * channel from its current Vsource and Vsense configuration.
+ * @param[in] ctx : Click context object.
+ * See #pac1720_t object definition for detailed explanation.
+ * @param[in] ch : Channel selection.
+ * @return None.
+ */
+static void pac1720_update_scale ( pac1720_t *ctx, pac1720_ch_sel_t ch );
+
 void pac1720_cfg_setup ( pac1720_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -185,6 +196,8 @@ err_t pac1720_set_vsource_config ( pac1720_t *ctx, pac1720_ch_sel_t ch,
     
     ctx->ch1_vsrc_cfg = vsrc_data & 0x0F;
     ctx->ch2_vsrc_cfg = ( vsrc_data & 0xF0 ) >> 4; 
+    pac1720_update_scale ( ctx, PAC1720_CHANNEL_1 );
+    pac1720_update_scale ( ctx, PAC1720_CHANNEL_2 );
     
     error_flag |= pac1720_write_byte ( ctx, PAC1720_REG_VSOURCE_CONFIG, vsrc_data );
     return error_flag;
@@ -198,11 +211,13 @@ err_t pac1720_set_vsense_config ( pac1720_t *ctx, pac1720_ch_sel_t ch, pac1720_s
     if ( PAC1720_CHANNEL_1 == ch )
     {
         ctx->ch1_vsense_cfg = vsense_data;
+        pac1720_update_scale ( ctx, ch );
         return pac1720_write_byte ( ctx, PAC1720_REG_CH1_VSENSE_CONFIG, vsense_data );
     }
     else if ( PAC1720_CHANNEL_2 == ch )
     {
         ctx->ch2_vsense_cfg = vsense_data;
+        pac1720_update_scale ( ctx, ch );
         return pac1720_write_byte ( ctx, PAC1720_REG_CH2_VSENSE_CONFIG, vsense_data );
     }
     else
@@ -278,4 +293,50 @@ err_t pac1720_get_measurements ( pac1720_t *ctx, pac1720_ch_sel_t ch,
     return error_flag;
 }
 
+err_t pac1720_get_snapshot ( pac1720_t *ctx, pac1720_snapshot_t *snap )
+{
+    uint8_t rx_buf[ PAC1720_SNAPSHOT_BLOCK_SIZE ] = { 0 };
+    
+    // CH1/CH2 Vsense, CH1/CH2 Vsource and CH1/CH2 power ratio, high byte first
+    err_t error_flag = pac1720_read_block ( ctx, PAC1720_REG_CH1_VSENSE_HIGH_BYTE, 
+                                            rx_buf, PAC1720_SNAPSHOT_BLOCK_SIZE );
+    
+    for ( uint8_t ch = 0; ch < PAC1720_NUM_CH; ch++ )
+    {
+        int16_t vsense = ( ( uint16_t ) rx_buf[ ch * 2 ] << 8 ) | rx_buf[ ch * 2 + 1 ];
+        uint16_t vsrc = ( ( uint16_t ) rx_buf[ ch * 2 + 4 ] << 8 ) | rx_buf[ ch * 2 + 5 ];
+        uint16_t pratio = ( ( uint16_t ) rx_buf[ ch * 2 + 8 ] << 8 ) | rx_buf[ ch * 2 + 9 ];
+        
+        vsense >>= ctx->vsense_shift[ ch ];
+        vsrc >>= ctx->vsrc_shift[ ch ];
+        
+        snap->voltage[ ch ] = vsrc * ctx->vsrc_scale[ ch ];
+        snap->current[ ch ] = vsense * ctx->isense_scale[ ch ];
+        snap->power[ ch ] = pratio * ctx->power_scale[ ch ];
+    }
+    return error_flag;
+}
+
+static void pac1720_update_scale ( pac1720_t *ctx, pac1720_ch_sel_t ch )
+{
+    uint8_t idx = ch - PAC1720_CHANNEL_1;
+    uint8_t vsrc_cfg = ( PAC1720_CHANNEL_1 == ch ) ? ctx->ch1_vsrc_cfg : ctx->ch2_vsrc_cfg;
+    uint8_t vsense_cfg = ( PAC1720_CHANNEL_1 == ch ) ? ctx->ch1_vsense_cfg : ctx->ch2_vsense_cfg;
+    
+    uint8_t vsrc_stime = vsrc_cfg >> 2;
+    uint16_t vsrc_den = ( 256 << vsrc_stime ) - 1;
+    float fsv = PAC1720_MAX_VOLTAGE - PAC1720_MAX_VOLTAGE / ( vsrc_den + 1 );
+    
+    uint8_t vsense_stime = ( ( vsense_cfg >> 4 ) < 5 ) ? ( vsense_cfg >> 4 ) : 5;
+    uint16_t vsense_den = ( ( uint16_t ) 64 << vsense_stime ) - 1;
+    float fsr = PAC1720_CURRENT_SENSE_RANGE_V * ( 1 << ( vsense_cfg & 0x03 ) );
+    float fsc = fsr / PAC1720_RSENSE_OHM;
+    
+    ctx->vsrc_shift[ idx ] = 8 - vsrc_stime;
+    ctx->vsrc_scale[ idx ] = fsv / vsrc_den;
+    ctx->vsense_shift[ idx ] = 9 - vsense_stime;
+    ctx->isense_scale[ idx ] = fsc / vsense_den;
+    ctx->power_scale[ idx ] = ( fsc * fsv ) / PAC1720_POWER_RATIO_RESOLUTION;
+}
+
 // ------------------------------------------------------------------------- END
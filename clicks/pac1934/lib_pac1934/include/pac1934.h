@@ -180,6 +180,8 @@
  */
 #define PAC1934_CHANNEL_DIS                                   0x1C
 #define PAC1934_CHANNEL_DIS_ALL_CHA                      0xF0
+#define PAC1934_CHANNEL_DIS_CH1_OFF                      0x80
+#define PAC1934_CHANNEL_DIS_NO_SKIP                      0x02
 /** \} */
 
 /**
@@ -187,6 +189,8 @@
  * \{
  */
 #define PAC1934_NEG_PWR                                       0x1D
+#define PAC1934_NEG_PWR_CH1_BIDI                         0x80
+#define PAC1934_NEG_PWR_CH1_BIDV                         0x08
 /** \} */
 
 /**
@@ -274,6 +278,14 @@
 #define PAC1934_REVISION_ID                                   0xFF
 /** \} */
 
+/**
+ * \defgroup snapshot   Snapshot
+ * \{
+ */
+#define PAC1934_NUM_CH                                        4
+#define PAC1934_SNAPSHOT_BLOCK_SIZE                           75
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -302,6 +314,16 @@ typedef struct
 
     uint8_t slave_address;
 
+    // Snapshot settings
+
+    uint8_t snap_ch_mask;
+    uint8_t snap_no_skip;
+    uint8_t vbus_bipolar;
+    uint8_t vsense_bipolar;
+    uint8_t power_bipolar;
+    float vbus_scale[ PAC1934_NUM_CH ];
+    float isense_scale[ PAC1934_NUM_CH ];
+    float power_scale[ PAC1934_NUM_CH ];
 
 } pac1934_t;
 
@@ -328,6 +350,24 @@ typedef struct
 
 } pac1934_cfg_t;
 
+/**
+ * @brief Snapshot structure definition.
+ * 
+ * @note Disabled channels are reported as zero.
+ */
+typedef struct
+{
+    uint8_t ch_mask;                        // Enabled channels (bit 0 - CH1)
+    uint32_t acc_count;                     // Accumulator count
+    float vbus[ PAC1934_NUM_CH ];           // Bus voltage [V]
+    float isense[ PAC1934_NUM_CH ];         // Sense current [mA]
+    float vbus_avg[ PAC1934_NUM_CH ];       // Averaged bus voltage [V]
+    float isense_avg[ PAC1934_NUM_CH ];     // Averaged sense current [mA]
+    float power[ PAC1934_NUM_CH ];          // Power [W]
+    float power_acc[ PAC1934_NUM_CH ];      // Sum of acc_count power samples [W]
+
+} pac1934_snapshot_t;
+
 /** \} */ // End types group
 
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
@@ -537,6 +577,35 @@ float pac1934_calc_power ( pac1934_t *ctx, float voltage, float amperage );
  */
 float pac1934_measure_energy ( pac1934_t *ctx, uint8_t chann, uint16_t samp_rate );
 
+/**
+ * @brief Snapshot setup function.
+ * 
+ * @param ctx          Click object.
+ *
+ * @note This function sends the REFRESH command, which resets the accumulators.
+ * It should be called again after every change of the CHANNEL_DIS or NEG_PWR registers.
+ *
+ * @description This function applies the pending configuration, reads the active channel 
+ * and bidirectional settings and precomputes the per-channel scale factors used by 
+ * pac1934_get_snapshot.
+ */
+void pac1934_snapshot_setup ( pac1934_t *ctx );
+
+/**
+ * @brief Get snapshot function.
+ * 
+ * @param ctx          Click object.
+ * @param snap         Snapshot of all channel measurements.
+ *
+ * @note pac1934_snapshot_setup must be called before this function. Energy in Joules
+ * is power_acc divided by the sample rate.
+ *
+ * @description This function sends the REFRESH_V command and reads the accumulator count, 
+ * accumulated power, VBUS, VSENSE, their averages and power of all enabled channels 
+ * in a single I2C transaction, then converts them using the precomputed scale factors.
+ */
+void pac1934_get_snapshot ( pac1934_t *ctx, pac1934_snapshot_t *snap );
+
 /**
  * @brief Enable device function.
  * 
@@ -29,6 +29,12 @@
 
 #include "pac1934.h"
 
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static uint8_t dev_decode_block ( uint8_t *data_in, uint8_t n_bytes, uint8_t n_bits, 
+                                  uint8_t present, uint8_t active, uint8_t bipolar, 
+                                  float *scale, float *data_out );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void pac1934_cfg_setup ( pac1934_cfg_t *cfg )
@@ -296,5 +302,146 @@ uint8_t pac1934_check_interrupt ( pac1934_t *ctx )
     return digital_in_read( &ctx->ale );
 }
 
+void pac1934_snapshot_setup ( pac1934_t *ctx )
+{
+    uint8_t dis_act;
+    uint8_t neg_pwr_act;
+    uint8_t ch_bit;
+    uint8_t ch;
+
+    pac1934_send_command( ctx, PAC1934_REFRESH_CMD );
+    Delay_1ms( );
+
+    dis_act = pac1934_read_byte( ctx, PAC1934_DIS_ACT );
+    neg_pwr_act = pac1934_read_byte( ctx, PAC1934_NEG_PWR_ACT );
+
+    ctx->snap_ch_mask = 0;
+    ctx->snap_no_skip = ( dis_act & PAC1934_CHANNEL_DIS_NO_SKIP ) ? 1 : 0;
+    ctx->vbus_bipolar = 0;
+    ctx->vsense_bipolar = 0;
+    ctx->power_bipolar = 0;
+
+    for ( ch = 0; ch < PAC1934_NUM_CH; ch++ )
+    {
+        ch_bit = 1 << ch;
+
+        if ( ( dis_act & ( PAC1934_CHANNEL_DIS_CH1_OFF >> ch ) ) == 0 )
+        {
+            ctx->snap_ch_mask |= ch_bit;
+        }
+
+        ctx->vbus_scale[ ch ] = 32.0 / 0xFFFF;
+        ctx->isense_scale[ ch ] = 25000.0 / 0xFFFF;
+        ctx->power_scale[ ch ] = 0.0000029802;
+
+        if ( neg_pwr_act & ( PAC1934_NEG_PWR_CH1_BIDV >> ch ) )
+        {
+            ctx->vbus_bipolar |= ch_bit;
+            ctx->vbus_scale[ ch ] = 32.0 / 0x8000;
+        }
+
+        if ( neg_pwr_act & ( PAC1934_NEG_PWR_CH1_BIDI >> ch ) )
+        {
+            ctx->vsense_bipolar |= ch_bit;
+            ctx->isense_scale[ ch ] = 25000.0 / 0x8000;
+        }
+
+        if ( ( ctx->vbus_bipolar | ctx->vsense_bipolar ) & ch_bit )
+        {
+            ctx->power_bipolar |= ch_bit;
+            ctx->power_scale[ ch ] = 0.0000059605;
+        }
+    }
+}
+
+void pac1934_get_snapshot ( pac1934_t *ctx, pac1934_snapshot_t *snap )
+{
+    uint8_t rx_buf[ PAC1934_SNAPSHOT_BLOCK_SIZE ] = { 0 };
+    uint8_t present;
+    uint8_t n_ch = 0;
+    uint8_t idx = 3;
+    uint8_t ch;
+
+    present = ctx->snap_ch_mask;
+
+    if ( ctx->snap_no_skip )
+    {
+        present = ( 1 << PAC1934_NUM_CH ) - 1;
+    }
+
+    for ( ch = 0; ch < PAC1934_NUM_CH; ch++ )
+    {
+        n_ch += ( present >> ch ) & 0x01;
+    }
+
+    pac1934_send_command( ctx, PAC1934_REFRESH_V_CMD );
+    Delay_1ms( );
+
+    // ACC_COUNT [3], VPOWER_ACC [6], VBUS [2], VSENSE [2], VBUS_AVG [2], VSENSE_AVG [2], VPOWER [4]
+    pac1934_generic_read( ctx, PAC1934_ACC_COUNT, rx_buf, 3 + n_ch * 18 );
+
+    snap->ch_mask = ctx->snap_ch_mask;
+    snap->acc_count = rx_buf[ 0 ];
+    snap->acc_count <<= 8;
+    snap->acc_count |= rx_buf[ 1 ];
+    snap->acc_count <<= 8;
+    snap->acc_count |= rx_buf[ 2 ];
+
+    idx += dev_decode_block( &rx_buf[ idx ], 6, 48, present, ctx->snap_ch_mask, 
+                             ctx->power_bipolar, ctx->power_scale, snap->power_acc );
+    idx += dev_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                             ctx->vbus_bipolar, ctx->vbus_scale, snap->vbus );
+    idx += dev_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                             ctx->vsense_bipolar, ctx->isense_scale, snap->isense );
+    idx += dev_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                             ctx->vbus_bipolar, ctx->vbus_scale, snap->vbus_avg );
+    idx += dev_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                             ctx->vsense_bipolar, ctx->isense_scale, snap->isense_avg );
+    dev_decode_block( &rx_buf[ idx ], 4, 28, present, ctx->snap_ch_mask, 
+                      ctx->power_bipolar, ctx->power_scale, snap->power );
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint8_t dev_decode_block ( uint8_t *data_in, uint8_t n_bytes, uint8_t n_bits, 
+                                  uint8_t present, uint8_t active, uint8_t bipolar, 
+                                  float *scale, float *data_out )
+{
+    uint8_t *p_data = data_in;
+    int64_t raw;
+    uint8_t ch;
+    uint8_t cnt;
+
+    for ( ch = 0; ch < PAC1934_NUM_CH; ch++ )
+    {
+        data_out[ ch ] = 0;
+
+        if ( ( present & ( 1 << ch ) ) == 0 )
+        {
+            continue;
+        }
+
+        raw = 0;
+        for ( cnt = 0; cnt < n_bytes; cnt++ )
+        {
+            raw <<= 8;
+            raw |= *p_data++;
+        }
+        raw >>= ( n_bytes * 8 - n_bits );
+
+        if ( ( bipolar & ( 1 << ch ) ) && ( raw & ( ( int64_t ) 1 << ( n_bits - 1 ) ) ) )
+        {
+            raw -= ( int64_t ) 1 << n_bits;
+        }
+
+        if ( active & ( 1 << ch ) )
+        {
+            data_out[ ch ] = raw * scale[ ch ];
+        }
+    }
+
+    return ( uint8_t ) ( p_data - data_in );
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -210,6 +210,22 @@ extern "C"{
 
 /*! @} */ // meas_mode
 
+/**
+ * @addtogroup snapshot
+ * @{
+ */
+
+/**
+ * @brief PAC1944 Snapshot settings.
+ * @details Number of channels and the maximal size of the data block
+ * (ACC_COUNT to VPOWER4) read by the snapshot function of the PAC1944 Click driver.
+ */
+
+#define PAC1944_NUM_CH                                4
+#define PAC1944_SNAPSHOT_BLOCK_SIZE                   80
+
+/*! @} */ // snapshot
+
 /**
  * @addtogroup state
  * @{
@@ -289,6 +305,10 @@ extern "C"{
 #define PAC1944_SMBUS_AUTO_INC_SKIP_OFF               0x02
 #define PAC1944_SMBUS_I2C_HIGH_SPEED                  0x01
 
+#define PAC1944_ACC_CFG_VPOWER                        0
+#define PAC1944_ACC_CFG_VSENSE                        1
+#define PAC1944_ACC_CFG_VBUS                          2
+
 /**
  * @brief PAC1944 device address setting.
  * @details Specified setting for device slave address selection of
@@ -361,6 +381,19 @@ typedef struct
 
     uint8_t slave_address;                           /**< Device slave address (used for I2C driver). */
 
+    // Snapshot settings
+
+    uint8_t snap_ch_mask;                            /**< Enabled channels (bit 0 - CH1). */
+    uint8_t snap_no_skip;                            /**< Disabled channels are not skipped in block reads. */
+    uint8_t vbus_bipolar;                            /**< Channels with bipolar VBUS data. */
+    uint8_t vsense_bipolar;                          /**< Channels with bipolar VSENSE data. */
+    uint8_t power_bipolar;                           /**< Channels with bipolar power data. */
+    uint8_t acc_bipolar;                             /**< Channels with bipolar accumulator data. */
+    float   vbus_scale[ PAC1944_NUM_CH ];            /**< VBUS LSB weight [V]. */
+    float   isense_scale[ PAC1944_NUM_CH ];          /**< VSENSE LSB weight [A]. */
+    float   power_scale[ PAC1944_NUM_CH ];           /**< Power LSB weight [W]. */
+    float   acc_scale[ PAC1944_NUM_CH ];             /**< Accumulator LSB weight. */
+
 } pac1944_t;
 
 /**
@@ -402,6 +435,25 @@ typedef struct
     
 } pac1944_setup_t;
 
+/**
+ * @brief PAC1944 Snapshot structure.
+ * @details All channel measurements taken from a single refresh of PAC1944 Click driver.
+ * Disabled channels are reported as zero.
+ */
+typedef struct
+{
+    uint8_t  ch_mask;                                /**< Enabled channels (bit 0 - CH1). */
+    uint32_t acc_count;                              /**< Accumulator count. */
+    float    vbus[ PAC1944_NUM_CH ];                 /**< Bus voltage [V]. */
+    float    isense[ PAC1944_NUM_CH ];               /**< Sense current [A]. */
+    float    vbus_avg[ PAC1944_NUM_CH ];             /**< Averaged bus voltage [V]. */
+    float    isense_avg[ PAC1944_NUM_CH ];           /**< Averaged sense current [A]. */
+    float    power[ PAC1944_NUM_CH ];                /**< Power [W]. */
+    float    acc[ PAC1944_NUM_CH ];                  /**< Accumulator output, sum of acc_count samples 
+                                                          of the accumulated quantity [W], [A] or [V]. */
+    
+} pac1944_snapshot_t;
+
 /*!
  * @addtogroup pac1944 PAC1944 Click Driver
  * @brief API for configuring and manipulating PAC1944 Click driver.
@@ -711,6 +763,44 @@ uint32_t pac1944_get_measurement ( pac1944_t *ctx, uint8_t meas_sel, uint8_t ch_
  */
 float pac1944_get_calc_measurement ( pac1944_t *ctx, uint8_t meas_sel, uint8_t ch_sel, uint8_t avg_sel, uint8_t meas_mode );
 
+/**
+ * @brief PAC1944 snapshot setup function.
+ * @details This function issues the REFRESH command to apply the pending configuration, 
+ * then reads the active channel, measurement mode and accumulator settings and 
+ * precomputes the per-channel scale factors used by #pac1944_get_snapshot.
+ * @param[in] ctx : Click context object.
+ * See #pac1944_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note This function resets the accumulators. It should be called again after 
+ * every change of the CTRL, NEG_PWR_FSR, ACC_CFG or SMBUS_CFG registers.
+ *
+ * @endcode
+ */
+err_t pac1944_snapshot_setup ( pac1944_t *ctx );
+
+/**
+ * @brief PAC1944 get snapshot function.
+ * @details This function issues the REFRESH_V command and reads the accumulator count, 
+ * accumulator outputs, VBUS, VSENSE, their averages and power of all enabled channels 
+ * in a single I2C transaction, then converts them using the precomputed scale factors.
+ * @param[in] ctx : Click context object.
+ * See #pac1944_t object definition for detailed explanation.
+ * @param[out] snap : Snapshot of all channel measurements.
+ * See #pac1944_snapshot_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note #pac1944_snapshot_setup must be called before this function.
+ * The accumulators are not reset by this function.
+ *
+ * @endcode
+ */
+err_t pac1944_get_snapshot ( pac1944_t *ctx, pac1944_snapshot_t *snap );
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,26 @@
 #define PAC1944_TWOS_COMP_PWR_SIGN_NEGATIVE           0x20000000
 #define PAC1944_TWOS_COMP_PWR_SIGN_CONV               0xC0000000
 
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+/**
+ * @brief PAC1944 decode block function.
+ * @details This function decodes one register group (e.g. VBUS1-VBUS4) of the
+ * snapshot data block and converts it using the per-channel scale factors.
+ * @param[in] data_in : Register group data.
+ * @param[in] n_bytes : Register size in bytes.
+ * @param[in] n_bits : Number of valid, MSB aligned, data bits.
+ * @param[in] present : Channels present in the data block.
+ * @param[in] active : Enabled channels, the others are reported as zero.
+ * @param[in] bipolar : Channels with two's complement data.
+ * @param[in] scale : Per-channel LSB weights.
+ * @param[out] data_out : Converted data for all channels.
+ * @return Number of bytes consumed from the data block.
+ */
+static uint8_t dev_decode_block ( uint8_t *data_in, uint8_t n_bytes, uint8_t n_bits, 
+                                  uint8_t present, uint8_t active, uint8_t bipolar, 
+                                  float *scale, float *data_out );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void pac1944_cfg_setup ( pac1944_cfg_t *cfg ) {
@@ -427,6 +447,191 @@ float pac1944_get_calc_measurement ( pac1944_t *ctx, uint8_t meas_sel, uint8_t c
     return res;
 }
 
+err_t pac1944_snapshot_setup ( pac1944_t *ctx ) {
+    uint8_t ctrl_act[ 2 ] = { DUMMY };
+    uint8_t neg_pwr_act[ 2 ] = { DUMMY };
+    uint8_t smbus_cfg = DUMMY;
+    uint8_t acc_cfg = DUMMY;
+    uint8_t offset;
+    uint8_t vs_mode;
+    uint8_t vb_mode;
+    uint8_t acc_mode;
+    uint8_t ch_bit;
+    uint8_t ch;
+    err_t error_flag;
+    
+    pac1944_refresh_cmd( ctx );
+    
+    error_flag = pac1944_generic_read( ctx, PAC1944_REG_CTRL_ACT, ctrl_act, 2 );
+    error_flag |= pac1944_generic_read( ctx, PAC1944_REG_NEG_PWR_FSR_ACT, neg_pwr_act, 2 );
+    error_flag |= pac1944_generic_read( ctx, PAC1944_REG_SMBUS_CFG, &smbus_cfg, 1 );
+    error_flag |= pac1944_generic_read( ctx, PAC1944_REG_ACC_CFG_ACT, &acc_cfg, 1 );
+    
+    ctx->snap_ch_mask = DUMMY;
+    ctx->snap_no_skip = ( smbus_cfg & PAC1944_SMBUS_AUTO_INC_SKIP_OFF ) ? 1 : 0;
+    ctx->vbus_bipolar = DUMMY;
+    ctx->vsense_bipolar = DUMMY;
+    ctx->power_bipolar = DUMMY;
+    ctx->acc_bipolar = DUMMY;
+    
+    for ( ch = 0; ch < PAC1944_NUM_CH; ch++ )
+    {
+        // Channel 1 settings are in the most significant bits of each register
+        offset = PAC1944_NEG_PWR_FSR_CH1_OFFSET - ( ch * 2 );
+        vs_mode = ( neg_pwr_act[ 0 ] >> offset ) & 0x03;
+        vb_mode = ( neg_pwr_act[ 1 ] >> offset ) & 0x03;
+        acc_mode = ( acc_cfg >> offset ) & 0x03;
+        ch_bit = 1 << ch;
+        
+        if ( ( ctrl_act[ 1 ] & ( PAC1944_CTRLL_CH1_OFF >> ch ) ) == 0 )
+        {
+            ctx->snap_ch_mask |= ch_bit;
+        }
+        
+        ctx->vbus_scale[ ch ] = ( float ) PAC1944_FSR_VSOURCE_V / PAC1944_CALC_DENOMINATOR_UNIPOLAR;
+        ctx->isense_scale[ ch ] = ( float ) PAC1944_FSR_ISENSE_A / PAC1944_CALC_DENOMINATOR_UNIPOLAR;
+        ctx->power_scale[ ch ] = ( float ) PAC1944_FSR_PSENSE_W / PAC1944_CALC_PWR_DENOMINATOR_UNIPOLAR;
+        
+        if ( vb_mode != PAC1944_MEAS_MODE_UNIPOLAR_FSR )
+        {
+            ctx->vbus_bipolar |= ch_bit;
+            ctx->vbus_scale[ ch ] = ( float ) PAC1944_FSR_VSOURCE_V / PAC1944_CALC_DENOMINATOR_BIPOLAR;
+            
+            if ( vb_mode != PAC1944_MEAS_MODE_BIPOLAR_FSR )
+            {
+                ctx->vbus_scale[ ch ] /= 2;
+            }
+        }
+        
+        if ( vs_mode != PAC1944_MEAS_MODE_UNIPOLAR_FSR )
+        {
+            ctx->vsense_bipolar |= ch_bit;
+            ctx->isense_scale[ ch ] = ( float ) PAC1944_FSR_ISENSE_A / PAC1944_CALC_DENOMINATOR_BIPOLAR;
+            
+            if ( vs_mode != PAC1944_MEAS_MODE_BIPOLAR_FSR )
+            {
+                ctx->isense_scale[ ch ] /= 2;
+            }
+        }
+        
+        if ( ( ctx->vbus_bipolar | ctx->vsense_bipolar ) & ch_bit )
+        {
+            ctx->power_bipolar |= ch_bit;
+            ctx->power_scale[ ch ] = ( float ) PAC1944_FSR_PSENSE_W / PAC1944_CALC_PWR_DENOMINATOR_BIPOLAR;
+            
+            if ( ( vb_mode > PAC1944_MEAS_MODE_BIPOLAR_FSR ) || ( vs_mode > PAC1944_MEAS_MODE_BIPOLAR_FSR ) )
+            {
+                ctx->power_scale[ ch ] /= 2;
+            }
+        }
+        
+        if ( acc_mode == PAC1944_ACC_CFG_VSENSE )
+        {
+            ctx->acc_scale[ ch ] = ctx->isense_scale[ ch ];
+            ctx->acc_bipolar |= ( ctx->vsense_bipolar & ch_bit );
+        }
+        else if ( acc_mode == PAC1944_ACC_CFG_VBUS )
+        {
+            ctx->acc_scale[ ch ] = ctx->vbus_scale[ ch ];
+            ctx->acc_bipolar |= ( ctx->vbus_bipolar & ch_bit );
+        }
+        else
+        {
+            ctx->acc_scale[ ch ] = ctx->power_scale[ ch ];
+            ctx->acc_bipolar |= ( ctx->power_bipolar & ch_bit );
+        }
+    }
+    
+    return error_flag;
+}
+
+err_t pac1944_get_snapshot ( pac1944_t *ctx, pac1944_snapshot_t *snap ) {
+    uint8_t rx_buf[ PAC1944_SNAPSHOT_BLOCK_SIZE ] = { DUMMY };
+    uint8_t present = ctx->snap_ch_mask;
+    uint8_t n_ch = 0;
+    uint8_t idx = 4;
+    uint8_t ch;
+    err_t error_flag;
+    
+    if ( ctx->snap_no_skip )
+    {
+        present = ( 1 << PAC1944_NUM_CH ) - 1;
+    }
+    
+    for ( ch = 0; ch < PAC1944_NUM_CH; ch++ )
+    {
+        n_ch += ( present >> ch ) & 0x01;
+    }
+    
+    pac1944_volatile_refresh_cmd( ctx );
+    
+    // ACC_COUNT [4], VACC [7], VBUS [2], VSENSE [2], VBUS_AVG [2], VSENSE_AVG [2], VPOWER [4]
+    error_flag = pac1944_generic_read( ctx, PAC1944_REG_ACC_COUNT, rx_buf, 4 + n_ch * 19 );
+    
+    snap->ch_mask = ctx->snap_ch_mask;
+    snap->acc_count = rx_buf[ 0 ];
+    snap->acc_count <<= 8;
+    snap->acc_count |= rx_buf[ 1 ];
+    snap->acc_count <<= 8;
+    snap->acc_count |= rx_buf[ 2 ];
+    snap->acc_count <<= 8;
+    snap->acc_count |= rx_buf[ 3 ];
+    
+    idx += dev_decode_block( &rx_buf[ idx ], 7, 56, present, ctx->snap_ch_mask, 
+                             ctx->acc_bipolar, ctx->acc_scale, snap->acc );
+    idx += dev_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                             ctx->vbus_bipolar, ctx->vbus_scale, snap->vbus );
+    idx += dev_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                             ctx->vsense_bipolar, ctx->isense_scale, snap->isense );
+    idx += dev_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                             ctx->vbus_bipolar, ctx->vbus_scale, snap->vbus_avg );
+    idx += dev_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                             ctx->vsense_bipolar, ctx->isense_scale, snap->isense_avg );
+    dev_decode_block( &rx_buf[ idx ], 4, 30, present, ctx->snap_ch_mask, 
+                      ctx->power_bipolar, ctx->power_scale, snap->power );
+    
+    return error_flag;
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
+static uint8_t dev_decode_block ( uint8_t *data_in, uint8_t n_bytes, uint8_t n_bits, 
+                                  uint8_t present, uint8_t active, uint8_t bipolar, 
+                                  float *scale, float *data_out ) {
+    uint8_t *p_data = data_in;
+    int64_t raw;
+    uint8_t ch;
+    uint8_t cnt;
+    
+    for ( ch = 0; ch < PAC1944_NUM_CH; ch++ )
+    {
+        data_out[ ch ] = DUMMY;
+        
+        if ( ( present & ( 1 << ch ) ) == 0 )
+        {
+            continue;
+        }
+        
+        raw = DUMMY;
+        for ( cnt = 0; cnt < n_bytes; cnt++ )
+        {
+            raw <<= 8;
+            raw |= *p_data++;
+        }
+        raw >>= ( n_bytes * 8 - n_bits );
+        
+        if ( ( bipolar & ( 1 << ch ) ) && ( raw & ( ( int64_t ) 1 << ( n_bits - 1 ) ) ) )
+        {
+            raw -= ( int64_t ) 1 << n_bits;
+        }
+        
+        if ( active & ( 1 << ch ) )
+        {
+            data_out[ ch ] = raw * scale[ ch ];
+        }
+    }
+    
+    return ( uint8_t ) ( p_data - data_in );
+}
+
 // ------------------------------------------------------------------------- END
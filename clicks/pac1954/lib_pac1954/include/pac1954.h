@@ -212,6 +212,14 @@ extern "C"{
 #define PAC1954_SMBUS_AUTO_INC_SKIP_OFF       0x02
 #define PAC1954_SMBUS_I2C_HIGH_SPEED          0x01
 
+/**
+ * @brief PAC1954 Accumulator Settings.
+ * @details Specified setting for ACC_CFG register of PAC1954 Click driver.
+ */
+#define PAC1954_ACC_CFG_VPOWER                0
+#define PAC1954_ACC_CFG_VSENSE                1
+#define PAC1954_ACC_CFG_VBUS                  2
+
 /**
  * @brief PAC1954 Measurement Data Selector.
  * @details Measurement data selection of PAC1954 Click driver.
@@ -229,6 +237,14 @@ extern "C"{
 #define PAC1954_CH_SEL_CH_3                   3
 #define PAC1954_CH_SEL_CH_4                   4
 
+/**
+ * @brief PAC1954 Snapshot Settings.
+ * @details Number of channels and the maximal size of the data block
+ * (ACC_COUNT to VPOWER4) read by the snapshot function of PAC1954 Click driver.
+ */
+#define PAC1954_NUM_CH                        4
+#define PAC1954_SNAPSHOT_BLOCK_SIZE           80
+
 /**
  * @brief PAC1954 Average Selector.
  * @details Selection for averaged or single data used in calculations of PAC1954 Click driver.
@@ -318,6 +334,18 @@ typedef struct
     // I2C slave address
     uint8_t slave_address;   /**< Device slave address (used for I2C driver). */
 
+    // Snapshot settings
+    uint8_t snap_ch_mask;    /**< Enabled channels (bit 0 - CH1). */
+    uint8_t snap_no_skip;    /**< Disabled channels are not skipped in block reads. */
+    uint8_t vbus_bipolar;    /**< Channels with bipolar VBUS data. */
+    uint8_t vsense_bipolar;  /**< Channels with bipolar VSENSE data. */
+    uint8_t power_bipolar;   /**< Channels with bipolar power data. */
+    uint8_t acc_bipolar;     /**< Channels with bipolar accumulator data. */
+    float vbus_scale[ PAC1954_NUM_CH ];    /**< VBUS LSB weight [V]. */
+    float isense_scale[ PAC1954_NUM_CH ];  /**< VSENSE LSB weight [A]. */
+    float power_scale[ PAC1954_NUM_CH ];   /**< Power LSB weight [W]. */
+    float acc_scale[ PAC1954_NUM_CH ];     /**< Accumulator LSB weight. */
+
 } pac1954_t;
 
 /**
@@ -349,6 +377,25 @@ typedef enum
 
 } pac1954_return_value_t;
 
+/**
+ * @brief PAC1954 Click snapshot object.
+ * @details All channel measurements taken from a single refresh of PAC1954 Click driver.
+ * Disabled channels are reported as zero.
+ */
+typedef struct
+{
+    uint8_t  ch_mask;                           /**< Enabled channels (bit 0 - CH1). */
+    uint32_t acc_count;                         /**< Accumulator count. */
+    float    vbus[ PAC1954_NUM_CH ];            /**< Bus voltage [V]. */
+    float    isense[ PAC1954_NUM_CH ];          /**< Sense current [A]. */
+    float    vbus_avg[ PAC1954_NUM_CH ];        /**< Averaged bus voltage [V]. */
+    float    isense_avg[ PAC1954_NUM_CH ];      /**< Averaged sense current [A]. */
+    float    power[ PAC1954_NUM_CH ];           /**< Power [W]. */
+    float    acc[ PAC1954_NUM_CH ];             /**< Accumulator output, sum of acc_count samples 
+                                                     of the accumulated quantity [W], [A] or [V]. */
+
+} pac1954_snapshot_t;
+
 /*!
  * @addtogroup pac1954 PAC1954 Click Driver
  * @brief API for configuring and manipulating PAC1954 Click driver.
@@ -596,6 +643,40 @@ err_t pac1954_get_acc_output ( pac1954_t *ctx, uint8_t ch_sel, uint8_t *data_out
 err_t pac1954_get_calc_measurement ( pac1954_t *ctx, uint8_t meas_sel, uint8_t ch_sel, 
                                      uint8_t avg_sel, uint8_t meas_mode, float *data_out );
 
+/**
+ * @brief PAC1954 Snapshot Setup Function.
+ * @details This function issues the REFRESH command to apply the pending configuration, 
+ * then reads the active channel, measurement mode and accumulator settings and 
+ * precomputes the per-channel scale factors used by #pac1954_get_snapshot.
+ * @param[in] ctx : Click context object.
+ * See #pac1954_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note This function resets the accumulators. It should be called again after 
+ * every change of the CTRL, NEG_PWR_FSR, ACC_CFG or SMBUS_CFG registers.
+ */
+err_t pac1954_snapshot_setup ( pac1954_t *ctx );
+
+/**
+ * @brief PAC1954 Get Snapshot Function.
+ * @details This function issues the REFRESH_V command and reads the accumulator count, 
+ * accumulator outputs, VBUS, VSENSE, their averages and power of all enabled channels 
+ * in a single I2C transaction, then converts them using the precomputed scale factors.
+ * @param[in] ctx : Click context object.
+ * See #pac1954_t object definition for detailed explanation.
+ * @param[out] snap : Snapshot of all channel measurements.
+ * See #pac1954_snapshot_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note #pac1954_snapshot_setup must be called before this function.
+ * The accumulators are not reset by this function.
+ */
+err_t pac1954_get_snapshot ( pac1954_t *ctx, pac1954_snapshot_t *snap );
+
 /**
  * @brief PAC1954 Slow Down Sampling Freq Of All Channels Function.
  * @details This function sets sampling frequency at 8 SPS for all channels 
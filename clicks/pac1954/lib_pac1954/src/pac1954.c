@@ -35,6 +35,24 @@
 #define PAC1954_FSR_ISENSE_A   25
 #define PAC1954_FSR_PSENSE_W   800
 
+/**
+ * @brief PAC1954 decode block function.
+ * @details This function decodes one register group (e.g. VBUS1-VBUS4) of the
+ * snapshot data block and converts it using the per-channel scale factors.
+ * @param[in] data_in : Register group data.
+ * @param[in] n_bytes : Register size in bytes.
+ * @param[in] n_bits : Number of valid, MSB aligned, data bits.
+ * @param[in] present : Channels present in the data block.
+ * @param[in] active : Enabled channels, the others are reported as zero.
+ * @param[in] bipolar : Channels with two's complement data.
+ * @param[in] scale : Per-channel LSB weights.
+ * @param[out] data_out : Converted data for all channels.
+ * @return Number of bytes consumed from the data block.
+ */
+static uint8_t pac1954_decode_block ( uint8_t *data_in, uint8_t n_bytes, uint8_t n_bits, 
+                                      uint8_t present, uint8_t active, uint8_t bipolar, 
+                                      float *scale, float *data_out );
+
 void pac1954_cfg_setup ( pac1954_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -364,6 +382,139 @@ err_t pac1954_get_calc_measurement ( pac1954_t *ctx, uint8_t meas_sel, uint8_t c
     return error_flag;
 }
 
+err_t pac1954_snapshot_setup ( pac1954_t *ctx )
+{
+    uint8_t ctrl_act[ 2 ] = { 0 };
+    uint8_t neg_pwr_act[ 2 ] = { 0 };
+    uint8_t smbus_cfg = 0;
+    uint8_t acc_cfg = 0;
+    
+    err_t error_flag = pac1954_refresh_cmd( ctx );
+    error_flag |= pac1954_generic_read( ctx, PAC1954_REG_CTRL_ACT, ctrl_act, 2 );
+    error_flag |= pac1954_generic_read( ctx, PAC1954_REG_NEG_PWR_FSR_ACT, neg_pwr_act, 2 );
+    error_flag |= pac1954_single_read( ctx, PAC1954_REG_SMBUS_CFG, &smbus_cfg );
+    error_flag |= pac1954_single_read( ctx, PAC1954_REG_ACC_CFG_ACT, &acc_cfg );
+    
+    ctx->snap_ch_mask = 0;
+    ctx->snap_no_skip = ( smbus_cfg & PAC1954_SMBUS_AUTO_INC_SKIP_OFF ) ? 1 : 0;
+    ctx->vbus_bipolar = 0;
+    ctx->vsense_bipolar = 0;
+    ctx->power_bipolar = 0;
+    ctx->acc_bipolar = 0;
+    
+    for ( uint8_t ch = 0; ch < PAC1954_NUM_CH; ch++ )
+    {
+        // Channel 1 settings are in the most significant bits of each register
+        uint8_t offset = PAC1954_NEG_PWR_FSR_CH1_OFFSET - ( ch * 2 );
+        uint8_t vs_mode = ( neg_pwr_act[ 0 ] >> offset ) & 0x03;
+        uint8_t vb_mode = ( neg_pwr_act[ 1 ] >> offset ) & 0x03;
+        uint8_t acc_mode = ( acc_cfg >> offset ) & 0x03;
+        uint8_t ch_bit = 1 << ch;
+        
+        if ( 0 == ( ctrl_act[ 1 ] & ( PAC1954_CTRLL_CH1_OFF >> ch ) ) )
+        {
+            ctx->snap_ch_mask |= ch_bit;
+        }
+        
+        ctx->vbus_scale[ ch ] = ( float ) PAC1954_FSR_VSOURCE_V / 0x10000;
+        ctx->isense_scale[ ch ] = ( float ) PAC1954_FSR_ISENSE_A / 0x10000;
+        ctx->power_scale[ ch ] = ( float ) PAC1954_FSR_PSENSE_W / 0x40000000;
+        
+        if ( PAC1954_MEAS_MODE_UNIPOLAR_FSR != vb_mode )
+        {
+            ctx->vbus_bipolar |= ch_bit;
+            ctx->vbus_scale[ ch ] = ( float ) PAC1954_FSR_VSOURCE_V / 0x8000;
+            
+            if ( PAC1954_MEAS_MODE_BIPOLAR_FSR != vb_mode )
+            {
+                ctx->vbus_scale[ ch ] /= 2;
+            }
+        }
+        
+        if ( PAC1954_MEAS_MODE_UNIPOLAR_FSR != vs_mode )
+        {
+            ctx->vsense_bipolar |= ch_bit;
+            ctx->isense_scale[ ch ] = ( float ) PAC1954_FSR_ISENSE_A / 0x8000;
+            
+            if ( PAC1954_MEAS_MODE_BIPOLAR_FSR != vs_mode )
+            {
+                ctx->isense_scale[ ch ] /= 2;
+            }
+        }
+        
+        if ( ( ctx->vbus_bipolar | ctx->vsense_bipolar ) & ch_bit )
+        {
+            ctx->power_bipolar |= ch_bit;
+            ctx->power_scale[ ch ] = ( float ) PAC1954_FSR_PSENSE_W / 0x20000000;
+            
+            if ( ( vb_mode > PAC1954_MEAS_MODE_BIPOLAR_FSR ) || ( vs_mode > PAC1954_MEAS_MODE_BIPOLAR_FSR ) )
+            {
+                ctx->power_scale[ ch ] /= 2;
+            }
+        }
+        
+        if ( PAC1954_ACC_CFG_VSENSE == acc_mode )
+        {
+            ctx->acc_scale[ ch ] = ctx->isense_scale[ ch ];
+            ctx->acc_bipolar |= ( ctx->vsense_bipolar & ch_bit );
+        }
+        else if ( PAC1954_ACC_CFG_VBUS == acc_mode )
+        {
+            ctx->acc_scale[ ch ] = ctx->vbus_scale[ ch ];
+            ctx->acc_bipolar |= ( ctx->vbus_bipolar & ch_bit );
+        }
+        else
+        {
+            ctx->acc_scale[ ch ] = ctx->power_scale[ ch ];
+            ctx->acc_bipolar |= ( ctx->power_bipolar & ch_bit );
+        }
+    }
+    
+    return error_flag;
+}
+
+err_t pac1954_get_snapshot ( pac1954_t *ctx, pac1954_snapshot_t *snap )
+{
+    uint8_t rx_buf[ PAC1954_SNAPSHOT_BLOCK_SIZE ] = { 0 };
+    uint8_t present = ctx->snap_ch_mask;
+    uint8_t n_ch = 0;
+    uint8_t idx = 4;
+    
+    if ( ctx->snap_no_skip )
+    {
+        present = ( 1 << PAC1954_NUM_CH ) - 1;
+    }
+    
+    for ( uint8_t ch = 0; ch < PAC1954_NUM_CH; ch++ )
+    {
+        n_ch += ( present >> ch ) & 0x01;
+    }
+    
+    err_t error_flag = pac1954_vol_refresh_cmd( ctx );
+    
+    // ACC_COUNT [4], VACC [7], VBUS [2], VSENSE [2], VBUS_AVG [2], VSENSE_AVG [2], VPOWER [4]
+    error_flag |= pac1954_generic_read( ctx, PAC1954_REG_ACC_COUNT, rx_buf, 4 + n_ch * 19 );
+    
+    snap->ch_mask = ctx->snap_ch_mask;
+    snap->acc_count = ( ( uint32_t ) rx_buf[ 0 ] << 24 ) | ( ( uint32_t ) rx_buf[ 1 ] << 16 ) | 
+                      ( ( uint16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 3 ];
+    
+    idx += pac1954_decode_block( &rx_buf[ idx ], 7, 56, present, ctx->snap_ch_mask, 
+                                 ctx->acc_bipolar, ctx->acc_scale, snap->acc );
+    idx += pac1954_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                                 ctx->vbus_bipolar, ctx->vbus_scale, snap->vbus );
+    idx += pac1954_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                                 ctx->vsense_bipolar, ctx->isense_scale, snap->isense );
+    idx += pac1954_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                                 ctx->vbus_bipolar, ctx->vbus_scale, snap->vbus_avg );
+    idx += pac1954_decode_block( &rx_buf[ idx ], 2, 16, present, ctx->snap_ch_mask, 
+                                 ctx->vsense_bipolar, ctx->isense_scale, snap->isense_avg );
+    pac1954_decode_block( &rx_buf[ idx ], 4, 30, present, ctx->snap_ch_mask, 
+                          ctx->power_bipolar, ctx->power_scale, snap->power );
+    
+    return error_flag;
+}
+
 void pac1954_set_ch_8_sps ( pac1954_t *ctx, uint8_t state )
 {
     digital_out_write ( &ctx->slw, state );
@@ -379,4 +530,42 @@ uint8_t pac1954_get_alert2_status ( pac1954_t *ctx )
     return digital_in_read ( &ctx->int_pin );
 }
 
+static uint8_t pac1954_decode_block ( uint8_t *data_in, uint8_t n_bytes, uint8_t n_bits, 
+                                      uint8_t present, uint8_t active, uint8_t bipolar, 
+                                      float *scale, float *data_out )
+{
+    uint8_t *p_data = data_in;
+    
+    for ( uint8_t ch = 0; ch < PAC1954_NUM_CH; ch++ )
+    {
+        int64_t raw = 0;
+        
+        data_out[ ch ] = 0;
+        
+        if ( 0 == ( present & ( 1 << ch ) ) )
+        {
+            continue;
+        }
+        
+        for ( uint8_t cnt = 0; cnt < n_bytes; cnt++ )
+        {
+            raw <<= 8;
+            raw |= *p_data++;
+        }
+        raw >>= ( n_bytes * 8 - n_bits );
+        
+        if ( ( bipolar & ( 1 << ch ) ) && ( raw & ( ( int64_t ) 1 << ( n_bits - 1 ) ) ) )
+        {
+            raw -= ( int64_t ) 1 << n_bits;
+        }
+        
+        if ( active & ( 1 << ch ) )
+        {
+            data_out[ ch ] = raw * scale[ ch ];
+        }
+    }
+    
+    return ( uint8_t ) ( p_data - data_in );
+}
+
 // ------------------------------------------------------------------------- END
@@ -871,8 +871,13 @@ err_t plugntrust_get_applet_info ( plugntrust_t *ctx, plugntrust_version_info_t
 
 static uint16_t plugntrust_create_crc ( uint8_t *crc_buff, uint16_t length )
 {
+    // CRC of each nibble value for reflected polynomial 0x8408, processed 4 bits at a time
+    static const uint16_t crc16_table[ 16 ] = 
+    {
+        0x0000, 0x1081, 0x2102, 0x3183, 0x4204, 0x5285, 0x6306, 0x7387,
+        0x8408, 0x9489, 0xA50A, 0xB58B, 0xC60C, 0xD68D, 0xE70E, 0xF78F
+    };
     uint16_t crc16 = 0xFFFF;
-    int8_t bit_idx;
     uint8_t new_byte[ 2 ] = { 0 };
     if ( NULL == crc_buff )
     {
@@ -880,18 +885,8 @@ static uint16_t plugntrust_create_crc ( uint8_t *crc_buff, uint16_t length )
     }
     for ( uint16_t i = 0; i < length; i++ )
     {
-        crc16 ^= crc_buff[ i ];
-        for ( bit_idx = 8; bit_idx > 0; --bit_idx )
-        {
-            if ( 0x0001 == ( crc16 & 0x0001 ) )
-            {
-                crc16 = ( crc16 >> 1 ) ^ 0x8408;
-            }
-            else
-            {
-                crc16 >>= 1;
-            }
-        }
+        crc16 = ( crc16 >> 4 ) ^ crc16_table[ ( crc16 ^ crc_buff[ i ] ) & 0x0F ];
+        crc16 = ( crc16 >> 4 ) ^ crc16_table[ ( crc16 ^ ( crc_buff[ i ] >> 4 ) ) & 0x0F ];
     }
     crc16 ^= 0xFFFF;
     new_byte[ 0 ] = crc16 & 0xFF;
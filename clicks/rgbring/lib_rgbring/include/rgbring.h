@@ -109,6 +109,13 @@ extern "C"{
 #define RGBRING_BUTTON_PRESSED              0
 #define RGBRING_BUTTON_RELESED              1
 
+/**
+ * @brief RGB Ring bitstream setting.
+ * @details Specified setting for bitstream buffer size of RGB Ring Click driver.
+ */
+#define RGBRING_BITSTREAM_BYTES_PER_LED     9
+#define RGBRING_BITSTREAM_SIZE              ( RGBRING_NUM_LEDS * RGBRING_BITSTREAM_BYTES_PER_LED )
+
 /*! @} */ // rgbring_set
 
 /**
@@ -138,6 +145,13 @@ extern "C"{
  */
 typedef void ( *rgbring_logic_t ) ( void );
 
+/**
+ * @brief Function pointer for bitstream transmission.
+ * @details Function pointer definition of RGB Ring Click driver which starts the
+ * transfer of the encoded bitstream, e.g. by SPI or DMA at 2.4 MHz, MSB first.
+ */
+typedef void ( *rgbring_burst_t ) ( uint8_t *bitstream, uint16_t len );
+
 /**
  * @brief RGB Ring Click RGB color object.
  * @details RGB color object definition of RGB Ring Click driver.
@@ -173,9 +187,13 @@ typedef struct
 
     rgbring_logic_t logic_zero; /**< Function pointer for logic zero. */
     rgbring_logic_t logic_one;  /**< Function pointer for logic one. */
+    rgbring_burst_t burst;      /**< Function pointer for bitstream transmission. */
     
     rgbring_led_t led_matrix[ RGBRING_NUM_LEDS ];   /**< 8 LEDs ring matrix. */
 
+    uint8_t *bitstream[ 2 ];    /**< Bitstream frame buffers. */
+    uint8_t bitstream_idx;      /**< Index of the buffer for the next frame. */
+
 } rgbring_t;
 
 /**
@@ -275,6 +293,36 @@ err_t rgbring_write_leds ( rgbring_t *ctx, rgbring_led_t *leds, uint8_t num_leds
  */
 err_t rgbring_write_led_matrix ( rgbring_t *ctx );
 
+/**
+ * @brief RGB Ring set bitstream function.
+ * @details This function makes the LED write functions encode the whole frame into
+ * a bitstream buffer, 3 bits per WS2812 bit, and hand it over to the @b burst function
+ * in one transfer. With two buffers the next frame is encoded into one buffer while
+ * the other one is still being transmitted.
+ * @param[in] ctx : Click context object.
+ * See #rgbring_t object definition for detailed explanation.
+ * @param[in] burst : Function pointer for bitstream transmission, NULL to go back
+ * to the logic one and zero functions.
+ * @param[in] frame_a : Bitstream buffer of RGBRING_BITSTREAM_SIZE bytes.
+ * @param[in] frame_b : Second bitstream buffer of RGBRING_BITSTREAM_SIZE bytes or NULL.
+ * @return Nothing.
+ * @note The @b burst function has to keep the DIN pin low for the reset time after
+ * the transfer.
+ */
+void rgbring_set_bitstream ( rgbring_t *ctx, rgbring_burst_t burst, uint8_t *frame_a, uint8_t *frame_b );
+
+/**
+ * @brief RGB Ring encode bitstream function.
+ * @details This function encodes the LED data bytes into a bitstream where each
+ * WS2812 bit is sent as 3 bits: 110 for logic one and 100 for logic zero.
+ * @param[out] bitstream : Output buffer of 3 bytes per data byte.
+ * @param[in] data_in : LED data bytes in GRB order.
+ * @param[in] len : Number of data bytes.
+ * @return Nothing.
+ * @note None.
+ */
+void rgbring_encode_bitstream ( uint8_t *bitstream, const uint8_t *data_in, uint16_t len );
+
 /**
  * @brief RGB Ring set LED color function.
  * @details This function sets the color of the selected LED in the LED matrix.
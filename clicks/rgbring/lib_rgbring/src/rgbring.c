@@ -27,6 +27,16 @@
 
 #include "rgbring.h"
 
+/**
+ * @brief 3-bit codes of the four WS2812 bits in a nibble.
+ * @details Logic one is sent as 110 and logic zero as 100.
+ */
+static const uint16_t bitstream_nibble[ 16 ] =
+{
+    0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+    0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6
+};
+
 void rgbring_cfg_setup ( rgbring_cfg_t *cfg ) 
 {
     cfg->din = HAL_PIN_NC;
@@ -43,6 +53,7 @@ err_t rgbring_init ( rgbring_t *ctx, rgbring_logic_t logic_zero, rgbring_logic_t
     
     ctx->logic_zero = logic_zero;
     ctx->logic_one = logic_one;
+    ctx->burst = NULL;
 
     return error_flag;
 }
@@ -72,6 +83,17 @@ err_t rgbring_write_leds ( rgbring_t *ctx, rgbring_led_t *leds, uint8_t num_leds
         data_buf[ 1 + led_cnt * 3 ] = leds[ led_cnt ].red;
         data_buf[ 2 + led_cnt * 3 ] = leds[ led_cnt ].blue;
     }
+    if ( NULL != ctx->burst )
+    {
+        rgbring_encode_bitstream( ctx->bitstream[ ctx->bitstream_idx ], data_buf, sizeof ( data_buf ) );
+        ctx->burst( ctx->bitstream[ ctx->bitstream_idx ], RGBRING_BITSTREAM_SIZE );
+        // Encode the next frame into the other buffer while this one is on the wire
+        if ( NULL != ctx->bitstream[ 1 ] )
+        {
+            ctx->bitstream_idx ^= 1;
+        }
+        return RGBRING_OK;
+    }
     for ( byte_cnt = 0; byte_cnt < ( RGBRING_NUM_LEDS * 3 ); byte_cnt++ )
     {
         for ( bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
@@ -97,6 +119,27 @@ err_t rgbring_write_led_matrix ( rgbring_t *ctx )
     return rgbring_write_leds ( ctx, ctx->led_matrix, RGBRING_NUM_LEDS );
 }
 
+void rgbring_set_bitstream ( rgbring_t *ctx, rgbring_burst_t burst, uint8_t *frame_a, uint8_t *frame_b )
+{
+    ctx->burst = burst;
+    ctx->bitstream[ 0 ] = frame_a;
+    ctx->bitstream[ 1 ] = frame_b;
+    ctx->bitstream_idx = 0;
+}
+
+void rgbring_encode_bitstream ( uint8_t *bitstream, const uint8_t *data_in, uint16_t len )
+{
+    uint32_t bits = 0;
+    for ( uint16_t byte_cnt = 0; byte_cnt < len; byte_cnt++ )
+    {
+        bits = ( ( uint32_t ) bitstream_nibble[ data_in[ byte_cnt ] >> 4 ] << 12 ) | 
+               bitstream_nibble[ data_in[ byte_cnt ] & 0x0F ];
+        *bitstream++ = ( uint8_t ) ( bits >> 16 );
+        *bitstream++ = ( uint8_t ) ( bits >> 8 );
+        *bitstream++ = ( uint8_t ) bits;
+    }
+}
+
 void rgbring_set_led_color ( rgbring_t *ctx, uint8_t led_num, uint32_t rgb )
 {
     ctx->led_matrix[ led_num % RGBRING_NUM_LEDS ].red = ( uint8_t ) ( ( rgb >> 16 ) & 0xFF );
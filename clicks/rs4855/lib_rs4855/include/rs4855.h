@@ -52,6 +52,7 @@
 #include "drv_digital_out.h"
 #include "drv_digital_in.h"
 #include "drv_uart.h"
+#include "rs4855_modbus.h"
 
 
 // -------------------------------------------------------------- PUBLIC MACROS 
@@ -78,6 +79,7 @@
 #define RS4855_RETVAL  uint8_t
 
 #define RS4855_OK           0x00
+#define RS4855_ERROR        0xFE
 #define RS4855_INIT_ERROR   0xFF
 /** \} */
 
@@ -114,6 +116,9 @@ typedef struct
     char uart_rx_buffer[ DRV_RX_BUFFER_SIZE ];
     char uart_tx_buffer[ DRV_RX_BUFFER_SIZE ];
 
+    // Modbus RTU
+    rs4855_modbus_t modbus;
+
 } rs4855_t;
 
 /**
@@ -208,6 +213,22 @@ void rs4855_set_de_state( rs4855_t *ctx, uint8_t state );
  */
 void rs4855_set_re_state( rs4855_t *ctx, uint8_t state );
 
+/**
+ * @brief Modbus RTU initialization function.
+ * @param ctx Click object.
+ * @param baud_rate UART baud rate.
+ * @param tick_us Period of the timer calling #rs4855_modbus_tick in microseconds.
+ * @param slave_addr Own slave address (1-247), 0 for master mode.
+ * @param map Slave data map, NULL in master mode.
+ * @return RS4855_OK on success, RS4855_ERROR on error.
+ *
+ * @description This function connects the Modbus RTU engine in @c ctx->modbus to the
+ * click UART and DE/RE pins and initializes it in master or slave mode.
+ * @note Drive the engine with #rs4855_modbus_tick from a timer interrupt, #rs4855_modbus_process
+ * from the main loop and queue master requests with #rs4855_modbus_submit.
+ */
+RS4855_RETVAL rs4855_modbus_init ( rs4855_t *ctx, uint32_t baud_rate, uint16_t tick_us, uint8_t slave_addr, rs4855_modbus_map_t *map );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,245 @@
+/*
+ * MikroSDK - MikroE Software Development Kit
+ * Copyright© 2020 MikroElektronika d.o.o.
+ * 
+ * Permission is hereby granted, free of charge, to any person 
+ * obtaining a copy of this software and associated documentation 
+ * files (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE 
+ * OR OTHER DEALINGS IN THE SOFTWARE. 
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the Modbus RTU engine of RS485 5 Click driver.
+ *
+ * \addtogroup rs4855_modbus Modbus RTU
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef RS4855_MODBUS_H
+#define RS4855_MODBUS_H
+
+#include "drv_uart.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS 
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+/**
+ * \defgroup modbus_error_code Error Code
+ * \{
+ */
+#define RS4855_MODBUS_OK                            0
+#define RS4855_MODBUS_ERROR                        -1
+/** \} */
+
+/**
+ * \defgroup modbus_settings Modbus RTU Settings
+ * \{
+ */
+#define RS4855_MODBUS_FRAME_SIZE                    256
+#define RS4855_MODBUS_QUEUE_SIZE                    4
+#define RS4855_MODBUS_RESPONSE_TIMEOUT_MS           100
+#define RS4855_MODBUS_TURNAROUND_MS                 100
+#define RS4855_MODBUS_FC_READ_COILS                 0x01
+#define RS4855_MODBUS_FC_READ_DISCRETE_INPUTS       0x02
+#define RS4855_MODBUS_FC_READ_HOLDING_REGISTERS     0x03
+#define RS4855_MODBUS_FC_READ_INPUT_REGISTERS       0x04
+#define RS4855_MODBUS_FC_WRITE_SINGLE_COIL          0x05
+#define RS4855_MODBUS_FC_WRITE_SINGLE_REGISTER      0x06
+#define RS4855_MODBUS_FC_WRITE_MULTIPLE_COILS       0x0F
+#define RS4855_MODBUS_FC_WRITE_MULTIPLE_REGS        0x10
+#define RS4855_MODBUS_FC_READ_WRITE_REGS            0x17
+/** \} */
+
+/**
+ * \defgroup modbus_status Modbus RTU Request Status
+ * \{
+ */
+#define RS4855_MODBUS_STATUS_OK                     0x00
+#define RS4855_MODBUS_STATUS_ILLEGAL_FUNCTION       0x01
+#define RS4855_MODBUS_STATUS_ILLEGAL_ADDRESS        0x02
+#define RS4855_MODBUS_STATUS_ILLEGAL_VALUE          0x03
+#define RS4855_MODBUS_STATUS_DEVICE_FAILURE         0x04
+#define RS4855_MODBUS_STATUS_PENDING                0xFD
+#define RS4855_MODBUS_STATUS_BAD_FRAME              0xFE
+#define RS4855_MODBUS_STATUS_TIMEOUT                0xFF
+/** \} */
+
+/** \} */ // End group macro 
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+/**
+ * @brief Modbus RTU transport object.
+ * @details The engine reaches the bus only through these callbacks, so any RS485
+ * driver can run it by mapping them to its UART and direction pins.
+ */
+typedef struct
+{
+    void  *handle;                                                      /**< Driver object passed to the callbacks. */
+    err_t ( *write )( void *handle, uint8_t *data_buf, uint16_t len );  /**< Non-blocking write, returns number of bytes accepted. */
+    err_t ( *read )( void *handle, uint8_t *data_buf, uint16_t len );   /**< Non-blocking read, returns number of bytes read. */
+    int32_t ( *rx_level )( void *handle );                              /**< Number of received bytes waiting to be read. */
+    void  ( *set_dir )( void *handle, uint8_t tx );                     /**< Transceiver direction, NULL for auto-direction boards. */
+
+} rs4855_modbus_port_t;
+
+/**
+ * @brief Modbus RTU request object.
+ */
+typedef struct rs4855_modbus_req
+{
+    uint8_t  slave;                 /**< Slave address, 0 for broadcast. */
+    uint8_t  function;              /**< Function code. */
+    uint16_t address;               /**< Start address (read address for function 23). */
+    uint16_t quantity;              /**< Number of coils or registers (read quantity for function 23). */
+    uint16_t wr_address;            /**< Write start address for function 23. */
+    uint16_t wr_quantity;           /**< Write quantity for function 23. */
+    uint16_t *regs;                 /**< Register data read or to be written. */
+    uint16_t *wr_regs;              /**< Registers to be written by function 23. */
+    uint8_t  *bits;                 /**< Coil or discrete input data. */
+    volatile uint8_t status;        /**< Request status. */
+    void ( *done )( struct rs4855_modbus_req *req ); /**< Completion callback, can be NULL. */
+
+} rs4855_modbus_req_t;
+
+/**
+ * @brief Modbus RTU slave data map.
+ */
+typedef struct
+{
+    uint8_t  *coils;                /**< Coils, packed LSB first. */
+    uint16_t n_coils;               /**< Number of coils. */
+    uint8_t  *discrete;             /**< Discrete inputs, packed LSB first. */
+    uint16_t n_discrete;            /**< Number of discrete inputs. */
+    uint16_t *holding;              /**< Holding registers. */
+    uint16_t n_holding;             /**< Number of holding registers. */
+    uint16_t *input;                /**< Input registers. */
+    uint16_t n_input;               /**< Number of input registers. */
+
+} rs4855_modbus_map_t;
+
+/**
+ * @brief Modbus RTU engine object.
+ */
+typedef struct
+{
+    rs4855_modbus_port_t port;      /**< Transport callbacks. */
+    uint8_t  frame[ RS4855_MODBUS_FRAME_SIZE ];        /**< Received frame. */
+    uint8_t  tx_frame[ RS4855_MODBUS_FRAME_SIZE ];     /**< Frame to be sent. */
+    uint16_t rx_len;                /**< Received frame length. */
+    uint16_t tx_len;                /**< Frame to be sent length. */
+    uint16_t tx_pos;                /**< Number of bytes passed to the UART. */
+    volatile uint16_t rx_avail;     /**< UART receive buffer level at the last tick. */
+    volatile uint16_t silence;      /**< Bus silence in ticks. */
+    volatile uint32_t tx_ticks;     /**< Remaining transmission time in ticks. */
+    volatile uint32_t wait_ticks;   /**< Remaining response or turnaround time in ticks. */
+    volatile uint8_t  rx_broken;    /**< Frame broken by t1.5 gap. */
+    volatile uint8_t  tx_busy;      /**< Transmitter is enabled. */
+    uint16_t t15;                   /**< Inter-character timeout in ticks. */
+    uint16_t t35;                   /**< Inter-frame delay in ticks. */
+    uint16_t char_ticks;            /**< Character time in ticks. */
+    uint32_t timeout_ticks;         /**< Response timeout in ticks. */
+    uint32_t turnaround_ticks;      /**< Broadcast turnaround delay in ticks. */
+    uint8_t  state;                 /**< Engine state. */
+    uint8_t  slave_addr;            /**< Own slave address, 0 in master mode. */
+    uint8_t  tx_ready;              /**< Next request is already encoded. */
+    rs4855_modbus_map_t *map;       /**< Slave data map. */
+    rs4855_modbus_req_t *queue[ RS4855_MODBUS_QUEUE_SIZE ]; /**< Master request queue. */
+    uint8_t  q_head;                /**< Queue head index. */
+    uint8_t  q_cnt;                 /**< Number of queued requests. */
+    uint32_t n_done;                /**< Number of successful transactions. */
+    uint32_t n_error;               /**< Number of failed transactions. */
+
+} rs4855_modbus_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Modbus RTU initialization function.
+ * @param mb Modbus RTU engine object.
+ * @param port Transport callbacks, copied into the engine object.
+ * @param baud_rate UART baud rate.
+ * @param tick_us Period of the timer calling #rs4855_modbus_tick in microseconds.
+ * @param slave_addr Own slave address (1-247), 0 for master mode.
+ * @param map Slave data map, NULL in master mode.
+ * @return RS4855_MODBUS_OK on success, RS4855_MODBUS_ERROR on error.
+ *
+ * @description This function initializes the Modbus RTU engine in master or slave mode
+ * and derives t1.5 and t3.5 silent intervals from the baud rate and timer tick period.
+ * @note Tick period should not exceed half of the character time.
+ */
+err_t rs4855_modbus_engine_init ( rs4855_modbus_t *mb, rs4855_modbus_port_t *port, uint32_t baud_rate, uint16_t tick_us, 
+                                 uint8_t slave_addr, rs4855_modbus_map_t *map );
+
+/**
+ * @brief Modbus RTU request submit function.
+ * @param mb Modbus RTU engine object.
+ * @param req Request object, must stay valid until completion.
+ * @return RS4855_MODBUS_OK on success, RS4855_MODBUS_ERROR on error.
+ *
+ * @description This function queues a master request. Queued requests to different slaves
+ * are sent back to back, the next frame is encoded while the current response is awaited.
+ * @note Request status is #RS4855_MODBUS_STATUS_PENDING until completion.
+ */
+err_t rs4855_modbus_submit ( rs4855_modbus_t *mb, rs4855_modbus_req_t *req );
+
+/**
+ * @brief Modbus RTU timer tick function.
+ * @param mb Modbus RTU engine object.
+ *
+ * @description This function measures bus silence and transmission time
+ * and switches the transceiver back to receive mode after transmission.
+ * @note Call it from a periodic timer interrupt with the period set in #rs4855_modbus_engine_init.
+ */
+void rs4855_modbus_tick ( rs4855_modbus_t *mb );
+
+/**
+ * @brief Modbus RTU process function.
+ * @param mb Modbus RTU engine object.
+ *
+ * @description This function sends queued requests, collects frames delimited by t3.5
+ * silence, completes master requests and answers slave requests.
+ * @note Call it from the main loop, it never blocks.
+ */
+void rs4855_modbus_process ( rs4855_modbus_t *mb );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _MODBUS_RTU_H_
+
+/** \} */ // End public_function group
+/*! @} */
+// ------------------------------------------------------------------------- END
@@ -30,6 +30,15 @@
 #include "rs4855.h"
 #include "string.h"
 
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static err_t dev_modbus_port_write ( void *handle, uint8_t *data_buf, uint16_t len );
+
+static err_t dev_modbus_port_read ( void *handle, uint8_t *data_buf, uint16_t len );
+
+static int32_t dev_modbus_port_rx_level ( void *handle );
+
+static void dev_modbus_port_set_dir ( void *handle, uint8_t tx );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -104,5 +113,56 @@ void rs4855_set_re_state( rs4855_t *ctx, uint8_t state )
     digital_out_write( &ctx->re, state );
 }
 
+RS4855_RETVAL rs4855_modbus_init ( rs4855_t *ctx, uint32_t baud_rate, uint16_t tick_us, uint8_t slave_addr, rs4855_modbus_map_t *map )
+{
+    rs4855_modbus_port_t port;
+
+    port.handle = ctx;
+    port.write = dev_modbus_port_write;
+    port.read = dev_modbus_port_read;
+    port.rx_level = dev_modbus_port_rx_level;
+    port.set_dir = dev_modbus_port_set_dir;
+
+    if ( RS4855_MODBUS_OK != rs4855_modbus_engine_init( &ctx->modbus, &port, baud_rate, tick_us, slave_addr, map ) )
+    {
+        return RS4855_ERROR;
+    }
+
+    return RS4855_OK;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static err_t dev_modbus_port_write ( void *handle, uint8_t *data_buf, uint16_t len )
+{
+    return uart_write( &( ( rs4855_t * ) handle )->uart, ( char * ) data_buf, len );
+}
+
+static err_t dev_modbus_port_read ( void *handle, uint8_t *data_buf, uint16_t len )
+{
+    return uart_read( &( ( rs4855_t * ) handle )->uart, ( char * ) data_buf, len );
+}
+
+static int32_t dev_modbus_port_rx_level ( void *handle )
+{
+    return ( int32_t ) uart_bytes_available( &( ( rs4855_t * ) handle )->uart );
+}
+
+static void dev_modbus_port_set_dir ( void *handle, uint8_t tx )
+{
+    rs4855_t *ctx = ( rs4855_t * ) handle;
+
+    if ( tx )
+    {
+        digital_out_high( &ctx->re );
+        digital_out_high( &ctx->de );
+    }
+    else
+    {
+        digital_out_low( &ctx->de );
+        digital_out_low( &ctx->re );
+    }
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -0,0 +1,762 @@
+/*
+ * MikroSDK - MikroE Software Development Kit
+ * Copyright© 2020 MikroElektronika d.o.o.
+ * 
+ * Permission is hereby granted, free of charge, to any person 
+ * obtaining a copy of this software and associated documentation 
+ * files (the "Software"), to deal in the Software without restriction, 
+ * including without limitation the rights to use, copy, modify, merge, 
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE 
+ * OR OTHER DEALINGS IN THE SOFTWARE. 
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include "rs4855_modbus.h"
+#include "string.h"
+
+
+// ------------------------------------------------------------- PRIVATE MACROS 
+
+#define MODBUS_STATE_IDLE          0
+#define MODBUS_STATE_TX            1
+#define MODBUS_STATE_WAIT          2
+#define MODBUS_STATE_TURNAROUND    3
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static uint16_t dev_modbus_crc ( uint8_t *data_buf, uint16_t len );
+
+static uint32_t dev_modbus_ticks ( uint32_t time_us, uint16_t tick_us );
+
+static void dev_modbus_tx_mode ( rs4855_modbus_t *mb );
+
+static void dev_modbus_rx_mode ( rs4855_modbus_t *mb );
+
+static err_t dev_modbus_check ( rs4855_modbus_req_t *req );
+
+static void dev_modbus_encode ( rs4855_modbus_t *mb, rs4855_modbus_req_t *req );
+
+static void dev_modbus_send ( rs4855_modbus_t *mb );
+
+static void dev_modbus_write ( rs4855_modbus_t *mb );
+
+static uint8_t dev_modbus_receive ( rs4855_modbus_t *mb );
+
+static uint8_t dev_modbus_master_rx ( rs4855_modbus_t *mb );
+
+static uint8_t dev_modbus_slave_rx ( rs4855_modbus_t *mb );
+
+static void dev_modbus_complete ( rs4855_modbus_t *mb, uint8_t status );
+
+static uint8_t dev_modbus_get_bit ( uint8_t *bits, uint16_t index );
+
+static void dev_modbus_set_bit ( uint8_t *bits, uint16_t index, uint8_t state );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+err_t rs4855_modbus_engine_init ( rs4855_modbus_t *mb, rs4855_modbus_port_t *port, uint32_t baud_rate, uint16_t tick_us, 
+                                 uint8_t slave_addr, rs4855_modbus_map_t *map )
+{
+    uint32_t char_us;
+
+    if ( ( NULL == port ) || ( NULL == port->write ) || ( NULL == port->read ) || ( NULL == port->rx_level ) || 
+         ( 0 == baud_rate ) || ( 0 == tick_us ) || ( slave_addr > 247 ) || ( slave_addr && ( NULL == map ) ) )
+    {
+        return RS4855_MODBUS_ERROR;
+    }
+    memset( mb, 0, sizeof( rs4855_modbus_t ) );
+    mb->port = *port;
+
+    // 11 bits per character, t1.5 and t3.5 are fixed above 19200 baud
+    char_us = ( 11000000ul + baud_rate - 1 ) / baud_rate;
+    mb->char_ticks = dev_modbus_ticks( char_us, tick_us );
+    if ( baud_rate > 19200 )
+    {
+        mb->t15 = dev_modbus_ticks( 750, tick_us );
+        mb->t35 = dev_modbus_ticks( 1750, tick_us );
+    }
+    else
+    {
+        mb->t15 = dev_modbus_ticks( ( char_us * 3 ) / 2, tick_us );
+        mb->t35 = dev_modbus_ticks( ( char_us * 7 ) / 2, tick_us );
+    }
+    mb->timeout_ticks = dev_modbus_ticks( RS4855_MODBUS_RESPONSE_TIMEOUT_MS * 1000ul, tick_us );
+    mb->turnaround_ticks = dev_modbus_ticks( RS4855_MODBUS_TURNAROUND_MS * 1000ul, tick_us );
+    mb->slave_addr = slave_addr;
+    mb->map = map;
+    mb->silence = mb->t35;
+    mb->state = MODBUS_STATE_IDLE;
+    dev_modbus_rx_mode( mb );
+
+    return RS4855_MODBUS_OK;
+}
+
+err_t rs4855_modbus_submit ( rs4855_modbus_t *mb, rs4855_modbus_req_t *req )
+{
+    if ( ( NULL == req ) || mb->slave_addr || ( mb->q_cnt >= RS4855_MODBUS_QUEUE_SIZE ) || dev_modbus_check( req ) )
+    {
+        return RS4855_MODBUS_ERROR;
+    }
+    req->status = RS4855_MODBUS_STATUS_PENDING;
+    mb->queue[ ( mb->q_head + mb->q_cnt ) % RS4855_MODBUS_QUEUE_SIZE ] = req;
+    mb->q_cnt++;
+
+    return RS4855_MODBUS_OK;
+}
+
+void rs4855_modbus_tick ( rs4855_modbus_t *mb )
+{
+    uint16_t rx_avail = ( uint16_t ) mb->port.rx_level( mb->port.handle );
+
+    if ( rx_avail != mb->rx_avail )
+    {
+        // Character received after t1.5 but before t3.5 of silence breaks the frame
+        if ( ( rx_avail > mb->rx_avail ) && mb->rx_avail && ( mb->silence >= mb->t15 ) && ( mb->silence < mb->t35 ) )
+        {
+            mb->rx_broken = 1;
+        }
+        mb->rx_avail = rx_avail;
+        mb->silence = 0;
+    }
+    else if ( mb->silence < 0xFFFF )
+    {
+        mb->silence++;
+    }
+
+    if ( mb->tx_busy && mb->tx_ticks && ( 0 == --mb->tx_ticks ) && ( mb->tx_pos >= mb->tx_len ) )
+    {
+        // Last character has left the transmitter
+        dev_modbus_rx_mode( mb );
+        mb->tx_busy = 0;
+        mb->silence = 0;
+    }
+
+    if ( mb->wait_ticks )
+    {
+        mb->wait_ticks--;
+    }
+}
+
+void rs4855_modbus_process ( rs4855_modbus_t *mb )
+{
+    switch ( mb->state )
+    {
+        case MODBUS_STATE_TX:
+        {
+            if ( mb->tx_pos < mb->tx_len )
+            {
+                dev_modbus_write( mb );
+            }
+            else if ( !mb->tx_busy )
+            {
+                if ( mb->slave_addr )
+                {
+                    mb->state = MODBUS_STATE_IDLE;
+                }
+                else if ( 0 == mb->queue[ mb->q_head ]->slave )
+                {
+                    mb->wait_ticks = mb->turnaround_ticks;
+                    mb->state = MODBUS_STATE_TURNAROUND;
+                }
+                else
+                {
+                    mb->wait_ticks = mb->timeout_ticks;
+                    mb->state = MODBUS_STATE_WAIT;
+                }
+            }
+            break;
+        }
+        case MODBUS_STATE_WAIT:
+        {
+            if ( dev_modbus_receive( mb ) )
+            {
+                dev_modbus_complete( mb, dev_modbus_master_rx( mb ) );
+            }
+            else if ( 0 == mb->wait_ticks )
+            {
+                dev_modbus_complete( mb, RS4855_MODBUS_STATUS_TIMEOUT );
+            }
+            break;
+        }
+        case MODBUS_STATE_TURNAROUND:
+        {
+            if ( 0 == mb->wait_ticks )
+            {
+                dev_modbus_complete( mb, RS4855_MODBUS_STATUS_OK );
+            }
+            break;
+        }
+        default:
+        {
+            if ( mb->slave_addr )
+            {
+                if ( dev_modbus_receive( mb ) && dev_modbus_slave_rx( mb ) )
+                {
+                    dev_modbus_send( mb );
+                }
+            }
+            else if ( mb->q_cnt )
+            {
+                if ( !mb->tx_ready )
+                {
+                    dev_modbus_encode( mb, mb->queue[ mb->q_head ] );
+                    mb->tx_ready = 1;
+                }
+                // Late frames are dropped before the bus is taken
+                dev_modbus_receive( mb );
+                if ( mb->silence >= mb->t35 )
+                {
+                    mb->tx_ready = 0;
+                    dev_modbus_send( mb );
+                }
+            }
+            break;
+        }
+    }
+
+    // Next request is encoded while the current one is on the bus
+    if ( ( ( MODBUS_STATE_WAIT == mb->state ) || ( MODBUS_STATE_TURNAROUND == mb->state ) ) && 
+         !mb->tx_ready && ( mb->q_cnt > 1 ) )
+    {
+        dev_modbus_encode( mb, mb->queue[ ( mb->q_head + 1 ) % RS4855_MODBUS_QUEUE_SIZE ] );
+        mb->tx_ready = 1;
+    }
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint16_t dev_modbus_crc ( uint8_t *data_buf, uint16_t len )
+{
+    // CRC of each nibble value for reflected polynomial 0xA001, processed 4 bits at a time
+    static const uint16_t crc16_table[ 16 ] = 
+    {
+        0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
+        0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400
+    };
+    uint16_t crc16 = 0xFFFF;
+
+    for ( uint16_t cnt = 0; cnt < len; cnt++ )
+    {
+        crc16 = ( crc16 >> 4 ) ^ crc16_table[ ( crc16 ^ data_buf[ cnt ] ) & 0x0F ];
+        crc16 = ( crc16 >> 4 ) ^ crc16_table[ ( crc16 ^ ( data_buf[ cnt ] >> 4 ) ) & 0x0F ];
+    }
+
+    return crc16;
+}
+
+static uint32_t dev_modbus_ticks ( uint32_t time_us, uint16_t tick_us )
+{
+    uint32_t ticks = ( time_us + tick_us - 1 ) / tick_us;
+
+    return ticks ? ticks : 1;
+}
+
+static void dev_modbus_tx_mode ( rs4855_modbus_t *mb )
+{
+    if ( NULL != mb->port.set_dir )
+    {
+        mb->port.set_dir( mb->port.handle, 1 );
+    }
+}
+
+static void dev_modbus_rx_mode ( rs4855_modbus_t *mb )
+{
+    if ( NULL != mb->port.set_dir )
+    {
+        mb->port.set_dir( mb->port.handle, 0 );
+    }
+}
+
+static err_t dev_modbus_check ( rs4855_modbus_req_t *req )
+{
+    uint8_t valid = 0;
+
+    switch ( req->function )
+    {
+        case RS4855_MODBUS_FC_READ_COILS:
+        case RS4855_MODBUS_FC_READ_DISCRETE_INPUTS:
+        {
+            valid = req->slave && req->bits && req->quantity && ( req->quantity <= 2000 );
+            break;
+        }
+        case RS4855_MODBUS_FC_READ_HOLDING_REGISTERS:
+        case RS4855_MODBUS_FC_READ_INPUT_REGISTERS:
+        {
+            valid = req->slave && req->regs && req->quantity && ( req->quantity <= 125 );
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_SINGLE_COIL:
+        {
+            valid = ( NULL != req->bits );
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_SINGLE_REGISTER:
+        {
+            valid = ( NULL != req->regs );
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_MULTIPLE_COILS:
+        {
+            valid = req->bits && req->quantity && ( req->quantity <= 1968 );
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_MULTIPLE_REGS:
+        {
+            valid = req->regs && req->quantity && ( req->quantity <= 123 );
+            break;
+        }
+        case RS4855_MODBUS_FC_READ_WRITE_REGS:
+        {
+            valid = req->slave && req->regs && req->wr_regs && req->quantity && ( req->quantity <= 125 ) && 
+                    req->wr_quantity && ( req->wr_quantity <= 121 );
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return ( valid && ( req->slave <= 247 ) ) ? RS4855_MODBUS_OK : RS4855_MODBUS_ERROR;
+}
+
+static void dev_modbus_encode ( rs4855_modbus_t *mb, rs4855_modbus_req_t *req )
+{
+    uint8_t *frame = mb->tx_frame;
+    uint16_t len = 0;
+    uint16_t crc;
+
+    frame[ len++ ] = req->slave;
+    frame[ len++ ] = req->function;
+    frame[ len++ ] = ( uint8_t ) ( req->address >> 8 );
+    frame[ len++ ] = ( uint8_t ) req->address;
+    if ( RS4855_MODBUS_FC_WRITE_SINGLE_COIL == req->function )
+    {
+        frame[ len++ ] = ( req->bits[ 0 ] & 0x01 ) ? 0xFF : 0x00;
+        frame[ len++ ] = 0x00;
+    }
+    else if ( RS4855_MODBUS_FC_WRITE_SINGLE_REGISTER == req->function )
+    {
+        frame[ len++ ] = ( uint8_t ) ( req->regs[ 0 ] >> 8 );
+        frame[ len++ ] = ( uint8_t ) req->regs[ 0 ];
+    }
+    else
+    {
+        frame[ len++ ] = ( uint8_t ) ( req->quantity >> 8 );
+        frame[ len++ ] = ( uint8_t ) req->quantity;
+    }
+
+    if ( RS4855_MODBUS_FC_WRITE_MULTIPLE_COILS == req->function )
+    {
+        uint8_t byte_cnt = ( uint8_t ) ( ( req->quantity + 7 ) / 8 );
+        frame[ len++ ] = byte_cnt;
+        memcpy( &frame[ len ], req->bits, byte_cnt );
+        len += byte_cnt;
+        if ( req->quantity % 8 )
+        {
+            // Unused bits of the last byte are sent as zeros
+            frame[ len - 1 ] &= ( uint8_t ) ( ( 1 << ( req->quantity % 8 ) ) - 1 );
+        }
+    }
+    else if ( ( RS4855_MODBUS_FC_WRITE_MULTIPLE_REGS == req->function ) || 
+              ( RS4855_MODBUS_FC_READ_WRITE_REGS == req->function ) )
+    {
+        uint16_t *regs = req->regs;
+        uint16_t quantity = req->quantity;
+        if ( RS4855_MODBUS_FC_READ_WRITE_REGS == req->function )
+        {
+            regs = req->wr_regs;
+            quantity = req->wr_quantity;
+            frame[ len++ ] = ( uint8_t ) ( req->wr_address >> 8 );
+            frame[ len++ ] = ( uint8_t ) req->wr_address;
+            frame[ len++ ] = ( uint8_t ) ( quantity >> 8 );
+            frame[ len++ ] = ( uint8_t ) quantity;
+        }
+        frame[ len++ ] = ( uint8_t ) ( quantity * 2 );
+        for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+        {
+            frame[ len++ ] = ( uint8_t ) ( regs[ cnt ] >> 8 );
+            frame[ len++ ] = ( uint8_t ) regs[ cnt ];
+        }
+    }
+
+    crc = dev_modbus_crc( frame, len );
+    frame[ len++ ] = ( uint8_t ) crc;
+    frame[ len++ ] = ( uint8_t ) ( crc >> 8 );
+    mb->tx_len = len;
+}
+
+static void dev_modbus_send ( rs4855_modbus_t *mb )
+{
+    dev_modbus_tx_mode( mb );
+    mb->tx_pos = 0;
+    // One character margin for the transmit shift register
+    mb->tx_ticks = mb->char_ticks;
+    mb->tx_busy = 1;
+    mb->state = MODBUS_STATE_TX;
+    dev_modbus_write( mb );
+}
+
+static void dev_modbus_write ( rs4855_modbus_t *mb )
+{
+    err_t len = mb->port.write( mb->port.handle, &mb->tx_frame[ mb->tx_pos ], mb->tx_len - mb->tx_pos );
+
+    if ( len > 0 )
+    {
+        mb->tx_ticks += ( uint32_t ) len * mb->char_ticks;
+        mb->tx_pos += len;
+    }
+}
+
+static uint8_t dev_modbus_receive ( rs4855_modbus_t *mb )
+{
+    err_t len;
+
+    if ( ( 0 == mb->rx_avail ) || ( mb->silence < mb->t35 ) )
+    {
+        return 0;
+    }
+
+    len = mb->port.read( mb->port.handle, mb->frame, RS4855_MODBUS_FRAME_SIZE );
+    if ( mb->port.rx_level( mb->port.handle ) )
+    {
+        // Frame longer than allowed, drop it completely
+        while ( mb->port.read( mb->port.handle, mb->frame, RS4855_MODBUS_FRAME_SIZE ) > 0 );
+        len = 0;
+    }
+    mb->rx_avail = 0;
+
+    if ( mb->rx_broken || ( len < 4 ) || dev_modbus_crc( mb->frame, len ) )
+    {
+        len = 0;
+    }
+    mb->rx_broken = 0;
+    mb->rx_len = len;
+
+    return 1;
+}
+
+static uint8_t dev_modbus_master_rx ( rs4855_modbus_t *mb )
+{
+    rs4855_modbus_req_t *req = mb->queue[ mb->q_head ];
+    uint8_t *frame = mb->frame;
+
+    if ( ( mb->rx_len < 5 ) || ( frame[ 0 ] != req->slave ) || ( ( frame[ 1 ] & 0x7F ) != req->function ) )
+    {
+        return RS4855_MODBUS_STATUS_BAD_FRAME;
+    }
+    if ( frame[ 1 ] & 0x80 )
+    {
+        return frame[ 2 ] ? frame[ 2 ] : RS4855_MODBUS_STATUS_BAD_FRAME;
+    }
+
+    switch ( req->function )
+    {
+        case RS4855_MODBUS_FC_READ_COILS:
+        case RS4855_MODBUS_FC_READ_DISCRETE_INPUTS:
+        {
+            if ( ( frame[ 2 ] != ( req->quantity + 7 ) / 8 ) || ( mb->rx_len != frame[ 2 ] + 5 ) )
+            {
+                return RS4855_MODBUS_STATUS_BAD_FRAME;
+            }
+            memcpy( req->bits, &frame[ 3 ], frame[ 2 ] );
+            break;
+        }
+        case RS4855_MODBUS_FC_READ_HOLDING_REGISTERS:
+        case RS4855_MODBUS_FC_READ_INPUT_REGISTERS:
+        case RS4855_MODBUS_FC_READ_WRITE_REGS:
+        {
+            if ( ( frame[ 2 ] != req->quantity * 2 ) || ( mb->rx_len != frame[ 2 ] + 5 ) )
+            {
+                return RS4855_MODBUS_STATUS_BAD_FRAME;
+            }
+            for ( uint16_t cnt = 0; cnt < req->quantity; cnt++ )
+            {
+                req->regs[ cnt ] = ( ( uint16_t ) frame[ cnt * 2 + 3 ] << 8 ) | frame[ cnt * 2 + 4 ];
+            }
+            break;
+        }
+        default:
+        {
+            // Write responses echo the start address
+            if ( ( mb->rx_len != 8 ) || ( ( ( ( uint16_t ) frame[ 2 ] << 8 ) | frame[ 3 ] ) != req->address ) )
+            {
+                return RS4855_MODBUS_STATUS_BAD_FRAME;
+            }
+            break;
+        }
+    }
+
+    return RS4855_MODBUS_STATUS_OK;
+}
+
+static uint8_t dev_modbus_slave_rx ( rs4855_modbus_t *mb )
+{
+    rs4855_modbus_map_t *map = mb->map;
+    uint8_t *req = mb->frame;
+    uint8_t *rsp = mb->tx_frame;
+    uint8_t exception = RS4855_MODBUS_STATUS_OK;
+    uint16_t address;
+    uint16_t quantity;
+    uint16_t len = 2;
+    uint16_t crc;
+
+    if ( ( mb->rx_len < 8 ) || ( ( req[ 0 ] != mb->slave_addr ) && ( 0 != req[ 0 ] ) ) )
+    {
+        return 0;
+    }
+    address = ( ( uint16_t ) req[ 2 ] << 8 ) | req[ 3 ];
+    quantity = ( ( uint16_t ) req[ 4 ] << 8 ) | req[ 5 ];
+    rsp[ 0 ] = mb->slave_addr;
+    rsp[ 1 ] = req[ 1 ];
+
+    switch ( req[ 1 ] )
+    {
+        case RS4855_MODBUS_FC_READ_COILS:
+        case RS4855_MODBUS_FC_READ_DISCRETE_INPUTS:
+        {
+            uint8_t *bits = map->coils;
+            uint16_t n_bits = map->n_coils;
+            if ( RS4855_MODBUS_FC_READ_DISCRETE_INPUTS == req[ 1 ] )
+            {
+                bits = map->discrete;
+                n_bits = map->n_discrete;
+            }
+            if ( ( 0 == quantity ) || ( quantity > 2000 ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_VALUE;
+            }
+            else if ( ( NULL == bits ) || ( ( ( uint32_t ) address + quantity ) > n_bits ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                rsp[ len++ ] = ( uint8_t ) ( ( quantity + 7 ) / 8 );
+                memset( &rsp[ len ], 0, rsp[ 2 ] );
+                for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+                {
+                    dev_modbus_set_bit( &rsp[ len ], cnt, dev_modbus_get_bit( bits, address + cnt ) );
+                }
+                len += rsp[ 2 ];
+            }
+            break;
+        }
+        case RS4855_MODBUS_FC_READ_HOLDING_REGISTERS:
+        case RS4855_MODBUS_FC_READ_INPUT_REGISTERS:
+        {
+            uint16_t *regs = map->holding;
+            uint16_t n_regs = map->n_holding;
+            if ( RS4855_MODBUS_FC_READ_INPUT_REGISTERS == req[ 1 ] )
+            {
+                regs = map->input;
+                n_regs = map->n_input;
+            }
+            if ( ( 0 == quantity ) || ( quantity > 125 ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_VALUE;
+            }
+            else if ( ( NULL == regs ) || ( ( ( uint32_t ) address + quantity ) > n_regs ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                rsp[ len++ ] = ( uint8_t ) ( quantity * 2 );
+                for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+                {
+                    rsp[ len++ ] = ( uint8_t ) ( regs[ address + cnt ] >> 8 );
+                    rsp[ len++ ] = ( uint8_t ) regs[ address + cnt ];
+                }
+            }
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_SINGLE_COIL:
+        {
+            if ( ( 0xFF00 != quantity ) && ( 0x0000 != quantity ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_VALUE;
+            }
+            else if ( ( NULL == map->coils ) || ( address >= map->n_coils ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                dev_modbus_set_bit( map->coils, address, ( 0xFF00 == quantity ) );
+                memcpy( &rsp[ len ], &req[ len ], 4 );
+                len += 4;
+            }
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_SINGLE_REGISTER:
+        {
+            if ( ( NULL == map->holding ) || ( address >= map->n_holding ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                map->holding[ address ] = quantity;
+                memcpy( &rsp[ len ], &req[ len ], 4 );
+                len += 4;
+            }
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_MULTIPLE_COILS:
+        {
+            if ( ( 0 == quantity ) || ( quantity > 1968 ) || ( req[ 6 ] != ( quantity + 7 ) / 8 ) || 
+                 ( mb->rx_len != req[ 6 ] + 9 ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_VALUE;
+            }
+            else if ( ( NULL == map->coils ) || ( ( ( uint32_t ) address + quantity ) > map->n_coils ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+                {
+                    dev_modbus_set_bit( map->coils, address + cnt, dev_modbus_get_bit( &req[ 7 ], cnt ) );
+                }
+                memcpy( &rsp[ len ], &req[ len ], 4 );
+                len += 4;
+            }
+            break;
+        }
+        case RS4855_MODBUS_FC_WRITE_MULTIPLE_REGS:
+        {
+            if ( ( 0 == quantity ) || ( quantity > 123 ) || ( req[ 6 ] != quantity * 2 ) || 
+                 ( mb->rx_len != req[ 6 ] + 9 ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_VALUE;
+            }
+            else if ( ( NULL == map->holding ) || ( ( ( uint32_t ) address + quantity ) > map->n_holding ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+                {
+                    map->holding[ address + cnt ] = ( ( uint16_t ) req[ cnt * 2 + 7 ] << 8 ) | req[ cnt * 2 + 8 ];
+                }
+                memcpy( &rsp[ len ], &req[ len ], 4 );
+                len += 4;
+            }
+            break;
+        }
+        case RS4855_MODBUS_FC_READ_WRITE_REGS:
+        {
+            uint16_t wr_address = ( ( uint16_t ) req[ 6 ] << 8 ) | req[ 7 ];
+            uint16_t wr_quantity = ( ( uint16_t ) req[ 8 ] << 8 ) | req[ 9 ];
+            if ( ( mb->rx_len < 13 ) || ( 0 == quantity ) || ( quantity > 125 ) || ( 0 == wr_quantity ) || 
+                 ( wr_quantity > 121 ) || ( req[ 10 ] != wr_quantity * 2 ) || ( mb->rx_len != req[ 10 ] + 13 ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_VALUE;
+            }
+            else if ( ( NULL == map->holding ) || ( ( ( uint32_t ) address + quantity ) > map->n_holding ) || 
+                      ( ( ( uint32_t ) wr_address + wr_quantity ) > map->n_holding ) )
+            {
+                exception = RS4855_MODBUS_STATUS_ILLEGAL_ADDRESS;
+            }
+            else
+            {
+                // Write is performed before read
+                for ( uint16_t cnt = 0; cnt < wr_quantity; cnt++ )
+                {
+                    map->holding[ wr_address + cnt ] = ( ( uint16_t ) req[ cnt * 2 + 11 ] << 8 ) | req[ cnt * 2 + 12 ];
+                }
+                rsp[ len++ ] = ( uint8_t ) ( quantity * 2 );
+                for ( uint16_t cnt = 0; cnt < quantity; cnt++ )
+                {
+                    rsp[ len++ ] = ( uint8_t ) ( map->holding[ address + cnt ] >> 8 );
+                    rsp[ len++ ] = ( uint8_t ) map->holding[ address + cnt ];
+                }
+            }
+            break;
+        }
+        default:
+        {
+            exception = RS4855_MODBUS_STATUS_ILLEGAL_FUNCTION;
+            break;
+        }
+    }
+
+    // Broadcast requests are never answered
+    if ( 0 == req[ 0 ] )
+    {
+        return 0;
+    }
+    if ( exception )
+    {
+        rsp[ 1 ] |= 0x80;
+        rsp[ 2 ] = exception;
+        len = 3;
+    }
+    crc = dev_modbus_crc( rsp, len );
+    rsp[ len++ ] = ( uint8_t ) crc;
+    rsp[ len++ ] = ( uint8_t ) ( crc >> 8 );
+    mb->tx_len = len;
+
+    return 1;
+}
+
+static void dev_modbus_complete ( rs4855_modbus_t *mb, uint8_t status )
+{
+    rs4855_modbus_req_t *req = mb->queue[ mb->q_head ];
+
+    mb->q_head = ( mb->q_head + 1 ) % RS4855_MODBUS_QUEUE_SIZE;
+    mb->q_cnt--;
+    mb->state = MODBUS_STATE_IDLE;
+    if ( RS4855_MODBUS_STATUS_OK == status )
+    {
+        mb->n_done++;
+    }
+    else
+    {
+        mb->n_error++;
+    }
+    req->status = status;
+    if ( NULL != req->done )
+    {
+        req->done( req );
+    }
+}
+
+static uint8_t dev_modbus_get_bit ( uint8_t *bits, uint16_t index )
+{
+    return ( bits[ index >> 3 ] >> ( index & 0x07 ) ) & 0x01;
+}
+
+static void dev_modbus_set_bit ( uint8_t *bits, uint16_t index, uint8_t state )
+{
+    if ( state )
+    {
+        bits[ index >> 3 ] |= ( uint8_t ) ( 1 << ( index & 0x07 ) );
+    }
+    else
+    {
+        bits[ index >> 3 ] &= ( uint8_t ) ~( 1 << ( index & 0x07 ) );
+    }
+}
+
+// ------------------------------------------------------------------------- END
+
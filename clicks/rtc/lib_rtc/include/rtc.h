@@ -430,8 +430,8 @@ void rtc_c_set_time ( rtc_c_t *ctx );
  *
  * @param ctx                 Click object.
  *
- * @details Function gets time: hours, minutes and seconds data from
- * the target register address of PCF8583 chip on RTC Click.
+ * @details Function gets time: hours, minutes, seconds and hundredths data from
+ * the time registers of PCF8583 chip on RTC Click in one burst read.
  */
 void rtc_c_get_time ( rtc_c_t *ctx );
 
@@ -451,7 +451,7 @@ void rtc_c_set_date ( rtc_c_t *ctx );
  * @param ctx                 Click object.
  *
  * @details Function gets date: day of the week, day, month and year data from
- * the target register address of PCF8583 chip on RTC Click.
+ * the date registers of PCF8583 chip on RTC Click in one burst read.
  */
 void rtc_c_get_date ( rtc_c_t *ctx );
 
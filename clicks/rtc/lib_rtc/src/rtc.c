@@ -391,10 +391,15 @@ void rtc_c_set_time ( rtc_c_t *ctx )
 
 void rtc_c_get_time ( rtc_c_t *ctx )
 {
-    ctx->time.time_hours = rtc_c_get_time_value( ctx, RTC_C_REG_TIME_HOUR );
-    ctx->time.time_minutes = rtc_c_get_time_value( ctx, RTC_C_REG_TIME_MIN );
-    ctx->time.time_seconds = rtc_c_get_time_value( ctx, RTC_C_REG_TIME_SEC );
-    ctx->time.time_hun_sec = rtc_c_get_time_value( ctx, RTC_C_REG_TIME_HUN_SEC );
+    uint8_t rx_buf[ 4 ];
+
+    // Hundredths, seconds, minutes and hours are read in one burst so they belong to the same instant.
+    rtc_c_generic_read( ctx, RTC_C_REG_TIME_HUN_SEC, rx_buf, 4 );
+
+    ctx->time.time_hun_sec = ( 10 * ( ( rx_buf[ 0 ] & 0x70 ) >> 4 ) ) + ( rx_buf[ 0 ] & 0x0F );
+    ctx->time.time_seconds = ( 10 * ( ( rx_buf[ 1 ] & 0x70 ) >> 4 ) ) + ( rx_buf[ 1 ] & 0x0F );
+    ctx->time.time_minutes = ( 10 * ( ( rx_buf[ 2 ] & 0x70 ) >> 4 ) ) + ( rx_buf[ 2 ] & 0x0F );
+    ctx->time.time_hours = ( 10 * ( ( rx_buf[ 3 ] & 0x30 ) >> 4 ) ) + ( rx_buf[ 3 ] & 0x0F );
 }                 
 
 void rtc_c_set_date ( rtc_c_t *ctx )
@@ -409,10 +414,15 @@ void rtc_c_set_date ( rtc_c_t *ctx )
 
 void rtc_c_get_date ( rtc_c_t *ctx )
 {
-    ctx->date.day_of_the_week = rtc_c_get_day_of_the_week( ctx );
-    ctx->date.date_day = rtc_c_get_date_day( ctx );
-    ctx->date.date_month = rtc_c_get_date_month( ctx );
-    ctx->date.date_year = rtc_c_get_date_year( ctx );
+    uint8_t rx_buf[ 3 ];
+
+    // Day and year, weekday and month, and the year byte kept in the timer register are read in one burst.
+    rtc_c_generic_read( ctx, RTC_C_REG_TIME_DATE_DAY_AND_YEAR, rx_buf, 3 );
+
+    ctx->date.date_day = ( 10 * ( ( rx_buf[ 0 ] & 0x30 ) >> 4 ) ) + ( rx_buf[ 0 ] & 0x0F );
+    ctx->date.day_of_the_week = ( rx_buf[ 1 ] & 0xE0 ) >> 5;
+    ctx->date.date_month = ( 10 * ( ( rx_buf[ 1 ] & 0x10 ) >> 4 ) ) + ( rx_buf[ 1 ] & 0x0F );
+    ctx->date.date_year = ( 10 * ( ( rx_buf[ 2 ] & 0xF0 ) >> 4 ) ) + ( rx_buf[ 2 ] & 0x0F );
 }
 
 void rtc_c_enable_disable_alarm ( rtc_c_t *ctx, uint8_t en_dis )
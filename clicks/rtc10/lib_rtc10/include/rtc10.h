@@ -176,6 +176,21 @@ typedef struct
 
 } rtc10_cfg_t;
 
+/**
+ * @brief Time and date snapshot structure definition.
+ */
+typedef struct
+{
+    uint8_t seconds;
+    uint8_t minutes;
+    uint8_t hours;
+    uint8_t day_of_the_week;
+    uint8_t date_day;
+    uint8_t date_month;
+    uint16_t date_year;
+
+} rtc10_timestamp_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -501,7 +516,7 @@ void rtc10_get_time ( rtc10_t *ctx, uint8_t *time_hours, uint8_t *time_minutes,
 void rtc10_set_date( rtc10_t *ctx, uint8_t day_of_the_week, uint8_t date_day, uint8_t date_month, uint16_t date_year );
 
 /**
- * @brief Get time hours, minutes and seconds function.
+ * @brief Get date function.
  *
  * @param ctx                   Click object.
  * @param day_of_the_week       pointer of date of the week data [ 1 : 7 ]
@@ -515,6 +530,41 @@ void rtc10_set_date( rtc10_t *ctx, uint8_t day_of_the_week, uint8_t date_day, ui
  */
 void rtc10_get_date( rtc10_t *ctx, uint8_t *day_of_the_week, uint8_t *date_day, uint8_t *date_month, uint8_t *date_year );
 
+/**
+ * @brief Get time and date snapshot function.
+ *
+ * @param ctx                   Click object.
+ * @param timestamp             pointer of time and date structure
+ *
+ * @description This function reads the whole time and date register block, from
+ * _RTC10_RTCSEC to _RTC10_RTCYEAR, in a single I2C transaction, so the result can not
+ * be torn by a rollover between the reads. The year is full, 2000 to 2199.
+ */
+void rtc10_get_timestamp ( rtc10_t *ctx, rtc10_timestamp_t *timestamp );
+
+/**
+ * @brief Convert time and date to Unix time function.
+ *
+ * @param timestamp             pointer of time and date structure
+ *
+ * @returns seconds since 1970-01-01 00:00:00.
+ *
+ * @description This function converts the time and date to Unix time.
+ * @note The 32-bit result covers dates up to the year 2105.
+ */
+uint32_t rtc10_timestamp_to_unix ( rtc10_timestamp_t *timestamp );
+
+/**
+ * @brief Get Unix time function.
+ *
+ * @param ctx                   Click object.
+ *
+ * @returns seconds since 1970-01-01 00:00:00.
+ *
+ * @description This function reads the time and date snapshot and converts it to Unix time.
+ */
+uint32_t rtc10_get_unix_time ( rtc10_t *ctx );
+
 /**
  * @brief Get alarm time seconds function.
  *
@@ -28,6 +28,10 @@
 
 #include "rtc10.h"
 
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static uint8_t dev_bcd_to_dec ( uint8_t bcd );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void rtc10_cfg_setup ( rtc10_cfg_t *cfg )
@@ -421,9 +425,13 @@ void rtc10_set_time ( rtc10_t *ctx, uint8_t time_hours, uint8_t time_minutes, ui
 
 void rtc10_get_time ( rtc10_t *ctx, uint8_t *time_hours, uint8_t *time_minutes, uint8_t *time_seconds )
 {
-    *time_hours = rtc10_get_time_hours( ctx );
-    *time_minutes = rtc10_get_time_minutes( ctx );
-    *time_seconds = rtc10_get_time_seconds( ctx );
+    uint8_t r_buffer[ 3 ];
+
+    rtc10_generic_read( ctx, RTC10_RTCSEC, r_buffer, 3 );
+
+    *time_seconds = dev_bcd_to_dec( r_buffer[ 0 ] & 0x7F );
+    *time_minutes = dev_bcd_to_dec( r_buffer[ 1 ] & 0x7F );
+    *time_hours = dev_bcd_to_dec( r_buffer[ 2 ] & 0x3F );
 }
 
 void rtc10_set_date( rtc10_t *ctx, uint8_t day_of_the_week, uint8_t date_day, uint8_t date_month, uint16_t date_year )
@@ -436,10 +444,70 @@ void rtc10_set_date( rtc10_t *ctx, uint8_t day_of_the_week, uint8_t date_day, ui
 
 void rtc10_get_date( rtc10_t *ctx, uint8_t *day_of_the_week, uint8_t *date_day, uint8_t *date_month, uint8_t *date_year )
 {
-    *day_of_the_week = rtc10_get_day_of_the_week( ctx );
-    *date_day = rtc10_get_date_day( ctx );
-    *date_month = rtc10_get_date_month( ctx );
-    *date_year = rtc10_get_date_year( ctx );
+    uint8_t r_buffer[ 4 ];
+
+    rtc10_generic_read( ctx, RTC10_RTCWKDAY, r_buffer, 4 );
+
+    *day_of_the_week = r_buffer[ 0 ];
+    *date_day = dev_bcd_to_dec( r_buffer[ 1 ] & 0x3F );
+    *date_month = dev_bcd_to_dec( r_buffer[ 2 ] & 0x1F );
+    *date_year = dev_bcd_to_dec( r_buffer[ 3 ] );
+}
+
+void rtc10_get_timestamp ( rtc10_t *ctx, rtc10_timestamp_t *timestamp )
+{
+    uint8_t r_buffer[ 7 ];
+
+    rtc10_generic_read( ctx, RTC10_RTCSEC, r_buffer, 7 );
+
+    timestamp->seconds = dev_bcd_to_dec( r_buffer[ 0 ] & 0x7F );
+    timestamp->minutes = dev_bcd_to_dec( r_buffer[ 1 ] & 0x7F );
+    timestamp->hours = dev_bcd_to_dec( r_buffer[ 2 ] & 0x3F );
+    timestamp->day_of_the_week = r_buffer[ 3 ];
+    timestamp->date_day = dev_bcd_to_dec( r_buffer[ 4 ] & 0x3F );
+    timestamp->date_month = dev_bcd_to_dec( r_buffer[ 5 ] & 0x1F );
+    timestamp->date_year = 2000 + dev_bcd_to_dec( r_buffer[ 6 ] );
+
+    // Century bit of the month register
+    if ( r_buffer[ 5 ] & 0x80 )
+    {
+        timestamp->date_year += 100;
+    }
+}
+
+uint32_t rtc10_timestamp_to_unix ( rtc10_timestamp_t *timestamp )
+{
+    uint32_t year;
+    uint32_t month;
+    uint32_t days;
+
+    // Days from civil date with the year starting in March, so February is the last month
+    year = timestamp->date_year;
+    month = timestamp->date_month;
+    if ( month <= 2 )
+    {
+        year--;
+        month += 9;
+    }
+    else
+    {
+        month -= 3;
+    }
+
+    days = ( 365 * year ) + ( year / 4 ) - ( year / 100 ) + ( year / 400 ) + 
+           ( ( 153 * month ) + 2 ) / 5 + timestamp->date_day - 1 - 719468ul;
+
+    return ( days * 86400ul ) + ( ( uint32_t ) timestamp->hours * 3600 ) + 
+           ( ( uint32_t ) timestamp->minutes * 60 ) + timestamp->seconds;
+}
+
+uint32_t rtc10_get_unix_time ( rtc10_t *ctx )
+{
+    rtc10_timestamp_t timestamp;
+
+    rtc10_get_timestamp( ctx, &timestamp );
+
+    return rtc10_timestamp_to_unix( &timestamp );
 }
 
 // -------------------------------------------------------------- ALARM 1 & 2  
@@ -791,5 +859,11 @@ float rtc10_get_temperature ( rtc10_t *ctx )
     return temperature;
 }
 
-// ------------------------------------------------------------------------- END
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
+static uint8_t dev_bcd_to_dec ( uint8_t bcd )
+{
+    return ( ( bcd >> 4 ) * 10 ) + ( bcd & 0x0F );
+}
+
+// ------------------------------------------------------------------------- END
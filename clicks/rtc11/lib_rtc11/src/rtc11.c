@@ -496,9 +496,13 @@ err_t rtc11_set_time ( rtc11_t *ctx, rtc11_time_t rtc_time ) {
 }
 
 void rtc11_get_time ( rtc11_t *ctx, rtc11_time_t *rtc_time ) {
-    rtc_time->hours = rtc11_get_time_hours( ctx );
-    rtc_time->min = rtc11_get_time_minutes( ctx );
-    rtc_time->sec = rtc11_get_time_seconds( ctx );
+    uint8_t rx_buf[ 3 ];
+
+    rtc11_generic_read( ctx, RTC11_REG_SEC, rx_buf, 3 );
+
+    rtc_time->sec = dev_bcd_to_bin( rx_buf[ 0 ] );
+    rtc_time->min = dev_bcd_to_bin( rx_buf[ 1 ] );
+    rtc_time->hours = dev_bcd_to_bin( rx_buf[ 2 ] );
 }
 
 err_t rtc11_set_date ( rtc11_t *ctx, rtc11_date_t rtc_date ) {
@@ -545,10 +549,14 @@ err_t rtc11_set_date ( rtc11_t *ctx, rtc11_date_t rtc_date ) {
 }
 
 void rtc11_get_date ( rtc11_t *ctx, rtc11_date_t *rtc_date ) {
-    rtc_date->day_of_week = rtc11_get_day_of_the_week( ctx );
-    rtc_date->day = rtc11_get_date_day( ctx );
-    rtc_date->month = rtc11_get_date_month( ctx );
-    rtc_date->year = rtc11_get_date_year( ctx );
+    uint8_t rx_buf[ 4 ];
+
+    rtc11_generic_read( ctx, RTC11_REG_DAT, rx_buf, 4 );
+
+    rtc_date->day = dev_bcd_to_bin( rx_buf[ 0 ] );
+    rtc_date->month = dev_bcd_to_bin( rx_buf[ 1 ] );
+    rtc_date->year = dev_bcd_to_bin( rx_buf[ 2 ] );
+    rtc_date->day_of_week = rx_buf[ 3 ];
 }
 
 void rtc11_stp_sys_slk ( rtc11_t *ctx, uint8_t state ) {
@@ -198,16 +198,12 @@ err_t rtc12_get_ctrl_reg ( rtc12_t *ctx, rtc12_control_t *rtc_ctrl ) {
 }
 
 err_t rtc12_get_time ( rtc12_t *ctx, rtc12_time_t *rtc_time ) {
-    uint8_t rx_data;
+    uint8_t rx_buf[ 3 ];
 
-    err_t error_flag = rtc12_generic_read( ctx, RTC12_REG_SECONDS, &rx_data, 1 );
-    rtc_time->sec = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc12_generic_read( ctx, RTC12_REG_MINUTES, &rx_data, 1 );
-    rtc_time->min = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc12_generic_read( ctx, RTC12_REG_HOUR, &rx_data, 1 );
-    rtc_time->hours = dev_rtc_to_dec( rx_data );
+    err_t error_flag = rtc12_generic_read( ctx, RTC12_REG_SECONDS, rx_buf, 3 );
+    rtc_time->sec = dev_rtc_to_dec( rx_buf[ 0 ] );
+    rtc_time->min = dev_rtc_to_dec( rx_buf[ 1 ] );
+    rtc_time->hours = dev_rtc_to_dec( rx_buf[ 2 ] );
     
     return error_flag;
 }
@@ -235,19 +231,13 @@ err_t rtc12_set_time ( rtc12_t *ctx, rtc12_time_t rtc_time ) {
 }
 
 err_t rtc12_get_date ( rtc12_t *ctx, rtc12_date_t *rtc_date ) {
-    uint8_t rx_data;
+    uint8_t rx_buf[ 4 ];
 
-    err_t error_flag = rtc12_generic_read( ctx, RTC12_REG_DAY, &rx_data, 1 );
-    rtc_date->day_of_week = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc12_generic_read( ctx, RTC12_REG_DATE, &rx_data, 1 );
-    rtc_date->day = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc12_generic_read( ctx, RTC12_REG_MONTH, &rx_data, 1 );
-    rtc_date->month = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc12_generic_read( ctx, RTC12_REG_YEAR, &rx_data, 1 );
-    rtc_date->year = dev_rtc_to_dec( rx_data );
+    err_t error_flag = rtc12_generic_read( ctx, RTC12_REG_DAY, rx_buf, 4 );
+    rtc_date->day_of_week = dev_rtc_to_dec( rx_buf[ 0 ] );
+    rtc_date->day = dev_rtc_to_dec( rx_buf[ 1 ] );
+    rtc_date->month = dev_rtc_to_dec( rx_buf[ 2 ] );
+    rtc_date->year = dev_rtc_to_dec( rx_buf[ 3 ] );
     
     return error_flag;
 }
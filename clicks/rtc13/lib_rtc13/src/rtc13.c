@@ -182,16 +182,12 @@ err_t rtc13_soft_reset ( rtc13_t *ctx )
 
 err_t rtc13_get_time ( rtc13_t *ctx, rtc13_time_t *rtc_time ) 
 {
-    uint8_t rx_data;
+    uint8_t rx_buf[ 3 ];
 
-    err_t error_flag = rtc13_generic_read( ctx, RTC13_REG_TIME_SECONDS, &rx_data, 1 );
-    rtc_time->sec = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc13_generic_read( ctx, RTC13_REG_TIME_MINUTES, &rx_data, 1 );
-    rtc_time->min = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc13_generic_read( ctx, RTC13_REG_TIME_HOUR, &rx_data, 1 );
-    rtc_time->hours = dev_rtc_to_dec( rx_data );
+    err_t error_flag = rtc13_generic_read( ctx, RTC13_REG_TIME_SECONDS, rx_buf, 3 );
+    rtc_time->sec = dev_rtc_to_dec( rx_buf[ 0 ] );
+    rtc_time->min = dev_rtc_to_dec( rx_buf[ 1 ] );
+    rtc_time->hours = dev_rtc_to_dec( rx_buf[ 2 ] );
     
     return error_flag;
 }
@@ -224,19 +220,13 @@ err_t rtc13_set_time ( rtc13_t *ctx, rtc13_time_t rtc_time )
 
 err_t rtc13_get_date ( rtc13_t *ctx, rtc13_date_t *rtc_date ) 
 {
-    uint8_t rx_data;
+    uint8_t rx_buf[ 4 ];
 
-    err_t error_flag = rtc13_generic_read( ctx, RTC13_REG_DATE_WEEKDAYS, &rx_data, 1 );
-    rtc_date->weekday = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc13_generic_read( ctx, RTC13_REG_DATE_DAY, &rx_data, 1 );
-    rtc_date->day = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc13_generic_read( ctx, RTC13_REG_DATE_MONTHS, &rx_data, 1 );
-    rtc_date->month = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc13_generic_read( ctx, RTC13_REG_DATE_YEARS, &rx_data, 1 );
-    rtc_date->year = dev_rtc_to_dec( rx_data );
+    err_t error_flag = rtc13_generic_read( ctx, RTC13_REG_DATE_DAY, rx_buf, 4 );
+    rtc_date->day = dev_rtc_to_dec( rx_buf[ 0 ] );
+    rtc_date->weekday = dev_rtc_to_dec( rx_buf[ 1 ] );
+    rtc_date->month = dev_rtc_to_dec( rx_buf[ 2 ] );
+    rtc_date->year = dev_rtc_to_dec( rx_buf[ 3 ] );
     
     return error_flag;
 }
@@ -187,15 +187,14 @@ err_t rtc14_soft_reset ( rtc14_t *ctx )
 
 err_t rtc14_get_time ( rtc14_t *ctx, rtc14_time_t *rtc_time ) 
 {
+    uint8_t rx_buf[ 3 ];
     uint8_t rx_data;
 
-    err_t error_flag = rtc14_generic_read( ctx, RTC14_REG_SC, &rx_data, 1 );
-    rtc_time->sec = dev_rtc_to_dec( rx_data );
+    err_t error_flag = rtc14_generic_read( ctx, RTC14_REG_SC, rx_buf, 3 );
+    rtc_time->sec = dev_rtc_to_dec( rx_buf[ 0 ] );
+    rtc_time->min = dev_rtc_to_dec( rx_buf[ 1 ] );
     
-    error_flag |= rtc14_generic_read( ctx, RTC14_REG_MN, &rx_data, 1 );
-    rtc_time->min = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc14_generic_read( ctx, RTC14_REG_HR, &rx_data, 1 );
+    rx_data = rx_buf[ 2 ];
     if ( rx_data & RTC14_SET_HOURS_FORMAT_24 )
     {
         rx_data &= BIT_MASK_HOURS_FORMAT_24;    
@@ -242,19 +241,13 @@ err_t rtc14_set_time ( rtc14_t *ctx, rtc14_time_t rtc_time )
 
 err_t rtc14_get_date ( rtc14_t *ctx, rtc14_date_t *rtc_date ) 
 {
-    uint8_t rx_data;
+    uint8_t rx_buf[ 4 ];
 
-    err_t error_flag = rtc14_generic_read( ctx, RTC14_REG_DT, &rx_data, 1 );
-    rtc_date->day = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc14_generic_read( ctx, RTC14_REG_MO, &rx_data, 1 );
-    rtc_date->month = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc14_generic_read( ctx, RTC14_REG_YR, &rx_data, 1 );
-    rtc_date->year = dev_rtc_to_dec( rx_data );
-    
-    error_flag = rtc14_generic_read( ctx, RTC14_REG_DW, &rx_data, 1 );
-    rtc_date->day_of_week = dev_rtc_to_dec( rx_data );
+    err_t error_flag = rtc14_generic_read( ctx, RTC14_REG_DT, rx_buf, 4 );
+    rtc_date->day = dev_rtc_to_dec( rx_buf[ 0 ] );
+    rtc_date->month = dev_rtc_to_dec( rx_buf[ 1 ] );
+    rtc_date->year = dev_rtc_to_dec( rx_buf[ 2 ] );
+    rtc_date->day_of_week = dev_rtc_to_dec( rx_buf[ 3 ] );
     
     return error_flag;
 }
@@ -422,30 +415,15 @@ void rtc14_trigger_time_stamp ( rtc14_t *ctx )
 
 err_t rtc14_get_time_stamp ( rtc14_t *ctx, rtc14_time_stamp_t *rtc_time_stamp ) 
 {
-    uint8_t rx_data;
-    
-    err_t error_flag = rtc14_generic_read( ctx, RTC14_REG_SCT, &rx_data, 1 );
-    rtc_time_stamp->sec = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc14_generic_read( ctx, RTC14_REG_MNT, &rx_data, 1 );
-    rx_data &= BIT_MASK_TIME_REV_BIT;
-    rtc_time_stamp->min = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc14_generic_read( ctx, RTC14_REG_HRT, &rx_data, 1 );
-    rx_data &= BIT_MASK_TIME_REV_BIT;
-    rtc_time_stamp->hours = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc14_generic_read( ctx, RTC14_REG_DTT, &rx_data, 1 );
-    rx_data &= BIT_MASK_TIME_REV_BIT;
-    rtc_time_stamp->day = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc14_generic_read( ctx, RTC14_REG_MOT, &rx_data, 1 );
-    rx_data &= BIT_MASK_TIME_REV_BIT;
-    rtc_time_stamp->month = dev_rtc_to_dec( rx_data );
-    
-    error_flag |= rtc14_generic_read( ctx, RTC14_REG_YRT, &rx_data, 1 );
-    rx_data &= BIT_MASK_TIME_REV_BIT;
-    rtc_time_stamp->year = dev_rtc_to_dec( rx_data );
+    uint8_t rx_buf[ 6 ];
+    
+    err_t error_flag = rtc14_generic_read( ctx, RTC14_REG_SCT, rx_buf, 6 );
+    rtc_time_stamp->sec = dev_rtc_to_dec( rx_buf[ 0 ] );
+    rtc_time_stamp->min = dev_rtc_to_dec( rx_buf[ 1 ] & BIT_MASK_TIME_REV_BIT );
+    rtc_time_stamp->hours = dev_rtc_to_dec( rx_buf[ 2 ] & BIT_MASK_TIME_REV_BIT );
+    rtc_time_stamp->day = dev_rtc_to_dec( rx_buf[ 3 ] & BIT_MASK_TIME_REV_BIT );
+    rtc_time_stamp->month = dev_rtc_to_dec( rx_buf[ 4 ] & BIT_MASK_TIME_REV_BIT );
+    rtc_time_stamp->year = dev_rtc_to_dec( rx_buf[ 5 ] & BIT_MASK_TIME_REV_BIT );
     
     return error_flag;
 }
@@ -397,9 +397,14 @@ void rtc2_set_time ( rtc2_t *ctx, uint8_t time_hours, uint8_t time_minutes, uint
 
 void rtc2_get_time ( rtc2_t *ctx, uint8_t *time_hours, uint8_t *time_minutes, uint8_t *time_seconds )
 {
-    *time_hours = rtc2_get_time_hours( ctx );
-    *time_minutes = rtc2_get_time_minutes( ctx );
-    *time_seconds = rtc2_get_time_seconds( ctx );
+    uint8_t rx_buf[ 3 ];
+
+    // Seconds, minutes and hours are read in one burst so they belong to the same second.
+    rtc2_generic_read( ctx, RTC2_REG_TIME_SEC, rx_buf, 3 );
+
+    *time_seconds = ( 10 * ( ( rx_buf[ 0 ] & 0x70 ) >> 4 ) ) + ( rx_buf[ 0 ] & 0x0F );
+    *time_minutes = ( 10 * ( ( rx_buf[ 1 ] & 0x70 ) >> 4 ) ) + ( rx_buf[ 1 ] & 0x0F );
+    *time_hours = ( 10 * ( ( rx_buf[ 2 ] & 0x30 ) >> 4 ) ) + ( rx_buf[ 2 ] & 0x0F );
 }
 
 void rtc2_set_date ( rtc2_t *ctx, rtc2_data_t *date )
@@ -412,10 +417,15 @@ void rtc2_set_date ( rtc2_t *ctx, rtc2_data_t *date )
 
 void rtc2_get_date ( rtc2_t *ctx, rtc2_data_t *date )
 {
-    date->day_of_the_week = rtc2_get_day_of_the_week( ctx );
-    date->date_day = rtc2_get_date_day( ctx );
-    date->date_month = rtc2_get_date_month( ctx );
-    date->date_year = rtc2_get_date_year( ctx );
+    uint8_t rx_buf[ 4 ];
+
+    // Day of the week, day, month and year are read in one burst.
+    rtc2_generic_read( ctx, RTC2_REG_TIME_DAY_OF_THE_WEEK, rx_buf, 4 );
+
+    date->day_of_the_week = rx_buf[ 0 ];
+    date->date_day = ( 10 * ( ( rx_buf[ 1 ] & 0x30 ) >> 4 ) ) + ( rx_buf[ 1 ] & 0x0F );
+    date->date_month = ( 10 * ( ( rx_buf[ 2 ] & 0x10 ) >> 4 ) ) + ( rx_buf[ 2 ] & 0x0F );
+    date->date_year = ( 10 * ( ( rx_buf[ 3 ] & 0xF0 ) >> 4 ) ) + ( rx_buf[ 3 ] & 0x0F );
 }
 
 void rtc2_set_frequency_sqwe ( rtc2_t *ctx, uint8_t rate_select )
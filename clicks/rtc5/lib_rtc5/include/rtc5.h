@@ -618,7 +618,7 @@ void rtc5_set_date ( rtc5_t *ctx, uint8_t date_day, uint8_t date_month, uint16_t
  *
  * This function gets time ( hours, minutes and seconds ) 
  * and date ( day, month and year )
- * of MCP79510 chip on RTC 5 Click.
+ * of MCP79510 chip on RTC 5 Click in one sequential read.
  */
 void rtc5_get_time_and_date ( rtc5_t *ctx, rtc5_timedate_t *timedate_data );
 
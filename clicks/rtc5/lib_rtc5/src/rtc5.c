@@ -534,13 +534,22 @@ void rtc5_set_date ( rtc5_t *ctx, uint8_t date_day, uint8_t date_month, uint16_t
 
 void rtc5_get_time_and_date ( rtc5_t *ctx, rtc5_timedate_t *timedate_data )
 {
-    timedate_data->hours = rtc5_get_time_hours( ctx );
-    timedate_data->min = rtc5_get_time_min( ctx );
-    timedate_data->sec = rtc5_get_time_sec( ctx );
-    timedate_data->day = rtc5_get_date_day( ctx );
-    timedate_data->month = rtc5_get_date_month( ctx );
-    timedate_data->year = rtc5_get_date_year( ctx );
-    timedate_data->w_day = rtc5_get_day_of_the_week( ctx );
+    uint8_t tx_buf[ 2 ];
+    uint8_t rx_buf[ 7 ];
+
+    tx_buf[ 0 ] = RTC5_SPI_READ;
+    tx_buf[ 1 ] = RTC5_REG_TIME_SEC;
+
+    // Seconds through year are read in one sequential read so they belong to the same second.
+    rtc5_generic_transfer( ctx, tx_buf, 2, rx_buf, 7 );
+
+    timedate_data->sec = ( 10 * ( ( rx_buf[ 0 ] & 0x70 ) >> 4 ) ) + ( rx_buf[ 0 ] & 0x0F );
+    timedate_data->min = ( 10 * ( ( rx_buf[ 1 ] & 0x70 ) >> 4 ) ) + ( rx_buf[ 1 ] & 0x0F );
+    timedate_data->hours = ( 10 * ( ( rx_buf[ 2 ] & 0x30 ) >> 4 ) ) + ( rx_buf[ 2 ] & 0x0F );
+    timedate_data->w_day = rx_buf[ 3 ] & 0x07;
+    timedate_data->day = ( 10 * ( ( rx_buf[ 4 ] & 0x30 ) >> 4 ) ) + ( rx_buf[ 4 ] & 0x0F );
+    timedate_data->month = ( 10 * ( ( rx_buf[ 5 ] & 0x10 ) >> 4 ) ) + ( rx_buf[ 5 ] & 0x0F );
+    timedate_data->year = ( 10 * ( ( rx_buf[ 6 ] & 0xF0 ) >> 4 ) ) + ( rx_buf[ 6 ] & 0x0F );
 }
 
 uint8_t rtc5_get_interrupt ( rtc5_t *ctx )
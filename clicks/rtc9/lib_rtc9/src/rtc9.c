@@ -286,43 +286,29 @@ void rtc9_set_date ( rtc9_t *ctx, rtc9_set_data_t *set_data )
 
 void rtc9_get_time( rtc9_t *ctx, rtc9_get_time_t *get_time )
 {
-    uint8_t part_sec_data;
-    uint8_t sec_data;
-    uint8_t min_data;
-    uint8_t hour_data;
+    uint8_t rx_buf[ 4 ];
 
-    rtc9_generic_read( ctx, RTC9_REG_PART_SECONDS, &part_sec_data, 1 );
-    get_time->part_sec = ( part_sec_data & 0x0F );
-    get_time->part_sec += ( ( ( part_sec_data >> 4 ) & 0x0F ) * 10 );
+    // Fractions through hours are read in one burst so they belong to the same instant.
+    rtc9_generic_read( ctx, RTC9_REG_PART_SECONDS, rx_buf, 4 );
 
-    rtc9_generic_read( ctx, RTC9_REG_SECONDS, &sec_data, 1 );
-    get_time->sec = drv_bcd_to_dec( sec_data & 0x7F );
-    
-    rtc9_generic_read( ctx, RTC9_REG_MINUTES, &min_data, 1 );
-    get_time->min = drv_bcd_to_dec( min_data & 0x7F );
-
-    rtc9_generic_read( ctx, RTC9_REG_CENTURY_HOURS, &hour_data, 1 );
-    get_time->hour = drv_bcd_to_dec( hour_data & 0x3F );
+    get_time->part_sec = ( rx_buf[ 0 ] & 0x0F );
+    get_time->part_sec += ( ( ( rx_buf[ 0 ] >> 4 ) & 0x0F ) * 10 );
+    get_time->sec = drv_bcd_to_dec( rx_buf[ 1 ] & 0x7F );
+    get_time->min = drv_bcd_to_dec( rx_buf[ 2 ] & 0x7F );
+    get_time->hour = drv_bcd_to_dec( rx_buf[ 3 ] & 0x3F );
 }
 
 void rtc9_get_date( rtc9_t *ctx, rtc9_get_date_t *get_data )
 {
-    uint8_t year_data;
-    uint8_t month_data;
-    uint8_t week_data;
-    uint8_t day_data;
+    uint8_t rx_buf[ 4 ];
 
-    rtc9_generic_read( ctx, RTC9_REG_DAY, &week_data, 1 );
-    get_data->day_of_week = drv_bcd_to_dec( week_data & 0x07 );
-
-    rtc9_generic_read( ctx, RTC9_REG_DATE, &day_data, 1 );
-    get_data->day = drv_bcd_to_dec( day_data & 0x3F );
-    
-    rtc9_generic_read( ctx, RTC9_REG_MONTH, &month_data, 1 );
-    get_data->month = drv_bcd_to_dec( month_data & 0x1F );
+    // Day of the week, date, month and year are read in one burst.
+    rtc9_generic_read( ctx, RTC9_REG_DAY, rx_buf, 4 );
 
-    rtc9_generic_read( ctx, RTC9_REG_YEAR, &year_data, 1 );
-    get_data->year = drv_bcd_to_dec( year_data );
+    get_data->day_of_week = drv_bcd_to_dec( rx_buf[ 0 ] & 0x07 );
+    get_data->day = drv_bcd_to_dec( rx_buf[ 1 ] & 0x3F );
+    get_data->month = drv_bcd_to_dec( rx_buf[ 2 ] & 0x1F );
+    get_data->year = drv_bcd_to_dec( rx_buf[ 3 ] );
 }
 
 char *rtc9_current_month( uint8_t month )
@@ -26,6 +26,7 @@
  */
 
 #include "silentstep4.h"
+#include "math.h"
 
 /**
  * @brief Dummy data.
@@ -42,6 +43,22 @@
  */
 static void silentstep4_speed_delay ( uint8_t speed_macro );
 
+/**
+ * @brief First ramp step correction factor.
+ * @details Corrects the first step interval of the incremental ramp approximation.
+ */
+#define MOTION_FIRST_STEP_CORR  0.676f
+
+/**
+ * @brief Silent Step 4 motion update function.
+ * @details This function computes the direction and interval of the next step from the current
+ * position, target and ramp state, and stops the motion engine once the target is reached.
+ * @param[in] ctx : Click context object.
+ * See #silentstep4_t object definition for detailed explanation.
+ * @return Nothing.
+ */
+static void silentstep4_motion_update ( silentstep4_t *ctx );
+
 void silentstep4_cfg_setup ( silentstep4_cfg_t *cfg ) 
 {
     cfg->scl  = HAL_PIN_NC;
@@ -128,6 +145,13 @@ err_t silentstep4_init ( silentstep4_t *ctx, silentstep4_cfg_t *cfg )
 
     digital_in_init( &ctx->int_pin, cfg->int_pin );
 
+    ctx->motion.position = 0;
+    ctx->motion.target = 0;
+    ctx->motion.ramp_step = 0;
+    ctx->motion.running = 0;
+    ctx->motion.hold = 0;
+    ctx->motion.interval_min = 0;
+
     return SILENTSTEP4_OK;
 }
 
@@ -422,6 +446,109 @@ void silentstep4_drive_motor ( silentstep4_t *ctx, uint32_t steps, uint8_t speed
     silentstep4_disable_device ( ctx );
 }
 
+err_t silentstep4_set_motion_profile ( silentstep4_t *ctx, uint32_t tick_freq, float max_speed, float accel )
+{
+    if ( ( ctx->motion.running ) || ( 0 == tick_freq ) || ( max_speed <= 0 ) || 
+         ( max_speed > ( float ) tick_freq ) || ( accel <= 0 ) )
+    {
+        return SILENTSTEP4_ERROR;
+    }
+    ctx->motion.interval_min = ( float ) tick_freq / max_speed;
+    ctx->motion.interval_0 = MOTION_FIRST_STEP_CORR * ( float ) tick_freq * sqrt ( 2.0 / accel );
+    if ( ctx->motion.interval_0 < ctx->motion.interval_min )
+    {
+        ctx->motion.interval_0 = ctx->motion.interval_min;
+    }
+    return SILENTSTEP4_OK;
+}
+
+err_t silentstep4_move_to ( silentstep4_t *ctx, int32_t position )
+{
+    if ( 0 == ctx->motion.interval_min )
+    {
+        return SILENTSTEP4_ERROR;
+    }
+    // The timer tick takes no step while the target and ramp state are updated
+    ctx->motion.hold = 1;
+    ctx->motion.target = position;
+    if ( ( !ctx->motion.running ) && ( position != ctx->motion.position ) )
+    {
+        ctx->motion.interval_frac = 0;
+        silentstep4_motion_update ( ctx );
+        ctx->motion.running = 1;
+    }
+    ctx->motion.hold = 0;
+    return SILENTSTEP4_OK;
+}
+
+err_t silentstep4_move_by ( silentstep4_t *ctx, int32_t steps )
+{
+    return silentstep4_move_to ( ctx, silentstep4_get_position ( ctx ) + steps );
+}
+
+void silentstep4_stop ( silentstep4_t *ctx )
+{
+    ctx->motion.hold = 1;
+    if ( ctx->motion.running )
+    {
+        int32_t steps_to_stop = ctx->motion.ramp_step;
+        if ( steps_to_stop < 0 )
+        {
+            steps_to_stop = -steps_to_stop;
+        }
+        ctx->motion.target = ctx->motion.position + ctx->motion.direction * steps_to_stop;
+    }
+    ctx->motion.hold = 0;
+}
+
+int32_t silentstep4_get_position ( silentstep4_t *ctx )
+{
+    int32_t position = 0;
+    // The position is wider than a single access on 8 and 16-bit cores
+    ctx->motion.hold = 1;
+    position = ctx->motion.position;
+    ctx->motion.hold = 0;
+    return position;
+}
+
+err_t silentstep4_set_position ( silentstep4_t *ctx, int32_t position )
+{
+    if ( ctx->motion.running )
+    {
+        return SILENTSTEP4_ERROR;
+    }
+    ctx->motion.position = position;
+    ctx->motion.target = position;
+    return SILENTSTEP4_OK;
+}
+
+uint8_t silentstep4_is_moving ( silentstep4_t *ctx )
+{
+    return ctx->motion.running;
+}
+
+void silentstep4_motion_tick ( silentstep4_t *ctx )
+{
+    if ( !ctx->motion.running )
+    {
+        return;
+    }
+    if ( ctx->motion.tick_cnt > 1 )
+    {
+        ctx->motion.tick_cnt--;
+        return;
+    }
+    if ( ctx->motion.hold )
+    {
+        return;
+    }
+    // Next interval is computed while the step pin is high, which stretches the pulse width
+    silentstep4_set_step_pin ( ctx, SILENTSTEP4_PIN_STATE_HIGH );
+    ctx->motion.position += ctx->motion.direction;
+    silentstep4_motion_update ( ctx );
+    silentstep4_set_step_pin ( ctx, SILENTSTEP4_PIN_STATE_LOW );
+}
+
 static void silentstep4_speed_delay ( uint8_t speed_macro )
 {
     switch ( speed_macro )
@@ -462,4 +589,83 @@ static void silentstep4_speed_delay ( uint8_t speed_macro )
     }
 }
 
+static void silentstep4_motion_update ( silentstep4_t *ctx )
+{
+    int32_t distance = ctx->motion.target - ctx->motion.position;
+    int32_t steps_to_stop = ctx->motion.ramp_step;
+    float interval = 0;
+    
+    // While accelerating or cruising the ramp index equals the number of steps needed to stop
+    if ( steps_to_stop < 0 )
+    {
+        steps_to_stop = -steps_to_stop;
+    }
+    if ( ( 0 == distance ) && ( steps_to_stop <= 1 ) )
+    {
+        ctx->motion.ramp_step = 0;
+        ctx->motion.running = 0;
+        return;
+    }
+    if ( distance > 0 )
+    {
+        if ( ( ctx->motion.ramp_step > 0 ) && ( ( steps_to_stop >= distance ) || ( ctx->motion.direction < 0 ) ) )
+        {
+            ctx->motion.ramp_step = -steps_to_stop;
+        }
+        else if ( ( ctx->motion.ramp_step < 0 ) && ( steps_to_stop < distance ) && ( ctx->motion.direction > 0 ) )
+        {
+            ctx->motion.ramp_step = steps_to_stop;
+        }
+    }
+    else if ( distance < 0 )
+    {
+        if ( ( ctx->motion.ramp_step > 0 ) && ( ( steps_to_stop >= -distance ) || ( ctx->motion.direction > 0 ) ) )
+        {
+            ctx->motion.ramp_step = -steps_to_stop;
+        }
+        else if ( ( ctx->motion.ramp_step < 0 ) && ( steps_to_stop < -distance ) && ( ctx->motion.direction < 0 ) )
+        {
+            ctx->motion.ramp_step = steps_to_stop;
+        }
+    }
+
+    if ( 0 == ctx->motion.ramp_step )
+    {
+        // Start of a new ramp from standstill
+        if ( distance > 0 )
+        {
+            ctx->motion.direction = 1;
+            silentstep4_set_direction ( ctx, SILENTSTEP4_DIR_CW );
+        }
+        else
+        {
+            ctx->motion.direction = -1;
+            silentstep4_set_direction ( ctx, SILENTSTEP4_DIR_CCW );
+        }
+        ctx->motion.interval = ctx->motion.interval_0;
+        ctx->motion.ramp_step = 1;
+    }
+    else
+    {
+        // c(n) = c(n-1) - 2 * c(n-1) / ( 4 * n + 1 ), a negative index slows the motor down
+        ctx->motion.interval -= ( 2.0f * ctx->motion.interval ) / ( 4.0f * ctx->motion.ramp_step + 1.0f );
+        if ( ctx->motion.interval <= ctx->motion.interval_min )
+        {
+            ctx->motion.interval = ctx->motion.interval_min;
+        }
+        else
+        {
+            ctx->motion.ramp_step++;
+        }
+    }
+
+    interval = ctx->motion.interval + ctx->motion.interval_frac;
+    ctx->motion.tick_cnt = ( uint32_t ) interval;
+    ctx->motion.interval_frac = interval - ctx->motion.tick_cnt;
+    if ( 0 == ctx->motion.tick_cnt )
+    {
+        ctx->motion.tick_cnt = 1;
+    }
+}
+
 // ------------------------------------------------------------------------ END
@@ -255,35 +255,20 @@ void smartnfc_clear_buffers ( smartnfc_t *ctx )
 
 static uint16_t smartnfc_crc16_ccitt ( smartnfc_frame_t cmd_frame )
 {
+    // CRC of each nibble value for polynomial 0x1021, processed 4 bits at a time
+    static const uint16_t crc16_table[ 16 ] = 
+    {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+    };
     uint16_t crc16 = 0xFFFF;
     uint16_t byte_cnt = 0;
-    uint8_t bit_cnt = 0;
-    crc16 ^= ( ( uint16_t ) cmd_frame.cmd << 8 );
-    for ( bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
-    {
-        if ( crc16 & 0x8000 )
-        {
-            crc16 = ( crc16 << 1 ) ^ 0x1021;
-        }
-        else
-        {
-            crc16 <<= 1;
-        }
-    }
+    crc16 = ( crc16 << 4 ) ^ crc16_table[ ( crc16 >> 12 ) ^ ( cmd_frame.cmd >> 4 ) ];
+    crc16 = ( crc16 << 4 ) ^ crc16_table[ ( crc16 >> 12 ) ^ ( cmd_frame.cmd & 0x0F ) ];
     for ( byte_cnt = 0; byte_cnt < cmd_frame.payload_len; byte_cnt++ )
     {
-        crc16 ^= ( ( uint16_t ) cmd_frame.payload[ byte_cnt ] << 8 );
-        for ( bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
-        {
-            if ( crc16 & 0x8000 )
-            {
-                crc16 = ( crc16 << 1 ) ^ 0x1021;
-            }
-            else
-            {
-                crc16 <<= 1;
-            }
-        }
+        crc16 = ( crc16 << 4 ) ^ crc16_table[ ( crc16 >> 12 ) ^ ( cmd_frame.payload[ byte_cnt ] >> 4 ) ];
+        crc16 = ( crc16 << 4 ) ^ crc16_table[ ( crc16 >> 12 ) ^ ( cmd_frame.payload[ byte_cnt ] & 0x0F ) ];
     }
     return crc16;
 }
@@ -78,11 +78,13 @@ extern "C"{
  * because it needs to be booted every time on the start of the application.
  * When Flash selector is selected and you already have flash image in your
  * devices flash you can disable flash image slector because you don't need
- * to include it in your project.
+ * to include it in your project. With @b SMARTSENS_FW_RESUME set, flash upload
+ * that was interrupted by a transfer error continues from the last written chunk.
  */
 #define SMARTSENS_FLASHIMG                                      0   /*< Firmware image for flash include */
 #define SMARTSENS_FLASH                                         1   /*< Boot firmware from flash */
 #define SMARTSENS_RAM                                           0   /*< Upload and boot firmware from RAM */
+#define SMARTSENS_FW_RESUME                                     1   /*< Resume interrupted flash upload */
 
 /**
  * @brief Smart Sens description register.
@@ -281,6 +283,14 @@ extern "C"{
 #define SMARTSENS_N_VIRTUAL_SENSOR_MAX                          256 /* Maximum no of available virtual sensor */
 #define SMARTSENS_SPECIAL_SENSOR_ID_OFFSET                      245 /* Special & debug virtual sensor id starts at 245 */
 
+/**
+ * @brief Smart Sens fifo batch definitions.
+ * @details Number of batched virtual sensors and batch data types of the Smart Sens Click driver.
+ */
+#define SMARTSENS_FIFO_BATCH_MAX                                4   /* Maximum no of batched virtual sensors */
+#define SMARTSENS_FIFO_BATCH_VECTOR                             0   /* Accelerometer, gyroscope, magnetometer, gravity, orientation */
+#define SMARTSENS_FIFO_BATCH_QUATERNION                         1   /* Rotation vectors */
+
 /**
  * @brief Smart Sens meta event definitions.
  * @details Definitions of the meta event of the Smart Sens firmware image.
@@ -399,7 +409,7 @@ extern "C"{
                                                                   ( uint32_t )( x )[ 2 ] << 16 | \
                                                                   ( uint32_t )( x )[ 3 ] << 24 ) )
 #define SMARTSENS_LE2S32( x )                                   ( ( int32_t )SMARTSENS_LE2U32( x ) )
-#define SMARTSENS_LE2U40( x )                                   ( SMARTSENS_LE2U32( x ) | ( uint32_t )( x )[ 4 ] << 32 )
+#define SMARTSENS_LE2U40( x )                                   ( ( uint64_t )SMARTSENS_LE2U32( x ) | ( uint64_t )( x )[ 4 ] << 32 )
 #define SMARTSENS_TIMESTAMP_TO_SEC( x )                         ( ( uint32_t ) ( x * ( 15625.0 / UINT32_C( 1000000000 ) ) ) )
 
 /**
@@ -552,10 +562,69 @@ struct smartsens_sensor_info
 struct smartsens_fifo_parse_callback_table
 {
     uint8_t event_size;
+    uint8_t batch_idx;
     smartsens_fifo_parse_callback_t callback;
     void *callback_ref;
 };
 
+/**
+ * @brief Vector event.
+ * @details Struct for batched 3-axis event of the Smart Sens Click driver.
+ */
+struct smartsens_fifo_vector
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    uint32_t time_stamp;
+};
+
+/**
+ * @brief Quaternion event.
+ * @details Struct for batched rotation vector event of the Smart Sens Click driver.
+ */
+struct smartsens_fifo_quaternion
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    int16_t w;
+    uint16_t accuracy;
+    uint32_t time_stamp;
+};
+
+/**
+ * @brief Fifo batch.
+ * @details Struct for batch of decoded events of one virtual sensor of the Smart Sens Click driver.
+ */
+struct smartsens_fifo_batch
+{
+    uint8_t sensor_id;
+    enum smartsens_fifo_type fifo_type;
+    uint8_t data_type;
+    uint16_t count;
+    union
+    {
+        struct smartsens_fifo_vector *vector;
+        struct smartsens_fifo_quaternion *quaternion;
+    } data;
+};
+
+/**< Driver batch callback interface. */
+typedef void ( *smartsens_fifo_batch_callback_t )( struct smartsens_fifo_batch *batch, void *batch_ref ); 
+
+/**
+ * @brief Fifo batch slot.
+ * @details Struct for fifo batch storage and callback of the Smart Sens Click driver.
+ */
+struct smartsens_fifo_batch_slot
+{
+    struct smartsens_fifo_batch batch;
+    uint16_t batch_len;
+    smartsens_fifo_batch_callback_t callback;
+    void *callback_ref;
+};
+
 /**
  * @brief Fifo buffer.
  * @details Struct for fifo buffer of the Smart Sens Click driver.
@@ -591,6 +660,8 @@ typedef struct smartsens_s
 
     struct smartsens_fifo_parse_callback_table table[ SMARTSENS_N_VIRTUAL_SENSOR_MAX ];
     uint32_t last_time_stamp[ SMARTSENS_FIFO_TYPE_MAX ];
+    struct smartsens_fifo_batch_slot batch[ SMARTSENS_FIFO_BATCH_MAX ];
+    uint32_t fw_offset;                 /**< Firmware bytes written to flash (upload resume point). */
     
 } smartsens_t;
 
@@ -846,7 +917,10 @@ err_t smartsens_sw_reset ( smartsens_t *ctx );
  * @note If you want to upload firmware to the device Flash you need both 
  * @b SMARTSENS_FLASHIMG and @b SMARTSENS_FLASH to set to 1, but if you 
  * want to use only device RAM both of that macros should be set to 0 and 
- * @b SMARTSENS_RAM should be set to 1.
+ * @b SMARTSENS_RAM should be set to 1. Image is sent in the largest chunks
+ * the selected interface allows and the status is polled with growing
+ * intervals. If flash upload fails, next call resumes it from
+ * the last acknowledged chunk when @b SMARTSENS_FW_RESUME is set.
  */
 err_t smartsens_update_firmware ( smartsens_t *ctx );
 
@@ -943,6 +1017,28 @@ err_t smartsens_get_and_process_fifo ( smartsens_t *ctx, uint8_t *work_buffer, u
 err_t smartsens_register_fifo_parse_callback ( smartsens_t *ctx, uint8_t sensor_id,
                                                smartsens_fifo_parse_callback_t callback, void *callback_ref );
 
+/**
+ * @brief Link a batch callback to virtual sensor.
+ * @details Function to decode events of the virtual sensor directly from the 
+ * FIFO work buffer into typed array and call the callback once per batch. 
+ * Batch is delivered when the array is full and at the end of each FIFO read.
+ * @param[in] sensor_id     : Sensor ID of the virtal sensor
+ * @param[in] data_type     : Batch data type.
+ *                            @li @c 0 - Vector (#smartsens_fifo_vector array),
+ *                            @li @c 1 - Quaternion (#smartsens_fifo_quaternion array).
+ * @param[in] batch_buf     : Typed array for decoded events.
+ * @param[in] batch_len     : Number of array elements.
+ * @param[in] callback      : Reference of the batch callback function. NULL releases the batch.
+ * @param[in] callback_ref  : Reference needed inside the callback function. Can be NULL.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Batched sensor events are not passed to the per event callback.
+ */
+err_t smartsens_register_fifo_batch_callback ( smartsens_t *ctx, uint8_t sensor_id, uint8_t data_type,
+                                               void *batch_buf, uint16_t batch_len,
+                                               smartsens_fifo_batch_callback_t callback, void *callback_ref );
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,17 @@ const unsigned char smartsens_firmware_image[ ] = { 0 };
 #define DUMMY             0x00
 #define SPI_READ_MASK     0x80
 
+/**
+ * @brief Firmware upload settings.
+ * @details Chunk sizes of the firmware upload and adaptive status polling limit.
+ * I2C frames are limited by the 8-bit length, flash write payload by the command
+ * buffer of the device, while SPI RAM upload is streamed directly from the image.
+ */
+#define FW_RAM_CHUNK_I2C  252
+#define FW_RAM_CHUNK_SPI  1024
+#define FW_FLASH_CHUNK    248
+#define FW_POLL_MAX_50US  200
+
 /**
  * @brief Float to uint32.
  * @details Union that converts float to uint32_t.
@@ -241,6 +252,63 @@ static err_t get_buffer_status ( struct smartsens_fifo_buffer *fifo_p, uint8_t e
  */
 static err_t get_time_stamp ( smartsens_t *ctx, enum smartsens_fifo_type source, uint32_t **time_stamp );
 
+/**
+ * @brief Smart Sens firmware chunk writing function.
+ * @details This function writes optional command header followed by firmware
+ * chunk to the command input register. SPI chunk is sent directly from the image,
+ * while I2C chunk is merged with the header into a single frame.
+ * @param[in] ctx : Click context object.
+ * See #smartsens_t object definition for detailed explanation.
+ * @param[in] header : Command header.
+ * @param[in] header_len : Number of header bytes.
+ * @param[in] data_in : Firmware chunk.
+ * @param[in] len : Number of chunk bytes.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t smartsens_fw_write ( smartsens_t *ctx, uint8_t *header, uint8_t header_len, 
+                                  const uint8_t *data_in, uint16_t len );
+
+/**
+ * @brief Smart Sens firmware status waiting function.
+ * @details This function polls selected register until any of the masked bits
+ * is set. Polling interval starts at 50us and doubles up to 10ms.
+ * @param[in] ctx : Click context object.
+ * See #smartsens_t object definition for detailed explanation.
+ * @param[in] reg : Status register address.
+ * @param[in] mask : Status bits to wait for.
+ * @param[in] err_check : Abort on non-zero error value register.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t smartsens_fw_wait ( smartsens_t *ctx, uint8_t reg, uint8_t mask, uint8_t err_check );
+
+/**
+ * @brief Smart Sens batch event decoding function.
+ * @details This function decodes event in place from the FIFO buffer into 
+ * the next element of the batch array and delivers full batch.
+ * @param[in] slot             : Batch slot.
+ * @param[in] source           : Fifo type.
+ * @param[in] event            : Event start (sensor ID) in the FIFO buffer.
+ * @param[in] event_size       : Event size including sensor ID.
+ * @param[in] time_stamp       : Event timestamp.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t smartsens_batch_push ( struct smartsens_fifo_batch_slot *slot, enum smartsens_fifo_type source, 
+                                    uint8_t *event, uint8_t event_size, uint32_t time_stamp );
+
+/**
+ * @brief Smart Sens batch delivering function.
+ * @details This function calls the batch callback if batch holds any event and empties it.
+ * @param[in] slot             : Batch slot.
+ * @return Nothing.
+ */
+static void smartsens_batch_flush ( struct smartsens_fifo_batch_slot *slot );
+
 void smartsens_cfg_setup ( smartsens_cfg_t *cfg ) 
 {
     cfg->scl  = HAL_PIN_NC;
@@ -270,6 +338,8 @@ void smartsens_drv_interface_selection ( smartsens_cfg_t *cfg, smartsens_drv_t d
 err_t smartsens_init ( smartsens_t *ctx, smartsens_cfg_t *cfg ) 
 {
     ctx->drv_sel = cfg->drv_sel;
+    ctx->fw_offset = 0;
+    memset( ctx->batch, 0, sizeof( ctx->batch ) );
 
     if ( SMARTSENS_DRV_SEL_I2C == ctx->drv_sel ) 
     {
@@ -548,132 +618,111 @@ err_t smartsens_sw_reset ( smartsens_t *ctx )
 err_t smartsens_update_firmware ( smartsens_t *ctx )
 {
     err_t ret_val = SMARTSENS_OK;
-    uint32_t step = 240;
-    uint8_t temp[ 0x1FF ] = { 0 };
+    uint32_t image_size = sizeof( smartsens_firmware_image );
     uint32_t cnt = 0;
-    uint32_t remaining = sizeof( smartsens_firmware_image );
-    uint8_t status;
+    uint16_t chunk;
+    uint8_t header[ 8 ] = { 0 };
     
 #if SMARTSENS_FLASH
-        volatile uint32_t start_addr = SMARTSENS_START_FLASH_ADR;        
+    uint16_t cmd;
+    uint16_t cmd_len;
+    uint8_t cmd_buf[ 0xFF ] = { 0 };
+    uint32_t addr;
+#if SMARTSENS_FW_RESUME
+    cnt = ctx->fw_offset;
+#endif
+    if ( cnt >= image_size )
+    {
+        cnt = 0;
+    }
+    
+    if ( !cnt )
+    {
         //ERASE
-        temp[ 0 ] = start_addr;
-        temp[ 1 ] = start_addr >> 8;
-        temp[ 2 ] = start_addr >> 16;
-        temp[ 3 ] = start_addr >> 24;
-        temp[ 4 ] = ( start_addr + remaining );
-        temp[ 5 ] = ( start_addr + remaining ) >> 8;
-        temp[ 6 ] = ( start_addr + remaining ) >> 16;
-        temp[ 7 ] = ( start_addr + remaining ) >> 24;
-        smartsens_cmd_write( ctx, SMARTSENS_CMD_ERASE_FLASH, temp, 8 );
-        
-        do 
-        {
-            smartsens_byte_read( ctx, SMARTSENS_REG_ERROR_VALUE, &status );
-            if ( status )
-            {
-                return status;
-            }
-            smartsens_byte_read( ctx, SMARTSENS_REG_INTERRUPT_STATUS, &status );
-            Delay_10ms( );
-        } while ( !( status & 0x20 ) );
-        volatile uint16_t cmd;
-        volatile uint16_t cmd_len;
-        volatile uint8_t cmd_buf[ 0xFF ] = { 0 };
-        smartsens_status_read( ctx, &cmd, cmd_buf, &cmd_len );
-        if ( 0x000F == cmd )
+        addr = SMARTSENS_START_FLASH_ADR;
+        header[ 0 ] = ( uint8_t ) addr;
+        header[ 1 ] = ( uint8_t ) ( addr >> 8 );
+        header[ 2 ] = ( uint8_t ) ( addr >> 16 );
+        header[ 3 ] = ( uint8_t ) ( addr >> 24 );
+        addr += image_size;
+        header[ 4 ] = ( uint8_t ) addr;
+        header[ 5 ] = ( uint8_t ) ( addr >> 8 );
+        header[ 6 ] = ( uint8_t ) ( addr >> 16 );
+        header[ 7 ] = ( uint8_t ) ( addr >> 24 );
+        if ( smartsens_cmd_write( ctx, SMARTSENS_CMD_ERASE_FLASH, header, 8 ) ||
+             smartsens_fw_wait( ctx, SMARTSENS_REG_INTERRUPT_STATUS, 0x20, 1 ) ||
+             smartsens_status_read( ctx, &cmd, cmd_buf, &cmd_len ) || ( 0x000F == cmd ) )
         {
             return SMARTSENS_ERROR;
         }
         //DONE ERASE
+    }
+    
+    //WRITE FLASH 
+    while ( cnt < image_size )
+    {
+        chunk = FW_FLASH_CHUNK;
+        if ( ( image_size - cnt ) < chunk )
+        {
+            chunk = image_size - cnt;
+        }
         
-        //WRITE FLASH 
-        start_addr = SMARTSENS_START_FLASH_ADR; 
+        addr = SMARTSENS_START_FLASH_ADR + cnt;
+        header[ 0 ] = ( uint8_t ) SMARTSENS_CMD_WRITE_FLASH;
+        header[ 1 ] = ( uint8_t ) ( SMARTSENS_CMD_WRITE_FLASH >> 8 );
+        header[ 2 ] = ( uint8_t ) ( chunk + 4 );
+        header[ 3 ] = ( uint8_t ) ( ( chunk + 4 ) >> 8 );
+        header[ 4 ] = ( uint8_t ) addr;
+        header[ 5 ] = ( uint8_t ) ( addr >> 8 );
+        header[ 6 ] = ( uint8_t ) ( addr >> 16 );
+        header[ 7 ] = ( uint8_t ) ( addr >> 24 );
         
-        do
+        // A chunk lost on the bus is never acknowledged, so the status is not waited for
+        if ( smartsens_fw_write( ctx, header, 8, &smartsens_firmware_image[ cnt ], chunk ) ||
+             smartsens_fw_wait( ctx, SMARTSENS_REG_INTERRUPT_STATUS, 0x20, 0 ) ||
+             smartsens_status_read( ctx, &cmd, cmd_buf, &cmd_len ) || ( 0x000F == cmd ) )
         {
-            volatile uint32_t size;
-            if ( remaining > step )
-            {
-                remaining -= step;
-                size = step + 4;
-            }
-            else
-            {
-                size = remaining + 4;
-                remaining = 0;
-            }
-            
-            temp[ 0 ] = start_addr;
-            temp[ 1 ] = start_addr >> 8;
-            temp[ 2 ] = start_addr >> 16;
-            temp[ 3 ] = start_addr >> 24;
-            memcpy( &temp[ 4 ], &smartsens_firmware_image[ cnt ], size );
-            cnt += size - 4;
-            
-            smartsens_cmd_write( ctx, SMARTSENS_CMD_WRITE_FLASH, temp, size );
-            
-            do 
-            {
-                smartsens_byte_read( ctx, SMARTSENS_REG_INTERRUPT_STATUS, &status );
-                Delay_10ms( );
-            } while ( !( status & 0x20 ) );
-            
-            smartsens_status_read( ctx, &cmd, cmd_buf, &cmd_len );
-            
-            if ( 0x000F == cmd )
-            {
-                ret_val = SMARTSENS_ERROR;
-                break;
-            }
-            
-            start_addr += ( size - 4 );
-            
-        } while ( remaining );
+            return SMARTSENS_ERROR;
+        }
         
+        cnt += chunk;
+        ctx->fw_offset = cnt;
+    }
+    ctx->fw_offset = 0;
+    
 #elif SMARTSENS_RAM
-        
-        uint32_t enc = 0;     
-        uint16_t temp_index = 0;
-        
-        temp[ 0 ] = ( uint8_t )SMARTSENS_CMD_UPLOAD_TO_RAM;
-        temp[ 1 ] = ( uint8_t )( SMARTSENS_CMD_UPLOAD_TO_RAM >> 8 );
-        uint16_t size = sizeof( smartsens_firmware_image ) / 4;
-        temp[ 2 ] = ( uint8_t )size;
-        temp[ 3 ] = ( uint8_t )( size >> 8 );
-        while ( cnt < sizeof( smartsens_firmware_image ) )
+    uint8_t header_len = 4;
+    
+    header[ 0 ] = ( uint8_t ) SMARTSENS_CMD_UPLOAD_TO_RAM;
+    header[ 1 ] = ( uint8_t ) ( SMARTSENS_CMD_UPLOAD_TO_RAM >> 8 );
+    header[ 2 ] = ( uint8_t ) ( image_size / 4 );
+    header[ 3 ] = ( uint8_t ) ( ( image_size / 4 ) >> 8 );
+    
+    while ( cnt < image_size )
+    {
+        if ( SMARTSENS_DRV_SEL_SPI == ctx->drv_sel )
         {
-            if ( !(enc++) )
-            {
-                temp_index = 4;
-            }
-            else
-            {
-                temp_index = 0;
-            }
-
-            while ( 0 != ( cnt % 4 ) )
-            {
-                cnt = ( ( cnt >> 2 ) + 1 ) << 2;
-            }
-            
-            volatile uint32_t limit = step * enc;
-            
-            for ( ; ( cnt < limit ) && ( cnt < sizeof( smartsens_firmware_image ) ); cnt++ )
-            {
-                temp[ temp_index++ ] = smartsens_firmware_image[ cnt ];
-            }
-            
-            smartsens_generic_write( ctx, SMARTSENS_REG_COMMAND_INPUT, temp, temp_index );
+            chunk = FW_RAM_CHUNK_SPI;
         }
-        
-        do
+        else
         {
-            Delay_10ms( );
-            smartsens_byte_read( ctx, SMARTSENS_REG_BOOT_STATUS, &status );
-            
-        } while ( !( status & SMARTSENS_BOOTSTATUS_HOST_FW_VERIFY_DONE ) );
+            chunk = FW_RAM_CHUNK_I2C;
+        }
+        if ( ( image_size - cnt ) < chunk )
+        {
+            chunk = image_size - cnt;
+        }
         
+        if ( smartsens_fw_write( ctx, header, header_len, &smartsens_firmware_image[ cnt ], chunk ) )
+        {
+            return SMARTSENS_ERROR;
+        }
+        header_len = 0;
+        cnt += chunk;
+    }
+    
+    ret_val = smartsens_fw_wait( ctx, SMARTSENS_REG_BOOT_STATUS, SMARTSENS_BOOTSTATUS_HOST_FW_VERIFY_DONE, 0 );
+    
 #endif
     return ret_val;
 }
@@ -704,6 +753,7 @@ err_t smartsens_boot_firmware( smartsens_t *ctx )
         
     if ( status & SMARTSENS_BOOTSTATUS_FLASH_VERIFY_ERROR )
     {     
+        ctx->fw_offset = 0;
         smartsens_reset( ctx );
         smartsens_sw_reset( ctx );
         
@@ -840,7 +890,6 @@ err_t smartsens_get_and_process_fifo( smartsens_t *ctx, uint8_t *work_buffer, ui
         return SMARTSENS_ERROR;
     }
 
-    memset( work_buffer, 0, buffer_size );
     memset( &fifos, 0, sizeof( struct smartsens_fifo_buffer ) );
 
     fifos.buffer = work_buffer;
@@ -945,6 +994,61 @@ err_t smartsens_register_fifo_parse_callback( smartsens_t *ctx, uint8_t sensor_i
     return SMARTSENS_OK;
 }
 
+err_t smartsens_register_fifo_batch_callback ( smartsens_t *ctx, uint8_t sensor_id, uint8_t data_type,
+                                               void *batch_buf, uint16_t batch_len,
+                                               smartsens_fifo_batch_callback_t callback, void *callback_ref )
+{
+    struct smartsens_fifo_batch_slot *slot = NULL;
+    
+    if ( ( NULL == ctx ) || ( 0 == sensor_id ) || ( sensor_id >= SMARTSENS_SPECIAL_SENSOR_ID_OFFSET ) )
+    {
+        return SMARTSENS_ERROR;
+    }
+    
+    if ( ctx->table[ sensor_id ].batch_idx )
+    {
+        slot = &ctx->batch[ ctx->table[ sensor_id ].batch_idx - 1 ];
+    }
+    
+    if ( NULL == callback )
+    {
+        if ( NULL != slot )
+        {
+            memset( slot, 0, sizeof( struct smartsens_fifo_batch_slot ) );
+            ctx->table[ sensor_id ].batch_idx = 0;
+        }
+        return SMARTSENS_OK;
+    }
+    
+    if ( ( NULL == batch_buf ) || ( 0 == batch_len ) || ( data_type > SMARTSENS_FIFO_BATCH_QUATERNION ) )
+    {
+        return SMARTSENS_ERROR;
+    }
+    
+    for ( uint8_t cnt = 0; ( NULL == slot ) && ( cnt < SMARTSENS_FIFO_BATCH_MAX ); cnt++ )
+    {
+        if ( NULL == ctx->batch[ cnt ].callback )
+        {
+            slot = &ctx->batch[ cnt ];
+            ctx->table[ sensor_id ].batch_idx = cnt + 1;
+        }
+    }
+    if ( NULL == slot )
+    {
+        return SMARTSENS_ERROR;
+    }
+    
+    slot->batch.sensor_id = sensor_id;
+    slot->batch.data_type = data_type;
+    slot->batch.count = 0;
+    slot->batch.data.vector = ( struct smartsens_fifo_vector * ) batch_buf;
+    slot->batch_len = batch_len;
+    slot->callback = callback;
+    slot->callback_ref = callback_ref;
+    
+    return SMARTSENS_OK;
+}
+
 static err_t smartsens_i2c_write ( smartsens_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) 
 {
     uint8_t tx_buf[ 257 ] = { 0 };
@@ -991,6 +1095,74 @@ static err_t smartsens_spi_read ( smartsens_t *ctx, uint8_t reg, uint8_t *data_o
     return error_flag;
 }
 
+static err_t smartsens_fw_write ( smartsens_t *ctx, uint8_t *header, uint8_t header_len, 
+                                  const uint8_t *data_in, uint16_t len )
+{
+    uint8_t reg = SMARTSENS_REG_COMMAND_INPUT;
+    err_t error_flag = SMARTSENS_OK;
+    
+    if ( SMARTSENS_DRV_SEL_SPI == ctx->drv_sel )
+    {
+        spi_master_select_device( ctx->chip_select );
+        error_flag |= spi_master_write( &ctx->spi, &reg, 1 );
+        if ( header_len )
+        {
+            error_flag |= spi_master_write( &ctx->spi, header, header_len );
+        }
+        error_flag |= spi_master_write( &ctx->spi, ( uint8_t * ) data_in, len );
+        spi_master_deselect_device( ctx->chip_select );
+    }
+    else
+    {
+        uint8_t tx_buf[ 257 ];
+        
+        if ( ( header_len + len ) > 256 )
+        {
+            return SMARTSENS_ERROR;
+        }
+        tx_buf[ 0 ] = reg;
+        memcpy( &tx_buf[ 1 ], header, header_len );
+        memcpy( &tx_buf[ header_len + 1 ], data_in, len );
+        error_flag = i2c_master_write( &ctx->i2c, tx_buf, header_len + len + 1 );
+    }
+    
+    return error_flag;
+}
+
+static err_t smartsens_fw_wait ( smartsens_t *ctx, uint8_t reg, uint8_t mask, uint8_t err_check )
+{
+    uint16_t interval = 1;
+    uint8_t status = 0;
+    
+    for ( ; ; )
+    {
+        if ( err_check )
+        {
+            if ( smartsens_byte_read( ctx, SMARTSENS_REG_ERROR_VALUE, &status ) || status )
+            {
+                return SMARTSENS_ERROR;
+            }
+        }
+        if ( smartsens_byte_read( ctx, reg, &status ) )
+        {
+            return SMARTSENS_ERROR;
+        }
+        if ( status & mask )
+        {
+            return SMARTSENS_OK;
+        }
+        for ( uint16_t cnt = 0; cnt < interval; cnt++ )
+        {
+            Delay_50us( );
+        }
+        interval <<= 1;
+        if ( interval > FW_POLL_MAX_50US )
+        {
+            interval = FW_POLL_MAX_50US;
+        }
+    }
+}
+
 static err_t smartsens_hif_get_sensor_info ( smartsens_t *ctx, uint8_t sensor_id, 
                                               struct smartsens_sensor_info *info )
 {
@@ -1128,18 +1300,20 @@ static err_t parse_fifo ( smartsens_t *ctx, enum smartsens_fifo_type source, str
     struct smartsens_fifo_parse_data_info data_info;
     uint32_t *time_stamp;
     struct smartsens_fifo_parse_callback_table info;
+    struct smartsens_fifo_parse_callback_table *entry;
     buffer_status_t status = SMARTSENS_BUFFER_STATUS_OK;
 
+    rslt = get_time_stamp( ctx, source, &time_stamp );
+    if ( SMARTSENS_OK != rslt )
+    {
+        return rslt;
+    }
+
     for ( ; ( fifo_p->read_pos < fifo_p->read_length ) && ( SMARTSENS_BUFFER_STATUS_OK == status ); )
     {
         tmp_read_pos = fifo_p->read_pos;
         tmp_sensor_id = fifo_p->buffer[tmp_read_pos];
 
-        rslt = get_time_stamp( ctx, source, &time_stamp );
-        if ( SMARTSENS_OK != rslt )
-        {
-            return rslt;
-        }
         switch ( tmp_sensor_id )
         {
             case SMARTSENS_SYS_ID_FILLER:
@@ -1190,6 +1364,25 @@ static err_t parse_fifo ( smartsens_t *ctx, enum smartsens_fifo_type source, str
                 break;
             default:
 
+                entry = &ctx->table[ tmp_sensor_id ];
+                if ( entry->batch_idx && entry->event_size )
+                {
+                    /* Batched events are decoded in place, without per event dispatch */
+                    if ( ( tmp_read_pos + entry->event_size ) > fifo_p->read_length )
+                    {
+                        status = SMARTSENS_BUFFER_STATUS_RELOAD;
+                        break;
+                    }
+                    rslt = smartsens_batch_push( &ctx->batch[ entry->batch_idx - 1 ], source, 
+                                                 &fifo_p->buffer[ tmp_read_pos ], entry->event_size, *time_stamp );
+                    if ( SMARTSENS_OK != rslt )
+                    {
+                        return rslt;
+                    }
+                    fifo_p->read_pos += entry->event_size;
+                    break;
+                }
+
                 rslt = get_callback_info( ctx, tmp_sensor_id, &info );
 
                 if ( SMARTSENS_OK != rslt )
@@ -1219,6 +1412,10 @@ static err_t parse_fifo ( smartsens_t *ctx, enum smartsens_fifo_type source, str
                 break;
         }
     }
+    for ( uint8_t cnt = 0; cnt < SMARTSENS_FIFO_BATCH_MAX; cnt++ )
+    {
+        smartsens_batch_flush( &ctx->batch[ cnt ] );
+    }
     if ( fifo_p->read_length )
     {
         if ( fifo_p->read_length < fifo_p->read_pos )
@@ -1295,4 +1492,54 @@ static err_t get_time_stamp ( smartsens_t *ctx, enum smartsens_fifo_type source,
     return rslt;
 }
 
+static err_t smartsens_batch_push ( struct smartsens_fifo_batch_slot *slot, enum smartsens_fifo_type source, 
+                                    uint8_t *event, uint8_t event_size, uint32_t time_stamp )
+{
+    struct smartsens_fifo_batch *batch = &slot->batch;
+    
+    /* Payload starts after sensor ID */
+    if ( SMARTSENS_FIFO_BATCH_QUATERNION == batch->data_type )
+    {
+        if ( event_size < 11 )
+        {
+            return SMARTSENS_ERROR;
+        }
+        struct smartsens_fifo_quaternion *quat = &batch->data.quaternion[ batch->count ];
+        quat->x = SMARTSENS_LE2S16( event + 1 );
+        quat->y = SMARTSENS_LE2S16( event + 3 );
+        quat->z = SMARTSENS_LE2S16( event + 5 );
+        quat->w = SMARTSENS_LE2S16( event + 7 );
+        quat->accuracy = SMARTSENS_LE2U16( event + 9 );
+        quat->time_stamp = time_stamp;
+    }
+    else
+    {
+        if ( event_size < 7 )
+        {
+            return SMARTSENS_ERROR;
+        }
+        struct smartsens_fifo_vector *vect = &batch->data.vector[ batch->count ];
+        vect->x = SMARTSENS_LE2S16( event + 1 );
+        vect->y = SMARTSENS_LE2S16( event + 3 );
+        vect->z = SMARTSENS_LE2S16( event + 5 );
+        vect->time_stamp = time_stamp;
+    }
+    batch->fifo_type = source;
+    
+    if ( ++batch->count >= slot->batch_len )
+    {
+        smartsens_batch_flush( slot );
+    }
+    return SMARTSENS_OK;
+}
+
+static void smartsens_batch_flush ( struct smartsens_fifo_batch_slot *slot )
+{
+    if ( slot->batch.count && ( NULL != slot->callback ) )
+    {
+        slot->callback( &slot->batch, slot->callback_ref );
+    }
+    slot->batch.count = 0;
+}
+
 // ------------------------------------------------------------------------ END
@@ -78,11 +78,13 @@ extern "C"{
  * because it needs to be booted every time on the start of the application.
  * When Flash selector is slected and you already have flash image in your
  * devices flash you can disable flash image slector because you don't need
- * to include it in your project.
+ * to include it in your project. With @b SMARTSENS2_FW_RESUME set, flash upload
+ * that was interrupted by a transfer error continues from the last written chunk.
  */
 #define SMARTSENS2_FLASHIMG                                     0   /*< Firmware image for flash include */
 #define SMARTSENS2_FLASH                                        1   /*< Boot firmware from flash */
 #define SMARTSENS2_RAM                                          0   /*< Upload and boot firmware from RAM */
+#define SMARTSENS2_FW_RESUME                                    1   /*< Resume interrupted flash upload */
 
 /**
  * @brief Smart Sens 2 description register.
@@ -399,7 +401,7 @@ extern "C"{
                                                                   ( uint32_t )( x )[ 2 ] << 16 | \
                                                                   ( uint32_t )( x )[ 3 ] << 24 ) )
 #define SMARTSENS2_LE2S32( x )                                  ( ( int32_t )SMARTSENS2_LE2U32( x ) )
-#define SMARTSENS2_LE2U40( x )                                  ( SMARTSENS2_LE2U32( x ) | ( uint32_t )( x )[ 4 ] << 32 )
+#define SMARTSENS2_LE2U40( x )                                  ( ( uint64_t )SMARTSENS2_LE2U32( x ) | ( uint64_t )( x )[ 4 ] << 32 )
 #define SMARTSENS2_TIMESTAMP_TO_SEC( x )                        ( ( uint32_t ) ( x * ( 15625.0 / UINT32_C( 1000000000 ) ) ) )
 
 /**
@@ -591,6 +593,7 @@ typedef struct smartsens2_s
 
     struct smartsens2_fifo_parse_callback_table table[ SMARTSENS2_N_VIRTUAL_SENSOR_MAX ];
     uint32_t last_time_stamp[ SMARTSENS2_FIFO_TYPE_MAX ];
+    uint32_t fw_offset;                 /**< Firmware bytes written to flash (upload resume point). */
     
 } smartsens2_t;
 
@@ -846,7 +849,10 @@ err_t smartsens2_sw_reset ( smartsens2_t *ctx );
  * @note If you want to upload firmware to the device Flash you need both 
  * @b SMARTSENS2_FLASHIMG and @b SMARTSENS2_FLASH to set to 1, but if you 
  * want to use only device RAM both of that macros should be set to 0 and 
- * @b SMARTSENS2_RAM should be set to 1.
+ * @b SMARTSENS2_RAM should be set to 1. Image is sent in the largest chunks
+ * the selected interface allows and the status is polled with growing
+ * intervals. If flash upload fails, next call resumes it from
+ * the last acknowledged chunk when @b SMARTSENS2_FW_RESUME is set.
  */
 err_t smartsens2_update_firmware ( smartsens2_t *ctx );
 
@@ -44,6 +44,17 @@ const unsigned char smartsens2_firmware_image[ ] = { 0 };
 #define DUMMY             0x00
 #define SPI_READ_MASK     0x80
 
+/**
+ * @brief Firmware upload settings.
+ * @details Chunk sizes of the firmware upload and adaptive status polling limit.
+ * I2C frames are limited by the 8-bit length, flash write payload by the command
+ * buffer of the device, while SPI RAM upload is streamed directly from the image.
+ */
+#define FW_RAM_CHUNK_I2C  252
+#define FW_RAM_CHUNK_SPI  1024
+#define FW_FLASH_CHUNK    248
+#define FW_POLL_MAX_50US  200
+
 /**
  * @brief Float to uint32.
  * @details Union that converts float to uint32_t.
@@ -241,6 +252,39 @@ static err_t get_buffer_status ( struct smartsens2_fifo_buffer *fifo_p, uint8_t
  */
 static err_t get_time_stamp ( smartsens2_t *ctx, enum smartsens2_fifo_type source, uint32_t **time_stamp );
 
+/**
+ * @brief Smart Sens 2 firmware chunk writing function.
+ * @details This function writes optional command header followed by firmware
+ * chunk to the command input register. SPI chunk is sent directly from the image,
+ * while I2C chunk is merged with the header into a single frame.
+ * @param[in] ctx : Click context object.
+ * See #smartsens2_t object definition for detailed explanation.
+ * @param[in] header : Command header.
+ * @param[in] header_len : Number of header bytes.
+ * @param[in] data_in : Firmware chunk.
+ * @param[in] len : Number of chunk bytes.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t smartsens2_fw_write ( smartsens2_t *ctx, uint8_t *header, uint8_t header_len, 
+                                   const uint8_t *data_in, uint16_t len );
+
+/**
+ * @brief Smart Sens 2 firmware status waiting function.
+ * @details This function polls selected register until any of the masked bits
+ * is set. Polling interval starts at 50us and doubles up to 10ms.
+ * @param[in] ctx : Click context object.
+ * See #smartsens2_t object definition for detailed explanation.
+ * @param[in] reg : Status register address.
+ * @param[in] mask : Status bits to wait for.
+ * @param[in] err_check : Abort on non-zero error value register.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t smartsens2_fw_wait ( smartsens2_t *ctx, uint8_t reg, uint8_t mask, uint8_t err_check );
+
 void smartsens2_cfg_setup ( smartsens2_cfg_t *cfg ) 
 {
     cfg->scl  = HAL_PIN_NC;
@@ -270,6 +314,7 @@ void smartsens2_drv_interface_selection ( smartsens2_cfg_t *cfg, smartsens2_drv_
 err_t smartsens2_init ( smartsens2_t *ctx, smartsens2_cfg_t *cfg ) 
 {
     ctx->drv_sel = cfg->drv_sel;
+    ctx->fw_offset = 0;
 
     if ( SMARTSENS2_DRV_SEL_I2C == ctx->drv_sel ) 
     {
@@ -548,132 +593,111 @@ err_t smartsens2_sw_reset ( smartsens2_t *ctx )
 err_t smartsens2_update_firmware ( smartsens2_t *ctx )
 {
     err_t ret_val = SMARTSENS2_OK;
-    uint32_t step = 240;
-    uint8_t temp[ 0x1FF ] = { 0 };
+    uint32_t image_size = sizeof( smartsens2_firmware_image );
     uint32_t cnt = 0;
-    uint32_t remaining = sizeof( smartsens2_firmware_image );
-    uint8_t status;
+    uint16_t chunk;
+    uint8_t header[ 8 ] = { 0 };
     
 #if SMARTSENS2_FLASH
-        volatile uint32_t start_addr = SMARTSENS2_START_FLASH_ADR;        
+    uint16_t cmd;
+    uint16_t cmd_len;
+    uint8_t cmd_buf[ 0xFF ] = { 0 };
+    uint32_t addr;
+#if SMARTSENS2_FW_RESUME
+    cnt = ctx->fw_offset;
+#endif
+    if ( cnt >= image_size )
+    {
+        cnt = 0;
+    }
+    
+    if ( !cnt )
+    {
         //ERASE
-        temp[ 0 ] = start_addr;
-        temp[ 1 ] = start_addr >> 8;
-        temp[ 2 ] = start_addr >> 16;
-        temp[ 3 ] = start_addr >> 24;
-        temp[ 4 ] = ( start_addr + remaining );
-        temp[ 5 ] = ( start_addr + remaining ) >> 8;
-        temp[ 6 ] = ( start_addr + remaining ) >> 16;
-        temp[ 7 ] = ( start_addr + remaining ) >> 24;
-        smartsens2_cmd_write( ctx, SMARTSENS2_CMD_ERASE_FLASH, temp, 8 );
-        
-        do 
-        {
-            smartsens2_byte_read( ctx, SMARTSENS2_REG_ERROR_VALUE, &status );
-            if ( status )
-            {
-                return status;
-            }
-            smartsens2_byte_read( ctx, SMARTSENS2_REG_INTERRUPT_STATUS, &status );
-            Delay_10ms( );
-        } while ( !( status & 0x20 ) );
-        volatile uint16_t cmd;
-        volatile uint16_t cmd_len;
-        volatile uint8_t cmd_buf[ 0xFF ] = { 0 };
-        smartsens2_status_read( ctx, &cmd, cmd_buf, &cmd_len );
-        if ( 0x000F == cmd )
+        addr = SMARTSENS2_START_FLASH_ADR;
+        header[ 0 ] = ( uint8_t ) addr;
+        header[ 1 ] = ( uint8_t ) ( addr >> 8 );
+        header[ 2 ] = ( uint8_t ) ( addr >> 16 );
+        header[ 3 ] = ( uint8_t ) ( addr >> 24 );
+        addr += image_size;
+        header[ 4 ] = ( uint8_t ) addr;
+        header[ 5 ] = ( uint8_t ) ( addr >> 8 );
+        header[ 6 ] = ( uint8_t ) ( addr >> 16 );
+        header[ 7 ] = ( uint8_t ) ( addr >> 24 );
+        if ( smartsens2_cmd_write( ctx, SMARTSENS2_CMD_ERASE_FLASH, header, 8 ) ||
+             smartsens2_fw_wait( ctx, SMARTSENS2_REG_INTERRUPT_STATUS, 0x20, 1 ) ||
+             smartsens2_status_read( ctx, &cmd, cmd_buf, &cmd_len ) || ( 0x000F == cmd ) )
         {
             return SMARTSENS2_ERROR;
         }
         //DONE ERASE
+    }
+    
+    //WRITE FLASH 
+    while ( cnt < image_size )
+    {
+        chunk = FW_FLASH_CHUNK;
+        if ( ( image_size - cnt ) < chunk )
+        {
+            chunk = image_size - cnt;
+        }
         
-        //WRITE FLASH 
-        start_addr = SMARTSENS2_START_FLASH_ADR; 
+        addr = SMARTSENS2_START_FLASH_ADR + cnt;
+        header[ 0 ] = ( uint8_t ) SMARTSENS2_CMD_WRITE_FLASH;
+        header[ 1 ] = ( uint8_t ) ( SMARTSENS2_CMD_WRITE_FLASH >> 8 );
+        header[ 2 ] = ( uint8_t ) ( chunk + 4 );
+        header[ 3 ] = ( uint8_t ) ( ( chunk + 4 ) >> 8 );
+        header[ 4 ] = ( uint8_t ) addr;
+        header[ 5 ] = ( uint8_t ) ( addr >> 8 );
+        header[ 6 ] = ( uint8_t ) ( addr >> 16 );
+        header[ 7 ] = ( uint8_t ) ( addr >> 24 );
         
-        do
+        // A chunk lost on the bus is never acknowledged, so the status is not waited for
+        if ( smartsens2_fw_write( ctx, header, 8, &smartsens2_firmware_image[ cnt ], chunk ) ||
+             smartsens2_fw_wait( ctx, SMARTSENS2_REG_INTERRUPT_STATUS, 0x20, 0 ) ||
+             smartsens2_status_read( ctx, &cmd, cmd_buf, &cmd_len ) || ( 0x000F == cmd ) )
         {
-            volatile uint32_t size;
-            if ( remaining > step )
-            {
-                remaining -= step;
-                size = step + 4;
-            }
-            else
-            {
-                size = remaining + 4;
-                remaining = 0;
-            }
-            
-            temp[ 0 ] = start_addr;
-            temp[ 1 ] = start_addr >> 8;
-            temp[ 2 ] = start_addr >> 16;
-            temp[ 3 ] = start_addr >> 24;
-            memcpy( &temp[ 4 ], &smartsens2_firmware_image[ cnt ], size );
-            cnt += size - 4;
-            
-            smartsens2_cmd_write( ctx, SMARTSENS2_CMD_WRITE_FLASH, temp, size );
-            
-            do 
-            {
-                smartsens2_byte_read( ctx, SMARTSENS2_REG_INTERRUPT_STATUS, &status );
-                Delay_10ms( );
-            } while ( !( status & 0x20 ) );
-            
-            smartsens2_status_read( ctx, &cmd, cmd_buf, &cmd_len );
-            
-            if ( 0x000F == cmd )
-            {
-                ret_val = SMARTSENS2_ERROR;
-                break;
-            }
-            
-            start_addr += ( size - 4 );
-            
-        } while ( remaining );
+            return SMARTSENS2_ERROR;
+        }
         
+        cnt += chunk;
+        ctx->fw_offset = cnt;
+    }
+    ctx->fw_offset = 0;
+    
 #elif SMARTSENS2_RAM
-        
-        uint32_t enc = 0;     
-        uint16_t temp_index = 0;
-        
-        temp[ 0 ] = ( uint8_t )SMARTSENS2_CMD_UPLOAD_TO_RAM;
-        temp[ 1 ] = ( uint8_t )( SMARTSENS2_CMD_UPLOAD_TO_RAM >> 8 );
-        uint16_t size = sizeof( smartsens2_firmware_image ) / 4;
-        temp[ 2 ] = ( uint8_t )size;
-        temp[ 3 ] = ( uint8_t )( size >> 8 );
-        while ( cnt < sizeof( smartsens2_firmware_image ) )
+    uint8_t header_len = 4;
+    
+    header[ 0 ] = ( uint8_t ) SMARTSENS2_CMD_UPLOAD_TO_RAM;
+    header[ 1 ] = ( uint8_t ) ( SMARTSENS2_CMD_UPLOAD_TO_RAM >> 8 );
+    header[ 2 ] = ( uint8_t ) ( image_size / 4 );
+    header[ 3 ] = ( uint8_t ) ( ( image_size / 4 ) >> 8 );
+    
+    while ( cnt < image_size )
+    {
+        if ( SMARTSENS2_DRV_SEL_SPI == ctx->drv_sel )
         {
-            if ( !(enc++) )
-            {
-                temp_index = 4;
-            }
-            else
-            {
-                temp_index = 0;
-            }
-
-            while ( 0 != ( cnt % 4 ) )
-            {
-                cnt = ( ( cnt >> 2 ) + 1 ) << 2;
-            }
-            
-            volatile uint32_t limit = step * enc;
-            
-            for ( ; ( cnt < limit ) && ( cnt < sizeof( smartsens2_firmware_image ) ); cnt++ )
-            {
-                temp[ temp_index++ ] = smartsens2_firmware_image[ cnt ];
-            }
-            
-            smartsens2_generic_write( ctx, SMARTSENS2_REG_COMMAND_INPUT, temp, temp_index );
+            chunk = FW_RAM_CHUNK_SPI;
         }
-        
-        do
+        else
         {
-            Delay_10ms( );
-            smartsens2_byte_read( ctx, SMARTSENS2_REG_BOOT_STATUS, &status );
-            
-        } while ( !( status & SMARTSENS2_BOOTSTATUS_HOST_FW_VERIFY_DONE ) );
+            chunk = FW_RAM_CHUNK_I2C;
+        }
+        if ( ( image_size - cnt ) < chunk )
+        {
+            chunk = image_size - cnt;
+        }
         
+        if ( smartsens2_fw_write( ctx, header, header_len, &smartsens2_firmware_image[ cnt ], chunk ) )
+        {
+            return SMARTSENS2_ERROR;
+        }
+        header_len = 0;
+        cnt += chunk;
+    }
+    
+    ret_val = smartsens2_fw_wait( ctx, SMARTSENS2_REG_BOOT_STATUS, SMARTSENS2_BOOTSTATUS_HOST_FW_VERIFY_DONE, 0 );
+    
 #endif
     return ret_val;
 }
@@ -704,6 +728,7 @@ err_t smartsens2_boot_firmware( smartsens2_t *ctx )
         
     if ( status & SMARTSENS2_BOOTSTATUS_FLASH_VERIFY_ERROR )
     {     
+        ctx->fw_offset = 0;
         smartsens2_reset( ctx );
         smartsens2_sw_reset( ctx );
         
@@ -991,6 +1016,74 @@ static err_t smartsens2_spi_read ( smartsens2_t *ctx, uint8_t reg, uint8_t *data
     return error_flag;
 }
 
+static err_t smartsens2_fw_write ( smartsens2_t *ctx, uint8_t *header, uint8_t header_len, 
+                                   const uint8_t *data_in, uint16_t len )
+{
+    uint8_t reg = SMARTSENS2_REG_COMMAND_INPUT;
+    err_t error_flag = SMARTSENS2_OK;
+    
+    if ( SMARTSENS2_DRV_SEL_SPI == ctx->drv_sel )
+    {
+        spi_master_select_device( ctx->chip_select );
+        error_flag |= spi_master_write( &ctx->spi, &reg, 1 );
+        if ( header_len )
+        {
+            error_flag |= spi_master_write( &ctx->spi, header, header_len );
+        }
+        error_flag |= spi_master_write( &ctx->spi, ( uint8_t * ) data_in, len );
+        spi_master_deselect_device( ctx->chip_select );
+    }
+    else
+    {
+        uint8_t tx_buf[ 257 ];
+        
+        if ( ( header_len + len ) > 256 )
+        {
+            return SMARTSENS2_ERROR;
+        }
+        tx_buf[ 0 ] = reg;
+        memcpy( &tx_buf[ 1 ], header, header_len );
+        memcpy( &tx_buf[ header_len + 1 ], data_in, len );
+        error_flag = i2c_master_write( &ctx->i2c, tx_buf, header_len + len + 1 );
+    }
+    
+    return error_flag;
+}
+
+static err_t smartsens2_fw_wait ( smartsens2_t *ctx, uint8_t reg, uint8_t mask, uint8_t err_check )
+{
+    uint16_t interval = 1;
+    uint8_t status = 0;
+    
+    for ( ; ; )
+    {
+        if ( err_check )
+        {
+            if ( smartsens2_byte_read( ctx, SMARTSENS2_REG_ERROR_VALUE, &status ) || status )
+            {
+                return SMARTSENS2_ERROR;
+            }
+        }
+        if ( smartsens2_byte_read( ctx, reg, &status ) )
+        {
+            return SMARTSENS2_ERROR;
+        }
+        if ( status & mask )
+        {
+            return SMARTSENS2_OK;
+        }
+        for ( uint16_t cnt = 0; cnt < interval; cnt++ )
+        {
+            Delay_50us( );
+        }
+        interval <<= 1;
+        if ( interval > FW_POLL_MAX_50US )
+        {
+            interval = FW_POLL_MAX_50US;
+        }
+    }
+}
+
 static err_t smartsens2_hif_get_sensor_info ( smartsens2_t *ctx, uint8_t sensor_id, 
                                               struct smartsens2_sensor_info *info )
 {
@@ -127,6 +127,8 @@ extern "C"{
 #define SQIFLASH_START_PAGE_ADDRESS     0x010000ul
 #define SQIFLASH_END_PAGE_ADDRESS       0x7FFFFFul
 #define SQIFLASH_FLASH_PAGE_SIZE        256
+#define SQIFLASH_PAGE_PROGRAM_TIMEOUT_MS  5
+#define SQIFLASH_ERASE_TIMEOUT_MS       1000
 
 /**
  * @brief Data sample selection.
@@ -620,6 +622,7 @@ void sqiflash_highspeed_r_read ( sqiflash_t *ctx, uint32_t address, uint8_t *buf
  * @param[in] buffer : Buffer with data to write.
  * @param[in] data_count : Amount of bytes to write.
  * @return Nothing.
+ * @note Use @c sqiflash_quad_write_pages to get the timeout status.
  */
 void sqiflash_quad_write ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count );
 
@@ -637,9 +640,77 @@ void sqiflash_quad_write ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, u
  * @param[in] buffer : Buffer with data to write.
  * @param[in] data_count : Amount of bytes to write.
  * @return Nothing.
+ * @note A write started while an erase is in progress waits for it up to
+ * SQIFLASH_ERASE_TIMEOUT_MS. Use @c sqiflash_write_pages to get the timeout status.
  */
 void sqiflash_write_generic ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count );
 
+/**
+ * @brief SQI FLASH Wait Ready.
+ * @details This function polls the BUSY bit of the Status register every 100 us
+ * until the current internal Write operation finishes or the timeout expires.
+ * @param[in] ctx : Click context object.
+ * See #sqiflash_t object definition for detailed explanation.
+ * @param[in] timeout_ms : Maximum time to wait in milliseconds.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t sqiflash_wait_ready ( sqiflash_t *ctx, uint16_t timeout_ms );
+
+/**
+ * @brief SQI FLASH Page Program Start.
+ * @details This function enables writes and issues a single Page-Program instruction,
+ * then returns without waiting for the program cycle to finish. The caller may prepare
+ * the next page while the device is busy and then call @c sqiflash_wait_ready
+ * before starting the next page.
+ * @param[in] ctx : Click context object.
+ * See #sqiflash_t object definition for detailed explanation.
+ * @param[in] address : Address to start write at.
+ * @param[in] buffer : Buffer with data to write.
+ * @param[in] data_count : Amount of bytes to write, must not cross a page boundary.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t sqiflash_page_program_start ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint16_t data_count );
+
+/**
+ * @brief SQI FLASH Write Pages.
+ * @details This function writes any amount of data by splitting it on page boundaries
+ * and issuing Write-Enable and Page-Program for every page. A pending erase is waited
+ * for up to SQIFLASH_ERASE_TIMEOUT_MS before the first page, and each program cycle up to
+ * SQIFLASH_PAGE_PROGRAM_TIMEOUT_MS while the next page is set up.
+ * @param[in] ctx : Click context object.
+ * See #sqiflash_t object definition for detailed explanation.
+ * @param[in] address : Address to start write at.
+ * @param[in] buffer : Buffer with data to write.
+ * @param[in] data_count : Amount of bytes to write.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The data for the selected pages must be in the erased state (FFH).
+ */
+err_t sqiflash_write_pages ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count );
+
+/**
+ * @brief SQI FLASH Quad Write Pages.
+ * @details This function is the same as @c sqiflash_write_pages, using the SPI Quad
+ * Page-Program instruction for every page.
+ * @param[in] ctx : Click context object.
+ * See #sqiflash_t object definition for detailed explanation.
+ * @param[in] address : Address to start write at.
+ * @param[in] buffer : Buffer with data to write.
+ * @param[in] data_count : Amount of bytes to write.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The data for the selected pages must be in the erased state (FFH).
+ */
+err_t sqiflash_quad_write_pages ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count );
+
 /**
  * @brief SQI FLASH Quad Enable. 
  * @details The Enable Quad I/O (EQIO) instruction, 38H, enables
@@ -65,6 +65,13 @@ void sqiflash_read( sqiflash_t *ctx, uint8_t *buffer, uint16_t count );
  */
 void sqiflash_write_address( sqiflash_t *ctx, uint32_t address );
 
+/**
+ * @brief SQI FLASH program pages.
+ * @details This function programs data page by page using the selected program instruction.
+ */
+static err_t sqiflash_program_pages ( sqiflash_t *ctx, uint8_t instr, uint32_t address, 
+                                      uint8_t *buffer, uint32_t data_count );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void sqiflash_cfg_setup ( sqiflash_cfg_t *cfg ) 
@@ -425,72 +432,54 @@ void sqiflash_highspeed_r_read( sqiflash_t *ctx, uint32_t address, uint8_t *buff
 
 void sqiflash_quad_write ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count ) 
 {
-    uint8_t cnt = 0;
-    uint8_t repeat = 0;
-    uint8_t repeat_over = 0;
-    
-    while ( sqiflash_busy( ctx ) );
+    sqiflash_program_pages( ctx, SQIFLASH_INSTR_SPI_QUAD, address, buffer, data_count );
+}
 
-    sqiflash_write_enable( ctx );
-    spi_master_select_device( ctx->chip_select );
-    sqiflash_command( ctx, SQIFLASH_INSTR_SPI_QUAD );
-    
-    if ( data_count <= SQIFLASH_FLASH_PAGE_SIZE ) 
-    {
-        sqiflash_write_address( ctx, address );
-        sqiflash_write( ctx, buffer, data_count );
-    } 
-    else 
+void sqiflash_write_generic ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count ) 
+{
+    sqiflash_program_pages( ctx, SQIFLASH_INSTR_PP, address, buffer, data_count );
+}
+
+err_t sqiflash_wait_ready ( sqiflash_t *ctx, uint16_t timeout_ms ) 
+{
+    uint32_t poll_cnt = ( uint32_t ) timeout_ms * 10;
+
+    while ( sqiflash_busy( ctx ) )
     {
-        repeat = data_count / SQIFLASH_FLASH_PAGE_SIZE;
-        repeat_over = data_count % SQIFLASH_FLASH_PAGE_SIZE;
-        for ( cnt = 0; cnt < repeat; cnt++ ) 
-        {
-            sqiflash_write_address( ctx, address + ( cnt * SQIFLASH_FLASH_PAGE_SIZE ) );
-            sqiflash_write( ctx,  buffer + ( cnt * SQIFLASH_FLASH_PAGE_SIZE ), SQIFLASH_FLASH_PAGE_SIZE );
-        }
-        if ( repeat_over ) 
+        if ( !poll_cnt-- )
         {
-            sqiflash_write_address( ctx, address + ( repeat * SQIFLASH_FLASH_PAGE_SIZE ) );
-            sqiflash_write( ctx, buffer + ( repeat * SQIFLASH_FLASH_PAGE_SIZE ), repeat_over );
+            return SQIFLASH_ERROR;
         }
+        Delay_100us( );
     }
-    spi_master_deselect_device( ctx->chip_select );  
+    return SQIFLASH_OK;
 }
 
-void sqiflash_write_generic ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count ) 
+err_t sqiflash_page_program_start ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint16_t data_count ) 
 {
-    uint8_t cnt = 0;
-    uint8_t repeat = 0;
-    uint8_t repeat_over = 0;
-    
-    while ( sqiflash_busy( ctx ) );
+    if ( ( 0 == data_count ) ||
+         ( ( ( address % SQIFLASH_FLASH_PAGE_SIZE ) + data_count ) > SQIFLASH_FLASH_PAGE_SIZE ) )
+    {
+        return SQIFLASH_ERROR;
+    }
 
     sqiflash_write_enable( ctx );
     spi_master_select_device( ctx->chip_select );
     sqiflash_command( ctx, SQIFLASH_INSTR_PP );
-    
-    if ( data_count <= SQIFLASH_FLASH_PAGE_SIZE ) 
-    {
-        sqiflash_write_address( ctx, address );
-        sqiflash_write( ctx, buffer, data_count );
-    }
-    else 
-    {
-        repeat = data_count / SQIFLASH_FLASH_PAGE_SIZE;
-        repeat_over = data_count % SQIFLASH_FLASH_PAGE_SIZE;
-        for ( cnt = 0; cnt < repeat; cnt++ ) 
-        {
-            sqiflash_write_address( ctx, address + ( cnt * SQIFLASH_FLASH_PAGE_SIZE ) );
-            sqiflash_write( ctx, buffer + ( cnt * SQIFLASH_FLASH_PAGE_SIZE ), SQIFLASH_FLASH_PAGE_SIZE );
-        }
-        if ( repeat_over ) 
-        {
-            sqiflash_write_address( ctx, address + ( repeat * SQIFLASH_FLASH_PAGE_SIZE ) );
-            sqiflash_write( ctx, buffer + ( repeat * SQIFLASH_FLASH_PAGE_SIZE ), repeat_over );
-        }
-    }
-    spi_master_deselect_device( ctx->chip_select );  
+    sqiflash_write_address( ctx, address );
+    sqiflash_write( ctx, buffer, data_count );
+    spi_master_deselect_device( ctx->chip_select );
+    return SQIFLASH_OK;
+}
+
+err_t sqiflash_write_pages ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count ) 
+{
+    return sqiflash_program_pages( ctx, SQIFLASH_INSTR_PP, address, buffer, data_count );
+}
+
+err_t sqiflash_quad_write_pages ( sqiflash_t *ctx, uint32_t address, uint8_t *buffer, uint32_t data_count ) 
+{
+    return sqiflash_program_pages( ctx, SQIFLASH_INSTR_SPI_QUAD, address, buffer, data_count );
 }
 
 void sqiflash_quad_enable ( sqiflash_t *ctx ) 
@@ -809,4 +798,46 @@ void sqiflash_write_address( sqiflash_t *ctx, uint32_t addr )
     sqiflash_write( ctx, temp, 3 );
 }
 
+static err_t sqiflash_program_pages ( sqiflash_t *ctx, uint8_t instr, uint32_t address, 
+                                      uint8_t *buffer, uint32_t data_count )
+{
+    uint16_t page_len = 0;
+
+    // A sector, block or chip erase may still be running
+    if ( SQIFLASH_OK != sqiflash_wait_ready( ctx, SQIFLASH_ERASE_TIMEOUT_MS ) )
+    {
+        return SQIFLASH_ERROR;
+    }
+
+    // The first chunk only reaches the end of the page the address points into
+    page_len = SQIFLASH_FLASH_PAGE_SIZE - ( address % SQIFLASH_FLASH_PAGE_SIZE );
+
+    while ( data_count )
+    {
+        if ( page_len > data_count )
+        {
+            page_len = data_count;
+        }
+
+        sqiflash_write_enable( ctx );
+        spi_master_select_device( ctx->chip_select );
+        sqiflash_command( ctx, instr );
+        sqiflash_write_address( ctx, address );
+        sqiflash_write( ctx, buffer, page_len );
+        spi_master_deselect_device( ctx->chip_select );
+
+        // Set up the next page while the current one is being programmed
+        address += page_len;
+        buffer += page_len;
+        data_count -= page_len;
+        page_len = SQIFLASH_FLASH_PAGE_SIZE;
+
+        if ( SQIFLASH_OK != sqiflash_wait_ready( ctx, SQIFLASH_PAGE_PROGRAM_TIMEOUT_MS ) )
+        {
+            return SQIFLASH_ERROR;
+        }
+    }
+    return SQIFLASH_OK;
+}
+
 // ------------------------------------------------------------------------- END
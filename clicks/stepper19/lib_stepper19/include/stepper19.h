@@ -217,6 +217,26 @@ extern "C"{
 /*! @} */ // stepper19_map
 /*! @} */ // stepper19
 
+/**
+ * @brief Stepper 19 Click motion engine object.
+ * @details Background motion state of Stepper 19 Click driver, advanced by #stepper19_motion_tick.
+ */
+typedef struct
+{
+    volatile int32_t  position;         /**< Current motor position in steps. */
+    volatile int32_t  target;           /**< Target motor position in steps. */
+    volatile int32_t  ramp_step;        /**< Ramp step index, negative while decelerating. */
+    volatile int8_t   direction;        /**< Current direction of motion (1 - CW, -1 - CCW). */
+    volatile uint8_t  running;          /**< Motion in progress flag. */
+    volatile uint8_t  hold;             /**< Main context update in progress, steps are deferred. */
+    volatile uint32_t tick_cnt;         /**< Timer ticks remaining until the next step. */
+    float    interval_0;                /**< First ramp step interval in timer ticks. */
+    float    interval_min;              /**< Cruise step interval in timer ticks. */
+    float    interval;                  /**< Current step interval in timer ticks. */
+    float    interval_frac;             /**< Fractional timer tick carried to the next step. */
+
+} stepper19_motion_t;
+
 /**
  * @brief Stepper 19 Click context object.
  * @details Context object definition of Stepper 19 Click driver.
@@ -242,6 +262,9 @@ typedef struct
     float microstep_mode;     /**< Microstepping mode setting. */
     uint8_t step_dir_mode;    /**< Step and direction control mode. */
 
+    // Motion engine
+    stepper19_motion_t motion;    /**< Background motion engine state. */
+
 } stepper19_t;
 
 /**
@@ -561,7 +584,105 @@ err_t stepper19_rotate_by_step ( stepper19_t *ctx, uint8_t step_speed, uint16_t
  */
 uint8_t stepper19_fault_indication ( stepper19_t *ctx );
 
+/**
+ * @brief Stepper 19 set motion profile function.
+ * @details This function sets the trapezoidal speed profile used by the background motion engine.
+ * @param[in] ctx : Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @param[in] tick_freq : Frequency of the timer calling #stepper19_motion_tick [Hz].
+ * @param[in] max_speed : Cruise speed [steps/s], up to @b tick_freq.
+ * @param[in] accel : Acceleration and deceleration rate [steps/s^2].
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note The profile can be changed only while the motor is not moving.
+ * The motion engine requires the STEP and DIR pins to be in the GPIO control mode.
+ */
+err_t stepper19_set_motion_profile ( stepper19_t *ctx, uint32_t tick_freq, float max_speed, float accel );
+
+/**
+ * @brief Stepper 19 move to function.
+ * @details This function starts a background move to the absolute position, or retargets the move in progress.
+ * @param[in] ctx : Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @param[in] position : Absolute target position in steps.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, motion profile is not set.
+ * See #err_t definition for detailed explanation.
+ * @note The device must be enabled and #stepper19_motion_tick called periodically for the motor to move.
+ */
+err_t stepper19_move_to ( stepper19_t *ctx, int32_t position );
+
+/**
+ * @brief Stepper 19 move by function.
+ * @details This function starts a background move by the number of steps relative to the current position.
+ * @param[in] ctx : Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @param[in] steps : Relative move in steps, negative values move in the CCW direction.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, motion profile is not set.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t stepper19_move_by ( stepper19_t *ctx, int32_t steps );
+
+/**
+ * @brief Stepper 19 stop function.
+ * @details This function decelerates the motor to a stop as fast as the set acceleration allows.
+ * @param[in] ctx : Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @return None.
+ * @note Use #stepper19_is_moving to check when the motor has stopped.
+ */
+void stepper19_stop ( stepper19_t *ctx );
 
+/**
+ * @brief Stepper 19 get position function.
+ * @details This function returns the current motor position tracked by the motion engine.
+ * @param[in] ctx : Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @return Current position in steps.
+ * @note None.
+ */
+int32_t stepper19_get_position ( stepper19_t *ctx );
+
+/**
+ * @brief Stepper 19 set position function.
+ * @details This function sets the current motor position, i.e. defines the zero point after homing.
+ * @param[in] ctx : Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @param[in] position : New current position in steps.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, motor is moving.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t stepper19_set_position ( stepper19_t *ctx, int32_t position );
+
+/**
+ * @brief Stepper 19 is moving function.
+ * @details This function checks whether a background move is in progress.
+ * @param[in] ctx : Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @return @li @c 0 - Motor is stopped,
+ *         @li @c 1 - Motor is moving.
+ * @note None.
+ */
+uint8_t stepper19_is_moving ( stepper19_t *ctx );
+
+/**
+ * @brief Stepper 19 motion tick function.
+ * @details This function advances the background motion engine by one timer tick, generating
+ * a step pulse when it is due and computing the next step interval of the acceleration,
+ * cruise and deceleration ramp incrementally, without a per-step square root.
+ * @param[in] ctx : Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @return None.
+ * @note Call this function from a periodic timer interrupt running at the frequency set
+ * by #stepper19_set_motion_profile. A step that falls due while the main context updates the
+ * motion state is taken on the first tick after the update.
+ */
+void stepper19_motion_tick ( stepper19_t *ctx );
 
 #ifdef __cplusplus
 }
@@ -26,6 +26,7 @@
  */
 
 #include "stepper19.h"
+#include "math.h"
 
 
 /**
@@ -44,6 +45,22 @@
  */
 static void stepper19_step_delay ( stepper19_t *ctx );
 
+/**
+ * @brief First ramp step correction factor.
+ * @details Corrects the first step interval of the incremental ramp approximation.
+ */
+#define MOTION_FIRST_STEP_CORR  0.676f
+
+/**
+ * @brief Stepper 19 motion update function.
+ * @details This function computes the direction and interval of the next step from the current
+ * position, target and ramp state, and stops the motion engine once the target is reached.
+ * @param[in] ctx : Click context object.
+ * See #stepper19_t object definition for detailed explanation.
+ * @return Nothing.
+ */
+static void stepper19_motion_update ( stepper19_t *ctx );
+
 void stepper19_cfg_setup ( stepper19_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -92,6 +109,13 @@ err_t stepper19_init ( stepper19_t *ctx, stepper19_cfg_t *cfg )
 
     digital_in_init( &ctx->flt, cfg->flt );
 
+    ctx->motion.position = 0;
+    ctx->motion.target = 0;
+    ctx->motion.ramp_step = 0;
+    ctx->motion.running = 0;
+    ctx->motion.hold = 0;
+    ctx->motion.interval_min = 0;
+
     return I2C_MASTER_SUCCESS;
 }
 
@@ -354,6 +378,110 @@ uint8_t stepper19_fault_indication ( stepper19_t *ctx )
     return digital_in_read( &ctx->flt );
 }
 
+err_t stepper19_set_motion_profile ( stepper19_t *ctx, uint32_t tick_freq, float max_speed, float accel )
+{
+    if ( ( ctx->motion.running ) || ( 0 == tick_freq ) || ( max_speed <= 0 ) || 
+         ( max_speed > ( float ) tick_freq ) || ( accel <= 0 ) || 
+         ( STEPPER19_CTRL_STEP_DIR_GPIO != ctx->step_dir_mode ) )
+    {
+        return STEPPER19_ERROR;
+    }
+    ctx->motion.interval_min = ( float ) tick_freq / max_speed;
+    ctx->motion.interval_0 = MOTION_FIRST_STEP_CORR * ( float ) tick_freq * sqrt ( 2.0 / accel );
+    if ( ctx->motion.interval_0 < ctx->motion.interval_min )
+    {
+        ctx->motion.interval_0 = ctx->motion.interval_min;
+    }
+    return STEPPER19_OK;
+}
+
+err_t stepper19_move_to ( stepper19_t *ctx, int32_t position )
+{
+    if ( 0 == ctx->motion.interval_min )
+    {
+        return STEPPER19_ERROR;
+    }
+    // The timer tick takes no step while the target and ramp state are updated
+    ctx->motion.hold = 1;
+    ctx->motion.target = position;
+    if ( ( !ctx->motion.running ) && ( position != ctx->motion.position ) )
+    {
+        ctx->motion.interval_frac = 0;
+        stepper19_motion_update ( ctx );
+        ctx->motion.running = 1;
+    }
+    ctx->motion.hold = 0;
+    return STEPPER19_OK;
+}
+
+err_t stepper19_move_by ( stepper19_t *ctx, int32_t steps )
+{
+    return stepper19_move_to ( ctx, stepper19_get_position ( ctx ) + steps );
+}
+
+void stepper19_stop ( stepper19_t *ctx )
+{
+    ctx->motion.hold = 1;
+    if ( ctx->motion.running )
+    {
+        int32_t steps_to_stop = ctx->motion.ramp_step;
+        if ( steps_to_stop < 0 )
+        {
+            steps_to_stop = -steps_to_stop;
+        }
+        ctx->motion.target = ctx->motion.position + ctx->motion.direction * steps_to_stop;
+    }
+    ctx->motion.hold = 0;
+}
+
+int32_t stepper19_get_position ( stepper19_t *ctx )
+{
+    int32_t position = 0;
+    // The position is wider than a single access on 8 and 16-bit cores
+    ctx->motion.hold = 1;
+    position = ctx->motion.position;
+    ctx->motion.hold = 0;
+    return position;
+}
+
+err_t stepper19_set_position ( stepper19_t *ctx, int32_t position )
+{
+    if ( ctx->motion.running )
+    {
+        return STEPPER19_ERROR;
+    }
+    ctx->motion.position = position;
+    ctx->motion.target = position;
+    return STEPPER19_OK;
+}
+
+uint8_t stepper19_is_moving ( stepper19_t *ctx )
+{
+    return ctx->motion.running;
+}
+
+void stepper19_motion_tick ( stepper19_t *ctx )
+{
+    if ( !ctx->motion.running )
+    {
+        return;
+    }
+    if ( ctx->motion.tick_cnt > 1 )
+    {
+        ctx->motion.tick_cnt--;
+        return;
+    }
+    if ( ctx->motion.hold )
+    {
+        return;
+    }
+    // Next interval is computed while the step pin is high, which stretches the pulse width
+    digital_out_high ( &ctx->stp );
+    ctx->motion.position += ctx->motion.direction;
+    stepper19_motion_update ( ctx );
+    digital_out_low ( &ctx->stp );
+}
+
 static void stepper19_step_delay ( stepper19_t *ctx ) 
 {
     for ( uint32_t n_cnt = 0; n_cnt < ctx->step_delay; n_cnt++ )
@@ -362,4 +490,83 @@ static void stepper19_step_delay ( stepper19_t *ctx )
     }
 }
 
+static void stepper19_motion_update ( stepper19_t *ctx )
+{
+    int32_t distance = ctx->motion.target - ctx->motion.position;
+    int32_t steps_to_stop = ctx->motion.ramp_step;
+    float interval = 0;
+    
+    // While accelerating or cruising the ramp index equals the number of steps needed to stop
+    if ( steps_to_stop < 0 )
+    {
+        steps_to_stop = -steps_to_stop;
+    }
+    if ( ( 0 == distance ) && ( steps_to_stop <= 1 ) )
+    {
+        ctx->motion.ramp_step = 0;
+        ctx->motion.running = 0;
+        return;
+    }
+    if ( distance > 0 )
+    {
+        if ( ( ctx->motion.ramp_step > 0 ) && ( ( steps_to_stop >= distance ) || ( ctx->motion.direction < 0 ) ) )
+        {
+            ctx->motion.ramp_step = -steps_to_stop;
+        }
+        else if ( ( ctx->motion.ramp_step < 0 ) && ( steps_to_stop < distance ) && ( ctx->motion.direction > 0 ) )
+        {
+            ctx->motion.ramp_step = steps_to_stop;
+        }
+    }
+    else if ( distance < 0 )
+    {
+        if ( ( ctx->motion.ramp_step > 0 ) && ( ( steps_to_stop >= -distance ) || ( ctx->motion.direction > 0 ) ) )
+        {
+            ctx->motion.ramp_step = -steps_to_stop;
+        }
+        else if ( ( ctx->motion.ramp_step < 0 ) && ( steps_to_stop < -distance ) && ( ctx->motion.direction < 0 ) )
+        {
+            ctx->motion.ramp_step = steps_to_stop;
+        }
+    }
+
+    if ( 0 == ctx->motion.ramp_step )
+    {
+        // Start of a new ramp from standstill
+        if ( distance > 0 )
+        {
+            ctx->motion.direction = 1;
+            digital_out_write ( &ctx->dir, STEPPER19_DIR_CLOCKWISE );
+        }
+        else
+        {
+            ctx->motion.direction = -1;
+            digital_out_write ( &ctx->dir, STEPPER19_DIR_COUNTERCLOCKWISE );
+        }
+        ctx->motion.interval = ctx->motion.interval_0;
+        ctx->motion.ramp_step = 1;
+    }
+    else
+    {
+        // c(n) = c(n-1) - 2 * c(n-1) / ( 4 * n + 1 ), a negative index slows the motor down
+        ctx->motion.interval -= ( 2.0f * ctx->motion.interval ) / ( 4.0f * ctx->motion.ramp_step + 1.0f );
+        if ( ctx->motion.interval <= ctx->motion.interval_min )
+        {
+            ctx->motion.interval = ctx->motion.interval_min;
+        }
+        else
+        {
+            ctx->motion.ramp_step++;
+        }
+    }
+
+    interval = ctx->motion.interval + ctx->motion.interval_frac;
+    ctx->motion.tick_cnt = ( uint32_t ) interval;
+    ctx->motion.interval_frac = interval - ctx->motion.tick_cnt;
+    if ( 0 == ctx->motion.tick_cnt )
+    {
+        ctx->motion.tick_cnt = 1;
+    }
+}
+
 // ------------------------------------------------------------------------- END
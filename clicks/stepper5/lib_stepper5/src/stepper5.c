@@ -26,6 +26,7 @@
  */
 
 #include "stepper5.h"
+#include "math.h"
 
 /**
  * @brief Set delay for controlling motor speed.
@@ -35,6 +36,22 @@
  */
 static void stepper5_speed_delay ( uint8_t speed_macro );
 
+/**
+ * @brief First ramp step correction factor.
+ * @details Corrects the first step interval of the incremental ramp approximation.
+ */
+#define MOTION_FIRST_STEP_CORR  0.676f
+
+/**
+ * @brief Stepper 5 motion update function.
+ * @details This function computes the direction and interval of the next step from the current
+ * position, target and ramp state, and stops the motion engine once the target is reached.
+ * @param[in] ctx : Click context object.
+ * See #stepper5_t object definition for detailed explanation.
+ * @return Nothing.
+ */
+static void stepper5_motion_update ( stepper5_t *ctx );
+
 /** 
  * @brief CRC8-ATM calculation function.
  * @details This function calculates CRC8-ATM with parameteres: 
@@ -111,6 +128,13 @@ err_t stepper5_init ( stepper5_t *ctx, stepper5_cfg_t *cfg )
     uint8_t dummy = 0;
     uart_read( &ctx->uart, &dummy, 1 );
 
+    ctx->motion.position = 0;
+    ctx->motion.target = 0;
+    ctx->motion.ramp_step = 0;
+    ctx->motion.running = 0;
+    ctx->motion.hold = 0;
+    ctx->motion.interval_min = 0;
+
     return UART_SUCCESS;
 }
 
@@ -302,6 +326,109 @@ void stepper5_drive_motor ( stepper5_t *ctx, uint32_t steps, uint8_t speed )
     stepper5_set_toff ( ctx, STEPPER5_TOFF_DRIVER_DISABLE );
 }
 
+err_t stepper5_set_motion_profile ( stepper5_t *ctx, uint32_t tick_freq, float max_speed, float accel )
+{
+    if ( ( ctx->motion.running ) || ( 0 == tick_freq ) || ( max_speed <= 0 ) || 
+         ( max_speed > ( float ) tick_freq ) || ( accel <= 0 ) )
+    {
+        return STEPPER5_ERROR;
+    }
+    ctx->motion.interval_min = ( float ) tick_freq / max_speed;
+    ctx->motion.interval_0 = MOTION_FIRST_STEP_CORR * ( float ) tick_freq * sqrt ( 2.0 / accel );
+    if ( ctx->motion.interval_0 < ctx->motion.interval_min )
+    {
+        ctx->motion.interval_0 = ctx->motion.interval_min;
+    }
+    return STEPPER5_OK;
+}
+
+err_t stepper5_move_to ( stepper5_t *ctx, int32_t position )
+{
+    if ( 0 == ctx->motion.interval_min )
+    {
+        return STEPPER5_ERROR;
+    }
+    // The timer tick takes no step while the target and ramp state are updated
+    ctx->motion.hold = 1;
+    ctx->motion.target = position;
+    if ( ( !ctx->motion.running ) && ( position != ctx->motion.position ) )
+    {
+        ctx->motion.interval_frac = 0;
+        stepper5_motion_update ( ctx );
+        ctx->motion.running = 1;
+    }
+    ctx->motion.hold = 0;
+    return STEPPER5_OK;
+}
+
+err_t stepper5_move_by ( stepper5_t *ctx, int32_t steps )
+{
+    return stepper5_move_to ( ctx, stepper5_get_position ( ctx ) + steps );
+}
+
+void stepper5_stop ( stepper5_t *ctx )
+{
+    ctx->motion.hold = 1;
+    if ( ctx->motion.running )
+    {
+        int32_t steps_to_stop = ctx->motion.ramp_step;
+        if ( steps_to_stop < 0 )
+        {
+            steps_to_stop = -steps_to_stop;
+        }
+        ctx->motion.target = ctx->motion.position + ctx->motion.direction * steps_to_stop;
+    }
+    ctx->motion.hold = 0;
+}
+
+int32_t stepper5_get_position ( stepper5_t *ctx )
+{
+    int32_t position = 0;
+    // The position is wider than a single access on 8 and 16-bit cores
+    ctx->motion.hold = 1;
+    position = ctx->motion.position;
+    ctx->motion.hold = 0;
+    return position;
+}
+
+err_t stepper5_set_position ( stepper5_t *ctx, int32_t position )
+{
+    if ( ctx->motion.running )
+    {
+        return STEPPER5_ERROR;
+    }
+    ctx->motion.position = position;
+    ctx->motion.target = position;
+    return STEPPER5_OK;
+}
+
+uint8_t stepper5_is_moving ( stepper5_t *ctx )
+{
+    return ctx->motion.running;
+}
+
+void stepper5_motion_tick ( stepper5_t *ctx )
+{
+    if ( !ctx->motion.running )
+    {
+        return;
+    }
+    if ( ctx->motion.tick_cnt > 1 )
+    {
+        ctx->motion.tick_cnt--;
+        return;
+    }
+    if ( ctx->motion.hold )
+    {
+        return;
+    }
+    // Next interval is computed while the step pin is high, which stretches the pulse width
+    stepper5_set_step_pin ( ctx, STEPPER5_PIN_STATE_HIGH );
+    ctx->motion.position += ctx->motion.direction;
+    stepper5_motion_update ( ctx );
+    stepper5_set_step_pin ( ctx, STEPPER5_PIN_STATE_LOW );
+}
+
 static void stepper5_speed_delay ( uint8_t speed_macro )
 {
     switch ( speed_macro )
@@ -344,24 +471,106 @@ static void stepper5_speed_delay ( uint8_t speed_macro )
 
 static uint8_t stepper5_calculate_crc ( uint8_t *data_buf, uint8_t len )
 {
+    // CRC of each nibble value for reflected polynomial 0xE0, processed 4 bits at a time
+    static const uint8_t crc8_table[ 16 ] = 
+    {
+        0x00, 0x1C, 0x38, 0x24, 0x70, 0x6C, 0x48, 0x54,
+        0xE0, 0xFC, 0xD8, 0xC4, 0x90, 0x8C, 0xA8, 0xB4
+    };
+    // Bit reversed nibble values
+    static const uint8_t reflect_table[ 16 ] = 
+    {
+        0x00, 0x08, 0x04, 0x0C, 0x02, 0x0A, 0x06, 0x0E,
+        0x01, 0x09, 0x05, 0x0D, 0x03, 0x0B, 0x07, 0x0F
+    };
     uint8_t crc = 0x00;
     for ( uint8_t cnt_byte = 0; cnt_byte < len; cnt_byte++ ) 
     {
-        uint8_t curr_byte = data_buf[ cnt_byte ];
-        for ( uint8_t cnt_bit = 0; cnt_bit < 8; cnt_bit++ ) 
+        // Reflected input is processed LSB first, the non-reflected output is restored at the end
+        crc ^= data_buf[ cnt_byte ];
+        crc = ( crc >> 4 ) ^ crc8_table[ crc & 0x0F ];
+        crc = ( crc >> 4 ) ^ crc8_table[ crc & 0x0F ];
+    }
+    return ( reflect_table[ crc & 0x0F ] << 4 ) | reflect_table[ crc >> 4 ];
+}
+
+static void stepper5_motion_update ( stepper5_t *ctx )
+{
+    int32_t distance = ctx->motion.target - ctx->motion.position;
+    int32_t steps_to_stop = ctx->motion.ramp_step;
+    float interval = 0;
+    
+    // While accelerating or cruising the ramp index equals the number of steps needed to stop
+    if ( steps_to_stop < 0 )
+    {
+        steps_to_stop = -steps_to_stop;
+    }
+    if ( ( 0 == distance ) && ( steps_to_stop <= 1 ) )
+    {
+        ctx->motion.ramp_step = 0;
+        ctx->motion.running = 0;
+        return;
+    }
+    if ( distance > 0 )
+    {
+        if ( ( ctx->motion.ramp_step > 0 ) && ( ( steps_to_stop >= distance ) || ( ctx->motion.direction < 0 ) ) )
+        {
+            ctx->motion.ramp_step = -steps_to_stop;
+        }
+        else if ( ( ctx->motion.ramp_step < 0 ) && ( steps_to_stop < distance ) && ( ctx->motion.direction > 0 ) )
+        {
+            ctx->motion.ramp_step = steps_to_stop;
+        }
+    }
+    else if ( distance < 0 )
+    {
+        if ( ( ctx->motion.ramp_step > 0 ) && ( ( steps_to_stop >= -distance ) || ( ctx->motion.direction > 0 ) ) )
+        {
+            ctx->motion.ramp_step = -steps_to_stop;
+        }
+        else if ( ( ctx->motion.ramp_step < 0 ) && ( steps_to_stop < -distance ) && ( ctx->motion.direction < 0 ) )
+        {
+            ctx->motion.ramp_step = steps_to_stop;
+        }
+    }
+
+    if ( 0 == ctx->motion.ramp_step )
+    {
+        // Start of a new ramp from standstill
+        if ( distance > 0 )
         {
-            if ( ( crc >> 7 ) ^ ( curr_byte & 0x01 ) )
-            {    
-                crc = ( uint8_t )( ( crc << 1 ) ^ 0x07 );
-            }
-            else
-            {
-                crc <<= 1;
-            }
-            curr_byte >>= 1;
+            ctx->motion.direction = 1;
+            stepper5_set_direction ( ctx, STEPPER5_DIR_CW );
         }
+        else
+        {
+            ctx->motion.direction = -1;
+            stepper5_set_direction ( ctx, STEPPER5_DIR_CCW );
+        }
+        ctx->motion.interval = ctx->motion.interval_0;
+        ctx->motion.ramp_step = 1;
+    }
+    else
+    {
+        // c(n) = c(n-1) - 2 * c(n-1) / ( 4 * n + 1 ), a negative index slows the motor down
+        ctx->motion.interval -= ( 2.0f * ctx->motion.interval ) / ( 4.0f * ctx->motion.ramp_step + 1.0f );
+        if ( ctx->motion.interval <= ctx->motion.interval_min )
+        {
+            ctx->motion.interval = ctx->motion.interval_min;
+        }
+        else
+        {
+            ctx->motion.ramp_step++;
+        }
+    }
+
+    interval = ctx->motion.interval + ctx->motion.interval_frac;
+    ctx->motion.tick_cnt = ( uint32_t ) interval;
+    ctx->motion.interval_frac = interval - ctx->motion.tick_cnt;
+    if ( 0 == ctx->motion.tick_cnt )
+    {
+        ctx->motion.tick_cnt = 1;
     }
-    return crc;
 }
 
 // ------------------------------------------------------------------------- END
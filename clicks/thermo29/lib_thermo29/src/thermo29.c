@@ -304,21 +304,17 @@ err_t thermo29_clear_alert_status ( thermo29_t *ctx )
 
 static uint16_t thermo29_calculate_crc16_ccitt ( uint8_t *data_buf, uint16_t len )
 {
+    // CRC of each nibble value for polynomial 0x1021, processed 4 bits at a time
+    static const uint16_t crc16_table[ 16 ] = 
+    {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+    };
     uint16_t crc16 = 0xFFFF;
     for ( uint16_t cnt = 0; cnt < len; cnt++ )
     {
-        crc16 ^= ( ( data_buf[ cnt ] ) << 8 );
-        for ( uint8_t bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
-        {
-            if ( crc16 & 0x8000 )
-            {
-                crc16 = ( crc16 << 1 ) ^ 0x1021;
-            }
-            else
-            {
-                crc16 <<= 1;
-            }
-        }
+        crc16 = ( crc16 << 4 ) ^ crc16_table[ ( crc16 >> 12 ) ^ ( data_buf[ cnt ] >> 4 ) ];
+        crc16 = ( crc16 << 4 ) ^ crc16_table[ ( crc16 >> 12 ) ^ ( data_buf[ cnt ] & 0x0F ) ];
     }
     return crc16;
 }
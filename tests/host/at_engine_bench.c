@@ -0,0 +1,646 @@
+/*
+ * AT command engine: framing, result codes, URC dispatch and bring-up time.
+ *
+ * The LTE Cat.1-EU driver is built by default and the LTE IoT 2 driver when
+ * LTEIOT2_BUILD is set. Both run against a modem model on the UART hooks
+ * at 115200 baud. The model echoes the command, answers after a per
+ * command latency with information lines and a final result code, sends
+ * a "> " prompt for AT+QISEND and takes the announced number of data bytes.
+ * It drops +QIURC and +CREG unsolicited result codes between response
+ * lines. Its receive FIFO accepts at most 8 bytes per write, so the engine
+ * has to resume a command it could not send in one call.
+ *
+ * The engine runs the example bring-up sequence from a 1 ms main loop.
+ * Every command has to reach the modem unchanged and complete with the
+ * right status. Its information lines have to reach its line callback,
+ * and every URC has to reach its handler exactly once. at_process must
+ * never advance the clock. The same sequence then runs the way the
+ * example did it: blocking send, strstr polling of the accumulated buffer
+ * every 1 ms and the fixed delay after each command. The engine has to
+ * finish the sequence in less time. A separate pass covers +CME ERROR
+ * codes, ERROR, the prompt data path, a timeout that releases the queue
+ * and a full queue.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_sim.h"
+
+#ifdef LTEIOT2_BUILD
+#include "lteiot2.h"
+
+#define DRIVER_NAME             "LTE IoT 2"
+#define modem_t                 lteiot2_t
+#define modem_cfg_t             lteiot2_cfg_t
+#define modem_cfg_setup         lteiot2_cfg_setup
+#define modem_init              lteiot2_init
+#define modem_send_cmd          lteiot2_send_cmd
+#define modem_generic_read      lteiot2_generic_read
+#define at_cmd_t                lteiot2_at_cmd_t
+#define at_urc_t                lteiot2_at_urc_t
+#define at_init                 lteiot2_at_init
+#define at_set_urc_table        lteiot2_at_set_urc_table
+#define at_submit               lteiot2_at_submit
+#define at_process              lteiot2_at_process
+#define AT_QUEUE_SIZE           LTEIOT2_AT_QUEUE_SIZE
+#define AT_STATUS_OK            LTEIOT2_AT_STATUS_OK
+#define AT_STATUS_ERROR         LTEIOT2_AT_STATUS_ERROR
+#define AT_STATUS_CME_ERROR     LTEIOT2_AT_STATUS_CME_ERROR
+#define AT_STATUS_PENDING       LTEIOT2_AT_STATUS_PENDING
+#define AT_STATUS_TIMEOUT       LTEIOT2_AT_STATUS_TIMEOUT
+#define MODEM_OK                LTEIOT2_OK
+#else
+#include "ltecat1eu.h"
+
+#define DRIVER_NAME             "LTE Cat.1-EU"
+#define modem_t                 ltecat1eu_t
+#define modem_cfg_t             ltecat1eu_cfg_t
+#define modem_cfg_setup         ltecat1eu_cfg_setup
+#define modem_init              ltecat1eu_init
+#define modem_send_cmd          ltecat1eu_send_cmd
+#define modem_generic_read      ltecat1eu_generic_read
+#define at_cmd_t                ltecat1eu_at_cmd_t
+#define at_urc_t                ltecat1eu_at_urc_t
+#define at_init                 ltecat1eu_at_init
+#define at_set_urc_table        ltecat1eu_at_set_urc_table
+#define at_submit               ltecat1eu_at_submit
+#define at_process              ltecat1eu_at_process
+#define AT_QUEUE_SIZE           LTECAT1EU_AT_QUEUE_SIZE
+#define AT_STATUS_OK            LTECAT1EU_AT_STATUS_OK
+#define AT_STATUS_ERROR         LTECAT1EU_AT_STATUS_ERROR
+#define AT_STATUS_CME_ERROR     LTECAT1EU_AT_STATUS_CME_ERROR
+#define AT_STATUS_PENDING       LTECAT1EU_AT_STATUS_PENDING
+#define AT_STATUS_TIMEOUT       LTECAT1EU_AT_STATUS_TIMEOUT
+#define MODEM_OK                LTECAT1EU_OK
+#endif
+
+#define CHAR_US             ( 10 * 1e6 / 115200 )
+#define RX_FIFO_BYTES       8
+#define OUT_SIZE            8192
+#define LINE_SIZE           96
+#define MAX_LINES           8
+#define MAX_CMDS            32
+#define LEGACY_BUF_SIZE     100
+
+typedef struct
+{
+    const char *cmd;            /* Command line as the modem receives it. */
+    uint32_t latency_ms;        /* Time from the end of the command to the response. */
+    const char *lines[ 4 ];     /* Information lines. */
+    const char *final;          /* Final result code, NULL for no response. */
+    uint32_t legacy_delay_ms;   /* Fixed delay of the example after the command. */
+} modem_cmd_t;
+
+/* Bring-up sequence of the LTE Cat.1-EU example, with its fixed delays */
+static const modem_cmd_t bring_up[ ] =
+{
+    { "AT",                         5,    { NULL },                                            "OK", 500 },
+    { "ATI",                        10,   { "Cinterion", "ELS62-E", "REVISION 01.000" },      "OK", 500 },
+    { "AT+CGMR",                    10,   { "REVISION 01.000" },                               "OK", 500 },
+    { "AT+COPS=2",                  200,  { NULL },                                            "OK", 500 },
+    { "AT+CGDCONT=1,\"IP\",\"internet\"", 20, { NULL },                                        "OK", 500 },
+    { "AT+CFUN=1",                  800,  { NULL },                                            "OK", 500 },
+    { "AT+COPS=0",                  1500, { NULL },                                            "OK", 2000 },
+    { "AT+CEREG=2",                 10,   { NULL },                                            "OK", 500 },
+    { "AT+CIMI",                    20,   { "220015555512345" },                               "OK", 500 },
+    { "AT+CGATT?",                  10,   { "+CGATT: 1" },                                     "OK", 500 },
+    { "AT+CEREG?",                  10,   { "+CEREG: 2,1,\"1A2B\",\"01A2B3C4\",7" },           "OK", 500 },
+    { "AT+CSQ",                     10,   { "+CSQ: 20,99" },                                   "OK", 0 },
+};
+#define BRING_UP_CMDS       ( sizeof( bring_up ) / sizeof( bring_up[ 0 ] ) )
+
+static const modem_cmd_t other_cmds[ ] =
+{
+    { "AT+QIOPEN=1,0,\"TCP\",\"10.0.0.1\",80", 30, { NULL },                                   "+CME ERROR: 566", 0 },
+    { "AT+FOO",                     5,    { NULL },                                            "ERROR", 0 },
+    { "AT+QPOWD=9",                 0,    { NULL },                                            NULL, 0 },
+    { "AT+QISEND=0,12",             5,    { NULL },                                            "SEND OK", 0 },
+};
+
+static const char * const urc_lines[ ] = { "+QIURC: \"recv\",0", "+CREG: 1,\"1A2B\",\"01A2B3C4\",7" };
+
+static struct
+{
+    char in[ LINE_SIZE ];
+    uint16_t in_len;
+    char received[ MAX_CMDS ][ LINE_SIZE ];
+    uint8_t n_received;
+    uint8_t out[ OUT_SIZE ];
+    uint64_t out_at[ OUT_SIZE ];
+    uint32_t out_len;
+    uint32_t out_pos;
+    uint64_t out_free_us;
+    uint32_t data_left;
+    char data[ LINE_SIZE ];
+    uint16_t data_len;
+    uint32_t urc_sent[ 2 ];
+    uint64_t silent_at_us;
+    uint32_t rng;
+} modem;
+
+static modem_t ctx;
+static uint32_t urc_got[ 2 ];
+static uint32_t urc_in_line_cb;
+static char got_lines[ MAX_CMDS ][ MAX_LINES ][ LINE_SIZE ];
+static uint8_t n_got_lines[ MAX_CMDS ];
+static uint8_t done_calls[ MAX_CMDS ];
+static uint64_t done_at_us[ MAX_CMDS ];
+
+static int failures;
+
+// ------------------------------------------------------------------- MODEM
+
+static uint32_t rng ( void )
+{
+    modem.rng = modem.rng * 1664525u + 1013904223u;
+    return modem.rng >> 8;
+}
+
+// Characters leave the modem back to back, starting no earlier than at_us
+static void modem_out ( const char *text, size_t len, uint64_t at_us )
+{
+    double t = ( at_us > modem.out_free_us ) ? at_us : modem.out_free_us;
+
+    for ( size_t cnt = 0; ( cnt < len ) && ( modem.out_len < OUT_SIZE ); cnt++ )
+    {
+        t += CHAR_US;
+        modem.out[ modem.out_len ] = ( uint8_t ) text[ cnt ];
+        modem.out_at[ modem.out_len++ ] = ( uint64_t ) t;
+    }
+    modem.out_free_us = ( uint64_t ) t;
+}
+
+static void modem_line ( const char *line, uint64_t at_us )
+{
+    modem_out( "\r\n", 2, at_us );
+    modem_out( line, strlen( line ), at_us );
+    modem_out( "\r\n", 2, at_us );
+}
+
+// One of the URCs on every third response line
+static void modem_maybe_urc ( uint64_t at_us )
+{
+    if ( 0 == ( rng( ) % 3 ) )
+    {
+        uint8_t urc = rng( ) & 1;
+
+        modem_line( urc_lines[ urc ], at_us );
+        modem.urc_sent[ urc ]++;
+    }
+}
+
+static const modem_cmd_t *modem_find ( const char *cmd )
+{
+    for ( uint8_t cnt = 0; cnt < BRING_UP_CMDS; cnt++ )
+    {
+        if ( 0 == strcmp( bring_up[ cnt ].cmd, cmd ) )
+        {
+            return &bring_up[ cnt ];
+        }
+    }
+    for ( uint8_t cnt = 0; cnt < sizeof( other_cmds ) / sizeof( other_cmds[ 0 ] ); cnt++ )
+    {
+        if ( 0 == strcmp( other_cmds[ cnt ].cmd, cmd ) )
+        {
+            return &other_cmds[ cnt ];
+        }
+    }
+    return NULL;
+}
+
+static void modem_respond ( const modem_cmd_t *mc, uint64_t at_us )
+{
+    at_us += ( uint64_t ) mc->latency_ms * 1000;
+    modem_maybe_urc( at_us );
+    for ( uint8_t cnt = 0; ( cnt < 4 ) && mc->lines[ cnt ]; cnt++ )
+    {
+        modem_line( mc->lines[ cnt ], at_us );
+        modem_maybe_urc( at_us );
+    }
+    modem_line( mc->final, at_us );
+}
+
+static void modem_command ( uint64_t at_us )
+{
+    const modem_cmd_t *mc;
+
+    if ( modem.n_received < MAX_CMDS )
+    {
+        strcpy( modem.received[ modem.n_received++ ], modem.in );
+    }
+    mc = modem_find( modem.in );
+    if ( NULL == mc )
+    {
+        modem_line( "ERROR", at_us );
+        return;
+    }
+    if ( 0 == strncmp( mc->cmd, "AT+QISEND=", 10 ) )
+    {
+        modem.data_left = atoi( strchr( mc->cmd, ',' ) + 1 );
+        modem.data_len = 0;
+        modem_out( "\r\n> ", 4, at_us + 2000 );
+        return;
+    }
+    if ( mc->final )
+    {
+        modem_respond( mc, at_us );
+    }
+    else
+    {
+        modem.silent_at_us = at_us;
+    }
+}
+
+static err_t uart_write_hook ( void *obj, char *buffer, size_t size )
+{
+    ( void ) obj;
+    if ( size > RX_FIFO_BYTES )
+    {
+        size = RX_FIFO_BYTES;
+    }
+    for ( size_t cnt = 0; cnt < size; cnt++ )
+    {
+        uint64_t at_us = hal_sim_time_us + ( uint64_t ) ( ( cnt + 1 ) * CHAR_US );
+        char chr = buffer[ cnt ];
+
+        if ( modem.data_left )
+        {
+            modem.data[ modem.data_len++ ] = chr;
+            if ( 0 == --modem.data_left )
+            {
+                modem.data[ modem.data_len ] = 0;
+                modem_respond( modem_find( "AT+QISEND=0,12" ), at_us );
+            }
+            continue;
+        }
+        if ( '\n' == chr )
+        {
+            continue;
+        }
+        modem_out( &chr, 1, at_us );
+        if ( '\r' == chr )
+        {
+            modem.in[ modem.in_len ] = 0;
+            if ( modem.in_len )
+            {
+                modem_command( at_us );
+            }
+            modem.in_len = 0;
+        }
+        else if ( modem.in_len < ( LINE_SIZE - 1 ) )
+        {
+            modem.in[ modem.in_len++ ] = chr;
+        }
+    }
+    return ( err_t ) size;
+}
+
+static err_t uart_read_hook ( void *obj, char *buffer, size_t size )
+{
+    size_t len = 0;
+
+    ( void ) obj;
+    while ( ( len < size ) && ( modem.out_pos < modem.out_len ) && ( modem.out_at[ modem.out_pos ] <= hal_sim_time_us ) )
+    {
+        buffer[ len++ ] = ( char ) modem.out[ modem.out_pos++ ];
+    }
+    return ( err_t ) len;
+}
+
+static size_t uart_bytes_available_hook ( void *obj )
+{
+    size_t len = 0;
+
+    ( void ) obj;
+    while ( ( modem.out_pos + len < modem.out_len ) && ( modem.out_at[ modem.out_pos + len ] <= hal_sim_time_us ) )
+    {
+        len++;
+    }
+    return len;
+}
+
+// ------------------------------------------------------------------- HOST
+
+static void urc_handler ( char *line, void *ref )
+{
+    uint8_t urc = ( uint8_t ) ( uintptr_t ) ref;
+
+    if ( strcmp( line, urc_lines[ urc ] ) )
+    {
+        printf( "FAIL: URC handler %u gets \"%s\"\n", urc, line );
+        failures++;
+    }
+    urc_got[ urc ]++;
+}
+
+static const at_urc_t urc_table[ ] =
+{
+    { "+QIURC:", urc_handler, ( void * ) 0 },
+    { "+CREG:",  urc_handler, ( void * ) 1 },
+};
+
+static void line_cb ( at_cmd_t *cmd, char *line )
+{
+    uint8_t idx = ( uint8_t ) ( uintptr_t ) cmd->ref;
+
+    if ( ( 0 == strncmp( line, "+QIURC", 6 ) ) || ( 0 == strncmp( line, "+CREG", 5 ) ) )
+    {
+        urc_in_line_cb++;
+    }
+    if ( n_got_lines[ idx ] < MAX_LINES )
+    {
+        snprintf( got_lines[ idx ][ n_got_lines[ idx ]++ ], LINE_SIZE, "%s", line );
+    }
+}
+
+static void done_cb ( at_cmd_t *cmd )
+{
+    done_calls[ ( uintptr_t ) cmd->ref ]++;
+    done_at_us[ ( uintptr_t ) cmd->ref ] = hal_sim_time_us;
+}
+
+static void open_modem ( uint32_t seed )
+{
+    modem_cfg_t cfg;
+
+    hal_sim_reset( );
+    hal_sim_uart_write = uart_write_hook;
+    hal_sim_uart_read = uart_read_hook;
+    hal_sim_uart_bytes_available = uart_bytes_available_hook;
+    memset( &modem, 0, sizeof( modem ) );
+    modem.rng = seed;
+    memset( urc_got, 0, sizeof( urc_got ) );
+    memset( n_got_lines, 0, sizeof( n_got_lines ) );
+    memset( done_calls, 0, sizeof( done_calls ) );
+    urc_in_line_cb = 0;
+
+    modem_cfg_setup( &cfg );
+    modem_init( &ctx, &cfg );
+    at_init( &ctx );
+    at_set_urc_table( &ctx, urc_table, 2 );
+}
+
+// Splits "AT+X=p" into the command and parameter fields, as an application sets them
+static void cmd_setup ( at_cmd_t *cmd, char *text, uint8_t idx )
+{
+    char *eq = strchr( text, '=' );
+
+    memset( cmd, 0, sizeof( at_cmd_t ) );
+    if ( eq )
+    {
+        *eq = 0;
+        cmd->param = eq + 1;
+    }
+    cmd->cmd = text;
+    cmd->line = line_cb;
+    cmd->done = done_cb;
+    cmd->ref = ( void * ) ( uintptr_t ) idx;
+}
+
+// Main loop with a 1 ms tick until all commands are done, returns the time in ms
+static uint32_t run_engine ( at_cmd_t *cmds, uint8_t n_cmds, uint32_t limit_ms )
+{
+    uint8_t submitted = 0;
+    uint32_t t_ms = 0;
+
+    for ( ; t_ms < limit_ms; t_ms++ )
+    {
+        uint8_t all_done = 1;
+
+        hal_sim_time_us = ( uint64_t ) t_ms * 1000;
+        while ( ( submitted < n_cmds ) && ( MODEM_OK == at_submit( &ctx, &cmds[ submitted ] ) ) )
+        {
+            submitted++;
+        }
+        at_process( &ctx, t_ms );
+        if ( hal_sim_time_us != ( uint64_t ) t_ms * 1000 )
+        {
+            printf( "FAIL: %s at_process blocks for %u us\n", DRIVER_NAME,
+                    ( unsigned ) ( hal_sim_time_us - ( uint64_t ) t_ms * 1000 ) );
+            failures++;
+            return t_ms;
+        }
+        for ( uint8_t cnt = 0; cnt < n_cmds; cnt++ )
+        {
+            all_done &= ( cnt < submitted ) && ( AT_STATUS_PENDING != cmds[ cnt ].status );
+        }
+        if ( all_done )
+        {
+            break;
+        }
+    }
+    return t_ms;
+}
+
+// ------------------------------------------------------------------- LEGACY
+
+static char app_buf[ LEGACY_BUF_SIZE ];
+static int32_t app_buf_len;
+
+// ltecat1eu_process of the example
+static void legacy_process ( void )
+{
+    char rx_buff[ LEGACY_BUF_SIZE ] = { 0 };
+    int32_t rx_size = modem_generic_read( &ctx, rx_buff, LEGACY_BUF_SIZE );
+
+    if ( rx_size > 0 )
+    {
+        if ( app_buf_len + rx_size >= LEGACY_BUF_SIZE )
+        {
+            memset( app_buf, 0, sizeof( app_buf ) );
+            app_buf_len = 0;
+        }
+        for ( int32_t cnt = 0; cnt < rx_size; cnt++ )
+        {
+            if ( rx_buff[ cnt ] )
+            {
+                app_buf[ app_buf_len++ ] = rx_buff[ cnt ];
+            }
+        }
+    }
+}
+
+// Blocking send, strstr polling every 1 ms and the fixed delay, as the example
+static uint32_t run_legacy ( void )
+{
+    char cmd[ LINE_SIZE ];
+
+    hal_sim_time_us = 0;
+    for ( uint8_t cnt = 0; cnt < BRING_UP_CMDS; cnt++ )
+    {
+        strcpy( cmd, bring_up[ cnt ].cmd );
+        modem_send_cmd( &ctx, cmd );
+        legacy_process( );
+        while ( !strstr( app_buf, "OK" ) && !strstr( app_buf, "ERROR" ) )
+        {
+            legacy_process( );
+            Delay_ms( 1 );
+        }
+        memset( app_buf, 0, sizeof( app_buf ) );
+        app_buf_len = 0;
+        Delay_ms( bring_up[ cnt ].legacy_delay_ms );
+    }
+    return ( uint32_t ) ( hal_sim_time_us / 1000 );
+}
+
+// ------------------------------------------------------------------- CHECKS
+
+static void check_bring_up ( void )
+{
+    static at_cmd_t cmds[ BRING_UP_CMDS ];
+    static char text[ BRING_UP_CMDS ][ LINE_SIZE ];
+    uint32_t engine_ms;
+    uint32_t legacy_ms;
+    uint32_t urcs;
+
+    open_modem( 21 );
+    for ( uint8_t cnt = 0; cnt < BRING_UP_CMDS; cnt++ )
+    {
+        strcpy( text[ cnt ], bring_up[ cnt ].cmd );
+        cmd_setup( &cmds[ cnt ], text[ cnt ], cnt );
+        cmds[ cnt ].timeout_ms = 3000;
+    }
+    engine_ms = run_engine( cmds, BRING_UP_CMDS, 60000 );
+
+    for ( uint8_t cnt = 0; cnt < BRING_UP_CMDS; cnt++ )
+    {
+        const modem_cmd_t *mc = &bring_up[ cnt ];
+        uint8_t n_lines = 0;
+
+        if ( ( cnt >= modem.n_received ) || strcmp( modem.received[ cnt ], mc->cmd ) )
+        {
+            printf( "FAIL: %s command %u reaches the modem as \"%s\", sent as \"%s\"\n", DRIVER_NAME, cnt,
+                    ( cnt < modem.n_received ) ? modem.received[ cnt ] : "", mc->cmd );
+            failures++;
+        }
+        if ( ( AT_STATUS_OK != cmds[ cnt ].status ) || ( 1 != done_calls[ cnt ] ) )
+        {
+            printf( "FAIL: %s %s completes with status %u and %u done callbacks\n", DRIVER_NAME, mc->cmd,
+                    cmds[ cnt ].status, done_calls[ cnt ] );
+            failures++;
+        }
+        while ( ( n_lines < 4 ) && mc->lines[ n_lines ] )
+        {
+            if ( ( n_lines >= n_got_lines[ cnt ] ) || strcmp( got_lines[ cnt ][ n_lines ], mc->lines[ n_lines ] ) )
+            {
+                printf( "FAIL: %s %s line %u is \"%s\", expected \"%s\"\n", DRIVER_NAME, mc->cmd, n_lines,
+                        ( n_lines < n_got_lines[ cnt ] ) ? got_lines[ cnt ][ n_lines ] : "", mc->lines[ n_lines ] );
+                failures++;
+            }
+            n_lines++;
+        }
+        if ( n_got_lines[ cnt ] != n_lines )
+        {
+            printf( "FAIL: %s %s gets %u lines, expected %u\n", DRIVER_NAME, mc->cmd, n_got_lines[ cnt ], n_lines );
+            failures++;
+        }
+    }
+    urcs = modem.urc_sent[ 0 ] + modem.urc_sent[ 1 ];
+    if ( ( urc_got[ 0 ] != modem.urc_sent[ 0 ] ) || ( urc_got[ 1 ] != modem.urc_sent[ 1 ] ) || urc_in_line_cb || !urcs )
+    {
+        printf( "FAIL: %s URC handlers get %u/%u and %u/%u, line callbacks %u\n", DRIVER_NAME,
+                urc_got[ 0 ], modem.urc_sent[ 0 ], urc_got[ 1 ], modem.urc_sent[ 1 ], urc_in_line_cb );
+        failures++;
+    }
+
+    open_modem( 21 );
+    legacy_ms = run_legacy( );
+    printf( "%-12s bring-up of %u commands: engine %u ms, example flow %u ms (%.1fx), %u URCs dispatched\n",
+            DRIVER_NAME, ( unsigned ) BRING_UP_CMDS, engine_ms, legacy_ms, ( double ) legacy_ms / engine_ms, urcs );
+    if ( engine_ms >= legacy_ms )
+    {
+        printf( "FAIL: %s engine is not faster than the example flow\n", DRIVER_NAME );
+        failures++;
+    }
+}
+
+static void check_results ( void )
+{
+    static at_cmd_t cmds[ 5 ];
+    static char text[ 5 ][ LINE_SIZE ];
+    static const uint8_t payload[ 12 ] = "hello\r\nworld";
+    at_cmd_t extra;
+    uint32_t timeout_ms;
+    uint32_t t_ms;
+
+    open_modem( 5 );
+    strcpy( text[ 0 ], other_cmds[ 0 ].cmd );
+    strcpy( text[ 1 ], other_cmds[ 1 ].cmd );
+    strcpy( text[ 2 ], other_cmds[ 2 ].cmd );
+    strcpy( text[ 3 ], other_cmds[ 3 ].cmd );
+    strcpy( text[ 4 ], "AT" );
+    for ( uint8_t cnt = 0; cnt < 5; cnt++ )
+    {
+        cmd_setup( &cmds[ cnt ], text[ cnt ], cnt );
+    }
+    cmds[ 2 ].timeout_ms = 300;
+    cmds[ 3 ].data = payload;
+    cmds[ 3 ].data_len = sizeof( payload );
+
+    /* Queue holds AT_QUEUE_SIZE commands, one more is refused */
+    for ( uint8_t cnt = 0; cnt < AT_QUEUE_SIZE; cnt++ )
+    {
+        if ( MODEM_OK != at_submit( &ctx, &cmds[ cnt ] ) )
+        {
+            printf( "FAIL: %s queue refuses command %u\n", DRIVER_NAME, cnt );
+            failures++;
+        }
+    }
+    cmd_setup( &extra, text[ 4 ], 4 );
+    if ( MODEM_OK == at_submit( &ctx, &extra ) )
+    {
+        printf( "FAIL: %s queue takes more than %u commands\n", DRIVER_NAME, AT_QUEUE_SIZE );
+        failures++;
+    }
+    t_ms = run_engine( &cmds[ 4 ], 1, 5000 );
+
+    if ( ( AT_STATUS_CME_ERROR != cmds[ 0 ].status ) || ( 566 != cmds[ 0 ].err_code ) )
+    {
+        printf( "FAIL: %s +CME ERROR completes with status %u code %d\n", DRIVER_NAME, cmds[ 0 ].status, cmds[ 0 ].err_code );
+        failures++;
+    }
+    if ( ( AT_STATUS_ERROR != cmds[ 1 ].status ) || ( -1 != cmds[ 1 ].err_code ) )
+    {
+        printf( "FAIL: %s ERROR completes with status %u code %d\n", DRIVER_NAME, cmds[ 1 ].status, cmds[ 1 ].err_code );
+        failures++;
+    }
+    timeout_ms = ( uint32_t ) ( ( done_at_us[ 2 ] - modem.silent_at_us ) / 1000 );
+    if ( ( AT_STATUS_TIMEOUT != cmds[ 2 ].status ) || ( timeout_ms < 298 ) || ( timeout_ms > 302 ) )
+    {
+        printf( "FAIL: %s silent command completes with status %u after %u ms\n", DRIVER_NAME,
+                cmds[ 2 ].status, timeout_ms );
+        failures++;
+    }
+    if ( ( AT_STATUS_OK != cmds[ 3 ].status ) || ( sizeof( payload ) != modem.data_len ) ||
+         memcmp( modem.data, payload, sizeof( payload ) ) )
+    {
+        printf( "FAIL: %s prompt data completes with status %u, %u of %u bytes\n", DRIVER_NAME, cmds[ 3 ].status,
+                modem.data_len, ( unsigned ) sizeof( payload ) );
+        failures++;
+    }
+    if ( AT_STATUS_OK != cmds[ 4 ].status )
+    {
+        printf( "FAIL: %s command after the timeout completes with status %u\n", DRIVER_NAME, cmds[ 4 ].status );
+        failures++;
+    }
+    for ( uint8_t cnt = 0; cnt < 5; cnt++ )
+    {
+        if ( n_got_lines[ cnt ] || ( 1 != done_calls[ cnt ] ) )
+        {
+            printf( "FAIL: %s command %u gets %u lines, first \"%s\", and %u done callbacks\n", DRIVER_NAME, cnt,
+                    n_got_lines[ cnt ], n_got_lines[ cnt ] ? got_lines[ cnt ][ 0 ] : "", done_calls[ cnt ] );
+            failures++;
+        }
+    }
+    printf( "%-12s +CME ERROR %d, ERROR, %u ms timeout, %u prompt bytes and queue release done in %u ms\n",
+            DRIVER_NAME, cmds[ 0 ].err_code, timeout_ms, modem.data_len, t_ms );
+}
+
+int main ( void )
+{
+    check_bring_up( );
+    check_results( );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,521 @@
+/*
+ * AT engine socket receive path: framing, decoding and sustained download.
+ *
+ * The LTE Cat.1-EU driver is built by default and the LTE IoT 2 driver when
+ * LTEIOT2_BUILD is set. The modem model on the UART hooks answers socket
+ * read commands in the header styles the engine supports. +QIRD puts the
+ * data on the next line, in binary or lower case hex. +CARECV puts binary
+ * data inline after the length. +USORD puts upper case hex data inline in
+ * quotes. The binary payloads carry "\r\nOK\r\n" and a +QIURC line, which
+ * the engine must not frame. Bytes arrive at 115200 baud and wait in a
+ * receive ring of DRV_RX_BUFFER_SIZE bytes, like the driver's UART ring
+ * buffer.
+ *
+ * Every read must deliver exactly the payload, to the caller buffer or in
+ * chunks to the data callback. Data beyond the buffer must be dropped with
+ * the stream kept in sync, so that the command after it still completes.
+ * The URC must reach only its handler and no line may reach the command.
+ * A 48000 byte download in 1500 byte reads runs with a 1 ms and a 10 ms
+ * main loop. It must never hold more than the ring size and must reach 80%
+ * of the line rate, with at least 90% of the payload read straight into
+ * the caller buffer.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_sim.h"
+
+#ifdef LTEIOT2_BUILD
+#include "lteiot2.h"
+
+#define DRIVER_NAME             "LTE IoT 2"
+#define modem_t                 lteiot2_t
+#define modem_cfg_t             lteiot2_cfg_t
+#define modem_cfg_setup         lteiot2_cfg_setup
+#define modem_init              lteiot2_init
+#define at_cmd_t                lteiot2_at_cmd_t
+#define at_urc_t                lteiot2_at_urc_t
+#define at_init                 lteiot2_at_init
+#define at_set_urc_table        lteiot2_at_set_urc_table
+#define at_submit               lteiot2_at_submit
+#define at_process              lteiot2_at_process
+#define AT_STATUS_OK            LTEIOT2_AT_STATUS_OK
+#define AT_STATUS_PENDING       LTEIOT2_AT_STATUS_PENDING
+#define AT_RX_HEX               LTEIOT2_AT_RX_HEX
+#define AT_RX_INLINE            LTEIOT2_AT_RX_INLINE
+#define AT_RX_QUOTED            LTEIOT2_AT_RX_QUOTED
+#define MODEM_OK                LTEIOT2_OK
+#else
+#include "ltecat1eu.h"
+
+#define DRIVER_NAME             "LTE Cat.1-EU"
+#define modem_t                 ltecat1eu_t
+#define modem_cfg_t             ltecat1eu_cfg_t
+#define modem_cfg_setup         ltecat1eu_cfg_setup
+#define modem_init              ltecat1eu_init
+#define at_cmd_t                ltecat1eu_at_cmd_t
+#define at_urc_t                ltecat1eu_at_urc_t
+#define at_init                 ltecat1eu_at_init
+#define at_set_urc_table        ltecat1eu_at_set_urc_table
+#define at_submit               ltecat1eu_at_submit
+#define at_process              ltecat1eu_at_process
+#define AT_STATUS_OK            LTECAT1EU_AT_STATUS_OK
+#define AT_STATUS_PENDING       LTECAT1EU_AT_STATUS_PENDING
+#define AT_RX_HEX               LTECAT1EU_AT_RX_HEX
+#define AT_RX_INLINE            LTECAT1EU_AT_RX_INLINE
+#define AT_RX_QUOTED            LTECAT1EU_AT_RX_QUOTED
+#define MODEM_OK                LTECAT1EU_OK
+#endif
+
+#define CHAR_US             ( 10 * 1e6 / 115200 )
+#define RING_SIZE           DRV_RX_BUFFER_SIZE
+#define OUT_SIZE            8192
+#define LINE_SIZE           64
+#define PAYLOAD_MAX         1500
+#define DOWNLOAD_READS      32
+
+/* Response styles of the modem model */
+#define FMT_QIRD            0
+#define FMT_QIRD_HEX        1
+#define FMT_CARECV          2
+#define FMT_USORD_HEX       3
+
+static struct
+{
+    char in[ LINE_SIZE ];
+    uint16_t in_len;
+    uint8_t fmt;
+    uint8_t payload[ PAYLOAD_MAX ];
+    uint16_t payload_len;
+    uint8_t out[ OUT_SIZE ];
+    uint64_t out_at[ OUT_SIZE ];
+    uint32_t out_len;
+    uint32_t out_pos;
+    uint64_t out_free_us;
+    uint32_t peak;
+    uint32_t direct;
+    uint32_t urc_sent;
+    uint32_t rng;
+} modem;
+
+static modem_t ctx;
+static uint8_t *direct_buf;
+static uint16_t direct_size;
+static uint8_t chunks[ PAYLOAD_MAX ];
+static uint16_t chunks_len;
+static uint32_t n_chunks;
+static uint32_t urc_got;
+static uint32_t lines_got;
+
+static int failures;
+
+// ------------------------------------------------------------------- MODEM
+
+static uint32_t rng ( void )
+{
+    modem.rng = modem.rng * 1664525u + 1013904223u;
+    return modem.rng >> 8;
+}
+
+// Characters leave the modem back to back, starting no earlier than at_us
+static void modem_out ( const char *text, size_t len, uint64_t at_us )
+{
+    double t = ( at_us > modem.out_free_us ) ? at_us : modem.out_free_us;
+
+    // Drops what the test has already read, the buffer only holds one response
+    if ( modem.out_pos == modem.out_len )
+    {
+        modem.out_pos = 0;
+        modem.out_len = 0;
+    }
+    for ( size_t cnt = 0; ( cnt < len ) && ( modem.out_len < OUT_SIZE ); cnt++ )
+    {
+        t += CHAR_US;
+        modem.out[ modem.out_len ] = ( uint8_t ) text[ cnt ];
+        modem.out_at[ modem.out_len++ ] = ( uint64_t ) t;
+    }
+    modem.out_free_us = ( uint64_t ) t;
+}
+
+static void modem_text ( const char *text, uint64_t at_us )
+{
+    modem_out( text, strlen( text ), at_us );
+}
+
+// +QIRD hex is lower case, +USORD upper case
+static void modem_hex ( const uint8_t *data_in, uint16_t len, uint64_t at_us )
+{
+    char hex[ 3 ];
+
+    for ( uint16_t cnt = 0; cnt < len; cnt++ )
+    {
+        sprintf( hex, ( FMT_USORD_HEX == modem.fmt ) ? "%02X" : "%02x", data_in[ cnt ] );
+        modem_out( hex, 2, at_us );
+    }
+}
+
+static void modem_command ( uint64_t at_us )
+{
+    char header[ LINE_SIZE ];
+    uint16_t len = modem.payload_len;
+    const uint8_t *data_in = modem.payload;
+
+    at_us += 2000;
+    if ( 0 == strcmp( modem.in, "AT" ) )
+    {
+        modem_text( "\r\nOK\r\n", at_us );
+        return;
+    }
+    // A socket data URC ahead of the response
+    modem_text( "\r\n+QIURC: \"recv\",0\r\n", at_us );
+    modem.urc_sent++;
+    switch ( modem.fmt )
+    {
+        case FMT_QIRD:
+        case FMT_QIRD_HEX:
+        {
+            sprintf( header, "\r\n+QIRD: %u\r\n", len );
+            modem_text( header, at_us );
+            if ( FMT_QIRD == modem.fmt )
+            {
+                modem_out( ( const char * ) data_in, len, at_us );
+            }
+            else
+            {
+                modem_hex( data_in, len, at_us );
+            }
+            break;
+        }
+        case FMT_CARECV:
+        {
+            sprintf( header, len ? "\r\n+CARECV: %u," : "\r\n+CARECV: %u", len );
+            modem_text( header, at_us );
+            modem_out( ( const char * ) data_in, len, at_us );
+            break;
+        }
+        default:
+        {
+            sprintf( header, "\r\n+USORD: 0,%u,\"", len );
+            modem_text( header, at_us );
+            modem_hex( data_in, len, at_us );
+            modem_text( "\"", at_us );
+            break;
+        }
+    }
+    modem_text( "\r\n\r\nOK\r\n", at_us );
+}
+
+static err_t uart_write_hook ( void *obj, char *buffer, size_t size )
+{
+    ( void ) obj;
+    for ( size_t cnt = 0; cnt < size; cnt++ )
+    {
+        uint64_t at_us = hal_sim_time_us + ( uint64_t ) ( ( cnt + 1 ) * CHAR_US );
+        char chr = buffer[ cnt ];
+
+        if ( '\n' == chr )
+        {
+            continue;
+        }
+        modem_out( &chr, 1, at_us );
+        if ( '\r' == chr )
+        {
+            modem.in[ modem.in_len ] = 0;
+            if ( modem.in_len )
+            {
+                modem_command( at_us );
+            }
+            modem.in_len = 0;
+        }
+        else if ( modem.in_len < ( LINE_SIZE - 1 ) )
+        {
+            modem.in[ modem.in_len++ ] = chr;
+        }
+    }
+    return ( err_t ) size;
+}
+
+static size_t uart_bytes_available_hook ( void *obj )
+{
+    size_t len = 0;
+
+    ( void ) obj;
+    while ( ( modem.out_pos + len < modem.out_len ) && ( modem.out_at[ modem.out_pos + len ] <= hal_sim_time_us ) )
+    {
+        len++;
+    }
+    return len;
+}
+
+static err_t uart_read_hook ( void *obj, char *buffer, size_t size )
+{
+    size_t held = uart_bytes_available_hook( obj );
+    size_t len = 0;
+
+    // Everything that arrived since the last read waits in the ring
+    if ( held > modem.peak )
+    {
+        modem.peak = held;
+    }
+    while ( ( len < size ) && ( len < held ) )
+    {
+        buffer[ len++ ] = ( char ) modem.out[ modem.out_pos++ ];
+    }
+    if ( direct_buf && ( ( uint8_t * ) buffer >= direct_buf ) && ( ( uint8_t * ) buffer < &direct_buf[ direct_size ] ) )
+    {
+        modem.direct += len;
+    }
+    return ( err_t ) len;
+}
+
+// ------------------------------------------------------------------- HOST
+
+static void urc_handler ( char *line, void *ref )
+{
+    ( void ) ref;
+    if ( strcmp( line, "+QIURC: \"recv\",0" ) )
+    {
+        printf( "FAIL: %s URC handler gets \"%s\"\n", DRIVER_NAME, line );
+        failures++;
+    }
+    urc_got++;
+}
+
+static const at_urc_t urc_table[ ] =
+{
+    { "+QIURC:", urc_handler, NULL },
+};
+
+static void line_cb ( at_cmd_t *cmd, char *line )
+{
+    ( void ) cmd;
+    ( void ) line;
+    lines_got++;
+}
+
+static void rx_cb ( at_cmd_t *cmd, uint8_t *data_in, uint16_t len )
+{
+    ( void ) cmd;
+    if ( chunks_len + len <= PAYLOAD_MAX )
+    {
+        memcpy( &chunks[ chunks_len ], data_in, len );
+    }
+    chunks_len += len;
+    n_chunks++;
+}
+
+static void open_modem ( void )
+{
+    modem_cfg_t cfg;
+
+    hal_sim_reset( );
+    hal_sim_uart_write = uart_write_hook;
+    hal_sim_uart_read = uart_read_hook;
+    hal_sim_uart_bytes_available = uart_bytes_available_hook;
+    memset( &modem, 0, sizeof( modem ) );
+    modem.rng = 22;
+    urc_got = 0;
+    lines_got = 0;
+
+    modem_cfg_setup( &cfg );
+    modem_init( &ctx, &cfg );
+    at_init( &ctx );
+    at_set_urc_table( &ctx, urc_table, 1 );
+}
+
+// Random payload with a result code and a URC inside
+static void make_payload ( uint16_t len )
+{
+    static const char inner[ ] = "\r\nOK\r\n+QIURC: \"closed\",0\r\n";
+
+    for ( uint16_t cnt = 0; cnt < len; cnt++ )
+    {
+        modem.payload[ cnt ] = ( uint8_t ) rng( );
+    }
+    if ( len > sizeof( inner ) + 8 )
+    {
+        memcpy( &modem.payload[ 8 ], inner, sizeof( inner ) - 1 );
+    }
+    modem.payload_len = len;
+}
+
+// Main loop with a period_ms tick until the command is done, returns the time in ms
+static uint32_t run ( at_cmd_t *cmd, uint32_t t_ms, uint32_t period_ms )
+{
+    uint32_t start_ms = t_ms;
+
+    while ( MODEM_OK != at_submit( &ctx, cmd ) )
+    {
+        t_ms += period_ms;
+    }
+    while ( ( AT_STATUS_PENDING == cmd->status ) && ( ( t_ms - start_ms ) < 10000 ) )
+    {
+        hal_sim_time_us = ( uint64_t ) t_ms * 1000;
+        at_process( &ctx, t_ms );
+        t_ms += period_ms;
+    }
+    return t_ms;
+}
+
+static void cmd_setup ( at_cmd_t *cmd, const char *text, const char *param, uint8_t fmt )
+{
+    memset( cmd, 0, sizeof( at_cmd_t ) );
+    cmd->cmd = text;
+    cmd->param = param;
+    cmd->line = line_cb;
+    cmd->timeout_ms = 2000;
+    switch ( fmt )
+    {
+        case FMT_QIRD:
+        {
+            cmd->rx_prefix = "+QIRD:";
+            break;
+        }
+        case FMT_QIRD_HEX:
+        {
+            cmd->rx_prefix = "+QIRD:";
+            cmd->rx_mode = AT_RX_HEX;
+            break;
+        }
+        case FMT_CARECV:
+        {
+            cmd->rx_prefix = "+CARECV:";
+            cmd->rx_mode = AT_RX_INLINE;
+            break;
+        }
+        default:
+        {
+            cmd->rx_prefix = "+USORD:";
+            cmd->rx_field = 1;
+            cmd->rx_mode = AT_RX_QUOTED | AT_RX_HEX;
+            break;
+        }
+    }
+    modem.fmt = fmt;
+}
+
+// ------------------------------------------------------------------- CHECKS
+
+static void check_read ( const char *name, uint8_t fmt, uint16_t len, uint16_t rx_size, uint8_t use_cb )
+{
+    static uint8_t buf[ PAYLOAD_MAX ];
+    static const char * const text[ ] = { "AT+QIRD", "AT+QIRD", "AT+CARECV", "AT+USORD" };
+    uint16_t want = ( len < rx_size ) ? len : rx_size;
+    at_cmd_t cmd;
+    at_cmd_t sync;
+    uint32_t t_ms;
+
+    open_modem( );
+    make_payload( len );
+    memset( buf, 0, sizeof( buf ) );
+    chunks_len = 0;
+    n_chunks = 0;
+    cmd_setup( &cmd, text[ fmt ], "0,1500", fmt );
+    if ( use_cb )
+    {
+        cmd.rx = rx_cb;
+        want = len;
+    }
+    else
+    {
+        cmd.rx_buf = buf;
+        cmd.rx_size = rx_size;
+    }
+    t_ms = run( &cmd, 0, 1 );
+
+    // The stream has to stay in sync for the next command
+    memset( &sync, 0, sizeof( sync ) );
+    sync.cmd = "AT";
+    run( &sync, t_ms, 1 );
+
+    if ( ( AT_STATUS_OK != cmd.status ) || ( cmd.rx_len != want ) ||
+         memcmp( use_cb ? chunks : buf, modem.payload, want ) || ( use_cb && ( chunks_len != len ) ) )
+    {
+        printf( "FAIL: %s %s completes with status %u and %u of %u bytes\n", DRIVER_NAME, name,
+                cmd.status, cmd.rx_len, want );
+        failures++;
+    }
+    if ( ( AT_STATUS_OK != sync.status ) || lines_got || ( urc_got != modem.urc_sent ) )
+    {
+        printf( "FAIL: %s %s leaves the next command with status %u, %u lines, %u of %u URCs\n", DRIVER_NAME,
+                name, sync.status, lines_got, urc_got, modem.urc_sent );
+        failures++;
+    }
+    printf( "%-12s %-34s %5u bytes in %3u ms%s\n", DRIVER_NAME, name, cmd.rx_len, t_ms,
+            use_cb ? ", data callback" : "" );
+}
+
+static void check_download ( uint32_t period_ms )
+{
+    static uint8_t buf[ PAYLOAD_MAX ];
+    at_cmd_t cmd;
+    uint32_t t_ms = 0;
+    uint32_t total = 0;
+    uint32_t line_rate;
+    uint32_t rate;
+
+    open_modem( );
+    direct_buf = buf;
+    direct_size = sizeof( buf );
+    // The application submits the same command object for every read
+    cmd_setup( &cmd, "AT+QIRD", "0,1500", FMT_QIRD );
+    cmd.rx_buf = buf;
+    cmd.rx_size = sizeof( buf );
+    for ( uint8_t cnt = 0; cnt < DOWNLOAD_READS; cnt++ )
+    {
+        make_payload( PAYLOAD_MAX );
+        t_ms = run( &cmd, t_ms, period_ms );
+        if ( ( AT_STATUS_OK != cmd.status ) || ( PAYLOAD_MAX != cmd.rx_len ) || memcmp( buf, modem.payload, PAYLOAD_MAX ) )
+        {
+            printf( "FAIL: %s download read %u completes with status %u and %u bytes\n", DRIVER_NAME, cnt,
+                    cmd.status, cmd.rx_len );
+            failures++;
+        }
+        total += cmd.rx_len;
+    }
+    direct_buf = NULL;
+
+    rate = ( uint32_t ) ( ( uint64_t ) total * 1000 / t_ms );
+    line_rate = ( uint32_t ) ( 1e6 / CHAR_US );
+    printf( "%-12s %u byte download, %2u ms loop: %u B/s of %u B/s line rate, ring peak %u of %u, "
+            "%.1f%% read straight into the caller buffer\n", DRIVER_NAME, total, period_ms, rate, line_rate,
+            modem.peak, RING_SIZE, 100.0 * modem.direct / total );
+    if ( modem.peak > RING_SIZE )
+    {
+        printf( "FAIL: %s ring overflows with a %u ms loop\n", DRIVER_NAME, period_ms );
+        failures++;
+    }
+    if ( modem.direct < ( total * 9 / 10 ) )
+    {
+        printf( "FAIL: %s less than 90%% of the download is read straight into the caller buffer\n", DRIVER_NAME );
+        failures++;
+    }
+    if ( rate < ( line_rate * 8 / 10 ) )
+    {
+        printf( "FAIL: %s download runs below 80%% of the line rate\n", DRIVER_NAME );
+        failures++;
+    }
+}
+
+int main ( void )
+{
+    check_read( "+QIRD binary", FMT_QIRD, 1500, 1500, 0 );
+    check_read( "+QIRD binary short of the buffer", FMT_QIRD, 1000, 1500, 0 );
+    check_read( "+QIRD binary", FMT_QIRD, 1500, 1500, 1 );
+    check_read( "+QIRD hex", FMT_QIRD_HEX, 700, 700, 0 );
+    check_read( "+QIRD hex", FMT_QIRD_HEX, 700, 700, 1 );
+    check_read( "+CARECV inline binary", FMT_CARECV, 300, 300, 0 );
+    check_read( "+CARECV inline short of the buffer", FMT_CARECV, 300, 1500, 0 );
+    check_read( "+USORD quoted hex", FMT_USORD_HEX, 200, 200, 0 );
+    check_read( "+USORD quoted hex", FMT_USORD_HEX, 200, 200, 1 );
+    check_read( "+QIRD past a 256 byte buffer", FMT_QIRD, 600, 256, 0 );
+    check_read( "+QIRD hex past a 256 byte buffer", FMT_QIRD_HEX, 600, 256, 0 );
+    check_read( "+CARECV past a 256 byte buffer", FMT_CARECV, 600, 256, 0 );
+    check_read( "+QIRD empty", FMT_QIRD, 0, 256, 0 );
+    check_read( "+CARECV empty", FMT_CARECV, 0, 256, 0 );
+    check_download( 1 );
+    check_download( 10 );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
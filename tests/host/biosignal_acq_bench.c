@@ -0,0 +1,734 @@
+/*
+ * Biosignal block acquisition: sampling grid, filter chain and QRS detection.
+ *
+ * The ECG 5, EEG and EMG drivers sample through the analog input hook and
+ * ECG 7 through two byte MCP3221 reads on the I2C hook. Every conversion
+ * returns a synthetic 12-bit signal at the simulated time of the timer
+ * tick and is kept in a log. The test plays the timer and calls acq_tick
+ * at the sample rate, the main loop fetches every finished block.
+ *
+ * Every tick has to take exactly one conversion and every 64 ticks have
+ * to give one block. Each block has to match a double precision model of
+ * the same DC removal, notch and band-pass chain fed with the logged
+ * conversions, within a count. On a tone inside the band with mains hum,
+ * wander or a motion artefact below the band and a DC offset, the tone
+ * has to pass at unity gain and the hum, the low band component and the
+ * offset have to be removed, with the notch on 50 Hz and on 60 Hz. A
+ * main loop that falls behind has to be told how many blocks it lost and
+ * get the newest one. Invalid rates and band edges are refused.
+ *
+ * The ECG drivers then run the QRS detector on a synthetic ECG with P, QRS
+ * and T waves, wander, hum and noise at 250, 500 and 1000 Hz and from 40
+ * to 150 bpm. After the 2 s learning period every R wave has to be found
+ * once, shortly after its peak, with no false detections, and the heart
+ * rate has to match. Complexes too small for the threshold have to be
+ * found by search back. Learning on noise or on an in band tone, which
+ * leaves the noise estimate above the signal estimate, must not stop the
+ * detector from finding the beats that follow the ECG onset.
+ */
+#include "ecg5.h"
+#include "ecg7.h"
+#include "eeg.h"
+#include "emg.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ACQ_PI              3.14159265358979
+#define BLOCK_SIZE          64
+#define ADC_MAX             4095
+#define MAX_LOG             ( 1000 * 70 + 1 )
+#define FILTER_FS           500
+#define FILTER_SECONDS      20
+#define FILTER_WINDOW_S     10
+#define QRS_SECONDS         60
+#define QRS_LEARN_S         2.0
+#define QRS_LAG_MIN_S       -0.05
+#define QRS_LAG_MAX_S       0.25
+#define AFTER_ONSET_S       30
+#define TONE_FADE_S         0.2
+#define MAX_BEATS           400
+
+typedef struct
+{
+    const char *name;
+    uint8_t has_qrs;
+    uint8_t i2c;
+    float band_low;
+    float band_high;
+    double tone_hz;
+    double low_hz;
+    err_t ( *start )( uint16_t fs, uint8_t mains, float band_low, float band_high );
+    void ( *tick )( void );
+    err_t ( *get_block )( int32_t *data_out );
+    uint16_t ( *overrun )( void );
+    err_t ( *qrs_start )( void );
+    uint8_t ( *qrs_process )( int32_t *data_in, uint16_t len );
+    err_t ( *heart_rate )( float *heart_rate );
+    uint32_t ( *last_qrs )( void );
+} driver_t;
+
+#define ACQ_WRAPPERS( lib )                                                                         \
+    static lib##_t lib##_ctx;                                                                       \
+    static err_t lib##_start ( uint16_t fs, uint8_t mains, float band_low, float band_high )       \
+    {                                                                                               \
+        return lib##_acq_start( &lib##_ctx, fs, mains, band_low, band_high );                       \
+    }                                                                                               \
+    static void lib##_tick ( void ) { lib##_acq_tick( &lib##_ctx ); }                               \
+    static err_t lib##_get_block ( int32_t *data_out ) { return lib##_acq_get_block( &lib##_ctx, data_out ); } \
+    static uint16_t lib##_overrun ( void ) { return lib##_ctx.acq.overrun; }
+
+#define QRS_WRAPPERS( lib )                                                                         \
+    static err_t lib##_qrs ( void ) { return lib##_qrs_start( &lib##_ctx ); }                       \
+    static uint8_t lib##_process ( int32_t *data_in, uint16_t len )                                 \
+    {                                                                                               \
+        return lib##_qrs_process( &lib##_ctx, data_in, len );                                       \
+    }                                                                                               \
+    static err_t lib##_heart_rate ( float *heart_rate )                                             \
+    {                                                                                               \
+        return lib##_qrs_get_heart_rate( &lib##_ctx, heart_rate );                                  \
+    }                                                                                               \
+    static uint32_t lib##_last_qrs ( void ) { return lib##_ctx.qrs.last_qrs; }
+
+ACQ_WRAPPERS( ecg5 )
+ACQ_WRAPPERS( ecg7 )
+ACQ_WRAPPERS( eeg )
+ACQ_WRAPPERS( emg )
+QRS_WRAPPERS( ecg5 )
+QRS_WRAPPERS( ecg7 )
+
+static const driver_t drivers[ ] =
+{
+    { "ECG 5", 1, 0, ECG5_ACQ_BAND_LOW_HZ, ECG5_ACQ_BAND_HIGH_HZ, 10, 0.1,
+      ecg5_start, ecg5_tick, ecg5_get_block, ecg5_overrun, ecg5_qrs, ecg5_process, ecg5_heart_rate, ecg5_last_qrs },
+    { "ECG 7", 1, 1, ECG7_ACQ_BAND_LOW_HZ, ECG7_ACQ_BAND_HIGH_HZ, 10, 0.1,
+      ecg7_start, ecg7_tick, ecg7_get_block, ecg7_overrun, ecg7_qrs, ecg7_process, ecg7_heart_rate, ecg7_last_qrs },
+    { "EEG", 0, 0, EEG_ACQ_BAND_LOW_HZ, EEG_ACQ_BAND_HIGH_HZ, 10, 0.1,
+      eeg_start, eeg_tick, eeg_get_block, eeg_overrun, NULL, NULL, NULL, NULL },
+    { "EMG", 0, 0, EMG_ACQ_BAND_LOW_HZ, EMG_ACQ_BAND_HIGH_HZ, 80, 5,
+      emg_start, emg_tick, emg_get_block, emg_overrun, NULL, NULL, NULL, NULL },
+};
+
+#define N_DRIVERS           ( sizeof( drivers ) / sizeof( drivers[ 0 ] ) )
+
+static struct
+{
+    double tone_hz;
+    double tone;
+    double tone_to_s;
+    double mains_hz;
+    double hum;
+    double low_hz;
+    double low;
+    double offset;
+    double bpm;
+    double noise;
+    double ecg_from_s;
+    long weak_every;
+    double weak;
+} sig;
+
+static uint16_t adc_log[ MAX_LOG ];
+static uint32_t adc_count;
+static uint32_t i2c_bad;
+static uint32_t rng_state;
+
+static int32_t out_log[ MAX_LOG ];
+static uint32_t out_count;
+
+static int failures;
+
+// ------------------------------------------------------------------- SIGNAL
+
+static uint32_t rng ( void )
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static double rr_s ( void )
+{
+    return 60.0 / sig.bpm;
+}
+
+// R wave of beat k, the P and T waves move closer to it as the rate goes up
+static double r_time ( long k )
+{
+    return sig.ecg_from_s + k * rr_s( ) + 0.15 * sqrt( rr_s( ) );
+}
+
+static double wave ( double t, double at, double width, double amplitude )
+{
+    double x = ( t - at ) / width;
+    return amplitude * exp( -x * x );
+}
+
+static double ecg ( double t )
+{
+    double scale = sqrt( rr_s( ) );
+    double sum = 0;
+    long beat = ( long ) floor( ( t - sig.ecg_from_s ) / rr_s( ) );
+
+    if ( ( sig.bpm <= 0 ) || ( t < sig.ecg_from_s ) )
+    {
+        return 0;
+    }
+    for ( long k = beat - 1; k <= beat + 1; k++ )
+    {
+        double r = r_time( k );
+        double qrs = 1;
+
+        if ( k < 0 )
+        {
+            continue;
+        }
+        if ( sig.weak_every && ( ( k % sig.weak_every ) == ( sig.weak_every - 1 ) ) )
+        {
+            qrs = sig.weak;
+        }
+        sum += wave( t, r - 0.12 * scale, 0.025, 40 );
+        sum += wave( t, r, 0.012, 600 * qrs );
+        sum += wave( t, r + 0.03, 0.01, -80 * qrs );
+        sum += wave( t, r + 0.25 * scale, 0.04 * scale, 100 );
+    }
+    return sum;
+}
+
+static uint16_t sample_at ( uint64_t time_us )
+{
+    double t = time_us / 1e6;
+    double x = 2048 + sig.offset + ecg( t );
+
+    if ( sig.tone_to_s <= 0 )
+    {
+        x += sig.tone * sin( 2 * ACQ_PI * sig.tone_hz * t );
+    }
+    else if ( t < sig.tone_to_s )
+    {
+        // Fades out over TONE_FADE_S so the end of the tone has no slope step
+        double fade = ( sig.tone_to_s - t ) / TONE_FADE_S;
+
+        fade = ( fade < 1 ) ? ( 0.5 - 0.5 * cos( ACQ_PI * fade ) ) : 1;
+        x += fade * sig.tone * sin( 2 * ACQ_PI * sig.tone_hz * t );
+    }
+    x += sig.hum * sin( 2 * ACQ_PI * sig.mains_hz * t );
+    x += sig.low * sin( 2 * ACQ_PI * sig.low_hz * t );
+    if ( sig.noise > 0 )
+    {
+        x += ( ( double ) ( rng( ) % 2001 ) / 1000.0 - 1.0 ) * sig.noise;
+    }
+    x = floor( x + 0.5 );
+    if ( x < 0 )
+    {
+        x = 0;
+    }
+    else if ( x > ADC_MAX )
+    {
+        x = ADC_MAX;
+    }
+    if ( adc_count < MAX_LOG )
+    {
+        adc_log[ adc_count ] = ( uint16_t ) x;
+    }
+    adc_count++;
+    return ( uint16_t ) x;
+}
+
+static err_t analog_read ( void *obj, uint16_t *value )
+{
+    ( void ) obj;
+    *value = sample_at( hal_sim_time_us );
+    return ADC_SUCCESS;
+}
+
+static err_t i2c_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                            uint8_t *read_buf, size_t read_len )
+{
+    uint16_t value;
+
+    ( void ) obj;
+    ( void ) write_buf;
+    if ( ( ECG7_SET_DEV_ADDR != address ) || write_len || ( 2 != read_len ) )
+    {
+        i2c_bad++;
+        return I2C_MASTER_ERROR;
+    }
+    value = sample_at( hal_sim_time_us );
+    read_buf[ 0 ] = ( uint8_t ) ( value >> 8 );
+    read_buf[ 1 ] = ( uint8_t ) value;
+    return I2C_MASTER_SUCCESS;
+}
+
+// ------------------------------------------------------------------- HOST
+
+static void open_drivers ( void )
+{
+    ecg5_cfg_t ecg5_cfg;
+    ecg7_cfg_t ecg7_cfg;
+    eeg_cfg_t eeg_cfg;
+    emg_cfg_t emg_cfg;
+
+    hal_sim_reset( );
+    hal_sim_analog_read = analog_read;
+    hal_sim_i2c_transfer = i2c_transfer;
+
+    ecg5_cfg_setup( &ecg5_cfg );
+    ecg5_init( &ecg5_ctx, &ecg5_cfg );
+    ecg7_cfg_setup( &ecg7_cfg );
+    ecg7_cfg.drv_sel = ECG7_DRV_SEL_I2C;
+    ecg7_init( &ecg7_ctx, &ecg7_cfg );
+    eeg_cfg_setup( &eeg_cfg );
+    eeg_init( &eeg_ctx, &eeg_cfg );
+    emg_cfg_setup( &emg_cfg );
+    emg_init( &emg_ctx, &emg_cfg );
+}
+
+static void new_signal ( void )
+{
+    memset( &sig, 0, sizeof( sig ) );
+    rng_state = 25;
+}
+
+static void start ( const driver_t *drv, uint16_t fs, uint8_t mains )
+{
+    adc_count = 0;
+    out_count = 0;
+    i2c_bad = 0;
+    hal_sim_time_us = 0;
+    if ( drv->start( fs, mains, drv->band_low, drv->band_high ) )
+    {
+        printf( "FAIL: %s refuses %u Hz\n", drv->name, fs );
+        failures++;
+    }
+}
+
+// Timer tick n samples at ( n + 1 ) / fs, the main loop fetches every finished block
+static void run ( const driver_t *drv, uint16_t fs, uint32_t ticks, uint8_t fetch )
+{
+    for ( uint32_t n = 0; n < ticks; n++ )
+    {
+        hal_sim_time_us = ( ( uint64_t ) ( n + 1 ) * 1000000u ) / fs;
+        drv->tick( );
+        if ( fetch && ( out_count + BLOCK_SIZE <= MAX_LOG ) && !drv->get_block( &out_log[ out_count ] ) )
+        {
+            out_count += BLOCK_SIZE;
+        }
+    }
+}
+
+// ------------------------------------------------------------------- MODEL
+
+typedef struct
+{
+    double b0, b1, b2, a1, a2;
+    double x1, x2, y1, y2;
+} ref_biquad_t;
+
+static void ref_biquad_set ( ref_biquad_t *bq, double b0, double b1, double b2, double a0, double a1, double a2 )
+{
+    memset( bq, 0, sizeof( *bq ) );
+    bq->b0 = b0 / a0;
+    bq->b1 = b1 / a0;
+    bq->b2 = b2 / a0;
+    bq->a1 = a1 / a0;
+    bq->a2 = a2 / a0;
+}
+
+static double ref_biquad_run ( ref_biquad_t *bq, double x )
+{
+    double y = bq->b0 * x + bq->b1 * bq->x1 + bq->b2 * bq->x2 - bq->a1 * bq->y1 - bq->a2 * bq->y2;
+
+    bq->x2 = bq->x1;
+    bq->x1 = x;
+    bq->y2 = bq->y1;
+    bq->y1 = y;
+    return y;
+}
+
+// Largest distance between the filtered blocks and the chain run in double precision
+static double model_error ( const driver_t *drv, uint16_t fs, uint8_t mains )
+{
+    ref_biquad_t notch;
+    ref_biquad_t band;
+    double dc_coef = 1.0 - 2.0 * ACQ_PI * 0.1 / fs;
+    double dc_x1 = adc_log[ 0 ];
+    double dc_y1 = 0;
+    double w_low = tan( ACQ_PI * drv->band_low / fs );
+    double w_high = tan( ACQ_PI * drv->band_high / fs );
+    double bw = w_high - w_low;
+    double w0_sq = w_low * w_high;
+    double worst = 0;
+
+    if ( mains )
+    {
+        double w0 = tan( ACQ_PI * mains / fs );
+
+        ref_biquad_set( &notch, 1 + w0 * w0, 2 * ( w0 * w0 - 1 ), 1 + w0 * w0,
+                        1 + w0 / 8.0 + w0 * w0, 2 * ( w0 * w0 - 1 ), 1 - w0 / 8.0 + w0 * w0 );
+    }
+    else
+    {
+        ref_biquad_set( &notch, 1, 0, 0, 1, 0, 0 );
+    }
+    ref_biquad_set( &band, bw, 0, -bw, 1 + bw + w0_sq, 2 * ( w0_sq - 1 ), 1 - bw + w0_sq );
+
+    for ( uint32_t cnt = 0; cnt < out_count; cnt++ )
+    {
+        double x = adc_log[ 1 + cnt ];
+        double y = x - dc_x1 + dc_coef * dc_y1;
+
+        dc_x1 = x;
+        dc_y1 = y;
+        y = ref_biquad_run( &band, ref_biquad_run( &notch, y ) );
+        if ( fabs( y - out_log[ cnt ] ) > worst )
+        {
+            worst = fabs( y - out_log[ cnt ] );
+        }
+    }
+    return worst;
+}
+
+// Amplitude of one frequency over the last seconds of the output
+static double amplitude ( uint16_t fs, double freq, uint32_t seconds )
+{
+    uint32_t len = ( uint32_t ) fs * seconds;
+    uint32_t first = out_count - len;
+    double re = 0;
+    double im = 0;
+
+    for ( uint32_t cnt = 0; cnt < len; cnt++ )
+    {
+        double t = ( double ) ( first + cnt + 1 ) / fs;
+
+        re += out_log[ first + cnt ] * cos( 2 * ACQ_PI * freq * t );
+        im += out_log[ first + cnt ] * sin( 2 * ACQ_PI * freq * t );
+    }
+    return 2 * sqrt( re * re + im * im ) / len;
+}
+
+static double mean ( uint16_t fs, uint32_t seconds )
+{
+    uint32_t len = ( uint32_t ) fs * seconds;
+    double sum = 0;
+
+    for ( uint32_t cnt = out_count - len; cnt < out_count; cnt++ )
+    {
+        sum += out_log[ cnt ];
+    }
+    return sum / len;
+}
+
+static double db ( double ratio )
+{
+    return 20 * log10( ratio > 1e-9 ? ratio : 1e-9 );
+}
+
+// ------------------------------------------------------------------- CHECKS
+
+static void check_grid ( const driver_t *drv )
+{
+    uint32_t ticks = FILTER_FS * 4;
+
+    new_signal( );
+    sig.tone_hz = drv->tone_hz;
+    sig.tone = 300;
+    start( drv, FILTER_FS, ECG5_ACQ_MAINS_50HZ );
+    run( drv, FILTER_FS, ticks, 1 );
+    if ( ( adc_count != ticks + 1 ) || ( out_count != ticks / BLOCK_SIZE * BLOCK_SIZE ) || drv->overrun( ) || i2c_bad )
+    {
+        printf( "FAIL: %s takes %u conversions for %u ticks and gives %u blocks, %u overruns\n", drv->name,
+                ( unsigned ) adc_count, ( unsigned ) ticks, ( unsigned ) ( out_count / BLOCK_SIZE ), drv->overrun( ) );
+        failures++;
+    }
+
+    /* A main loop that misses ten blocks keeps the newest one, the other nine are counted as lost */
+    {
+        int32_t block[ BLOCK_SIZE ];
+
+        run( drv, FILTER_FS, BLOCK_SIZE * 10, 0 );
+        if ( ( 9 != drv->overrun( ) ) || drv->get_block( block ) || !drv->get_block( block ) )
+        {
+            printf( "FAIL: %s reports %u overruns for 10 missed blocks\n", drv->name, drv->overrun( ) );
+            failures++;
+        }
+    }
+
+    /* Rates and band edges that cannot work */
+    if ( !drv->start( 0, 0, drv->band_low, drv->band_high ) ||
+         !drv->start( FILTER_FS, 0, 0, drv->band_high ) ||
+         !drv->start( FILTER_FS, 0, drv->band_high, drv->band_low ) ||
+         !drv->start( FILTER_FS, 0, drv->band_low, FILTER_FS / 2 ) ||
+         !drv->start( 100, ECG5_ACQ_MAINS_50HZ, drv->band_low, drv->band_high < 45 ? drv->band_high : 45 ) )
+    {
+        printf( "FAIL: %s accepts an invalid rate or band\n", drv->name );
+        failures++;
+    }
+}
+
+static void check_filters ( const driver_t *drv, uint8_t mains )
+{
+    uint32_t ticks = FILTER_FS * FILTER_SECONDS;
+    double tone_gain;
+    double hum_left;
+    double low_left;
+    double offset_left;
+    double error;
+
+    new_signal( );
+    sig.tone_hz = drv->tone_hz;
+    sig.tone = 300;
+    sig.mains_hz = mains;
+    sig.hum = 300;
+    sig.low_hz = drv->low_hz;
+    sig.low = 300;
+    sig.offset = 700;
+    start( drv, FILTER_FS, mains );
+    run( drv, FILTER_FS, ticks, 1 );
+
+    error = model_error( drv, FILTER_FS, mains );
+    tone_gain = amplitude( FILTER_FS, drv->tone_hz, FILTER_WINDOW_S ) / 300;
+    hum_left = amplitude( FILTER_FS, mains, FILTER_WINDOW_S ) / 300;
+    low_left = amplitude( FILTER_FS, drv->low_hz, FILTER_WINDOW_S ) / 300;
+    offset_left = fabs( mean( FILTER_FS, FILTER_WINDOW_S ) );
+
+    printf( "%-5s %u Hz notch: %g Hz tone %+.2f dB, hum %.1f dB, %g Hz %.1f dB, offset %.2f counts, "
+            "model error %.2f counts\n", drv->name, mains, drv->tone_hz, db( tone_gain ), db( hum_left ),
+            drv->low_hz, db( low_left ), offset_left, error );
+
+    if ( error > 1.0 )
+    {
+        printf( "FAIL: %s blocks are %.2f counts off the filter model\n", drv->name, error );
+        failures++;
+    }
+    if ( ( db( tone_gain ) < -0.5 ) || ( db( tone_gain ) > 0.5 ) )
+    {
+        printf( "FAIL: %s passes the %g Hz tone at %.2f dB\n", drv->name, drv->tone_hz, db( tone_gain ) );
+        failures++;
+    }
+    if ( db( hum_left ) > -40 )
+    {
+        printf( "FAIL: %s leaves %u Hz hum at %.1f dB\n", drv->name, mains, db( hum_left ) );
+        failures++;
+    }
+    if ( db( low_left ) > -10 )
+    {
+        printf( "FAIL: %s leaves the %g Hz component at %.1f dB\n", drv->name, drv->low_hz, db( low_left ) );
+        failures++;
+    }
+    if ( offset_left > 1.0 )
+    {
+        printf( "FAIL: %s leaves %.2f counts of offset\n", drv->name, offset_left );
+        failures++;
+    }
+}
+
+// Runs the detector sample by sample so every detection position is seen
+static void run_qrs ( const driver_t *drv, uint16_t fs, uint32_t ticks, uint32_t *pos, uint32_t *n_pos )
+{
+    int32_t block[ BLOCK_SIZE ];
+
+    *n_pos = 0;
+    drv->qrs_start( );
+    for ( uint32_t n = 0; n < ticks; n++ )
+    {
+        hal_sim_time_us = ( ( uint64_t ) ( n + 1 ) * 1000000u ) / fs;
+        drv->tick( );
+        if ( !drv->get_block( block ) )
+        {
+            for ( uint16_t cnt = 0; cnt < BLOCK_SIZE; cnt++ )
+            {
+                if ( drv->qrs_process( &block[ cnt ], 1 ) && ( *n_pos < MAX_BEATS ) )
+                {
+                    pos[ ( *n_pos )++ ] = drv->last_qrs( );
+                }
+            }
+        }
+    }
+}
+
+// Matches detections to R waves, returns the number of R waves found once
+static uint32_t match_beats ( uint16_t fs, const uint32_t *pos, uint32_t n_pos, double from_s, double to_s,
+                              uint32_t *expected, uint32_t *extra, double *lag_min, double *lag_max )
+{
+    uint8_t hit[ MAX_BEATS ] = { 0 };
+    uint32_t found = 0;
+
+    *expected = 0;
+    *extra = 0;
+    *lag_min = 1e9;
+    *lag_max = -1e9;
+    for ( long k = 0; r_time( k ) < to_s; k++ )
+    {
+        *expected += ( r_time( k ) >= from_s );
+    }
+    for ( uint32_t cnt = 0; cnt < n_pos; cnt++ )
+    {
+        double t = ( double ) ( pos[ cnt ] + 1 ) / fs;
+        long k = ( long ) floor( ( t - QRS_LAG_MAX_S - sig.ecg_from_s ) / rr_s( ) );
+        long best = -1;
+
+        for ( long j = ( k > 0 ? k : 0 ); j <= k + 2; j++ )
+        {
+            double lag = t - r_time( j );
+
+            if ( ( lag >= QRS_LAG_MIN_S ) && ( lag <= QRS_LAG_MAX_S ) && ( j < MAX_BEATS ) )
+            {
+                best = j;
+                *lag_min = ( lag < *lag_min ) ? lag : *lag_min;
+                *lag_max = ( lag > *lag_max ) ? lag : *lag_max;
+                break;
+            }
+        }
+        if ( ( best < 0 ) || hit[ best ] )
+        {
+            ( *extra )++;
+            continue;
+        }
+        hit[ best ] = 1;
+        found += ( r_time( best ) >= from_s );
+    }
+    return found;
+}
+
+static void check_qrs ( const driver_t *drv, uint16_t fs, double bpm )
+{
+    uint32_t pos[ MAX_BEATS ];
+    uint32_t n_pos;
+    uint32_t expected;
+    uint32_t extra;
+    uint32_t found;
+    double lag_min;
+    double lag_max;
+    float heart_rate = 0;
+
+    new_signal( );
+    sig.bpm = bpm;
+    sig.mains_hz = 50;
+    sig.hum = 100;
+    sig.low_hz = 0.2;
+    sig.low = 150;
+    sig.noise = 3;
+    start( drv, fs, ECG5_ACQ_MAINS_50HZ );
+    run_qrs( drv, fs, ( uint32_t ) fs * QRS_SECONDS, pos, &n_pos );
+
+    // The first R wave after learning only sets the RR reference and may fall in the refractory period
+    found = match_beats( fs, pos, n_pos, QRS_LEARN_S + rr_s( ), QRS_SECONDS - QRS_LAG_MAX_S,
+                         &expected, &extra, &lag_min, &lag_max );
+    if ( drv->heart_rate( &heart_rate ) )
+    {
+        heart_rate = 0;
+    }
+    printf( "%-5s QRS %4u Hz %3.0f bpm: %u of %u R waves, %u false, lag %.0f to %.0f ms, heart rate %.1f bpm\n",
+            drv->name, fs, bpm, ( unsigned ) found, ( unsigned ) expected, ( unsigned ) extra,
+            lag_min * 1000, lag_max * 1000, heart_rate );
+    if ( ( found != expected ) || extra )
+    {
+        printf( "FAIL: %s at %u Hz and %.0f bpm finds %u of %u R waves with %u false detections\n",
+                drv->name, fs, bpm, ( unsigned ) found, ( unsigned ) expected, ( unsigned ) extra );
+        failures++;
+    }
+    if ( fabs( heart_rate - bpm ) > bpm * 0.02 )
+    {
+        printf( "FAIL: %s at %u Hz reports %.1f bpm for %.0f bpm\n", drv->name, fs, heart_rate, bpm );
+        failures++;
+    }
+}
+
+// Every weak_every-th QRS complex is too small for the threshold and only search back finds it
+static void check_weak_beats ( const driver_t *drv, long weak_every, double weak )
+{
+    uint32_t pos[ MAX_BEATS ];
+    uint32_t n_pos;
+    uint32_t expected;
+    uint32_t extra;
+    uint32_t found;
+    double lag_min;
+    double lag_max;
+
+    new_signal( );
+    sig.bpm = 72;
+    sig.noise = 3;
+    sig.weak_every = weak_every;
+    sig.weak = weak;
+    start( drv, FILTER_FS, ECG5_ACQ_MAINS_50HZ );
+    run_qrs( drv, FILTER_FS, FILTER_FS * QRS_SECONDS, pos, &n_pos );
+    found = match_beats( FILTER_FS, pos, n_pos, QRS_LEARN_S + rr_s( ), QRS_SECONDS - QRS_LAG_MAX_S,
+                         &expected, &extra, &lag_min, &lag_max );
+    printf( "%-5s QRS with every %ld. complex at %.0f %%: %u of %u R waves, %u false, lag %.0f to %.0f ms\n",
+            drv->name, weak_every, weak * 100, ( unsigned ) found, ( unsigned ) expected, ( unsigned ) extra,
+            lag_min * 1000, lag_max * 1000 );
+    if ( ( found != expected ) || extra )
+    {
+        printf( "FAIL: %s finds %u of %u R waves with weak complexes and %u false detections\n",
+                drv->name, ( unsigned ) found, ( unsigned ) expected, ( unsigned ) extra );
+        failures++;
+    }
+}
+
+static void check_learn_first ( const driver_t *drv, const char *what, double noise, double tone, double onset_s )
+{
+    uint32_t pos[ MAX_BEATS ];
+    uint32_t n_pos;
+    uint32_t expected;
+    uint32_t extra;
+    uint32_t found;
+    double lag_min;
+    double lag_max;
+
+    new_signal( );
+    sig.bpm = 72;
+    sig.noise = noise;
+    sig.tone_hz = 15;
+    sig.tone = tone;
+    sig.tone_to_s = onset_s + TONE_FADE_S;
+    sig.ecg_from_s = onset_s;
+    start( drv, FILTER_FS, ECG5_ACQ_MAINS_50HZ );
+
+    /* Noise or an in band tone until the ECG starts, the tone fades out over the first R wave */
+    run_qrs( drv, FILTER_FS, ( uint32_t ) ( FILTER_FS * ( onset_s + AFTER_ONSET_S ) ), pos, &n_pos );
+    found = match_beats( FILTER_FS, pos, n_pos, onset_s, onset_s + AFTER_ONSET_S - QRS_LAG_MAX_S,
+                         &expected, &extra, &lag_min, &lag_max );
+    printf( "%-5s QRS after %.1f s of %s: %u of %u R waves\n", drv->name, onset_s, what,
+            ( unsigned ) found, ( unsigned ) expected );
+    if ( found < expected )
+    {
+        printf( "FAIL: %s finds %u of %u R waves after learning on %s\n", drv->name,
+                ( unsigned ) found, ( unsigned ) expected, what );
+        failures++;
+    }
+}
+
+int main ( void )
+{
+    static const uint16_t rates[ ] = { 250, 500, 1000 };
+    static const double bpms[ ] = { 40, 72, 150 };
+
+    open_drivers( );
+    for ( uint8_t drv = 0; drv < N_DRIVERS; drv++ )
+    {
+        check_grid( &drivers[ drv ] );
+        check_filters( &drivers[ drv ], ECG5_ACQ_MAINS_50HZ );
+        check_filters( &drivers[ drv ], ECG5_ACQ_MAINS_60HZ );
+    }
+    for ( uint8_t drv = 0; drv < N_DRIVERS; drv++ )
+    {
+        if ( !drivers[ drv ].has_qrs )
+        {
+            continue;
+        }
+        for ( uint8_t rate = 0; rate < 3; rate++ )
+        {
+            for ( uint8_t bpm = 0; bpm < 3; bpm++ )
+            {
+                check_qrs( &drivers[ drv ], rates[ rate ], bpms[ bpm ] );
+            }
+        }
+        check_weak_beats( &drivers[ drv ], 4, 0.45 );
+        check_learn_first( &drivers[ drv ], "noise", 100, 0, 10 );
+        check_learn_first( &drivers[ drv ], "a 15 Hz tone", 0, 200, QRS_LEARN_S );
+    }
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/*
+ * 4x4 RGB fill screen: bit-banged frames against the bitstream burst.
+ *
+ * The bit-banged fill pushes every diode again for each of the 16 diodes
+ * and waits 5 ms in between. With a bitstream set the fill has to encode
+ * the frame once and hand it to the burst function in a single call. The
+ * bursts are decoded back to colors to check the encoding, and two
+ * consecutive fills must alternate between the double buffers.
+ */
+#include "c4x4rgb.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static uint32_t logic_calls;
+static uint32_t burst_calls;
+static uint8_t *burst_buf;
+static uint16_t burst_len;
+
+static uint8_t frame_a[ C4X4RGB_BITSTREAM_SIZE ];
+static uint8_t frame_b[ C4X4RGB_BITSTREAM_SIZE ];
+
+static void logic_zero ( void )
+{
+    logic_calls++;
+}
+
+static void logic_one ( void )
+{
+    logic_calls++;
+}
+
+static void burst ( uint8_t *bitstream, uint16_t len )
+{
+    burst_calls++;
+    burst_buf = bitstream;
+    burst_len = len;
+}
+
+// Every WS2812 bit is sent as 3 line bits, the middle one carries the data.
+static uint32_t decode_diode ( const uint8_t *bitstream )
+{
+    uint32_t grb = 0;
+    for ( uint16_t bit = 0; bit < 24; bit++ )
+    {
+        uint16_t pos = bit * 3 + 1;
+        grb = ( grb << 1 ) | ( ( bitstream[ pos / 8 ] >> ( 7 - pos % 8 ) ) & 1 );
+    }
+    return grb;
+}
+
+static int check_frame ( uint32_t rgb_color )
+{
+    uint32_t grb = ( ( rgb_color & 0xFF00 ) << 8 ) | ( ( rgb_color & 0xFF0000 ) >> 8 ) | ( rgb_color & 0xFF );
+    if ( C4X4RGB_BITSTREAM_SIZE != burst_len )
+    {
+        printf( "burst length %u, expected %u\n", burst_len, C4X4RGB_BITSTREAM_SIZE );
+        return 1;
+    }
+    for ( uint8_t diode = 0; diode < 16; diode++ )
+    {
+        uint32_t decoded = decode_diode( &burst_buf[ diode * C4X4RGB_BITSTREAM_BYTES_PER_LED ] );
+        if ( decoded != grb )
+        {
+            printf( "diode %u decodes to 0x%06X, expected 0x%06X\n", diode, ( unsigned ) decoded, ( unsigned ) grb );
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main ( void )
+{
+    c4x4rgb_cfg_t cfg;
+    static c4x4rgb_t ctx;
+    int failures = 0;
+
+    hal_sim_reset( );
+    c4x4rgb_cfg_setup( &cfg, logic_zero, logic_one, C4X4RGB_CTRL_PIN_IN1 );
+    c4x4rgb_init( &ctx, &cfg );
+
+    c4x4rgb_fill_screen( &ctx, 0x00FF00 );
+    uint32_t bitbang_calls = logic_calls;
+    double bitbang_ms = hal_sim_time_us / 1000.0;
+    printf( "bit-banged fill:  %u logic calls, %.2f ms of delays\n", ( unsigned ) bitbang_calls, bitbang_ms );
+
+    c4x4rgb_set_bitstream( &ctx, burst, frame_a, frame_b );
+    logic_calls = 0;
+    hal_sim_time_us = 0;
+
+    c4x4rgb_fill_screen( &ctx, 0x123456 );
+    printf( "bitstream fill:   %u burst call(s) of %u bytes, %u logic calls, %.2f ms of delays\n",
+            ( unsigned ) burst_calls, burst_len, ( unsigned ) logic_calls, hal_sim_time_us / 1000.0 );
+    if ( ( 1 != burst_calls ) || ( 0 != logic_calls ) || ( 0 != hal_sim_time_us ) )
+    {
+        printf( "FAIL: fill screen has to send one frame in one burst\n" );
+        failures++;
+    }
+    failures += check_frame( 0x123456 );
+    uint8_t *first = burst_buf;
+
+    c4x4rgb_fill_screen( &ctx, 0xA5C30F );
+    if ( ( 2 != burst_calls ) || ( burst_buf == first ) )
+    {
+        printf( "FAIL: consecutive frames have to alternate between the two buffers\n" );
+        failures++;
+    }
+    failures += check_frame( 0xA5C30F );
+
+    c4x4rgb_set_diode( &ctx, 16, 0x0000FF );
+    uint32_t last = decode_diode( &burst_buf[ 15 * C4X4RGB_BITSTREAM_BYTES_PER_LED ] );
+    uint32_t other = decode_diode( &burst_buf[ 0 ] );
+    if ( ( 3 != burst_calls ) || ( 0x0000FF != last ) || ( 0xC3A50F != other ) )
+    {
+        printf( "FAIL: set diode has to update one diode and keep the others\n" );
+        failures++;
+    }
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
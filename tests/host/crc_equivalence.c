@@ -0,0 +1,279 @@
+/*
+ * Checks the table driven CRC routine of a click driver against the bitwise
+ * implementation it replaced and reports the speedup of the two.
+ *
+ * The driver source is included directly so its static CRC functions can be
+ * called. The CMake target selects the driver and names its CRC functions:
+ *
+ *   CRC_DRIVER_SOURCE    path of the driver source file
+ *   CRC_DALLAS8_FUNC     CRC-8/MAXIM-DOW, reflected polynomial 0x8C
+ *   CRC_TMC8_FUNC        Trinamic UART CRC-8, polynomial 0x07 fed LSB first
+ *   CRC_MAXIM16_FUNC     CRC-16/MAXIM-DOW, reflected polynomial 0xA001
+ *   CRC_CCITT16_FUNC     CRC-16/CCITT-FALSE, polynomial 0x1021
+ *   CRC_CCITT16_XOROUT   final XOR value of CRC_CCITT16_FUNC, 0 by default
+ *   CRC_CCITT16_FRAME_FUNC
+ *                        CRC-16/CCITT-FALSE over a command frame of type
+ *                        CRC_FRAME_TYPE, fed the first byte as the command
+ *                        code and the rest as payload
+ *   CRC_X25_SWAP16_FUNC  CRC-16/IBM-SDLC, reflected polynomial 0x8408,
+ *                        returned with its bytes swapped
+ */
+#include CRC_DRIVER_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef CRC_CCITT16_FRAME_FUNC
+#define CRC_CCITT16_FUNC    crc_frame_ccitt16
+#endif
+
+#define CRC_RANDOM_RUNS     20000
+#define CRC_BENCH_LEN       255
+#define CRC_BENCH_RUNS      20000
+
+#ifndef CRC_CCITT16_XOROUT
+#define CRC_CCITT16_XOROUT  0x0000
+#endif
+
+static const uint8_t check_input[ 9 ] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+static int failures;
+
+// -------------------------------------------------- BITWISE REFERENCE MODELS
+
+#ifdef CRC_DALLAS8_FUNC
+static uint32_t ref_dallas8 ( uint8_t *data_buf, uint16_t len )
+{
+    uint8_t crc = 0x00;
+    for ( uint16_t cnt_0 = 0; cnt_0 < len; cnt_0++ )
+    {
+        uint8_t in_byte = data_buf[ cnt_0 ];
+        for ( uint8_t cnt_1 = 0; cnt_1 < 8; cnt_1++ )
+        {
+            uint8_t mix = ( crc ^ in_byte ) & 0x01;
+            crc >>= 1;
+            if ( 0 != mix )
+            {
+                crc ^= 0x8C;
+            }
+            in_byte >>= 1;
+        }
+    }
+    return crc;
+}
+#endif
+
+#ifdef CRC_TMC8_FUNC
+static uint32_t ref_tmc8 ( uint8_t *data_buf, uint16_t len )
+{
+    uint8_t crc = 0x00;
+    for ( uint16_t cnt_byte = 0; cnt_byte < len; cnt_byte++ )
+    {
+        uint8_t curr_byte = data_buf[ cnt_byte ];
+        for ( uint8_t cnt_bit = 0; cnt_bit < 8; cnt_bit++ )
+        {
+            if ( ( crc >> 7 ) ^ ( curr_byte & 0x01 ) )
+            {
+                crc = ( uint8_t ) ( ( crc << 1 ) ^ 0x07 );
+            }
+            else
+            {
+                crc <<= 1;
+            }
+            curr_byte >>= 1;
+        }
+    }
+    return crc;
+}
+#endif
+
+#ifdef CRC_MAXIM16_FUNC
+static uint16_t ref_reflect_bits ( uint16_t data_in, uint8_t len )
+{
+    uint16_t data_out = 0;
+    for ( uint16_t cnt = 0; cnt < len; cnt++ )
+    {
+        data_out |= ( ( data_in >> cnt ) & 1 ) << ( len - cnt - 1 );
+    }
+    return data_out;
+}
+
+static uint32_t ref_maxim16 ( uint8_t *data_buf, uint16_t len )
+{
+    uint16_t crc16 = 0x0000;
+    for ( uint16_t cnt = 0; cnt < len; cnt++ )
+    {
+        crc16 ^= ( ref_reflect_bits( data_buf[ cnt ], 8 ) << 8 );
+        for ( uint8_t bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
+        {
+            if ( crc16 & 0x8000 )
+            {
+                crc16 = ( crc16 << 1 ) ^ 0x8005;
+            }
+            else
+            {
+                crc16 <<= 1;
+            }
+        }
+    }
+    return ref_reflect_bits( crc16, 16 ) ^ 0xFFFF;
+}
+#endif
+
+#ifdef CRC_CCITT16_FUNC
+static uint32_t ref_ccitt16 ( uint8_t *data_buf, uint16_t len )
+{
+    uint16_t crc16 = 0xFFFF;
+    for ( uint16_t cnt = 0; cnt < len; cnt++ )
+    {
+        crc16 ^= ( data_buf[ cnt ] << 8 );
+        for ( uint8_t bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
+        {
+            if ( crc16 & 0x8000 )
+            {
+                crc16 = ( crc16 << 1 ) ^ 0x1021;
+            }
+            else
+            {
+                crc16 <<= 1;
+            }
+        }
+    }
+    return ( uint16_t ) ( crc16 ^ CRC_CCITT16_XOROUT );
+}
+#endif
+
+#ifdef CRC_X25_SWAP16_FUNC
+static uint32_t ref_x25_swap16 ( uint8_t *data_buf, uint16_t len )
+{
+    uint16_t crc16 = 0xFFFF;
+    for ( uint16_t cnt = 0; cnt < len; cnt++ )
+    {
+        crc16 ^= data_buf[ cnt ];
+        for ( uint8_t bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
+        {
+            if ( crc16 & 0x0001 )
+            {
+                crc16 = ( crc16 >> 1 ) ^ 0x8408;
+            }
+            else
+            {
+                crc16 >>= 1;
+            }
+        }
+    }
+    crc16 ^= 0xFFFF;
+    return ( uint16_t ) ( ( crc16 << 8 ) | ( crc16 >> 8 ) );
+}
+#endif
+
+// ------------------------------------------------------- DRIVER UNDER TEST
+
+#ifdef CRC_CCITT16_FRAME_FUNC
+static uint16_t crc_frame_ccitt16 ( uint8_t *data_buf, uint16_t len )
+{
+    static CRC_FRAME_TYPE frame;
+    frame.cmd = data_buf[ 0 ];
+    memcpy( frame.payload, &data_buf[ 1 ], len - 1 );
+    frame.payload_len = len - 1;
+    return CRC_CCITT16_FRAME_FUNC( frame );
+}
+#endif
+
+#ifdef CRC_DALLAS8_FUNC
+static uint32_t drv_dallas8 ( uint8_t *data_buf, uint16_t len ) { return CRC_DALLAS8_FUNC( data_buf, len ); }
+#endif
+#ifdef CRC_TMC8_FUNC
+static uint32_t drv_tmc8 ( uint8_t *data_buf, uint16_t len ) { return CRC_TMC8_FUNC( data_buf, len ); }
+#endif
+#ifdef CRC_MAXIM16_FUNC
+static uint32_t drv_maxim16 ( uint8_t *data_buf, uint16_t len ) { return CRC_MAXIM16_FUNC( data_buf, len ); }
+#endif
+#ifdef CRC_CCITT16_FUNC
+static uint32_t drv_ccitt16 ( uint8_t *data_buf, uint16_t len ) { return CRC_CCITT16_FUNC( data_buf, len ); }
+#endif
+#ifdef CRC_X25_SWAP16_FUNC
+static uint32_t drv_x25_swap16 ( uint8_t *data_buf, uint16_t len ) { return CRC_X25_SWAP16_FUNC( data_buf, len ); }
+#endif
+
+typedef uint32_t ( *crc_fn_t )( uint8_t *data_buf, uint16_t len );
+
+static double bench_mbps ( crc_fn_t fn, uint8_t *data_buf )
+{
+    volatile uint32_t sink = 0;
+    clock_t start = clock( );
+    for ( uint32_t run = 0; run < CRC_BENCH_RUNS; run++ )
+    {
+        data_buf[ 0 ] = ( uint8_t ) run;
+        sink ^= fn( data_buf, CRC_BENCH_LEN );
+    }
+    double sec = ( double ) ( clock( ) - start ) / CLOCKS_PER_SEC;
+    ( void ) sink;
+    return sec > 0 ? ( double ) CRC_BENCH_LEN * CRC_BENCH_RUNS / sec / 1e6 : 0;
+}
+
+static void check_model ( const char *name, crc_fn_t drv, crc_fn_t ref, uint32_t check_value )
+{
+    uint8_t data_buf[ 256 ];
+    int mismatches = 0;
+
+    if ( ref( ( uint8_t * ) check_input, sizeof( check_input ) ) != check_value )
+    {
+        printf( "%s: reference model check value is wrong\n", name );
+        failures++;
+        return;
+    }
+    if ( drv( ( uint8_t * ) check_input, sizeof( check_input ) ) != check_value )
+    {
+        printf( "%s: check value 0x%X, expected 0x%X\n", name,
+                ( unsigned ) drv( ( uint8_t * ) check_input, sizeof( check_input ) ), ( unsigned ) check_value );
+        mismatches++;
+    }
+    for ( uint32_t run = 0; run < CRC_RANDOM_RUNS; run++ )
+    {
+        uint16_t len = ( uint16_t ) ( rand( ) % CRC_BENCH_LEN + 1 );
+        for ( uint16_t cnt = 0; cnt < len; cnt++ )
+        {
+            data_buf[ cnt ] = ( uint8_t ) rand( );
+        }
+        if ( drv( data_buf, len ) != ref( data_buf, len ) )
+        {
+            if ( mismatches++ < 5 )
+            {
+                printf( "%s: mismatch on a %u byte buffer\n", name, len );
+            }
+        }
+    }
+
+    for ( uint16_t cnt = 0; cnt < CRC_BENCH_LEN; cnt++ )
+    {
+        data_buf[ cnt ] = ( uint8_t ) rand( );
+    }
+    double ref_mbps = bench_mbps( ref, data_buf );
+    double drv_mbps = bench_mbps( drv, data_buf );
+    printf( "%-24s %s, bitwise %.1f MB/s, table %.1f MB/s (x%.1f)\n", name,
+            mismatches ? "FAIL" : "ok", ref_mbps, drv_mbps, ref_mbps > 0 ? drv_mbps / ref_mbps : 0 );
+    failures += mismatches ? 1 : 0;
+}
+
+int main ( void )
+{
+    srand( 1 );
+#ifdef CRC_DALLAS8_FUNC
+    check_model( "CRC-8/MAXIM-DOW", drv_dallas8, ref_dallas8, 0xA1 );
+#endif
+#ifdef CRC_TMC8_FUNC
+    check_model( "CRC-8/TMC", drv_tmc8, ref_tmc8, ref_tmc8( ( uint8_t * ) check_input, sizeof( check_input ) ) );
+#endif
+#ifdef CRC_MAXIM16_FUNC
+    check_model( "CRC-16/MAXIM-DOW", drv_maxim16, ref_maxim16, 0x44C2 );
+#endif
+#ifdef CRC_CCITT16_FUNC
+    check_model( "CRC-16/CCITT-FALSE", drv_ccitt16, ref_ccitt16, 0x29B1 ^ CRC_CCITT16_XOROUT );
+#endif
+#ifdef CRC_X25_SWAP16_FUNC
+    check_model( "CRC-16/IBM-SDLC swapped", drv_x25_swap16, ref_x25_swap16, 0x6E90 );
+#endif
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,345 @@
+/*
+ * Flash 2 and SQI FLASH page program throughput against a simulated SST26.
+ *
+ * The model follows the SST26VF016B in SPI mode: commands need Write-Enable,
+ * Page-Program wraps inside its 256 byte page, programming only clears bits
+ * and the device stays busy for the maximum tPP (1.5 ms) and tSE (25 ms).
+ * Commands sent while busy are counted as errors and ignored. SPI transfers
+ * advance the simulated clock at the configured bus speed.
+ *
+ * For each driver the test writes 64 KiB page aligned, an unaligned 1000 byte
+ * block crossing five pages, and a block right after a sector erase, then
+ * reads everything back. Throughput has to reach 90 % of the bound given by
+ * the bus time and tPP of each page.
+ */
+#include "flash2.h"
+#include "sqiflash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIM_FLASH_SIZE      ( 2ul * 1024 * 1024 )
+#define SIM_PAGE_SIZE       256
+#define SIM_SECTOR_SIZE     4096
+#define SIM_T_PP_US         1500
+#define SIM_T_SE_US         25000
+#define SIM_SPI_SPEED       10000000ul
+
+#define CMD_WREN            0x06
+#define CMD_RDSR            0x05
+#define CMD_READ            0x03
+#define CMD_PP              0x02
+#define CMD_QUAD_PP         0x32
+#define CMD_SE              0x20
+
+#define BENCH_LEN           ( 64ul * 1024 )
+
+static uint8_t mem[ SIM_FLASH_SIZE ];
+static uint8_t frame[ 4 + SIM_FLASH_SIZE ];
+static uint32_t frame_len;
+static uint32_t read_pos;
+static uint8_t wel;
+static uint64_t busy_until;
+static uint32_t page_programs;
+static uint32_t busy_violations;
+
+static uint8_t src[ BENCH_LEN ];
+static uint8_t dst[ BENCH_LEN ];
+
+static uint32_t frame_address ( void )
+{
+    return ( ( uint32_t ) frame[ 1 ] << 16 ) | ( ( uint32_t ) frame[ 2 ] << 8 ) | frame[ 3 ];
+}
+
+static int device_busy ( void )
+{
+    return hal_sim_time_us < busy_until;
+}
+
+static void bus_time ( size_t size )
+{
+    hal_sim_time_us += ( size * 8 * 1000000ull + SIM_SPI_SPEED - 1 ) / SIM_SPI_SPEED;
+}
+
+static void spi_select ( pin_name_t cs, uint8_t selected )
+{
+    ( void ) cs;
+    if ( selected )
+    {
+        frame_len = 0;
+        read_pos = 0;
+        return;
+    }
+    if ( 0 == frame_len )
+    {
+        return;
+    }
+    uint8_t cmd = frame[ 0 ];
+    if ( ( CMD_RDSR == cmd ) || ( CMD_READ == cmd ) )
+    {
+        return;
+    }
+    if ( device_busy( ) )
+    {
+        busy_violations++;
+        return;
+    }
+    if ( CMD_WREN == cmd )
+    {
+        wel = 1;
+    }
+    else if ( ( ( CMD_PP == cmd ) || ( CMD_QUAD_PP == cmd ) ) && wel && ( frame_len > 4 ) )
+    {
+        uint32_t address = frame_address( ) % SIM_FLASH_SIZE;
+        uint32_t page = address - address % SIM_PAGE_SIZE;
+        for ( uint32_t cnt = 4; cnt < frame_len; cnt++ )
+        {
+            mem[ page + ( address + cnt - 4 ) % SIM_PAGE_SIZE ] &= frame[ cnt ];
+        }
+        page_programs++;
+        wel = 0;
+        busy_until = hal_sim_time_us + SIM_T_PP_US;
+    }
+    else if ( ( CMD_SE == cmd ) && wel && ( 4 == frame_len ) )
+    {
+        uint32_t sector = frame_address( ) % SIM_FLASH_SIZE;
+        sector -= sector % SIM_SECTOR_SIZE;
+        memset( &mem[ sector ], 0xFF, SIM_SECTOR_SIZE );
+        wel = 0;
+        busy_until = hal_sim_time_us + SIM_T_SE_US;
+    }
+}
+
+static err_t spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    bus_time( size );
+    if ( frame_len + size <= sizeof( frame ) )
+    {
+        memcpy( &frame[ frame_len ], buffer, size );
+        frame_len += size;
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+static err_t spi_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    bus_time( size );
+    for ( size_t cnt = 0; cnt < size; cnt++ )
+    {
+        if ( CMD_RDSR == frame[ 0 ] )
+        {
+            buffer[ cnt ] = ( device_busy( ) ? 0x80 : 0x00 ) | ( wel ? 0x02 : 0x00 );
+        }
+        else if ( ( CMD_READ == frame[ 0 ] ) && ( frame_len >= 4 ) )
+        {
+            buffer[ cnt ] = mem[ ( frame_address( ) + read_pos++ ) % SIM_FLASH_SIZE ];
+        }
+        else
+        {
+            buffer[ cnt ] = 0xFF;
+        }
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+static void sim_reset ( void )
+{
+    hal_sim_reset( );
+    hal_sim_spi_select = spi_select;
+    hal_sim_spi_write = spi_write;
+    hal_sim_spi_read = spi_read;
+    memset( mem, 0xFF, sizeof( mem ) );
+    wel = 0;
+    busy_until = 0;
+    page_programs = 0;
+    busy_violations = 0;
+}
+
+// ------------------------------------------------------------ DRIVER ADAPTERS
+
+typedef struct
+{
+    const char *name;
+    void ( *init ) ( void );
+    int ( *write_pages ) ( uint32_t address, uint8_t *buffer, uint32_t len );
+    int ( *quad_write_pages ) ( uint32_t address, uint8_t *buffer, uint32_t len );
+    void ( *sector_erase ) ( uint32_t address );
+    void ( *read ) ( uint32_t address, uint8_t *buffer, uint32_t len );
+
+} flash_driver_t;
+
+static flash2_t flash2;
+static sqiflash_t sqiflash;
+
+static void flash2_adapter_init ( void )
+{
+    flash2_cfg_t cfg;
+    flash2_cfg_setup( &cfg );
+    cfg.cs = 1;
+    cfg.spi_speed = SIM_SPI_SPEED;
+    flash2_init( &flash2, &cfg );
+}
+
+static int flash2_adapter_write ( uint32_t address, uint8_t *buffer, uint32_t len )
+{
+    return flash2_write_pages( &flash2, address, buffer, len );
+}
+
+static int flash2_adapter_quad_write ( uint32_t address, uint8_t *buffer, uint32_t len )
+{
+    return flash2_quad_write_pages( &flash2, address, buffer, len );
+}
+
+static void flash2_adapter_erase ( uint32_t address )
+{
+    flash2_sector_erase( &flash2, address );
+}
+
+static void flash2_adapter_read ( uint32_t address, uint8_t *buffer, uint32_t len )
+{
+    flash2_read_generic( &flash2, address, buffer, len );
+}
+
+static void sqiflash_adapter_init ( void )
+{
+    sqiflash_cfg_t cfg;
+    sqiflash_cfg_setup( &cfg );
+    cfg.cs = 1;
+    cfg.spi_speed = SIM_SPI_SPEED;
+    sqiflash_init( &sqiflash, &cfg );
+}
+
+static int sqiflash_adapter_write ( uint32_t address, uint8_t *buffer, uint32_t len )
+{
+    return sqiflash_write_pages( &sqiflash, address, buffer, len );
+}
+
+static int sqiflash_adapter_quad_write ( uint32_t address, uint8_t *buffer, uint32_t len )
+{
+    return sqiflash_quad_write_pages( &sqiflash, address, buffer, len );
+}
+
+static void sqiflash_adapter_erase ( uint32_t address )
+{
+    sqiflash_sector_erase( &sqiflash, address );
+}
+
+static void sqiflash_adapter_read ( uint32_t address, uint8_t *buffer, uint32_t len )
+{
+    sqiflash_read_generic( &sqiflash, address, buffer, len );
+}
+
+static const flash_driver_t drivers[ ] =
+{
+    { "Flash 2", flash2_adapter_init, flash2_adapter_write, flash2_adapter_quad_write,
+      flash2_adapter_erase, flash2_adapter_read },
+    { "SQI FLASH", sqiflash_adapter_init, sqiflash_adapter_write, sqiflash_adapter_quad_write,
+      sqiflash_adapter_erase, sqiflash_adapter_read },
+};
+
+// ---------------------------------------------------------------------- TESTS
+
+static int check_readback ( const flash_driver_t *drv, const char *what, uint32_t address, uint32_t len )
+{
+    memset( dst, 0, len );
+    // The read helpers of both drivers take a 16-bit length
+    for ( uint32_t pos = 0; pos < len; pos += SIM_SECTOR_SIZE )
+    {
+        drv->read( address + pos, &dst[ pos ], ( len - pos < SIM_SECTOR_SIZE ) ? len - pos : SIM_SECTOR_SIZE );
+    }
+    for ( uint32_t cnt = 0; cnt < len; cnt++ )
+    {
+        if ( dst[ cnt ] != src[ cnt ] )
+        {
+            printf( "%s: %s differs at 0x%06X\n", drv->name, what, ( unsigned ) ( address + cnt ) );
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int run_driver ( const flash_driver_t *drv )
+{
+    int failures = 0;
+
+    // Page aligned bulk write
+    sim_reset( );
+    drv->init( );
+    uint64_t start = hal_sim_time_us;
+    if ( drv->write_pages( 0, src, BENCH_LEN ) )
+    {
+        printf( "%s: bulk write failed\n", drv->name );
+        failures++;
+    }
+    double sec = ( hal_sim_time_us - start ) / 1e6;
+    double kbps = BENCH_LEN / 1024.0 / sec;
+    double page_us = ( 4 + SIM_PAGE_SIZE + 1 ) * 8 * 1e6 / SIM_SPI_SPEED + SIM_T_PP_US;
+    double bound_kbps = SIM_PAGE_SIZE / 1024.0 / ( page_us / 1e6 );
+    printf( "%-10s %lu bytes in %u page programs, %.1f KB/s (bound %.1f KB/s)\n", drv->name,
+            BENCH_LEN, ( unsigned ) page_programs, kbps, bound_kbps );
+    if ( ( BENCH_LEN / SIM_PAGE_SIZE != page_programs ) || ( kbps < 0.9 * bound_kbps ) )
+    {
+        printf( "%s: expected one program per page at 90 %% of the bound\n", drv->name );
+        failures++;
+    }
+    failures += check_readback( drv, "bulk write", 0, BENCH_LEN );
+
+    // Unaligned start and end
+    sim_reset( );
+    drv->init( );
+    if ( drv->write_pages( 0x1F0, src, 1000 ) || ( 5 != page_programs ) )
+    {
+        printf( "%s: unaligned write took %u page programs, expected 5\n", drv->name, ( unsigned ) page_programs );
+        failures++;
+    }
+    failures += check_readback( drv, "unaligned write", 0x1F0, 1000 );
+
+    // Write straight after a sector erase, the erase outlasts a page program timeout
+    sim_reset( );
+    drv->init( );
+    memset( mem, 0x00, SIM_SECTOR_SIZE );
+    drv->sector_erase( 0 );
+    if ( drv->write_pages( 0x100, src, 600 ) )
+    {
+        printf( "%s: write after sector erase timed out\n", drv->name );
+        failures++;
+    }
+    failures += check_readback( drv, "write after erase", 0x100, 600 );
+
+    // Quad page program instruction through the same engine
+    sim_reset( );
+    drv->init( );
+    if ( drv->quad_write_pages( 0x3000, src, 2 * SIM_PAGE_SIZE ) || ( 2 != page_programs ) )
+    {
+        printf( "%s: quad write failed\n", drv->name );
+        failures++;
+    }
+    failures += check_readback( drv, "quad write", 0x3000, 2 * SIM_PAGE_SIZE );
+
+    if ( busy_violations )
+    {
+        printf( "%s: %u commands were sent while the device was busy\n", drv->name, ( unsigned ) busy_violations );
+        failures++;
+    }
+    return failures;
+}
+
+int main ( void )
+{
+    int failures = 0;
+
+    srand( 1 );
+    for ( uint32_t cnt = 0; cnt < BENCH_LEN; cnt++ )
+    {
+        src[ cnt ] = ( uint8_t ) rand( );
+    }
+    for ( uint8_t cnt = 0; cnt < sizeof( drivers ) / sizeof( drivers[ 0 ] ); cnt++ )
+    {
+        failures += run_driver( &drivers[ cnt ] );
+    }
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,425 @@
+/*
+ * GNSS NMEA parsing: streaming parser against the strstr GGA parser.
+ *
+ * One 10 Hz epoch of a GPS receiver is built with valid checksums: RMC,
+ * VTG, GGA, GSA, three GSV messages and GNS, in the order the receivers
+ * send them. It is fed to gnss_nmea_process through the UART hook and
+ * every field of every sentence has to decode to its expected fixed point
+ * value, with the sentence IDs reported in order. A wrong checksum, a
+ * sentence cut short by the next '$', an unknown sentence and an overlong
+ * field must each drop only their own sentence and keep the last valid
+ * one. The GGA position and altitude have to match what gnss_parse_gpgga
+ * returns for the same buffer.
+ *
+ * The driver source is included with strstr counted, so the cost of both
+ * parsers is also reported as the number of buffer characters examined
+ * per epoch, for the three GGA fields the example reads and for all GGA
+ * fields, next to the host time per epoch. The streaming parser has to
+ * look at every byte once, the strstr parser rescans the buffer for every
+ * field it returns. The counting strstr is a plain byte by byte search
+ * like the small C libraries of the MCU toolchains, so the host times of
+ * gnss_parse_gpgga are of that search and not of the host C library.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static unsigned long strstr_chars;
+
+// Naive search with the cost of every examined character counted
+static char *counted_strstr ( const char *haystack, const char *needle )
+{
+    size_t needle_len = strlen( needle );
+
+    for ( ; *haystack; haystack++ )
+    {
+        size_t cnt = 0;
+
+        strstr_chars++;
+        while ( ( cnt < needle_len ) && ( haystack[ cnt ] == needle[ cnt ] ) )
+        {
+            cnt++;
+        }
+        if ( cnt == needle_len )
+        {
+            return ( char * ) haystack;
+        }
+    }
+    return NULL;
+}
+
+#define strstr counted_strstr
+#include "gnss.c"
+#undef strstr
+
+#define EPOCH_SIZE          1024
+#define BENCH_RUNS          20000
+// Coordinates are truncated to 1e-7 degrees, about 1 cm
+#define COORD_1E7( deg, min )   ( ( int32_t ) ( deg ) * 10000000l + ( int32_t ) ( ( min ) * 1e7 / 60 ) )
+
+static char epoch[ EPOCH_SIZE ];
+static size_t epoch_len;
+static const char *rx_data;
+static size_t rx_len;
+static size_t rx_pos;
+static unsigned long rx_bytes;
+
+static int failures;
+
+// ------------------------------------------------------------------ SENTENCES
+
+static void add_sentence ( char *buf, size_t *len, const char *body )
+{
+    uint8_t checksum = 0;
+
+    for ( const char *ptr = body; *ptr; ptr++ )
+    {
+        checksum ^= ( uint8_t ) *ptr;
+    }
+    *len += ( size_t ) sprintf( buf + *len, "$%s*%02X\r\n", body, checksum );
+}
+
+static const char *const epoch_body[ ] =
+{
+    "GPRMC,123519.20,A,4807.03800,N,01131.00000,E,022.40,084.40,230394,003.1,W,A",
+    "GPVTG,054.70,T,034.40,M,005.50,N,010.20,K,A",
+    "GPGGA,123519.20,4807.03800,N,01131.00000,E,1,08,0.94,545.42,M,46.91,M,3,0120",
+    "GPGSA,A,3,04,05,,09,12,,,24,,,,,2.50,1.30,2.10,1",
+    "GPGSV,3,1,11,03,03,111,40,04,15,270,38,06,01,010,21,13,06,292,33,1",
+    "GPGSV,3,2,11,14,25,170,42,16,57,208,45,19,40,346,30,24,12,049,27,1",
+    "GPGSV,3,3,11,25,73,286,47,27,-02,138,12,29,23,012,35,1",
+    "GPGNS,123519.20,4807.03800,S,01131.00000,W,AAN,10,0.94,545.42,46.91,,,V",
+};
+
+static const uint8_t epoch_ids[ ] =
+{
+    GNSS_NMEA_SENTENCE_RMC, GNSS_NMEA_SENTENCE_VTG, GNSS_NMEA_SENTENCE_GGA, GNSS_NMEA_SENTENCE_GSA,
+    GNSS_NMEA_SENTENCE_GSV, GNSS_NMEA_SENTENCE_GSV, GNSS_NMEA_SENTENCE_GSV, GNSS_NMEA_SENTENCE_GNS,
+};
+
+#define EPOCH_SENTENCES     ( sizeof( epoch_body ) / sizeof( epoch_body[ 0 ] ) )
+
+static void build_epoch ( void )
+{
+    epoch_len = 0;
+    for ( uint8_t cnt = 0; cnt < EPOCH_SENTENCES; cnt++ )
+    {
+        add_sentence( epoch, &epoch_len, epoch_body[ cnt ] );
+    }
+}
+
+// ----------------------------------------------------------------------- HOST
+
+static err_t rx_read ( void *obj, char *buffer, size_t size )
+{
+    size_t cnt = 0;
+
+    ( void ) obj;
+    while ( ( cnt < size ) && ( rx_pos < rx_len ) )
+    {
+        buffer[ cnt++ ] = rx_data[ rx_pos++ ];
+    }
+    rx_bytes += cnt;
+    return ( err_t ) cnt;
+}
+
+static size_t rx_available ( void *obj )
+{
+    ( void ) obj;
+    return rx_len - rx_pos;
+}
+
+static void rx_set ( const char *data, size_t len )
+{
+    rx_data = data;
+    rx_len = len;
+    rx_pos = 0;
+}
+
+// Drains the receive data, stores every reported sentence ID and returns their number
+static uint8_t drain ( gnss_t *ctx, gnss_nmea_parser_t *parser, uint8_t *ids, uint8_t max_ids )
+{
+    uint8_t count = 0;
+    uint8_t sentence;
+
+    while ( ( sentence = gnss_nmea_process( ctx, parser ) ) != GNSS_NMEA_SENTENCE_NONE )
+    {
+        if ( count < max_ids )
+        {
+            ids[ count ] = sentence;
+        }
+        count++;
+    }
+    return count;
+}
+
+// --------------------------------------------------------------------- CHECKS
+
+static void expect ( const char *what, long value, long expected )
+{
+    if ( value != expected )
+    {
+        printf( "FAIL: %s is %ld, expected %ld\n", what, value, expected );
+        failures++;
+    }
+}
+
+static void expect_char ( const char *what, char value, char expected )
+{
+    if ( value != expected )
+    {
+        printf( "FAIL: %s is '%c', expected '%c'\n", what, value, expected );
+        failures++;
+    }
+}
+
+static void check_epoch ( gnss_t *ctx )
+{
+    static const uint8_t gsa_ids[ GNSS_NMEA_GSA_MAX_SATELLITES ] = { 4, 5, 0, 9, 12, 0, 0, 24 };
+    gnss_nmea_parser_t parser;
+    uint8_t ids[ 16 ] = { 0 };
+    uint8_t count;
+
+    gnss_nmea_parser_init( &parser );
+    rx_set( epoch, epoch_len );
+    rx_bytes = 0;
+    count = drain( ctx, &parser, ids, sizeof( ids ) );
+    expect( "sentences of the epoch", count, EPOCH_SENTENCES );
+    for ( uint8_t cnt = 0; ( cnt < count ) && ( cnt < EPOCH_SENTENCES ); cnt++ )
+    {
+        expect( "sentence ID", ids[ cnt ], epoch_ids[ cnt ] );
+    }
+    expect( "bytes read for the epoch", ( long ) rx_bytes, ( long ) epoch_len );
+    expect( "checksum errors", parser.checksum_errors, 0 );
+
+    expect( "RMC hours", parser.rmc.time.hours, 12 );
+    expect( "RMC minutes", parser.rmc.time.minutes, 35 );
+    expect( "RMC seconds", parser.rmc.time.seconds, 19 );
+    expect( "RMC milliseconds", parser.rmc.time.milliseconds, 200 );
+    expect_char( "RMC status", parser.rmc.status, 'A' );
+    expect( "RMC latitude", parser.rmc.latitude, COORD_1E7( 48, 7.038 ) );
+    expect( "RMC longitude", parser.rmc.longitude, COORD_1E7( 11, 31.0 ) );
+    expect( "RMC speed", ( long ) parser.rmc.speed_knots, 2240 );
+    expect( "RMC course", parser.rmc.course, 8440 );
+    expect( "RMC day", parser.rmc.date.day, 23 );
+    expect( "RMC month", parser.rmc.date.month, 3 );
+    expect( "RMC year", parser.rmc.date.year, 94 );
+    expect_char( "RMC mode", parser.rmc.mode, 'A' );
+
+    expect( "VTG true course", parser.vtg.course_true, 5470 );
+    expect( "VTG magnetic course", parser.vtg.course_magnetic, 3440 );
+    expect( "VTG knots", ( long ) parser.vtg.speed_knots, 550 );
+    expect( "VTG km/h", ( long ) parser.vtg.speed_kmh, 1020 );
+    expect_char( "VTG mode", parser.vtg.mode, 'A' );
+
+    expect( "GGA seconds", parser.gga.time.seconds, 19 );
+    expect( "GGA latitude", parser.gga.latitude, COORD_1E7( 48, 7.038 ) );
+    expect( "GGA longitude", parser.gga.longitude, COORD_1E7( 11, 31.0 ) );
+    expect( "GGA quality", parser.gga.quality, 1 );
+    expect( "GGA satellites", parser.gga.num_satellites, 8 );
+    expect( "GGA HDOP", parser.gga.hdop, 94 );
+    expect( "GGA altitude", parser.gga.altitude, 54542 );
+    expect( "GGA geoid separation", parser.gga.geoid_separation, 4691 );
+    expect( "GGA DGPS age", parser.gga.dgps_age, 3 );
+    expect( "GGA DGPS station", parser.gga.dgps_station_id, 120 );
+    expect_char( "GGA talker", parser.gga.talker[ 1 ], 'P' );
+
+    expect_char( "GSA mode", parser.gsa.mode, 'A' );
+    expect( "GSA fix", parser.gsa.fix_type, 3 );
+    for ( uint8_t cnt = 0; cnt < GNSS_NMEA_GSA_MAX_SATELLITES; cnt++ )
+    {
+        expect( "GSA satellite", parser.gsa.satellite_id[ cnt ], gsa_ids[ cnt ] );
+    }
+    expect( "GSA PDOP", parser.gsa.pdop, 250 );
+    expect( "GSA HDOP", parser.gsa.hdop, 130 );
+    expect( "GSA VDOP", parser.gsa.vdop, 210 );
+    expect( "GSA system", parser.gsa.system_id, 1 );
+
+    // The last GSV message is the one kept, three satellites and the signal ID
+    expect( "GSV messages", parser.gsv.total_messages, 3 );
+    expect( "GSV message number", parser.gsv.message_number, 3 );
+    expect( "GSV in view", parser.gsv.satellites_in_view, 11 );
+    expect( "GSV satellites", parser.gsv.num_satellites, 3 );
+    expect( "GSV satellite 2 ID", parser.gsv.satellite[ 1 ].id, 27 );
+    expect( "GSV satellite 2 elevation", parser.gsv.satellite[ 1 ].elevation, -2 );
+    expect( "GSV satellite 2 azimuth", parser.gsv.satellite[ 1 ].azimuth, 138 );
+    expect( "GSV satellite 2 SNR", parser.gsv.satellite[ 1 ].snr, 12 );
+    expect( "GSV satellite 3 ID", parser.gsv.satellite[ 2 ].id, 29 );
+    expect( "GSV satellite 4 ID", parser.gsv.satellite[ 3 ].id, 0 );
+    expect( "GSV signal", parser.gsv.signal_id, 1 );
+
+    expect( "GNS latitude", parser.gns.latitude, -COORD_1E7( 48, 7.038 ) );
+    expect( "GNS longitude", parser.gns.longitude, -COORD_1E7( 11, 31.0 ) );
+    expect_char( "GNS mode", parser.gns.mode[ 2 ], 'N' );
+    expect( "GNS satellites", parser.gns.num_satellites, 10 );
+    expect( "GNS altitude", parser.gns.altitude, 54542 );
+    expect( "GNS geoid separation", parser.gns.geoid_separation, 4691 );
+    expect_char( "GNS status", parser.gns.nav_status, 'V' );
+
+    printf( "Streaming parser: %u of %u sentences decoded from a %u byte epoch\n",
+            ( unsigned ) count, ( unsigned ) EPOCH_SENTENCES, ( unsigned ) epoch_len );
+}
+
+// Each damaged sentence follows a valid GGA and is followed by a valid RMC
+static void check_damaged ( gnss_t *ctx, const char *what, const char *damaged, uint16_t checksum_errors )
+{
+    char buf[ EPOCH_SIZE ];
+    size_t len = 0;
+    gnss_nmea_parser_t parser;
+    uint8_t ids[ 8 ] = { 0 };
+    uint8_t count;
+
+    add_sentence( buf, &len, epoch_body[ 2 ] );
+    len += ( size_t ) sprintf( buf + len, "%s", damaged );
+    add_sentence( buf, &len, epoch_body[ 0 ] );
+
+    gnss_nmea_parser_init( &parser );
+    rx_set( buf, len );
+    count = drain( ctx, &parser, ids, sizeof( ids ) );
+    printf( "Streaming parser with %s: %u sentences, %u checksum errors\n", what,
+            ( unsigned ) count, ( unsigned ) parser.checksum_errors );
+    if ( ( 2 != count ) || ( GNSS_NMEA_SENTENCE_GGA != ids[ 0 ] ) || ( GNSS_NMEA_SENTENCE_RMC != ids[ 1 ] ) ||
+         ( checksum_errors != parser.checksum_errors ) )
+    {
+        printf( "FAIL: %s is not dropped on its own\n", what );
+        failures++;
+    }
+    expect( "GGA altitude kept", parser.gga.altitude, 54542 );
+    expect( "RMC latitude after", parser.rmc.latitude, COORD_1E7( 48, 7.038 ) );
+}
+
+static double legacy_coordinate ( const char *text, uint8_t deg_digits )
+{
+    char deg[ 4 ] = { 0 };
+
+    memcpy( deg, text, deg_digits );
+    return atof( deg ) + atof( text + deg_digits ) / 60;
+}
+
+static void check_legacy ( void )
+{
+    gnss_nmea_parser_t parser;
+    char lat[ 32 ] = { 0 };
+    char lon[ 32 ] = { 0 };
+    char alt[ 32 ] = { 0 };
+
+    gnss_nmea_parser_init( &parser );
+    for ( size_t cnt = 0; cnt < epoch_len; cnt++ )
+    {
+        gnss_nmea_parse_byte( &parser, epoch[ cnt ] );
+    }
+    if ( gnss_parse_gpgga( epoch, GNSS_GPGGA_LATITUDE, lat ) || gnss_parse_gpgga( epoch, GNSS_GPGGA_LONGITUDE, lon ) ||
+         gnss_parse_gpgga( epoch, GNSS_GPGGA_ALTITUDE, alt ) )
+    {
+        printf( "FAIL: gnss_parse_gpgga does not find the GGA fields\n" );
+        failures++;
+        return;
+    }
+    expect( "latitude against gnss_parse_gpgga", parser.gga.latitude,
+            ( long ) ( legacy_coordinate( lat, 2 ) * 1e7 ) );
+    expect( "longitude against gnss_parse_gpgga", parser.gga.longitude,
+            ( long ) ( legacy_coordinate( lon, 3 ) * 1e7 ) );
+    expect( "altitude against gnss_parse_gpgga", parser.gga.altitude, ( long ) ( atof( alt ) * 100 + 0.5 ) );
+}
+
+// --------------------------------------------------------------------- BENCH
+
+static double bench_streaming ( void )
+{
+    gnss_nmea_parser_t parser;
+    volatile int32_t sink = 0;
+    clock_t start = clock( );
+
+    gnss_nmea_parser_init( &parser );
+    for ( uint32_t run = 0; run < BENCH_RUNS; run++ )
+    {
+        for ( size_t cnt = 0; cnt < epoch_len; cnt++ )
+        {
+            gnss_nmea_parse_byte( &parser, epoch[ cnt ] );
+        }
+        sink += parser.gga.altitude;
+    }
+    ( void ) sink;
+    return ( double ) ( clock( ) - start ) / CLOCKS_PER_SEC / BENCH_RUNS * 1e9;
+}
+
+static void legacy_epoch ( const uint8_t *elements, uint8_t n_elements )
+{
+    char element[ 32 ];
+
+    for ( uint8_t cnt = 0; cnt < n_elements; cnt++ )
+    {
+        memset( element, 0, sizeof( element ) );
+        gnss_parse_gpgga( epoch, elements[ cnt ], element );
+    }
+}
+
+static double bench_legacy ( const uint8_t *elements, uint8_t n_elements )
+{
+    clock_t start = clock( );
+
+    for ( uint32_t run = 0; run < BENCH_RUNS; run++ )
+    {
+        legacy_epoch( elements, n_elements );
+    }
+    return ( double ) ( clock( ) - start ) / CLOCKS_PER_SEC / BENCH_RUNS * 1e9;
+}
+
+static void bench ( void )
+{
+    static const uint8_t example_fields[ ] = { GNSS_GPGGA_LATITUDE, GNSS_GPGGA_LONGITUDE, GNSS_GPGGA_ALTITUDE };
+    static const uint8_t all_fields[ ] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 };
+    unsigned long example_chars;
+    unsigned long all_chars;
+    double stream_ns = bench_streaming( );
+    double example_ns = bench_legacy( example_fields, sizeof( example_fields ) );
+    double all_ns = bench_legacy( all_fields, sizeof( all_fields ) );
+
+    strstr_chars = 0;
+    legacy_epoch( example_fields, sizeof( example_fields ) );
+    example_chars = strstr_chars;
+    strstr_chars = 0;
+    legacy_epoch( all_fields, sizeof( all_fields ) );
+    all_chars = strstr_chars;
+
+    printf( "Streaming, all %u sentences: %5lu characters, %6.0f ns per epoch\n",
+            ( unsigned ) EPOCH_SENTENCES, ( unsigned long ) epoch_len, stream_ns );
+    printf( "gnss_parse_gpgga, 3 GGA fields: %5lu characters, %6.0f ns per epoch\n", example_chars, example_ns );
+    printf( "gnss_parse_gpgga, 13 GGA fields: %5lu characters, %6.0f ns per epoch\n", all_chars, all_ns );
+    if ( all_chars <= epoch_len )
+    {
+        printf( "FAIL: gnss_parse_gpgga examines %lu characters for %lu bytes\n", all_chars,
+                ( unsigned long ) epoch_len );
+        failures++;
+    }
+}
+
+int main ( void )
+{
+    gnss_cfg_t cfg;
+    gnss_t ctx;
+
+    hal_sim_reset( );
+    hal_sim_uart_read = rx_read;
+    hal_sim_uart_bytes_available = rx_available;
+    gnss_cfg_setup( &cfg );
+    if ( gnss_init( &ctx, &cfg ) )
+    {
+        printf( "FAIL: init\n" );
+        return EXIT_FAILURE;
+    }
+    build_epoch( );
+
+    check_epoch( &ctx );
+    check_damaged( &ctx, "a wrong checksum",
+                   "$GPVTG,054.70,T,034.40,M,005.50,N,010.20,K,A*00\r\n", 1 );
+    check_damaged( &ctx, "a sentence cut short", "$GPVTG,054.70,T,034.4", 0 );
+    check_damaged( &ctx, "an unknown sentence", "$GPGLL,4916.45,N,12311.12,W,225444,A*31\r\n", 0 );
+    check_damaged( &ctx, "an overlong field", "$GPVTG,054.700000000000000000,T*00\r\n", 0 );
+    check_legacy( );
+    bench( );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,25 @@
+/*
+ * Host build shim of the mikroSDK conversions library, the C library
+ * provides everything the click drivers need on the host apart from the
+ * fixed width integer conversions below.
+ */
+#ifndef CONVERSIONS_H
+#define CONVERSIONS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// Right aligned in 3 characters, as the mikroSDK conversion
+static inline void uint8_to_str ( uint8_t input, char *output )
+{
+    sprintf( output, "%3u", ( unsigned ) input );
+}
+
+// Two upper case hex digits
+static inline void uint8_to_hex ( uint8_t input, char *output )
+{
+    sprintf( output, "%02X", ( unsigned ) input );
+}
+
+#endif // CONVERSIONS_H
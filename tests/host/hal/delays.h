@@ -0,0 +1,33 @@
+/*
+ * Host build shim of the mikroSDK delay API. Delays advance the simulated
+ * clock of hal_sim.c and return immediately.
+ */
+#ifndef DELAYS_H
+#define DELAYS_H
+
+#include "hal_sim.h"
+
+void Delay_us ( uint32_t time_us );
+void Delay_ms ( uint32_t time_ms );
+void Delay_1us ( void );
+void Delay_5us ( void );
+void Delay_6us ( void );
+void Delay_10us ( void );
+void Delay_22us ( void );
+void Delay_50us ( void );
+void Delay_60us ( void );
+void Delay_80us ( void );
+void Delay_100us ( void );
+void Delay_500us ( void );
+void Delay_1ms ( void );
+void Delay_5ms ( void );
+void Delay_8ms ( void );
+void Delay_10ms ( void );
+void Delay_22ms ( void );
+void Delay_50ms ( void );
+void Delay_80ms ( void );
+void Delay_100ms ( void );
+void Delay_500ms ( void );
+void Delay_1sec ( void );
+
+#endif // DELAYS_H
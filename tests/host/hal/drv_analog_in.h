@@ -0,0 +1,63 @@
+/*
+ * Host build shim of the mikroSDK analog input driver API used by the click drivers.
+ * Conversions are provided by hal_sim.c and can be redirected by each test.
+ */
+#ifndef DRV_ANALOG_IN_H
+#define DRV_ANALOG_IN_H
+
+#include "hal_sim.h"
+
+typedef enum
+{
+    ADC_SUCCESS = 0,
+    ADC_ERROR = -1
+
+} analog_in_err_t;
+
+typedef enum
+{
+    ANALOG_IN_RESOLUTION_NOT_SET = 0,
+    ANALOG_IN_RESOLUTION_6_BIT,
+    ANALOG_IN_RESOLUTION_8_BIT,
+    ANALOG_IN_RESOLUTION_10_BIT,
+    ANALOG_IN_RESOLUTION_12_BIT,
+    ANALOG_IN_RESOLUTION_14_BIT,
+    ANALOG_IN_RESOLUTION_16_BIT,
+
+    ANALOG_IN_RESOLUTION_DEFAULT = ANALOG_IN_RESOLUTION_12_BIT
+
+} analog_in_resolution_t;
+
+typedef enum
+{
+    ANALOG_IN_VREF_EXTERNAL = 0,
+    ANALOG_IN_VREF_INTERNAL,
+
+    ANALOG_IN_VREF_DEFAULT = ANALOG_IN_VREF_EXTERNAL
+
+} analog_in_vref_t;
+
+typedef struct
+{
+    pin_name_t input_pin;
+    analog_in_resolution_t resolution;
+    analog_in_vref_t vref_input;
+    float vref_value;
+
+} analog_in_config_t;
+
+typedef struct
+{
+    analog_in_config_t config;
+
+} analog_in_t;
+
+void analog_in_configure_default ( analog_in_config_t *config );
+err_t analog_in_open ( analog_in_t *obj, analog_in_config_t *config );
+err_t analog_in_set_resolution ( analog_in_t *obj, analog_in_resolution_t resolution );
+err_t analog_in_set_vref_input ( analog_in_t *obj, analog_in_vref_t vref );
+err_t analog_in_set_vref_value ( analog_in_t *obj, float vref_value );
+err_t analog_in_read ( analog_in_t *obj, uint16_t *read_data_buf );
+err_t analog_in_read_voltage ( analog_in_t *obj, float *read_data_buf );
+
+#endif // DRV_ANALOG_IN_H
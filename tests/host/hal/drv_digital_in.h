@@ -0,0 +1,27 @@
+/*
+ * Host build shim of the mikroSDK digital input driver API.
+ */
+#ifndef DRV_DIGITAL_IN_H
+#define DRV_DIGITAL_IN_H
+
+#include "hal_sim.h"
+
+typedef enum
+{
+    DIGITAL_IN_SUCCESS = 0,
+    DIGITAL_IN_UNSUPPORTED_PIN = -1
+
+} digital_in_err_t;
+
+typedef struct
+{
+    pin_name_t pin;
+
+} digital_in_t;
+
+err_t digital_in_init ( digital_in_t *in, pin_name_t name );
+err_t digital_in_pull_up_init ( digital_in_t *in, pin_name_t name );
+err_t digital_in_pull_down_init ( digital_in_t *in, pin_name_t name );
+uint8_t digital_in_read ( digital_in_t *in );
+
+#endif // DRV_DIGITAL_IN_H
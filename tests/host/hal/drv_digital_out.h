@@ -0,0 +1,22 @@
+/*
+ * Host build shim of the mikroSDK digital output driver API.
+ */
+#ifndef DRV_DIGITAL_OUT_H
+#define DRV_DIGITAL_OUT_H
+
+#include "hal_sim.h"
+
+typedef struct
+{
+    pin_name_t pin;
+    uint8_t state;
+
+} digital_out_t;
+
+err_t digital_out_init ( digital_out_t *out, pin_name_t name );
+void digital_out_high ( digital_out_t *out );
+void digital_out_low ( digital_out_t *out );
+void digital_out_toggle ( digital_out_t *out );
+void digital_out_write ( digital_out_t *out, uint8_t value );
+
+#endif // DRV_DIGITAL_OUT_H
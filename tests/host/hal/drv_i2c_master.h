@@ -0,0 +1,48 @@
+/*
+ * Host build shim of the mikroSDK I2C master driver API used by the click drivers.
+ * Behaviour is provided by hal_sim.c and can be redirected by each test.
+ */
+#ifndef DRV_I2C_MASTER_H
+#define DRV_I2C_MASTER_H
+
+#include "hal_sim.h"
+
+#define I2C_MASTER_SUCCESS  0
+#define I2C_MASTER_ERROR   -1
+
+typedef enum
+{
+    I2C_MASTER_SPEED_STANDARD = 0,
+    I2C_MASTER_SPEED_FULL,
+    I2C_MASTER_SPEED_FAST
+
+} i2c_master_speed_t;
+
+typedef struct
+{
+    uint8_t addr;
+    pin_name_t sda;
+    pin_name_t scl;
+    uint32_t speed;
+    uint16_t timeout_pass_count;
+
+} i2c_master_config_t;
+
+typedef struct
+{
+    i2c_master_config_t config;
+
+} i2c_master_t;
+
+void i2c_master_configure_default ( i2c_master_config_t *config );
+err_t i2c_master_open ( i2c_master_t *obj, i2c_master_config_t *config );
+err_t i2c_master_set_speed ( i2c_master_t *obj, uint32_t speed );
+void i2c_master_set_timeout ( i2c_master_t *obj, uint16_t timeout_pass_count );
+err_t i2c_master_set_slave_address ( i2c_master_t *obj, uint8_t address );
+err_t i2c_master_write ( i2c_master_t *obj, uint8_t *write_data_buf, size_t len_write_data );
+err_t i2c_master_read ( i2c_master_t *obj, uint8_t *read_data_buf, size_t len_read_data );
+err_t i2c_master_write_then_read ( i2c_master_t *obj, uint8_t *write_data_buf, size_t len_write_data,
+                                   uint8_t *read_data_buf, size_t len_read_data );
+void i2c_master_close ( i2c_master_t *obj );
+
+#endif // DRV_I2C_MASTER_H
@@ -0,0 +1,37 @@
+/*
+ * Host build shim of the mikroSDK One Wire driver API used by the click drivers.
+ * Behaviour is provided by hal_sim.c and can be redirected by each test.
+ */
+#ifndef DRV_ONE_WIRE_H
+#define DRV_ONE_WIRE_H
+
+#include "hal_sim.h"
+
+#define ONE_WIRE_SUCCESS  0
+#define ONE_WIRE_ERROR   -1
+
+typedef struct
+{
+    uint8_t address[ 8 ];
+
+} one_wire_rom_address_t;
+
+typedef struct
+{
+    pin_name_t data_pin;
+    bool state;
+
+} one_wire_t;
+
+void one_wire_configure_default ( one_wire_t *obj );
+err_t one_wire_open ( one_wire_t *obj );
+err_t one_wire_reset ( one_wire_t *obj );
+err_t one_wire_read_rom ( one_wire_t *obj, one_wire_rom_address_t *device_rom_address );
+err_t one_wire_skip_rom ( one_wire_t *obj );
+err_t one_wire_match_rom ( one_wire_t *obj, one_wire_rom_address_t *device_rom_address );
+err_t one_wire_search_first_device ( one_wire_t *obj, one_wire_rom_address_t *one_wire_device_list );
+err_t one_wire_search_next_device ( one_wire_t *obj, one_wire_rom_address_t *one_wire_device_list );
+err_t one_wire_write_byte ( one_wire_t *obj, uint8_t *write_data_buffer, size_t write_data_length );
+err_t one_wire_read_byte ( one_wire_t *obj, uint8_t *read_data_buffer, size_t read_data_length );
+
+#endif // DRV_ONE_WIRE_H
@@ -0,0 +1,62 @@
+/*
+ * Host build shim of the mikroSDK SPI master driver API used by the click drivers.
+ * Behaviour is provided by hal_sim.c and can be redirected by each test.
+ */
+#ifndef DRV_SPI_MASTER_H
+#define DRV_SPI_MASTER_H
+
+#include "hal_sim.h"
+
+#define SPI_MASTER_SUCCESS  0
+#define SPI_MASTER_ERROR   -1
+
+typedef enum
+{
+    SPI_MASTER_MODE_0 = 0,
+    SPI_MASTER_MODE_1,
+    SPI_MASTER_MODE_2,
+    SPI_MASTER_MODE_3,
+    SPI_MASTER_MODE_DEFAULT = SPI_MASTER_MODE_0
+
+} spi_master_mode_t;
+
+typedef enum
+{
+    SPI_MASTER_CHIP_SELECT_POLARITY_ACTIVE_LOW = 0,
+    SPI_MASTER_CHIP_SELECT_POLARITY_ACTIVE_HIGH,
+    SPI_MASTER_CHIP_SELECT_DEFAULT_POLARITY = SPI_MASTER_CHIP_SELECT_POLARITY_ACTIVE_LOW
+
+} spi_master_chip_select_polarity_t;
+
+typedef struct
+{
+    uint8_t default_write_data;
+    pin_name_t sck;
+    pin_name_t miso;
+    pin_name_t mosi;
+    uint32_t speed;
+    spi_master_mode_t mode;
+
+} spi_master_config_t;
+
+typedef struct
+{
+    spi_master_config_t config;
+
+} spi_master_t;
+
+void spi_master_configure_default ( spi_master_config_t *config );
+err_t spi_master_open ( spi_master_t *obj, spi_master_config_t *config );
+void spi_master_select_device ( pin_name_t chip_select );
+void spi_master_deselect_device ( pin_name_t chip_select );
+void spi_master_set_chip_select_polarity ( spi_master_chip_select_polarity_t polarity );
+err_t spi_master_set_default_write_data ( spi_master_t *obj, uint8_t default_write_data );
+err_t spi_master_set_speed ( spi_master_t *obj, uint32_t speed );
+err_t spi_master_set_mode ( spi_master_t *obj, spi_master_mode_t mode );
+err_t spi_master_write ( spi_master_t *obj, uint8_t *write_data_buffer, size_t write_data_length );
+err_t spi_master_read ( spi_master_t *obj, uint8_t *read_data_buffer, size_t read_data_length );
+err_t spi_master_write_then_read ( spi_master_t *obj, uint8_t *write_data_buffer, size_t length_write_data,
+                                   uint8_t *read_data_buffer, size_t length_read_data );
+void spi_master_close ( spi_master_t *obj );
+
+#endif // DRV_SPI_MASTER_H
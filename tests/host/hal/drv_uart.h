@@ -0,0 +1,51 @@
+/*
+ * Host build shim of the mikroSDK UART driver API used by the click drivers.
+ * Behaviour is provided by hal_sim.c and can be redirected by each test.
+ */
+#ifndef DRV_UART_H
+#define DRV_UART_H
+
+#include "hal_sim.h"
+
+#define UART_SUCCESS            0
+#define UART_ERROR             -1
+#define UART_DATA_BITS_DEFAULT  8
+#define UART_PARITY_DEFAULT     0
+#define UART_STOP_BITS_DEFAULT  1
+
+typedef int uart_data_bits_t;
+typedef int uart_parity_t;
+typedef int uart_stop_bits_t;
+
+typedef struct
+{
+    char *tx_ring_buffer;
+    char *rx_ring_buffer;
+
+} uart_t;
+
+typedef struct
+{
+    pin_name_t rx_pin;
+    pin_name_t tx_pin;
+    size_t tx_ring_size;
+    size_t rx_ring_size;
+
+} uart_config_t;
+
+void uart_configure_default ( uart_config_t *config );
+err_t uart_open ( uart_t *obj, uart_config_t *config );
+err_t uart_set_baud ( uart_t *obj, uint32_t baud );
+err_t uart_set_parity ( uart_t *obj, uart_parity_t parity );
+err_t uart_set_stop_bits ( uart_t *obj, uart_stop_bits_t stop );
+err_t uart_set_data_bits ( uart_t *obj, uart_data_bits_t bits );
+void uart_set_blocking ( uart_t *obj, bool blocking );
+err_t uart_write ( uart_t *obj, char *buffer, size_t size );
+err_t uart_print ( uart_t *obj, char *text );
+err_t uart_println ( uart_t *obj, char *text );
+err_t uart_read ( uart_t *obj, char *buffer, size_t size );
+size_t uart_bytes_available ( uart_t *obj );
+void uart_clear ( uart_t *obj );
+void uart_close ( uart_t *obj );
+
+#endif // DRV_UART_H
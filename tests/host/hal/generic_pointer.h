@@ -0,0 +1,10 @@
+/*
+ * Host build shim of the mikroSDK generic pointer qualifier, host pointers
+ * reach every address space so the qualifier is empty.
+ */
+#ifndef GENERIC_POINTER_H
+#define GENERIC_POINTER_H
+
+#define __generic_ptr
+
+#endif // GENERIC_POINTER_H
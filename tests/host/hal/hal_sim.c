@@ -0,0 +1,559 @@
+/*
+ * Default behaviour of the host simulation layer: buses accept every write,
+ * reads return nothing and delays only advance the simulated clock.
+ */
+#include "hal_sim.h"
+#include "delays.h"
+#include "drv_uart.h"
+#include "drv_digital_out.h"
+#include "drv_digital_in.h"
+#include "drv_i2c_master.h"
+#include "drv_spi_master.h"
+#include "drv_one_wire.h"
+#include "drv_analog_in.h"
+
+uint64_t hal_sim_time_us;
+
+static err_t default_uart_write ( void *obj, char *buffer, size_t size )
+{
+    ( void ) obj;
+    ( void ) buffer;
+    return ( err_t ) size;
+}
+
+static err_t default_uart_read ( void *obj, char *buffer, size_t size )
+{
+    ( void ) obj;
+    ( void ) buffer;
+    ( void ) size;
+    return 0;
+}
+
+static size_t default_uart_bytes_available ( void *obj )
+{
+    ( void ) obj;
+    return 0;
+}
+
+static err_t default_i2c_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                                    uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    ( void ) address;
+    ( void ) write_buf;
+    ( void ) write_len;
+    if ( read_len )
+    {
+        memset( read_buf, 0, read_len );
+    }
+    return I2C_MASTER_SUCCESS;
+}
+
+static err_t default_spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    ( void ) buffer;
+    ( void ) size;
+    return SPI_MASTER_SUCCESS;
+}
+
+static err_t default_spi_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    memset( buffer, 0, size );
+    return SPI_MASTER_SUCCESS;
+}
+
+static void default_spi_select ( pin_name_t cs, uint8_t selected )
+{
+    ( void ) cs;
+    ( void ) selected;
+}
+
+static err_t default_one_wire_reset ( void *obj )
+{
+    ( void ) obj;
+    return ONE_WIRE_SUCCESS;
+}
+
+static err_t default_one_wire_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    ( void ) buffer;
+    ( void ) size;
+    return ONE_WIRE_SUCCESS;
+}
+
+static err_t default_one_wire_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    memset( buffer, 0xFF, size );
+    return ONE_WIRE_SUCCESS;
+}
+
+static err_t default_analog_read ( void *obj, uint16_t *value )
+{
+    ( void ) obj;
+    *value = 0;
+    return ADC_SUCCESS;
+}
+
+static void default_gpio_write ( void *obj, pin_name_t pin, uint8_t state )
+{
+    ( void ) obj;
+    ( void ) pin;
+    ( void ) state;
+}
+
+static uint8_t default_gpio_read ( void *obj, pin_name_t pin )
+{
+    ( void ) obj;
+    ( void ) pin;
+    return 0;
+}
+
+err_t ( *hal_sim_uart_write )( void *obj, char *buffer, size_t size ) = default_uart_write;
+err_t ( *hal_sim_uart_read )( void *obj, char *buffer, size_t size ) = default_uart_read;
+size_t ( *hal_sim_uart_bytes_available )( void *obj ) = default_uart_bytes_available;
+err_t ( *hal_sim_i2c_transfer )( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                                 uint8_t *read_buf, size_t read_len ) = default_i2c_transfer;
+err_t ( *hal_sim_spi_write )( void *obj, uint8_t *buffer, size_t size ) = default_spi_write;
+err_t ( *hal_sim_spi_read )( void *obj, uint8_t *buffer, size_t size ) = default_spi_read;
+void ( *hal_sim_spi_select )( pin_name_t cs, uint8_t selected ) = default_spi_select;
+err_t ( *hal_sim_one_wire_reset )( void *obj ) = default_one_wire_reset;
+err_t ( *hal_sim_one_wire_write )( void *obj, uint8_t *buffer, size_t size ) = default_one_wire_write;
+err_t ( *hal_sim_one_wire_read )( void *obj, uint8_t *buffer, size_t size ) = default_one_wire_read;
+err_t ( *hal_sim_analog_read )( void *obj, uint16_t *value ) = default_analog_read;
+void ( *hal_sim_gpio_write )( void *obj, pin_name_t pin, uint8_t state ) = default_gpio_write;
+uint8_t ( *hal_sim_gpio_read )( void *obj, pin_name_t pin ) = default_gpio_read;
+
+void hal_sim_reset ( void )
+{
+    hal_sim_time_us = 0;
+    hal_sim_uart_write = default_uart_write;
+    hal_sim_uart_read = default_uart_read;
+    hal_sim_uart_bytes_available = default_uart_bytes_available;
+    hal_sim_i2c_transfer = default_i2c_transfer;
+    hal_sim_spi_write = default_spi_write;
+    hal_sim_spi_read = default_spi_read;
+    hal_sim_spi_select = default_spi_select;
+    hal_sim_one_wire_reset = default_one_wire_reset;
+    hal_sim_one_wire_write = default_one_wire_write;
+    hal_sim_one_wire_read = default_one_wire_read;
+    hal_sim_analog_read = default_analog_read;
+    hal_sim_gpio_write = default_gpio_write;
+    hal_sim_gpio_read = default_gpio_read;
+}
+
+// ----------------------------------------------------------------------- UART
+
+void uart_configure_default ( uart_config_t *config )
+{
+    memset( config, 0, sizeof( uart_config_t ) );
+}
+
+err_t uart_open ( uart_t *obj, uart_config_t *config )
+{
+    ( void ) obj;
+    ( void ) config;
+    return UART_SUCCESS;
+}
+
+err_t uart_set_baud ( uart_t *obj, uint32_t baud )
+{
+    ( void ) obj;
+    ( void ) baud;
+    return UART_SUCCESS;
+}
+
+err_t uart_set_parity ( uart_t *obj, uart_parity_t parity )
+{
+    ( void ) obj;
+    ( void ) parity;
+    return UART_SUCCESS;
+}
+
+err_t uart_set_stop_bits ( uart_t *obj, uart_stop_bits_t stop )
+{
+    ( void ) obj;
+    ( void ) stop;
+    return UART_SUCCESS;
+}
+
+err_t uart_set_data_bits ( uart_t *obj, uart_data_bits_t bits )
+{
+    ( void ) obj;
+    ( void ) bits;
+    return UART_SUCCESS;
+}
+
+void uart_set_blocking ( uart_t *obj, bool blocking )
+{
+    ( void ) obj;
+    ( void ) blocking;
+}
+
+err_t uart_write ( uart_t *obj, char *buffer, size_t size )
+{
+    return hal_sim_uart_write( obj, buffer, size );
+}
+
+err_t uart_print ( uart_t *obj, char *text )
+{
+    return hal_sim_uart_write( obj, text, strlen( text ) );
+}
+
+err_t uart_println ( uart_t *obj, char *text )
+{
+    err_t len = hal_sim_uart_write( obj, text, strlen( text ) );
+    return len + hal_sim_uart_write( obj, "\r\n", 2 );
+}
+
+err_t uart_read ( uart_t *obj, char *buffer, size_t size )
+{
+    return hal_sim_uart_read( obj, buffer, size );
+}
+
+size_t uart_bytes_available ( uart_t *obj )
+{
+    return hal_sim_uart_bytes_available( obj );
+}
+
+void uart_clear ( uart_t *obj )
+{
+    char dummy[ 64 ];
+    while ( hal_sim_uart_read( obj, dummy, sizeof( dummy ) ) > 0 );
+}
+
+void uart_close ( uart_t *obj )
+{
+    ( void ) obj;
+}
+
+// ------------------------------------------------------------------------ I2C
+
+void i2c_master_configure_default ( i2c_master_config_t *config )
+{
+    memset( config, 0, sizeof( i2c_master_config_t ) );
+    config->speed = I2C_MASTER_SPEED_STANDARD;
+    config->timeout_pass_count = 10000;
+}
+
+err_t i2c_master_open ( i2c_master_t *obj, i2c_master_config_t *config )
+{
+    obj->config = *config;
+    return I2C_MASTER_SUCCESS;
+}
+
+err_t i2c_master_set_speed ( i2c_master_t *obj, uint32_t speed )
+{
+    obj->config.speed = speed;
+    return I2C_MASTER_SUCCESS;
+}
+
+void i2c_master_set_timeout ( i2c_master_t *obj, uint16_t timeout_pass_count )
+{
+    obj->config.timeout_pass_count = timeout_pass_count;
+}
+
+err_t i2c_master_set_slave_address ( i2c_master_t *obj, uint8_t address )
+{
+    obj->config.addr = address;
+    return I2C_MASTER_SUCCESS;
+}
+
+err_t i2c_master_write ( i2c_master_t *obj, uint8_t *write_data_buf, size_t len_write_data )
+{
+    return hal_sim_i2c_transfer( obj, obj->config.addr, write_data_buf, len_write_data, NULL, 0 );
+}
+
+err_t i2c_master_read ( i2c_master_t *obj, uint8_t *read_data_buf, size_t len_read_data )
+{
+    return hal_sim_i2c_transfer( obj, obj->config.addr, NULL, 0, read_data_buf, len_read_data );
+}
+
+err_t i2c_master_write_then_read ( i2c_master_t *obj, uint8_t *write_data_buf, size_t len_write_data,
+                                   uint8_t *read_data_buf, size_t len_read_data )
+{
+    return hal_sim_i2c_transfer( obj, obj->config.addr, write_data_buf, len_write_data,
+                                 read_data_buf, len_read_data );
+}
+
+void i2c_master_close ( i2c_master_t *obj )
+{
+    ( void ) obj;
+}
+
+// ------------------------------------------------------------------------ SPI
+
+void spi_master_configure_default ( spi_master_config_t *config )
+{
+    memset( config, 0, sizeof( spi_master_config_t ) );
+    config->speed = 100000;
+}
+
+err_t spi_master_open ( spi_master_t *obj, spi_master_config_t *config )
+{
+    obj->config = *config;
+    return SPI_MASTER_SUCCESS;
+}
+
+void spi_master_select_device ( pin_name_t chip_select )
+{
+    hal_sim_spi_select( chip_select, 1 );
+}
+
+void spi_master_deselect_device ( pin_name_t chip_select )
+{
+    hal_sim_spi_select( chip_select, 0 );
+}
+
+void spi_master_set_chip_select_polarity ( spi_master_chip_select_polarity_t polarity )
+{
+    ( void ) polarity;
+}
+
+err_t spi_master_set_default_write_data ( spi_master_t *obj, uint8_t default_write_data )
+{
+    obj->config.default_write_data = default_write_data;
+    return SPI_MASTER_SUCCESS;
+}
+
+err_t spi_master_set_speed ( spi_master_t *obj, uint32_t speed )
+{
+    obj->config.speed = speed;
+    return SPI_MASTER_SUCCESS;
+}
+
+err_t spi_master_set_mode ( spi_master_t *obj, spi_master_mode_t mode )
+{
+    obj->config.mode = mode;
+    return SPI_MASTER_SUCCESS;
+}
+
+err_t spi_master_write ( spi_master_t *obj, uint8_t *write_data_buffer, size_t write_data_length )
+{
+    return hal_sim_spi_write( obj, write_data_buffer, write_data_length );
+}
+
+err_t spi_master_read ( spi_master_t *obj, uint8_t *read_data_buffer, size_t read_data_length )
+{
+    return hal_sim_spi_read( obj, read_data_buffer, read_data_length );
+}
+
+err_t spi_master_write_then_read ( spi_master_t *obj, uint8_t *write_data_buffer, size_t length_write_data,
+                                   uint8_t *read_data_buffer, size_t length_read_data )
+{
+    if ( SPI_MASTER_SUCCESS != hal_sim_spi_write( obj, write_data_buffer, length_write_data ) )
+    {
+        return SPI_MASTER_ERROR;
+    }
+    return hal_sim_spi_read( obj, read_data_buffer, length_read_data );
+}
+
+void spi_master_close ( spi_master_t *obj )
+{
+    ( void ) obj;
+}
+
+// ------------------------------------------------------------------- ONE WIRE
+
+#define ONE_WIRE_CMD_READ_ROM   0x33
+#define ONE_WIRE_CMD_MATCH_ROM  0x55
+#define ONE_WIRE_CMD_SKIP_ROM   0xCC
+
+static err_t one_wire_command ( one_wire_t *obj, uint8_t cmd )
+{
+    if ( ONE_WIRE_SUCCESS != hal_sim_one_wire_reset( obj ) )
+    {
+        return ONE_WIRE_ERROR;
+    }
+    return hal_sim_one_wire_write( obj, &cmd, 1 );
+}
+
+void one_wire_configure_default ( one_wire_t *obj )
+{
+    obj->data_pin = HAL_PIN_NC;
+    obj->state = false;
+}
+
+err_t one_wire_open ( one_wire_t *obj )
+{
+    return ( HAL_PIN_NC == obj->data_pin ) ? ONE_WIRE_ERROR : ONE_WIRE_SUCCESS;
+}
+
+err_t one_wire_reset ( one_wire_t *obj )
+{
+    return hal_sim_one_wire_reset( obj );
+}
+
+err_t one_wire_read_rom ( one_wire_t *obj, one_wire_rom_address_t *device_rom_address )
+{
+    if ( ONE_WIRE_SUCCESS != one_wire_command( obj, ONE_WIRE_CMD_READ_ROM ) )
+    {
+        return ONE_WIRE_ERROR;
+    }
+    return hal_sim_one_wire_read( obj, device_rom_address->address, sizeof( device_rom_address->address ) );
+}
+
+err_t one_wire_skip_rom ( one_wire_t *obj )
+{
+    return one_wire_command( obj, ONE_WIRE_CMD_SKIP_ROM );
+}
+
+err_t one_wire_match_rom ( one_wire_t *obj, one_wire_rom_address_t *device_rom_address )
+{
+    if ( ONE_WIRE_SUCCESS != one_wire_command( obj, ONE_WIRE_CMD_MATCH_ROM ) )
+    {
+        return ONE_WIRE_ERROR;
+    }
+    return hal_sim_one_wire_write( obj, device_rom_address->address, sizeof( device_rom_address->address ) );
+}
+
+// A single device is modelled on the bus, so searching reports its ROM address.
+err_t one_wire_search_first_device ( one_wire_t *obj, one_wire_rom_address_t *one_wire_device_list )
+{
+    return one_wire_read_rom( obj, one_wire_device_list );
+}
+
+err_t one_wire_search_next_device ( one_wire_t *obj, one_wire_rom_address_t *one_wire_device_list )
+{
+    ( void ) obj;
+    ( void ) one_wire_device_list;
+    return ONE_WIRE_ERROR;
+}
+
+err_t one_wire_write_byte ( one_wire_t *obj, uint8_t *write_data_buffer, size_t write_data_length )
+{
+    return hal_sim_one_wire_write( obj, write_data_buffer, write_data_length );
+}
+
+err_t one_wire_read_byte ( one_wire_t *obj, uint8_t *read_data_buffer, size_t read_data_length )
+{
+    return hal_sim_one_wire_read( obj, read_data_buffer, read_data_length );
+}
+
+// ------------------------------------------------------------------ ANALOG IN
+
+void analog_in_configure_default ( analog_in_config_t *config )
+{
+    config->input_pin = HAL_PIN_NC;
+    config->resolution = ANALOG_IN_RESOLUTION_DEFAULT;
+    config->vref_input = ANALOG_IN_VREF_DEFAULT;
+    config->vref_value = 3.3;
+}
+
+err_t analog_in_open ( analog_in_t *obj, analog_in_config_t *config )
+{
+    obj->config = *config;
+    return ADC_SUCCESS;
+}
+
+err_t analog_in_set_resolution ( analog_in_t *obj, analog_in_resolution_t resolution )
+{
+    obj->config.resolution = resolution;
+    return ADC_SUCCESS;
+}
+
+err_t analog_in_set_vref_input ( analog_in_t *obj, analog_in_vref_t vref )
+{
+    obj->config.vref_input = vref;
+    return ADC_SUCCESS;
+}
+
+err_t analog_in_set_vref_value ( analog_in_t *obj, float vref_value )
+{
+    obj->config.vref_value = vref_value;
+    return ADC_SUCCESS;
+}
+
+err_t analog_in_read ( analog_in_t *obj, uint16_t *read_data_buf )
+{
+    return hal_sim_analog_read( obj, read_data_buf );
+}
+
+err_t analog_in_read_voltage ( analog_in_t *obj, float *read_data_buf )
+{
+    static const uint8_t bits[ ] = { 12, 6, 8, 10, 12, 14, 16 };
+    uint16_t value = 0;
+    err_t error_flag = hal_sim_analog_read( obj, &value );
+
+    *read_data_buf = value * obj->config.vref_value / ( ( 1ul << bits[ obj->config.resolution ] ) - 1 );
+    return error_flag;
+}
+
+// ----------------------------------------------------------------------- GPIO
+
+err_t digital_out_init ( digital_out_t *out, pin_name_t name )
+{
+    out->pin = name;
+    out->state = 0;
+    return 0;
+}
+
+void digital_out_high ( digital_out_t *out )
+{
+    digital_out_write( out, 1 );
+}
+
+void digital_out_low ( digital_out_t *out )
+{
+    digital_out_write( out, 0 );
+}
+
+void digital_out_toggle ( digital_out_t *out )
+{
+    digital_out_write( out, !out->state );
+}
+
+void digital_out_write ( digital_out_t *out, uint8_t value )
+{
+    out->state = value ? 1 : 0;
+    hal_sim_gpio_write( out, out->pin, out->state );
+}
+
+err_t digital_in_init ( digital_in_t *in, pin_name_t name )
+{
+    in->pin = name;
+    return 0;
+}
+
+err_t digital_in_pull_up_init ( digital_in_t *in, pin_name_t name )
+{
+    return digital_in_init( in, name );
+}
+
+err_t digital_in_pull_down_init ( digital_in_t *in, pin_name_t name )
+{
+    return digital_in_init( in, name );
+}
+
+uint8_t digital_in_read ( digital_in_t *in )
+{
+    return hal_sim_gpio_read( in, in->pin );
+}
+
+// --------------------------------------------------------------------- DELAYS
+
+void Delay_us ( uint32_t time_us ) { hal_sim_time_us += time_us; }
+void Delay_ms ( uint32_t time_ms ) { hal_sim_time_us += ( uint64_t ) time_ms * 1000; }
+void Delay_1us ( void ) { Delay_us( 1 ); }
+void Delay_5us ( void ) { Delay_us( 5 ); }
+void Delay_6us ( void ) { Delay_us( 6 ); }
+void Delay_10us ( void ) { Delay_us( 10 ); }
+void Delay_22us ( void ) { Delay_us( 22 ); }
+void Delay_50us ( void ) { Delay_us( 50 ); }
+void Delay_60us ( void ) { Delay_us( 60 ); }
+void Delay_80us ( void ) { Delay_us( 80 ); }
+void Delay_100us ( void ) { Delay_us( 100 ); }
+void Delay_500us ( void ) { Delay_us( 500 ); }
+void Delay_1ms ( void ) { Delay_ms( 1 ); }
+void Delay_5ms ( void ) { Delay_ms( 5 ); }
+void Delay_8ms ( void ) { Delay_ms( 8 ); }
+void Delay_10ms ( void ) { Delay_ms( 10 ); }
+void Delay_22ms ( void ) { Delay_ms( 22 ); }
+void Delay_50ms ( void ) { Delay_ms( 50 ); }
+void Delay_80ms ( void ) { Delay_ms( 80 ); }
+void Delay_100ms ( void ) { Delay_ms( 100 ); }
+void Delay_500ms ( void ) { Delay_ms( 500 ); }
+void Delay_1sec ( void ) { Delay_ms( 1000 ); }
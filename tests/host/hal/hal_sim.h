@@ -0,0 +1,70 @@
+/*
+ * Host simulation layer for building click drivers against the mikroSDK
+ * driver API. Every bus call is routed through a hook that a test can
+ * replace to model the device, and every Delay_* call advances a
+ * simulated clock instead of sleeping.
+ */
+#ifndef HAL_SIM_H
+#define HAL_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef int32_t err_t;
+typedef uint32_t pin_name_t;
+
+#define HAL_PIN_NC  0xFFFFFFFFul
+
+/**
+ * @brief Simulated time in microseconds, advanced by the delay shims.
+ */
+extern uint64_t hal_sim_time_us;
+
+/**
+ * @brief UART hooks, the object pointer identifies the driver instance.
+ */
+extern err_t ( *hal_sim_uart_write )( void *obj, char *buffer, size_t size );
+extern err_t ( *hal_sim_uart_read )( void *obj, char *buffer, size_t size );
+extern size_t ( *hal_sim_uart_bytes_available )( void *obj );
+
+/**
+ * @brief I2C hook, one call per bus transaction. A write is sent with an
+ * empty read part, a read with an empty write part and a write then read
+ * as a single transaction with a repeated start.
+ */
+extern err_t ( *hal_sim_i2c_transfer )( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                                        uint8_t *read_buf, size_t read_len );
+
+/**
+ * @brief SPI hooks, chip select changes are reported with the pin and its logic level.
+ */
+extern err_t ( *hal_sim_spi_write )( void *obj, uint8_t *buffer, size_t size );
+extern err_t ( *hal_sim_spi_read )( void *obj, uint8_t *buffer, size_t size );
+extern void ( *hal_sim_spi_select )( pin_name_t cs, uint8_t selected );
+
+/**
+ * @brief One Wire hooks, reset returns the presence result of the bus.
+ */
+extern err_t ( *hal_sim_one_wire_reset )( void *obj );
+extern err_t ( *hal_sim_one_wire_write )( void *obj, uint8_t *buffer, size_t size );
+extern err_t ( *hal_sim_one_wire_read )( void *obj, uint8_t *buffer, size_t size );
+
+/**
+ * @brief Analog input hook, one call per conversion of the pin object.
+ */
+extern err_t ( *hal_sim_analog_read )( void *obj, uint16_t *value );
+
+/**
+ * @brief GPIO hooks, called with the pin object on every output change and input read.
+ */
+extern void ( *hal_sim_gpio_write )( void *obj, pin_name_t pin, uint8_t state );
+extern uint8_t ( *hal_sim_gpio_read )( void *obj, pin_name_t pin );
+
+/**
+ * @brief Restores the default hooks and clears the simulated clock.
+ */
+void hal_sim_reset ( void );
+
+#endif // HAL_SIM_H
@@ -0,0 +1,7 @@
+/*
+ * Host build shim, no MCU specific definitions are needed on the host.
+ */
+#ifndef MCU_DEFINITIONS_H
+#define MCU_DEFINITIONS_H
+
+#endif // MCU_DEFINITIONS_H
@@ -0,0 +1,1006 @@
+/*
+ * IMU and accelerometer sample reads: bus transactions per sample.
+ *
+ * The sample readers of the accel, 6DOF IMU, gyro and 9DOF clicks run
+ * against one register file model. Each I2C address is its own page of
+ * registers and SPI parts share one more. A read continues from the
+ * register pointer set by the last address byte and advances after every
+ * byte, except on parts that only auto increment when a bit of the
+ * address byte asks for it. Like a running sensor, the model replaces
+ * the output registers with a new sample at the start of every bus
+ * transaction, so values taken with more than one data read come from
+ * different samples.
+ *
+ * Every reader must take the expected number of transactions, one I2C
+ * transfer or one SPI chip select frame, and return exactly the values
+ * in the output registers after its last transaction. The per-axis
+ * readers of 6DOF IMU 15 run the same way as a control and must come
+ * out torn.
+ */
+#include "c6dofimu.h"
+#include "c6dofimu2.h"
+#include "c6dofimu5.h"
+#include "c6dofimu6.h"
+#include "c6dofimu7.h"
+#include "c6dofimu9.h"
+#include "c6dofimu10.h"
+#include "c6dofimu11.h"
+#include "c6dofimu13.h"
+#include "c6dofimu14.h"
+#include "c6dofimu15.h"
+#include "c6dofimu20.h"
+#include "c6dofimu25.h"
+#include "c9dof.h"
+#include "c9dof2.h"
+#include "accel.h"
+#include "accel2.h"
+#include "accel3.h"
+#include "accel4.h"
+#include "accel8.h"
+#include "accel12.h"
+#include "accel13.h"
+#include "accel28.h"
+#include "accelpressure.h"
+#include "gyro.h"
+#include "gyro9.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLES             200
+#define MAX_VALUES          7
+#define SPI_PAGE            128
+
+// Output register pair of one value, with the width of its two's complement field
+typedef struct
+{
+    uint8_t page;
+    uint8_t lsb;
+    uint8_t msb;
+    uint8_t bits;
+} out_reg_t;
+
+#define LE( page, reg )         { page, ( reg ), ( reg ) + 1, 16 }
+#define BE( page, reg )         { page, ( reg ) + 1, ( reg ), 16 }
+#define LE_BITS( page, reg, n ) { page, ( reg ), ( reg ) + 1, n }
+
+typedef struct
+{
+    const char *name;
+    void ( *setup )( void );
+    void ( *read )( int32_t *values );
+    uint8_t transactions;
+    uint8_t torn;           // Control reader, expected to mix samples
+    uint8_t inc_page;       // Page whose address byte carries an auto increment bit
+    uint8_t inc_bit;
+    uint8_t word_regs;      // 16-bit registers, an I2C read starts with two dummy bytes
+    uint8_t num_values;
+    out_reg_t values[ MAX_VALUES ];
+    uint8_t fixed_page;     // Status or configuration register the reader checks first
+    uint8_t fixed_reg;
+    uint8_t fixed_value;
+} part_t;
+
+static int failures;
+static uint8_t regs[ SPI_PAGE + 1 ][ 256 ];
+static const part_t *part;
+static uint32_t transactions;
+static uint32_t bus_bytes;
+static uint8_t page;
+static uint16_t ptr;
+static uint8_t auto_inc;
+static uint8_t spi_frame_pos;
+static uint8_t spi_reading;
+
+static c6dofimu_t c6dofimu;
+static c6dofimu2_t c6dofimu2;
+static c6dofimu5_t c6dofimu5;
+static c6dofimu6_t c6dofimu6;
+static c6dofimu7_t c6dofimu7;
+static c6dofimu9_t c6dofimu9;
+static c6dofimu10_t c6dofimu10;
+static c6dofimu11_t c6dofimu11;
+static c6dofimu13_t c6dofimu13;
+static c6dofimu14_t c6dofimu14;
+static c6dofimu15_t c6dofimu15;
+static c6dofimu20_t c6dofimu20;
+static c6dofimu25_t c6dofimu25;
+static c9dof_t c9dof;
+static c9dof2_t c9dof2;
+static accel_t accel;
+static accel2_t accel2;
+static accel3_t accel3;
+static accel4_t accel4;
+static accel8_t accel8;
+static accel12_t accel12;
+static accel13_t accel13;
+static accel28_t accel28;
+static accelpressure_t accelpressure;
+static gyro_t gyro;
+static gyro9_t gyro9;
+
+// --------------------------------------------------------------------- DEVICE
+
+static void new_sample ( void )
+{
+    for ( uint8_t cnt = 0; cnt < part->num_values; cnt++ )
+    {
+        const out_reg_t *out = &part->values[ cnt ];
+        regs[ out->page ][ out->lsb ] = ( uint8_t ) rand( );
+        regs[ out->page ][ out->msb ] = ( uint8_t ) rand( );
+    }
+}
+
+static void set_pointer ( uint8_t dev_page, uint8_t address )
+{
+    page = dev_page;
+    auto_inc = 1;
+    if ( part->inc_bit && ( dev_page == part->inc_page ) )
+    {
+        auto_inc = ( 0 != ( address & part->inc_bit ) );
+        address &= ~part->inc_bit;
+    }
+    ptr = part->word_regs ? ( uint16_t ) address * 2 : address;
+}
+
+static uint8_t next_byte ( void )
+{
+    uint8_t value = regs[ page ][ ptr & 0xFF ];
+    if ( auto_inc )
+    {
+        ptr++;
+    }
+    return value;
+}
+
+static err_t imu_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                            uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    transactions++;
+    new_sample( );
+    if ( write_len )
+    {
+        set_pointer( address & 0x7F, write_buf[ 0 ] );
+        for ( size_t cnt = 1; cnt < write_len; cnt++ )
+        {
+            regs[ page ][ ptr & 0xFF ] = write_buf[ cnt ];
+            ptr++;
+        }
+        bus_bytes += 1 + write_len;
+    }
+    if ( read_len )
+    {
+        for ( size_t cnt = 0; cnt < read_len; cnt++ )
+        {
+            read_buf[ cnt ] = ( part->word_regs && ( cnt < 2 ) ) ? 0 : next_byte( );
+        }
+        bus_bytes += 1 + read_len;
+    }
+    return I2C_MASTER_SUCCESS;
+}
+
+static void imu_select ( pin_name_t cs, uint8_t selected )
+{
+    ( void ) cs;
+    if ( selected )
+    {
+        transactions++;
+        new_sample( );
+        spi_frame_pos = 0;
+    }
+}
+
+static err_t imu_spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    for ( size_t cnt = 0; cnt < size; cnt++, spi_frame_pos++ )
+    {
+        if ( 0 == spi_frame_pos )
+        {
+            spi_reading = ( 0 != ( buffer[ cnt ] & 0x80 ) );
+            set_pointer( SPI_PAGE, buffer[ cnt ] & 0x7F );
+        }
+        else if ( !spi_reading )
+        {
+            regs[ page ][ ptr & 0xFF ] = buffer[ cnt ];
+            ptr++;
+        }
+    }
+    bus_bytes += size;
+    return SPI_MASTER_SUCCESS;
+}
+
+static err_t imu_spi_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    for ( size_t cnt = 0; cnt < size; cnt++, spi_frame_pos++ )
+    {
+        buffer[ cnt ] = next_byte( );
+    }
+    bus_bytes += size;
+    return SPI_MASTER_SUCCESS;
+}
+
+// ----------------------------------------------------------------------- HOST
+
+static void setup_c6dofimu ( void )
+{
+    c6dofimu_cfg_t cfg;
+    c6dofimu_cfg_setup( &cfg );
+    cfg.sel = C6DOFIMU_MASTER_I2C;
+    c6dofimu_init( &c6dofimu, &cfg );
+}
+
+static void read_c6dofimu ( int32_t *values )
+{
+    c6dofimu_read_axis_data( &c6dofimu, C6DOFIMU_ALL_READ_MODE );
+    values[ 0 ] = c6dofimu.gyro_axis.x;
+    values[ 1 ] = c6dofimu.gyro_axis.y;
+    values[ 2 ] = c6dofimu.gyro_axis.z;
+    values[ 3 ] = c6dofimu.accel_axis.x;
+    values[ 4 ] = c6dofimu.accel_axis.y;
+    values[ 5 ] = c6dofimu.accel_axis.z;
+}
+
+static void setup_c6dofimu2 ( void )
+{
+    c6dofimu2_cfg_t cfg;
+    c6dofimu2_cfg_setup( &cfg );
+    cfg.sel = C6DOFIMU2_MASTER_I2C;
+    c6dofimu2_init( &c6dofimu2, &cfg );
+}
+
+static void read_c6dofimu2 ( int32_t *values )
+{
+    c6dofimu2_gyro_data_t gyro_data;
+    c6dofimu2_accel_data_t accel_data;
+    c6dofimu2_read_data( &c6dofimu2, &gyro_data, &accel_data );
+    values[ 0 ] = gyro_data.gyro_x;
+    values[ 1 ] = gyro_data.gyro_y;
+    values[ 2 ] = gyro_data.gyro_z;
+    values[ 3 ] = accel_data.accel_x;
+    values[ 4 ] = accel_data.accel_y;
+    values[ 5 ] = accel_data.accel_z;
+}
+
+static void setup_c6dofimu5 ( void )
+{
+    c6dofimu5_cfg_t cfg;
+    c6dofimu5_cfg_setup( &cfg );
+    c6dofimu5_init( &c6dofimu5, &cfg );
+}
+
+static void read_c6dofimu5 ( int32_t *values )
+{
+    c6dofimu5_data_t data;
+    c6dofimu5_read_data( &c6dofimu5, &data );
+    values[ 0 ] = data.accel_x;
+    values[ 1 ] = data.accel_y;
+    values[ 2 ] = data.accel_z;
+    values[ 3 ] = data.temp_out;
+    values[ 4 ] = data.gyro_x;
+    values[ 5 ] = data.gyro_y;
+    values[ 6 ] = data.gyro_z;
+}
+
+static void setup_c6dofimu6 ( void )
+{
+    c6dofimu6_cfg_t cfg;
+    c6dofimu6_cfg_setup( &cfg );
+    cfg.sel = C6DOFIMU6_MASTER_I2C;
+    c6dofimu6_init( &c6dofimu6, &cfg );
+}
+
+static void read_c6dofimu6 ( int32_t *values )
+{
+    c6dofimu6_data_t data;
+    c6dofimu6_read_data( &c6dofimu6, &data );
+    values[ 0 ] = data.accel_x;
+    values[ 1 ] = data.accel_y;
+    values[ 2 ] = data.accel_z;
+    values[ 3 ] = data.temp_out;
+    values[ 4 ] = data.gyro_x;
+    values[ 5 ] = data.gyro_y;
+    values[ 6 ] = data.gyro_z;
+}
+
+static void setup_c6dofimu7 ( void )
+{
+    c6dofimu7_cfg_t cfg;
+    c6dofimu7_cfg_setup( &cfg );
+    c6dofimu7_init( &c6dofimu7, &cfg );
+}
+
+static void read_c6dofimu7 ( int32_t *values )
+{
+    c6dofimu7_axis_t accel;
+    c6dofimu7_axis_t gyro;
+    c6dofimu7_get_data( &c6dofimu7, &accel, 1.0, &gyro, 1.0 );
+    values[ 0 ] = ( int32_t ) accel.x_axis;
+    values[ 1 ] = ( int32_t ) accel.y_axis;
+    values[ 2 ] = ( int32_t ) accel.z_axis;
+    values[ 3 ] = ( int32_t ) gyro.x_axis;
+    values[ 4 ] = ( int32_t ) gyro.y_axis;
+    values[ 5 ] = ( int32_t ) gyro.z_axis;
+}
+
+static void setup_c6dofimu9 ( void )
+{
+    c6dofimu9_cfg_t cfg;
+    c6dofimu9_cfg_setup( &cfg );
+    cfg.sel = C6DOFIMU9_MASTER_I2C;
+    c6dofimu9_init( &c6dofimu9, &cfg );
+}
+
+static void read_c6dofimu9 ( int32_t *values )
+{
+    c6dofimu9_data_t data;
+    c6dofimu9_get_data( &c6dofimu9, &data );
+    values[ 0 ] = data.accel_x;
+    values[ 1 ] = data.accel_y;
+    values[ 2 ] = data.accel_z;
+    values[ 3 ] = data.temp_out;
+    values[ 4 ] = data.gyro_x;
+    values[ 5 ] = data.gyro_y;
+    values[ 6 ] = data.gyro_z;
+}
+
+static void setup_c6dofimu10 ( void )
+{
+    c6dofimu10_cfg_t cfg;
+    c6dofimu10_cfg_setup( &cfg );
+    c6dofimu10_init( &c6dofimu10, &cfg );
+}
+
+static void read_c6dofimu10 ( int32_t *values )
+{
+    c6dofimu10_axis_t accel_axis;
+    c6dofimu10_axis_t mag_axis;
+    c6dofimu10_get_axis_data( &c6dofimu10, &accel_axis, &mag_axis );
+    values[ 0 ] = accel_axis.x;
+    values[ 1 ] = accel_axis.y;
+    values[ 2 ] = accel_axis.z;
+    values[ 3 ] = mag_axis.x;
+    values[ 4 ] = mag_axis.y;
+    values[ 5 ] = mag_axis.z;
+}
+
+static void setup_c6dofimu11 ( void )
+{
+    c6dofimu11_cfg_t cfg;
+    c6dofimu11_cfg_setup( &cfg );
+    c6dofimu11_init( &c6dofimu11, &cfg );
+}
+
+static void read_c6dofimu11_accel ( int32_t *values )
+{
+    int16_t x, y, z;
+    c6dofimu11_get_accel_data( &c6dofimu11, &x, &y, &z );
+    values[ 0 ] = x;
+    values[ 1 ] = y;
+    values[ 2 ] = z;
+}
+
+static void read_c6dofimu11_mag ( int32_t *values )
+{
+    int16_t x, y, z;
+    c6dofimu11_get_mag_data( &c6dofimu11, &x, &y, &z );
+    values[ 0 ] = x;
+    values[ 1 ] = y;
+    values[ 2 ] = z;
+}
+
+static void setup_c6dofimu13 ( void )
+{
+    c6dofimu13_cfg_t cfg;
+    c6dofimu13_cfg_setup( &cfg );
+    c6dofimu13_init( &c6dofimu13, &cfg );
+    c6dofimu13.calc_coef = 1.0;
+}
+
+static void read_c6dofimu13_accel ( int32_t *values )
+{
+    float x, y, z;
+    c6dofimu13_accel_get_data( &c6dofimu13, &x, &y, &z );
+    values[ 0 ] = ( int32_t ) x;
+    values[ 1 ] = ( int32_t ) y;
+    values[ 2 ] = ( int32_t ) z;
+}
+
+static void read_c6dofimu13_mag ( int32_t *values )
+{
+    float x, y, z;
+    c6dofimu13_mag_get_data( &c6dofimu13, &x, &y, &z );
+    values[ 0 ] = ( int32_t ) lroundf( x / C6DOFIMU13_MAG_SENS );
+    values[ 1 ] = ( int32_t ) lroundf( y / C6DOFIMU13_MAG_SENS );
+    values[ 2 ] = ( int32_t ) lroundf( z / C6DOFIMU13_MAG_SENS );
+}
+
+static void setup_c6dofimu14 ( void )
+{
+    c6dofimu14_cfg_t cfg;
+    c6dofimu14_cfg_setup( &cfg );
+    cfg.drv_sel = C6DOFIMU14_DRV_SEL_I2C;
+    c6dofimu14_init( &c6dofimu14, &cfg );
+}
+
+static void read_c6dofimu14 ( int32_t *values )
+{
+    float temp;
+    c6dofimu14_axis_t acc_axis;
+    c6dofimu14_axis_t gyro_axis;
+    c6dofimu14_get_sensor_data( &c6dofimu14, &temp, &acc_axis, &gyro_axis );
+    values[ 0 ] = ( int32_t ) lround( ( temp - 25.0 ) * 132.48 );
+    values[ 1 ] = acc_axis.x;
+    values[ 2 ] = acc_axis.y;
+    values[ 3 ] = acc_axis.z;
+    values[ 4 ] = gyro_axis.x;
+    values[ 5 ] = gyro_axis.y;
+    values[ 6 ] = gyro_axis.z;
+}
+
+static void setup_c6dofimu15 ( void )
+{
+    c6dofimu15_cfg_t cfg;
+    c6dofimu15_cfg_setup( &cfg );
+    c6dofimu15_init( &c6dofimu15, &cfg );
+}
+
+static void read_c6dofimu15 ( int32_t *values )
+{
+    c6dofimu15_data_t data;
+    c6dofimu15_read_data( &c6dofimu15, &data );
+    values[ 0 ] = data.temp_out;
+    values[ 1 ] = data.gyro_x;
+    values[ 2 ] = data.gyro_y;
+    values[ 3 ] = data.gyro_z;
+    values[ 4 ] = data.accel_x;
+    values[ 5 ] = data.accel_y;
+    values[ 6 ] = data.accel_z;
+}
+
+// The per-axis readers the all-axes helpers used to call in sequence
+static void read_c6dofimu15_per_axis ( int32_t *values )
+{
+    values[ 0 ] = c6dofimu15_read_gyro_x( &c6dofimu15 );
+    values[ 1 ] = c6dofimu15_read_gyro_y( &c6dofimu15 );
+    values[ 2 ] = c6dofimu15_read_gyro_z( &c6dofimu15 );
+    values[ 3 ] = c6dofimu15_read_accel_x( &c6dofimu15 );
+    values[ 4 ] = c6dofimu15_read_accel_y( &c6dofimu15 );
+    values[ 5 ] = c6dofimu15_read_accel_z( &c6dofimu15 );
+}
+
+static void setup_c6dofimu20 ( void )
+{
+    c6dofimu20_cfg_t cfg;
+    c6dofimu20_cfg_setup( &cfg );
+    c6dofimu20_init( &c6dofimu20, &cfg );
+}
+
+static void read_c6dofimu20 ( int32_t *values )
+{
+    c6dofimu20_data_t acc_data;
+    c6dofimu20_data_t gyr_data;
+    c6dofimu20_get_data( &c6dofimu20, &acc_data, &gyr_data );
+    values[ 0 ] = acc_data.data_x;
+    values[ 1 ] = acc_data.data_y;
+    values[ 2 ] = acc_data.data_z;
+    values[ 3 ] = gyr_data.data_x;
+    values[ 4 ] = gyr_data.data_y;
+    values[ 5 ] = gyr_data.data_z;
+}
+
+static void setup_c6dofimu25 ( void )
+{
+    c6dofimu25_cfg_t cfg;
+    c6dofimu25_cfg_setup( &cfg );
+    cfg.drv_sel = C6DOFIMU25_DRV_SEL_I2C;
+    c6dofimu25_init( &c6dofimu25, &cfg );
+    c6dofimu25.gyro_sens = 1.0;
+    c6dofimu25.accel_sens = 1.0;
+}
+
+static void read_c6dofimu25 ( int32_t *values )
+{
+    c6dofimu25_data_t data;
+    c6dofimu25_get_data( &c6dofimu25, &data );
+    values[ 0 ] = ( int32_t ) lround( ( data.temperature - C6DOFIMU25_TEMP_OFFSET ) *
+                                      C6DOFIMU25_TEMP_SENS_LSB_PER_C );
+    values[ 1 ] = ( int32_t ) data.gyro.x;
+    values[ 2 ] = ( int32_t ) data.gyro.y;
+    values[ 3 ] = ( int32_t ) data.gyro.z;
+    values[ 4 ] = ( int32_t ) data.accel.x;
+    values[ 5 ] = ( int32_t ) data.accel.y;
+    values[ 6 ] = ( int32_t ) data.accel.z;
+}
+
+static void setup_c9dof ( void )
+{
+    c9dof_cfg_t cfg;
+    c9dof_cfg_setup( &cfg );
+    c9dof_init( &c9dof, &cfg );
+}
+
+static void read_c9dof_accel ( int32_t *values )
+{
+    c9dof_accel_data_t data;
+    c9dof_read_accel( &c9dof, &data );
+    values[ 0 ] = data.x;
+    values[ 1 ] = data.y;
+    values[ 2 ] = data.z;
+}
+
+static void read_c9dof_gyro ( int32_t *values )
+{
+    c9dof_gyro_data_t data;
+    c9dof_read_gyro( &c9dof, &data );
+    values[ 0 ] = data.x;
+    values[ 1 ] = data.y;
+    values[ 2 ] = data.z;
+}
+
+static void read_c9dof_mag ( int32_t *values )
+{
+    c9dof_mag_data_t data;
+    c9dof_read_mag( &c9dof, &data );
+    values[ 0 ] = data.x;
+    values[ 1 ] = data.y;
+    values[ 2 ] = data.z;
+}
+
+static void setup_c9dof2 ( void )
+{
+    c9dof2_cfg_t cfg;
+    c9dof2_cfg_setup( &cfg );
+    c9dof2_init( &c9dof2, &cfg );
+}
+
+static void read_c9dof2 ( int32_t *values )
+{
+    c9dof2_data_t data;
+    c9dof2_read_all_data( &c9dof2, &data );
+    values[ 0 ] = data.accel_x;
+    values[ 1 ] = data.accel_y;
+    values[ 2 ] = data.accel_z;
+    values[ 3 ] = data.gyro_x;
+    values[ 4 ] = data.gyro_y;
+    values[ 5 ] = data.gyro_z;
+    values[ 6 ] = data.temp_out;
+}
+
+static void setup_accel_i2c ( void )
+{
+    accel_cfg_t cfg;
+    accel_cfg_setup( &cfg );
+    accel_init( &accel, &cfg );
+}
+
+static void setup_accel_spi ( void )
+{
+    accel_cfg_t cfg;
+    accel_cfg_setup( &cfg );
+    cfg.sel = ACCEL_MASTER_SPI;
+    accel_init( &accel, &cfg );
+}
+
+static void read_accel ( int32_t *values )
+{
+    accel_axes_t axes;
+    accel_read_axes( &accel, &axes );
+    values[ 0 ] = axes.x;
+    values[ 1 ] = axes.y;
+    values[ 2 ] = axes.z;
+}
+
+static void setup_accel2_i2c ( void )
+{
+    accel2_cfg_t cfg;
+    accel2_cfg_setup( &cfg );
+    accel2_init( &accel2, &cfg );
+}
+
+static void setup_accel2_spi ( void )
+{
+    accel2_cfg_t cfg;
+    accel2_cfg_setup( &cfg );
+    cfg.sel = ACCEL2_MASTER_SPI;
+    accel2_init( &accel2, &cfg );
+}
+
+static void read_accel2 ( int32_t *values )
+{
+    accel2_axes_t axes;
+    accel2_read_axes( &accel2, &axes );
+    values[ 0 ] = axes.x;
+    values[ 1 ] = axes.y;
+    values[ 2 ] = axes.z;
+}
+
+static void setup_accel3_i2c ( void )
+{
+    accel3_cfg_t cfg;
+    accel3_cfg_setup( &cfg );
+    accel3_init( &accel3, &cfg );
+}
+
+static void setup_accel3_spi ( void )
+{
+    accel3_cfg_t cfg;
+    accel3_cfg_setup( &cfg );
+    cfg.sel = ACCEL3_MASTER_SPI;
+    accel3_init( &accel3, &cfg );
+}
+
+static void read_accel3 ( int32_t *values )
+{
+    accel3_data_t data;
+    accel3_read_data( &accel3, &data );
+    values[ 0 ] = data.x;
+    values[ 1 ] = data.y;
+    values[ 2 ] = data.z;
+}
+
+static void setup_accel4 ( void )
+{
+    accel4_cfg_t cfg;
+    accel4_cfg_setup( &cfg );
+    accel4_init( &accel4, &cfg );
+}
+
+static void read_accel4 ( int32_t *values )
+{
+    accel4_axes_t axes;
+    accel4_get_axes_data( &accel4, &axes );
+    values[ 0 ] = ( int32_t ) lroundf( axes.x / accel4.resolution );
+    values[ 1 ] = ( int32_t ) lroundf( axes.y / accel4.resolution );
+    values[ 2 ] = ( int32_t ) lroundf( axes.z / accel4.resolution );
+}
+
+static void setup_accel8 ( void )
+{
+    accel8_cfg_t cfg;
+    accel8_cfg_setup( &cfg );
+    accel8_init( &accel8, &cfg );
+}
+
+static void read_accel8 ( int32_t *values )
+{
+    accel8_data_t data;
+    accel8_get_data( &accel8, &data );
+    values[ 0 ] = data.accel_x;
+    values[ 1 ] = data.accel_y;
+    values[ 2 ] = data.accel_z;
+    values[ 3 ] = data.temp_out;
+    values[ 4 ] = data.gyro_x;
+    values[ 5 ] = data.gyro_y;
+    values[ 6 ] = data.gyro_z;
+}
+
+static void setup_accel12 ( void )
+{
+    accel12_cfg_t cfg;
+    accel12_cfg_setup( &cfg );
+    accel12_init( &accel12, &cfg );
+}
+
+static void read_accel12 ( int32_t *values )
+{
+    int16_t x, y, z;
+    accel12_get_axis_data( &accel12, &x, &y, &z );
+    values[ 0 ] = x;
+    values[ 1 ] = y;
+    values[ 2 ] = z;
+}
+
+static void setup_accel13 ( void )
+{
+    accel13_cfg_t cfg;
+    accel13_cfg_setup( &cfg );
+    accel13_init( &accel13, &cfg );
+}
+
+static void read_accel13 ( int32_t *values )
+{
+    accel13_axis_t axis;
+    accel13_get_axis_data( &accel13, &axis );
+    values[ 0 ] = axis.x;
+    values[ 1 ] = axis.y;
+    values[ 2 ] = axis.z;
+}
+
+static void setup_accel28 ( void )
+{
+    accel28_cfg_t cfg;
+    accel28_cfg_setup( &cfg );
+    accel28_init( &accel28, &cfg );
+}
+
+static void read_accel28 ( int32_t *values )
+{
+    accel28_data_t data;
+    accel28_get_raw_data( &accel28, &data );
+    values[ 0 ] = ( int32_t ) data.x_data;
+    values[ 1 ] = ( int32_t ) data.y_data;
+    values[ 2 ] = ( int32_t ) data.z_data;
+}
+
+static void setup_accelpressure ( void )
+{
+    accelpressure_cfg_t cfg;
+    accelpressure_cfg_setup( &cfg );
+    accelpressure_init( &accelpressure, &cfg );
+    accelpressure.sensitivity = 1.0;
+}
+
+static void read_accelpressure ( int32_t *values )
+{
+    accelpressure_axes_t axes;
+    accelpressure_get_axes_data( &accelpressure, &axes );
+    values[ 0 ] = ( int32_t ) axes.x;
+    values[ 1 ] = ( int32_t ) axes.y;
+    values[ 2 ] = ( int32_t ) axes.z;
+}
+
+static void setup_gyro ( void )
+{
+    gyro_cfg_t cfg;
+    gyro_cfg_setup( &cfg );
+    gyro_init( &gyro, &cfg );
+}
+
+static void read_gyro ( int32_t *values )
+{
+    int16_t x, y, z;
+    gyro_read_gyro( &gyro, &x, &y, &z );
+    values[ 0 ] = x;
+    values[ 1 ] = y;
+    values[ 2 ] = z;
+}
+
+static void setup_gyro9_i2c ( void )
+{
+    gyro9_cfg_t cfg;
+    gyro9_cfg_setup( &cfg );
+    cfg.drv_sel = GYRO9_DRV_SEL_I2C;
+    gyro9_init( &gyro9, &cfg );
+}
+
+static void setup_gyro9_spi ( void )
+{
+    gyro9_cfg_t cfg;
+    gyro9_cfg_setup( &cfg );
+    cfg.drv_sel = GYRO9_DRV_SEL_SPI;
+    gyro9_init( &gyro9, &cfg );
+}
+
+static void read_gyro9 ( int32_t *values )
+{
+    gyro9_axis_data_t axis;
+    gyro9_get_axis_data( &gyro9, &axis );
+    values[ 0 ] = axis.x;
+    values[ 1 ] = axis.y;
+    values[ 2 ] = axis.z;
+}
+
+// C6DOFIMU_SLAVE_ADDRESS carries a semicolon, it only works as a statement
+#define C6DOFIMU_ADR        0x6B
+#define C6DOFIMU2_ADR       C6DOFIMU2_I2C_ADDR
+#define C6DOFIMU6_ADR       C6DOFIMU6_I2C_SLAVE_ADR_GND
+#define C6DOFIMU14_ADR      C6DOFIMU14_SET_DEV_ADDR_GND
+#define C6DOFIMU25_ADR      C6DOFIMU25_DEVICE_ADDRESS_0
+#define C9DOF_AG_ADR        C9DOF_SLAVE_ADDRESS_ACCEL_GYRO_0
+#define C9DOF_M_ADR         C9DOF_SLAVE_ADDRESS_MAG_0
+
+static const part_t parts[ ] =
+{
+    { "c6dofimu_read_axis_data", setup_c6dofimu, read_c6dofimu, 1, 0, 0, 0, 0, 6,
+      { LE( C6DOFIMU_ADR, 0x22 ), LE( C6DOFIMU_ADR, 0x24 ), LE( C6DOFIMU_ADR, 0x26 ),
+        LE( C6DOFIMU_ADR, 0x28 ), LE( C6DOFIMU_ADR, 0x2A ), LE( C6DOFIMU_ADR, 0x2C ) } },
+    { "c6dofimu2_read_data", setup_c6dofimu2, read_c6dofimu2, 1, 0, 0, 0, 0, 6,
+      { LE( C6DOFIMU2_ADR, 0x0C ), LE( C6DOFIMU2_ADR, 0x0E ), LE( C6DOFIMU2_ADR, 0x10 ),
+        LE( C6DOFIMU2_ADR, 0x12 ), LE( C6DOFIMU2_ADR, 0x14 ), LE( C6DOFIMU2_ADR, 0x16 ) } },
+    { "c6dofimu5_read_data", setup_c6dofimu5, read_c6dofimu5, 1, 0, 0, 0, 0, 7,
+      { BE( SPI_PAGE, 0x3B ), BE( SPI_PAGE, 0x3D ), BE( SPI_PAGE, 0x3F ), BE( SPI_PAGE, 0x41 ),
+        BE( SPI_PAGE, 0x43 ), BE( SPI_PAGE, 0x45 ), BE( SPI_PAGE, 0x47 ) } },
+    { "c6dofimu6_read_data", setup_c6dofimu6, read_c6dofimu6, 1, 0, 0, 0, 0, 7,
+      { BE( C6DOFIMU6_ADR, 0x3B ), BE( C6DOFIMU6_ADR, 0x3D ), BE( C6DOFIMU6_ADR, 0x3F ),
+        BE( C6DOFIMU6_ADR, 0x41 ), BE( C6DOFIMU6_ADR, 0x43 ), BE( C6DOFIMU6_ADR, 0x45 ),
+        BE( C6DOFIMU6_ADR, 0x47 ) } },
+    { "c6dofimu7_get_data", setup_c6dofimu7, read_c6dofimu7, 1, 0, 0, 0, 0, 6,
+      { BE( C6DOFIMU7_SLAVE_ADDRESS, 0x2D ), BE( C6DOFIMU7_SLAVE_ADDRESS, 0x2F ),
+        BE( C6DOFIMU7_SLAVE_ADDRESS, 0x31 ), BE( C6DOFIMU7_SLAVE_ADDRESS, 0x33 ),
+        BE( C6DOFIMU7_SLAVE_ADDRESS, 0x35 ), BE( C6DOFIMU7_SLAVE_ADDRESS, 0x37 ) } },
+    { "c6dofimu9_get_data", setup_c6dofimu9, read_c6dofimu9, 1, 0, 0, 0, 0, 7,
+      { BE( C6DOFIMU9_I2C_SLAVE_ADDRESS_1, 0x3B ), BE( C6DOFIMU9_I2C_SLAVE_ADDRESS_1, 0x3D ),
+        BE( C6DOFIMU9_I2C_SLAVE_ADDRESS_1, 0x3F ), BE( C6DOFIMU9_I2C_SLAVE_ADDRESS_1, 0x41 ),
+        BE( C6DOFIMU9_I2C_SLAVE_ADDRESS_1, 0x43 ), BE( C6DOFIMU9_I2C_SLAVE_ADDRESS_1, 0x45 ),
+        BE( C6DOFIMU9_I2C_SLAVE_ADDRESS_1, 0x47 ) } },
+    { "c6dofimu10_get_axis_data", setup_c6dofimu10, read_c6dofimu10, 1, 0, 0, 0, 0, 6,
+      { LE( C6DOFIMU10_SLAVE_ADDRESS_GND, 0x0A ), LE( C6DOFIMU10_SLAVE_ADDRESS_GND, 0x0C ),
+        LE( C6DOFIMU10_SLAVE_ADDRESS_GND, 0x0E ), LE( C6DOFIMU10_SLAVE_ADDRESS_GND, 0x10 ),
+        LE( C6DOFIMU10_SLAVE_ADDRESS_GND, 0x12 ), LE( C6DOFIMU10_SLAVE_ADDRESS_GND, 0x14 ) } },
+    { "c6dofimu11_get_accel_data", setup_c6dofimu11, read_c6dofimu11_accel, 1, 0, 0, 0, 0, 3,
+      { LE( C6DOFIMU11_I2C_SLAVE_ADDRESS_GND, 0x0A ), LE( C6DOFIMU11_I2C_SLAVE_ADDRESS_GND, 0x0C ),
+        LE( C6DOFIMU11_I2C_SLAVE_ADDRESS_GND, 0x0E ) } },
+    { "c6dofimu11_get_mag_data", setup_c6dofimu11, read_c6dofimu11_mag, 1, 0, 0, 0, 0, 3,
+      { LE( C6DOFIMU11_I2C_SLAVE_ADDRESS_GND, 0x10 ), LE( C6DOFIMU11_I2C_SLAVE_ADDRESS_GND, 0x12 ),
+        LE( C6DOFIMU11_I2C_SLAVE_ADDRESS_GND, 0x14 ) } },
+    // 14-bit accel and 15-bit magnetometer fields, each behind one read of the range configuration
+    { "c6dofimu13_accel_get_data", setup_c6dofimu13, read_c6dofimu13_accel, 2, 0, 0, 0, 0, 3,
+      { LE_BITS( C6DOFIMU13_DEV_ADDRESS_ACCEL_GND, 0x0D, 14 ),
+        LE_BITS( C6DOFIMU13_DEV_ADDRESS_ACCEL_GND, 0x0F, 14 ),
+        LE_BITS( C6DOFIMU13_DEV_ADDRESS_ACCEL_GND, 0x11, 14 ) },
+      C6DOFIMU13_DEV_ADDRESS_ACCEL_GND, C6DOFIMU13_ACCEL_OUTCFG, C6DOFIMU13_ACCEL_OUTCFG_RES_14 },
+    { "c6dofimu13_mag_get_data", setup_c6dofimu13, read_c6dofimu13_mag, 2, 0, 0, 0, 0, 3,
+      { LE_BITS( C6DOFIMU13_DEV_ADDRESS_MAG, 0x10, 15 ), LE_BITS( C6DOFIMU13_DEV_ADDRESS_MAG, 0x12, 15 ),
+        LE_BITS( C6DOFIMU13_DEV_ADDRESS_MAG, 0x14, 15 ) },
+      C6DOFIMU13_DEV_ADDRESS_MAG, C6DOFIMU13_MAG_CTL_4, C6DOFIMU13_MAG_CTL_4_RS_S_15 },
+    // Data ready status first, then temperature, accel and gyro
+    { "c6dofimu14_get_sensor_data", setup_c6dofimu14, read_c6dofimu14, 2, 0, 0, 0, 0, 7,
+      { BE( C6DOFIMU14_ADR, 0x1D ), BE( C6DOFIMU14_ADR, 0x1F ), BE( C6DOFIMU14_ADR, 0x21 ),
+        BE( C6DOFIMU14_ADR, 0x23 ), BE( C6DOFIMU14_ADR, 0x25 ), BE( C6DOFIMU14_ADR, 0x27 ),
+        BE( C6DOFIMU14_ADR, 0x29 ) },
+      C6DOFIMU14_ADR, C6DOFIMU14_REG0_INT_STATUS_1, 0x08 },
+    { "c6dofimu15_read_data", setup_c6dofimu15, read_c6dofimu15, 1, 0, 0, 0, 0, 7,
+      { LE( C6DOFIMU15_I2C_ADR_GND, 0x20 ), LE( C6DOFIMU15_I2C_ADR_GND, 0x22 ),
+        LE( C6DOFIMU15_I2C_ADR_GND, 0x24 ), LE( C6DOFIMU15_I2C_ADR_GND, 0x26 ),
+        LE( C6DOFIMU15_I2C_ADR_GND, 0x28 ), LE( C6DOFIMU15_I2C_ADR_GND, 0x2A ),
+        LE( C6DOFIMU15_I2C_ADR_GND, 0x2C ) } },
+    { "c6dofimu15 per-axis readers", setup_c6dofimu15, read_c6dofimu15_per_axis, 6, 1, 0, 0, 0, 6,
+      { LE( C6DOFIMU15_I2C_ADR_GND, 0x22 ), LE( C6DOFIMU15_I2C_ADR_GND, 0x24 ),
+        LE( C6DOFIMU15_I2C_ADR_GND, 0x26 ), LE( C6DOFIMU15_I2C_ADR_GND, 0x28 ),
+        LE( C6DOFIMU15_I2C_ADR_GND, 0x2A ), LE( C6DOFIMU15_I2C_ADR_GND, 0x2C ) } },
+    // 16-bit registers, the register pointer write and the read are separate transfers
+    { "c6dofimu20_get_data", setup_c6dofimu20, read_c6dofimu20, 2, 0, 0, 0, 1, 6,
+      { LE( C6DOFIMU20_DEVICE_ADDRESS_GND, 0x06 ), LE( C6DOFIMU20_DEVICE_ADDRESS_GND, 0x08 ),
+        LE( C6DOFIMU20_DEVICE_ADDRESS_GND, 0x0A ), LE( C6DOFIMU20_DEVICE_ADDRESS_GND, 0x0C ),
+        LE( C6DOFIMU20_DEVICE_ADDRESS_GND, 0x0E ), LE( C6DOFIMU20_DEVICE_ADDRESS_GND, 0x10 ) } },
+    // Status first, accel axes are stored Z, Y, X
+    { "c6dofimu25_get_data", setup_c6dofimu25, read_c6dofimu25, 2, 0, 0, 0, 0, 7,
+      { LE( C6DOFIMU25_ADR, 0x20 ), LE( C6DOFIMU25_ADR, 0x22 ), LE( C6DOFIMU25_ADR, 0x24 ),
+        LE( C6DOFIMU25_ADR, 0x26 ), LE( C6DOFIMU25_ADR, 0x2C ), LE( C6DOFIMU25_ADR, 0x2A ),
+        LE( C6DOFIMU25_ADR, 0x28 ) },
+      C6DOFIMU25_ADR, C6DOFIMU25_REG_STATUS,
+      C6DOFIMU25_STATUS_TDA | C6DOFIMU25_STATUS_GDA | C6DOFIMU25_STATUS_XLDA },
+    { "c9dof_read_accel", setup_c9dof, read_c9dof_accel, 1, 0, C9DOF_M_ADR, 0x80, 0, 3,
+      { LE( C9DOF_AG_ADR, 0x28 ), LE( C9DOF_AG_ADR, 0x2A ), LE( C9DOF_AG_ADR, 0x2C ) } },
+    { "c9dof_read_gyro", setup_c9dof, read_c9dof_gyro, 1, 0, C9DOF_M_ADR, 0x80, 0, 3,
+      { LE( C9DOF_AG_ADR, 0x18 ), LE( C9DOF_AG_ADR, 0x1A ), LE( C9DOF_AG_ADR, 0x1C ) } },
+    { "c9dof_read_mag", setup_c9dof, read_c9dof_mag, 1, 0, C9DOF_M_ADR, 0x80, 0, 3,
+      { LE( C9DOF_M_ADR, 0x28 ), LE( C9DOF_M_ADR, 0x2A ), LE( C9DOF_M_ADR, 0x2C ) } },
+    { "c9dof2_read_all_data", setup_c9dof2, read_c9dof2, 1, 0, 0, 0, 0, 7,
+      { BE( SPI_PAGE, 0x2D ), BE( SPI_PAGE, 0x2F ), BE( SPI_PAGE, 0x31 ), BE( SPI_PAGE, 0x33 ),
+        BE( SPI_PAGE, 0x35 ), BE( SPI_PAGE, 0x37 ), BE( SPI_PAGE, 0x39 ) } },
+    // The SPI address byte carries the multiple byte bit, I2C reads always auto increment
+    { "accel_read_axes (I2C)", setup_accel_i2c, read_accel, 1, 0, 0, 0, 0, 3,
+      { LE( ACCEL_I2C_ADR_VCC, 0x32 ), LE( ACCEL_I2C_ADR_VCC, 0x34 ), LE( ACCEL_I2C_ADR_VCC, 0x36 ) } },
+    { "accel_read_axes (SPI)", setup_accel_spi, read_accel, 1, 0, SPI_PAGE, 0x40, 0, 3,
+      { LE( SPI_PAGE, 0x32 ), LE( SPI_PAGE, 0x34 ), LE( SPI_PAGE, 0x36 ) } },
+    { "accel2_read_axes (I2C)", setup_accel2_i2c, read_accel2, 1, 0, 0, 0, 0, 3,
+      { LE( 0x1D, 0x28 ), LE( 0x1D, 0x2A ), LE( 0x1D, 0x2C ) } },
+    { "accel2_read_axes (SPI)", setup_accel2_spi, read_accel2, 1, 0, 0, 0, 0, 3,
+      { LE( SPI_PAGE, 0x28 ), LE( SPI_PAGE, 0x2A ), LE( SPI_PAGE, 0x2C ) } },
+    { "accel3_read_data (I2C)", setup_accel3_i2c, read_accel3, 1, 0, ACCEL3_I2C_ADDRESS, 0x80, 0, 3,
+      { LE( ACCEL3_I2C_ADDRESS, 0x28 ), LE( ACCEL3_I2C_ADDRESS, 0x2A ), LE( ACCEL3_I2C_ADDRESS, 0x2C ) } },
+    { "accel3_read_data (SPI)", setup_accel3_spi, read_accel3, 1, 0, SPI_PAGE, 0x40, 0, 3,
+      { LE( SPI_PAGE, 0x28 ), LE( SPI_PAGE, 0x2A ), LE( SPI_PAGE, 0x2C ) } },
+    { "accel4_get_axes_data", setup_accel4, read_accel4, 1, 0, 0, 0, 0, 3,
+      { LE( ACCEL4_SET_DEV_ADDR, 0x04 ), LE( ACCEL4_SET_DEV_ADDR, 0x06 ), LE( ACCEL4_SET_DEV_ADDR, 0x08 ) } },
+    { "accel8_get_data", setup_accel8, read_accel8, 1, 0, 0, 0, 0, 7,
+      { BE( ACCEL8_DEVICE_SLAVE_ADDRESS_ADD, 0x3B ), BE( ACCEL8_DEVICE_SLAVE_ADDRESS_ADD, 0x3D ),
+        BE( ACCEL8_DEVICE_SLAVE_ADDRESS_ADD, 0x3F ), BE( ACCEL8_DEVICE_SLAVE_ADDRESS_ADD, 0x41 ),
+        BE( ACCEL8_DEVICE_SLAVE_ADDRESS_ADD, 0x43 ), BE( ACCEL8_DEVICE_SLAVE_ADDRESS_ADD, 0x45 ),
+        BE( ACCEL8_DEVICE_SLAVE_ADDRESS_ADD, 0x47 ) } },
+    { "accel12_get_axis_data", setup_accel12, read_accel12, 1, 0, 0, 0, 0, 3,
+      { LE( 0x4C, 0x0D ), LE( 0x4C, 0x0F ), LE( 0x4C, 0x11 ) } },
+    { "accel13_get_axis_data", setup_accel13, read_accel13, 1, 0, 0, 0, 0, 3,
+      { LE( ACCEL13_DEVICE_SLAVE_ADDR_VCC, 0x28 ), LE( ACCEL13_DEVICE_SLAVE_ADDR_VCC, 0x2A ),
+        LE( ACCEL13_DEVICE_SLAVE_ADDR_VCC, 0x2C ) } },
+    { "accel28_get_raw_data", setup_accel28, read_accel28, 1, 0, 0, 0, 0, 3,
+      { LE( ACCEL28_DEVICE_ADDRESS_0, 0x28 ), LE( ACCEL28_DEVICE_ADDRESS_0, 0x2A ),
+        LE( ACCEL28_DEVICE_ADDRESS_0, 0x2C ) } },
+    { "accelpressure_get_axes_data", setup_accelpressure, read_accelpressure, 1, 0, 0, 0, 0, 3,
+      { LE( ACCELPRESSURE_DEVICE_ADDRESS_ACCEL, 0x04 ), LE( ACCELPRESSURE_DEVICE_ADDRESS_ACCEL, 0x06 ),
+        LE( ACCELPRESSURE_DEVICE_ADDRESS_ACCEL, 0x08 ) } },
+    { "gyro_read_gyro", setup_gyro, read_gyro, 1, 0, GYRO_L3GD20_I2C_ADDRESS, 0x80, 0, 3,
+      { LE( GYRO_L3GD20_I2C_ADDRESS, 0x28 ), LE( GYRO_L3GD20_I2C_ADDRESS, 0x2A ),
+        LE( GYRO_L3GD20_I2C_ADDRESS, 0x2C ) } },
+    { "gyro9_get_axis_data (I2C)", setup_gyro9_i2c, read_gyro9, 1, 0, GYRO9_DEVICE_ADDRESS_GND, 0x80, 0, 3,
+      { LE( GYRO9_DEVICE_ADDRESS_GND, 0x28 ), LE( GYRO9_DEVICE_ADDRESS_GND, 0x2A ),
+        LE( GYRO9_DEVICE_ADDRESS_GND, 0x2C ) } },
+    { "gyro9_get_axis_data (SPI)", setup_gyro9_spi, read_gyro9, 1, 0, SPI_PAGE, 0x40, 0, 3,
+      { LE( SPI_PAGE, 0x28 ), LE( SPI_PAGE, 0x2A ), LE( SPI_PAGE, 0x2C ) } },
+};
+
+// --------------------------------------------------------------------- CHECKS
+
+static int32_t expected_value ( const out_reg_t *out )
+{
+    uint16_t raw = ( uint16_t ) ( ( regs[ out->page ][ out->msb ] << 8 ) | regs[ out->page ][ out->lsb ] );
+    int32_t value = raw & ( ( 1ul << out->bits ) - 1 );
+    if ( value & ( 1l << ( out->bits - 1 ) ) )
+    {
+        value -= 1l << out->bits;
+    }
+    return value;
+}
+
+static void run_part ( const part_t *p )
+{
+    int32_t values[ MAX_VALUES ];
+    uint32_t total_transactions = 0;
+    uint32_t torn = 0;
+    uint32_t wrong_count = 0;
+
+    hal_sim_reset( );
+    hal_sim_i2c_transfer = imu_transfer;
+    hal_sim_spi_select = imu_select;
+    hal_sim_spi_write = imu_spi_write;
+    hal_sim_spi_read = imu_spi_read;
+    part = p;
+    memset( regs, 0, sizeof( regs ) );
+    p->setup( );
+    if ( p->fixed_value )
+    {
+        regs[ p->fixed_page ][ p->fixed_reg ] = p->fixed_value;
+    }
+
+    srand( 23 );
+    bus_bytes = 0;
+    for ( uint32_t run = 0; run < SAMPLES; run++ )
+    {
+        transactions = 0;
+        p->read( values );
+        total_transactions += transactions;
+        if ( transactions != p->transactions )
+        {
+            wrong_count++;
+        }
+        for ( uint8_t cnt = 0; cnt < p->num_values; cnt++ )
+        {
+            if ( values[ cnt ] != expected_value( &p->values[ cnt ] ) )
+            {
+                if ( !p->torn && !torn )
+                {
+                    printf( "FAIL: %s value %u is %ld, the output registers hold %ld\n", p->name, cnt,
+                            ( long ) values[ cnt ], ( long ) expected_value( &p->values[ cnt ] ) );
+                }
+                torn++;
+                break;
+            }
+        }
+    }
+
+    printf( "%-30s %u values, %.0f transactions, %.0f bus bytes per sample, %u of %u torn\n", p->name,
+            p->num_values, ( double ) total_transactions / SAMPLES, ( double ) bus_bytes / SAMPLES,
+            ( unsigned ) torn, SAMPLES );
+    if ( wrong_count )
+    {
+        printf( "FAIL: %s takes %.2f transactions per sample, expected %u\n", p->name,
+                ( double ) total_transactions / SAMPLES, p->transactions );
+        failures++;
+    }
+    if ( p->torn ? ( torn < SAMPLES ) : ( 0 != torn ) )
+    {
+        if ( p->torn )
+        {
+            printf( "FAIL: %s read %u samples intact, the model does not tear split reads\n", p->name,
+                    ( unsigned ) ( SAMPLES - torn ) );
+        }
+        failures++;
+    }
+}
+
+int main ( void )
+{
+    for ( size_t cnt = 0; cnt < sizeof( parts ) / sizeof( parts[ 0 ] ); cnt++ )
+    {
+        run_part( &parts[ cnt ] );
+    }
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,759 @@
+/*
+ * 6DOF IMU FIFO streaming: watermark wake-ups, burst drains and the ring.
+ *
+ * The 6DOF IMU 15 driver (ISM330DHCX) is built by default and the 6DOF IMU
+ * 25 driver (LSM6DSV) when C6DOFIMU25_BUILD is set. A FIFO model serves
+ * both parts on the I2C and SPI hooks. It batches accelerometer and
+ * gyroscope words at the BDR set in FIFO_CTRL3 and timestamp words at the
+ * decimation set in FIFO_CTRL4 once the timestamp counter is enabled. Each
+ * word carries the tag counter and parity bits next to the sensor tag and
+ * the timestamp words carry configuration bytes after the counter. Reading
+ * FIFO_DATA_OUT_TAG pops a word, and the address rolls back from the last
+ * output byte to the tag so one transaction can read many words. A full
+ * FIFO drops its oldest word and raises FIFO_OVR_IA. INT1 is driven by
+ * the watermark flag once INT1_FIFO_TH is routed.
+ *
+ * The configuration has to land in the FIFO control, timestamp enable and
+ * INT1 routing registers without touching their other bits. The MCU then
+ * sleeps until INT1 for two simulated seconds per scenario and drains the
+ * FIFO with one fifo_read per wake-up. Every sample written by the model
+ * has to come out of the ring once, in order, with its values, tag and
+ * the timestamp of the last timestamp word ahead of it, and the FIFO must
+ * never overflow. Each drain has to read the level once and then use full
+ * bursts of 36 words apart from the last one. A stall afterwards has to
+ * report FIFO_OVR_IA and leave the newest samples in a small ring with the
+ * rest counted as dropped. The watermark and batching rate limits of the
+ * configuration are checked on the way.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_sim.h"
+
+#ifdef C6DOFIMU25_BUILD
+#include "c6dofimu25.h"
+
+#define DRIVER_NAME         "6DOF IMU 25"
+#define imu_t               c6dofimu25_t
+#define imu_cfg_t           c6dofimu25_cfg_t
+#define sample_t            c6dofimu25_fifo_sample_t
+#define ring_t              c6dofimu25_fifo_ring_t
+#define ring_init           c6dofimu25_fifo_ring_init
+#define REG_FIFO_CTRL1      C6DOFIMU25_REG_FIFO_CTRL1
+#define REG_FIFO_CTRL2      C6DOFIMU25_REG_FIFO_CTRL2
+#define REG_FIFO_CTRL3      C6DOFIMU25_REG_FIFO_CTRL3
+#define REG_FIFO_CTRL4      C6DOFIMU25_REG_FIFO_CTRL4
+#define REG_INT1_CTRL       C6DOFIMU25_REG_INT1_CTRL
+#define REG_FIFO_STATUS1    C6DOFIMU25_REG_FIFO_STATUS1
+#define REG_FIFO_STATUS2    C6DOFIMU25_REG_FIFO_STATUS2
+#define REG_FIFO_DATA_OUT   C6DOFIMU25_REG_FIFO_DATA_OUT_TAG
+#define REG_TS_ENABLE       C6DOFIMU25_REG_FUNCTIONS_ENABLE
+#define TS_ENABLE           C6DOFIMU25_FUNCTIONS_ENABLE_TIMESTAMP_EN
+#define INT1_FIFO_TH        C6DOFIMU25_INT1_CTRL_FIFO_TH
+#define STATUS_WTM_IA       C6DOFIMU25_FIFO_STATUS2_WTM_IA
+#define STATUS_OVR_IA       C6DOFIMU25_FIFO_STATUS2_OVR_IA
+#define STATUS_FULL_IA      C6DOFIMU25_FIFO_STATUS2_FULL_IA
+#define LEVEL_MSB_MASK      C6DOFIMU25_FIFO_STATUS2_DIFF_FIFO_8
+#define WTM_MSB_MASK        0x00
+#define WTM_MAX             255
+#define SAMPLE_TAG_GYRO     C6DOFIMU25_FIFO_TAG_GYRO
+#define SAMPLE_TAG_ACCEL    C6DOFIMU25_FIFO_TAG_ACCEL
+#define DEC_TS_OFF          C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_OFF
+#define DEC_TS_1            C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_1
+#define DEC_TS_8            C6DOFIMU25_FIFO_CTRL4_DEC_TS_BATCH_8
+#define BDR_XL_TOP          C6DOFIMU25_ACCEL_ODR_7680_HZ
+#define BDR_GY_TOP          C6DOFIMU25_GYRO_ODR_7680_HZ
+#define BDR_XL_MID          C6DOFIMU25_ACCEL_ODR_1920_HZ
+#define BDR_GY_MID_HALF     C6DOFIMU25_GYRO_ODR_960_HZ
+#define BDR_GY_CODE( bdr )  ( bdr )
+#define TOP_BDR_CODE        12
+#define TOP_BDR_HZ          7680.0
+#define TS_LSB_NS           21750
+#define FIFO_DEPTH          511
+#define TS_ENABLE_PRESET    0x80
+#else
+#include "c6dofimu15.h"
+
+#define DRIVER_NAME         "6DOF IMU 15"
+#define imu_t               c6dofimu15_t
+#define imu_cfg_t           c6dofimu15_cfg_t
+#define sample_t            c6dofimu15_fifo_sample_t
+#define ring_t              c6dofimu15_fifo_ring_t
+#define ring_init           c6dofimu15_fifo_ring_init
+#define REG_FIFO_CTRL1      C6DOFIMU15_FIFO_CTL1
+#define REG_FIFO_CTRL2      C6DOFIMU15_FIFO_CTL2
+#define REG_FIFO_CTRL3      C6DOFIMU15_FIFO_CTL3
+#define REG_FIFO_CTRL4      C6DOFIMU15_FIFO_CTL4
+#define REG_INT1_CTRL       C6DOFIMU15_INT1_CTL
+#define REG_FIFO_STATUS1    C6DOFIMU15_FIFO_STAT1
+#define REG_FIFO_STATUS2    C6DOFIMU15_FIFO_STAT2
+#define REG_FIFO_DATA_OUT   C6DOFIMU15_FIFO_DATA_OUT_TAG
+#define REG_TS_ENABLE       C6DOFIMU15_CTL10_C
+#define TS_ENABLE           C6DOFIMU15_T_STAMP_EN
+#define INT1_FIFO_TH        C6DOFIMU15_INT1_FIFO_TH
+#define STATUS_WTM_IA       C6DOFIMU15_FIFO_WTM_IA
+#define STATUS_OVR_IA       C6DOFIMU15_FIFO_OVR_IA
+#define STATUS_FULL_IA      C6DOFIMU15_FIFO_FULL_IA
+#define LEVEL_MSB_MASK      C6DOFIMU15_FIFO_DIFF_MSB_MASK
+#define WTM_MSB_MASK        0x01
+#define WTM_MAX             C6DOFIMU15_FIFO_WTM_MAX
+#define SAMPLE_TAG_GYRO     C6DOFIMU15_TAG_SEN_GYRO
+#define SAMPLE_TAG_ACCEL    C6DOFIMU15_TAG_SEN_ACEL
+#define DEC_TS_OFF          0x00
+#define DEC_TS_1            C6DOFIMU15_DEC_TS_BATCH_1
+#define DEC_TS_8            C6DOFIMU15_DEC_TS_BATCH_8
+#define BDR_XL_TOP          C6DOFIMU15_BDR_XL_6667_HZ
+#define BDR_GY_TOP          C6DOFIMU15_BDR_GY_6667_HZ
+#define BDR_XL_MID          C6DOFIMU15_BDR_XL_1667_HZ
+#define BDR_GY_MID_HALF     C6DOFIMU15_BDR_GY_833_HZ
+#define BDR_GY_CODE( bdr )  ( ( bdr ) >> 4 )
+#define TOP_BDR_CODE        10
+#define TOP_BDR_HZ          6667.0
+#define TS_LSB_NS           25000
+#define FIFO_DEPTH          438
+#define TS_ENABLE_PRESET    0x00
+#endif
+
+#define I2C_BYTE_US         ( 9 / 0.4 )
+#define SPI_BYTE_US         ( 8 / 10.0 )
+#define SPI_READ_MASK       0x80
+#define WORD_SIZE           7
+#define BURST_WORDS         36
+#define OUT_LAST            ( REG_FIFO_DATA_OUT + WORD_SIZE - 1 )
+#define TAG_ID_GYRO         1
+#define TAG_ID_ACCEL        2
+#define TAG_ID_TIMESTAMP    4
+#define TS_BASE             0x9E3779B9ul
+#define RUN_US              2000000ull
+#define WAKE_US             20
+#define RING_SIZE           512
+#define STALL_RING_SIZE     16
+#define MAX_REF             40000
+
+typedef struct
+{
+    uint8_t tag;
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    uint32_t timestamp;
+} ref_sample_t;
+
+static struct
+{
+    uint8_t regs[ 256 ];
+    uint8_t words[ FIFO_DEPTH ][ WORD_SIZE ];
+    int32_t word_ref[ FIFO_DEPTH ];
+    uint16_t head;
+    uint16_t level;
+    uint8_t out[ WORD_SIZE ];
+    uint8_t ovr;
+    uint8_t running;
+    uint64_t next_tick_ns;
+    uint32_t tick;
+    uint32_t last_ts;
+    uint32_t n[ 2 ];
+} dev;
+
+static struct
+{
+    uint8_t addr;
+    uint8_t started;
+    uint8_t read;
+    size_t len;
+} spi;
+
+static ref_sample_t ref[ MAX_REF ];
+static uint32_t ref_count;
+static uint32_t got_count;
+static uint32_t lost_words;
+static uint32_t words_written;
+
+static uint32_t writes;
+static uint32_t status_reads;
+static uint32_t bursts;
+static uint32_t expected_bursts;
+static uint32_t max_burst_words;
+static uint32_t empty_pops;
+static uint32_t odd_bursts;
+static int32_t snap_last_ref;
+static uint32_t snap_samples;
+
+static sample_t ring_buf[ RING_SIZE ];
+
+static int failures;
+
+// ------------------------------------------------------------------- DEVICE
+
+static uint16_t device_watermark ( void )
+{
+    return dev.regs[ REG_FIFO_CTRL1 ] | ( ( uint16_t ) ( dev.regs[ REG_FIFO_CTRL2 ] & WTM_MSB_MASK ) << 8 );
+}
+
+static uint8_t device_int1 ( void )
+{
+    return ( dev.regs[ REG_INT1_CTRL ] & INT1_FIFO_TH ) && device_watermark( ) &&
+           ( dev.level >= device_watermark( ) );
+}
+
+static void fifo_push ( uint8_t tag_id, const uint8_t *data, int32_t ref_index )
+{
+    uint16_t slot = ( dev.head + dev.level ) % FIFO_DEPTH;
+    uint8_t tag = ( uint8_t ) ( ( tag_id << 3 ) | ( ( dev.tick & 3 ) << 1 ) );
+    uint8_t parity = tag;
+
+    if ( FIFO_DEPTH == dev.level )
+    {
+        lost_words++;
+        dev.head = ( dev.head + 1 ) % FIFO_DEPTH;
+        dev.level--;
+        dev.ovr = 1;
+    }
+    parity ^= parity >> 4;
+    parity ^= parity >> 2;
+    parity ^= parity >> 1;
+    dev.words[ slot ][ 0 ] = tag | ( parity & 1 );
+    memcpy( &dev.words[ slot ][ 1 ], data, WORD_SIZE - 1 );
+    dev.word_ref[ slot ] = ref_index;
+    dev.level++;
+    words_written++;
+}
+
+static void fifo_push_sample ( uint8_t tag_id, uint8_t sensor_tag )
+{
+    uint8_t sensor = ( TAG_ID_ACCEL == tag_id );
+    uint32_t n = dev.n[ sensor ]++;
+    ref_sample_t *s;
+    uint8_t data[ 6 ];
+
+    if ( ref_count == MAX_REF )
+    {
+        printf( "FAIL: reference log is full\n" );
+        exit( EXIT_FAILURE );
+    }
+    s = &ref[ ref_count ];
+    s->tag = sensor_tag;
+    s->x = ( int16_t ) ( n * 37 + sensor * 1000 );
+    s->y = ( int16_t ) ( -( int32_t ) ( n * 113 ) );
+    s->z = ( int16_t ) ( 0x8000 | ( n ^ sensor ) );
+    s->timestamp = dev.last_ts;
+    data[ 0 ] = ( uint8_t ) s->x;
+    data[ 1 ] = ( uint8_t ) ( ( uint16_t ) s->x >> 8 );
+    data[ 2 ] = ( uint8_t ) s->y;
+    data[ 3 ] = ( uint8_t ) ( ( uint16_t ) s->y >> 8 );
+    data[ 4 ] = ( uint8_t ) s->z;
+    data[ 5 ] = ( uint8_t ) ( ( uint16_t ) s->z >> 8 );
+    fifo_push( tag_id, data, ( int32_t ) ref_count++ );
+}
+
+static uint64_t bdr_period_ns ( uint8_t code )
+{
+    return ( uint64_t ) ( 1e9 / TOP_BDR_HZ ) << ( TOP_BDR_CODE - code );
+}
+
+// Batches every tick of the fastest BDR that is due, timestamp word ahead of the sensor words
+static void device_run ( void )
+{
+    uint64_t now_ns = hal_sim_time_us * 1000;
+    uint8_t xl = dev.regs[ REG_FIFO_CTRL3 ] & 0x0F;
+    uint8_t gy = dev.regs[ REG_FIFO_CTRL3 ] >> 4;
+    uint8_t top = ( xl > gy ) ? xl : gy;
+    static const uint8_t ts_dec[ 4 ] = { 0, 1, 8, 32 };
+    uint8_t dec = ts_dec[ dev.regs[ REG_FIFO_CTRL4 ] >> 6 ];
+
+    if ( !dev.running || !top || ( top > TOP_BDR_CODE ) )
+    {
+        return;
+    }
+    while ( dev.next_tick_ns <= now_ns )
+    {
+        if ( dec && ( dev.regs[ REG_TS_ENABLE ] & TS_ENABLE ) && ( 0 == dev.tick % dec ) )
+        {
+            uint8_t data[ 6 ];
+
+            dev.last_ts = ( uint32_t ) ( TS_BASE + dev.next_tick_ns / TS_LSB_NS );
+            for ( uint8_t cnt = 0; cnt < 4; cnt++ )
+            {
+                data[ cnt ] = ( uint8_t ) ( dev.last_ts >> ( 8 * cnt ) );
+            }
+            data[ 4 ] = 0xA5;
+            data[ 5 ] = 0x5A;
+            fifo_push( TAG_ID_TIMESTAMP, data, -1 );
+        }
+        if ( gy && ( 0 == dev.tick % ( 1u << ( top - gy ) ) ) )
+        {
+            fifo_push_sample( TAG_ID_GYRO, SAMPLE_TAG_GYRO );
+        }
+        if ( xl && ( 0 == dev.tick % ( 1u << ( top - xl ) ) ) )
+        {
+            fifo_push_sample( TAG_ID_ACCEL, SAMPLE_TAG_ACCEL );
+        }
+        dev.tick++;
+        dev.next_tick_ns += bdr_period_ns( top );
+    }
+}
+
+static uint8_t device_read_byte ( uint8_t reg )
+{
+    if ( REG_FIFO_STATUS1 == reg )
+    {
+        return ( uint8_t ) dev.level;
+    }
+    if ( REG_FIFO_STATUS2 == reg )
+    {
+        uint8_t status = ( uint8_t ) ( dev.level >> 8 ) & LEVEL_MSB_MASK;
+
+        status |= ( device_watermark( ) && ( dev.level >= device_watermark( ) ) ) ? STATUS_WTM_IA : 0;
+        status |= dev.ovr ? STATUS_OVR_IA : 0;
+        status |= ( FIFO_DEPTH == dev.level ) ? STATUS_FULL_IA : 0;
+        dev.ovr = 0;
+        return status;
+    }
+    if ( REG_FIFO_DATA_OUT == reg )
+    {
+        if ( 0 == dev.level )
+        {
+            empty_pops++;
+            memset( dev.out, 0, sizeof( dev.out ) );
+        }
+        else
+        {
+            memcpy( dev.out, dev.words[ dev.head ], WORD_SIZE );
+            dev.head = ( dev.head + 1 ) % FIFO_DEPTH;
+            dev.level--;
+        }
+    }
+    if ( ( reg >= REG_FIFO_DATA_OUT ) && ( reg <= OUT_LAST ) )
+    {
+        return dev.out[ reg - REG_FIFO_DATA_OUT ];
+    }
+    return dev.regs[ reg ];
+}
+
+// Level snapshot of a status read, used for the burst count and the stall check
+static void device_snapshot ( void )
+{
+    snap_samples = 0;
+    snap_last_ref = -1;
+    for ( uint16_t cnt = 0; cnt < dev.level; cnt++ )
+    {
+        int32_t index = dev.word_ref[ ( dev.head + cnt ) % FIFO_DEPTH ];
+
+        if ( index >= 0 )
+        {
+            snap_samples++;
+            snap_last_ref = index;
+        }
+    }
+    status_reads++;
+    expected_bursts += ( dev.level + BURST_WORDS - 1 ) / BURST_WORDS;
+}
+
+static uint8_t next_addr ( uint8_t reg )
+{
+    return ( OUT_LAST == reg ) ? REG_FIFO_DATA_OUT : ( uint8_t ) ( reg + 1 );
+}
+
+static void device_read ( uint8_t reg, uint8_t *data, size_t len )
+{
+    if ( REG_FIFO_STATUS1 == reg )
+    {
+        device_snapshot( );
+    }
+    if ( REG_FIFO_DATA_OUT == reg )
+    {
+        bursts++;
+        if ( len % WORD_SIZE )
+        {
+            odd_bursts++;
+        }
+        if ( len / WORD_SIZE > max_burst_words )
+        {
+            max_burst_words = len / WORD_SIZE;
+        }
+    }
+    for ( size_t cnt = 0; cnt < len; cnt++ )
+    {
+        data[ cnt ] = device_read_byte( reg );
+        reg = next_addr( reg );
+    }
+}
+
+static void device_write ( uint8_t reg, const uint8_t *data, size_t len )
+{
+    writes++;
+    for ( size_t cnt = 0; cnt < len; cnt++ )
+    {
+        if ( ( REG_FIFO_CTRL4 == reg ) && ( 0x06 == ( data[ cnt ] & 0x07 ) ) && !dev.running )
+        {
+            dev.running = 1;
+            dev.tick = 0;
+            dev.next_tick_ns = hal_sim_time_us * 1000;
+        }
+        dev.regs[ reg ] = data[ cnt ];
+        reg = next_addr( reg );
+    }
+}
+
+static err_t i2c_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                            uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    ( void ) address;
+    if ( read_len )
+    {
+        device_read( write_buf[ 0 ], read_buf, read_len );
+    }
+    else if ( write_len > 1 )
+    {
+        device_write( write_buf[ 0 ], &write_buf[ 1 ], write_len - 1 );
+    }
+    hal_sim_time_us += ( uint64_t ) ( ( 1 + write_len + ( read_len ? 1 + read_len : 0 ) ) * I2C_BYTE_US );
+    device_run( );
+    return I2C_MASTER_SUCCESS;
+}
+
+static void spi_select ( pin_name_t cs, uint8_t selected )
+{
+    ( void ) cs;
+    if ( !selected && spi.started )
+    {
+        hal_sim_time_us += ( uint64_t ) ( spi.len * SPI_BYTE_US );
+        device_run( );
+    }
+    spi.started = 0;
+    spi.len = 0;
+}
+
+static err_t spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    spi.len += size;
+    if ( !spi.started )
+    {
+        spi.started = 1;
+        spi.read = buffer[ 0 ] & SPI_READ_MASK;
+        spi.addr = buffer[ 0 ] & ~SPI_READ_MASK;
+        buffer++;
+        size--;
+    }
+    if ( size && !spi.read )
+    {
+        device_write( spi.addr, buffer, size );
+        spi.addr += size;
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+static err_t spi_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    spi.len += size;
+    device_read( spi.addr, buffer, size );
+    return SPI_MASTER_SUCCESS;
+}
+
+// ------------------------------------------------------------------- HOST
+
+static void open_device ( imu_t *ctx, uint8_t use_spi )
+{
+    imu_cfg_t cfg;
+
+    hal_sim_reset( );
+    hal_sim_i2c_transfer = i2c_transfer;
+    hal_sim_spi_select = spi_select;
+    hal_sim_spi_write = spi_write;
+    hal_sim_spi_read = spi_read;
+    memset( &dev, 0, sizeof( dev ) );
+    memset( &spi, 0, sizeof( spi ) );
+    ref_count = got_count = lost_words = words_written = 0;
+    writes = status_reads = bursts = expected_bursts = max_burst_words = empty_pops = odd_bursts = 0;
+
+    /* Bits the configuration has to keep: ODRCHG_EN with a stale WTM8, T batching rate and DRDY_XL */
+    dev.regs[ REG_FIFO_CTRL2 ] = 0x10 | WTM_MSB_MASK;
+    dev.regs[ REG_FIFO_CTRL4 ] = 0x37;
+    dev.regs[ REG_TS_ENABLE ] = TS_ENABLE_PRESET;
+    dev.regs[ REG_INT1_CTRL ] = 0x01;
+
+    memset( ctx, 0, sizeof( imu_t ) );
+#ifdef C6DOFIMU25_BUILD
+    c6dofimu25_cfg_setup( &cfg );
+    cfg.drv_sel = use_spi ? C6DOFIMU25_DRV_SEL_SPI : C6DOFIMU25_DRV_SEL_I2C;
+    c6dofimu25_init( ctx, &cfg );
+#else
+    c6dofimu15_cfg_setup( &cfg );
+    cfg.sel = use_spi ? C6DOFIMU15_MASTER_SPI : C6DOFIMU15_MASTER_I2C;
+    c6dofimu15_init( ctx, &cfg );
+#endif
+    writes = 0;
+}
+
+static err_t fifo_config ( imu_t *ctx, uint16_t watermark, uint8_t bdr_xl, uint8_t bdr_gy, uint8_t dec_ts )
+{
+#ifdef C6DOFIMU25_BUILD
+    return c6dofimu25_fifo_config( ctx, ( uint8_t ) watermark, bdr_xl, bdr_gy, dec_ts );
+#else
+    c6dofimu15_fifo_config( ctx, watermark, bdr_xl, bdr_gy, dec_ts );
+    return 0;
+#endif
+}
+
+static void fifo_read ( imu_t *ctx, ring_t *ring )
+{
+#ifdef C6DOFIMU25_BUILD
+    if ( C6DOFIMU25_OK != c6dofimu25_fifo_read( ctx, ring ) )
+    {
+        printf( "FAIL: fifo_read returns an error\n" );
+        failures++;
+    }
+#else
+    c6dofimu15_fifo_read( ctx, ring );
+#endif
+}
+
+static uint8_t ring_get ( ring_t *ring, sample_t *sample )
+{
+#ifdef C6DOFIMU25_BUILD
+    return C6DOFIMU25_OK == c6dofimu25_fifo_ring_pop( ring, sample );
+#else
+    return c6dofimu15_fifo_ring_pop( ring, sample );
+#endif
+}
+
+static uint8_t same_sample ( const sample_t *got, const ref_sample_t *want )
+{
+    return ( got->tag == want->tag ) && ( got->x == want->x ) && ( got->y == want->y ) &&
+           ( got->z == want->z ) && ( got->timestamp == want->timestamp );
+}
+
+static void drain_ring ( ring_t *ring )
+{
+    sample_t sample;
+
+    while ( ring_get( ring, &sample ) )
+    {
+        if ( got_count >= ref_count )
+        {
+            printf( "FAIL: ring returns more samples than were batched\n" );
+            failures++;
+            return;
+        }
+        if ( !same_sample( &sample, &ref[ got_count ] ) )
+        {
+            if ( failures < 10 )
+            {
+                printf( "FAIL: sample %u comes out as tag 0x%02X (%d, %d, %d) ts 0x%08X, "
+                        "batched as tag 0x%02X (%d, %d, %d) ts 0x%08X\n", ( unsigned ) got_count,
+                        sample.tag, sample.x, sample.y, sample.z, ( unsigned ) sample.timestamp,
+                        ref[ got_count ].tag, ref[ got_count ].x, ref[ got_count ].y,
+                        ref[ got_count ].z, ( unsigned ) ref[ got_count ].timestamp );
+            }
+            failures++;
+        }
+        got_count++;
+    }
+}
+
+// ------------------------------------------------------------------- CHECKS
+
+static void check_reg ( const char *name, uint8_t reg, uint8_t expected )
+{
+    if ( dev.regs[ reg ] != expected )
+    {
+        printf( "FAIL: %s is 0x%02X, expected 0x%02X\n", name, dev.regs[ reg ], expected );
+        failures++;
+    }
+}
+
+static void check_config ( uint16_t watermark, uint8_t bdr_xl, uint8_t bdr_gy, uint8_t dec_ts )
+{
+    check_reg( "FIFO_CTRL1", REG_FIFO_CTRL1, ( uint8_t ) watermark );
+    check_reg( "FIFO_CTRL2", REG_FIFO_CTRL2, 0x10 | ( ( watermark >> 8 ) & WTM_MSB_MASK ) );
+    check_reg( "FIFO_CTRL3", REG_FIFO_CTRL3, ( uint8_t ) ( ( BDR_GY_CODE( bdr_gy ) << 4 ) | bdr_xl ) );
+    check_reg( "FIFO_CTRL4", REG_FIFO_CTRL4, 0x30 | dec_ts | 0x06 );
+    check_reg( "timestamp enable", REG_TS_ENABLE, TS_ENABLE_PRESET | ( dec_ts ? TS_ENABLE : 0 ) );
+    check_reg( "INT1_CTRL", REG_INT1_CTRL, 0x01 | INT1_FIFO_TH );
+}
+
+static const struct
+{
+    const char *name;
+    uint8_t spi;
+    uint16_t watermark;
+    uint8_t bdr_xl;
+    uint8_t bdr_gy;
+    uint8_t dec_ts;
+} scenarios[ ] =
+{
+    { "SPI 10 MHz, accel and gyro at the top BDR, timestamp every 8", 1, 192, BDR_XL_TOP, BDR_GY_TOP, DEC_TS_8 },
+    { "I2C 400 kHz, gyro at half the accel BDR, timestamp every batch", 0, 64, BDR_XL_MID, BDR_GY_MID_HALF, DEC_TS_1 },
+};
+
+static void check_stream ( unsigned index )
+{
+    imu_t ctx;
+    ring_t ring;
+    uint32_t wakeups = 0;
+    uint64_t busy_us = 0;
+    uint16_t max_level = 0;
+    uint8_t ovr_seen = 0;
+    uint32_t pending = 0;
+
+    open_device( &ctx, scenarios[ index ].spi );
+    ring_init( &ring, ring_buf, RING_SIZE );
+    if ( fifo_config( &ctx, scenarios[ index ].watermark, scenarios[ index ].bdr_xl,
+                      scenarios[ index ].bdr_gy, scenarios[ index ].dec_ts ) )
+    {
+        printf( "FAIL: fifo_config rejects a valid configuration\n" );
+        failures++;
+    }
+    check_config( scenarios[ index ].watermark, scenarios[ index ].bdr_xl,
+                  scenarios[ index ].bdr_gy, scenarios[ index ].dec_ts );
+
+    while ( hal_sim_time_us < RUN_US )
+    {
+        uint64_t start;
+
+        if ( !device_int1( ) )
+        {
+            hal_sim_time_us++;
+            device_run( );
+            continue;
+        }
+        if ( dev.level > max_level )
+        {
+            max_level = dev.level;
+        }
+        hal_sim_time_us += WAKE_US;
+        device_run( );
+        start = hal_sim_time_us;
+        fifo_read( &ctx, &ring );
+        busy_us += hal_sim_time_us - start;
+        wakeups++;
+        ovr_seen |= ring.status & STATUS_OVR_IA;
+        if ( ring.dropped )
+        {
+            printf( "FAIL: ring drops %u samples while streaming\n", ring.dropped );
+            failures++;
+            ring.dropped = 0;
+        }
+        drain_ring( &ring );
+    }
+
+    for ( uint16_t cnt = 0; cnt < dev.level; cnt++ )
+    {
+        pending += ( dev.word_ref[ ( dev.head + cnt ) % FIFO_DEPTH ] >= 0 );
+    }
+    printf( "%s, %s: %u words, %u samples in %u wake-ups, %.1f words per wake-up, "
+            "%u bursts of up to %u words, peak level %u of %u, MCU awake %.1f%%\n",
+            DRIVER_NAME, scenarios[ index ].name, ( unsigned ) words_written, ( unsigned ) got_count,
+            ( unsigned ) wakeups, wakeups ? ( double ) words_written / wakeups : 0.0, ( unsigned ) bursts,
+            ( unsigned ) max_burst_words, max_level, FIFO_DEPTH, 100.0 * busy_us / hal_sim_time_us );
+
+    if ( lost_words || ovr_seen )
+    {
+        printf( "FAIL: FIFO overflows while streaming, %u words lost\n", ( unsigned ) lost_words );
+        failures++;
+    }
+    if ( got_count + pending != ref_count )
+    {
+        printf( "FAIL: %u of %u samples come out of the ring, %u still in the FIFO\n",
+                ( unsigned ) got_count, ( unsigned ) ref_count, ( unsigned ) pending );
+        failures++;
+    }
+    if ( status_reads != wakeups )
+    {
+        printf( "FAIL: %u level reads for %u wake-ups\n", ( unsigned ) status_reads, ( unsigned ) wakeups );
+        failures++;
+    }
+    if ( ( bursts != expected_bursts ) || ( max_burst_words > BURST_WORDS ) || odd_bursts || empty_pops )
+    {
+        printf( "FAIL: %u bursts for %u full drains, up to %u words, %u partial words, %u empty reads\n",
+                ( unsigned ) bursts, ( unsigned ) expected_bursts, ( unsigned ) max_burst_words,
+                ( unsigned ) odd_bursts, ( unsigned ) empty_pops );
+        failures++;
+    }
+    if ( !wakeups || ( wakeups > words_written / scenarios[ index ].watermark + 1 ) )
+    {
+        printf( "FAIL: %u wake-ups for %u words at a watermark of %u\n", ( unsigned ) wakeups,
+                ( unsigned ) words_written, scenarios[ index ].watermark );
+        failures++;
+    }
+
+    /* Stall: the MCU misses the watermark until the FIFO wraps, then drains into a small ring */
+    {
+        sample_t stall_buf[ STALL_RING_SIZE ];
+        sample_t sample;
+        uint64_t until = hal_sim_time_us + 2 * FIFO_DEPTH * bdr_period_ns( TOP_BDR_CODE ) / 1000;
+        uint32_t popped = 0;
+
+        ring_init( &ring, stall_buf, STALL_RING_SIZE );
+        while ( hal_sim_time_us < until )
+        {
+            hal_sim_time_us++;
+            device_run( );
+        }
+        fifo_read( &ctx, &ring );
+        if ( !( ring.status & STATUS_OVR_IA ) || !( ring.status & STATUS_WTM_IA ) )
+        {
+            printf( "FAIL: status after a stall is 0x%02X\n", ring.status );
+            failures++;
+        }
+        if ( ring.dropped != snap_samples - STALL_RING_SIZE )
+        {
+            printf( "FAIL: ring drops %u of %u samples, expected %u\n", ring.dropped,
+                    ( unsigned ) snap_samples, ( unsigned ) ( snap_samples - STALL_RING_SIZE ) );
+            failures++;
+        }
+        while ( ring_get( &ring, &sample ) )
+        {
+            int32_t want = snap_last_ref - STALL_RING_SIZE + 1 + ( int32_t ) popped;
+
+            if ( ( popped >= STALL_RING_SIZE ) || ( want < 0 ) || !same_sample( &sample, &ref[ want ] ) )
+            {
+                printf( "FAIL: stalled ring sample %u is not the batched sample %d\n", ( unsigned ) popped, want );
+                failures++;
+            }
+            popped++;
+        }
+        if ( popped != STALL_RING_SIZE )
+        {
+            printf( "FAIL: stalled ring holds %u samples\n", ( unsigned ) popped );
+            failures++;
+        }
+    }
+}
+
+static void check_limits ( void )
+{
+    imu_t ctx;
+
+    open_device( &ctx, 0 );
+    dev.regs[ REG_TS_ENABLE ] |= TS_ENABLE;
+#ifdef C6DOFIMU25_BUILD
+    if ( ( C6DOFIMU25_OK == fifo_config( &ctx, 100, BDR_XL_TOP + 1, BDR_GY_TOP, DEC_TS_8 ) ) ||
+         ( C6DOFIMU25_OK == fifo_config( &ctx, 100, BDR_XL_TOP, BDR_GY_TOP + 1, DEC_TS_8 ) ) || writes )
+    {
+        printf( "FAIL: a BDR above the top rate is accepted or written\n" );
+        failures++;
+    }
+    fifo_config( &ctx, WTM_MAX, BDR_XL_MID, BDR_GY_MID_HALF, DEC_TS_OFF );
+#else
+    fifo_config( &ctx, 600, BDR_XL_MID, BDR_GY_MID_HALF, DEC_TS_OFF );
+#endif
+    check_reg( "watermark FIFO_CTRL1", REG_FIFO_CTRL1, ( uint8_t ) WTM_MAX );
+    check_reg( "watermark FIFO_CTRL2", REG_FIFO_CTRL2, 0x10 | ( ( WTM_MAX >> 8 ) & WTM_MSB_MASK ) );
+    check_reg( "timestamp enable without timestamp batching", REG_TS_ENABLE, TS_ENABLE_PRESET );
+}
+
+int main ( void )
+{
+    for ( unsigned index = 0; index < sizeof( scenarios ) / sizeof( scenarios[ 0 ] ); index++ )
+    {
+        check_stream( index );
+    }
+    check_limits( );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,969 @@
+/*
+ * Untagged FIFO streaming: watermark, level and burst drains into the ring.
+ *
+ * 6DOF IMU 9 (IAM-20680) and Accel 13 (LIS2DW12) run on the I2C hook and
+ * Accel 16 (ADXL362) on the SPI hooks, each against a model of its FIFO.
+ * The IAM-20680 keeps 512 bytes of 14-byte accel, temperature and gyro
+ * records, read from FIFO_R_W without address increment, and stops
+ * writing when it is full, so its last record can be cut short. The
+ * LIS2DW12 keeps 32 X, Y, Z samples read from OUT_X_L, with the address
+ * rolling back from OUT_Z_H, and in continuous mode drops its oldest
+ * sample when full. The ADXL362 keeps 512 axis words tagged in bits 15:14,
+ * read with the FIFO command, and in stream mode drops its oldest word
+ * when full. The watermark pins of the two accelerometers follow their
+ * interrupt maps; the IAM-20680 has none and is polled for its level.
+ *
+ * The configuration has to land in the FIFO and interrupt registers
+ * without touching their other bits and has to clamp the watermark. The
+ * models then produce one to three samples at a time and the FIFO is
+ * drained whenever the watermark is reached. Every sample has to come out
+ * of the ring once, in order, with its values, and the FIFO must never
+ * overflow. Each drain has to read the level once and then use full
+ * bursts apart from the last one. Filling the FIFO past its size has to
+ * report it and leave the newest samples the part kept in a small ring,
+ * with the rest counted as dropped, and the samples written after that
+ * drain have to come out aligned. An Accel 16 sample whose words are
+ * split over two drains has to come out once.
+ */
+#include "c6dofimu9.h"
+#include "accel13.h"
+#include "accel16.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IMU9_ADDRESS        C6DOFIMU9_I2C_SLAVE_ADDRESS_1
+#define IMU9_FIFO_BYTES     512
+#define IMU9_RECORD         14
+#define ACCEL13_ADDRESS     ACCEL13_DEVICE_SLAVE_ADDR_VCC
+#define ACCEL13_DEPTH       32
+#define ACCEL16_DEPTH       512
+#define ACCEL13_INT1_PIN    11
+#define ACCEL16_INT1_PIN    21
+#define ACCEL16_CS_PIN      22
+#define MAX_CHANNELS        7
+#define RING_SIZE           256
+#define SMALL_RING          8
+#define STREAM_STEPS        3000
+#define OVERFLOW_EXTRA      8
+
+static struct
+{
+    uint8_t regs[ 128 ];
+    uint8_t fifo[ IMU9_FIFO_BYTES ];
+    uint16_t head;
+    uint16_t level;
+} imu9_dev;
+
+static struct
+{
+    uint8_t regs[ 64 ];
+    uint8_t fifo[ ACCEL13_DEPTH ][ 6 ];
+    uint8_t out[ 6 ];
+    uint8_t head;
+    uint8_t level;
+    uint8_t ovr;
+} accel13_dev;
+
+static struct
+{
+    uint8_t regs[ 64 ];
+    uint16_t fifo[ ACCEL16_DEPTH ];
+    uint16_t head;
+    uint16_t level;
+    uint16_t out;
+    uint8_t overrun;
+    uint8_t next_axis;
+    uint8_t selected;
+    uint8_t cmd;
+    uint8_t addr;
+    uint8_t header;
+    uint32_t frame_bytes;
+} accel16_dev;
+
+static c6dofimu9_t imu9;
+static c6dofimu9_fifo_ring_t imu9_ring;
+static c6dofimu9_data_t imu9_buf[ RING_SIZE ];
+static accel13_t accel13;
+static accel13_fifo_ring_t accel13_ring;
+static accel13_axis_t accel13_buf[ RING_SIZE ];
+static accel16_t accel16;
+static accel16_fifo_ring_t accel16_ring;
+static accel16_axes_t accel16_buf[ RING_SIZE ];
+
+static uint32_t produced;
+static uint32_t level_reads;
+static uint32_t bursts;
+static uint32_t expected_bursts;
+static uint32_t max_burst;
+static uint32_t odd_bursts;
+static uint32_t empty_pops;
+
+static int failures;
+
+// --------------------------------------------------------------------- SAMPLES
+
+static int16_t ref_value ( uint32_t n, uint8_t channel )
+{
+    return ( int16_t ) ( ( n * 37 + channel * 541 ) % 4001 ) - 2000;
+}
+
+static uint32_t lcg_state;
+
+static uint8_t random_count ( void )
+{
+    lcg_state = lcg_state * 1103515245u + 12345u;
+    return ( uint8_t ) ( 1 + ( ( lcg_state >> 16 ) % 3 ) );
+}
+
+static void count_burst ( uint32_t units, uint32_t unit_size, uint32_t bytes )
+{
+    bursts++;
+    odd_bursts += ( 0 != bytes % unit_size );
+    max_burst = ( units > max_burst ) ? units : max_burst;
+}
+
+// ------------------------------------------------------------------ 6DOF IMU 9
+
+static void imu9_produce ( void )
+{
+    uint8_t record[ IMU9_RECORD ];
+    uint32_t n = produced++;
+
+    if ( !( imu9_dev.regs[ C6DOFIMU9_REG_USER_CTRL ] & 0x40 ) || ( 0xF8 != imu9_dev.regs[ C6DOFIMU9_REG_FIFO_EN ] ) )
+    {
+        return;
+    }
+    for ( uint8_t cnt = 0; cnt < MAX_CHANNELS; cnt++ )
+    {
+        record[ cnt * 2 ] = ( uint8_t ) ( ( uint16_t ) ref_value( n, cnt ) >> 8 );
+        record[ cnt * 2 + 1 ] = ( uint8_t ) ref_value( n, cnt );
+    }
+    for ( uint8_t cnt = 0; cnt < IMU9_RECORD; cnt++ )
+    {
+        if ( IMU9_FIFO_BYTES == imu9_dev.level )
+        {
+            if ( imu9_dev.regs[ C6DOFIMU9_REG_CONFIG ] & 0x40 )
+            {
+                return;
+            }
+            imu9_dev.head = ( imu9_dev.head + 1 ) % IMU9_FIFO_BYTES;
+            imu9_dev.level--;
+        }
+        imu9_dev.fifo[ ( imu9_dev.head + imu9_dev.level++ ) % IMU9_FIFO_BYTES ] = record[ cnt ];
+    }
+}
+
+static uint8_t imu9_read_byte ( uint8_t reg )
+{
+    uint8_t value;
+
+    switch ( reg )
+    {
+        case C6DOFIMU9_REG_FIFO_COUNTH:
+            return ( uint8_t ) ( imu9_dev.level >> 8 );
+        case C6DOFIMU9_REG_FIFO_COUNTL:
+            return ( uint8_t ) imu9_dev.level;
+        case C6DOFIMU9_REG_FIFO_R_W:
+            if ( 0 == imu9_dev.level )
+            {
+                empty_pops++;
+                return 0;
+            }
+            value = imu9_dev.fifo[ imu9_dev.head ];
+            imu9_dev.head = ( imu9_dev.head + 1 ) % IMU9_FIFO_BYTES;
+            imu9_dev.level--;
+            return value;
+        default:
+            return imu9_dev.regs[ reg & 0x7F ];
+    }
+}
+
+static void imu9_read ( uint8_t reg, uint8_t *data, size_t len )
+{
+    if ( C6DOFIMU9_REG_FIFO_COUNTH == reg )
+    {
+        level_reads++;
+        expected_bursts += ( imu9_dev.level / IMU9_RECORD + C6DOFIMU9_FIFO_BURST_RECORDS - 1 ) /
+                           C6DOFIMU9_FIFO_BURST_RECORDS;
+    }
+    if ( C6DOFIMU9_REG_FIFO_R_W == reg )
+    {
+        count_burst( len / IMU9_RECORD, IMU9_RECORD, len );
+    }
+    for ( size_t cnt = 0; cnt < len; cnt++ )
+    {
+        data[ cnt ] = imu9_read_byte( reg );
+        // FIFO_R_W is read over and over, the rest of the map auto increments
+        reg = ( C6DOFIMU9_REG_FIFO_R_W == reg ) ? reg : ( uint8_t ) ( reg + 1 );
+    }
+}
+
+static void imu9_write ( uint8_t reg, const uint8_t *data, size_t len )
+{
+    for ( size_t cnt = 0; cnt < len; cnt++, reg++ )
+    {
+        imu9_dev.regs[ reg & 0x7F ] = data[ cnt ];
+        if ( ( C6DOFIMU9_REG_USER_CTRL == reg ) && ( data[ cnt ] & 0x04 ) )
+        {
+            // FIFO_RST empties the FIFO and clears itself
+            imu9_dev.head = 0;
+            imu9_dev.level = 0;
+            imu9_dev.regs[ reg ] &= ~0x04;
+        }
+    }
+}
+
+static void imu9_open ( uint16_t ring_size )
+{
+    c6dofimu9_cfg_t cfg;
+
+    memset( &imu9_dev, 0, sizeof( imu9_dev ) );
+    // Bits the configuration has to keep: DLPF_CFG and a bit of USER_CTRL
+    imu9_dev.regs[ C6DOFIMU9_REG_CONFIG ] = 0x03;
+    imu9_dev.regs[ C6DOFIMU9_REG_USER_CTRL ] = 0x80;
+    c6dofimu9_cfg_setup( &cfg );
+    cfg.sel = C6DOFIMU9_MASTER_I2C;
+    c6dofimu9_init( &imu9, &cfg );
+    c6dofimu9_fifo_ring_init( &imu9_ring, imu9_buf, ring_size );
+}
+
+static void imu9_config ( uint16_t watermark )
+{
+    c6dofimu9_fifo_config( &imu9, watermark );
+}
+
+static uint8_t imu9_watermark ( void )
+{
+    uint8_t status;
+
+    c6dofimu9_fifo_get_level( &imu9, &status );
+    return 0 != ( status & C6DOFIMU9_FIFO_WTM_IA );
+}
+
+static void imu9_drain ( void )
+{
+    c6dofimu9_fifo_read( &imu9, &imu9_ring );
+}
+
+static uint8_t imu9_pop ( int32_t *values )
+{
+    c6dofimu9_data_t sample;
+
+    if ( !c6dofimu9_fifo_ring_pop( &imu9_ring, &sample ) )
+    {
+        return 0;
+    }
+    values[ 0 ] = sample.accel_x;
+    values[ 1 ] = sample.accel_y;
+    values[ 2 ] = sample.accel_z;
+    values[ 3 ] = sample.temp_out;
+    values[ 4 ] = sample.gyro_x;
+    values[ 5 ] = sample.gyro_y;
+    values[ 6 ] = sample.gyro_z;
+    return 1;
+}
+
+static uint8_t imu9_overflow ( void )
+{
+    return 0 != ( imu9_ring.status & C6DOFIMU9_FIFO_FULL_IA );
+}
+
+static uint16_t imu9_dropped ( void )
+{
+    return imu9_ring.dropped;
+}
+
+static uint8_t imu9_check_config ( void )
+{
+    uint8_t bad = 0;
+
+    c6dofimu9_fifo_config( &imu9, 20 );
+    bad |= ( 0x43 != imu9_dev.regs[ C6DOFIMU9_REG_CONFIG ] );
+    bad |= ( 0xF8 != imu9_dev.regs[ C6DOFIMU9_REG_FIFO_EN ] );
+    bad |= ( 0xC0 != imu9_dev.regs[ C6DOFIMU9_REG_USER_CTRL ] );
+    bad |= ( 20 != imu9.fifo_watermark );
+    c6dofimu9_fifo_config( &imu9, C6DOFIMU9_FIFO_WTM_MAX + 1 );
+    bad |= ( C6DOFIMU9_FIFO_WTM_MAX != imu9.fifo_watermark );
+    return bad;
+}
+
+// -------------------------------------------------------------------- ACCEL 13
+
+static uint8_t accel13_watermark_level ( void )
+{
+    return accel13_dev.regs[ ACCEL13_REG_FIFO_CTRL ] & 0x1F;
+}
+
+static void accel13_produce ( void )
+{
+    uint8_t *slot;
+    uint32_t n = produced++;
+
+    if ( ACCEL13_FCTRL_CONTINUOUS_MODE != ( accel13_dev.regs[ ACCEL13_REG_FIFO_CTRL ] & 0xE0 ) )
+    {
+        return;
+    }
+    if ( ACCEL13_DEPTH == accel13_dev.level )
+    {
+        accel13_dev.head = ( accel13_dev.head + 1 ) % ACCEL13_DEPTH;
+        accel13_dev.level--;
+        accel13_dev.ovr = 1;
+    }
+    slot = accel13_dev.fifo[ ( accel13_dev.head + accel13_dev.level++ ) % ACCEL13_DEPTH ];
+    for ( uint8_t cnt = 0; cnt < 3; cnt++ )
+    {
+        slot[ cnt * 2 ] = ( uint8_t ) ref_value( n, cnt );
+        slot[ cnt * 2 + 1 ] = ( uint8_t ) ( ( uint16_t ) ref_value( n, cnt ) >> 8 );
+    }
+}
+
+static uint8_t accel13_read_byte ( uint8_t reg )
+{
+    if ( ACCEL13_REG_FIFO_SAMPLES == reg )
+    {
+        uint8_t value = accel13_dev.level;
+
+        value |= ( accel13_watermark_level( ) && ( accel13_dev.level >= accel13_watermark_level( ) ) ) ? 0x80 : 0;
+        value |= accel13_dev.ovr ? 0x40 : 0;
+        return value;
+    }
+    if ( ACCEL13_REG_AXIS_X_LSB == reg )
+    {
+        if ( 0 == accel13_dev.level )
+        {
+            empty_pops++;
+            memset( accel13_dev.out, 0, sizeof( accel13_dev.out ) );
+        }
+        else
+        {
+            memcpy( accel13_dev.out, accel13_dev.fifo[ accel13_dev.head ], 6 );
+            accel13_dev.head = ( accel13_dev.head + 1 ) % ACCEL13_DEPTH;
+            accel13_dev.level--;
+            accel13_dev.ovr = 0;
+        }
+    }
+    if ( ( reg >= ACCEL13_REG_AXIS_X_LSB ) && ( reg <= ACCEL13_REG_AXIS_Z_MSB ) )
+    {
+        return accel13_dev.out[ reg - ACCEL13_REG_AXIS_X_LSB ];
+    }
+    return accel13_dev.regs[ reg & 0x3F ];
+}
+
+static void accel13_read ( uint8_t reg, uint8_t *data, size_t len )
+{
+    uint8_t inc = 0 != ( accel13_dev.regs[ ACCEL13_REG_CTRL_2 ] & ACCEL13_CTRL2_IF_ADD_INC_ENABLED );
+
+    if ( ACCEL13_REG_FIFO_SAMPLES == reg )
+    {
+        level_reads++;
+        expected_bursts += ( accel13_dev.level + ACCEL13_FIFO_BURST_SAMPLES - 1 ) / ACCEL13_FIFO_BURST_SAMPLES;
+    }
+    if ( ACCEL13_REG_AXIS_X_LSB == reg )
+    {
+        count_burst( len / 6, 6, len );
+    }
+    for ( size_t cnt = 0; cnt < len; cnt++ )
+    {
+        data[ cnt ] = accel13_read_byte( reg );
+        if ( inc )
+        {
+            // With the FIFO on the address rolls back from OUT_Z_H to OUT_X_L
+            reg = ( ACCEL13_REG_AXIS_Z_MSB == reg ) ? ACCEL13_REG_AXIS_X_LSB : ( uint8_t ) ( reg + 1 );
+        }
+    }
+}
+
+static void accel13_write ( uint8_t reg, const uint8_t *data, size_t len )
+{
+    for ( size_t cnt = 0; cnt < len; cnt++, reg++ )
+    {
+        accel13_dev.regs[ reg & 0x3F ] = data[ cnt ];
+    }
+}
+
+static uint8_t accel13_int1 ( void )
+{
+    return ( accel13_dev.regs[ ACCEL13_REG_CTRL_4_INT1 ] & ACCEL13_CTRL4_INT1_FTH_ENABLED ) &&
+           accel13_watermark_level( ) && ( accel13_dev.level >= accel13_watermark_level( ) );
+}
+
+static void accel13_open ( uint16_t ring_size )
+{
+    accel13_cfg_t cfg;
+
+    memset( &accel13_dev, 0, sizeof( accel13_dev ) );
+    // Reset value of CTRL2 with auto increment on, and a tap event routed to INT1 to keep
+    accel13_dev.regs[ ACCEL13_REG_CTRL_2 ] = ACCEL13_CTRL2_IF_ADD_INC_ENABLED;
+    accel13_dev.regs[ ACCEL13_REG_CTRL_4_INT1 ] = ACCEL13_CTRL4_INT1_TAP_ENABLED;
+    accel13_cfg_setup( &cfg );
+    cfg.int1 = ACCEL13_INT1_PIN;
+    accel13_init( &accel13, &cfg );
+    accel13_fifo_ring_init( &accel13_ring, accel13_buf, ring_size );
+}
+
+static void accel13_config ( uint16_t watermark )
+{
+    accel13_fifo_config( &accel13, ( uint8_t ) watermark );
+}
+
+static uint8_t accel13_watermark ( void )
+{
+    return accel13_get_interrupt( &accel13, ACCEL13_INT_PIN_INTERRUPT_1 );
+}
+
+static void accel13_drain ( void )
+{
+    accel13_fifo_read( &accel13, &accel13_ring );
+}
+
+static uint8_t accel13_pop ( int32_t *values )
+{
+    accel13_axis_t sample;
+
+    if ( !accel13_fifo_ring_pop( &accel13_ring, &sample ) )
+    {
+        return 0;
+    }
+    values[ 0 ] = sample.x;
+    values[ 1 ] = sample.y;
+    values[ 2 ] = sample.z;
+    return 1;
+}
+
+static uint8_t accel13_overflow ( void )
+{
+    return 0 != ( accel13_ring.status & ACCEL13_FSAMPLES_FIFO_OVR );
+}
+
+static uint16_t accel13_dropped ( void )
+{
+    return accel13_ring.dropped;
+}
+
+static uint8_t accel13_check_config ( void )
+{
+    uint8_t bad = 0;
+
+    accel13_fifo_config( &accel13, 20 );
+    bad |= ( ( ACCEL13_FCTRL_CONTINUOUS_MODE | 20 ) != accel13_dev.regs[ ACCEL13_REG_FIFO_CTRL ] );
+    bad |= ( ( ACCEL13_CTRL4_INT1_TAP_ENABLED | ACCEL13_CTRL4_INT1_FTH_ENABLED ) !=
+             accel13_dev.regs[ ACCEL13_REG_CTRL_4_INT1 ] );
+    accel13_fifo_config( &accel13, ACCEL13_FIFO_WTM_MAX + 1 );
+    bad |= ( ( ACCEL13_FCTRL_CONTINUOUS_MODE | ACCEL13_FIFO_WTM_MAX ) != accel13_dev.regs[ ACCEL13_REG_FIFO_CTRL ] );
+    return bad;
+}
+
+// -------------------------------------------------------------------- ACCEL 16
+
+static uint16_t accel16_watermark_level ( void )
+{
+    return accel16_dev.regs[ ACCEL16_REG_FIFO_SAMPLES ] |
+           ( ( accel16_dev.regs[ ACCEL16_REG_FIFO_CONTROL ] & 0x08 ) ? 0x100 : 0 );
+}
+
+static uint8_t accel16_status ( void )
+{
+    uint8_t status = 0;
+
+    status |= ( accel16_watermark_level( ) && ( accel16_dev.level >= accel16_watermark_level( ) ) ) ? 0x04 : 0;
+    status |= accel16_dev.overrun ? 0x08 : 0;
+    return status;
+}
+
+// Axis words of the samples in order, X, Y and Z, sign extended from bit 11 into bit 13
+static void accel16_push_words ( uint8_t words )
+{
+    for ( uint8_t cnt = 0; cnt < words; cnt++ )
+    {
+        uint8_t axis = accel16_dev.next_axis;
+        uint16_t word = ( ( uint16_t ) ref_value( produced, axis ) & 0x3FFF ) | ( ( uint16_t ) axis << 14 );
+
+        if ( 2 == axis )
+        {
+            produced++;
+        }
+        accel16_dev.next_axis = ( axis + 1 ) % 3;
+        if ( 0x02 != ( accel16_dev.regs[ ACCEL16_REG_FIFO_CONTROL ] & 0x03 ) )
+        {
+            continue;
+        }
+        if ( ACCEL16_DEPTH == accel16_dev.level )
+        {
+            accel16_dev.head = ( accel16_dev.head + 1 ) % ACCEL16_DEPTH;
+            accel16_dev.level--;
+            accel16_dev.overrun = 1;
+        }
+        accel16_dev.fifo[ ( accel16_dev.head + accel16_dev.level++ ) % ACCEL16_DEPTH ] = word;
+    }
+}
+
+static void accel16_produce ( void )
+{
+    accel16_push_words( 3 );
+}
+
+static uint8_t accel16_read_byte ( void )
+{
+    uint8_t value;
+
+    if ( ACCEL16_CMD_READ_FIFO == accel16_dev.cmd )
+    {
+        // Words come out low byte first, a word is popped on its low byte
+        if ( 0 == accel16_dev.frame_bytes++ % 2 )
+        {
+            if ( 0 == accel16_dev.level )
+            {
+                empty_pops++;
+                accel16_dev.out = 0;
+            }
+            else
+            {
+                accel16_dev.out = accel16_dev.fifo[ accel16_dev.head ];
+                accel16_dev.head = ( accel16_dev.head + 1 ) % ACCEL16_DEPTH;
+                accel16_dev.level--;
+            }
+            return ( uint8_t ) accel16_dev.out;
+        }
+        return ( uint8_t ) ( accel16_dev.out >> 8 );
+    }
+    switch ( accel16_dev.addr )
+    {
+        case ACCEL16_REG_STATUS:
+            value = accel16_status( );
+            accel16_dev.overrun = 0;
+            break;
+        case ACCEL16_REG_FIFO_ENTRIES_L:
+            value = ( uint8_t ) accel16_dev.level;
+            break;
+        case ACCEL16_REG_FIFO_ENTRIES_H:
+            value = ( uint8_t ) ( accel16_dev.level >> 8 );
+            break;
+        default:
+            value = accel16_dev.regs[ accel16_dev.addr & 0x3F ];
+            break;
+    }
+    accel16_dev.addr++;
+    return value;
+}
+
+static void accel16_spi_select ( pin_name_t cs, uint8_t selected )
+{
+    if ( ACCEL16_CS_PIN != cs )
+    {
+        return;
+    }
+    if ( !selected && accel16_dev.selected && ( ACCEL16_CMD_READ_FIFO == accel16_dev.cmd ) )
+    {
+        count_burst( accel16_dev.frame_bytes / 2, 2, accel16_dev.frame_bytes );
+    }
+    accel16_dev.selected = selected;
+    accel16_dev.header = 0;
+    accel16_dev.cmd = 0;
+    accel16_dev.frame_bytes = 0;
+}
+
+static err_t accel16_spi_write ( uint8_t *buffer, size_t size )
+{
+    for ( size_t cnt = 0; cnt < size; cnt++ )
+    {
+        if ( 0 == accel16_dev.header )
+        {
+            accel16_dev.cmd = buffer[ cnt ];
+            accel16_dev.header = ( ACCEL16_CMD_READ_FIFO == accel16_dev.cmd ) ? 2 : 1;
+        }
+        else if ( 1 == accel16_dev.header )
+        {
+            accel16_dev.addr = buffer[ cnt ];
+            accel16_dev.header = 2;
+            if ( ( ACCEL16_CMD_READ_REG == accel16_dev.cmd ) && ( ACCEL16_REG_STATUS == accel16_dev.addr ) )
+            {
+                level_reads++;
+                expected_bursts += ( accel16_dev.level + ACCEL16_FIFO_BURST_WORDS - 1 ) / ACCEL16_FIFO_BURST_WORDS;
+            }
+        }
+        else if ( ACCEL16_CMD_WRITE_REG == accel16_dev.cmd )
+        {
+            accel16_dev.regs[ accel16_dev.addr++ & 0x3F ] = buffer[ cnt ];
+        }
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+static err_t accel16_spi_read ( uint8_t *buffer, size_t size )
+{
+    for ( size_t cnt = 0; cnt < size; cnt++ )
+    {
+        buffer[ cnt ] = accel16_read_byte( );
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+static uint8_t accel16_int1 ( void )
+{
+    return ( accel16_dev.regs[ ACCEL16_REG_INTMAP1 ] & ACCEL16_INTMAP_FIFO_WATERMARK ) &&
+           ( accel16_status( ) & 0x04 );
+}
+
+static void accel16_open ( uint16_t ring_size )
+{
+    accel16_cfg_t cfg;
+
+    memset( &accel16_dev, 0, sizeof( accel16_dev ) );
+    // Data ready mapped to INT1, to keep
+    accel16_dev.regs[ ACCEL16_REG_INTMAP1 ] = 0x01;
+    accel16_cfg_setup( &cfg );
+    cfg.cs = ACCEL16_CS_PIN;
+    cfg.int1 = ACCEL16_INT1_PIN;
+    accel16_init( &accel16, &cfg );
+    accel16_filter_configuration( &accel16, ACCEL16_2G, ACCEL16_100HZ );
+    accel16_fifo_ring_init( &accel16_ring, accel16_buf, ring_size );
+}
+
+static void accel16_config ( uint16_t watermark )
+{
+    if ( ACCEL16_OK != accel16_fifo_config( &accel16, watermark ) )
+    {
+        printf( "FAIL: Accel 16 fifo_config returns an error\n" );
+        failures++;
+    }
+}
+
+static uint8_t accel16_watermark ( void )
+{
+    return accel16_get_interrupt_1( &accel16 );
+}
+
+static void accel16_drain ( void )
+{
+    if ( ACCEL16_OK != accel16_fifo_drain( &accel16, &accel16_ring ) )
+    {
+        printf( "FAIL: Accel 16 fifo_drain returns an error\n" );
+        failures++;
+    }
+}
+
+static uint8_t accel16_pop ( int32_t *values )
+{
+    accel16_axes_t sample;
+
+    if ( !accel16_fifo_ring_pop( &accel16_ring, &sample ) )
+    {
+        return 0;
+    }
+    values[ 0 ] = ( int32_t ) lroundf( sample.x * accel16.resolution );
+    values[ 1 ] = ( int32_t ) lroundf( sample.y * accel16.resolution );
+    values[ 2 ] = ( int32_t ) lroundf( sample.z * accel16.resolution );
+    return 1;
+}
+
+static uint8_t accel16_overflow ( void )
+{
+    return 0 != ( accel16_ring.status & ACCEL16_STATUS_FIFO_OVERRUN );
+}
+
+static uint16_t accel16_dropped ( void )
+{
+    return accel16_ring.dropped;
+}
+
+static uint8_t accel16_check_config ( void )
+{
+    uint8_t bad = 0;
+
+    accel16_fifo_config( &accel16, 20 );
+    bad |= ( ACCEL16_FIFO_CONTROL_STREAM != accel16_dev.regs[ ACCEL16_REG_FIFO_CONTROL ] );
+    bad |= ( 60 != accel16_dev.regs[ ACCEL16_REG_FIFO_SAMPLES ] );
+    bad |= ( ( 0x01 | ACCEL16_INTMAP_FIFO_WATERMARK ) != accel16_dev.regs[ ACCEL16_REG_INTMAP1 ] );
+    accel16_fifo_config( &accel16, 100 );
+    bad |= ( 300 != accel16_watermark_level( ) );
+    accel16_fifo_config( &accel16, ACCEL16_FIFO_WTM_MAX + 1 );
+    bad |= ( ( ACCEL16_FIFO_CONTROL_STREAM | ACCEL16_FIFO_CONTROL_AH ) != accel16_dev.regs[ ACCEL16_REG_FIFO_CONTROL ] );
+    bad |= ( ACCEL16_FIFO_WTM_MAX * 3 != accel16_watermark_level( ) );
+    return bad;
+}
+
+// ------------------------------------------------------------------------ BUS
+
+static err_t i2c_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                            uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    if ( IMU9_ADDRESS == address )
+    {
+        if ( read_len )
+        {
+            imu9_read( write_buf[ 0 ], read_buf, read_len );
+        }
+        else if ( write_len > 1 )
+        {
+            imu9_write( write_buf[ 0 ], &write_buf[ 1 ], write_len - 1 );
+        }
+    }
+    else if ( ACCEL13_ADDRESS == address )
+    {
+        if ( read_len )
+        {
+            accel13_read( write_buf[ 0 ], read_buf, read_len );
+        }
+        else if ( write_len > 1 )
+        {
+            accel13_write( write_buf[ 0 ], &write_buf[ 1 ], write_len - 1 );
+        }
+    }
+    return I2C_MASTER_SUCCESS;
+}
+
+static err_t spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    return accel16_spi_write( buffer, size );
+}
+
+static err_t spi_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    return accel16_spi_read( buffer, size );
+}
+
+static uint8_t gpio_read ( void *obj, pin_name_t pin )
+{
+    ( void ) obj;
+    if ( ACCEL13_INT1_PIN == pin )
+    {
+        return accel13_int1( );
+    }
+    if ( ACCEL16_INT1_PIN == pin )
+    {
+        return accel16_int1( );
+    }
+    return 0;
+}
+
+// --------------------------------------------------------------------- CHECKS
+
+typedef struct
+{
+    const char *name;
+    void ( *open )( uint16_t ring_size );
+    uint8_t ( *check_config )( void );
+    void ( *config )( uint16_t watermark );
+    void ( *produce )( void );
+    uint8_t ( *watermark )( void );
+    void ( *drain )( void );
+    uint8_t ( *pop )( int32_t *values );
+    uint8_t ( *overflow )( void );
+    uint16_t ( *dropped )( void );
+    uint8_t channels;
+    uint16_t watermark_level;   // Stream watermark, in samples
+    uint16_t depth;             // Samples kept by a full FIFO
+    uint16_t burst;             // Burst limit, in FIFO units
+} part_t;
+
+static const part_t parts[ ] =
+{
+    { "6DOF IMU 9", imu9_open, imu9_check_config, imu9_config, imu9_produce, imu9_watermark, imu9_drain,
+      imu9_pop, imu9_overflow, imu9_dropped, 7, 30, IMU9_FIFO_BYTES / IMU9_RECORD, C6DOFIMU9_FIFO_BURST_RECORDS },
+    { "Accel 13", accel13_open, accel13_check_config, accel13_config, accel13_produce, accel13_watermark,
+      accel13_drain, accel13_pop, accel13_overflow, accel13_dropped, 3, 24, ACCEL13_DEPTH, ACCEL13_FIFO_BURST_SAMPLES },
+    { "Accel 16", accel16_open, accel16_check_config, accel16_config, accel16_produce, accel16_watermark,
+      accel16_drain, accel16_pop, accel16_overflow, accel16_dropped, 3, 60, ACCEL16_DEPTH / 3, ACCEL16_FIFO_BURST_WORDS },
+};
+
+#define N_PARTS             ( sizeof( parts ) / sizeof( parts[ 0 ] ) )
+
+static void open_part ( const part_t *part, uint16_t ring_size )
+{
+    hal_sim_reset( );
+    hal_sim_i2c_transfer = i2c_transfer;
+    hal_sim_spi_select = accel16_spi_select;
+    hal_sim_spi_write = spi_write;
+    hal_sim_spi_read = spi_read;
+    hal_sim_gpio_read = gpio_read;
+    produced = 0;
+    part->open( ring_size );
+}
+
+// Drains once and counts the bus use that does not fit one level read and full bursts
+static uint8_t drain_once ( const part_t *part )
+{
+    level_reads = bursts = expected_bursts = max_burst = odd_bursts = empty_pops = 0;
+    part->drain( );
+    return ( 1 != level_reads ) || ( bursts != expected_bursts ) || ( max_burst > part->burst ) ||
+           odd_bursts || empty_pops;
+}
+
+// Pops the ring and compares against the samples from first on, returns the next one expected
+static uint32_t pop_all ( const part_t *part, uint32_t first, uint32_t *bad )
+{
+    int32_t values[ MAX_CHANNELS ];
+
+    while ( part->pop( values ) )
+    {
+        for ( uint8_t cnt = 0; cnt < part->channels; cnt++ )
+        {
+            if ( values[ cnt ] != ref_value( first, cnt ) )
+            {
+                if ( !*bad )
+                {
+                    printf( "FAIL: %s sample %u channel %u is %d, written as %d\n", part->name,
+                            ( unsigned ) first, cnt, ( int ) values[ cnt ], ref_value( first, cnt ) );
+                }
+                ( *bad )++;
+                break;
+            }
+        }
+        first++;
+    }
+    return first;
+}
+
+static void check_config ( const part_t *part )
+{
+    open_part( part, RING_SIZE );
+    if ( part->check_config( ) )
+    {
+        printf( "FAIL: %s FIFO configuration registers are wrong\n", part->name );
+        failures++;
+    }
+}
+
+static void check_stream ( const part_t *part )
+{
+    uint32_t next = 0;
+    uint32_t drains = 0;
+    uint32_t bad_bus = 0;
+    uint32_t bad = 0;
+    uint32_t overflows = 0;
+
+    open_part( part, RING_SIZE );
+    part->config( part->watermark_level );
+    lcg_state = 1u;
+    for ( uint32_t step = 0; step < STREAM_STEPS; step++ )
+    {
+        for ( uint8_t cnt = random_count( ); cnt > 0; cnt-- )
+        {
+            part->produce( );
+        }
+        if ( part->watermark( ) )
+        {
+            bad_bus += drain_once( part );
+            overflows += part->overflow( );
+            drains++;
+            next = pop_all( part, next, &bad );
+        }
+    }
+    bad_bus += drain_once( part );
+    next = pop_all( part, next, &bad );
+
+    printf( "%-11s %5u samples in %4u drains at a watermark of %u\n", part->name, ( unsigned ) next,
+            ( unsigned ) drains, part->watermark_level );
+    if ( bad )
+    {
+        printf( "FAIL: %s %u samples come out wrong\n", part->name, ( unsigned ) bad );
+        failures++;
+    }
+    if ( next != produced )
+    {
+        printf( "FAIL: %s %u samples come out of %u written\n", part->name, ( unsigned ) next,
+                ( unsigned ) produced );
+        failures++;
+    }
+    if ( ( drains < STREAM_STEPS * 2 / part->watermark_level / 2 ) || overflows )
+    {
+        printf( "FAIL: %s drains %u times with %u overflows\n", part->name, ( unsigned ) drains,
+                ( unsigned ) overflows );
+        failures++;
+    }
+    if ( bad_bus )
+    {
+        printf( "FAIL: %s %u drains do not read the level once and then use full bursts\n", part->name,
+                ( unsigned ) bad_bus );
+        failures++;
+    }
+}
+
+static void check_overflow ( const part_t *part )
+{
+    uint32_t total = part->depth + OVERFLOW_EXTRA;
+    uint32_t bad = 0;
+    uint32_t first;
+    uint32_t next;
+
+    open_part( part, SMALL_RING );
+    part->config( part->watermark_level );
+    for ( uint32_t cnt = 0; cnt < total; cnt++ )
+    {
+        part->produce( );
+    }
+    drain_once( part );
+
+    // The IAM-20680 keeps its oldest records, the others their newest samples
+    first = ( part->produce == imu9_produce ) ? ( part->depth - SMALL_RING ) : ( total - SMALL_RING );
+    next = pop_all( part, first, &bad );
+    if ( !part->overflow( ) )
+    {
+        printf( "FAIL: %s full FIFO is not reported\n", part->name );
+        failures++;
+    }
+    if ( ( next != first + SMALL_RING ) || ( part->dropped( ) != part->depth - SMALL_RING ) || bad )
+    {
+        printf( "FAIL: %s full FIFO leaves samples %u to %u with %u dropped, expected %u to %u with %u\n",
+                part->name, ( unsigned ) first, ( unsigned ) next, part->dropped( ), ( unsigned ) first,
+                ( unsigned ) ( first + SMALL_RING ), part->depth - SMALL_RING );
+        failures++;
+    }
+
+    // Samples written after the drain have to start on a record and sample boundary
+    first = produced;
+    for ( uint32_t cnt = 0; cnt < 5; cnt++ )
+    {
+        part->produce( );
+    }
+    bad = 0;
+    drain_once( part );
+    next = pop_all( part, first, &bad );
+    if ( ( next != first + 5 ) || bad )
+    {
+        printf( "FAIL: %s samples after a full FIFO come out misaligned\n", part->name );
+        failures++;
+    }
+}
+
+static void check_split_sample ( void )
+{
+    uint32_t bad = 0;
+    uint32_t next;
+
+    open_part( &parts[ 2 ], RING_SIZE );
+    accel16_config( 60 );
+    accel16_produce( );
+    accel16_push_words( 1 );
+    drain_once( &parts[ 2 ] );
+    next = pop_all( &parts[ 2 ], 0, &bad );
+    accel16_push_words( 2 );
+    accel16_produce( );
+    drain_once( &parts[ 2 ] );
+    next = pop_all( &parts[ 2 ], next, &bad );
+    if ( ( 3 != next ) || bad )
+    {
+        printf( "FAIL: Accel 16 sample split over two drains comes out %s\n", bad ? "wrong" : "lost" );
+        failures++;
+    }
+}
+
+int main ( void )
+{
+    for ( uint32_t cnt = 0; cnt < N_PARTS; cnt++ )
+    {
+        check_config( &parts[ cnt ] );
+        check_stream( &parts[ cnt ] );
+        check_overflow( &parts[ cnt ] );
+    }
+    check_split_sample( );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
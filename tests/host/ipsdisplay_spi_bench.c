@@ -0,0 +1,470 @@
+/*
+ * IPS Display SPI batching: chip select frames per fill and per string.
+ *
+ * The IPS Display driver is built by default, IPS Display 2 with
+ * IPSDISPLAY2_BUILD and IPS Display 3 with IPSDISPLAY3_BUILD. They run
+ * against a panel model on the GPIO and SPI hooks that follows the chip
+ * select and data/command pins, decodes CASET, RASET and RAMWR and writes
+ * the RGB565 pixel stream into its frame memory. A frame is one chip
+ * select assertion. Bytes sent with chip select released are an error.
+ *
+ * Screen fills, clipped rectangles, rectangle outlines, horizontal lines
+ * and transparent and opaque strings have to leave exactly the expected
+ * pixels in the frame memory, and their frames are counted. A fill or a
+ * line has to be one window, a transparent glyph one window per run of
+ * set pixels on each glyph row and an opaque glyph one window per cell.
+ * The same pixels drawn one at a time with draw_pixel, which is how the
+ * drivers drew before, are counted for comparison.
+ *
+ * A framebuffer string has to reach the panel as one window per dirty
+ * rectangle, redrawing the same text must leave nothing to flush and
+ * changing one digit must only flush pixels of that digit's cell.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_sim.h"
+
+#if defined( IPSDISPLAY2_BUILD )
+#include "ipsdisplay2.h"
+#include "ipsdisplay2_resources.h"
+#define DRIVER_NAME             "IPS Display 2"
+#define IPS( name )             ipsdisplay2_##name
+#define IPS_C( name )           IPSDISPLAY2_##name
+#elif defined( IPSDISPLAY3_BUILD )
+#include "ipsdisplay3.h"
+#include "ipsdisplay3_resources.h"
+#define DRIVER_NAME             "IPS Display 3"
+#define IPS( name )             ipsdisplay3_##name
+#define IPS_C( name )           IPSDISPLAY3_##name
+#else
+#include "ipsdisplay.h"
+#include "ipsdisplay_resources.h"
+#define DRIVER_NAME             "IPS Display"
+#define IPS( name )             ipsdisplay_##name
+#define IPS_C( name )           IPSDISPLAY_##name
+#endif
+
+#define CS_PIN              1
+#define DC_PIN              2
+#define RST_PIN             3
+#define BCK_PIN             4
+#define VRAM_SIZE           320
+#define WIDTH               ( IPS_C( POS_WIDTH_MAX ) + 1 )
+#define HEIGHT              ( IPS_C( POS_HEIGHT_MAX ) + 1 )
+#define BACKGROUND          0x0000
+#define FRAMES_PER_WINDOW   5
+#define FB_X                2
+#define FB_Y                60
+#define FB_WIDTH            60
+#define FB_HEIGHT           20
+#define FB_BACKGROUND       0x39E7
+
+typedef IPS( t ) ips_t;
+typedef IPS( point_t ) ips_point_t;
+typedef IPS( fb_t ) ips_fb_t;
+
+static uint16_t vram[ VRAM_SIZE ][ VRAM_SIZE ];
+static uint16_t expected[ HEIGHT ][ WIDTH ];
+static uint16_t fb_buf[ FB_WIDTH * FB_HEIGHT ];
+static uint8_t cs_level = 1;
+static uint8_t dc_level;
+static uint8_t cmd;
+static uint8_t param[ 4 ];
+static uint8_t param_cnt;
+static uint16_t x_start, x_end, y_start, y_end;
+static uint16_t x_pos, y_pos;
+static uint8_t pixel_hi;
+static uint8_t pixel_half;
+static uint32_t frames;
+static uint32_t spi_writes;
+static uint32_t stray_bytes;
+
+static int failures;
+
+// ---------------------------------------------------------------------- PANEL
+
+static void panel_gpio_write ( void *obj, pin_name_t pin, uint8_t state )
+{
+    ( void ) obj;
+    if ( CS_PIN == pin )
+    {
+        if ( cs_level && !state )
+        {
+            frames++;
+        }
+        cs_level = state;
+    }
+    else if ( DC_PIN == pin )
+    {
+        dc_level = state;
+    }
+}
+
+static void panel_pixel ( uint8_t data )
+{
+    if ( !pixel_half )
+    {
+        pixel_hi = data;
+        pixel_half = 1;
+        return;
+    }
+    pixel_half = 0;
+    if ( ( y_pos <= y_end ) && ( x_pos < VRAM_SIZE ) && ( y_pos < VRAM_SIZE ) )
+    {
+        vram[ y_pos ][ x_pos ] = ( uint16_t ) ( ( pixel_hi << 8 ) | data );
+    }
+    if ( ++x_pos > x_end )
+    {
+        x_pos = x_start;
+        y_pos++;
+    }
+}
+
+static err_t panel_spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    spi_writes++;
+    if ( cs_level )
+    {
+        stray_bytes += ( uint32_t ) size;
+        return SPI_MASTER_SUCCESS;
+    }
+    for ( size_t cnt = 0; cnt < size; cnt++ )
+    {
+        if ( !dc_level )
+        {
+            cmd = buffer[ cnt ];
+            param_cnt = 0;
+            pixel_half = 0;
+            if ( IPS_C( CMD_RAMWR ) == cmd )
+            {
+                x_pos = x_start;
+                y_pos = y_start;
+            }
+            continue;
+        }
+        if ( IPS_C( CMD_RAMWR ) == cmd )
+        {
+            panel_pixel( buffer[ cnt ] );
+        }
+        else if ( ( IPS_C( CMD_CASET ) == cmd ) || ( IPS_C( CMD_RASET ) == cmd ) )
+        {
+            if ( param_cnt < 4 )
+            {
+                param[ param_cnt++ ] = buffer[ cnt ];
+            }
+            if ( 4 == param_cnt )
+            {
+                uint16_t first = ( uint16_t ) ( ( param[ 0 ] << 8 ) | param[ 1 ] );
+                uint16_t last = ( uint16_t ) ( ( param[ 2 ] << 8 ) | param[ 3 ] );
+                if ( IPS_C( CMD_CASET ) == cmd )
+                {
+                    x_start = first;
+                    x_end = last;
+                }
+                else
+                {
+                    y_start = first;
+                    y_end = last;
+                }
+            }
+        }
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+// ----------------------------------------------------------------------- HOST
+
+static ips_point_t point ( uint16_t x, uint16_t y )
+{
+    ips_point_t pt;
+    pt.x = x;
+    pt.y = y;
+    return pt;
+}
+
+static void clear ( ips_t *ctx )
+{
+    IPS( fill_screen )( ctx, BACKGROUND );
+    for ( uint16_t y = 0; y < HEIGHT; y++ )
+    {
+        for ( uint16_t x = 0; x < WIDTH; x++ )
+        {
+            expected[ y ][ x ] = BACKGROUND;
+        }
+    }
+    frames = 0;
+    spi_writes = 0;
+    stray_bytes = 0;
+}
+
+static void expect_rect ( uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color )
+{
+    for ( uint16_t y = y0; ( y <= y1 ) && ( y < HEIGHT ); y++ )
+    {
+        for ( uint16_t x = x0; ( x <= x1 ) && ( x < WIDTH ); x++ )
+        {
+            expected[ y ][ x ] = color;
+        }
+    }
+}
+
+static uint8_t glyph_bit ( ips_t *ctx, uint8_t ch, uint8_t row, uint8_t col )
+{
+    uint16_t row_bytes = ( ( ctx->font.width - 1 ) / 8 ) + 1;
+    uint16_t pos = ( ch - IPS_C( FONT_ASCII_OFFSET ) ) * ctx->font.height * row_bytes + row * row_bytes;
+    return ( ctx->font.font_buf[ pos + col / 8 ] & ( 0x80 >> ( col % 8 ) ) ) ? 1 : 0;
+}
+
+// Renders the string into the expected image and returns the number of set pixel runs
+static uint32_t expect_string ( ips_t *ctx, uint16_t x, uint16_t y, const char *text, uint16_t color,
+                                const uint16_t *bg_color )
+{
+    uint32_t runs = 0;
+
+    for ( const char *ch = text; *ch; ch++ )
+    {
+        for ( uint8_t row = 0; row < ctx->font.height; row++ )
+        {
+            uint8_t prev = 0;
+            for ( uint8_t col = 0; col < ctx->font.width; col++ )
+            {
+                uint8_t bit = glyph_bit( ctx, ( uint8_t ) *ch, row, col );
+                if ( bit )
+                {
+                    expected[ y + row ][ x + col ] = color;
+                    runs += !prev;
+                }
+                else if ( NULL != bg_color )
+                {
+                    expected[ y + row ][ x + col ] = *bg_color;
+                }
+                prev = bit;
+            }
+        }
+        x += ctx->font.width + IPS_C( FONT_TEXT_SPACE );
+    }
+    return runs;
+}
+
+static uint32_t set_pixels ( void )
+{
+    uint32_t count = 0;
+    for ( uint16_t y = 0; y < HEIGHT; y++ )
+    {
+        for ( uint16_t x = 0; x < WIDTH; x++ )
+        {
+            count += ( BACKGROUND != expected[ y ][ x ] );
+        }
+    }
+    return count;
+}
+
+// Frames and SPI writes of one draw_pixel call, the cost per pixel of the drivers before
+static void pixel_cost ( ips_t *ctx, uint32_t *pixel_frames, uint32_t *pixel_writes )
+{
+    frames = 0;
+    spi_writes = 0;
+    IPS( draw_pixel )( ctx, point( 0, 0 ), BACKGROUND );
+    *pixel_frames = frames;
+    *pixel_writes = spi_writes;
+}
+
+// --------------------------------------------------------------------- CHECKS
+
+static void check_image ( const char *what )
+{
+    uint32_t wrong = 0;
+    uint16_t x_off = IPS_C( POS_OFFSET_LEFT );
+    uint16_t y_off = IPS_C( POS_OFFSET_UP );
+
+    for ( uint16_t y = 0; y < HEIGHT; y++ )
+    {
+        for ( uint16_t x = 0; x < WIDTH; x++ )
+        {
+            if ( vram[ y + y_off ][ x + x_off ] != expected[ y ][ x ] )
+            {
+                if ( !wrong )
+                {
+                    printf( "FAIL: %s leaves pixel %u,%u at 0x%04X, expected 0x%04X\n", what, x, y,
+                            vram[ y + y_off ][ x + x_off ], expected[ y ][ x ] );
+                }
+                wrong++;
+            }
+        }
+    }
+    if ( wrong )
+    {
+        failures++;
+    }
+    if ( stray_bytes )
+    {
+        printf( "FAIL: %s sends %u bytes with chip select released\n", what, ( unsigned ) stray_bytes );
+        failures++;
+    }
+}
+
+static void report ( ips_t *ctx, const char *what, uint32_t max_frames, uint32_t pixels )
+{
+    uint32_t pixel_frames;
+    uint32_t pixel_writes;
+    uint32_t op_frames = frames;
+    uint32_t op_writes = spi_writes;
+
+    check_image( what );
+    pixel_cost( ctx, &pixel_frames, &pixel_writes );
+    printf( "%-13s %-28s %5u frames %6u SPI writes, pixel by pixel %6u frames %6u writes\n",
+            DRIVER_NAME, what, ( unsigned ) op_frames, ( unsigned ) op_writes,
+            ( unsigned ) ( pixels * pixel_frames ), ( unsigned ) ( pixels * pixel_writes ) );
+    if ( op_frames != max_frames )
+    {
+        printf( "FAIL: %s takes %u chip select frames, expected %u\n", what, ( unsigned ) op_frames,
+                ( unsigned ) max_frames );
+        failures++;
+    }
+}
+
+static void check_fill ( ips_t *ctx )
+{
+    clear( ctx );
+    IPS( fill_screen )( ctx, 0xF800 );
+    expect_rect( 0, 0, WIDTH - 1, HEIGHT - 1, 0xF800 );
+    report( ctx, "fill screen", FRAMES_PER_WINDOW + 1, WIDTH * HEIGHT );
+
+    // Partly off the panel, clipped to it
+    clear( ctx );
+    IPS( fill_rectangle )( ctx, point( WIDTH - 20, HEIGHT - 10 ), point( WIDTH + 30, HEIGHT + 5 ), 0x07E0 );
+    expect_rect( WIDTH - 20, HEIGHT - 10, WIDTH - 1, HEIGHT - 1, 0x07E0 );
+    report( ctx, "clipped rectangle", FRAMES_PER_WINDOW + 1, set_pixels( ) );
+
+    clear( ctx );
+    IPS( draw_rectangle )( ctx, point( 10, 20 ), point( 100, 90 ), 0x001F );
+    expect_rect( 10, 20, 100, 20, 0x001F );
+    expect_rect( 10, 90, 100, 90, 0x001F );
+    expect_rect( 10, 20, 10, 90, 0x001F );
+    expect_rect( 100, 20, 100, 90, 0x001F );
+    report( ctx, "rectangle outline", 4 * ( FRAMES_PER_WINDOW + 1 ), set_pixels( ) );
+
+    clear( ctx );
+    IPS( draw_line )( ctx, point( 5, 40 ), point( WIDTH - 5, 40 ), 0xFFFF );
+    expect_rect( 5, 40, WIDTH - 5, 40, 0xFFFF );
+    report( ctx, "horizontal line", FRAMES_PER_WINDOW + 1, set_pixels( ) );
+}
+
+static void check_strings ( ips_t *ctx )
+{
+    static const char text[ ] = "Hi 42!";
+    uint16_t bg_color = 0x39E7;
+    uint32_t runs;
+
+    clear( ctx );
+    runs = expect_string( ctx, 2, 30, text, 0xFFE0, NULL );
+    IPS( write_string )( ctx, point( 2, 30 ), ( uint8_t * ) text, 0xFFE0 );
+    report( ctx, "transparent string", runs * ( FRAMES_PER_WINDOW + 1 ), set_pixels( ) );
+
+    clear( ctx );
+    expect_string( ctx, 2, 30, text, 0xFFE0, &bg_color );
+    IPS( write_string_bg )( ctx, point( 2, 30 ), ( uint8_t * ) text, 0xFFE0, bg_color );
+    report( ctx, "opaque string", ( sizeof( text ) - 1 ) * ( FRAMES_PER_WINDOW + 1 ), set_pixels( ) );
+}
+
+// Flushes the framebuffer and checks one window per dirty rectangle
+static void check_flush ( ips_t *ctx, ips_fb_t *fb, const char *what )
+{
+    uint8_t dirty = fb->num_dirty;
+
+    frames = 0;
+    spi_writes = 0;
+    if ( IPS( fb_flush )( ctx, fb ) || fb->num_dirty )
+    {
+        printf( "FAIL: %s flush leaves %u dirty rectangles\n", what, fb->num_dirty );
+        failures++;
+    }
+    check_image( what );
+    printf( "%-13s %-28s %5u frames %6u SPI writes, %u dirty rectangles\n",
+            DRIVER_NAME, what, ( unsigned ) frames, ( unsigned ) spi_writes, dirty );
+    if ( frames != dirty * ( FRAMES_PER_WINDOW + 1 ) )
+    {
+        printf( "FAIL: %s takes %u chip select frames, expected %u\n", what, ( unsigned ) frames,
+                ( unsigned ) ( dirty * ( FRAMES_PER_WINDOW + 1 ) ) );
+        failures++;
+    }
+}
+
+static void check_framebuffer ( ips_t *ctx )
+{
+    ips_fb_t fb;
+    ips_point_t text_pt = point( FB_X + 2, FB_Y + 2 );
+    uint16_t bg_color = FB_BACKGROUND;
+    uint16_t cell_x = FB_X + 2 + ctx->font.width + IPS_C( FONT_TEXT_SPACE );
+    uint16_t first_x = 0xFFFF;
+    uint16_t last_x = 0;
+
+    clear( ctx );
+    IPS( fb_init )( &fb, fb_buf, point( FB_X, FB_Y ), FB_WIDTH, FB_HEIGHT, FB_BACKGROUND );
+    expect_rect( FB_X, FB_Y, FB_X + FB_WIDTH - 1, FB_Y + FB_HEIGHT - 1, FB_BACKGROUND );
+    check_flush( ctx, &fb, "framebuffer init" );
+
+    IPS( fb_write_string )( ctx, &fb, text_pt, ( uint8_t * ) "42", 0xFFE0, FB_BACKGROUND );
+    expect_string( ctx, text_pt.x, text_pt.y, "42", 0xFFE0, &bg_color );
+    if ( !fb.num_dirty )
+    {
+        printf( "FAIL: framebuffer string marks nothing dirty\n" );
+        failures++;
+    }
+    check_flush( ctx, &fb, "framebuffer string" );
+
+    IPS( fb_write_string )( ctx, &fb, text_pt, ( uint8_t * ) "42", 0xFFE0, FB_BACKGROUND );
+    if ( fb.num_dirty )
+    {
+        printf( "FAIL: redrawing the same string marks %u rectangles dirty\n", fb.num_dirty );
+        failures++;
+    }
+
+    IPS( fb_write_string )( ctx, &fb, text_pt, ( uint8_t * ) "43", 0xFFE0, FB_BACKGROUND );
+    expect_string( ctx, text_pt.x, text_pt.y, "43", 0xFFE0, &bg_color );
+    for ( uint8_t cnt = 0; cnt < fb.num_dirty; cnt++ )
+    {
+        first_x = ( fb.dirty[ cnt ].x_start < first_x ) ? fb.dirty[ cnt ].x_start : first_x;
+        last_x = ( fb.dirty[ cnt ].x_end > last_x ) ? fb.dirty[ cnt ].x_end : last_x;
+    }
+    if ( !fb.num_dirty || ( first_x < cell_x ) || ( last_x >= ( cell_x + ctx->font.width ) ) )
+    {
+        printf( "FAIL: changing one digit marks columns %u..%u dirty, expected within %u..%u\n",
+                first_x, last_x, cell_x, cell_x + ctx->font.width - 1 );
+        failures++;
+    }
+    check_flush( ctx, &fb, "framebuffer digit change" );
+}
+
+int main ( void )
+{
+    IPS( cfg_t ) cfg;
+    ips_t ctx;
+
+    hal_sim_reset( );
+    hal_sim_gpio_write = panel_gpio_write;
+    hal_sim_spi_write = panel_spi_write;
+    IPS( cfg_setup )( &cfg );
+    cfg.cs = CS_PIN;
+    cfg.dc = DC_PIN;
+    cfg.rst = RST_PIN;
+#if defined( IPSDISPLAY2_BUILD ) || defined( IPSDISPLAY3_BUILD )
+    cfg.bck = BCK_PIN;
+#endif
+    if ( IPS( init )( &ctx, &cfg ) || IPS( default_cfg )( &ctx ) )
+    {
+        printf( "FAIL: init\n" );
+        return EXIT_FAILURE;
+    }
+    IPS( set_rotation )( &ctx, IPS_C( ROTATION_VERTICAL_0 ) );
+    IPS( set_font )( &ctx, IPS_C( FONT_8X16 ) );
+
+    check_fill( &ctx );
+    check_strings( &ctx );
+    check_framebuffer( &ctx );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,273 @@
+/*
+ * IR Grid 3 object temperature: fast single precision path against the reference.
+ *
+ * An EEPROM image in the MLX90640 layout is built around the calibration
+ * example of the sensor datasheet, with per pixel offset, sensitivity and
+ * Kta words and row and column corrections drawn from a fixed seed, and
+ * is passed through irgrid3_extract_parameters. Frames cover both sub
+ * pages, chess and interleaved readout, ambient temperatures from about
+ * -3 to 59 degrees Celsius, two supply voltages and a reflected temperature
+ * different from the ambient one. The pixels of each frame sweep the raw
+ * range so that every frame spans the -40 to 300 degrees Celsius object
+ * range of the irgrid3_calculate_temp_obj_fast documentation.
+ *
+ * On every pixel of the sub page of a frame whose reference result lies
+ * in that range, irgrid3_calculate_temp_obj_fast has to stay within
+ * 0.01 degrees Celsius of irgrid3_calculate_temp_obj, pixels of the other
+ * sub page have to be left untouched, and the whole range has to be
+ * covered. The EEPROM is built once calibrated in chess mode and once in
+ * interleaved mode, so each readout mode also runs the interleave and
+ * chess corrections applied outside the calibration mode. Both paths are
+ * then timed on the same frame.
+ */
+#include "irgrid3.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define EEPROM_WORDS        832
+#define FRAME_WORDS         834
+#define PIXELS              768
+#define TOLERANCE_C         0.01f
+#define RANGE_LOW_C         -40.0f
+#define RANGE_HIGH_C        300.0f
+#define RAW_LOW             -1500
+#define RAW_HIGH            3000
+#define UNTOUCHED           -999.0f
+#define BENCH_ROUNDS        200
+
+static irgrid3_t ctx;
+static uint16_t eeprom[ EEPROM_WORDS ];
+static uint16_t frame[ FRAME_WORDS ];
+static float temp_ref[ PIXELS ];
+static float temp_fast[ PIXELS ];
+static uint32_t lcg_state;
+
+static int failures;
+
+// ------------------------------------------------------------------- EEPROM
+
+static uint16_t random_bits ( uint8_t bits )
+{
+    lcg_state = lcg_state * 1103515245u + 12345u;
+    return ( uint16_t ) ( ( lcg_state >> 12 ) & ( ( 1u << bits ) - 1 ) );
+}
+
+// Small signed nibbles packed four to a word, as the row and column corrections
+static uint16_t random_nibbles ( void )
+{
+    uint16_t word = 0;
+    for ( uint8_t cnt = 0; cnt < 4; cnt++ )
+    {
+        word |= ( uint16_t ) ( ( ( random_bits( 3 ) + 14 ) & 0x0F ) << ( cnt * 4 ) );
+    }
+    return word;
+}
+
+static void make_eeprom ( uint8_t calibration_bit )
+{
+    memset( eeprom, 0, sizeof( eeprom ) );
+    lcg_state = 90640u;
+
+    eeprom[ 10 ] = calibration_bit ? 0x0800 : 0x0000;
+    eeprom[ 16 ] = 0x4210;              // alpha PTAT 9, occ row scale 2, column 1, remnant 0
+    eeprom[ 17 ] = ( uint16_t ) -62;    // offset reference
+    for ( uint8_t cnt = 0; cnt < 6; cnt++ )
+    {
+        eeprom[ 18 + cnt ] = random_nibbles( );
+        eeprom[ 34 + cnt ] = random_nibbles( );
+    }
+    for ( uint8_t cnt = 0; cnt < 8; cnt++ )
+    {
+        eeprom[ 24 + cnt ] = random_nibbles( );
+        eeprom[ 40 + cnt ] = random_nibbles( );
+    }
+    eeprom[ 32 ] = 0x79A6;              // alpha scale 37, acc row scale 9, column 10, remnant 6
+    eeprom[ 33 ] = 0x2F44;              // alpha reference
+    eeprom[ 48 ] = 0x18EF;              // gain
+    eeprom[ 49 ] = 0x2FF1;              // VPTAT25
+    eeprom[ 50 ] = 0x5952;              // KvPTAT 0.0054, KtPTAT 42.25
+    eeprom[ 51 ] = 0x9D68;              // Kvdd -3168, Vdd25 -13056
+    eeprom[ 52 ] = 0x2233;              // Kv
+    eeprom[ 53 ] = 0x2A5D;              // interleave and chess corrections
+    eeprom[ 54 ] = 0x6D67;              // Kta of odd and even rows and columns
+    eeprom[ 55 ] = 0x6A64;
+    eeprom[ 56 ] = 0x2363;              // resolution 2, Kv scale 3, Kta scales 14 and 3
+    eeprom[ 57 ] = 0x04A4;              // CP alpha
+    eeprom[ 58 ] = 0x07C4;              // CP offsets
+    eeprom[ 59 ] = 0x0A4B;              // CP Kv and Kta
+    eeprom[ 60 ] = 0xF020;              // KsTa -0.002, TGC 1
+    eeprom[ 61 ] = 0x9797;              // KsTo of ranges 0 and 1
+    eeprom[ 62 ] = 0x9496;              // KsTo of ranges 2 and 3
+    eeprom[ 63 ] = 0x2889;              // corner temperatures 160 and 320 degrees Celsius
+    for ( uint16_t px = 0; px < PIXELS; px++ )
+    {
+        // offset, sensitivity and Kta of the pixel, no outlier flag
+        eeprom[ 64 + px ] = ( uint16_t ) ( ( random_bits( 6 ) << 10 ) | ( random_bits( 6 ) << 4 ) |
+                                           ( random_bits( 3 ) << 1 ) );
+        if ( 0 == eeprom[ 64 + px ] )
+        {
+            eeprom[ 64 + px ] = 0x0400;
+        }
+    }
+}
+
+// -------------------------------------------------------------------- FRAMES
+
+static void make_frame ( uint16_t ptat, int16_t vdd, uint8_t chess, uint8_t sub_page, uint8_t shift )
+{
+    for ( uint16_t px = 0; px < PIXELS; px++ )
+    {
+        // sweep the raw range, rotated by the frame so every pixel sees every level
+        uint16_t step = ( uint16_t ) ( ( px * 7 + shift * 13 ) % PIXELS );
+        frame[ px ] = ( uint16_t ) ( int16_t ) ( RAW_LOW + ( int32_t ) step * ( RAW_HIGH - RAW_LOW ) / ( PIXELS - 1 ) );
+    }
+    frame[ 768 ] = 19442;               // PTAT art reference
+    frame[ 776 ] = ( uint16_t ) -75;    // CP of sub page 0
+    frame[ 778 ] = 6383;                // gain
+    frame[ 800 ] = ptat;
+    frame[ 808 ] = ( uint16_t ) -76;    // CP of sub page 1
+    frame[ 810 ] = ( uint16_t ) vdd;
+    frame[ 832 ] = ( uint16_t ) ( 0x0800 | ( chess ? 0x1000 : 0x0000 ) );
+    frame[ 833 ] = sub_page;
+}
+
+// -------------------------------------------------------------------- CHECKS
+
+static void check_eeprom ( const char *what, uint8_t calibration_bit )
+{
+    static const uint16_t ptat[ ] = { 1330, 1480, 1640, 1790, 1920 };
+    static const int16_t vdd[ ] = { -13115, -12900 };
+    float max_err = 0;
+    float min_c = 1000;
+    float max_c = -1000;
+    float min_ta = 1000;
+    float max_ta = -1000;
+    uint32_t compared = 0;
+    uint32_t bad = 0;
+    uint32_t touched = 0;
+    uint8_t shift = 0;
+
+    make_eeprom( calibration_bit );
+    if ( irgrid3_extract_parameters( &ctx, eeprom ) )
+    {
+        printf( "FAIL: %s EEPROM image is refused\n", what );
+        failures++;
+        return;
+    }
+
+    for ( uint8_t p = 0; p < sizeof( ptat ) / sizeof( ptat[ 0 ] ); p++ )
+    {
+        for ( uint8_t v = 0; v < sizeof( vdd ) / sizeof( vdd[ 0 ] ); v++ )
+        {
+            for ( uint8_t chess = 0; chess < 2; chess++ )
+            {
+                for ( uint8_t sub_page = 0; sub_page < 2; sub_page++ )
+                {
+                    float ta;
+                    make_frame( ptat[ p ], vdd[ v ], chess, sub_page, shift++ );
+                    ta = irgrid3_get_temp_ambient( &ctx, frame );
+                    min_ta = ( ta < min_ta ) ? ta : min_ta;
+                    max_ta = ( ta > max_ta ) ? ta : max_ta;
+                    for ( uint16_t px = 0; px < PIXELS; px++ )
+                    {
+                        temp_ref[ px ] = UNTOUCHED;
+                        temp_fast[ px ] = UNTOUCHED;
+                    }
+                    // reflected temperature 8 degrees below the ambient one
+                    irgrid3_calculate_temp_obj( &ctx, frame, ta - 8, temp_ref );
+                    irgrid3_calculate_temp_obj_fast( &ctx, frame, ta - 8, temp_fast );
+
+                    for ( uint16_t px = 0; px < PIXELS; px++ )
+                    {
+                        float err;
+                        if ( UNTOUCHED == temp_ref[ px ] )
+                        {
+                            touched += ( UNTOUCHED != temp_fast[ px ] );
+                            continue;
+                        }
+                        // raw levels below the scene floor give no real root in the reference
+                        if ( !( ( temp_ref[ px ] >= RANGE_LOW_C ) && ( temp_ref[ px ] <= RANGE_HIGH_C ) ) )
+                        {
+                            continue;
+                        }
+                        err = fabsf( temp_fast[ px ] - temp_ref[ px ] );
+                        if ( !( err <= TOLERANCE_C ) )
+                        {
+                            if ( !bad )
+                            {
+                                printf( "FAIL: %s Ta %.1f pixel %u is %.4f, reference %.4f\n", what, ta, px,
+                                        temp_fast[ px ], temp_ref[ px ] );
+                            }
+                            bad++;
+                        }
+                        max_err = ( err > max_err ) ? err : max_err;
+                        min_c = ( temp_ref[ px ] < min_c ) ? temp_ref[ px ] : min_c;
+                        max_c = ( temp_ref[ px ] > max_c ) ? temp_ref[ px ] : max_c;
+                        compared++;
+                    }
+                }
+            }
+        }
+    }
+
+    printf( "%-15s Ta %.1f to %.1f C, %6u pixels from %7.2f to %6.2f C, max difference %.5f C\n", what,
+            min_ta, max_ta, ( unsigned ) compared, min_c, max_c, max_err );
+    if ( bad )
+    {
+        printf( "FAIL: %s %u pixels are more than %.2f C off the reference\n", what, ( unsigned ) bad,
+                TOLERANCE_C );
+        failures++;
+    }
+    if ( touched )
+    {
+        printf( "FAIL: %s fast path writes %u pixels of the other sub page\n", what, ( unsigned ) touched );
+        failures++;
+    }
+    if ( ( min_c > ( RANGE_LOW_C + 5 ) ) || ( max_c < ( RANGE_HIGH_C - 5 ) ) )
+    {
+        printf( "FAIL: %s frames only cover %.1f to %.1f C\n", what, min_c, max_c );
+        failures++;
+    }
+}
+
+// --------------------------------------------------------------------- BENCH
+
+static double time_path ( void ( *calc )( irgrid3_t *, uint16_t *, float, float * ) )
+{
+    clock_t start;
+
+    make_frame( 1711, -13115, 1, 0, 0 );
+    start = clock( );
+    for ( uint32_t round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        calc( &ctx, frame, 30.0f, temp_ref );
+    }
+    return ( double ) ( clock( ) - start ) / CLOCKS_PER_SEC;
+}
+
+static void bench ( void )
+{
+    double ref_s;
+    double fast_s;
+
+    make_eeprom( 0 );
+    irgrid3_extract_parameters( &ctx, eeprom );
+    ref_s = time_path( irgrid3_calculate_temp_obj );
+    fast_s = time_path( irgrid3_calculate_temp_obj_fast );
+    printf( "reference %.1f us per sub page, fast %.1f us per sub page, %.1fx\n",
+            ref_s * 1e6 / BENCH_ROUNDS, fast_s * 1e6 / BENCH_ROUNDS, fast_s > 0 ? ref_s / fast_s : 0 );
+}
+
+int main ( void )
+{
+    check_eeprom( "chess cal", 0 );
+    check_eeprom( "interleaved cal", 1 );
+    bench( );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,586 @@
+/*
+ * Load cell background acquisition: ring buffer, running filters and
+ * readout cost.
+ *
+ * Load Cell runs against an HX711 model converting at 80 SPS on its own
+ * time base, with DOUT low while a conversion waits to be clocked out. The
+ * stream is polled from a main loop and every captured sample has to be
+ * the next conversion, none lost and none read twice. The blocking
+ * loadcell_get_weight is timed against the same model for contrast.
+ *
+ * Load Cell 2 to Load Cell 8 run against a generic model that presents
+ * either a fresh conversion or nothing new on the ready signal of each
+ * driver, and for Load Cell 4, 5 and 8 also a stale or error status with
+ * the ready signal asserted. Only fresh conversions may enter the stream,
+ * and a fresh conversion whose bus read fails must leave it unchanged, as
+ * must a Load Cell poll with an input selection the driver refuses.
+ *
+ * After every poll the moving average and moving median are compared with
+ * a brute force filter over the last samples, and reading the filtered
+ * weight must not touch the bus.
+ */
+#include "loadcell.h"
+#include "loadcell2.h"
+#include "loadcell3.h"
+#include "loadcell4.h"
+#include "loadcell5.h"
+#include "loadcell6.h"
+#include "loadcell7.h"
+#include "loadcell8.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define WINDOW              20
+#define GENERIC_POLLS       6000
+#define HX711_PERIOD_US     12500
+#define HX711_RUN_US        40000000ull
+#define LOOP_PERIOD_US      100
+
+enum { DEV_IDLE, DEV_FRESH, DEV_STALE };
+
+typedef struct
+{
+    const char *name;
+    void *ctx;
+    void *ready_pin;
+    uint8_t ready_level;
+    uint8_t has_status;
+    int32_t min;
+    int32_t max;
+    float offset;
+    int ( *start )( void *ctx, uint8_t filter );
+    uint8_t ( *poll )( void *ctx );
+    int ( *weight )( void *ctx, float *weight );
+} stream_dev_t;
+
+static const stream_dev_t *dev;
+static uint8_t dev_state;
+static int32_t dev_sample;
+static uint32_t bus_calls;
+static uint8_t bus_fail;
+
+static int32_t history[ WINDOW ];
+static uint32_t history_count;
+static int failures;
+
+// ---------------------------------------------------------- REFERENCE FILTER
+
+static void history_push ( int32_t sample )
+{
+    history[ history_count % WINDOW ] = sample;
+    history_count++;
+}
+
+static int cmp_int32 ( const void *a, const void *b )
+{
+    int32_t x = *( const int32_t * ) a;
+    int32_t y = *( const int32_t * ) b;
+    return ( x > y ) - ( x < y );
+}
+
+static double reference_filter ( uint8_t filter )
+{
+    int32_t window[ WINDOW ];
+    uint32_t n = ( history_count < WINDOW ) ? history_count : WINDOW;
+    double sum = 0;
+
+    memcpy( window, history, n * sizeof( int32_t ) );
+    if ( filter )
+    {
+        qsort( window, n, sizeof( int32_t ), cmp_int32 );
+        return ( n % 2 ) ? window[ n / 2 ] : ( ( double ) window[ n / 2 - 1 ] + window[ n / 2 ] ) / 2;
+    }
+    for ( uint32_t cnt = 0; cnt < n; cnt++ )
+    {
+        sum += window[ cnt ];
+    }
+    return sum / n;
+}
+
+static int check_weight ( const char *name, void *ctx, int ( *weight )( void *ctx, float *weight ),
+                          uint8_t filter, float offset )
+{
+    double expected = reference_filter( filter ) + offset;
+    uint32_t calls = bus_calls;
+    uint64_t start = hal_sim_time_us;
+    float value;
+
+    if ( !weight( ctx, &value ) )
+    {
+        printf( "FAIL: %s reports no weight after %u samples\n", name, ( unsigned ) history_count );
+        return 1;
+    }
+    if ( ( calls != bus_calls ) || ( start != hal_sim_time_us ) )
+    {
+        printf( "FAIL: %s reads the bus to get the filtered weight\n", name );
+        return 1;
+    }
+    if ( fabs( value - expected ) > 1e-6 * fabs( expected ) + 1e-3 )
+    {
+        printf( "FAIL: %s %s is %.3f after %u samples, expected %.3f\n", name, filter ? "median" : "average",
+                value, ( unsigned ) history_count, expected );
+        return 1;
+    }
+    return 0;
+}
+
+// ------------------------------------------------------------------ HX711
+
+static loadcell_t hx711;
+static uint64_t hx711_latched;
+static uint8_t hx711_pulses;
+static uint8_t hx711_clk;
+static uint32_t hx711_shift;
+
+static uint32_t hx711_conversion ( uint64_t index )
+{
+    // Deterministic noise around a load, 24 bits like the converter
+    return ( uint32_t ) ( 0x400000 + ( ( index * 2654435761u ) >> 11 ) % 0x20000 ) & 0xFFFFFF;
+}
+
+static uint64_t hx711_current ( void )
+{
+    return hal_sim_time_us / HX711_PERIOD_US;
+}
+
+static uint8_t hx711_read ( void *obj, pin_name_t pin )
+{
+    ( void ) pin;
+    bus_calls++;
+    if ( obj != &hx711.int_pin )
+    {
+        return 0;
+    }
+    if ( hx711_pulses && ( hx711_pulses <= 24 ) )
+    {
+        return ( hx711_shift >> ( 24 - hx711_pulses ) ) & 1;
+    }
+    if ( hx711_current( ) > hx711_latched )
+    {
+        return 0;
+    }
+    // A busy wait on DOUT costs about a microsecond per read
+    hal_sim_time_us++;
+    return 1;
+}
+
+static void hx711_write ( void *obj, pin_name_t pin, uint8_t state )
+{
+    ( void ) pin;
+    bus_calls++;
+    if ( obj != &hx711.clk )
+    {
+        return;
+    }
+    if ( state && !hx711_clk )
+    {
+        if ( 0 == hx711_pulses )
+        {
+            hx711_latched = hx711_current( );
+            hx711_shift = hx711_conversion( hx711_latched );
+        }
+        hx711_pulses++;
+    }
+    else if ( !state && hx711_clk && ( hx711_pulses >= 25 ) )
+    {
+        hx711_pulses = 0;
+    }
+    hx711_clk = state;
+}
+
+static int hx711_weight ( void *ctx, float *weight )
+{
+    static loadcell_data_t cell_data = { .weight_coeff_100g = 1, .weight_data_100g_ok = LOADCELL_DATA_OK };
+
+    return LOADCELL_GET_RESULT_OK == loadcell_stream_get_weight( ctx, &cell_data, weight );
+}
+
+static void hx711_reset ( void )
+{
+    hal_sim_reset( );
+    hal_sim_gpio_read = hx711_read;
+    hal_sim_gpio_write = hx711_write;
+    hx711_latched = 0;
+    hx711_pulses = 0;
+    hx711_clk = 0;
+}
+
+static void check_hx711_stream ( uint8_t filter )
+{
+    uint64_t expected_index = 1;
+    uint64_t poll_us = 0;
+    uint32_t captured = 0;
+    uint32_t lost = 0;
+
+    hx711_reset( );
+    history_count = 0;
+    loadcell_stream_start( &hx711, LOADCELL_CHANN_A_GATE_128_NEXT, filter );
+    while ( hal_sim_time_us < HX711_RUN_US )
+    {
+        uint64_t start = hal_sim_time_us;
+        if ( loadcell_stream_poll( &hx711 ) )
+        {
+            poll_us += hal_sim_time_us - start;
+            if ( hx711_latched != expected_index )
+            {
+                lost++;
+            }
+            expected_index = hx711_latched + 1;
+            history_push( ( int32_t ) hx711_conversion( hx711_latched ) );
+            captured++;
+            failures += check_weight( "Load Cell", &hx711, hx711_weight, filter, 0 );
+        }
+        hal_sim_time_us = start + LOOP_PERIOD_US;
+    }
+
+    uint32_t conversions = ( uint32_t ) ( HX711_RUN_US / HX711_PERIOD_US ) - 1;
+    printf( "%-13s %-7s %u of %u conversions captured, %u lost, %.0f us of CPU per sample\n", "Load Cell",
+            filter ? "median" : "average", ( unsigned ) captured, ( unsigned ) conversions, ( unsigned ) lost,
+            ( double ) poll_us / captured );
+    if ( lost || ( captured != conversions ) )
+    {
+        printf( "FAIL: the stream has to capture every conversion exactly once\n" );
+        failures++;
+    }
+}
+
+static void check_hx711_input_sel ( void )
+{
+    hx711_reset( );
+    history_count = 0;
+    if ( LOADCELL_GET_RESULT_ERROR != loadcell_stream_start( &hx711, LOADCELL_CHANN_A_GATE_64_NEXT + 1,
+                                                             LOADCELL_STREAM_FILTER_AVERAGE ) )
+    {
+        printf( "FAIL: Load Cell stream accepts an invalid input selection\n" );
+        failures++;
+    }
+    loadcell_stream_start( &hx711, LOADCELL_CHANN_A_GATE_128_NEXT, LOADCELL_STREAM_FILTER_AVERAGE );
+    // A selection set behind the driver's back has to be refused by the read as well
+    hx711.stream.input_sel = LOADCELL_CHANN_A_GATE_64_NEXT + 1;
+    hal_sim_time_us = 2 * HX711_PERIOD_US;
+    if ( loadcell_stream_poll( &hx711 ) || hx711.stream.count )
+    {
+        printf( "FAIL: Load Cell stream captures a sample the read refused\n" );
+        failures++;
+    }
+}
+
+static void time_hx711_blocking ( void )
+{
+    loadcell_data_t cell_data = { .weight_coeff_100g = 1, .weight_data_100g_ok = LOADCELL_DATA_OK };
+
+    hx711_reset( );
+    hal_sim_time_us = 1000000;
+    uint64_t start = hal_sim_time_us;
+    loadcell_get_weight( &hx711, LOADCELL_CHANN_A_GATE_128_NEXT, &cell_data );
+    double blocking_ms = ( hal_sim_time_us - start ) / 1000.0;
+
+    start = hal_sim_time_us;
+    float weight;
+    hx711_weight( &hx711, &weight );
+    printf( "Load Cell     blocking get_weight holds the CPU %.1f ms per reading, %.1f readings/s;"
+            " stream_get_weight %.0f us\n", blocking_ms, 1000.0 / blocking_ms,
+            ( double ) ( hal_sim_time_us - start ) );
+    if ( hal_sim_time_us != start )
+    {
+        printf( "FAIL: stream_get_weight waits for conversions\n" );
+        failures++;
+    }
+}
+
+// ---------------------------------------------------------- GENERIC DEVICES
+
+static uint8_t generic_ready ( void *obj, pin_name_t pin )
+{
+    ( void ) pin;
+    bus_calls++;
+    if ( obj != dev->ready_pin )
+    {
+        return 0;
+    }
+    return ( DEV_IDLE != dev_state ) ? dev->ready_level : !dev->ready_level;
+}
+
+// Status in bits 31..30 and a 14 bit bridge reading in bits 29..16, as on ZSC31014 and ZSSC3240 parts
+static void put_status_word ( uint8_t *buf, uint8_t status )
+{
+    uint32_t word = ( ( uint32_t ) status << 30 ) | ( ( uint32_t ) dev_sample << 16 ) | 0x1234;
+
+    buf[ 0 ] = word >> 24;
+    buf[ 1 ] = word >> 16;
+    buf[ 2 ] = word >> 8;
+    buf[ 3 ] = word;
+}
+
+static void put_be24 ( uint8_t *buf, uint32_t value )
+{
+    buf[ 0 ] = value >> 16;
+    buf[ 1 ] = value >> 8;
+    buf[ 2 ] = value;
+}
+
+static err_t generic_i2c ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                           uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    ( void ) address;
+    bus_calls++;
+    memset( read_buf, 0, read_len );
+    if ( bus_fail )
+    {
+        return I2C_MASTER_ERROR;
+    }
+    if ( write_len && ( LOADCELL2_REG_ADC_B2 == write_buf[ 0 ] ) && ( 3 == read_len ) )
+    {
+        put_be24( read_buf, dev_sample );
+    }
+    else if ( write_len && ( LOADCELL3_REG_TEST_PADC_DATA_1 == write_buf[ 0 ] ) )
+    {
+        read_buf[ 0 ] = ( uint8_t ) dev_sample;
+    }
+    else if ( write_len && ( LOADCELL3_REG_TEST_PADC_DATA_2 == write_buf[ 0 ] ) )
+    {
+        read_buf[ 0 ] = ( uint8_t ) ( dev_sample >> 8 );
+    }
+    else if ( !write_len && ( 4 == read_len ) )
+    {
+        // Data that was already read comes back with the stale status
+        put_status_word( read_buf, ( DEV_FRESH == dev_state ) ? 0 : 1 );
+    }
+    return I2C_MASTER_SUCCESS;
+}
+
+static err_t generic_spi_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    bus_calls++;
+    memset( buffer, 0, size );
+    if ( bus_fail )
+    {
+        return SPI_MASTER_ERROR;
+    }
+    if ( 4 == size )
+    {
+        buffer[ 0 ] = ( DEV_FRESH == dev_state ) ? 0 : LOADCELL5_STATUS_ERROR;
+        put_be24( &buffer[ 1 ], dev_sample );
+    }
+    else if ( 3 == size )
+    {
+        put_be24( buffer, ( uint32_t ) dev_sample & 0xFFFFFF );
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+static err_t generic_spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    ( void ) buffer;
+    ( void ) size;
+    bus_calls++;
+    return SPI_MASTER_SUCCESS;
+}
+
+static void check_generic_stream ( const stream_dev_t *device, uint8_t filter )
+{
+    uint32_t fresh = 0, stale = 0, captured = 0;
+    float weight;
+
+    dev = device;
+    history_count = 0;
+    device->start( device->ctx, filter );
+    if ( device->weight( device->ctx, &weight ) )
+    {
+        printf( "FAIL: %s reports a weight before the first sample\n", device->name );
+        failures++;
+    }
+
+    srand( 17 );
+    for ( uint32_t cnt = 0; cnt < GENERIC_POLLS; cnt++ )
+    {
+        int pick = rand( ) % 4;
+        dev_state = ( pick < 2 ) ? DEV_FRESH : ( ( 2 == pick ) && device->has_status ) ? DEV_STALE : DEV_IDLE;
+        if ( !device->ready_pin )
+        {
+            // Without a ready pin only the status can report that nothing new arrived
+            dev_state = !device->has_status ? DEV_FRESH : ( DEV_IDLE == dev_state ) ? DEV_STALE : dev_state;
+        }
+        dev_sample = device->min + ( int32_t ) ( ( uint32_t ) rand( ) % ( uint32_t ) ( device->max - device->min + 1 ) );
+
+        uint8_t got = device->poll( device->ctx );
+        fresh += ( DEV_FRESH == dev_state );
+        stale += ( DEV_STALE == dev_state );
+        if ( got != ( DEV_FRESH == dev_state ) )
+        {
+            printf( "FAIL: %s poll returns %u for a %s conversion\n", device->name, got,
+                    ( DEV_FRESH == dev_state ) ? "fresh" : ( DEV_STALE == dev_state ) ? "stale" : "missing" );
+            failures++;
+            return;
+        }
+        if ( got )
+        {
+            history_push( dev_sample );
+            captured++;
+            if ( check_weight( device->name, device->ctx, device->weight, filter, device->offset ) )
+            {
+                failures++;
+                return;
+            }
+        }
+    }
+
+    // A fresh conversion lost on the bus must not enter the filter
+    dev_state = DEV_FRESH;
+    bus_fail = 1;
+    if ( device->poll( device->ctx ) )
+    {
+        printf( "FAIL: %s captures a sample whose read failed\n", device->name );
+        failures++;
+    }
+    bus_fail = 0;
+    failures += check_weight( device->name, device->ctx, device->weight, filter, device->offset );
+
+    printf( "%-13s %-7s %u fresh samples captured, %u idle and %u stale polls skipped\n", device->name,
+            filter ? "median" : "average", ( unsigned ) captured, ( unsigned ) ( GENERIC_POLLS - fresh - stale ),
+            ( unsigned ) stale );
+}
+
+// ------------------------------------------------------------ DRIVER ADAPTERS
+
+static loadcell2_t lc2;
+static loadcell3_t lc3;
+static loadcell4_t lc4;
+static loadcell5_t lc5;
+static loadcell6_t lc6;
+static loadcell7_t lc7;
+static loadcell8_t lc8;
+
+// Unit coefficient, and a negative tare moving signed readings above the zero clamp
+#define CELL_DATA( type, ok, shift ) \
+    static type cell_data = { .tare = -( shift ), .weight_coeff_100g = 1, .weight_data_100g_ok = ok }
+
+static int lc2_start ( void *ctx, uint8_t filter ) { return loadcell2_stream_start( ctx, filter ); }
+static uint8_t lc2_poll ( void *ctx ) { return loadcell2_stream_poll( ctx ); }
+static int lc2_weight ( void *ctx, float *weight )
+{
+    CELL_DATA( loadcell2_data_t, LOADCELL2_DATA_OK, 0 );
+    return LOADCELL2_GET_RESULT_OK == loadcell2_stream_get_weight( ctx, &cell_data, weight );
+}
+
+static int lc3_start ( void *ctx, uint8_t filter ) { return loadcell3_stream_start( ctx, filter ); }
+static uint8_t lc3_poll ( void *ctx ) { return loadcell3_stream_poll( ctx ); }
+static int lc3_weight ( void *ctx, float *weight )
+{
+    CELL_DATA( loadcell3_data_t, LOADCELL3_DATA_OK, 32768 );
+    return LOADCELL3_OK == loadcell3_stream_get_weight( ctx, &cell_data, weight );
+}
+
+static int lc4_start ( void *ctx, uint8_t filter ) { return loadcell4_stream_start( ctx, filter ); }
+static uint8_t lc4_poll ( void *ctx ) { return loadcell4_stream_poll( ctx ); }
+static int lc4_weight ( void *ctx, float *weight )
+{
+    CELL_DATA( loadcell4_data_t, LOADCELL4_DATA_OK, 0 );
+    return LOADCELL4_OK == loadcell4_stream_get_weight( ctx, &cell_data, weight );
+}
+
+static int lc5_start ( void *ctx, uint8_t filter ) { return loadcell5_stream_start( ctx, filter ); }
+static uint8_t lc5_poll ( void *ctx ) { return loadcell5_stream_poll( ctx ); }
+static int lc5_weight ( void *ctx, float *weight )
+{
+    CELL_DATA( loadcell5_data_t, LOADCELL5_DATA_OK, 0 );
+    return LOADCELL5_OK == loadcell5_stream_get_weight( ctx, &cell_data, weight );
+}
+
+static int lc6_start ( void *ctx, uint8_t filter ) { return loadcell6_stream_start( ctx, filter ); }
+static uint8_t lc6_poll ( void *ctx ) { return loadcell6_stream_poll( ctx ); }
+static int lc6_weight ( void *ctx, float *weight )
+{
+    CELL_DATA( loadcell6_data_t, LOADCELL6_DATA_OK, 0 );
+    return LOADCELL6_OK == loadcell6_stream_get_weight( ctx, &cell_data, weight );
+}
+
+static int lc7_start ( void *ctx, uint8_t filter ) { return loadcell7_stream_start( ctx, filter ); }
+static uint8_t lc7_poll ( void *ctx ) { return loadcell7_stream_poll( ctx ); }
+static int lc7_weight ( void *ctx, float *weight )
+{
+    return LOADCELL7_OK == loadcell7_stream_get_weight( ctx, weight );
+}
+
+static int lc8_start ( void *ctx, uint8_t filter ) { return loadcell8_stream_start( ctx, filter ); }
+static uint8_t lc8_poll ( void *ctx ) { return loadcell8_stream_poll( ctx ); }
+static int lc8_weight ( void *ctx, float *weight )
+{
+    CELL_DATA( loadcell8_data_t, LOADCELL8_DATA_OK, 0 );
+    return LOADCELL8_OK == loadcell8_stream_get_weight( ctx, &cell_data, weight );
+}
+
+static const stream_dev_t devices[ ] =
+{
+    { "Load Cell 2", &lc2, &lc2.rdy, 1, 0, 0, 0xFFFFFF, 0, lc2_start, lc2_poll, lc2_weight },
+    // No ready signal, every poll reads the latest conversion
+    { "Load Cell 3", &lc3, NULL, 1, 0, -32768, 32767, 32768, lc3_start, lc3_poll, lc3_weight },
+    { "Load Cell 4", &lc4, &lc4.int_pin, 1, 1, 0, 0x3FFF, 0, lc4_start, lc4_poll, lc4_weight },
+    { "Load Cell 5", &lc5, &lc5.rdy, 0, 1, 0, 0xFFFFFF, 0, lc5_start, lc5_poll, lc5_weight },
+    { "Load Cell 6", &lc6, &lc6.rdy, 0, 0, 0, 0xFFFFFF, 0, lc6_start, lc6_poll, lc6_weight },
+    { "Load Cell 7", &lc7, &lc7.miso, 0, 0, -524288, 524287, 0, lc7_start, lc7_poll, lc7_weight },
+    // No ready pin, stale conversions are told apart by the status bits
+    { "Load Cell 8", &lc8, NULL, 1, 1, 0, 0x3FFF, 0, lc8_start, lc8_poll, lc8_weight },
+};
+
+static void init_devices ( void )
+{
+    loadcell2_cfg_t cfg2;
+    loadcell3_cfg_t cfg3;
+    loadcell4_cfg_t cfg4;
+    loadcell5_cfg_t cfg5;
+    loadcell6_cfg_t cfg6;
+    loadcell7_cfg_t cfg7;
+    loadcell8_cfg_t cfg8;
+
+    loadcell2_cfg_setup( &cfg2 );
+    loadcell2_init( &lc2, &cfg2 );
+    loadcell3_cfg_setup( &cfg3 );
+    loadcell3_init( &lc3, &cfg3 );
+    loadcell4_cfg_setup( &cfg4 );
+    loadcell4_init( &lc4, &cfg4 );
+    loadcell5_cfg_setup( &cfg5 );
+    loadcell5_init( &lc5, &cfg5 );
+    loadcell6_cfg_setup( &cfg6 );
+    loadcell6_init( &lc6, &cfg6 );
+    loadcell7_cfg_setup( &cfg7 );
+    loadcell7_init( &lc7, &cfg7 );
+    lc7.tare_scale = 0;
+    lc7.weight_scale = 1;
+    loadcell8_cfg_setup( &cfg8 );
+    loadcell8_init( &lc8, &cfg8 );
+}
+
+int main ( void )
+{
+    loadcell_cfg_t cfg;
+
+    hx711_reset( );
+    loadcell_cfg_setup( &cfg );
+    loadcell_init( &hx711, &cfg );
+    check_hx711_stream( LOADCELL_STREAM_FILTER_AVERAGE );
+    check_hx711_stream( LOADCELL_STREAM_FILTER_MEDIAN );
+    check_hx711_input_sel( );
+    time_hx711_blocking( );
+
+    hal_sim_reset( );
+    hal_sim_gpio_read = generic_ready;
+    hal_sim_i2c_transfer = generic_i2c;
+    hal_sim_spi_read = generic_spi_read;
+    hal_sim_spi_write = generic_spi_write;
+    dev = &devices[ 0 ];
+    init_devices( );
+    for ( uint8_t cnt = 0; cnt < sizeof( devices ) / sizeof( devices[ 0 ] ); cnt++ )
+    {
+        check_generic_stream( &devices[ cnt ], 0 );
+        check_generic_stream( &devices[ cnt ], 1 );
+    }
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,507 @@
+/*
+ * MCP25xxFD burst transfers: FIFO draining and loading against a simulated controller.
+ *
+ * The MCP2517FD driver is built by default, MCP2518FD with MCP2518FD_BUILD
+ * and MCP251863 with MCP251863_BUILD. They run against a model of the
+ * controller on the SPI hooks that decodes the READ and WRITE instructions
+ * into a register and message RAM image. One FIFO is modelled with its
+ * depth, tail, fill level and timestamp setting. Its control, status and
+ * user address registers follow the FIFO, and a write of UINC to the
+ * second control byte advances the tail, while TXREQ is counted. A
+ * transaction is one chip select assertion.
+ *
+ * For FIFO depths of 1 to 8, every start offset and fill level and with
+ * and without RX timestamps, receive_burst has to return the pending
+ * messages in FIFO order, up to the requested count, with their headers,
+ * timestamps and payloads, and release exactly the messages it returned.
+ * transmit_burst has to write the messages to the free objects in order,
+ * stop when the FIFO is full and set TXREQ at least once whenever it sent
+ * anything. Both have to refuse a FIFO of the wrong direction. Moving 8
+ * messages through an 8 deep FIFO has to take 24 transactions each way
+ * when exactly 8 are asked for, and 25 when more are asked for and the
+ * burst ends on the status read that finds the FIFO empty or full. The
+ * per message receive_message and transmit_message calls are counted for
+ * comparison.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "hal_sim.h"
+
+#if defined( MCP2518FD_BUILD )
+#include "mcp2518fd.h"
+#define DRIVER_NAME             "MCP2518FD"
+#define CAN( name )             mcp2518fd_##name
+#define CAN_C( name )           MCP2518FD_##name
+#elif defined( MCP251863_BUILD )
+#include "mcp251863.h"
+#define DRIVER_NAME             "MCP251863"
+#define CAN( name )             mcp251863_##name
+#define CAN_C( name )           MCP251863_##name
+#else
+#include "mcp2517fd.h"
+#define DRIVER_NAME             "MCP2517FD"
+#define CAN( name )             mcp2517fd_##name
+#define CAN_C( name )           MCP2517FD_##name
+#endif
+
+#define CS_PIN              1
+#define MEM_SIZE            0x1000
+#define RAM_START           0x400
+#define RX_CHANNEL          CAN_C( FIFO_CH1 )
+#define TX_CHANNEL          CAN_C( FIFO_CH2 )
+#define MAX_DEPTH           8
+#define PAYLOAD             64
+#define BURST_MESSAGES      8
+#define BURST_TRANSACTIONS  24
+
+typedef CAN( rx_msg_obj_t ) rx_obj_t;
+typedef CAN( tx_msg_obj_t ) tx_obj_t;
+
+static CAN( t ) ctx;
+static uint8_t mem[ MEM_SIZE ];
+
+// FIFO model
+static struct
+{
+    uint8_t channel;
+    uint8_t is_tx;
+    uint8_t time_stamp;
+    uint8_t depth;
+    uint8_t tail;
+    uint8_t count;
+    uint16_t base;
+    uint16_t obj_size;
+    uint32_t txreq;
+    uint32_t uinc;
+} fifo;
+
+static uint8_t spi_state;
+static uint8_t instruction;
+static uint16_t address;
+static uint8_t selected;
+static uint32_t transactions;
+static uint32_t stray_bytes;
+
+static int failures;
+
+// ----------------------------------------------------------------- CONTROLLER
+
+static void put_word ( uint16_t addr, uint32_t value )
+{
+    for ( uint8_t cnt = 0; cnt < 4; cnt++ )
+    {
+        mem[ addr + cnt ] = ( uint8_t ) ( value >> ( 8 * cnt ) );
+    }
+}
+
+// Control, status and user address registers of the modelled FIFO
+static void fifo_refresh ( void )
+{
+    uint16_t reg = CAN_C( REG_CIFIFOCON ) + fifo.channel * CAN_C( FIFO_OFFSET );
+    uint32_t con = ( fifo.is_tx ? 0x80u : 0u ) | ( fifo.time_stamp ? 0x20u : 0u ) |
+                   ( ( uint32_t ) ( fifo.depth - 1 ) << 24 ) | ( 7u << 29 );
+    uint32_t sta;
+
+    if ( fifo.is_tx )
+    {
+        // not full, half empty, empty
+        sta = ( fifo.count < fifo.depth ) | ( ( fifo.count * 2 <= fifo.depth ) << 1 ) | ( ( 0 == fifo.count ) << 2 );
+    }
+    else
+    {
+        // not empty, half full, full
+        sta = ( fifo.count > 0 ) | ( ( fifo.count * 2 >= fifo.depth ) << 1 ) | ( ( fifo.count == fifo.depth ) << 2 );
+    }
+    put_word( reg, con );
+    put_word( reg + 4, sta );
+    put_word( reg + 8, ( uint32_t ) ( fifo.base + fifo.tail * fifo.obj_size - RAM_START ) );
+}
+
+static void controller_select ( pin_name_t cs, uint8_t state )
+{
+    ( void ) cs;
+    if ( state && !selected )
+    {
+        transactions++;
+        spi_state = 0;
+        fifo_refresh( );
+    }
+    selected = state;
+}
+
+static void controller_byte ( uint8_t data_in, uint8_t *data_out )
+{
+    uint16_t con_reg = CAN_C( REG_CIFIFOCON ) + fifo.channel * CAN_C( FIFO_OFFSET );
+
+    *data_out = 0;
+    if ( 0 == spi_state )
+    {
+        instruction = data_in >> 4;
+        address = ( uint16_t ) ( ( data_in & 0x0F ) << 8 );
+        spi_state = 1;
+        return;
+    }
+    if ( 1 == spi_state )
+    {
+        address |= data_in;
+        spi_state = 2;
+        return;
+    }
+    if ( CAN_C( INS_READ ) == instruction )
+    {
+        *data_out = mem[ address % MEM_SIZE ];
+    }
+    else if ( CAN_C( INS_WRITE ) == instruction )
+    {
+        if ( ( con_reg + 1 ) == address )
+        {
+            // UINC and TXREQ are self clearing and only act on the FIFO
+            if ( data_in & 0x01 )
+            {
+                fifo.uinc++;
+                fifo.count = fifo.is_tx ? fifo.count + 1 : fifo.count - 1;
+                fifo.tail = ( fifo.tail + 1 ) % fifo.depth;
+            }
+            fifo.txreq += ( data_in & 0x02 ) ? 1 : 0;
+        }
+        else
+        {
+            mem[ address % MEM_SIZE ] = data_in;
+        }
+    }
+    address++;
+}
+
+static err_t controller_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    uint8_t unused;
+    ( void ) obj;
+    if ( !selected )
+    {
+        stray_bytes += ( uint32_t ) size;
+        return SPI_MASTER_SUCCESS;
+    }
+    for ( size_t cnt = 0; cnt < size; cnt++ )
+    {
+        controller_byte( buffer[ cnt ], &unused );
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+static err_t controller_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    if ( !selected )
+    {
+        stray_bytes += ( uint32_t ) size;
+        return SPI_MASTER_SUCCESS;
+    }
+    for ( size_t cnt = 0; cnt < size; cnt++ )
+    {
+        controller_byte( 0, &buffer[ cnt ] );
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+// ----------------------------------------------------------------------- HOST
+
+static void fifo_setup ( uint8_t channel, uint8_t is_tx, uint8_t time_stamp, uint8_t depth, uint8_t tail,
+                         uint8_t count )
+{
+    memset( mem, 0, sizeof( mem ) );
+    memset( &fifo, 0, sizeof( fifo ) );
+    fifo.channel = channel;
+    fifo.is_tx = is_tx;
+    fifo.time_stamp = time_stamp;
+    fifo.depth = depth;
+    fifo.tail = tail;
+    fifo.count = count;
+    fifo.base = RAM_START + 0x100;
+    fifo.obj_size = 8 + ( time_stamp ? 4 : 0 ) + PAYLOAD;
+    transactions = 0;
+    stray_bytes = 0;
+}
+
+// Message object k of the RX FIFO: identifier k, DLC from k, payload bytes from k
+static void fill_rx_objects ( void )
+{
+    for ( uint8_t k = 0; k < fifo.depth; k++ )
+    {
+        uint8_t *obj = &mem[ fifo.base + k * fifo.obj_size ];
+        obj[ 0 ] = k;
+        obj[ 1 ] = 0x11;
+        obj[ 4 ] = ( uint8_t ) ( ( k * 3 ) & 0x0F );
+        if ( fifo.time_stamp )
+        {
+            put_word( fifo.base + k * fifo.obj_size + 8, 0x77000000u | k );
+        }
+        for ( uint8_t j = 0; j < PAYLOAD; j++ )
+        {
+            obj[ 8 + ( fifo.time_stamp ? 4 : 0 ) + j ] = ( uint8_t ) ( k * 16 + j );
+        }
+    }
+}
+
+// --------------------------------------------------------------------- CHECKS
+
+static void check_receive ( void )
+{
+    static rx_obj_t rx_obj[ MAX_DEPTH + 1 ];
+    static uint8_t data[ ( MAX_DEPTH + 1 ) * PAYLOAD ];
+    uint32_t bad = 0;
+    uint32_t cases = 0;
+
+    for ( uint8_t ts = 0; ts < 2; ts++ )
+    {
+        for ( uint8_t depth = 1; depth <= MAX_DEPTH; depth++ )
+        {
+            for ( uint8_t start = 0; start < depth; start++ )
+            {
+                for ( uint8_t count = 0; count <= depth; count++ )
+                {
+                    for ( uint8_t max_msg = 1; max_msg <= ( MAX_DEPTH + 1 ); max_msg += 4 )
+                    {
+                        uint8_t num_msg = 0xFF;
+                        uint8_t expected = ( count < max_msg ) ? count : max_msg;
+                        err_t error;
+
+                        fifo_setup( RX_CHANNEL, 0, ts, depth, start, count );
+                        fill_rx_objects( );
+                        error = CAN( receive_burst )( &ctx, RX_CHANNEL, rx_obj, data, PAYLOAD, max_msg, &num_msg );
+                        cases++;
+                        if ( error || ( num_msg != expected ) || ( fifo.uinc != expected ) || stray_bytes )
+                        {
+                            if ( !bad )
+                            {
+                                printf( "FAIL: RX depth %u start %u count %u max %u returns %d with %u messages, "
+                                        "%u released\n", depth, start, count, max_msg, ( int ) error, num_msg,
+                                        ( unsigned ) fifo.uinc );
+                            }
+                            bad++;
+                            continue;
+                        }
+                        for ( uint8_t i = 0; i < num_msg; i++ )
+                        {
+                            uint8_t k = ( start + i ) % depth;
+                            uint32_t n_bytes = CAN( dlc_to_data_bytes )( rx_obj[ i ].bf.ctrl.dlc );
+                            uint8_t wrong = ( rx_obj[ i ].byte[ 0 ] != k ) ||
+                                            ( rx_obj[ i ].bf.ctrl.dlc != ( ( k * 3 ) & 0x0F ) ) ||
+                                            ( rx_obj[ i ].word[ 2 ] != ( ts ? ( 0x77000000u | k ) : 0 ) );
+                            for ( uint32_t j = 0; j < n_bytes; j++ )
+                            {
+                                wrong |= ( data[ i * PAYLOAD + j ] != ( uint8_t ) ( k * 16 + j ) );
+                            }
+                            if ( wrong && !bad )
+                            {
+                                printf( "FAIL: RX depth %u start %u count %u message %u does not match object %u\n",
+                                        depth, start, count, i, k );
+                            }
+                            bad += wrong;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    fifo_setup( TX_CHANNEL, 1, 0, 4, 0, 0 );
+    {
+        uint8_t num_msg = 0xFF;
+        if ( ( -2 != CAN( receive_burst )( &ctx, TX_CHANNEL, rx_obj, data, PAYLOAD, 4, &num_msg ) ) || num_msg )
+        {
+            printf( "FAIL: RX burst on a TX FIFO is not refused\n" );
+            bad++;
+        }
+    }
+
+    printf( "%-10s RX burst %u cases, %u wrong\n", DRIVER_NAME, ( unsigned ) cases, ( unsigned ) bad );
+    failures += ( bad != 0 );
+}
+
+static void check_transmit ( void )
+{
+    static tx_obj_t tx_obj[ MAX_DEPTH + 1 ];
+    static uint8_t data[ ( MAX_DEPTH + 1 ) * PAYLOAD ];
+    uint32_t bad = 0;
+    uint32_t cases = 0;
+
+    for ( uint8_t i = 0; i <= MAX_DEPTH; i++ )
+    {
+        memset( &tx_obj[ i ], 0, sizeof( tx_obj_t ) );
+        tx_obj[ i ].word[ 0 ] = 0x100u + i;
+        tx_obj[ i ].bf.ctrl.dlc = ( i * 5 ) & 0x0F;
+        for ( uint8_t j = 0; j < PAYLOAD; j++ )
+        {
+            data[ i * PAYLOAD + j ] = ( uint8_t ) ( i + j );
+        }
+    }
+
+    for ( uint8_t depth = 1; depth <= MAX_DEPTH; depth++ )
+    {
+        for ( uint8_t start = 0; start < depth; start++ )
+        {
+            for ( uint8_t count = 0; count <= depth; count++ )
+            {
+                for ( uint8_t num = 1; num <= ( MAX_DEPTH + 1 ); num += 4 )
+                {
+                    uint8_t num_sent = 0xFF;
+                    uint8_t free_obj = depth - count;
+                    uint8_t expected = ( free_obj < num ) ? free_obj : num;
+                    err_t error;
+
+                    fifo_setup( TX_CHANNEL, 1, 0, depth, start, count );
+                    error = CAN( transmit_burst )( &ctx, TX_CHANNEL, tx_obj, data, PAYLOAD, num, &num_sent );
+                    cases++;
+                    if ( error || ( num_sent != expected ) || ( fifo.uinc != expected ) ||
+                         ( num_sent && !fifo.txreq ) || stray_bytes )
+                    {
+                        if ( !bad )
+                        {
+                            printf( "FAIL: TX depth %u start %u count %u num %u returns %d with %u sent, "
+                                    "%u TXREQ\n", depth, start, count, num, ( int ) error, num_sent,
+                                    ( unsigned ) fifo.txreq );
+                        }
+                        bad++;
+                        continue;
+                    }
+                    for ( uint8_t i = 0; i < num_sent; i++ )
+                    {
+                        uint8_t k = ( start + i ) % depth;
+                        uint8_t *obj = &mem[ fifo.base + k * fifo.obj_size ];
+                        uint32_t n_bytes = CAN( dlc_to_data_bytes )( tx_obj[ i ].bf.ctrl.dlc );
+                        uint8_t wrong = ( obj[ 0 ] != ( uint8_t ) ( 0x100u + i ) ) || ( 0x01 != obj[ 1 ] ) ||
+                                        ( ( obj[ 4 ] & 0x0F ) != ( ( i * 5 ) & 0x0F ) );
+                        for ( uint32_t j = 0; j < n_bytes; j++ )
+                        {
+                            wrong |= ( obj[ 8 + j ] != ( uint8_t ) ( i + j ) );
+                        }
+                        if ( wrong && !bad )
+                        {
+                            printf( "FAIL: TX depth %u start %u count %u message %u is not in object %u\n",
+                                    depth, start, count, i, k );
+                        }
+                        bad += wrong;
+                    }
+                }
+            }
+        }
+    }
+
+    fifo_setup( RX_CHANNEL, 0, 0, 4, 0, 0 );
+    {
+        uint8_t num_sent = 0xFF;
+        if ( ( -2 != CAN( transmit_burst )( &ctx, RX_CHANNEL, tx_obj, data, PAYLOAD, 4, &num_sent ) ) ||
+             num_sent || fifo.uinc )
+        {
+            printf( "FAIL: TX burst on a RX FIFO is not refused\n" );
+            bad++;
+        }
+    }
+
+    printf( "%-10s TX burst %u cases, %u wrong\n", DRIVER_NAME, ( unsigned ) cases, ( unsigned ) bad );
+    failures += ( bad != 0 );
+}
+
+// Transactions of a burst asking for num messages with the FIFO holding 8 or none
+static uint32_t burst_transactions ( uint8_t is_tx, uint8_t num, uint32_t *txreq )
+{
+    static rx_obj_t rx_obj[ BURST_MESSAGES + 1 ];
+    static tx_obj_t tx_obj[ BURST_MESSAGES + 1 ];
+    static uint8_t data[ ( BURST_MESSAGES + 1 ) * PAYLOAD ];
+    uint8_t done;
+
+    memset( tx_obj, 0, sizeof( tx_obj ) );
+    for ( uint8_t i = 0; i <= BURST_MESSAGES; i++ )
+    {
+        tx_obj[ i ].bf.ctrl.dlc = 8;
+    }
+    if ( is_tx )
+    {
+        fifo_setup( TX_CHANNEL, 1, 0, BURST_MESSAGES, 0, 0 );
+        CAN( transmit_burst )( &ctx, TX_CHANNEL, tx_obj, data, PAYLOAD, num, &done );
+        if ( txreq )
+        {
+            *txreq = fifo.txreq;
+        }
+    }
+    else
+    {
+        fifo_setup( RX_CHANNEL, 0, 0, BURST_MESSAGES, 0, BURST_MESSAGES );
+        fill_rx_objects( );
+        CAN( receive_burst )( &ctx, RX_CHANNEL, rx_obj, data, PAYLOAD, num, &done );
+    }
+    return ( BURST_MESSAGES == done ) ? transactions : 0;
+}
+
+static void check_transactions ( void )
+{
+    static uint8_t data[ BURST_MESSAGES * PAYLOAD ];
+    uint32_t rx_burst, tx_burst, rx_drain, tx_fill, rx_single, tx_single;
+    uint32_t tx_burst_req, tx_single_req;
+    uint16_t data_len;
+
+    rx_burst = burst_transactions( 0, BURST_MESSAGES, NULL );
+    rx_drain = burst_transactions( 0, BURST_MESSAGES + 1, NULL );
+    tx_fill = burst_transactions( 1, BURST_MESSAGES + 1, &tx_burst_req );
+    tx_burst = burst_transactions( 1, BURST_MESSAGES, &tx_burst_req );
+
+    fifo_setup( RX_CHANNEL, 0, 0, BURST_MESSAGES, 0, BURST_MESSAGES );
+    fill_rx_objects( );
+    for ( uint8_t i = 0; i < BURST_MESSAGES; i++ )
+    {
+        CAN( receive_message )( &ctx, data, &data_len );
+    }
+    rx_single = transactions;
+
+    fifo_setup( TX_CHANNEL, 1, 0, BURST_MESSAGES, 0, 0 );
+    for ( uint8_t i = 0; i < BURST_MESSAGES; i++ )
+    {
+        CAN( transmit_message )( &ctx, data, 8 );
+    }
+    tx_single = transactions;
+    tx_single_req = fifo.txreq;
+
+    printf( "%-10s %u messages RX: burst %u transactions, draining %u, per message %u\n", DRIVER_NAME,
+            BURST_MESSAGES, ( unsigned ) rx_burst, ( unsigned ) rx_drain, ( unsigned ) rx_single );
+    printf( "%-10s %u messages TX: burst %u transactions, filling %u, per message %u; TXREQ %u and %u\n",
+            DRIVER_NAME, BURST_MESSAGES, ( unsigned ) tx_burst, ( unsigned ) tx_fill, ( unsigned ) tx_single,
+            ( unsigned ) tx_burst_req, ( unsigned ) tx_single_req );
+
+    if ( ( BURST_TRANSACTIONS != rx_burst ) || ( BURST_TRANSACTIONS != tx_burst ) ||
+         ( ( BURST_TRANSACTIONS + 1 ) != rx_drain ) || ( ( BURST_TRANSACTIONS + 1 ) != tx_fill ) )
+    {
+        printf( "FAIL: %u messages take %u and %u RX, %u and %u TX transactions, expected %u and %u\n",
+                BURST_MESSAGES, ( unsigned ) rx_burst, ( unsigned ) rx_drain, ( unsigned ) tx_burst,
+                ( unsigned ) tx_fill, BURST_TRANSACTIONS, BURST_TRANSACTIONS + 1 );
+        failures++;
+    }
+    if ( 1 != tx_burst_req )
+    {
+        printf( "FAIL: TX burst of %u messages sets TXREQ %u times\n", BURST_MESSAGES, ( unsigned ) tx_burst_req );
+        failures++;
+    }
+}
+
+int main ( void )
+{
+    CAN( cfg_t ) cfg;
+
+    hal_sim_reset( );
+    hal_sim_spi_select = controller_select;
+    hal_sim_spi_write = controller_write;
+    hal_sim_spi_read = controller_read;
+    CAN( cfg_setup )( &cfg );
+    cfg.cs = CS_PIN;
+    if ( CAN( init )( &ctx, &cfg ) )
+    {
+        printf( "FAIL: init\n" );
+        return EXIT_FAILURE;
+    }
+
+    check_receive( );
+    check_transmit( );
+    check_transactions( );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,258 @@
+/*
+ * Oximeter 5 streaming SpO2 and heart rate estimator against the batch functions.
+ *
+ * A synthetic 25 Hz PPG with a fast systolic upstroke, an exponential
+ * runoff and a dicrotic notch is fed one IR/Red pair at a time to
+ * oximeter5_estimator_update. The Red and IR pulses have a set ratio of
+ * their AC to DC parts, so every trace has a known heart rate and a fixed
+ * SpO2. The Red pulse lags the IR pulse by 12 ms, a third of a sample, and
+ * respiration wander and noise are added on top.
+ *
+ * Each time the estimator reports a beat, oximeter5_get_oxygen_saturation
+ * and oximeter5_get_heart_rate are run on the trailing 100-sample window,
+ * which is how the driver is used without the estimator. From 60 to 120
+ * bpm and over the SpO2 range of the table, the streaming SpO2 has to
+ * stay within a point of the batch result. The streaming heart rate has
+ * to come from a mean beat interval of the true period truncated to whole
+ * samples, or a sample less, and on average be no further from the true
+ * rate than the batch result. The estimator has to report one
+ * beat per pulse. The work per sample of both is timed for comparison.
+ */
+#include "oximeter5.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define OXI_PI              3.14159265358979
+#define FS                  25
+#define WINDOW              ( FS * 4 )
+#define TRACE_SECONDS       60
+#define TRACE_LEN           ( FS * TRACE_SECONDS )
+#define WARMUP_SAMPLES      ( WINDOW + FS * 2 )
+#define IR_DC               120000.0
+#define RED_DC              90000.0
+#define IR_MOD              0.02
+#define WANDER              0.002
+#define NOISE               20
+#define RED_LAG             0.3
+#define SPO2_TOLERANCE      1
+#define BENCH_ROUNDS        20
+
+typedef struct
+{
+    double bpm;
+    double ratio;           // Red/IR ratio of the AC to DC parts
+    uint8_t wander;
+} scenario_t;
+
+static const scenario_t scenarios[ ] =
+{
+    { 60, 0.5, 0 }, { 75, 0.5, 0 }, { 90, 0.5, 0 }, { 120, 0.5, 0 },
+    { 75, 0.4, 0 }, { 75, 0.7, 0 }, { 75, 1.0, 0 },
+    { 60, 0.6, 1 }, { 75, 0.6, 1 }, { 100, 0.6, 1 },
+};
+
+#define N_SCENARIOS         ( sizeof( scenarios ) / sizeof( scenarios[ 0 ] ) )
+
+static uint32_t ir_trace[ TRACE_LEN ];
+static uint32_t red_trace[ TRACE_LEN ];
+static uint32_t lcg_state;
+
+static int failures;
+
+// --------------------------------------------------------------------- SIGNAL
+
+static int32_t noise ( void )
+{
+    lcg_state = lcg_state * 1103515245u + 12345u;
+    return ( int32_t ) ( ( lcg_state >> 16 ) % ( 2 * NOISE + 1 ) ) - NOISE;
+}
+
+// Blood volume over one beat, 0 at diastole and 1 at the systolic peak
+static double pulse ( double phase )
+{
+    double rise = 0.15;
+    double value;
+
+    if ( phase < rise )
+    {
+        value = sin( OXI_PI / 2 * phase / rise );
+        return value * value;
+    }
+    value = exp( -( phase - rise ) * 3.5 );
+    // dicrotic notch and wave
+    value += 0.12 * exp( -pow( ( phase - 0.45 ) / 0.06, 2 ) );
+    return value * ( 1.0 - 0.15 * ( phase - rise ) );
+}
+
+static void make_trace ( const scenario_t *sc )
+{
+    double period = FS * 60.0 / sc->bpm;
+
+    lcg_state = 1u;
+    for ( uint32_t n = 0; n < TRACE_LEN; n++ )
+    {
+        double phase = fmod( n + 0.37 * period, period ) / period;
+        double red_phase = fmod( n + 0.37 * period - RED_LAG, period ) / period;
+        double blood = pulse( phase );
+        double breath = sc->wander ? WANDER * sin( 2 * OXI_PI * 0.25 * n / FS ) : 0;
+        // more blood absorbs more light, so the photodiode current dips at systole
+        ir_trace[ n ] = ( uint32_t ) ( IR_DC * ( 1.0 - IR_MOD * blood + breath ) + noise( ) );
+        red_trace[ n ] = ( uint32_t ) ( RED_DC * ( 1.0 - IR_MOD * sc->ratio * pulse( red_phase ) + breath ) + noise( ) );
+    }
+}
+
+// --------------------------------------------------------------------- CHECKS
+
+static void check_scenario ( const scenario_t *sc )
+{
+    oximeter5_estimator_t est;
+    uint32_t beats = 0;
+    uint32_t compared = 0;
+    uint32_t batch_errors = 0;
+    uint32_t spo2_off = 0;
+    uint32_t hr_off = 0;
+    uint8_t max_spo2_diff = 0;
+    int32_t batch_spo2_sum = 0;
+    int32_t stream_spo2_sum = 0;
+    double stream_hr_sum = 0;
+    double batch_hr_sum = 0;
+    double pulses = ( TRACE_LEN - 0.37 * FS * 60.0 / sc->bpm ) * sc->bpm / ( 60.0 * FS );
+
+    make_trace( sc );
+    oximeter5_estimator_init( &est );
+    for ( uint32_t n = 0; n < TRACE_LEN; n++ )
+    {
+        uint8_t batch_spo2;
+        int32_t batch_hr;
+        uint8_t diff;
+
+        if ( OXIMETER5_ESTIMATOR_NEW_BEAT != oximeter5_estimator_update( &est, ir_trace[ n ], red_trace[ n ] ) )
+        {
+            continue;
+        }
+        beats++;
+        if ( n < WARMUP_SAMPLES )
+        {
+            continue;
+        }
+        if ( oximeter5_get_oxygen_saturation( &ir_trace[ n + 1 - WINDOW ], WINDOW, &red_trace[ n + 1 - WINDOW ], &batch_spo2 ) ||
+             oximeter5_get_heart_rate( &ir_trace[ n + 1 - WINDOW ], WINDOW, &red_trace[ n + 1 - WINDOW ], &batch_hr ) )
+        {
+            batch_errors++;
+            continue;
+        }
+        compared++;
+        diff = ( est.spo2 > batch_spo2 ) ? ( est.spo2 - batch_spo2 ) : ( batch_spo2 - est.spo2 );
+        max_spo2_diff = ( diff > max_spo2_diff ) ? diff : max_spo2_diff;
+        spo2_off += ( diff > SPO2_TOLERANCE );
+        batch_spo2_sum += batch_spo2;
+        stream_spo2_sum += est.spo2;
+        batch_hr_sum += batch_hr;
+        stream_hr_sum += est.heart_rate;
+        // the mean beat interval is truncated to whole samples, so jitter can only shorten it
+        if ( ( est.heart_rate > ( int32_t ) ( FS * 60 / ( floor( FS * 60 / sc->bpm ) - 1 ) ) ) ||
+             ( est.heart_rate < ( int32_t ) ( FS * 60 / floor( FS * 60 / sc->bpm ) ) ) )
+        {
+            hr_off++;
+        }
+    }
+
+    printf( "%5.0f bpm ratio %.1f %-7s beats %3u/%3.0f compared %3u SpO2 stream %5.1f batch %5.1f "
+            "max diff %u, bpm stream %6.1f batch %6.1f, batch errors %u\n",
+            sc->bpm, sc->ratio, sc->wander ? "wander" : "", ( unsigned ) beats, floor( pulses ),
+            ( unsigned ) compared, compared ? ( double ) stream_spo2_sum / compared : 0,
+            compared ? ( double ) batch_spo2_sum / compared : 0, max_spo2_diff,
+            compared ? stream_hr_sum / compared : 0, compared ? batch_hr_sum / compared : 0,
+            ( unsigned ) batch_errors );
+
+    if ( ( beats + 2 ) < floor( pulses ) || beats > ceil( pulses ) )
+    {
+        printf( "FAIL: %.0f bpm ratio %.1f reports %u beats for %.0f pulses\n", sc->bpm, sc->ratio,
+                ( unsigned ) beats, floor( pulses ) );
+        failures++;
+    }
+    if ( compared < ( beats / 2 ) )
+    {
+        printf( "FAIL: %.0f bpm ratio %.1f has only %u batch results to compare\n", sc->bpm, sc->ratio,
+                ( unsigned ) compared );
+        failures++;
+    }
+    if ( spo2_off )
+    {
+        printf( "FAIL: %.0f bpm ratio %.1f streaming SpO2 is more than %u off the batch result %u times\n",
+                sc->bpm, sc->ratio, SPO2_TOLERANCE, ( unsigned ) spo2_off );
+        failures++;
+    }
+    if ( hr_off )
+    {
+        printf( "FAIL: %.0f bpm ratio %.1f streaming heart rate comes from a wrong beat interval %u times\n",
+                sc->bpm, sc->ratio, ( unsigned ) hr_off );
+        failures++;
+    }
+    if ( compared && ( fabs( stream_hr_sum / compared - sc->bpm ) > fabs( batch_hr_sum / compared - sc->bpm ) ) )
+    {
+        printf( "FAIL: %.0f bpm ratio %.1f streaming heart rate is further off the true rate than the batch one\n",
+                sc->bpm, sc->ratio );
+        failures++;
+    }
+}
+
+// ---------------------------------------------------------------------- BENCH
+
+static void bench ( void )
+{
+    oximeter5_estimator_t est;
+    volatile uint32_t sink = 0;
+    uint8_t spo2;
+    int32_t hr;
+    clock_t start;
+    double stream_s;
+    double batch_s;
+
+    make_trace( &scenarios[ 1 ] );
+    start = clock( );
+    for ( uint32_t round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        oximeter5_estimator_init( &est );
+        for ( uint32_t n = 0; n < TRACE_LEN; n++ )
+        {
+            sink += oximeter5_estimator_update( &est, ir_trace[ n ], red_trace[ n ] );
+        }
+    }
+    stream_s = ( double ) ( clock( ) - start ) / CLOCKS_PER_SEC;
+
+    // the batch functions are run once per second on the trailing window
+    start = clock( );
+    for ( uint32_t round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        for ( uint32_t n = WINDOW; n <= TRACE_LEN; n += FS )
+        {
+            oximeter5_get_oxygen_saturation( &ir_trace[ n - WINDOW ], WINDOW, &red_trace[ n - WINDOW ], &spo2 );
+            oximeter5_get_heart_rate( &ir_trace[ n - WINDOW ], WINDOW, &red_trace[ n - WINDOW ], &hr );
+            sink += spo2;
+        }
+    }
+    batch_s = ( double ) ( clock( ) - start ) / CLOCKS_PER_SEC;
+
+    printf( "streaming %.3f us per sample, %u bytes of state; batch %.3f us per sample at one window "
+            "per second, %u bytes of window buffers\n",
+            stream_s * 1e6 / ( BENCH_ROUNDS * TRACE_LEN ), ( unsigned ) sizeof( oximeter5_estimator_t ),
+            batch_s * 1e6 / ( BENCH_ROUNDS * TRACE_LEN ), ( unsigned ) ( 2 * WINDOW * sizeof( uint32_t ) ) );
+    ( void ) sink;
+}
+
+int main ( void )
+{
+    for ( uint32_t cnt = 0; cnt < N_SCENARIOS; cnt++ )
+    {
+        check_scenario( &scenarios[ cnt ] );
+    }
+    bench( );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,607 @@
+/*
+ * PAC power monitor snapshots against the per-channel reads they replace.
+ *
+ * The I2C model serves the PAC195x/PAC194x/PAC193x register map with
+ * auto-increment, including the skip of disabled channel registers, and
+ * the flat PAC1720 register file. Its measurement registers are filled
+ * with random data for every run. The snapshot of each enabled channel has
+ * to match the existing per-channel conversion functions on the same data,
+ * and disabled channels have to read as zero. Channel masks, skip settings,
+ * bipolar and half range modes and accumulator sources are all covered.
+ *
+ * The accumulators have no float conversion in the PAC195x/PAC194x
+ * drivers, so their raw registers are scaled here from the datasheet
+ * LSB weights. The transactions and bus bytes of one snapshot are reported
+ * next to the per-channel poll that returns the same data.
+ */
+#include "pac1720.h"
+#include "pac1934.h"
+#include "pac1944.h"
+#include "pac1954.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNS_PER_CONFIG     200
+
+#define PAC_CH_REG_FIRST    0x03
+#define PAC_CH_REG_LAST     0x1A
+#define PAC_REFRESH_V       0x1F
+
+static struct
+{
+    uint8_t data[ 256 ][ 8 ];
+    uint8_t size[ 256 ];
+    uint8_t ptr;
+    uint8_t channel_regs;
+    uint8_t skip;
+    uint8_t ch_off;
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t refresh_v;
+} pac;
+
+static int failures;
+
+static int reg_channel ( uint8_t reg )
+{
+    if ( pac.channel_regs && ( reg >= PAC_CH_REG_FIRST ) && ( reg <= PAC_CH_REG_LAST ) )
+    {
+        return ( reg - PAC_CH_REG_FIRST ) % 4;
+    }
+    return -1;
+}
+
+// Auto-increment moves to the next register, past disabled channels when skipping
+static uint8_t next_reg ( uint8_t reg )
+{
+    int ch;
+    do
+    {
+        reg++;
+        ch = reg_channel( reg );
+    }
+    while ( pac.skip && ( ch >= 0 ) && ( ( pac.ch_off >> ch ) & 1 ) );
+    return reg;
+}
+
+static err_t pac_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                            uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    ( void ) address;
+    uint8_t reg;
+    uint8_t offset = 0;
+
+    pac.transactions++;
+    pac.bytes += 1 + write_len + ( read_len ? 1 + read_len : 0 );
+
+    if ( write_len )
+    {
+        pac.ptr = write_buf[ 0 ];
+        if ( pac.channel_regs && ( 1 == write_len ) && !read_len && ( PAC_REFRESH_V == pac.ptr ) )
+        {
+            pac.refresh_v++;
+        }
+    }
+    reg = pac.ptr;
+    for ( size_t cnt = 1; cnt < write_len; cnt++ )
+    {
+        if ( offset == pac.size[ reg ] )
+        {
+            reg = next_reg( reg );
+            offset = 0;
+        }
+        pac.data[ reg ][ offset++ ] = write_buf[ cnt ];
+    }
+    for ( size_t cnt = 0; cnt < read_len; cnt++ )
+    {
+        if ( offset == pac.size[ reg ] )
+        {
+            reg = next_reg( reg );
+            offset = 0;
+        }
+        read_buf[ cnt ] = pac.data[ reg ][ offset++ ];
+    }
+    return I2C_MASTER_SUCCESS;
+}
+
+// PAC195x and PAC194x registers are 4/7/2/4 bytes wide, PAC193x 3/6/2/4
+static void model_pac19xx ( uint8_t acc_count_size, uint8_t acc_size, uint8_t ctrl_act_size )
+{
+    memset( &pac, 0, sizeof( pac ) );
+    memset( pac.size, 1, sizeof( pac.size ) );
+    pac.channel_regs = 1;
+    pac.size[ 0x01 ] = 2;
+    pac.size[ 0x02 ] = acc_count_size;
+    for ( uint8_t reg = 0x03; reg <= 0x06; reg++ )
+    {
+        pac.size[ reg ] = acc_size;
+    }
+    for ( uint8_t reg = 0x07; reg <= 0x16; reg++ )
+    {
+        pac.size[ reg ] = 2;
+    }
+    for ( uint8_t reg = 0x17; reg <= 0x1A; reg++ )
+    {
+        pac.size[ reg ] = 4;
+    }
+    pac.size[ 0x21 ] = ctrl_act_size;
+    pac.size[ 0x22 ] = ctrl_act_size;
+}
+
+static void fill_random ( uint8_t first, uint8_t last )
+{
+    for ( uint16_t reg = first; reg <= last; reg++ )
+    {
+        for ( uint8_t cnt = 0; cnt < pac.size[ reg ]; cnt++ )
+        {
+            pac.data[ reg ][ cnt ] = ( uint8_t ) rand( );
+        }
+    }
+}
+
+static int64_t raw_value ( const uint8_t *data_in, uint8_t n_bytes, uint8_t n_bits, uint8_t bipolar )
+{
+    uint64_t raw = 0;
+    for ( uint8_t cnt = 0; cnt < n_bytes; cnt++ )
+    {
+        raw = ( raw << 8 ) | data_in[ cnt ];
+    }
+    raw >>= n_bytes * 8 - n_bits;
+    if ( bipolar && ( raw >> ( n_bits - 1 ) ) )
+    {
+        return ( int64_t ) raw - ( ( int64_t ) 1 << n_bits );
+    }
+    return ( int64_t ) raw;
+}
+
+static void expect ( const char *name, const char *field, uint8_t ch, double value, double expected, double rel )
+{
+    if ( fabs( value - expected ) > rel * fabs( expected ) + 1e-9 )
+    {
+        if ( failures++ < 10 )
+        {
+            printf( "FAIL: %s %s of channel %u is %g, expected %g\n", name, field, ch + 1, value, expected );
+        }
+    }
+}
+
+static void report ( const char *name, uint32_t snap_tr, uint32_t snap_bytes, uint32_t poll_tr, uint32_t poll_bytes )
+{
+    printf( "%-34s snapshot %2u transactions / %3u bytes, per-channel poll %2u / %3u\n", name,
+            ( unsigned ) snap_tr, ( unsigned ) snap_bytes, ( unsigned ) poll_tr, ( unsigned ) poll_bytes );
+    if ( snap_tr > 2 )
+    {
+        printf( "FAIL: %s snapshot takes more than REFRESH_V and one block read\n", name );
+        failures++;
+    }
+}
+
+// Measurement mode of the power registers, from the Vbus and Vsense modes
+static uint8_t power_mode ( uint8_t vb_mode, uint8_t vs_mode )
+{
+    if ( ( vb_mode > 1 ) || ( vs_mode > 1 ) )
+    {
+        return 2;
+    }
+    return ( vb_mode || vs_mode ) ? 1 : 0;
+}
+
+// LSB weight of a 16 bit Vbus/Vsense or 30 bit power register in the given mode
+static double pac19x4_lsb ( double fsr, uint8_t n_bits, uint8_t mode )
+{
+    return fsr / ( double ) ( ( uint64_t ) 1 << ( mode ? n_bits - 1 : n_bits ) ) / ( ( mode > 1 ) ? 2 : 1 );
+}
+
+typedef struct
+{
+    const char *name;
+    uint8_t ch_off;         // bit 0 - CH1
+    uint8_t no_skip;
+    uint8_t vs_modes;       // NEG_PWR_FSR[15:8]
+    uint8_t vb_modes;       // NEG_PWR_FSR[7:0]
+    uint8_t acc_cfg;
+} pac19x4_case_t;
+
+static const pac19x4_case_t pac19x4_cases[ ] =
+{
+    { "all channels, default ranges", 0x0, 0, 0x60, 0x60, 0x00 },
+    { "CH2 and CH4 off, skipped", 0xA, 0, 0x90, 0x00, 0x18 },
+    { "CH3 off, not skipped", 0x4, 1, 0xA5, 0x5A, 0x24 },
+    { "CH1 only, half range", 0xE, 0, 0x80, 0x80, 0x40 },
+};
+
+// Fields shared by pac1954_snapshot_t and pac1944_snapshot_t
+typedef struct
+{
+    uint32_t acc_count;
+    float vbus[ 4 ], isense[ 4 ], vbus_avg[ 4 ], isense_avg[ 4 ], power[ 4 ], acc[ 4 ];
+} pac19x4_values_t;
+
+static void pac19x4_setup_regs ( const pac19x4_case_t *tc, uint8_t skip_off_bit )
+{
+    pac.skip = !tc->no_skip;
+    pac.ch_off = tc->ch_off;
+    pac.data[ 0x21 ][ 0 ] = 0;
+    pac.data[ 0x21 ][ 1 ] = 0;
+    for ( uint8_t ch = 0; ch < 4; ch++ )
+    {
+        if ( ( tc->ch_off >> ch ) & 1 )
+        {
+            pac.data[ 0x21 ][ 1 ] |= 0x80 >> ch;
+        }
+    }
+    pac.data[ 0x22 ][ 0 ] = tc->vs_modes;
+    pac.data[ 0x22 ][ 1 ] = tc->vb_modes;
+    pac.data[ 0x1C ][ 0 ] = tc->no_skip ? skip_off_bit : 0;
+    pac.data[ 0x4A ][ 0 ] = tc->acc_cfg;
+}
+
+static void pac19x4_check_acc ( const char *name, const pac19x4_case_t *tc, uint8_t ch, float value,
+                                double fsr_v, double fsr_i, double fsr_p )
+{
+    uint8_t shift = 6 - ch * 2;
+    uint8_t vs_mode = ( tc->vs_modes >> shift ) & 3;
+    uint8_t vb_mode = ( tc->vb_modes >> shift ) & 3;
+    uint8_t acc_mode = ( tc->acc_cfg >> shift ) & 3;
+    uint8_t mode;
+    double lsb;
+
+    if ( 1 == acc_mode )
+    {
+        mode = vs_mode;
+        lsb = pac19x4_lsb( fsr_i, 16, mode );
+    }
+    else if ( 2 == acc_mode )
+    {
+        mode = vb_mode;
+        lsb = pac19x4_lsb( fsr_v, 16, mode );
+    }
+    else
+    {
+        mode = power_mode( vb_mode, vs_mode );
+        lsb = pac19x4_lsb( fsr_p, 30, mode );
+    }
+    expect( name, "accumulator", ch, value, raw_value( pac.data[ 0x03 + ch ], 7, 56, mode != 0 ) * lsb, 1e-5 );
+}
+
+static void check_disabled ( const char *name, uint8_t ch_mask, const pac19x4_values_t *v )
+{
+    for ( uint8_t ch = 0; ch < 4; ch++ )
+    {
+        if ( !( ( ch_mask >> ch ) & 1 ) && ( v->vbus[ ch ] || v->isense[ ch ] || v->vbus_avg[ ch ] ||
+             v->isense_avg[ ch ] || v->power[ ch ] || v->acc[ ch ] ) )
+        {
+            printf( "FAIL: %s reports data for disabled channel %u\n", name, ch + 1 );
+            failures++;
+        }
+    }
+}
+
+#define COPY_SNAPSHOT( dst, src ) do { ( dst ).acc_count = ( src ).acc_count; \
+    memcpy( ( dst ).vbus, ( src ).vbus, sizeof( ( dst ).vbus ) ); \
+    memcpy( ( dst ).isense, ( src ).isense, sizeof( ( dst ).isense ) ); \
+    memcpy( ( dst ).vbus_avg, ( src ).vbus_avg, sizeof( ( dst ).vbus_avg ) ); \
+    memcpy( ( dst ).isense_avg, ( src ).isense_avg, sizeof( ( dst ).isense_avg ) ); \
+    memcpy( ( dst ).power, ( src ).power, sizeof( ( dst ).power ) ); \
+    memcpy( ( dst ).acc, ( src ).acc, sizeof( ( dst ).acc ) ); } while ( 0 )
+
+static void check_pac1954 ( const pac19x4_case_t *tc )
+{
+    static pac1954_t ctx;
+    pac1954_cfg_t cfg;
+    pac1954_snapshot_t snap;
+    pac19x4_values_t v;
+    char name[ 64 ];
+    uint32_t snap_tr = 0, snap_bytes = 0, poll_tr = 0, poll_bytes = 0;
+
+    snprintf( name, sizeof( name ), "PAC1954 %s", tc->name );
+    model_pac19xx( 4, 7, 2 );
+    pac1954_cfg_setup( &cfg );
+    pac1954_init( &ctx, &cfg );
+    pac19x4_setup_regs( tc, PAC1954_SMBUS_AUTO_INC_SKIP_OFF );
+    pac1954_snapshot_setup( &ctx );
+
+    for ( uint32_t run = 0; run < RUNS_PER_CONFIG; run++ )
+    {
+        fill_random( 0x02, 0x1A );
+        pac.transactions = pac.bytes = pac.refresh_v = 0;
+        pac1954_get_snapshot( &ctx, &snap );
+        snap_tr = pac.transactions;
+        snap_bytes = pac.bytes;
+        if ( 1 != pac.refresh_v )
+        {
+            printf( "FAIL: %s snapshot does not send REFRESH_V\n", name );
+            failures++;
+        }
+        COPY_SNAPSHOT( v, snap );
+
+        pac.transactions = pac.bytes = 0;
+        pac1954_vol_refresh_cmd( &ctx );
+        uint32_t acc_count = 0;
+        pac1954_get_acc_count( &ctx, &acc_count );
+        if ( ( acc_count != snap.acc_count ) || ( ( uint8_t ) ( ~tc->ch_off & 0x0F ) != snap.ch_mask ) )
+        {
+            printf( "FAIL: %s accumulator count or channel mask\n", name );
+            failures++;
+        }
+        for ( uint8_t ch = 0; ch < 4; ch++ )
+        {
+            uint8_t shift = 6 - ch * 2;
+            uint8_t vs_mode = ( tc->vs_modes >> shift ) & 3;
+            uint8_t vb_mode = ( tc->vb_modes >> shift ) & 3;
+            uint8_t acc_out[ 7 ];
+            float value;
+
+            if ( ( tc->ch_off >> ch ) & 1 )
+            {
+                continue;
+            }
+            pac1954_get_calc_measurement( &ctx, PAC1954_MEAS_SEL_V_SOURCE, ch + 1, PAC1954_AVG_SEL_DISABLE, vb_mode, &value );
+            expect( name, "vbus", ch, v.vbus[ ch ], value, 1e-5 );
+            pac1954_get_calc_measurement( &ctx, PAC1954_MEAS_SEL_I_SENSE, ch + 1, PAC1954_AVG_SEL_DISABLE, vs_mode, &value );
+            expect( name, "isense", ch, v.isense[ ch ], value, 1e-5 );
+            pac1954_get_calc_measurement( &ctx, PAC1954_MEAS_SEL_V_SOURCE, ch + 1, PAC1954_AVG_SEL_ENABLE, vb_mode, &value );
+            expect( name, "vbus average", ch, v.vbus_avg[ ch ], value, 1e-5 );
+            pac1954_get_calc_measurement( &ctx, PAC1954_MEAS_SEL_I_SENSE, ch + 1, PAC1954_AVG_SEL_ENABLE, vs_mode, &value );
+            expect( name, "isense average", ch, v.isense_avg[ ch ], value, 1e-5 );
+            pac1954_get_calc_measurement( &ctx, PAC1954_MEAS_SEL_P_SENSE, ch + 1, PAC1954_AVG_SEL_DISABLE,
+                                          power_mode( vb_mode, vs_mode ), &value );
+            expect( name, "power", ch, v.power[ ch ], value, 1e-5 );
+            pac1954_get_acc_output( &ctx, ch + 1, acc_out );
+            pac19x4_check_acc( name, tc, ch, v.acc[ ch ], 32, 25, 800 );
+        }
+        poll_tr = pac.transactions;
+        poll_bytes = pac.bytes;
+        check_disabled( name, snap.ch_mask, &v );
+    }
+    report( name, snap_tr, snap_bytes, poll_tr, poll_bytes );
+}
+
+static void check_pac1944 ( const pac19x4_case_t *tc )
+{
+    static pac1944_t ctx;
+    pac1944_cfg_t cfg;
+    pac1944_snapshot_t snap;
+    pac19x4_values_t v;
+    char name[ 64 ];
+    uint32_t snap_tr = 0, snap_bytes = 0, poll_tr = 0, poll_bytes = 0;
+
+    snprintf( name, sizeof( name ), "PAC1944 %s", tc->name );
+    model_pac19xx( 4, 7, 2 );
+    pac1944_cfg_setup( &cfg );
+    pac1944_init( &ctx, &cfg );
+    pac19x4_setup_regs( tc, PAC1944_SMBUS_AUTO_INC_SKIP_OFF );
+    pac1944_snapshot_setup( &ctx );
+
+    for ( uint32_t run = 0; run < RUNS_PER_CONFIG; run++ )
+    {
+        fill_random( 0x02, 0x1A );
+        pac.transactions = pac.bytes = pac.refresh_v = 0;
+        pac1944_get_snapshot( &ctx, &snap );
+        snap_tr = pac.transactions;
+        snap_bytes = pac.bytes;
+        if ( 1 != pac.refresh_v )
+        {
+            printf( "FAIL: %s snapshot does not send REFRESH_V\n", name );
+            failures++;
+        }
+        COPY_SNAPSHOT( v, snap );
+
+        pac.transactions = pac.bytes = 0;
+        pac1944_volatile_refresh_cmd( &ctx );
+        if ( ( pac1944_get_accumulator_count( &ctx ) != snap.acc_count ) ||
+             ( ( uint8_t ) ( ~tc->ch_off & 0x0F ) != snap.ch_mask ) )
+        {
+            printf( "FAIL: %s accumulator count or channel mask\n", name );
+            failures++;
+        }
+        for ( uint8_t ch = 0; ch < 4; ch++ )
+        {
+            uint8_t shift = 6 - ch * 2;
+            uint8_t vs_mode = ( tc->vs_modes >> shift ) & 3;
+            uint8_t vb_mode = ( tc->vb_modes >> shift ) & 3;
+            uint8_t acc_out[ 7 ];
+
+            if ( ( tc->ch_off >> ch ) & 1 )
+            {
+                continue;
+            }
+            expect( name, "vbus", ch, v.vbus[ ch ], pac1944_get_calc_measurement( &ctx, PAC1944_MEAS_SEL_V_SOURCE,
+                    ch + 1, PAC1944_AVG_SEL_DISABLE, vb_mode ), 1e-5 );
+            expect( name, "isense", ch, v.isense[ ch ], pac1944_get_calc_measurement( &ctx, PAC1944_MEAS_SEL_I_SENSE,
+                    ch + 1, PAC1944_AVG_SEL_DISABLE, vs_mode ), 1e-5 );
+            expect( name, "vbus average", ch, v.vbus_avg[ ch ], pac1944_get_calc_measurement( &ctx,
+                    PAC1944_MEAS_SEL_V_SOURCE, ch + 1, PAC1944_AVG_SEL_ENABLE, vb_mode ), 1e-5 );
+            expect( name, "isense average", ch, v.isense_avg[ ch ], pac1944_get_calc_measurement( &ctx,
+                    PAC1944_MEAS_SEL_I_SENSE, ch + 1, PAC1944_AVG_SEL_ENABLE, vs_mode ), 1e-5 );
+            expect( name, "power", ch, v.power[ ch ], pac1944_get_calc_measurement( &ctx, PAC1944_MEAS_SEL_P_SENSE,
+                    ch + 1, PAC1944_AVG_SEL_DISABLE, power_mode( vb_mode, vs_mode ) ), 1e-5 );
+            pac1944_get_accumulator_output( &ctx, ch + 1, acc_out );
+            pac19x4_check_acc( name, tc, ch, v.acc[ ch ], 9, 25, 225 );
+        }
+        poll_tr = pac.transactions;
+        poll_bytes = pac.bytes;
+        check_disabled( name, snap.ch_mask, &v );
+    }
+    report( name, snap_tr, snap_bytes, poll_tr, poll_bytes );
+}
+
+typedef struct
+{
+    const char *name;
+    uint8_t ch_off;
+    uint8_t no_skip;
+    uint8_t neg_pwr;        // BIDI[7:4], BIDV[3:0]
+} pac1934_case_t;
+
+static void check_pac1934 ( const pac1934_case_t *tc )
+{
+    static pac1934_t ctx;
+    pac1934_cfg_t cfg;
+    pac1934_snapshot_t snap;
+    char name[ 64 ];
+    uint32_t snap_tr = 0, snap_bytes = 0, poll_tr = 0, poll_bytes = 0;
+
+    snprintf( name, sizeof( name ), "PAC1934 %s", tc->name );
+    model_pac19xx( 3, 6, 1 );
+    pac1934_cfg_setup( &cfg );
+    pac1934_init( &ctx, &cfg );
+    pac.skip = !tc->no_skip;
+    pac.ch_off = tc->ch_off;
+    pac.data[ PAC1934_DIS_ACT ][ 0 ] = tc->no_skip ? PAC1934_CHANNEL_DIS_NO_SKIP : 0;
+    for ( uint8_t ch = 0; ch < 4; ch++ )
+    {
+        if ( ( tc->ch_off >> ch ) & 1 )
+        {
+            pac.data[ PAC1934_DIS_ACT ][ 0 ] |= PAC1934_CHANNEL_DIS_CH1_OFF >> ch;
+        }
+    }
+    pac.data[ PAC1934_NEG_PWR_ACT ][ 0 ] = tc->neg_pwr;
+    pac1934_snapshot_setup( &ctx );
+
+    for ( uint32_t run = 0; run < RUNS_PER_CONFIG; run++ )
+    {
+        fill_random( 0x02, 0x1A );
+        pac.transactions = pac.bytes = pac.refresh_v = 0;
+        pac1934_get_snapshot( &ctx, &snap );
+        snap_tr = pac.transactions;
+        snap_bytes = pac.bytes;
+        if ( 1 != pac.refresh_v )
+        {
+            printf( "FAIL: %s snapshot does not send REFRESH_V\n", name );
+            failures++;
+        }
+        uint32_t acc_count = ( ( uint32_t ) pac.data[ 0x02 ][ 0 ] << 16 ) | ( pac.data[ 0x02 ][ 1 ] << 8 ) | pac.data[ 0x02 ][ 2 ];
+        if ( ( acc_count != snap.acc_count ) || ( ( uint8_t ) ( ~tc->ch_off & 0x0F ) != snap.ch_mask ) )
+        {
+            printf( "FAIL: %s accumulator count or channel mask\n", name );
+            failures++;
+        }
+
+        pac.transactions = pac.bytes = 0;
+        pac1934_send_command( &ctx, PAC1934_REFRESH_V_CMD );
+        for ( uint8_t ch = 0; ch < 4; ch++ )
+        {
+            uint8_t bidi = ( tc->neg_pwr >> ( 7 - ch ) ) & 1;
+            uint8_t bidv = ( tc->neg_pwr >> ( 3 - ch ) ) & 1;
+            double lsb_v = bidv ? 32.0 / 0x8000 : 32.0 / 0xFFFF;
+            double lsb_i = bidi ? 25000.0 / 0x8000 : 25000.0 / 0xFFFF;
+            double lsb_p = ( bidv || bidi ) ? 0.0000059605 : 0.0000029802;
+
+            if ( ( tc->ch_off >> ch ) & 1 )
+            {
+                if ( snap.vbus[ ch ] || snap.isense[ ch ] || snap.power[ ch ] || snap.power_acc[ ch ] )
+                {
+                    printf( "FAIL: %s reports data for disabled channel %u\n", name, ch + 1 );
+                    failures++;
+                }
+                continue;
+            }
+            expect( name, "vbus", ch, snap.vbus[ ch ], raw_value( pac.data[ 0x07 + ch ], 2, 16, bidv ) * lsb_v, 1e-5 );
+            expect( name, "isense", ch, snap.isense[ ch ], raw_value( pac.data[ 0x0B + ch ], 2, 16, bidi ) * lsb_i, 1e-5 );
+            expect( name, "vbus average", ch, snap.vbus_avg[ ch ],
+                    raw_value( pac.data[ 0x0F + ch ], 2, 16, bidv ) * lsb_v, 1e-5 );
+            expect( name, "isense average", ch, snap.isense_avg[ ch ],
+                    raw_value( pac.data[ 0x13 + ch ], 2, 16, bidi ) * lsb_i, 1e-5 );
+            expect( name, "power", ch, snap.power[ ch ],
+                    raw_value( pac.data[ 0x17 + ch ], 4, 28, bidv || bidi ) * lsb_p, 1e-5 );
+            expect( name, "accumulated power", ch, snap.power_acc[ ch ],
+                    raw_value( pac.data[ 0x03 + ch ], 6, 48, bidv || bidi ) * lsb_p, 1e-5 );
+
+            float voltage = pac1934_measure_voltage( &ctx, ch + 1 );
+            float current = pac1934_measure_current( &ctx, ch + 1 );
+            float power = pac1934_measure_power( &ctx, ch + 1 );
+            float energy = pac1934_measure_energy( &ctx, ch + 1, 1024 );
+
+            // The per-channel functions only handle unipolar data
+            if ( !bidi && !bidv )
+            {
+                expect( name, "vbus", ch, snap.vbus[ ch ], voltage, 1e-5 );
+                expect( name, "isense", ch, snap.isense[ ch ], current, 1e-5 );
+                expect( name, "power", ch, snap.power[ ch ], power, 1e-5 );
+                expect( name, "energy", ch, snap.power_acc[ ch ] / 1024, energy, 1e-3 );
+            }
+        }
+        poll_tr = pac.transactions;
+        poll_bytes = pac.bytes;
+    }
+    report( name, snap_tr, snap_bytes, poll_tr, poll_bytes );
+}
+
+static void check_pac1720 ( pac1720_sample_time_t vsrc_stime, pac1720_sample_time_t vsense_stime, pac1720_cs_rng_t range )
+{
+    static pac1720_t ctx;
+    pac1720_cfg_t cfg;
+    pac1720_snapshot_t snap;
+    char name[ 64 ];
+    uint32_t snap_tr = 0, snap_bytes = 0, poll_tr = 0, poll_bytes = 0;
+
+    snprintf( name, sizeof( name ), "PAC1720 sample times %u/%u, range %u", vsrc_stime, vsense_stime, range );
+    memset( &pac, 0, sizeof( pac ) );
+    memset( pac.size, 1, sizeof( pac.size ) );
+    pac1720_cfg_setup( &cfg );
+    pac1720_init( &ctx, &cfg );
+    pac1720_set_vsource_config( &ctx, PAC1720_CHANNEL_1, vsrc_stime, PAC1720_AVG_DISABLE );
+    pac1720_set_vsource_config( &ctx, PAC1720_CHANNEL_2, vsrc_stime, PAC1720_AVG_2_SAMPLES );
+    pac1720_set_vsense_config( &ctx, PAC1720_CHANNEL_1, vsense_stime, PAC1720_AVG_DISABLE, range );
+    pac1720_set_vsense_config( &ctx, PAC1720_CHANNEL_2, vsense_stime, PAC1720_AVG_4_SAMPLES, range );
+
+    for ( uint32_t run = 0; run < RUNS_PER_CONFIG; run++ )
+    {
+        fill_random( PAC1720_REG_CH1_VSENSE_HIGH_BYTE, PAC1720_REG_CH2_POWER_RATIO_LOW_BYTE );
+        pac.transactions = pac.bytes = 0;
+        pac1720_get_snapshot( &ctx, &snap );
+        snap_tr = pac.transactions;
+        snap_bytes = pac.bytes;
+
+        pac.transactions = pac.bytes = 0;
+        for ( uint8_t ch = 0; ch < PAC1720_NUM_CH; ch++ )
+        {
+            float voltage, current, power;
+            pac1720_get_measurements( &ctx, PAC1720_CHANNEL_1 + ch, &voltage, &current, &power );
+            expect( name, "voltage", ch, snap.voltage[ ch ], voltage, 1e-5 );
+            expect( name, "current", ch, snap.current[ ch ], current, 1e-5 );
+            expect( name, "power", ch, snap.power[ ch ], power, 1e-5 );
+        }
+        poll_tr = pac.transactions;
+        poll_bytes = pac.bytes;
+    }
+    report( name, snap_tr, snap_bytes, poll_tr, poll_bytes );
+}
+
+int main ( void )
+{
+    static const pac1934_case_t pac1934_cases[ ] =
+    {
+        { "all channels, unipolar", 0x0, 0, 0x00 },
+        { "CH2 off, skipped, bipolar", 0x2, 0, 0xA5 },
+        { "CH4 off, not skipped", 0x8, 1, 0x10 },
+    };
+
+    hal_sim_reset( );
+    hal_sim_i2c_transfer = pac_transfer;
+    srand( 14 );
+
+    for ( uint8_t cnt = 0; cnt < sizeof( pac19x4_cases ) / sizeof( pac19x4_cases[ 0 ] ); cnt++ )
+    {
+        check_pac1954( &pac19x4_cases[ cnt ] );
+    }
+    for ( uint8_t cnt = 0; cnt < sizeof( pac19x4_cases ) / sizeof( pac19x4_cases[ 0 ] ); cnt++ )
+    {
+        check_pac1944( &pac19x4_cases[ cnt ] );
+    }
+    for ( uint8_t cnt = 0; cnt < sizeof( pac1934_cases ) / sizeof( pac1934_cases[ 0 ] ); cnt++ )
+    {
+        check_pac1934( &pac1934_cases[ cnt ] );
+    }
+    check_pac1720( PAC1720_SAMPLE_TIME_2p5mS, PAC1720_SAMPLE_TIME_80mS, PAC1720_CS_RANGE_10mV );
+    check_pac1720( PAC1720_SAMPLE_TIME_20mS, PAC1720_SAMPLE_TIME_10mS, PAC1720_CS_RANGE_80mV );
+    check_pac1720( PAC1720_SAMPLE_TIME_10mS, PAC1720_SAMPLE_TIME_320mS, PAC1720_CS_RANGE_20mV );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
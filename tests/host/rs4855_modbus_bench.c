@@ -0,0 +1,420 @@
+/*
+ * Modbus RTU requests-per-second benchmark for the RS485 5 click engine.
+ *
+ * One master and two loopback slaves run the real rs4855 glue and
+ * rs4855_modbus engine on a simulated half-duplex bus. Characters leave a
+ * UART one character time after each other and reach every other node only
+ * while the sender drives DE, so a missing direction switch shows up as lost
+ * bytes. The timer ISR is modelled by calling rs4855_modbus_tick every TICK_US.
+ *
+ * The master keeps the request queue full with FC3 reads alternating between
+ * the two slaves and checks every returned register. The result is compared
+ * with the bus limit of back-to-back transactions separated by t3.5.
+ * A functional pass then exercises function codes 1, 2, 5, 6, 15, 16, 23,
+ * an exception response and a broadcast write.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "rs4855.h"
+
+#define BAUD_RATE       115200ul
+#define TICK_US         50
+#define RUN_SECONDS     10
+#define NUM_NODES       3
+#define FIFO_SIZE       512
+#define READ_REGS       10
+
+typedef struct
+{
+    uint8_t buf[ FIFO_SIZE ];
+    uint16_t head;
+    uint16_t cnt;
+
+} fifo_t;
+
+typedef struct
+{
+    rs4855_t ctx;
+    fifo_t tx;
+    fifo_t rx;
+    double shift_us;        /* Time left until the character in the shifter is on the wire. */
+
+} node_t;
+
+static node_t nodes[ NUM_NODES ];
+static double char_us;
+static uint32_t lost_bytes;
+static uint32_t collisions;
+static uint32_t bad_data;
+
+static void fifo_put ( fifo_t *f, uint8_t data_in )
+{
+    if ( f->cnt < FIFO_SIZE )
+    {
+        f->buf[ ( f->head + f->cnt ) % FIFO_SIZE ] = data_in;
+        f->cnt++;
+    }
+}
+
+static uint8_t fifo_get ( fifo_t *f )
+{
+    uint8_t data_out = f->buf[ f->head ];
+    f->head = ( f->head + 1 ) % FIFO_SIZE;
+    f->cnt--;
+    return data_out;
+}
+
+static node_t *node_of_uart ( void *obj )
+{
+    for ( int cnt = 0; cnt < NUM_NODES; cnt++ )
+    {
+        if ( obj == &nodes[ cnt ].ctx.uart )
+        {
+            return &nodes[ cnt ];
+        }
+    }
+    abort( );
+}
+
+static err_t sim_uart_write ( void *obj, char *buffer, size_t size )
+{
+    node_t *node = node_of_uart( obj );
+    size_t len = 0;
+    while ( ( len < size ) && ( node->tx.cnt < FIFO_SIZE ) )
+    {
+        if ( 0 == node->tx.cnt )
+        {
+            node->shift_us = char_us;
+        }
+        fifo_put( &node->tx, ( uint8_t ) buffer[ len++ ] );
+    }
+    return ( err_t ) len;
+}
+
+static err_t sim_uart_read ( void *obj, char *buffer, size_t size )
+{
+    node_t *node = node_of_uart( obj );
+    size_t len = 0;
+    while ( ( len < size ) && node->rx.cnt )
+    {
+        buffer[ len++ ] = ( char ) fifo_get( &node->rx );
+    }
+    return ( err_t ) len;
+}
+
+static size_t sim_uart_bytes_available ( void *obj )
+{
+    return node_of_uart( obj )->rx.cnt;
+}
+
+/* Advances the wire by one tick and delivers finished characters. */
+static void wire_step ( double step_us )
+{
+    int driving = 0;
+    for ( int cnt = 0; cnt < NUM_NODES; cnt++ )
+    {
+        if ( nodes[ cnt ].tx.cnt )
+        {
+            driving++;
+        }
+    }
+    if ( driving > 1 )
+    {
+        collisions++;
+    }
+    for ( int cnt = 0; cnt < NUM_NODES; cnt++ )
+    {
+        node_t *node = &nodes[ cnt ];
+        double left = step_us;
+        while ( node->tx.cnt && ( node->shift_us <= left ) )
+        {
+            uint8_t data_out = fifo_get( &node->tx );
+            left -= node->shift_us;
+            node->shift_us = char_us;
+            if ( !node->ctx.de.state )
+            {
+                lost_bytes++;
+                continue;
+            }
+            for ( int dst = 0; dst < NUM_NODES; dst++ )
+            {
+                if ( dst != cnt )
+                {
+                    fifo_put( &nodes[ dst ].rx, data_out );
+                }
+            }
+        }
+        if ( node->tx.cnt )
+        {
+            node->shift_us -= left;
+        }
+    }
+}
+
+static void sim_step ( void )
+{
+    wire_step( TICK_US );
+    hal_sim_time_us += TICK_US;
+    for ( int cnt = 0; cnt < NUM_NODES; cnt++ )
+    {
+        rs4855_modbus_tick( &nodes[ cnt ].ctx.modbus );
+    }
+    for ( int cnt = 0; cnt < NUM_NODES; cnt++ )
+    {
+        rs4855_modbus_process( &nodes[ cnt ].ctx.modbus );
+    }
+}
+
+static uint16_t slave_holding[ NUM_NODES ][ 64 ];
+static uint16_t slave_input[ NUM_NODES ][ 16 ];
+static uint8_t slave_coils[ NUM_NODES ][ 8 ];
+static uint8_t slave_discrete[ NUM_NODES ][ 4 ];
+static rs4855_modbus_map_t slave_map[ NUM_NODES ];
+
+static void setup_nodes ( void )
+{
+    hal_sim_reset( );
+    hal_sim_uart_write = sim_uart_write;
+    hal_sim_uart_read = sim_uart_read;
+    hal_sim_uart_bytes_available = sim_uart_bytes_available;
+    memset( nodes, 0, sizeof( nodes ) );
+    char_us = 11e6 / BAUD_RATE;
+    for ( int cnt = 0; cnt < NUM_NODES; cnt++ )
+    {
+        rs4855_cfg_t cfg;
+        rs4855_cfg_setup( &cfg );
+        cfg.baud_rate = BAUD_RATE;
+        rs4855_init( &nodes[ cnt ].ctx, &cfg );
+        if ( cnt )
+        {
+            for ( int reg = 0; reg < 64; reg++ )
+            {
+                slave_holding[ cnt ][ reg ] = ( uint16_t ) ( cnt * 1000 + reg );
+            }
+            for ( int reg = 0; reg < 16; reg++ )
+            {
+                slave_input[ cnt ][ reg ] = ( uint16_t ) ( cnt * 2000 + reg );
+            }
+            memset( slave_coils[ cnt ], 0, sizeof( slave_coils[ cnt ] ) );
+            slave_discrete[ cnt ][ 0 ] = 0xA5;
+            slave_discrete[ cnt ][ 1 ] = ( uint8_t ) cnt;
+            slave_map[ cnt ].coils = slave_coils[ cnt ];
+            slave_map[ cnt ].n_coils = 64;
+            slave_map[ cnt ].discrete = slave_discrete[ cnt ];
+            slave_map[ cnt ].n_discrete = 32;
+            slave_map[ cnt ].holding = slave_holding[ cnt ];
+            slave_map[ cnt ].n_holding = 64;
+            slave_map[ cnt ].input = slave_input[ cnt ];
+            slave_map[ cnt ].n_input = 16;
+        }
+        if ( RS4855_OK != rs4855_modbus_init( &nodes[ cnt ].ctx, BAUD_RATE, TICK_US, ( uint8_t ) cnt,
+                                              cnt ? &slave_map[ cnt ] : NULL ) )
+        {
+            printf( "FAIL: rs4855_modbus_init node %d\n", cnt );
+            exit( 1 );
+        }
+    }
+}
+
+static rs4855_modbus_req_t bench_req[ RS4855_MODBUS_QUEUE_SIZE ];
+static uint16_t bench_regs[ RS4855_MODBUS_QUEUE_SIZE ][ READ_REGS ];
+
+static void bench_done ( rs4855_modbus_req_t *req )
+{
+    int idx = ( int ) ( req - bench_req );
+    if ( RS4855_MODBUS_STATUS_OK == req->status )
+    {
+        for ( int reg = 0; reg < READ_REGS; reg++ )
+        {
+            if ( bench_regs[ idx ][ reg ] != ( uint16_t ) ( req->slave * 1000 + req->address + reg ) )
+            {
+                bad_data++;
+                break;
+            }
+        }
+    }
+    memset( bench_regs[ idx ], 0, sizeof( bench_regs[ idx ] ) );
+    req->address = ( uint16_t ) ( ( req->address + 7 ) % ( 64 - READ_REGS ) );
+    rs4855_modbus_submit( &nodes[ 0 ].ctx.modbus, req );
+}
+
+static int run_benchmark ( void )
+{
+    rs4855_modbus_t *master = &nodes[ 0 ].ctx.modbus;
+    double t35_us = ( BAUD_RATE > 19200 ) ? 1750.0 : 3.5 * char_us;
+    double transaction_us;
+    double bus_limit;
+    double rate;
+
+    setup_nodes( );
+    for ( int cnt = 0; cnt < RS4855_MODBUS_QUEUE_SIZE; cnt++ )
+    {
+        memset( &bench_req[ cnt ], 0, sizeof( rs4855_modbus_req_t ) );
+        bench_req[ cnt ].slave = ( uint8_t ) ( 1 + ( cnt % 2 ) );
+        bench_req[ cnt ].function = RS4855_MODBUS_FC_READ_HOLDING_REGISTERS;
+        bench_req[ cnt ].address = ( uint16_t ) cnt;
+        bench_req[ cnt ].quantity = READ_REGS;
+        bench_req[ cnt ].regs = bench_regs[ cnt ];
+        bench_req[ cnt ].done = bench_done;
+        if ( RS4855_MODBUS_OK != rs4855_modbus_submit( master, &bench_req[ cnt ] ) )
+        {
+            printf( "FAIL: submit\n" );
+            return 1;
+        }
+    }
+    while ( hal_sim_time_us < RUN_SECONDS * 1000000ull )
+    {
+        sim_step( );
+    }
+
+    // Request (8 bytes) and response (5 + 2N bytes), each followed by t3.5
+    transaction_us = ( 8 + 5 + 2 * READ_REGS ) * char_us + 2 * t35_us;
+    bus_limit = 1e6 / transaction_us;
+    rate = ( double ) master->n_done / RUN_SECONDS;
+    printf( "FC3 x%d regs, 2 slaves, %lu baud, %d us tick: %.1f requests/s "
+            "(bus limit %.1f, %.0f%%), errors %u, bad data %u, collisions %u, lost bytes %u\n",
+            READ_REGS, ( unsigned long ) BAUD_RATE, TICK_US, rate, bus_limit, 100.0 * rate / bus_limit,
+            ( unsigned ) master->n_error, ( unsigned ) bad_data, ( unsigned ) collisions, ( unsigned ) lost_bytes );
+
+    if ( master->n_error || bad_data || collisions || lost_bytes || ( rate < 0.85 * bus_limit ) )
+    {
+        printf( "FAIL: benchmark\n" );
+        return 1;
+    }
+    return 0;
+}
+
+static uint8_t run_request ( rs4855_modbus_req_t *req )
+{
+    if ( RS4855_MODBUS_OK != rs4855_modbus_submit( &nodes[ 0 ].ctx.modbus, req ) )
+    {
+        return 0xEE;
+    }
+    while ( RS4855_MODBUS_STATUS_PENDING == req->status )
+    {
+        sim_step( );
+    }
+    return req->status;
+}
+
+#define CHECK( cond, what ) \
+    do { if ( !( cond ) ) { printf( "FAIL: %s\n", what ); return 1; } } while ( 0 )
+
+static int run_functional ( void )
+{
+    rs4855_modbus_req_t req;
+    uint16_t regs[ 8 ];
+    uint16_t wr_regs[ 4 ] = { 0x1111, 0x2222, 0x3333, 0x4444 };
+    uint8_t bits[ 4 ];
+
+    setup_nodes( );
+
+    memset( &req, 0, sizeof( req ) );
+    req.slave = 2;
+    req.function = RS4855_MODBUS_FC_READ_INPUT_REGISTERS;
+    req.address = 3;
+    req.quantity = 2;
+    req.regs = regs;
+    CHECK( RS4855_MODBUS_STATUS_OK == run_request( &req ), "FC4 status" );
+    CHECK( ( 4003 == regs[ 0 ] ) && ( 4004 == regs[ 1 ] ), "FC4 data" );
+
+    memset( &req, 0, sizeof( req ) );
+    bits[ 0 ] = 1;
+    req.slave = 1;
+    req.function = RS4855_MODBUS_FC_WRITE_SINGLE_COIL;
+    req.address = 9;
+    req.bits = bits;
+    CHECK( RS4855_MODBUS_STATUS_OK == run_request( &req ), "FC5 status" );
+    CHECK( 0x02 == slave_coils[ 1 ][ 1 ], "FC5 data" );
+
+    memset( &req, 0, sizeof( req ) );
+    bits[ 0 ] = 0x0F;
+    bits[ 1 ] = 0x01;
+    req.slave = 1;
+    req.function = RS4855_MODBUS_FC_WRITE_MULTIPLE_COILS;
+    req.address = 16;
+    req.quantity = 9;
+    req.bits = bits;
+    CHECK( RS4855_MODBUS_STATUS_OK == run_request( &req ), "FC15 status" );
+    CHECK( ( 0x0F == slave_coils[ 1 ][ 2 ] ) && ( 0x01 == slave_coils[ 1 ][ 3 ] ), "FC15 data" );
+
+    memset( &req, 0, sizeof( req ) );
+    memset( bits, 0, sizeof( bits ) );
+    req.slave = 1;
+    req.function = RS4855_MODBUS_FC_READ_COILS;
+    req.address = 8;
+    req.quantity = 17;
+    req.bits = bits;
+    CHECK( RS4855_MODBUS_STATUS_OK == run_request( &req ), "FC1 status" );
+    CHECK( ( 0x02 == bits[ 0 ] ) && ( 0x0F == bits[ 1 ] ) && ( 0x01 == bits[ 2 ] ), "FC1 data" );
+
+    memset( &req, 0, sizeof( req ) );
+    memset( bits, 0, sizeof( bits ) );
+    req.slave = 2;
+    req.function = RS4855_MODBUS_FC_READ_DISCRETE_INPUTS;
+    req.address = 4;
+    req.quantity = 8;
+    req.bits = bits;
+    CHECK( RS4855_MODBUS_STATUS_OK == run_request( &req ), "FC2 status" );
+    CHECK( 0x2A == bits[ 0 ], "FC2 data" );
+
+    memset( &req, 0, sizeof( req ) );
+    regs[ 0 ] = 0xBEEF;
+    req.slave = 2;
+    req.function = RS4855_MODBUS_FC_WRITE_SINGLE_REGISTER;
+    req.address = 5;
+    req.regs = regs;
+    CHECK( RS4855_MODBUS_STATUS_OK == run_request( &req ), "FC6 status" );
+    CHECK( 0xBEEF == slave_holding[ 2 ][ 5 ], "FC6 data" );
+
+    memset( &req, 0, sizeof( req ) );
+    req.slave = 1;
+    req.function = RS4855_MODBUS_FC_WRITE_MULTIPLE_REGS;
+    req.address = 40;
+    req.quantity = 4;
+    req.regs = wr_regs;
+    CHECK( RS4855_MODBUS_STATUS_OK == run_request( &req ), "FC16 status" );
+    CHECK( ( 0x1111 == slave_holding[ 1 ][ 40 ] ) && ( 0x4444 == slave_holding[ 1 ][ 43 ] ), "FC16 data" );
+
+    memset( &req, 0, sizeof( req ) );
+    req.slave = 1;
+    req.function = RS4855_MODBUS_FC_READ_WRITE_REGS;
+    req.address = 41;
+    req.quantity = 3;
+    req.regs = regs;
+    req.wr_address = 42;
+    req.wr_quantity = 1;
+    req.wr_regs = &wr_regs[ 3 ];
+    CHECK( RS4855_MODBUS_STATUS_OK == run_request( &req ), "FC23 status" );
+    CHECK( ( 0x2222 == regs[ 0 ] ) && ( 0x4444 == regs[ 1 ] ) && ( 0x4444 == regs[ 2 ] ), "FC23 data" );
+
+    memset( &req, 0, sizeof( req ) );
+    req.slave = 2;
+    req.function = RS4855_MODBUS_FC_READ_HOLDING_REGISTERS;
+    req.address = 60;
+    req.quantity = 8;
+    req.regs = regs;
+    CHECK( RS4855_MODBUS_STATUS_ILLEGAL_ADDRESS == run_request( &req ), "exception response" );
+
+    memset( &req, 0, sizeof( req ) );
+    regs[ 0 ] = 0x5A5A;
+    req.slave = 0;
+    req.function = RS4855_MODBUS_FC_WRITE_SINGLE_REGISTER;
+    req.address = 0;
+    req.regs = regs;
+    CHECK( RS4855_MODBUS_STATUS_OK == run_request( &req ), "broadcast status" );
+    CHECK( ( 0x5A5A == slave_holding[ 1 ][ 0 ] ) && ( 0x5A5A == slave_holding[ 2 ][ 0 ] ), "broadcast data" );
+
+    CHECK( !collisions && !lost_bytes, "bus errors in functional pass" );
+    printf( "functional pass: FC1-6, 15, 16, 23, exception and broadcast OK\n" );
+    return 0;
+}
+
+int main ( void )
+{
+    if ( run_benchmark( ) )
+    {
+        return 1;
+    }
+    return run_functional( );
+}
@@ -0,0 +1,419 @@
+/*
+ * RTC time and date reads: bus transactions and torn timestamps.
+ *
+ * RTC 10 runs against a DS3231M model whose time follows the simulated
+ * clock. Like the real device it latches the time registers at the start
+ * of each transaction, and every transaction takes its 100 kHz bus time.
+ * Timestamps are taken around a year rollover both with the per-field
+ * getters the driver used before, seven transactions, and with the single
+ * burst snapshot. A timestamp is torn when it matches neither the time
+ * at the start nor the time at the end of the read.
+ *
+ * The Unix conversion is compared with timegm for every day it covers,
+ * and the burst get_time/get_date of RTC, RTC 2, 5, 9, 11, 12, 13 and 14
+ * must each be one I2C transaction or one SPI chip select frame. For RTC,
+ * RTC 5 and RTC 9 the burst results are also decoded from a register
+ * image and compared with the per-field getters or the expected values.
+ */
+#define _DEFAULT_SOURCE
+#include "rtc.h"
+#include "rtc2.h"
+#include "rtc5.h"
+#include "rtc9.h"
+#include "rtc10.h"
+#include "rtc11.h"
+#include "rtc12.h"
+#include "rtc13.h"
+#include "rtc14.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define I2C_BIT_US          10
+#define SWEEP_RUNS          5000
+
+static time_t epoch_at_zero;
+static uint8_t reg_ptr;
+static uint32_t transactions;
+static uint8_t family_regs[ 32 ];
+
+static uint8_t dec_to_bcd ( int value )
+{
+    return ( uint8_t ) ( ( ( value / 10 ) << 4 ) | ( value % 10 ) );
+}
+
+static time_t device_time ( void )
+{
+    return epoch_at_zero + ( time_t ) ( hal_sim_time_us / 1000000 );
+}
+
+static err_t ds3231_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                               uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    ( void ) address;
+    uint8_t regs[ 7 ];
+    struct tm tm;
+    time_t now = device_time( );
+
+    transactions++;
+    gmtime_r( &now, &tm );
+    regs[ 0 ] = dec_to_bcd( tm.tm_sec );
+    regs[ 1 ] = dec_to_bcd( tm.tm_min );
+    regs[ 2 ] = dec_to_bcd( tm.tm_hour );
+    regs[ 3 ] = ( uint8_t ) ( tm.tm_wday + 1 );
+    regs[ 4 ] = dec_to_bcd( tm.tm_mday );
+    regs[ 5 ] = dec_to_bcd( tm.tm_mon + 1 ) | ( ( tm.tm_year >= 200 ) ? 0x80 : 0x00 );
+    regs[ 6 ] = dec_to_bcd( tm.tm_year % 100 );
+
+    if ( write_len )
+    {
+        reg_ptr = write_buf[ 0 ];
+    }
+    for ( size_t cnt = 0; cnt < read_len; cnt++, reg_ptr++ )
+    {
+        read_buf[ cnt ] = ( reg_ptr < sizeof( regs ) ) ? regs[ reg_ptr ] : 0;
+    }
+
+    // Address byte, data bytes and a repeated start address for the read, 9 bits each
+    hal_sim_time_us += ( 1 + write_len + ( read_len ? 1 + read_len : 0 ) ) * 9 * I2C_BIT_US;
+    return I2C_MASTER_SUCCESS;
+}
+
+static err_t count_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                              uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    ( void ) address;
+    transactions++;
+    if ( write_len )
+    {
+        reg_ptr = write_buf[ 0 ];
+    }
+    for ( size_t cnt = 0; cnt < read_len; cnt++ )
+    {
+        read_buf[ cnt ] = family_regs[ ( reg_ptr + cnt ) % sizeof( family_regs ) ];
+    }
+    return I2C_MASTER_SUCCESS;
+}
+
+// RTC 5, 11, 12 and 13 are SPI parts, one transaction is one chip select frame
+static void count_select ( pin_name_t cs, uint8_t selected )
+{
+    ( void ) cs;
+    if ( selected )
+    {
+        transactions++;
+        reg_ptr = 0;
+    }
+}
+
+// The RTC 5 read instruction is followed by the register address
+static err_t count_spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    if ( size >= 2 )
+    {
+        reg_ptr = buffer[ 1 ];
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+static err_t count_spi_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    for ( size_t cnt = 0; cnt < size; cnt++ )
+    {
+        buffer[ cnt ] = family_regs[ reg_ptr++ % sizeof( family_regs ) ];
+    }
+    return SPI_MASTER_SUCCESS;
+}
+
+// Burst results against the per-field getters on the same register image
+static int check_decode ( void )
+{
+    static rtc_c_t rtc;
+    static rtc5_t rtc5;
+    static rtc9_t rtc9;
+    rtc5_timedate_t rtc5_td;
+    rtc9_get_time_t rtc9_time;
+    rtc9_get_date_t rtc9_date;
+    int failures = 0;
+
+    // RTC: hundredths 47, 23:29:38, day 17 with year bits, Friday November, year 26 in the timer register
+    static const uint8_t rtc_regs[ ] = { 0x00, 0x47, 0x38, 0x29, 0x23, 0x57, 0xB1, 0x26 };
+    memset( family_regs, 0, sizeof( family_regs ) );
+    memcpy( family_regs, rtc_regs, sizeof( rtc_regs ) );
+    rtc_c_get_time( &rtc );
+    rtc_c_get_date( &rtc );
+    if ( ( rtc.time.time_hun_sec != rtc_c_get_time_value( &rtc, RTC_C_REG_TIME_HUN_SEC ) ) ||
+         ( rtc.time.time_seconds != rtc_c_get_time_value( &rtc, RTC_C_REG_TIME_SEC ) ) ||
+         ( rtc.time.time_minutes != rtc_c_get_time_value( &rtc, RTC_C_REG_TIME_MIN ) ) ||
+         ( rtc.time.time_hours != rtc_c_get_time_value( &rtc, RTC_C_REG_TIME_HOUR ) ) ||
+         ( rtc.date.date_day != rtc_c_get_date_day( &rtc ) ) ||
+         ( rtc.date.day_of_the_week != rtc_c_get_day_of_the_week( &rtc ) ) ||
+         ( rtc.date.date_month != rtc_c_get_date_month( &rtc ) ) ||
+         ( rtc.date.date_year != rtc_c_get_date_year( &rtc ) ) || ( 23 != rtc.time.time_hours ) ||
+         ( 26 != rtc.date.date_year ) )
+    {
+        printf( "FAIL: rtc_c burst reads %02u:%02u:%02u.%02u %u %02u.%02u.%02u\n", rtc.time.time_hours,
+                rtc.time.time_minutes, rtc.time.time_seconds, rtc.time.time_hun_sec, rtc.date.day_of_the_week,
+                rtc.date.date_day, rtc.date.date_month, rtc.date.date_year );
+        failures++;
+    }
+
+    // RTC 5: 12:59:45 with ST set, Thursday with VBATEN set, 31.12.25 with the leap year bit
+    static const uint8_t rtc5_regs[ ] = { 0x00, 0xC5, 0x59, 0x12, 0x0C, 0x31, 0x32, 0x25 };
+    memset( family_regs, 0, sizeof( family_regs ) );
+    memcpy( family_regs, rtc5_regs, sizeof( rtc5_regs ) );
+    rtc5_get_time_and_date( &rtc5, &rtc5_td );
+    if ( ( rtc5_td.sec != rtc5_get_time_sec( &rtc5 ) ) || ( rtc5_td.min != rtc5_get_time_min( &rtc5 ) ) ||
+         ( rtc5_td.hours != rtc5_get_time_hours( &rtc5 ) ) ||
+         ( rtc5_td.w_day != rtc5_get_day_of_the_week( &rtc5 ) ) ||
+         ( rtc5_td.day != rtc5_get_date_day( &rtc5 ) ) || ( rtc5_td.month != rtc5_get_date_month( &rtc5 ) ) ||
+         ( rtc5_td.year != rtc5_get_date_year( &rtc5 ) ) || ( 45 != rtc5_td.sec ) || ( 25 != rtc5_td.year ) )
+    {
+        printf( "FAIL: rtc5 burst reads %02u:%02u:%02u %u %02u.%02u.%02u\n", rtc5_td.hours, rtc5_td.min,
+                rtc5_td.sec, rtc5_td.w_day, rtc5_td.day, rtc5_td.month, rtc5_td.year );
+        failures++;
+    }
+
+    // RTC 9: 19:07:53.86 with ST and century bits set, Tuesday 29.02.24
+    static const uint8_t rtc9_regs[ ] = { 0x86, 0xD3, 0x07, 0xD9, 0x02, 0x29, 0x02, 0x24 };
+    memset( family_regs, 0, sizeof( family_regs ) );
+    memcpy( family_regs, rtc9_regs, sizeof( rtc9_regs ) );
+    rtc9_get_time( &rtc9, &rtc9_time );
+    rtc9_get_date( &rtc9, &rtc9_date );
+    if ( ( 86 != rtc9_time.part_sec ) || ( 53 != rtc9_time.sec ) || ( 7 != rtc9_time.min ) ||
+         ( 19 != rtc9_time.hour ) || ( 2 != rtc9_date.day_of_week ) || ( 29 != rtc9_date.day ) ||
+         ( 2 != rtc9_date.month ) || ( 24 != rtc9_date.year ) )
+    {
+        printf( "FAIL: rtc9 burst reads %02u:%02u:%02u.%02u %u %02u.%02u.%02u\n", rtc9_time.hour, rtc9_time.min,
+                rtc9_time.sec, rtc9_time.part_sec, rtc9_date.day_of_week, rtc9_date.day, rtc9_date.month,
+                rtc9_date.year );
+        failures++;
+    }
+
+    if ( !failures )
+    {
+        printf( "RTC, RTC 5 and RTC 9 burst reads decode like the per-field getters\n" );
+    }
+    return failures;
+}
+
+// The field by field read that get_time and get_date did before the burst
+static uint32_t legacy_unix_time ( rtc10_t *ctx )
+{
+    rtc10_timestamp_t ts;
+
+    ts.hours = rtc10_get_time_hours( ctx );
+    ts.minutes = rtc10_get_time_minutes( ctx );
+    ts.seconds = rtc10_get_time_seconds( ctx );
+    ts.day_of_the_week = rtc10_get_day_of_the_week( ctx );
+    ts.date_day = rtc10_get_date_day( ctx );
+    ts.date_month = rtc10_get_date_month( ctx );
+    ts.date_year = 2000 + rtc10_get_date_year( ctx );
+    return rtc10_timestamp_to_unix( &ts );
+}
+
+static uint32_t snapshot_unix_time ( rtc10_t *ctx )
+{
+    return rtc10_get_unix_time( ctx );
+}
+
+static int sweep ( rtc10_t *ctx, const char *name, uint32_t ( *get )( rtc10_t *ctx ), uint32_t *torn )
+{
+    uint64_t bus_us = 0;
+    uint32_t calls = 0;
+
+    *torn = 0;
+    transactions = 0;
+    srand( 7 );
+    for ( uint32_t run = 0; run < SWEEP_RUNS; run++ )
+    {
+        // Start anywhere in the last second of the year
+        hal_sim_time_us = ( uint64_t ) ( rand( ) % 1000000 );
+        time_t before = device_time( );
+        uint64_t start = hal_sim_time_us;
+        uint32_t value = get( ctx );
+        bus_us += hal_sim_time_us - start;
+        calls++;
+        if ( ( value != ( uint32_t ) before ) && ( value != ( uint32_t ) device_time( ) ) )
+        {
+            ( *torn )++;
+        }
+    }
+    printf( "%-22s %.0f transactions, %.0f us of bus time per timestamp, %u of %u torn\n", name,
+            ( double ) transactions / calls, ( double ) bus_us / calls, ( unsigned ) *torn, ( unsigned ) calls );
+    return ( int ) ( transactions / calls );
+}
+
+static int check_unix_conversion ( void )
+{
+    struct tm tm = { 0 };
+    rtc10_timestamp_t ts;
+    uint32_t days = 0;
+
+    for ( int year = 2000; year <= 2105; year++ )
+    {
+        for ( int month = 1; month <= 12; month++ )
+        {
+            for ( int day = 1; day <= 31; day++ )
+            {
+                tm.tm_year = year - 1900;
+                tm.tm_mon = month - 1;
+                tm.tm_mday = day;
+                tm.tm_hour = 23;
+                tm.tm_min = 59;
+                tm.tm_sec = 58;
+                time_t expected = timegm( &tm );
+                if ( tm.tm_mday != day )
+                {
+                    continue;
+                }
+                ts.date_year = ( uint16_t ) year;
+                ts.date_month = ( uint8_t ) month;
+                ts.date_day = ( uint8_t ) day;
+                ts.hours = 23;
+                ts.minutes = 59;
+                ts.seconds = 58;
+                if ( rtc10_timestamp_to_unix( &ts ) != ( uint32_t ) expected )
+                {
+                    printf( "FAIL: %04d-%02d-%02d converts to %u, expected %ld\n", year, month, day,
+                            ( unsigned ) rtc10_timestamp_to_unix( &ts ), ( long ) expected );
+                    return 1;
+                }
+                days++;
+            }
+        }
+    }
+    printf( "Unix conversion matches timegm for %u days, 2000-01-01 to 2105-12-31\n", ( unsigned ) days );
+    return 0;
+}
+
+static int check_century ( rtc10_t *ctx )
+{
+    struct tm tm = { .tm_year = 199, .tm_mon = 11, .tm_mday = 31, .tm_hour = 23, .tm_min = 59, .tm_sec = 59 };
+    rtc10_timestamp_t ts;
+
+    epoch_at_zero = timegm( &tm );
+    hal_sim_time_us = 1000000;
+    rtc10_get_timestamp( ctx, &ts );
+    if ( ( 2100 != ts.date_year ) || ( 1 != ts.date_month ) || ( 1 != ts.date_day ) || ( 0 != ts.seconds ) )
+    {
+        printf( "FAIL: century rollover read as %04u-%02u-%02u\n", ts.date_year, ts.date_month, ts.date_day );
+        return 1;
+    }
+    return 0;
+}
+
+static int check_family ( void )
+{
+    static rtc_c_t rtc;
+    static rtc5_t rtc5;
+    static rtc9_t rtc9;
+    static rtc2_t rtc2;
+    static rtc11_t rtc11;
+    static rtc12_t rtc12;
+    static rtc13_t rtc13;
+    static rtc14_t rtc14;
+    uint8_t hours, minutes, seconds;
+    rtc2_data_t rtc2_date;
+    rtc5_timedate_t rtc5_td;
+    rtc9_get_time_t rtc9_time;
+    rtc9_get_date_t rtc9_date;
+    rtc11_time_t rtc11_time;
+    rtc11_date_t rtc11_date;
+    rtc12_time_t rtc12_time;
+    rtc12_date_t rtc12_date;
+    rtc13_time_t rtc13_time;
+    rtc13_date_t rtc13_date;
+    rtc14_time_t rtc14_time;
+    rtc14_date_t rtc14_date;
+    rtc14_time_stamp_t rtc14_stamp;
+    uint32_t counts[ 16 ];
+    uint8_t idx = 0;
+    int failures = 0;
+
+    hal_sim_reset( );
+    hal_sim_i2c_transfer = count_transfer;
+    hal_sim_spi_select = count_select;
+    hal_sim_spi_write = count_spi_write;
+    hal_sim_spi_read = count_spi_read;
+
+#define COUNT( call ) do { transactions = 0; call; counts[ idx++ ] = transactions; } while ( 0 )
+    COUNT( rtc_c_get_time( &rtc ) );
+    COUNT( rtc_c_get_date( &rtc ) );
+    COUNT( rtc5_get_time_and_date( &rtc5, &rtc5_td ) );
+    COUNT( rtc9_get_time( &rtc9, &rtc9_time ) );
+    COUNT( rtc9_get_date( &rtc9, &rtc9_date ) );
+    COUNT( rtc2_get_time( &rtc2, &hours, &minutes, &seconds ) );
+    COUNT( rtc2_get_date( &rtc2, &rtc2_date ) );
+    COUNT( rtc11_get_time( &rtc11, &rtc11_time ) );
+    COUNT( rtc11_get_date( &rtc11, &rtc11_date ) );
+    COUNT( rtc12_get_time( &rtc12, &rtc12_time ) );
+    COUNT( rtc12_get_date( &rtc12, &rtc12_date ) );
+    COUNT( rtc13_get_time( &rtc13, &rtc13_time ) );
+    COUNT( rtc13_get_date( &rtc13, &rtc13_date ) );
+    COUNT( rtc14_get_time( &rtc14, &rtc14_time ) );
+    COUNT( rtc14_get_date( &rtc14, &rtc14_date ) );
+    COUNT( rtc14_get_time_stamp( &rtc14, &rtc14_stamp ) );
+#undef COUNT
+
+    static const char *names[ ] =
+    {
+        "rtc_c_get_time", "rtc_c_get_date", "rtc5_get_time_and_date", "rtc9_get_time", "rtc9_get_date",
+        "rtc2_get_time", "rtc2_get_date", "rtc11_get_time", "rtc11_get_date", "rtc12_get_time",
+        "rtc12_get_date", "rtc13_get_time", "rtc13_get_date", "rtc14_get_time", "rtc14_get_date",
+        "rtc14_get_time_stamp"
+    };
+    for ( uint8_t cnt = 0; cnt < idx; cnt++ )
+    {
+        if ( 1 != counts[ cnt ] )
+        {
+            printf( "FAIL: %s takes %u transactions\n", names[ cnt ], ( unsigned ) counts[ cnt ] );
+            failures++;
+        }
+    }
+    if ( !failures )
+    {
+        printf( "RTC, RTC 2, 5, 9, 11, 12, 13 and 14 read time, date and time stamp in one transaction each\n" );
+    }
+    return failures + check_decode( );
+}
+
+int main ( void )
+{
+    static rtc10_t rtc10;
+    rtc10_cfg_t cfg;
+    struct tm tm = { .tm_year = 125, .tm_mon = 11, .tm_mday = 31, .tm_hour = 23, .tm_min = 59, .tm_sec = 59 };
+    uint32_t legacy_torn, snapshot_torn;
+    int failures = 0;
+
+    hal_sim_reset( );
+    hal_sim_i2c_transfer = ds3231_transfer;
+    rtc10_cfg_setup( &cfg );
+    rtc10_init( &rtc10, &cfg );
+
+    epoch_at_zero = timegm( &tm );
+    sweep( &rtc10, "per-field reads:", legacy_unix_time, &legacy_torn );
+    int snapshot_transactions = sweep( &rtc10, "burst snapshot:", snapshot_unix_time, &snapshot_torn );
+    if ( ( 1 != snapshot_transactions ) || snapshot_torn )
+    {
+        printf( "FAIL: the snapshot has to be one transaction and never torn\n" );
+        failures++;
+    }
+    if ( !legacy_torn )
+    {
+        printf( "FAIL: the model did not produce a rollover during the per-field reads\n" );
+        failures++;
+    }
+    failures += check_century( &rtc10 );
+    failures += check_unix_conversion( );
+    failures += check_family( );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,572 @@
+/*
+ * Smart Sens FIFO decoding: batched virtual sensors against a reference.
+ *
+ * A BHI260 host interface model serves the wake-up and non-wake-up FIFO
+ * registers, the first read of a transfer returns the length prefix and
+ * the following reads stream the data. A seeded generator fills both
+ * FIFOs with 400 Hz accelerometer, gyroscope and rotation vector events,
+ * a 1 kHz accelerometer in the wake-up FIFO and a 1 Hz temperature that
+ * is left to the per event callback. Events are separated by small, large
+ * and full timestamp records, padding and filler bytes, and the device
+ * clock starts above 32 bits so the fifth byte of a full timestamp is set.
+ *
+ * Every event the generator writes is kept as the reference. Batched
+ * sensors have to come back through the batch arrays with the same
+ * values, timestamps and order, one callback per full array plus one per
+ * FIFO read for the rest, and never through the per event callback. The
+ * temperature has to come back through the per event callback, as well
+ * as a sensor whose batch is released again. Slot and sensor ID limits of
+ * the registration are checked on the way.
+ */
+#include "smartsens.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define I2C_BYTE_US         ( 9 / 0.4 )
+#define SPI_BYTE_US         ( 8 / 10.0 )
+#define TICKS_PER_MS        64
+#define READ_PERIOD_MS      20
+#define READS               250
+#define FIFO_SIZE           4096
+#define SPI_READ_MASK       0x80
+#define MAX_EVENTS          ( READS * READ_PERIOD_MS * 4 )
+
+#define N_SENSORS           5
+
+static const struct
+{
+    uint8_t id;
+    uint8_t wake_up;
+    uint8_t event_size;
+    uint16_t period_ms_x4;
+    uint8_t data_type;
+    uint16_t batch_len;
+} sensors[ N_SENSORS ] =
+{
+    { SMARTSENS_SENSOR_ID_ACC,    0, 7,  10,   SMARTSENS_FIFO_BATCH_VECTOR,     16 },
+    { SMARTSENS_SENSOR_ID_GYRO,   0, 7,  10,   SMARTSENS_FIFO_BATCH_VECTOR,     10 },
+    { SMARTSENS_SENSOR_ID_RV,     0, 11, 10,   SMARTSENS_FIFO_BATCH_QUATERNION, 7 },
+    { SMARTSENS_SENSOR_ID_ACC_WU, 1, 7,  4,    SMARTSENS_FIFO_BATCH_VECTOR,     3 },
+    { SMARTSENS_SENSOR_ID_TEMP,   0, 3,  4000, 0,                               0 },
+};
+
+typedef struct
+{
+    uint8_t sensor;
+    uint8_t data[ 10 ];
+    uint32_t time_stamp;
+} ref_event_t;
+
+static struct
+{
+    uint8_t data[ FIFO_SIZE ];
+    size_t len;
+    size_t pos;
+    uint8_t latched;
+    uint64_t emitted_ts;
+    uint8_t has_ts;
+} fifo[ 2 ];
+
+static struct
+{
+    uint8_t frame[ 8 ];
+    size_t frame_len;
+} spi;
+
+static uint64_t device_ts;
+static uint32_t rng_state;
+
+static ref_event_t ref[ N_SENSORS ][ MAX_EVENTS ];
+static uint32_t ref_count[ N_SENSORS ];
+static uint32_t got_count[ N_SENSORS ];
+static uint32_t batch_calls[ N_SENSORS ];
+static uint32_t expected_calls[ N_SENSORS ];
+static uint32_t event_calls[ N_SENSORS ];
+static uint32_t stray_calls;
+
+static struct smartsens_fifo_vector vector_buf[ N_SENSORS ][ 16 ];
+static struct smartsens_fifo_quaternion quaternion_buf[ N_SENSORS ][ 16 ];
+
+static int failures;
+
+// ------------------------------------------------------------------- DEVICE
+
+static uint32_t rng ( void )
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static void fifo_put ( uint8_t wake_up, const uint8_t *data, size_t len )
+{
+    if ( fifo[ wake_up ].len + len > FIFO_SIZE )
+    {
+        printf( "FAIL: generator overflows the %s FIFO\n", wake_up ? "wake-up" : "non-wake-up" );
+        exit( EXIT_FAILURE );
+    }
+    memcpy( &fifo[ wake_up ].data[ fifo[ wake_up ].len ], data, len );
+    fifo[ wake_up ].len += len;
+}
+
+// Timestamp record ahead of events, the smallest one that fits unless a full one is forced
+static void fifo_put_time_stamp ( uint8_t wake_up )
+{
+    uint64_t delta = device_ts - fifo[ wake_up ].emitted_ts;
+    uint8_t rec[ 6 ];
+
+    if ( fifo[ wake_up ].has_ts && ( device_ts == fifo[ wake_up ].emitted_ts ) )
+    {
+        return;
+    }
+    if ( fifo[ wake_up ].has_ts && ( delta < 0x100 ) && ( rng( ) % 16 ) )
+    {
+        rec[ 0 ] = wake_up ? SMARTSENS_SYS_ID_TS_SMALL_DELTA_WU : SMARTSENS_SYS_ID_TS_SMALL_DELTA;
+        rec[ 1 ] = ( uint8_t ) delta;
+        fifo_put( wake_up, rec, 2 );
+    }
+    else if ( fifo[ wake_up ].has_ts && ( delta < 0x10000 ) && ( rng( ) % 8 ) )
+    {
+        rec[ 0 ] = wake_up ? SMARTSENS_SYS_ID_TS_LARGE_DELTA_WU : SMARTSENS_SYS_ID_TS_LARGE_DELTA;
+        rec[ 1 ] = ( uint8_t ) delta;
+        rec[ 2 ] = ( uint8_t ) ( delta >> 8 );
+        fifo_put( wake_up, rec, 3 );
+    }
+    else
+    {
+        rec[ 0 ] = wake_up ? SMARTSENS_SYS_ID_TS_FULL_WU : SMARTSENS_SYS_ID_TS_FULL;
+        for ( uint8_t cnt = 0; cnt < 5; cnt++ )
+        {
+            rec[ 1 + cnt ] = ( uint8_t ) ( device_ts >> ( 8 * cnt ) );
+        }
+        fifo_put( wake_up, rec, 6 );
+    }
+    fifo[ wake_up ].emitted_ts = device_ts;
+    fifo[ wake_up ].has_ts = 1;
+}
+
+static void fifo_put_event ( uint8_t sensor )
+{
+    uint8_t wake_up = sensors[ sensor ].wake_up;
+    uint8_t event[ 11 ];
+    ref_event_t *ev;
+
+    fifo_put_time_stamp( wake_up );
+    if ( ( rng( ) % 8 ) == 0 )
+    {
+        event[ 0 ] = ( rng( ) & 1 ) ? SMARTSENS_SYS_ID_FILLER : SMARTSENS_SYS_ID_PADDING;
+        fifo_put( wake_up, event, 1 );
+    }
+    event[ 0 ] = sensors[ sensor ].id;
+    for ( uint8_t cnt = 1; cnt < sensors[ sensor ].event_size; cnt++ )
+    {
+        event[ cnt ] = ( uint8_t ) rng( );
+    }
+    fifo_put( wake_up, event, sensors[ sensor ].event_size );
+
+    ev = &ref[ sensor ][ ref_count[ sensor ]++ ];
+    ev->sensor = sensor;
+    memcpy( ev->data, &event[ 1 ], sensors[ sensor ].event_size - 1 );
+    ev->time_stamp = ( uint32_t ) device_ts;
+}
+
+// Runs the sensors for one read period, in quarter milliseconds
+static void device_run ( void )
+{
+    for ( uint32_t step = 0; step < READ_PERIOD_MS * 4; step++ )
+    {
+        static uint32_t quarter_ms;
+
+        for ( uint8_t sensor = 0; sensor < N_SENSORS; sensor++ )
+        {
+            if ( 0 == ( quarter_ms % sensors[ sensor ].period_ms_x4 ) )
+            {
+                fifo_put_event( sensor );
+            }
+        }
+        quarter_ms++;
+        device_ts += TICKS_PER_MS / 4 + ( rng( ) % 3 ) - 1;
+        if ( 0 == ( rng( ) % 1000 ) )
+        {
+            device_ts += 0x12000;
+        }
+    }
+}
+
+static void device_read ( uint8_t reg, uint8_t *data, size_t len )
+{
+    memset( data, 0, len );
+    if ( SMARTSENS_REG_INTERRUPT_STATUS == reg )
+    {
+        data[ 0 ] = ( fifo[ 1 ].len ? SMARTSENS_IST_FIFO_W_DRDY : 0 ) |
+                    ( fifo[ 0 ].len ? SMARTSENS_IST_FIFO_NW_DRDY : 0 );
+    }
+    else if ( ( SMARTSENS_REG_WAKE_UP_FIFO == reg ) || ( SMARTSENS_REG_NON_WAKE_UP_FIFO == reg ) )
+    {
+        uint8_t wake_up = ( SMARTSENS_REG_WAKE_UP_FIFO == reg );
+
+        if ( !fifo[ wake_up ].latched )
+        {
+            data[ 0 ] = ( uint8_t ) fifo[ wake_up ].len;
+            data[ 1 ] = ( uint8_t ) ( fifo[ wake_up ].len >> 8 );
+            fifo[ wake_up ].latched = ( 0 != fifo[ wake_up ].len );
+            fifo[ wake_up ].pos = 0;
+            return;
+        }
+        if ( fifo[ wake_up ].pos + len > fifo[ wake_up ].len )
+        {
+            printf( "FAIL: FIFO read runs past the transfer\n" );
+            failures++;
+            len = fifo[ wake_up ].len - fifo[ wake_up ].pos;
+        }
+        memcpy( data, &fifo[ wake_up ].data[ fifo[ wake_up ].pos ], len );
+        fifo[ wake_up ].pos += len;
+        if ( fifo[ wake_up ].pos == fifo[ wake_up ].len )
+        {
+            fifo[ wake_up ].len = 0;
+            fifo[ wake_up ].latched = 0;
+        }
+    }
+}
+
+static err_t i2c_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                            uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    ( void ) address;
+    hal_sim_time_us += ( uint64_t ) ( ( 1 + write_len + ( read_len ? 1 + read_len : 0 ) ) * I2C_BYTE_US );
+    if ( read_len )
+    {
+        device_read( write_buf[ 0 ], read_buf, read_len );
+    }
+    return I2C_MASTER_SUCCESS;
+}
+
+static void spi_select ( pin_name_t cs, uint8_t selected )
+{
+    ( void ) cs;
+    if ( selected )
+    {
+        spi.frame_len = 0;
+    }
+}
+
+static err_t spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    hal_sim_time_us += ( uint64_t ) ( size * SPI_BYTE_US );
+    if ( !spi.frame_len )
+    {
+        spi.frame[ 0 ] = buffer[ 0 ];
+    }
+    spi.frame_len += size;
+    return SPI_MASTER_SUCCESS;
+}
+
+static err_t spi_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    hal_sim_time_us += ( uint64_t ) ( size * SPI_BYTE_US );
+    device_read( spi.frame[ 0 ] & ~SPI_READ_MASK, buffer, size );
+    return SPI_MASTER_SUCCESS;
+}
+
+// ------------------------------------------------------------------- CALLBACKS
+
+static int sensor_index ( uint8_t id )
+{
+    for ( int sensor = 0; sensor < N_SENSORS; sensor++ )
+    {
+        if ( sensors[ sensor ].id == id )
+        {
+            return sensor;
+        }
+    }
+    return -1;
+}
+
+static void check_event ( int sensor, const uint8_t *data, uint32_t time_stamp, const char *path )
+{
+    const ref_event_t *ev;
+
+    if ( got_count[ sensor ] >= ref_count[ sensor ] )
+    {
+        printf( "FAIL: sensor %u gets more events than written\n", sensors[ sensor ].id );
+        failures++;
+        return;
+    }
+    ev = &ref[ sensor ][ got_count[ sensor ]++ ];
+    if ( memcmp( ev->data, data, sensors[ sensor ].event_size - 1 ) || ( ev->time_stamp != time_stamp ) )
+    {
+        printf( "FAIL: sensor %u event %u decoded through the %s path as ts %u, written as ts %u\n",
+                sensors[ sensor ].id, ( unsigned ) ( got_count[ sensor ] - 1 ), path,
+                ( unsigned ) time_stamp, ( unsigned ) ev->time_stamp );
+        failures++;
+    }
+}
+
+static void event_callback ( struct smartsens_fifo_parse_data_info *info, void *ref_arg )
+{
+    int sensor = sensor_index( info->sensor_id );
+
+    if ( ( sensor < 0 ) || ( ref_arg != &sensors[ sensor ] ) ||
+         ( info->data_size != sensors[ sensor ].event_size ) ||
+         ( info->fifo_type != ( sensors[ sensor ].wake_up ? SMARTSENS_FIFO_TYPE_WAKEUP : SMARTSENS_FIFO_TYPE_NON_WAKEUP ) ) )
+    {
+        stray_calls++;
+        return;
+    }
+    event_calls[ sensor ]++;
+    check_event( sensor, info->data_ptr, *info->time_stamp, "per event" );
+}
+
+static void batch_callback ( struct smartsens_fifo_batch *batch, void *ref_arg )
+{
+    int sensor = sensor_index( batch->sensor_id );
+    uint8_t data[ 10 ];
+
+    if ( ( sensor < 0 ) || ( ref_arg != &sensors[ sensor ] ) || ( 0 == batch->count ) ||
+         ( batch->count > sensors[ sensor ].batch_len ) ||
+         ( batch->fifo_type != ( sensors[ sensor ].wake_up ? SMARTSENS_FIFO_TYPE_WAKEUP : SMARTSENS_FIFO_TYPE_NON_WAKEUP ) ) )
+    {
+        stray_calls++;
+        return;
+    }
+    batch_calls[ sensor ]++;
+    for ( uint16_t cnt = 0; cnt < batch->count; cnt++ )
+    {
+        if ( SMARTSENS_FIFO_BATCH_QUATERNION == batch->data_type )
+        {
+            struct smartsens_fifo_quaternion *q = &batch->data.quaternion[ cnt ];
+            int16_t val[ 5 ] = { q->x, q->y, q->z, q->w, ( int16_t ) q->accuracy };
+            for ( uint8_t axis = 0; axis < 5; axis++ )
+            {
+                data[ 2 * axis ] = ( uint8_t ) val[ axis ];
+                data[ 2 * axis + 1 ] = ( uint8_t ) ( ( uint16_t ) val[ axis ] >> 8 );
+            }
+            check_event( sensor, data, q->time_stamp, "batch" );
+        }
+        else
+        {
+            struct smartsens_fifo_vector *v = &batch->data.vector[ cnt ];
+            int16_t val[ 3 ] = { v->x, v->y, v->z };
+            for ( uint8_t axis = 0; axis < 3; axis++ )
+            {
+                data[ 2 * axis ] = ( uint8_t ) val[ axis ];
+                data[ 2 * axis + 1 ] = ( uint8_t ) ( ( uint16_t ) val[ axis ] >> 8 );
+            }
+            check_event( sensor, data, v->time_stamp, "batch" );
+        }
+    }
+}
+
+// ------------------------------------------------------------------- CHECKS
+
+static void open_device ( smartsens_t *ctx, uint8_t drv_sel )
+{
+    smartsens_cfg_t cfg;
+
+    hal_sim_reset( );
+    hal_sim_i2c_transfer = i2c_transfer;
+    hal_sim_spi_select = spi_select;
+    hal_sim_spi_write = spi_write;
+    hal_sim_spi_read = spi_read;
+    smartsens_cfg_setup( &cfg );
+    cfg.drv_sel = drv_sel;
+    memset( ctx, 0, sizeof( smartsens_t ) );
+    smartsens_init( ctx, &cfg );
+
+    /* Event sizes as smartsens_update_virtual_sensor_list reads them from the device */
+    ctx->table[ 0 ].event_size = 1;
+    for ( uint8_t sensor = 0; sensor < N_SENSORS; sensor++ )
+    {
+        ctx->table[ sensors[ sensor ].id ].event_size = sensors[ sensor ].event_size;
+    }
+}
+
+static void stream_reset ( uint32_t seed )
+{
+    memset( fifo, 0, sizeof( fifo ) );
+    memset( ref_count, 0, sizeof( ref_count ) );
+    memset( got_count, 0, sizeof( got_count ) );
+    memset( batch_calls, 0, sizeof( batch_calls ) );
+    memset( expected_calls, 0, sizeof( expected_calls ) );
+    memset( event_calls, 0, sizeof( event_calls ) );
+    stray_calls = 0;
+    rng_state = seed;
+    device_ts = 0x0123456000ull;
+}
+
+static uint8_t register_batches ( smartsens_t *ctx, uint8_t batched )
+{
+    for ( uint8_t sensor = 0; sensor < N_SENSORS; sensor++ )
+    {
+        void *buf = ( SMARTSENS_FIFO_BATCH_QUATERNION == sensors[ sensor ].data_type ) ?
+                    ( void * ) quaternion_buf[ sensor ] : ( void * ) vector_buf[ sensor ];
+
+        if ( SMARTSENS_OK != smartsens_register_fifo_parse_callback( ctx, sensors[ sensor ].id, event_callback,
+                                                                    ( void * ) &sensors[ sensor ] ) )
+        {
+            return 0;
+        }
+        if ( ( batched & ( 1 << sensor ) ) &&
+             ( SMARTSENS_OK != smartsens_register_fifo_batch_callback( ctx, sensors[ sensor ].id, sensors[ sensor ].data_type,
+                                                                      buf, sensors[ sensor ].batch_len,
+                                                                      batch_callback, ( void * ) &sensors[ sensor ] ) ) )
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Streams READS FIFO reads, returns the number of parse calls that failed
+static uint32_t run_stream ( smartsens_t *ctx, uint8_t batched )
+{
+    static uint8_t work_buffer[ 2 * FIFO_SIZE ];
+    uint32_t errors = 0;
+
+    for ( uint32_t read = 0; read < READS; read++ )
+    {
+        uint32_t before[ N_SENSORS ];
+
+        memcpy( before, ref_count, sizeof( before ) );
+        device_run( );
+        for ( uint8_t sensor = 0; sensor < N_SENSORS; sensor++ )
+        {
+            uint32_t events = ref_count[ sensor ] - before[ sensor ];
+            if ( batched & ( 1 << sensor ) )
+            {
+                expected_calls[ sensor ] += ( events + sensors[ sensor ].batch_len - 1 ) / sensors[ sensor ].batch_len;
+            }
+        }
+        if ( SMARTSENS_OK != smartsens_get_and_process_fifo( ctx, work_buffer, sizeof( work_buffer ) ) )
+        {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+static void check_stream ( uint8_t drv_sel, const char *bus, uint8_t batched, uint32_t seed )
+{
+    static smartsens_t ctx;
+    uint32_t errors;
+    uint32_t events = 0;
+    uint32_t calls = 0;
+
+    open_device( &ctx, drv_sel );
+    stream_reset( seed );
+    if ( !register_batches( &ctx, batched ) )
+    {
+        printf( "FAIL: %s callbacks can not be registered\n", bus );
+        failures++;
+        return;
+    }
+    errors = run_stream( &ctx, batched );
+    if ( errors || stray_calls )
+    {
+        printf( "FAIL: %s stream has %u parse errors and %u stray callbacks\n", bus,
+                ( unsigned ) errors, ( unsigned ) stray_calls );
+        failures++;
+    }
+    for ( uint8_t sensor = 0; sensor < N_SENSORS; sensor++ )
+    {
+        uint8_t is_batched = ( batched >> sensor ) & 1;
+
+        if ( got_count[ sensor ] != ref_count[ sensor ] )
+        {
+            printf( "FAIL: %s sensor %u decodes %u of %u events\n", bus, sensors[ sensor ].id,
+                    ( unsigned ) got_count[ sensor ], ( unsigned ) ref_count[ sensor ] );
+            failures++;
+        }
+        if ( is_batched && ( event_calls[ sensor ] || ( batch_calls[ sensor ] != expected_calls[ sensor ] ) ) )
+        {
+            printf( "FAIL: %s sensor %u gets %u batch and %u per event callbacks, %u batch callbacks expected\n",
+                    bus, sensors[ sensor ].id, ( unsigned ) batch_calls[ sensor ], ( unsigned ) event_calls[ sensor ],
+                    ( unsigned ) expected_calls[ sensor ] );
+            failures++;
+        }
+        if ( !is_batched && ( batch_calls[ sensor ] || ( event_calls[ sensor ] != ref_count[ sensor ] ) ) )
+        {
+            printf( "FAIL: %s sensor %u gets %u batch callbacks and %u per event callbacks for %u events\n",
+                    bus, sensors[ sensor ].id, ( unsigned ) batch_calls[ sensor ], ( unsigned ) event_calls[ sensor ],
+                    ( unsigned ) ref_count[ sensor ] );
+            failures++;
+        }
+        events += ref_count[ sensor ];
+        calls += batch_calls[ sensor ] + event_calls[ sensor ];
+    }
+    printf( "%-4s batched 0x%02X: %u events in %u FIFO reads, %u callbacks (%.3f per event)\n", bus, batched,
+            ( unsigned ) events, READS, ( unsigned ) calls, ( double ) calls / events );
+}
+
+// A released batch falls back to the per event callback, slots and IDs are bounded
+static void check_registration ( void )
+{
+    static smartsens_t ctx;
+    static struct smartsens_fifo_vector spare[ 4 ];
+    uint32_t gyro_before;
+
+    open_device( &ctx, SMARTSENS_DRV_SEL_SPI );
+    stream_reset( 7 );
+    if ( !register_batches( &ctx, 0x0F ) ||
+         ( SMARTSENS_OK == smartsens_register_fifo_batch_callback( &ctx, SMARTSENS_SENSOR_ID_TEMP, SMARTSENS_FIFO_BATCH_VECTOR,
+                                                                  spare, 4, batch_callback, NULL ) ) ||
+         ( SMARTSENS_OK == smartsens_register_fifo_batch_callback( &ctx, 0, SMARTSENS_FIFO_BATCH_VECTOR,
+                                                                  spare, 4, batch_callback, NULL ) ) ||
+         ( SMARTSENS_OK == smartsens_register_fifo_batch_callback( &ctx, SMARTSENS_SYS_ID_TS_FULL, SMARTSENS_FIFO_BATCH_VECTOR,
+                                                                  spare, 4, batch_callback, NULL ) ) )
+    {
+        printf( "FAIL: batch registration accepts a fifth sensor or a system ID\n" );
+        failures++;
+        return;
+    }
+    run_stream( &ctx, 0x0F );
+
+    /* Released gyroscope batch goes back to the per event callback */
+    if ( SMARTSENS_OK != smartsens_register_fifo_batch_callback( &ctx, SMARTSENS_SENSOR_ID_GYRO, 0, NULL, 0, NULL, NULL ) )
+    {
+        printf( "FAIL: gyroscope batch can not be released\n" );
+        failures++;
+        return;
+    }
+    memset( event_calls, 0, sizeof( event_calls ) );
+    memset( batch_calls, 0, sizeof( batch_calls ) );
+    memset( expected_calls, 0, sizeof( expected_calls ) );
+    gyro_before = ref_count[ 1 ];
+    run_stream( &ctx, 0x0D );
+    if ( ( got_count[ 1 ] != ref_count[ 1 ] ) || ( event_calls[ 1 ] != ref_count[ 1 ] - gyro_before ) ||
+         batch_calls[ 1 ] || ( batch_calls[ 0 ] != expected_calls[ 0 ] ) || stray_calls )
+    {
+        printf( "FAIL: released gyroscope batch decodes %u of %u events, %u per event callbacks\n",
+                ( unsigned ) got_count[ 1 ], ( unsigned ) ref_count[ 1 ], ( unsigned ) event_calls[ 1 ] );
+        failures++;
+        return;
+    }
+
+    /* Its slot is free for the next batch */
+    if ( ( SMARTSENS_OK != smartsens_register_fifo_batch_callback( &ctx, SMARTSENS_SENSOR_ID_GYRO, SMARTSENS_FIFO_BATCH_VECTOR,
+                                                                  vector_buf[ 1 ], 4, batch_callback,
+                                                                  ( void * ) &sensors[ 1 ] ) ) ||
+         ( 2 != ctx.table[ SMARTSENS_SENSOR_ID_GYRO ].batch_idx ) )
+    {
+        printf( "FAIL: released batch slot is not reused\n" );
+        failures++;
+        return;
+    }
+    printf( "SPI  release: gyroscope back on %u per event callbacks, slot %u reused\n",
+            ( unsigned ) event_calls[ 1 ], ( unsigned ) ctx.table[ SMARTSENS_SENSOR_ID_GYRO ].batch_idx );
+}
+
+int main ( void )
+{
+    check_stream( SMARTSENS_DRV_SEL_SPI, "SPI", 0x00, 1 );
+    check_stream( SMARTSENS_DRV_SEL_SPI, "SPI", 0x0F, 2 );
+    check_stream( SMARTSENS_DRV_SEL_I2C, "I2C", 0x0F, 3 );
+    check_stream( SMARTSENS_DRV_SEL_I2C, "I2C", 0x0B, 4 );
+    check_registration( );
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
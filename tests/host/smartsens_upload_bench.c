@@ -0,0 +1,548 @@
+/*
+ * Smart Sens firmware upload: load time, framing and flash resume.
+ *
+ * The driver source is built with the presets overridden, flash upload
+ * with the flash image included or RAM upload, and for Smart Sens 2 when
+ * SMARTSENS2_BUILD is set. It runs over I2C at 400 kHz and SPI at 10 MHz
+ * against a BHI260 host interface model that parses the command stream on
+ * the command input register into its flash or program RAM. The model
+ * erases a 4 KiB sector in 30 ms, programs 256 bytes in 1 ms and verifies
+ * an uploaded RAM image in 40 ms, and reports completion through the
+ * interrupt status and status FIFO registers.
+ *
+ * smartsens_update_firmware is timed against the upload loop it replaced.
+ * Both have to leave an exact copy of the image in the device. Flash
+ * upload is bound by the status polling and has to be faster, RAM upload
+ * is bound by the bus and must not lose more than one legacy poll period.
+ * In flash mode one write chunk is dropped with a bus error and the next
+ * call has to finish the upload from that chunk without erasing again,
+ * in RAM mode the upload has to fail instead of waiting for the boot.
+ */
+#ifdef SMARTSENS2_BUILD
+#include "smartsens2.h"
+#undef SMARTSENS2_FLASHIMG
+#undef SMARTSENS2_FLASH
+#undef SMARTSENS2_RAM
+#define SMARTSENS2_FLASHIMG     !UPLOAD_RAM
+#define SMARTSENS2_FLASH        !UPLOAD_RAM
+#define SMARTSENS2_RAM          UPLOAD_RAM
+#include "smartsens2.c"
+
+#define DRIVER_NAME                                 "Smart Sens 2"
+#define smartsens_t                                 smartsens2_t
+#define smartsens_cfg_t                             smartsens2_cfg_t
+#define smartsens_cfg_setup                         smartsens2_cfg_setup
+#define smartsens_init                              smartsens2_init
+#define smartsens_update_firmware                   smartsens2_update_firmware
+#define smartsens_cmd_write                         smartsens2_cmd_write
+#define smartsens_byte_read                         smartsens2_byte_read
+#define smartsens_generic_write                     smartsens2_generic_write
+#define smartsens_status_read                       smartsens2_status_read
+#define smartsens_firmware_image                    smartsens2_firmware_image
+#define SMARTSENS_OK                                SMARTSENS2_OK
+#define SMARTSENS_ERROR                             SMARTSENS2_ERROR
+#define SMARTSENS_DRV_SEL_SPI                       SMARTSENS2_DRV_SEL_SPI
+#define SMARTSENS_DRV_SEL_I2C                       SMARTSENS2_DRV_SEL_I2C
+#define SMARTSENS_REG_COMMAND_INPUT                 SMARTSENS2_REG_COMMAND_INPUT
+#define SMARTSENS_REG_STATUS_DEBUG_FIFO             SMARTSENS2_REG_STATUS_DEBUG_FIFO
+#define SMARTSENS_REG_BOOT_STATUS                   SMARTSENS2_REG_BOOT_STATUS
+#define SMARTSENS_REG_INTERRUPT_STATUS              SMARTSENS2_REG_INTERRUPT_STATUS
+#define SMARTSENS_REG_ERROR_VALUE                   SMARTSENS2_REG_ERROR_VALUE
+#define SMARTSENS_CMD_UPLOAD_TO_RAM                 SMARTSENS2_CMD_UPLOAD_TO_RAM
+#define SMARTSENS_CMD_ERASE_FLASH                   SMARTSENS2_CMD_ERASE_FLASH
+#define SMARTSENS_CMD_WRITE_FLASH                   SMARTSENS2_CMD_WRITE_FLASH
+#define SMARTSENS_START_FLASH_ADR                   SMARTSENS2_START_FLASH_ADR
+#define SMARTSENS_BOOTSTATUS_HOST_FW_VERIFY_DONE    SMARTSENS2_BOOTSTATUS_HOST_FW_VERIFY_DONE
+#else
+#include "smartsens.h"
+#undef SMARTSENS_FLASHIMG
+#undef SMARTSENS_FLASH
+#undef SMARTSENS_RAM
+#define SMARTSENS_FLASHIMG      !UPLOAD_RAM
+#define SMARTSENS_FLASH         !UPLOAD_RAM
+#define SMARTSENS_RAM           UPLOAD_RAM
+#include "smartsens.c"
+
+#define DRIVER_NAME             "Smart Sens"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define I2C_BYTE_US         ( 9 / 0.4 )
+#define SPI_BYTE_US         ( 8 / 10.0 )
+#define ERASE_SECTOR_US     30000
+#define PROGRAM_PAGE_US     1000
+#define RAM_VERIFY_US       40000
+#define LEGACY_POLL_US      10000
+
+#define STATUS_ERASE_DONE   0x000B
+#define STATUS_WRITE_DONE   0x000D
+#define STATUS_FLASH_ERROR  0x000F
+#define STATUS_READY        0x20
+
+#define IMAGE_SIZE          sizeof( smartsens_firmware_image )
+#define MAX_FRAME           2048
+
+static struct
+{
+    uint8_t memory[ IMAGE_SIZE ];
+    uint32_t ram_fill;
+    uint8_t hdr[ 4 ];
+    uint8_t hdr_fill;
+    uint16_t cmd;
+    uint32_t remaining;
+    uint8_t payload[ 260 ];
+    uint16_t payload_fill;
+    uint16_t status;
+    uint64_t busy_until;
+    uint64_t boot_at;
+    uint32_t erases;
+    uint32_t written;
+    uint32_t cmd_frames;
+    uint32_t fail_frame;
+    uint32_t transactions;
+    size_t max_i2c_frame;
+    uint8_t frame[ MAX_FRAME ];
+    size_t frame_len;
+    uint8_t frame_error;
+} dev;
+
+static int failures;
+
+// ------------------------------------------------------------------- DEVICE
+
+// Flash starts out programmed, writes before the erase fail
+static void device_reset ( void )
+{
+    memset( &dev, 0, sizeof( dev ) );
+}
+
+static void command_done ( void )
+{
+    uint32_t addr = dev.payload[ 0 ] | ( ( uint32_t ) dev.payload[ 1 ] << 8 ) |
+                    ( ( uint32_t ) dev.payload[ 2 ] << 16 ) | ( ( uint32_t ) dev.payload[ 3 ] << 24 );
+
+    if ( SMARTSENS_CMD_ERASE_FLASH == dev.cmd )
+    {
+        uint32_t end = dev.payload[ 4 ] | ( ( uint32_t ) dev.payload[ 5 ] << 8 ) |
+                       ( ( uint32_t ) dev.payload[ 6 ] << 16 ) | ( ( uint32_t ) dev.payload[ 7 ] << 24 );
+        uint32_t sectors = ( end - addr + 4095 ) / 4096;
+        dev.erases++;
+        memset( dev.memory, 0xFF, sizeof( dev.memory ) );
+        dev.status = ( ( SMARTSENS_START_FLASH_ADR == addr ) && ( end - addr == IMAGE_SIZE ) ) ?
+                     STATUS_ERASE_DONE : STATUS_FLASH_ERROR;
+        dev.busy_until = hal_sim_time_us + ( uint64_t ) sectors * ERASE_SECTOR_US;
+    }
+    else if ( SMARTSENS_CMD_WRITE_FLASH == dev.cmd )
+    {
+        uint32_t offset = addr - SMARTSENS_START_FLASH_ADR;
+        uint16_t len = dev.payload_fill - 4;
+        dev.status = STATUS_WRITE_DONE;
+        if ( ( addr < SMARTSENS_START_FLASH_ADR ) || ( offset + len > IMAGE_SIZE ) )
+        {
+            dev.status = STATUS_FLASH_ERROR;
+        }
+        else
+        {
+            // NOR programming only clears bits, a byte written twice must not change
+            for ( uint16_t cnt = 0; cnt < len; cnt++ )
+            {
+                if ( ( dev.memory[ offset + cnt ] & dev.payload[ 4 + cnt ] ) != dev.payload[ 4 + cnt ] )
+                {
+                    dev.status = STATUS_FLASH_ERROR;
+                }
+                dev.memory[ offset + cnt ] &= dev.payload[ 4 + cnt ];
+            }
+            dev.written += len;
+        }
+        dev.busy_until = hal_sim_time_us + ( ( len + 255 ) / 256 ) * PROGRAM_PAGE_US;
+    }
+    else if ( SMARTSENS_CMD_UPLOAD_TO_RAM == dev.cmd )
+    {
+        dev.boot_at = hal_sim_time_us + RAM_VERIFY_US;
+    }
+}
+
+static void device_write ( uint8_t reg, const uint8_t *data, size_t len )
+{
+    if ( SMARTSENS_REG_COMMAND_INPUT != reg )
+    {
+        return;
+    }
+    for ( size_t cnt = 0; cnt < len; cnt++ )
+    {
+        if ( dev.hdr_fill < 4 )
+        {
+            dev.hdr[ dev.hdr_fill++ ] = data[ cnt ];
+            if ( 4 == dev.hdr_fill )
+            {
+                dev.cmd = dev.hdr[ 0 ] | ( ( uint16_t ) dev.hdr[ 1 ] << 8 );
+                dev.remaining = dev.hdr[ 2 ] | ( ( uint16_t ) dev.hdr[ 3 ] << 8 );
+                if ( SMARTSENS_CMD_UPLOAD_TO_RAM == dev.cmd )
+                {
+                    // The RAM upload length is given in 32-bit words
+                    dev.remaining *= 4;
+                }
+                dev.payload_fill = 0;
+            }
+            continue;
+        }
+        if ( SMARTSENS_CMD_UPLOAD_TO_RAM == dev.cmd )
+        {
+            if ( dev.ram_fill < IMAGE_SIZE )
+            {
+                dev.memory[ dev.ram_fill ] = data[ cnt ];
+            }
+            dev.ram_fill++;
+        }
+        else if ( dev.payload_fill < sizeof( dev.payload ) )
+        {
+            dev.payload[ dev.payload_fill++ ] = data[ cnt ];
+        }
+        if ( 0 == --dev.remaining )
+        {
+            command_done( );
+            dev.hdr_fill = 0;
+        }
+    }
+}
+
+static void device_read ( uint8_t reg, uint8_t *data, size_t len )
+{
+    uint8_t ready = dev.status && ( hal_sim_time_us >= dev.busy_until );
+
+    memset( data, 0, len );
+    if ( SMARTSENS_REG_INTERRUPT_STATUS == reg )
+    {
+        data[ 0 ] = ready ? STATUS_READY : 0;
+    }
+    else if ( SMARTSENS_REG_BOOT_STATUS == reg )
+    {
+        data[ 0 ] = ( dev.boot_at && ( hal_sim_time_us >= dev.boot_at ) ) ? SMARTSENS_BOOTSTATUS_HOST_FW_VERIFY_DONE : 0;
+    }
+    else if ( ( SMARTSENS_REG_STATUS_DEBUG_FIFO == reg ) && ready && ( len >= 4 ) )
+    {
+        data[ 0 ] = ( uint8_t ) dev.status;
+        data[ 1 ] = ( uint8_t ) ( dev.status >> 8 );
+        dev.status = 0;
+    }
+}
+
+// A command frame that fails on the bus is dropped by the device
+static uint8_t command_frame_fails ( void )
+{
+    return ++dev.cmd_frames == dev.fail_frame;
+}
+
+static err_t i2c_transfer ( void *obj, uint8_t address, uint8_t *write_buf, size_t write_len,
+                            uint8_t *read_buf, size_t read_len )
+{
+    ( void ) obj;
+    ( void ) address;
+    dev.transactions++;
+    hal_sim_time_us += ( uint64_t ) ( ( 1 + write_len + ( read_len ? 1 + read_len : 0 ) ) * I2C_BYTE_US );
+    if ( write_len > dev.max_i2c_frame )
+    {
+        dev.max_i2c_frame = write_len;
+    }
+    if ( read_len )
+    {
+        device_read( write_buf[ 0 ], read_buf, read_len );
+        return I2C_MASTER_SUCCESS;
+    }
+    if ( ( SMARTSENS_REG_COMMAND_INPUT == write_buf[ 0 ] ) && command_frame_fails( ) )
+    {
+        return I2C_MASTER_ERROR;
+    }
+    device_write( write_buf[ 0 ], &write_buf[ 1 ], write_len - 1 );
+    return I2C_MASTER_SUCCESS;
+}
+
+static void spi_select ( pin_name_t cs, uint8_t selected )
+{
+    ( void ) cs;
+    if ( selected )
+    {
+        dev.transactions++;
+        dev.frame_len = 0;
+        dev.frame_error = 0;
+    }
+    else if ( dev.frame_len && !( dev.frame[ 0 ] & SPI_READ_MASK ) && !dev.frame_error )
+    {
+        device_write( dev.frame[ 0 ], &dev.frame[ 1 ], dev.frame_len - 1 );
+    }
+}
+
+static err_t spi_write ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    hal_sim_time_us += ( uint64_t ) ( size * SPI_BYTE_US );
+    if ( !dev.frame_len && ( SMARTSENS_REG_COMMAND_INPUT == buffer[ 0 ] ) && command_frame_fails( ) )
+    {
+        dev.frame_error = 1;
+    }
+    if ( dev.frame_len + size > MAX_FRAME )
+    {
+        dev.frame_error = 1;
+    }
+    else
+    {
+        memcpy( &dev.frame[ dev.frame_len ], buffer, size );
+    }
+    dev.frame_len += size;
+    return dev.frame_error ? SPI_MASTER_ERROR : SPI_MASTER_SUCCESS;
+}
+
+static err_t spi_read ( void *obj, uint8_t *buffer, size_t size )
+{
+    ( void ) obj;
+    hal_sim_time_us += ( uint64_t ) ( size * SPI_BYTE_US );
+    device_read( dev.frame[ 0 ] & ~SPI_READ_MASK, buffer, size );
+    return SPI_MASTER_SUCCESS;
+}
+
+// ------------------------------------------------------------------- LEGACY
+
+// The upload loop smartsens_update_firmware ran before the pipelined engine
+static err_t legacy_update_firmware ( smartsens_t *ctx )
+{
+    err_t ret_val = SMARTSENS_OK;
+    uint32_t step = 240;
+    uint8_t temp[ 0x1FF ] = { 0 };
+    uint32_t cnt = 0;
+    uint32_t remaining = IMAGE_SIZE;
+    uint8_t status;
+
+#if !UPLOAD_RAM
+    uint32_t start_addr = SMARTSENS_START_FLASH_ADR;
+    uint16_t cmd;
+    uint16_t cmd_len;
+    uint8_t cmd_buf[ 0xFF ] = { 0 };
+
+    temp[ 0 ] = start_addr;
+    temp[ 1 ] = start_addr >> 8;
+    temp[ 2 ] = start_addr >> 16;
+    temp[ 3 ] = start_addr >> 24;
+    temp[ 4 ] = ( start_addr + remaining );
+    temp[ 5 ] = ( start_addr + remaining ) >> 8;
+    temp[ 6 ] = ( start_addr + remaining ) >> 16;
+    temp[ 7 ] = ( start_addr + remaining ) >> 24;
+    smartsens_cmd_write( ctx, SMARTSENS_CMD_ERASE_FLASH, temp, 8 );
+    do
+    {
+        smartsens_byte_read( ctx, SMARTSENS_REG_ERROR_VALUE, &status );
+        if ( status )
+        {
+            return status;
+        }
+        smartsens_byte_read( ctx, SMARTSENS_REG_INTERRUPT_STATUS, &status );
+        Delay_10ms( );
+    } while ( !( status & 0x20 ) );
+    smartsens_status_read( ctx, &cmd, cmd_buf, &cmd_len );
+    if ( 0x000F == cmd )
+    {
+        return SMARTSENS_ERROR;
+    }
+
+    do
+    {
+        uint32_t size;
+        if ( remaining > step )
+        {
+            remaining -= step;
+            size = step + 4;
+        }
+        else
+        {
+            size = remaining + 4;
+            remaining = 0;
+        }
+        temp[ 0 ] = start_addr;
+        temp[ 1 ] = start_addr >> 8;
+        temp[ 2 ] = start_addr >> 16;
+        temp[ 3 ] = start_addr >> 24;
+        memcpy( &temp[ 4 ], &smartsens_firmware_image[ cnt ], size );
+        cnt += size - 4;
+        smartsens_cmd_write( ctx, SMARTSENS_CMD_WRITE_FLASH, temp, size );
+        do
+        {
+            smartsens_byte_read( ctx, SMARTSENS_REG_INTERRUPT_STATUS, &status );
+            Delay_10ms( );
+        } while ( !( status & 0x20 ) );
+        smartsens_status_read( ctx, &cmd, cmd_buf, &cmd_len );
+        if ( 0x000F == cmd )
+        {
+            ret_val = SMARTSENS_ERROR;
+            break;
+        }
+        start_addr += ( size - 4 );
+    } while ( remaining );
+#else
+    uint32_t enc = 0;
+    uint16_t temp_index = 0;
+    uint16_t size = IMAGE_SIZE / 4;
+
+    ( void ) remaining;
+    temp[ 0 ] = ( uint8_t ) SMARTSENS_CMD_UPLOAD_TO_RAM;
+    temp[ 1 ] = ( uint8_t ) ( SMARTSENS_CMD_UPLOAD_TO_RAM >> 8 );
+    temp[ 2 ] = ( uint8_t ) size;
+    temp[ 3 ] = ( uint8_t ) ( size >> 8 );
+    while ( cnt < IMAGE_SIZE )
+    {
+        temp_index = !( enc++ ) ? 4 : 0;
+        while ( 0 != ( cnt % 4 ) )
+        {
+            cnt = ( ( cnt >> 2 ) + 1 ) << 2;
+        }
+        uint32_t limit = step * enc;
+        for ( ; ( cnt < limit ) && ( cnt < IMAGE_SIZE ); cnt++ )
+        {
+            temp[ temp_index++ ] = smartsens_firmware_image[ cnt ];
+        }
+        smartsens_generic_write( ctx, SMARTSENS_REG_COMMAND_INPUT, temp, temp_index );
+    }
+    do
+    {
+        Delay_10ms( );
+        smartsens_byte_read( ctx, SMARTSENS_REG_BOOT_STATUS, &status );
+    } while ( !( status & SMARTSENS_BOOTSTATUS_HOST_FW_VERIFY_DONE ) );
+#endif
+    return ret_val;
+}
+
+// ------------------------------------------------------------------- CHECKS
+
+static void open_device ( smartsens_t *ctx, uint8_t drv_sel )
+{
+    smartsens_cfg_t cfg;
+
+    hal_sim_reset( );
+    hal_sim_i2c_transfer = i2c_transfer;
+    hal_sim_spi_select = spi_select;
+    hal_sim_spi_write = spi_write;
+    hal_sim_spi_read = spi_read;
+    smartsens_cfg_setup( &cfg );
+    cfg.drv_sel = drv_sel;
+    smartsens_init( ctx, &cfg );
+}
+
+static int image_matches ( void )
+{
+    return ( 0 == memcmp( dev.memory, smartsens_firmware_image, IMAGE_SIZE ) ) &&
+           ( !UPLOAD_RAM || ( IMAGE_SIZE == dev.ram_fill ) );
+}
+
+static double timed_upload ( smartsens_t *ctx, const char *label, err_t ( *upload )( smartsens_t *ctx ),
+                             uint32_t *transactions )
+{
+    device_reset( );
+    hal_sim_time_us = 0;
+    err_t ret_val = upload( ctx );
+    *transactions = dev.transactions;
+    if ( ( SMARTSENS_OK != ret_val ) || !image_matches( ) )
+    {
+        printf( "FAIL: %s leaves %s in the device\n", label, ( SMARTSENS_OK != ret_val ) ? "an error" : "a wrong image" );
+        failures++;
+    }
+    return hal_sim_time_us / 1e6;
+}
+
+static void check_interface ( uint8_t drv_sel, const char *bus )
+{
+    static smartsens_t ctx;
+    uint32_t legacy_transactions, engine_transactions;
+    char label[ 64 ];
+
+    open_device( &ctx, drv_sel );
+    snprintf( label, sizeof( label ), "%s legacy upload", bus );
+    double legacy_s = timed_upload( &ctx, label, legacy_update_firmware, &legacy_transactions );
+    snprintf( label, sizeof( label ), "%s upload", bus );
+    double engine_s = timed_upload( &ctx, label, smartsens_update_firmware, &engine_transactions );
+
+    printf( "%-12s %s %-5s %u bytes: legacy %.3f s in %u transactions, engine %.3f s in %u transactions\n",
+            DRIVER_NAME, UPLOAD_RAM ? "RAM" : "flash", bus, ( unsigned ) IMAGE_SIZE, legacy_s,
+            ( unsigned ) legacy_transactions, engine_s, ( unsigned ) engine_transactions );
+    if ( UPLOAD_RAM ? ( engine_s > legacy_s + LEGACY_POLL_US / 1e6 ) || ( engine_transactions > legacy_transactions ) :
+                      ( engine_s >= legacy_s ) )
+    {
+        printf( "FAIL: the %s upload is slower than the legacy loop\n", bus );
+        failures++;
+    }
+    if ( ( SMARTSENS_DRV_SEL_I2C == drv_sel ) && ( dev.max_i2c_frame > 257 ) )
+    {
+        printf( "FAIL: an I2C frame of %u bytes overflows the driver buffer\n", ( unsigned ) dev.max_i2c_frame );
+        failures++;
+    }
+}
+
+#if UPLOAD_RAM
+static void check_abort ( uint8_t drv_sel, const char *bus )
+{
+    static smartsens_t ctx;
+
+    open_device( &ctx, drv_sel );
+    device_reset( );
+    dev.fail_frame = 3;
+    if ( SMARTSENS_OK == smartsens_update_firmware( &ctx ) )
+    {
+        printf( "FAIL: %s upload ignores a bus error\n", bus );
+        failures++;
+        return;
+    }
+    printf( "%-12s RAM   %-5s bus error: upload stops after %u of %u bytes\n", DRIVER_NAME, bus,
+            ( unsigned ) dev.ram_fill, ( unsigned ) IMAGE_SIZE );
+}
+
+#else
+static void check_resume ( uint8_t drv_sel, const char *bus )
+{
+    static smartsens_t ctx;
+    uint32_t chunks = ( IMAGE_SIZE + FW_FLASH_CHUNK - 1 ) / FW_FLASH_CHUNK;
+
+    open_device( &ctx, drv_sel );
+    device_reset( );
+    // The erase is the first command frame, drop the write of the chunk in the middle
+    dev.fail_frame = 1 + chunks / 2 + 1;
+    if ( SMARTSENS_OK == smartsens_update_firmware( &ctx ) )
+    {
+        printf( "FAIL: %s upload ignores a bus error\n", bus );
+        failures++;
+        return;
+    }
+    uint32_t resume_at = ctx.fw_offset;
+    uint32_t written = dev.written;
+    if ( smartsens_update_firmware( &ctx ) || !image_matches( ) || ( 1 != dev.erases ) || ctx.fw_offset )
+    {
+        printf( "FAIL: %s resume ends with %s, %u erases, resume point %u\n", bus,
+                image_matches( ) ? "the image" : "a wrong image", ( unsigned ) dev.erases,
+                ( unsigned ) ctx.fw_offset );
+        failures++;
+        return;
+    }
+    printf( "%-12s flash %-5s resume: error at byte %u, %u bytes were already written, %u bytes sent"
+            " after the resume, one erase\n", DRIVER_NAME, bus, ( unsigned ) resume_at, ( unsigned ) written,
+            ( unsigned ) ( dev.written - written ) );
+    if ( ( resume_at != ( chunks / 2 ) * FW_FLASH_CHUNK ) || ( dev.written != IMAGE_SIZE ) )
+    {
+        printf( "FAIL: the resume has to start at the dropped chunk and write every byte once\n" );
+        failures++;
+    }
+}
+
+#endif
+int main ( void )
+{
+    check_interface( SMARTSENS_DRV_SEL_I2C, "I2C" );
+    check_interface( SMARTSENS_DRV_SEL_SPI, "SPI" );
+#if UPLOAD_RAM
+    check_abort( SMARTSENS_DRV_SEL_I2C, "I2C" );
+    check_abort( SMARTSENS_DRV_SEL_SPI, "SPI" );
+#else
+    check_resume( SMARTSENS_DRV_SEL_I2C, "I2C" );
+    check_resume( SMARTSENS_DRV_SEL_SPI, "SPI" );
+#endif
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
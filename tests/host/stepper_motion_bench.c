@@ -0,0 +1,343 @@
+/*
+ * Stepper motion engine against a simulated timer.
+ *
+ * The motion tick of Stepper 5, Stepper 19 and Silent Step 4 is called at
+ * 100 kHz and every STEP rising edge is timestamped together with the DIR
+ * level. The step trains are checked against the ideal trapezoid of the
+ * profile: move time, steps spent accelerating and decelerating, cruise
+ * speed, stopping distance, and a reversal in mid-move landing exactly on
+ * the new target. Ticks arriving while the main context holds the engine
+ * must not step, and the deferred step must come on the first tick after
+ * the hold. The blocking stepper5_drive_motor is timed for contrast.
+ */
+#include "stepper5.h"
+#include "stepper19.h"
+#include "silentstep4.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TICK_FREQ           100000
+#define MAX_SPEED           5000.0f
+#define ACCEL               20000.0f
+#define MAX_STEPS           120000
+#define MAX_TICKS           ( 10 * TICK_FREQ )
+
+// Each end of a ramp is quantized to about one first step interval, c0 = 0.676 * sqrt( 2 / a )
+#define RAMP_END_TOLERANCE  ( 2 * 0.676 * sqrt( 2 / ACCEL ) )
+
+#define STEP_PIN            20
+#define DIR_PIN             21
+
+typedef struct
+{
+    const char *name;
+    void *ctx;
+    err_t ( *set_profile )( void *ctx, uint32_t tick_freq, float max_speed, float accel );
+    err_t ( *move_to )( void *ctx, int32_t position );
+    void ( *stop )( void *ctx );
+    int32_t ( *get_position )( void *ctx );
+    err_t ( *set_position )( void *ctx, int32_t position );
+    uint8_t ( *is_moving )( void *ctx );
+    void ( *tick )( void *ctx );
+    void ( *hold )( void *ctx, uint8_t state );
+} engine_t;
+
+static uint32_t now;
+static uint8_t step_level;
+static uint8_t dir_level;
+static uint32_t step_tick[ MAX_STEPS ];
+static uint8_t step_dir[ MAX_STEPS ];
+static uint32_t n_steps;
+static int failures;
+
+static void gpio_write ( void *obj, pin_name_t pin, uint8_t state )
+{
+    ( void ) obj;
+    if ( DIR_PIN == pin )
+    {
+        dir_level = state;
+    }
+    else if ( STEP_PIN == pin )
+    {
+        if ( state && !step_level && ( n_steps < MAX_STEPS ) )
+        {
+            step_tick[ n_steps ] = now;
+            step_dir[ n_steps ] = dir_level;
+            n_steps++;
+        }
+        step_level = state;
+    }
+}
+
+// ------------------------------------------------------------ DRIVER ADAPTERS
+
+#define ENGINE_ADAPTER( drv, type ) \
+    static type drv##_ctx; \
+    static err_t drv##_profile ( void *ctx, uint32_t f, float v, float a ) \
+        { return drv##_set_motion_profile( ctx, f, v, a ); } \
+    static err_t drv##_to ( void *ctx, int32_t position ) { return drv##_move_to( ctx, position ); } \
+    static void drv##_halt ( void *ctx ) { drv##_stop( ctx ); } \
+    static int32_t drv##_position ( void *ctx ) { return drv##_get_position( ctx ); } \
+    static err_t drv##_zero ( void *ctx, int32_t position ) { return drv##_set_position( ctx, position ); } \
+    static uint8_t drv##_moving ( void *ctx ) { return drv##_is_moving( ctx ); } \
+    static void drv##_tick ( void *ctx ) { drv##_motion_tick( ctx ); } \
+    static void drv##_hold ( void *ctx, uint8_t state ) { ( ( type * ) ctx )->motion.hold = state; }
+
+#define ENGINE( drv, label ) { label, &drv##_ctx, drv##_profile, drv##_to, drv##_halt, \
+                               drv##_position, drv##_zero, drv##_moving, drv##_tick, drv##_hold }
+
+ENGINE_ADAPTER( stepper5, stepper5_t )
+ENGINE_ADAPTER( stepper19, stepper19_t )
+ENGINE_ADAPTER( silentstep4, silentstep4_t )
+
+static void init_drivers ( void )
+{
+    stepper5_cfg_t stepper5_cfg;
+    stepper19_cfg_t stepper19_cfg;
+    silentstep4_cfg_t silentstep4_cfg;
+
+    stepper5_cfg_setup( &stepper5_cfg );
+    stepper5_cfg.step = STEP_PIN;
+    stepper5_cfg.dir = DIR_PIN;
+    stepper5_init( &stepper5_ctx, &stepper5_cfg );
+
+    // The engine runs on GPIO STEP/DIR, the zeroed context selects it
+    stepper19_cfg_setup( &stepper19_cfg );
+    stepper19_cfg.stp = STEP_PIN;
+    stepper19_cfg.dir = DIR_PIN;
+    stepper19_init( &stepper19_ctx, &stepper19_cfg );
+
+    silentstep4_cfg_setup( &silentstep4_cfg );
+    silentstep4_cfg.step = STEP_PIN;
+    silentstep4_cfg.dir = DIR_PIN;
+    silentstep4_init( &silentstep4_ctx, &silentstep4_cfg );
+}
+
+// ------------------------------------------------------------------ SCENARIOS
+
+static void check ( const engine_t *eng, const char *what, int ok )
+{
+    if ( !ok )
+    {
+        printf( "FAIL: %s %s\n", eng->name, what );
+        failures++;
+    }
+}
+
+static void start_capture ( void )
+{
+    now = 0;
+    n_steps = 0;
+}
+
+// Runs until the move is over, or until the given tick when it is not zero
+static void run ( const engine_t *eng, uint32_t until )
+{
+    while ( eng->is_moving( eng->ctx ) && ( now < MAX_TICKS ) && ( !until || ( now < until ) ) )
+    {
+        eng->tick( eng->ctx );
+        now++;
+    }
+}
+
+static uint32_t steps_between ( double t_from, double t_to )
+{
+    uint32_t cnt = 0;
+    for ( uint32_t idx = 0; idx < n_steps; idx++ )
+    {
+        double t = ( double ) step_tick[ idx ] / TICK_FREQ;
+        cnt += ( t >= t_from ) && ( t < t_to );
+    }
+    return cnt;
+}
+
+static uint32_t min_interval ( void )
+{
+    uint32_t min = UINT32_MAX;
+    for ( uint32_t idx = 1; idx < n_steps; idx++ )
+    {
+        if ( step_tick[ idx ] - step_tick[ idx - 1 ] < min )
+        {
+            min = step_tick[ idx ] - step_tick[ idx - 1 ];
+        }
+    }
+    return min;
+}
+
+static uint32_t direction_changes ( void )
+{
+    uint32_t cnt = 0;
+    for ( uint32_t idx = 1; idx < n_steps; idx++ )
+    {
+        cnt += step_dir[ idx ] != step_dir[ idx - 1 ];
+    }
+    return cnt;
+}
+
+static void long_move ( const engine_t *eng )
+{
+    const double ramp_time = MAX_SPEED / ACCEL;
+    const double ramp_steps = MAX_SPEED * MAX_SPEED / ( 2 * ACCEL );
+    const double ideal = 10000 / MAX_SPEED + ramp_time;
+
+    eng->set_position( eng->ctx, 0 );
+    start_capture( );
+    eng->move_to( eng->ctx, 10000 );
+    run( eng, 0 );
+
+    double t_end = n_steps ? ( double ) step_tick[ n_steps - 1 ] / TICK_FREQ : 0;
+    uint32_t accel_steps = steps_between( 0, ramp_time );
+    uint32_t decel_steps = steps_between( t_end - ramp_time, t_end + 1 );
+    double cruise = steps_between( ramp_time + 0.05, t_end - ramp_time - 0.05 ) / ( t_end - 2 * ramp_time - 0.1 );
+
+    printf( "%-14s 10000 steps in %.3f s (ideal %.3f s), %u/%u steps accelerating/decelerating (ideal %.0f), "
+            "cruise %.0f steps/s\n", eng->name, t_end, ideal, ( unsigned ) accel_steps, ( unsigned ) decel_steps,
+            ramp_steps, cruise );
+    check( eng, "does not end the move on the target", ( 10000 == n_steps ) && ( 10000 == eng->get_position( eng->ctx ) ) );
+    check( eng, "moves the wrong way", !direction_changes( ) && ( 0 == step_dir[ 0 ] ) );
+    check( eng, "move time is off the trapezoid", fabs( t_end - ideal ) < RAMP_END_TOLERANCE );
+    check( eng, "acceleration ramp is off", fabs( accel_steps - ramp_steps ) < 0.03 * ramp_steps );
+    check( eng, "deceleration ramp is off", fabs( decel_steps - ramp_steps ) < 0.03 * ramp_steps );
+    check( eng, "cruise speed is off", fabs( cruise - MAX_SPEED ) < 0.005 * MAX_SPEED );
+    check( eng, "exceeds the maximal speed", min_interval( ) >= ( uint32_t ) ( TICK_FREQ / MAX_SPEED ) );
+}
+
+static void stop_from_cruise ( const engine_t *eng )
+{
+    const double stop_steps = MAX_SPEED * MAX_SPEED / ( 2 * ACCEL );
+
+    eng->set_position( eng->ctx, 0 );
+    start_capture( );
+    eng->move_to( eng->ctx, 100000 );
+    run( eng, TICK_FREQ );
+    int32_t at_stop = eng->get_position( eng->ctx );
+    eng->stop( eng->ctx );
+    run( eng, 0 );
+
+    int32_t stopped = eng->get_position( eng->ctx ) - at_stop;
+    printf( "%-14s stop from cruise takes %d steps (v^2/2a = %.0f)\n", eng->name, ( int ) stopped, stop_steps );
+    check( eng, "does not stop", !eng->is_moving( eng->ctx ) );
+    check( eng, "stopping distance is off", fabs( stopped - stop_steps ) < 0.02 * stop_steps );
+    check( eng, "reverses while stopping", !direction_changes( ) );
+}
+
+static void reversal ( const engine_t *eng )
+{
+    int32_t peak = 0;
+    uint32_t reverse_at = 0;
+
+    eng->set_position( eng->ctx, 0 );
+    start_capture( );
+    eng->move_to( eng->ctx, 10000 );
+    while ( eng->get_position( eng->ctx ) < 3000 )
+    {
+        run( eng, now + 1 );
+    }
+    eng->move_to( eng->ctx, -2000 );
+    run( eng, 0 );
+
+    for ( uint32_t idx = 1; idx < n_steps; idx++ )
+    {
+        if ( step_dir[ idx ] != step_dir[ idx - 1 ] )
+        {
+            reverse_at = idx;
+            peak = ( int32_t ) idx;
+        }
+    }
+    uint32_t turn_interval = reverse_at ? step_tick[ reverse_at ] - step_tick[ reverse_at - 1 ] : 0;
+    printf( "%-14s reversal at 3000 turns at %d, %u ticks between the last steps, ends at %d\n", eng->name,
+            ( int ) peak, ( unsigned ) turn_interval, ( int ) eng->get_position( eng->ctx ) );
+    check( eng, "does not land on the new target", -2000 == eng->get_position( eng->ctx ) );
+    check( eng, "has to reverse exactly once", 1 == direction_changes( ) );
+    check( eng, "does not decelerate before reversing", turn_interval >= 10 * ( uint32_t ) ( TICK_FREQ / MAX_SPEED ) );
+    check( eng, "overshoot is off", fabs( peak - 3000 - MAX_SPEED * MAX_SPEED / ( 2 * ACCEL ) ) < 20 );
+}
+
+static void short_move ( const engine_t *eng )
+{
+    const double ideal = 2 * sqrt( 200 / ACCEL );
+    const double v_peak = sqrt( ACCEL * 200 );
+
+    eng->set_position( eng->ctx, 1000 );
+    start_capture( );
+    eng->move_to( eng->ctx, 800 );
+    run( eng, 0 );
+
+    double t_end = n_steps ? ( double ) step_tick[ n_steps - 1 ] / TICK_FREQ : 0;
+    double v_max = ( double ) TICK_FREQ / min_interval( );
+    printf( "%-14s 200 step triangle in %.3f s (ideal %.3f s), peak %.0f steps/s (ideal %.0f)\n", eng->name,
+            t_end, ideal, v_max, v_peak );
+    check( eng, "does not end the short move on the target", ( 200 == n_steps ) && ( 800 == eng->get_position( eng->ctx ) ) );
+    check( eng, "short move time is off", fabs( t_end - ideal ) < RAMP_END_TOLERANCE );
+    check( eng, "short move peak speed is off", fabs( v_max - v_peak ) < 0.05 * v_peak );
+}
+
+// Holds the engine across several due steps in mid-cruise, as a main context update would
+static void held_ticks ( const engine_t *eng )
+{
+    uint32_t steps_before, steps_held, steps_released;
+
+    eng->set_position( eng->ctx, 0 );
+    start_capture( );
+    eng->move_to( eng->ctx, 10000 );
+    while ( eng->get_position( eng->ctx ) < 3000 )
+    {
+        run( eng, now + 1 );
+    }
+    steps_before = n_steps;
+    eng->hold( eng->ctx, 1 );
+    for ( uint32_t cnt = 0; cnt < 5 * ( uint32_t ) ( TICK_FREQ / MAX_SPEED ); cnt++ )
+    {
+        eng->tick( eng->ctx );
+        now++;
+    }
+    steps_held = n_steps - steps_before;
+    eng->hold( eng->ctx, 0 );
+    eng->tick( eng->ctx );
+    now++;
+    steps_released = n_steps - steps_before;
+    run( eng, 0 );
+
+    printf( "%-14s hold over 5 step intervals: %u steps held, %u on release, ends at %d\n", eng->name,
+            ( unsigned ) steps_held, ( unsigned ) steps_released, ( int ) eng->get_position( eng->ctx ) );
+    check( eng, "steps while held", 0 == steps_held );
+    check( eng, "does not take the deferred step on release", 1 == steps_released );
+    check( eng, "does not land on the target after a hold",
+           ( 10000 == n_steps ) && ( 10000 == eng->get_position( eng->ctx ) ) );
+}
+
+int main ( void )
+{
+    const engine_t engines[ ] =
+    {
+        ENGINE( stepper5, "Stepper 5" ),
+        ENGINE( stepper19, "Stepper 19" ),
+        ENGINE( silentstep4, "Silent Step 4" ),
+    };
+
+    hal_sim_reset( );
+    hal_sim_gpio_write = gpio_write;
+    init_drivers( );
+
+    // Old blocking path at its fastest speed setting, 100 steps
+    hal_sim_time_us = 0;
+    stepper5_drive_motor( &stepper5_ctx, 100, STEPPER5_SPEED_VERY_FAST );
+    printf( "%-14s blocking drive_motor: %.0f steps/s with the CPU held for %.0f ms\n", "Stepper 5",
+            100e6 / hal_sim_time_us, hal_sim_time_us / 1000.0 );
+
+    for ( uint8_t cnt = 0; cnt < sizeof( engines ) / sizeof( engines[ 0 ] ); cnt++ )
+    {
+        const engine_t *eng = &engines[ cnt ];
+        check( eng, "rejects the profile", STEPPER5_OK == eng->set_profile( eng->ctx, TICK_FREQ, MAX_SPEED, ACCEL ) );
+        long_move( eng );
+        stop_from_cruise( eng );
+        reversal( eng );
+        short_move( eng );
+        held_ticks( eng );
+    }
+
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}